@@ -28,6 +28,7 @@
 #include "AppMisc.h"
 #include "AppTimestamp.h"
 #include "AppMqtt.h"
+#include "AppMqttScheduler.h"
 #include "BSP_BoardType.h"
 #include "BCDS_BSP_Button.h"
 
@@ -43,6 +44,7 @@ typedef struct {
 	AppTimestamp_T timestamp; /**< timestamp of the event */
 } AppButtonEventData_T;
 
+#define APP_BUTTONS_PUBLISH_DEADLINE_IN_MS		UINT32_C(10000) /**< deadline for publishing a button event */
 /**
  * @brief Publish info for a button event. @note Qos=0 is used.
  */
@@ -51,6 +53,7 @@ static AppXDK_MQTT_Publish_T appButton_MqttPublishInfo = {
 	.qos = 0UL,
 	.payload = NULL,
 	.payloadLength = 0UL,
+	.deadlineMillis = APP_BUTTONS_PUBLISH_DEADLINE_IN_MS,
 };
 static char * appButtons_MqttPublishTopicStr = NULL; /**< topic string for the button events */
 
@@ -243,7 +246,7 @@ static void appButtons_Button2CallbackFromIsr(uint32_t data) {
  * @param[in] buttonEventData: #AppButtonEventData_T
  * @param[in] param2: unused
  *
- * @exception Retcode_RaiseError: result of @ref AppMqtt_Publish() if not RETCODE_OK
+ * @exception Retcode_RaiseError: result of @ref AppMqttScheduler_Publish() if not RETCODE_OK
  */
 static void appButtons_PublishEvent(void * buttonEventData, uint32_t param2) {
 
@@ -288,7 +291,7 @@ static void appButtons_PublishEvent(void * buttonEventData, uint32_t param2) {
 	appButton_MqttPublishInfo.payload = payloadStr;
 	appButton_MqttPublishInfo.payloadLength = strlen(payloadStr);
 
-	Retcode_T retcode = AppMqtt_Publish(&appButton_MqttPublishInfo);
+	Retcode_T retcode = AppMqttScheduler_Publish(AppMqttScheduler_Class_Alarm, &appButton_MqttPublishInfo);
 
 	appButtons_DeleteEventData(buttonEventDataPtr);
 	cJSON_Delete(payloadJsonHandle);
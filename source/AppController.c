@@ -71,7 +71,14 @@
 #include "AppRuntimeConfig.h"
 #include "AppTelemetrySampling.h"
 #include "AppTelemetryPublish.h"
+#include "AppTelemetrySpill.h"
+#include "AppTelemetryCapture.h"
+#include "AppTelemetryAnalysis.h"
+#include "AppTelemetryFusion.h"
+#include "AppTelemetryRateControl.h"
+#include "AppTelemetryFidelity.h"
 #include "AppMqtt.h"
+#include "AppMqttScheduler.h"
 #include "AppButtons.h"
 #include "AppStatus.h"
 
@@ -84,6 +91,7 @@
 
 /* variables */
 static AppTimestamp_T appController_BootTimestamp; /**< save the boot timestamp for status reporting */
+static AppRuntimeConfig_TelemetryConfig_T appController_TelemetryFidelityConfig; /**< the telemetry configuration of the applied fidelity level, the telemetry modules take copies */
 
 /* telemetry tasks management protection */
 static SemaphoreHandle_t appController_TelemetryTasksSemaphoreHandle = NULL; /**< semaphore handle to protect access to telemetry tasks (sampling & publishing) */
@@ -172,9 +180,10 @@ static bool areTelemetryTasksRunning(void) {
 }
 /**
  * @brief Creates the telemetry tasks and the internal queue.
+ * @param[in] isQueueKept: true to keep the samples in the internal queue, false to prepare it and discard them
  * @return Retcode_T: RETCODE_OK if created/already running, otherwise returns retcode from called functions.
  */
-static Retcode_T appController_CreateTelemetryTasks(void) {
+static Retcode_T appController_CreateTelemetryTasks(bool isQueueKept) {
 
 	Retcode_T retcode = RETCODE_OK;
 
@@ -182,7 +191,13 @@ static Retcode_T appController_CreateTelemetryTasks(void) {
 
 	if(pdTRUE == xSemaphoreTake(appController_TelemetryTasksSemaphoreHandle, MILLISECONDS(APP_CONTROLLER_TAKE_TELEMETRY_TASKS_SEMAPHORE_WAIT_IN_MS))) {
 
-		if (RETCODE_OK == retcode) retcode = AppTelemetryQueue_Prepare();
+		if (RETCODE_OK == retcode && !isQueueKept) retcode = AppTelemetryQueue_Prepare();
+
+		if (RETCODE_OK == retcode) retcode = AppTelemetryCapture_Prepare();
+
+		if (RETCODE_OK == retcode) retcode = AppTelemetryAnalysis_Prepare();
+
+		if (RETCODE_OK == retcode) retcode = AppTelemetryFusion_Prepare();
 
 		if (RETCODE_OK == retcode) retcode = AppTelemetrySampling_CreateSamplingTask();
 
@@ -326,6 +341,47 @@ static Retcode_T applyNewRuntime_StatusConfig(AppRuntimeConfig_StatusConfig_T *
 	return retcode;
 }
 
+/**
+ * @brief Applies a telemetry configuration and the telemetry runtime parameters to the telemetry modules.
+ * @note Call only while the telemetry tasks are suspended.
+ * @param[in] configPtr: the telemetry configuration, the target or the one of a fidelity level
+ * @param[in] rtParamsPtr: the active telemetry runtime parameters
+ * @return Retcode_T: RETCODE_OK or the retcode from the called functions.
+ */
+static Retcode_T appController_ApplyTelemetryConfig2Modules(const AppRuntimeConfig_TelemetryConfig_T * configPtr, const AppRuntimeConfig_TelemetryRTParams_T * rtParamsPtr) {
+
+	Retcode_T retcode = RETCODE_OK;
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetryQueue_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetryQueue_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, rtParamsPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetryPayload_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetrySpill_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetryCapture_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetryCapture_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, rtParamsPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetryAnalysis_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetryAnalysis_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, rtParamsPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetryFusion_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetryFusion_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, rtParamsPtr);
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryPublish_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, rtParamsPtr);
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryPublish_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetrySampling_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr);
+
+    if (RETCODE_OK == retcode) retcode = AppTelemetrySampling_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, rtParamsPtr);
+
+	return retcode;
+}
 /**
  * @brief Applies a new target telemetry configuration.
  * @note Module @ref AppRuntimeConfig also re-calculates the activeTelemetryRTParams, which are also applied to the various modules.
@@ -340,15 +396,11 @@ static Retcode_T applyNewRuntime_TargetTelemetryConfig(AppRuntimeConfig_Telemetr
 
     if (RETCODE_OK == retcode) retcode = AppRuntimeConfig_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, newConfigPtr);
 
-    if (RETCODE_OK == retcode) retcode = AppTelemetryQueue_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
-
-    if (RETCODE_OK == retcode) retcode = AppTelemetryPayload_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, newConfigPtr);
-
-	if (RETCODE_OK == retcode) retcode = AppTelemetryPublish_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+    if (RETCODE_OK == retcode) retcode = appController_ApplyTelemetryConfig2Modules(newConfigPtr, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
 
-	if (RETCODE_OK == retcode) retcode = AppTelemetryPublish_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, newConfigPtr);
+    if (RETCODE_OK == retcode) retcode = AppTelemetryRateControl_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, newConfigPtr);
 
-    if (RETCODE_OK == retcode) retcode = AppTelemetrySampling_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+    if (RETCODE_OK == retcode) retcode = AppTelemetryFidelity_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, newConfigPtr);
 
 	return retcode;
 }
@@ -398,7 +450,7 @@ Retcode_T AppController_ApplyNewRuntimeConfiguration(AppRuntimeConfig_ConfigElem
 	default: assert(0);
 	}
 
-	if (RETCODE_OK == retcode && appController_targetTelemetryState_isRunning) retcode = appController_CreateTelemetryTasks();
+	if (RETCODE_OK == retcode && appController_targetTelemetryState_isRunning) retcode = appController_CreateTelemetryTasks(false);
 
 	appController_AllowInstructions();
 
@@ -436,7 +488,7 @@ Retcode_T AppController_ExecuteCommand(AppCmdCtrl_CommandType_T commandType, con
 	}
 	break;
 	case AppCmdCtrl_CommandType_ResumeTelemetry: {
-		retcode = appController_CreateTelemetryTasks();
+		retcode = appController_CreateTelemetryTasks(false);
 	}
 	break;
 	case AppCmdCtrl_CommandType_SendFullStatus: {
@@ -496,7 +548,7 @@ Retcode_T AppController_ExecuteCommand(AppCmdCtrl_CommandType_T commandType, con
  * @details Enqueued by @ref appController_MqttBrokerDisconnectCallback(), runs in AppController command processor.
  * Waits until AppController is finished processing any other instructions and then blocks new instruction processing until finished.
  * @details Sequence: <br/>
- * - notifies modules of the disconnect event and suspends telemetry tasks.<br/>
+ * - notifies modules of the disconnect event and suspends telemetry tasks, unless telemetry is spilled to the SD card (@ref AppTelemetrySpill_IsEnabled()). Then sampling continues and the publishing task spills the events until the reconnect.<br/>
  * - reconnect: <br/>
  *    - checks if WLAN connection still active, waits #APP_CONTROLLER_WLAN_RECONNECT_WAIT_MS milliseconds for #APP_CONTROLLER_WLAN_RECONNECT_MAX_TRIES times until it is<br/>
  *    - connects to the broker #APP_CONTROLLER_MQTT_RECONNECT_MAX_TRIES times with a wait of #APP_CONTROLLER_MQTT_RECONNECT_WAIT_MS before trying again
@@ -551,7 +603,7 @@ static void appController_SetupAfterDisconnect(void * param1, uint32_t param2) {
 
 	if (RETCODE_OK == retcode) retcode = AppButtons_NotifyDisconnectedFromBroker();
 
-	if (RETCODE_OK == retcode) retcode = appController_SuspendTelemetryTasks();
+	if (RETCODE_OK == retcode && !AppTelemetrySpill_IsEnabled()) retcode = appController_SuspendTelemetryTasks();
 
 	// connect
 	if (RETCODE_OK == retcode) {
@@ -626,7 +678,7 @@ static void appController_SetupAfterDisconnect(void * param1, uint32_t param2) {
 
 	if (RETCODE_OK == retcode) retcode = AppCmdCtrl_NotifyReconnected2Broker();
 
-	if (RETCODE_OK == retcode && appController_targetTelemetryState_isRunning) retcode = appController_CreateTelemetryTasks();
+	if (RETCODE_OK == retcode && appController_targetTelemetryState_isRunning) retcode = appController_CreateTelemetryTasks(false);
 
 	if (RETCODE_OK == retcode) AppMisc_UserFeedback_Ready();
 
@@ -635,6 +687,159 @@ static void appController_SetupAfterDisconnect(void * param1, uint32_t param2) {
 	appController_AllowInstructions();
 
 }
+/**
+ * @brief Applies the telemetry rate proposed by @ref AppTelemetryRateControl.
+ * @details Enqueued by @ref appController_TelemetryRateChangedCallback(), runs in AppController command processor.
+ * Discards the proposal if AppController is busy with other instructions or the telemetry tasks are not running, the rate control then measures again.
+ * @details Sequence: <br/>
+ * - suspends the telemetry tasks <br/>
+ * - calculates the activeTelemetryRTParams for the new rate with @ref AppRuntimeConfig_AdaptTelemetryRate() and applies them to the telemetry modules,
+ *   the queue only takes over the new sampling period with @ref AppTelemetryQueue_ApplyNewRate() and keeps the queued samples.
+ *   If the parameters change the queue layout, the queued events are spilled with @ref AppTelemetryPublish_SpillQueuedEvents() and the queue is prepared instead <br/>
+ * - confirms the new rate, which sends a status message, and starts the telemetry tasks again.
+ *
+ * @param[in] param1: unused
+ * @param[in] param2: unused
+ * @exception Retcode_RaiseError: retcode of the called functions if not RETCODE_OK
+ */
+static void appController_ApplyTelemetryRate(void * param1, uint32_t param2) {
+	BCDS_UNUSED(param1);
+	BCDS_UNUSED(param2);
+
+	uint32_t ratePermille = APP_TELEMETRY_RATE_CONTROL_FULL_RATE_PERMILLE;
+
+	// a new target telemetry config was applied in the meantime
+	if(!AppTelemetryRateControl_GetProposal(&ratePermille)) return;
+
+	if(!appController_BlockInstructionsIfNotInProgress(AppController_State_ApplyingNewRuntimeConfiguration)) {
+		AppTelemetryRateControl_DiscardProposal();
+		return;
+	}
+
+	if(!areTelemetryTasksRunning()) {
+		AppTelemetryRateControl_DiscardProposal();
+		appController_AllowInstructions();
+		return;
+	}
+
+	Retcode_T retcode = RETCODE_OK;
+	bool isQueueKept = true;
+
+	if (RETCODE_OK == retcode) retcode = appController_SuspendTelemetryTasks();
+
+	if (RETCODE_OK == retcode) retcode = AppRuntimeConfig_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, AppRuntimeConfig_AdaptTelemetryRate(ratePermille));
+
+	// the rate keeps the queue layout: keep the samples queued during the lag that triggered the change
+	if (RETCODE_OK == retcode) retcode = AppTelemetryQueue_ApplyNewRate(getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+
+	// otherwise keep the queued batches for replay and prepare the queue with the new layout
+	if (RETCODE_SOLAPP_TELEMETRY_QUEUE_LAYOUT_CHANGED == Retcode_GetCode(retcode)) {
+		AppTelemetryPublish_SpillQueuedEvents();
+		isQueueKept = false;
+		retcode = AppTelemetryQueue_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+	}
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryCapture_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryAnalysis_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryFusion_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryPublish_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetrySampling_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+
+	if (RETCODE_OK == retcode) AppTelemetryRateControl_ConfirmProposal(getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+	else AppTelemetryRateControl_DiscardProposal();
+
+	if (RETCODE_OK == retcode) retcode = appController_CreateTelemetryTasks(isQueueKept);
+
+	if (RETCODE_OK != retcode) Retcode_RaiseError(retcode);
+
+	appController_AllowInstructions();
+}
+/**
+ * @brief Callback from @ref AppTelemetryRateControl module when it proposes a new telemetry rate.
+ * @details Enqueues @ref appController_ApplyTelemetryRate(). If it can't be enqueued, the proposal is discarded.
+ *
+ * @note Function is of type: @ref AppTelemetryRateControl_RateChanged_Func_T
+ */
+static void appController_TelemetryRateChangedCallback(void) {
+
+	Retcode_T retcode = CmdProcessor_Enqueue(AppControllerProcessorHandle, appController_ApplyTelemetryRate, NULL, UINT32_C(0));
+	if (RETCODE_OK != retcode) {
+		Retcode_RaiseError(retcode);
+		AppTelemetryRateControl_DiscardProposal();
+	}
+}
+/**
+ * @brief Applies the fidelity level proposed by @ref AppTelemetryFidelity.
+ * @details Enqueued by @ref appController_TelemetryFidelityChangedCallback(), runs in AppController command processor.
+ * Discards the proposal if AppController is busy with other instructions or the telemetry tasks are not running, the fidelity ladder then measures again.
+ * @details Sequence: <br/>
+ * - suspends the telemetry tasks <br/>
+ * - spills the events left in the queue with @ref AppTelemetryPublish_SpillQueuedEvents() <br/>
+ * - creates the telemetry configuration and the activeTelemetryRTParams of the level with @ref AppRuntimeConfig_AdaptTelemetryFidelity() and applies them to the telemetry modules <br/>
+ * - confirms the new level, which sends a status message, and starts the telemetry tasks again.
+ *
+ * @param[in] param1: unused
+ * @param[in] param2: unused
+ * @exception Retcode_RaiseError: retcode of the called functions if not RETCODE_OK
+ */
+static void appController_ApplyTelemetryFidelity(void * param1, uint32_t param2) {
+	BCDS_UNUSED(param1);
+	BCDS_UNUSED(param2);
+
+	uint8_t level = APP_TELEMETRY_FIDELITY_CONFIGURED_LEVEL;
+
+	// a new target telemetry config was applied in the meantime
+	if(!AppTelemetryFidelity_GetProposal(&level)) return;
+
+	if(!appController_BlockInstructionsIfNotInProgress(AppController_State_ApplyingNewRuntimeConfiguration)) {
+		AppTelemetryFidelity_DiscardProposal();
+		return;
+	}
+
+	if(!areTelemetryTasksRunning()) {
+		AppTelemetryFidelity_DiscardProposal();
+		appController_AllowInstructions();
+		return;
+	}
+
+	Retcode_T retcode = RETCODE_OK;
+
+	if (RETCODE_OK == retcode) retcode = appController_SuspendTelemetryTasks();
+
+	// the level changes the queue layout, keep the queued batches for replay before the queue is prepared
+	if (RETCODE_OK == retcode) AppTelemetryPublish_SpillQueuedEvents();
+
+	if (RETCODE_OK == retcode) retcode = AppRuntimeConfig_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, AppRuntimeConfig_AdaptTelemetryFidelity(level, &appController_TelemetryFidelityConfig));
+
+	if (RETCODE_OK == retcode) retcode = appController_ApplyTelemetryConfig2Modules(&appController_TelemetryFidelityConfig, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+
+	if (RETCODE_OK == retcode) AppTelemetryFidelity_ConfirmProposal(&appController_TelemetryFidelityConfig, getAppRuntimeConfigPtr()->activeTelemetryRTParamsPtr);
+	else AppTelemetryFidelity_DiscardProposal();
+
+	if (RETCODE_OK == retcode) retcode = appController_CreateTelemetryTasks(false);
+
+	if (RETCODE_OK != retcode) Retcode_RaiseError(retcode);
+
+	appController_AllowInstructions();
+}
+/**
+ * @brief Callback from @ref AppTelemetryFidelity module when it proposes a new fidelity level.
+ * @details Enqueues @ref appController_ApplyTelemetryFidelity(). If it can't be enqueued, the proposal is discarded.
+ *
+ * @note Function is of type: @ref AppTelemetryFidelity_LevelChanged_Func_T
+ */
+static void appController_TelemetryFidelityChangedCallback(void) {
+
+	Retcode_T retcode = CmdProcessor_Enqueue(AppControllerProcessorHandle, appController_ApplyTelemetryFidelity, NULL, UINT32_C(0));
+	if (RETCODE_OK != retcode) {
+		Retcode_RaiseError(retcode);
+		AppTelemetryFidelity_DiscardProposal();
+	}
+}
 /**
  * @brief Callback from @ref AppMqtt module when connection closed event received.
  * @details Enqueues @ref appController_SetupAfterDisconnect().
@@ -686,6 +891,8 @@ static void AppController_Enable(void * param1, uint32_t param2) {
 
 	if (RETCODE_OK == retcode) retcode = AppRuntimeConfig_Enable();
 
+	if (RETCODE_OK == retcode) retcode = AppTelemetrySpill_Enable();
+
 	if (RETCODE_OK == retcode) retcode = AppMqtt_Connect2Broker();
 
 	if (RETCODE_OK == retcode) retcode = AppStatus_SendBootStatus();
@@ -703,7 +910,7 @@ static void AppController_Enable(void * param1, uint32_t param2) {
 
 	if (RETCODE_OK == retcode) {
 		if(getAppRuntimeConfigPtr()->targetTelemetryConfigPtr->received.activateAtBootTime) {
-			retcode = appController_CreateTelemetryTasks();
+			retcode = appController_CreateTelemetryTasks(false);
 			if(RETCODE_OK == retcode) appController_targetTelemetryState_isRunning = true;
 		} else appController_targetTelemetryState_isRunning = false;
 	}
@@ -751,6 +958,18 @@ static void AppController_Setup(void * param1, uint32_t param2) {
 
 	if (RETCODE_OK == retcode) retcode = AppTelemetryPayload_Setup(getAppRuntimeConfigPtr());
 
+	if (RETCODE_OK == retcode) retcode = AppTelemetrySpill_Setup(getAppRuntimeConfigPtr());
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryCapture_Setup(getAppRuntimeConfigPtr());
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryAnalysis_Setup(getAppRuntimeConfigPtr());
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryFusion_Setup(getAppRuntimeConfigPtr());
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryRateControl_Setup(getAppRuntimeConfigPtr());
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryFidelity_Setup(getAppRuntimeConfigPtr());
+
 	if (RETCODE_OK == retcode) retcode = AppButtons_Setup(getAppRuntimeConfigPtr());
 
 	if (RETCODE_OK == retcode) retcode = CmdProcessor_Enqueue(AppControllerProcessorHandle, AppController_Enable, NULL, UINT32_C(0));
@@ -835,6 +1054,18 @@ void AppController_Init(void * cmdProcessorHandle, uint32_t param2) {
 
 	if (RETCODE_OK == retcode) retcode = AppTelemetryPayload_Init(AppMisc_GetDeviceId());
 
+	if (RETCODE_OK == retcode) retcode = AppTelemetrySpill_Init();
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryCapture_Init();
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryAnalysis_Init();
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryFusion_Init();
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryRateControl_Init(appController_TelemetryRateChangedCallback);
+
+	if (RETCODE_OK == retcode) retcode = AppTelemetryFidelity_Init(appController_TelemetryFidelityChangedCallback);
+
 	if (RETCODE_OK == retcode) retcode = AppTelemetryPublish_Init(AppMisc_GetDeviceId(), APP_TELEMETRY_PUBLISHING_TASK_PRIORITY, APP_TELEMETRY_PUBLISHING_TASK_STACK_SIZE);
 
 	if (RETCODE_OK == retcode) retcode = AppTelemetrySampling_Init(AppMisc_GetDeviceId(), APP_TELEMETRY_SAMPLING_TASK_PRIORITY, APP_TELEMETRY_SAMPLING_TASK_STACK_SIZE, &SensorCmdProcessor);
@@ -851,6 +1082,8 @@ void AppController_Init(void * cmdProcessorHandle, uint32_t param2) {
 
 	if (RETCODE_OK == retcode) retcode = AppMqtt_Init(AppMisc_GetDeviceId(), appController_MqttBrokerDisconnectCallback, AppCmdCtrl_GetGlobalSubscriptionCallback());
 
+	if (RETCODE_OK == retcode) retcode = AppMqttScheduler_Init(APP_MQTT_SCHEDULER_TASK_PRIORITY, APP_MQTT_SCHEDULER_TASK_STACK_SIZE);
+
 	if (RETCODE_OK == retcode) retcode = CmdProcessor_Enqueue(AppControllerProcessorHandle, AppController_Setup, NULL, UINT32_C(0));
 
 	if (RETCODE_OK != retcode) {
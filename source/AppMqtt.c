@@ -184,6 +184,8 @@ Retcode_T AppMqtt_Connect2Broker(void) {
  *
  * @details Checks if app is connected to broker and the payload is not greater than #APP_MQTT_MAX_PUBLISH_DATA_LENGTH.
  * Calls @ref AppXDK_MQTT_PublishToTopic().
+ * @details A qos 1 message with a completion callback in the publish info returns once it is in flight, its outcome is passed to the callback.
+ * @details Publishers do not call this function directly but @ref AppMqttScheduler_Publish(), the scheduler task is its only caller.
  *
  *
  * @param[in] publishInfoPtr: the publish info
@@ -214,10 +216,10 @@ Retcode_T AppMqtt_Connect2Broker(void) {
  * mqttPublishInfo.Payload = payloadStr;
  * mqttPublishInfo.PayloadLength = strlen(payloadStr);
  *
- * Retcode_T retcode = AppMqtt_Publish(&mqttPublishInfo);
+ * Retcode_T retcode = AppMqttScheduler_Publish(AppMqttScheduler_Class_Status, &mqttPublishInfo);
  *
  * if(RETCODE_OK != retcode) {
- * 		// raise the error from AppMqtt_Publish
+ * 		// raise the error from AppMqttScheduler_Publish
  *
  * 		// NOTE: this could send another status message in a different processor
  *		// if severity=Error or Fatal
@@ -251,6 +253,10 @@ Retcode_T AppMqtt_Publish(const AppXDK_MQTT_Publish_T * publishInfoPtr) {
 	case RETCODE_SOLAPP_APP_XDK_MQTT_MODULE_BUSY_SUBSCRIBING:
 	case RETCODE_SOLAPP_APP_XDK_MQTT_MODULE_BUSY_UNSUBSCRIBING:
 	case RETCODE_SOLAPP_APP_XDK_MQTT_MODULE_BUSY_UNDEFINED:
+	case RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_FULL:
+	case RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_FAILED_TO_ALLOCATE:
+	case RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED:
+	case RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED_IN_FLIGHT:
 		break;
 	case RETCODE_SOLAPP_APP_XDK_MQTT_MODULE_BUSY_CONNECTING:
 		appMqtt_IsConnected2Broker = false;
@@ -274,6 +280,21 @@ Retcode_T AppMqtt_Publish(const AppXDK_MQTT_Publish_T * publishInfoPtr) {
 	return retcode;
 }
 
+/**
+ * @brief Set the number of qos 1 messages in flight.
+ * @details Calls @ref AppXDK_MQTT_SetQos1MaxInFlight().
+ * @param[in] maxInFlight: 1-#APP_MQTT_PUBLISH_WINDOW_MAX_SIZE
+ */
+void AppMqtt_SetQos1MaxInFlight(uint32_t maxInFlight) {
+	AppXDK_MQTT_SetQos1MaxInFlight(maxInFlight);
+}
+/**
+ * @brief Pass the outcomes of the qos 1 messages in flight to their completion callbacks and fail the ones that timed out.
+ * @details Calls @ref AppXDK_MQTT_ServicePublishWindow().
+ */
+void AppMqtt_ServicePublishWindow(void) {
+	AppXDK_MQTT_ServicePublishWindow();
+}
 /**
  * @brief Sends a subscription to the broker.
  *
@@ -41,6 +41,10 @@ Retcode_T AppMqtt_Connect2Broker(void);
 
 Retcode_T AppMqtt_Publish(const AppXDK_MQTT_Publish_T * publishInfoPtr);
 
+void AppMqtt_SetQos1MaxInFlight(uint32_t maxInFlight);
+
+void AppMqtt_ServicePublishWindow(void);
+
 Retcode_T AppMqtt_Subscribe(const AppXDK_MQTT_Subscribe_T * subscribeInfoPtr);
 
 Retcode_T AppMqtt_Unsubscribe(const uint8_t numTopics, const char * topicsArray[]);
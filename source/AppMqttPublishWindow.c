@@ -0,0 +1,242 @@
+/*
+ * AppMqttPublishWindow.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppMqttPublishWindow AppMqttPublishWindow
+ * @{
+ *
+ * @brief Window of qos 1 messages in flight. Used by @ref AppXDK_MQTT to pipeline qos 1 publishing.
+ * @details Keeps copies of up to #APP_MQTT_PUBLISH_WINDOW_MAX_SIZE messages until the broker acknowledged them, so the publisher does not wait a round trip per message.
+ * Each message gets a packet id, passed to its completion callback.
+ * @details The Serval stack does not pass its packet ids to the application, the acknowledgements are matched to the messages in order instead:
+ * the broker acknowledges qos 1 messages in the order it received them (MQTT 3.1.1, 4.6), so the oldest message in flight is always the one acknowledged.
+ * Every message sent gets exactly one outcome from the stack: acknowledged, failed or the connection closed. Each takes the oldest message out of the window.
+ * @details Messages are not sent again within the session: MQTT 3.1.1 only allows a qos 1 message to be sent again with the DUP flag after a reconnect,
+ * which the stack does not expose, and a message sent again would have two outcomes.
+ * @details A message not acknowledged within the timeout is abandoned: its completion is notified as failed, so the publisher can act on it,
+ * but it keeps its place in the window until the stack reported its outcome. A late acknowledgement is matched to it and not to the next message.
+ * Abandoned messages count towards the messages in flight, a broker that stopped responding fills the window until the connection is closed.
+ * @details The matching is tested on the host against a broker stand-in that acknowledges in order with a latency, see test/test_AppMqttPublishWindow.c.
+ * @details The window is not thread-safe and has no dependencies on FreeRTOS or the XDK SDK, so it can be compiled and tested on a host against a broker stand-in.
+ * The time is passed in as ticks.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+
+#include "AppMqttPublishWindow.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Get the message at a position of the ring.
+ * @param[in] windowPtr: the window
+ * @param[in] position: the position, 0 is the oldest message
+ * @return AppMqttPublishWindow_Message_T *: the message
+ */
+static AppMqttPublishWindow_Message_T * appMqttPublishWindow_GetMessage(AppMqttPublishWindow_T * windowPtr, uint32_t position) {
+	return &windowPtr->messages[(windowPtr->head + position) % APP_MQTT_PUBLISH_WINDOW_MAX_SIZE];
+}
+/**
+ * @brief Free the copies of a message and fill in its completion.
+ * @param[in] messagePtr: the message
+ * @param[in] isAcknowledged: the outcome
+ * @param[out] completionPtr: the completion, can be NULL
+ */
+static void appMqttPublishWindow_ReleaseMessage(AppMqttPublishWindow_Message_T * messagePtr, bool isAcknowledged, AppMqttPublishWindow_Completion_T * completionPtr) {
+
+	if(NULL != completionPtr) {
+		completionPtr->packetId = messagePtr->packetId;
+		completionPtr->isAcknowledged = isAcknowledged;
+		completionPtr->isAbandoned = false;
+		completionPtr->wasAbandoned = messagePtr->isAbandoned;
+		completionPtr->completed_Func = messagePtr->completed_Func;
+		completionPtr->completedContextPtr = messagePtr->completedContextPtr;
+	}
+	free(messagePtr->topic);
+	free(messagePtr->payload);
+	memset(messagePtr, 0, sizeof(AppMqttPublishWindow_Message_T));
+}
+/**
+ * @brief Initialize an empty window.
+ * @param[in] windowPtr: the window
+ * @param[in] maxInFlight: number of messages allowed in flight, 1-#APP_MQTT_PUBLISH_WINDOW_MAX_SIZE
+ * @param[in] timeoutTicks: ticks after which an unacknowledged message is abandoned
+ */
+void AppMqttPublishWindow_Init(AppMqttPublishWindow_T * windowPtr, uint32_t maxInFlight, uint32_t timeoutTicks) {
+
+	assert(windowPtr);
+	assert(timeoutTicks > 0);
+
+	memset(windowPtr, 0, sizeof(AppMqttPublishWindow_T));
+	windowPtr->timeoutTicks = timeoutTicks;
+	windowPtr->nextPacketId = 1;
+	AppMqttPublishWindow_SetMaxInFlight(windowPtr, maxInFlight);
+}
+/**
+ * @brief Set the number of messages allowed in flight.
+ * @details Messages already in flight stay, a smaller window takes effect once enough of them completed.
+ * @param[in] windowPtr: the window
+ * @param[in] maxInFlight: 1-#APP_MQTT_PUBLISH_WINDOW_MAX_SIZE
+ */
+void AppMqttPublishWindow_SetMaxInFlight(AppMqttPublishWindow_T * windowPtr, uint32_t maxInFlight) {
+
+	assert(windowPtr);
+	assert(maxInFlight >= 1 && maxInFlight <= APP_MQTT_PUBLISH_WINDOW_MAX_SIZE);
+
+	windowPtr->maxInFlight = maxInFlight;
+}
+/**
+ * @brief Get the number of messages in flight.
+ * @param[in] windowPtr: the window
+ * @return uint32_t: the number of messages
+ */
+uint32_t AppMqttPublishWindow_GetNumberInFlight(const AppMqttPublishWindow_T * windowPtr) {
+	return windowPtr->numberOfMessages;
+}
+/**
+ * @brief Check if the window is full.
+ * @param[in] windowPtr: the window
+ * @return bool: true if no other message is allowed in flight
+ */
+bool AppMqttPublishWindow_IsFull(const AppMqttPublishWindow_T * windowPtr) {
+	return windowPtr->numberOfMessages >= windowPtr->maxInFlight;
+}
+/**
+ * @brief Add a message to the window before it is sent.
+ * @details Copies the topic and the payload and assigns the next packet id. Remove the message again with @ref AppMqttPublishWindow_RemoveNewest() if sending it fails.
+ * @param[in] windowPtr: the window
+ * @param[in] topic: the topic
+ * @param[in] payload: the payload
+ * @param[in] payloadLength: the length of the payload
+ * @param[in] completed_Func: the completion callback, can be NULL
+ * @param[in] completedContextPtr: the context for the completion callback
+ * @param[in] nowTicks: the current ticks
+ * @return AppMqttPublishWindow_Message_T *: the message to send, NULL if the window is full or the copies could not be allocated
+ */
+AppMqttPublishWindow_Message_T * AppMqttPublishWindow_Add(AppMqttPublishWindow_T * windowPtr, const char * topic, const char * payload, uint32_t payloadLength,
+		AppMqttPublishWindow_Completed_Func_T completed_Func, void * completedContextPtr, uint32_t nowTicks) {
+
+	assert(windowPtr);
+	assert(topic);
+	assert(payload);
+
+	if(AppMqttPublishWindow_IsFull(windowPtr)) return NULL;
+
+	uint32_t topicLength = (uint32_t) strlen(topic);
+	char * topicCopy = malloc(topicLength + 1);
+	char * payloadCopy = malloc(payloadLength);
+	if(NULL == topicCopy || NULL == payloadCopy) {
+		free(topicCopy);
+		free(payloadCopy);
+		return NULL;
+	}
+	memcpy(topicCopy, topic, topicLength + 1);
+	memcpy(payloadCopy, payload, payloadLength);
+
+	AppMqttPublishWindow_Message_T * messagePtr = appMqttPublishWindow_GetMessage(windowPtr, windowPtr->numberOfMessages);
+	messagePtr->packetId = windowPtr->nextPacketId;
+	messagePtr->topic = topicCopy;
+	messagePtr->payload = payloadCopy;
+	messagePtr->payloadLength = payloadLength;
+	messagePtr->sentTicks = nowTicks;
+	messagePtr->isAbandoned = false;
+	messagePtr->completed_Func = completed_Func;
+	messagePtr->completedContextPtr = completedContextPtr;
+	windowPtr->numberOfMessages++;
+
+	// packet id 0 is not allowed
+	windowPtr->nextPacketId = (UINT16_MAX == windowPtr->nextPacketId) ? 1 : windowPtr->nextPacketId + 1;
+
+	return messagePtr;
+}
+/**
+ * @brief Take the newest message out of the window, the one added last, because sending it failed.
+ * @param[in] windowPtr: the window
+ * @param[out] completionPtr: the completion of the message as failed, can be NULL
+ * @return bool: false if the window is empty
+ */
+bool AppMqttPublishWindow_RemoveNewest(AppMqttPublishWindow_T * windowPtr, AppMqttPublishWindow_Completion_T * completionPtr) {
+
+	assert(windowPtr);
+
+	if(0 == windowPtr->numberOfMessages) return false;
+
+	appMqttPublishWindow_ReleaseMessage(appMqttPublishWindow_GetMessage(windowPtr, windowPtr->numberOfMessages - 1), false, completionPtr);
+	windowPtr->numberOfMessages--;
+	return true;
+}
+/**
+ * @brief Take the oldest message out of the window, because the broker acknowledged it, the stack reported it failed or the connection was lost.
+ * @details The completion of a message that was abandoned before has wasAbandoned set.
+ * @param[in] windowPtr: the window
+ * @param[in] isAcknowledged: true for an acknowledgement, false for a failure
+ * @param[out] completionPtr: the completion of the message
+ * @return bool: false if the window is empty
+ */
+bool AppMqttPublishWindow_Complete(AppMqttPublishWindow_T * windowPtr, bool isAcknowledged, AppMqttPublishWindow_Completion_T * completionPtr) {
+
+	assert(windowPtr);
+
+	if(0 == windowPtr->numberOfMessages) return false;
+
+	appMqttPublishWindow_ReleaseMessage(appMqttPublishWindow_GetMessage(windowPtr, 0), isAcknowledged, completionPtr);
+	windowPtr->head = (windowPtr->head + 1) % APP_MQTT_PUBLISH_WINDOW_MAX_SIZE;
+	windowPtr->numberOfMessages--;
+	return true;
+}
+/**
+ * @brief Abandon the oldest message not acknowledged within the timeout, if any.
+ * @details The message keeps its place in the window, see @ref AppMqttPublishWindow_Complete(). Call until it returns false.
+ * @param[in] windowPtr: the window
+ * @param[in] nowTicks: the current ticks
+ * @param[out] completionPtr: the completion of the message as abandoned, not acknowledged
+ * @return bool: true if a message was abandoned
+ */
+bool AppMqttPublishWindow_AbandonTimedOut(AppMqttPublishWindow_T * windowPtr, uint32_t nowTicks, AppMqttPublishWindow_Completion_T * completionPtr) {
+
+	assert(windowPtr);
+	assert(completionPtr);
+
+	// messages are in the order they were sent, only the oldest one not abandoned yet can be due
+	for(uint32_t position = 0; position < windowPtr->numberOfMessages; position++) {
+
+		AppMqttPublishWindow_Message_T * messagePtr = appMqttPublishWindow_GetMessage(windowPtr, position);
+		if(messagePtr->isAbandoned) continue;
+
+		if((uint32_t) (nowTicks - messagePtr->sentTicks) < windowPtr->timeoutTicks) return false;
+
+		messagePtr->isAbandoned = true;
+
+		completionPtr->packetId = messagePtr->packetId;
+		completionPtr->isAcknowledged = false;
+		completionPtr->isAbandoned = true;
+		completionPtr->wasAbandoned = false;
+		completionPtr->completed_Func = messagePtr->completed_Func;
+		completionPtr->completedContextPtr = messagePtr->completedContextPtr;
+		return true;
+	}
+	return false;
+}
+/**
+ * @brief Call the completion callback of a message, if any. An abandoned message is notified twice: when it is abandoned and with its outcome.
+ * @param[in] completionPtr: the completion
+ */
+void AppMqttPublishWindow_NotifyCompletion(const AppMqttPublishWindow_Completion_T * completionPtr) {
+
+	assert(completionPtr);
+
+	if(NULL != completionPtr->completed_Func) completionPtr->completed_Func(completionPtr->packetId, completionPtr->isAcknowledged, completionPtr->isAbandoned, completionPtr->completedContextPtr);
+}
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,89 @@
+/*
+ * AppMqttPublishWindow.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppMqttPublishWindow
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPMQTTPUBLISHWINDOW_H_
+#define SOURCE_APPMQTTPUBLISHWINDOW_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define APP_MQTT_PUBLISH_WINDOW_MAX_SIZE		UINT32_C(8) /**< max number of qos 1 messages in flight */
+
+/**
+ * @brief Callback function typedef for the completion of a message in the window.
+ * @param[in] packetId: the packet id the window assigned to the message
+ * @param[in] isAcknowledged: true if the broker acknowledged the message, false if it failed
+ * @param[in] isAbandoned: true if the message timed out: it is not acknowledged yet and may still be, the callback is called again with its outcome
+ * @param[in] contextPtr: the context passed with the message
+ */
+typedef void (*AppMqttPublishWindow_Completed_Func_T)(uint16_t packetId, bool isAcknowledged, bool isAbandoned, void * contextPtr);
+/**
+ * @brief A message in flight. Owns copies of its topic and payload, the stack may still send them until it reported the outcome.
+ */
+typedef struct {
+	uint16_t packetId; /**< the packet id assigned by the window, 1-65535 */
+	char * topic; /**< copy of the topic */
+	char * payload; /**< copy of the payload */
+	uint32_t payloadLength; /**< length of the payload */
+	uint32_t sentTicks; /**< ticks when the message was sent */
+	bool isAbandoned; /**< flag set when the message timed out, it was notified as abandoned and keeps its place until the stack reported the outcome */
+	AppMqttPublishWindow_Completed_Func_T completed_Func; /**< the completion callback, can be NULL */
+	void * completedContextPtr; /**< the context for the completion callback */
+} AppMqttPublishWindow_Message_T;
+/**
+ * @brief A message taken out of the window, to call its completion callback outside the lock of the window. See @ref AppMqttPublishWindow_NotifyCompletion().
+ */
+typedef struct {
+	uint16_t packetId; /**< the packet id of the message */
+	bool isAcknowledged; /**< true if the broker acknowledged the message */
+	bool isAbandoned; /**< true if the message timed out and keeps its place, see @ref AppMqttPublishWindow_Completed_Func_T() */
+	bool wasAbandoned; /**< true for the outcome of a message that was abandoned before */
+	AppMqttPublishWindow_Completed_Func_T completed_Func; /**< the completion callback, can be NULL */
+	void * completedContextPtr; /**< the context for the completion callback */
+} AppMqttPublishWindow_Completion_T;
+/**
+ * @brief The window. A ring of the messages in flight in the order the broker acknowledges them.
+ */
+typedef struct {
+	AppMqttPublishWindow_Message_T messages[APP_MQTT_PUBLISH_WINDOW_MAX_SIZE]; /**< the ring */
+	uint32_t head; /**< index of the oldest message in the ring */
+	uint32_t numberOfMessages; /**< number of messages in flight */
+	uint32_t maxInFlight; /**< number of messages allowed in flight, 1-#APP_MQTT_PUBLISH_WINDOW_MAX_SIZE */
+	uint32_t timeoutTicks; /**< ticks after which an unacknowledged message is abandoned */
+	uint16_t nextPacketId; /**< the next packet id to assign */
+} AppMqttPublishWindow_T;
+
+void AppMqttPublishWindow_Init(AppMqttPublishWindow_T * windowPtr, uint32_t maxInFlight, uint32_t timeoutTicks);
+
+void AppMqttPublishWindow_SetMaxInFlight(AppMqttPublishWindow_T * windowPtr, uint32_t maxInFlight);
+
+uint32_t AppMqttPublishWindow_GetNumberInFlight(const AppMqttPublishWindow_T * windowPtr);
+
+bool AppMqttPublishWindow_IsFull(const AppMqttPublishWindow_T * windowPtr);
+
+AppMqttPublishWindow_Message_T * AppMqttPublishWindow_Add(AppMqttPublishWindow_T * windowPtr, const char * topic, const char * payload, uint32_t payloadLength,
+		AppMqttPublishWindow_Completed_Func_T completed_Func, void * completedContextPtr, uint32_t nowTicks);
+
+bool AppMqttPublishWindow_RemoveNewest(AppMqttPublishWindow_T * windowPtr, AppMqttPublishWindow_Completion_T * completionPtr);
+
+bool AppMqttPublishWindow_Complete(AppMqttPublishWindow_T * windowPtr, bool isAcknowledged, AppMqttPublishWindow_Completion_T * completionPtr);
+
+bool AppMqttPublishWindow_AbandonTimedOut(AppMqttPublishWindow_T * windowPtr, uint32_t nowTicks, AppMqttPublishWindow_Completion_T * completionPtr);
+
+void AppMqttPublishWindow_NotifyCompletion(const AppMqttPublishWindow_Completion_T * completionPtr);
+
+#endif /* SOURCE_APPMQTTPUBLISHWINDOW_H_ */
+
+/**@} */
+/** ************************************************************************* */
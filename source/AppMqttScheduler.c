@@ -0,0 +1,326 @@
+/*
+ * AppMqttScheduler.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppMqttScheduler AppMqttScheduler
+ * @{
+ *
+ * @brief Outbound publish scheduler. The only caller of @ref AppMqtt_Publish().
+ * @details Publishers pass their messages with a class, see @ref AppMqttScheduler_Class_T. One task publishes them one at a time,
+ * so publishers no longer race for the mqtt module and get busy retcodes back.
+ * @details Each class has its own queue. The task always takes the next message from the class with the highest priority that has a message waiting
+ * and is within its rate budget: command responses and alarms go ahead of status messages and telemetry, a message already being published is not interrupted.
+ * @details The rate budgets are token buckets of messages and payload bytes per second per class, refilled continuously and capped at one second of budget.
+ * A message larger than the byte budget left is published and the class waits until the deficit is paid back.
+ * @details @ref AppMqttScheduler_Publish() blocks the publisher until its message is published and returns the retcode of the publish,
+ * so the publish info and payload stay owned by the publisher and are not copied. The retcode is passed back with a task notification.
+ * @details A message may have a deadline, see AppXDK_MQTT_Publish_T.deadlineMillis, counted from the call of @ref AppMqttScheduler_Publish().
+ * A message still queued at its deadline is not published, otherwise the publish gets the time left and abandons the message when it runs out.
+ * A publish stuck on the broker holds up the queues for at most the deadline of its message, #APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS without one.
+ * @details Per class, the number of messages published, the queue depth, the time messages waited in the queue and the deadlines missed are counted in @ref AppStatus stats.
+ * @details Every #APP_MQTT_SCHEDULER_SERVICE_INTERVAL_IN_MS, the task passes the outcomes of the qos 1 messages in flight to their callbacks, see @ref AppMqtt_ServicePublishWindow().
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+
+#include "XdkAppInfo.h"
+
+#undef BCDS_MODULE_ID /**< undefine any previous module id */
+#define BCDS_MODULE_ID SOLACE_APP_MODULE_ID_APP_MQTT_SCHEDULER
+
+#include "AppMqttScheduler.h"
+#include "AppMqtt.h"
+#include "AppStatus.h"
+#include "AppMisc.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#define APP_MQTT_SCHEDULER_SERVICE_INTERVAL_IN_MS		UINT32_C(1000) /**< interval to service the qos 1 messages in flight */
+
+#define APP_MQTT_SCHEDULER_CREDIT_PER_UNIT		INT64_C(1000) /**< the credits are kept in units x milliseconds, so a budget per second refills by the budget every millisecond */
+
+/**
+ * @brief A message waiting in a class queue.
+ */
+typedef struct {
+	const AppXDK_MQTT_Publish_T * publishInfoPtr; /**< the publish info of the publisher, valid until the publisher is notified */
+	TaskHandle_t publisherTaskHandle; /**< the publisher waiting for the retcode */
+	TickType_t queuedTicks; /**< ticks when the message was queued */
+	uint32_t queueDepth; /**< number of messages in the class queue with this one */
+} AppMqttScheduler_Message_T;
+/**
+ * @brief The rate budget of a class.
+ */
+typedef struct {
+	uint32_t maxMsgsPerSec; /**< messages per second, 0 for no limit */
+	uint32_t maxBytesPerSec; /**< payload bytes per second, 0 for no limit */
+	int64_t msgsCredit; /**< credit in messages x milliseconds */
+	int64_t bytesCredit; /**< credit in bytes x milliseconds, negative after a message larger than the credit */
+	TickType_t refilledTicks; /**< ticks of the last refill */
+} AppMqttScheduler_Budget_T;
+
+static QueueHandle_t appMqttScheduler_QueueHandles[APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES] = { NULL }; /**< the class queues of #AppMqttScheduler_Message_T */
+
+static SemaphoreHandle_t appMqttScheduler_WakeSemaphoreHandle = NULL; /**< given by the publishers after queueing a message */
+
+static TaskHandle_t appMqttScheduler_TaskHandle = NULL; /**< the scheduler task */
+
+/**
+ * @brief The rate budgets per class.
+ */
+static AppMqttScheduler_Budget_T appMqttScheduler_Budgets[APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES] = {
+	{ .maxMsgsPerSec = APP_MQTT_SCHEDULER_COMMAND_RESPONSE_MAX_MSGS_PER_SEC, .maxBytesPerSec = APP_MQTT_SCHEDULER_COMMAND_RESPONSE_MAX_BYTES_PER_SEC },
+	{ .maxMsgsPerSec = APP_MQTT_SCHEDULER_ALARM_MAX_MSGS_PER_SEC, .maxBytesPerSec = APP_MQTT_SCHEDULER_ALARM_MAX_BYTES_PER_SEC },
+	{ .maxMsgsPerSec = APP_MQTT_SCHEDULER_STATUS_MAX_MSGS_PER_SEC, .maxBytesPerSec = APP_MQTT_SCHEDULER_STATUS_MAX_BYTES_PER_SEC },
+	{ .maxMsgsPerSec = APP_MQTT_SCHEDULER_TELEMETRY_MAX_MSGS_PER_SEC, .maxBytesPerSec = APP_MQTT_SCHEDULER_TELEMETRY_MAX_BYTES_PER_SEC },
+};
+
+/* forward declarations */
+static void appMqttScheduler_Task(void * pvParameters);
+
+/**
+ * @brief Initialize the module. Creates the class queues and starts the scheduler task.
+ *
+ * @param[in] taskPriority: the task priority
+ * @param[in] taskStackSize: the task stack size
+ *
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_APP_MQTT_SCHEDULER_FAILED_TO_CREATE_QUEUE)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_FAILED_TO_CREATE_SEMAPHORE)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_FAILED_TO_CREATE_TASK)
+ */
+Retcode_T AppMqttScheduler_Init(uint32_t taskPriority, uint32_t taskStackSize) {
+
+	assert(NULL == appMqttScheduler_TaskHandle);
+
+	for(uint32_t i = 0; i < APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES; i++) {
+		appMqttScheduler_QueueHandles[i] = xQueueCreate(APP_MQTT_SCHEDULER_QUEUE_LEN, sizeof(AppMqttScheduler_Message_T));
+		if(NULL == appMqttScheduler_QueueHandles[i]) return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_APP_MQTT_SCHEDULER_FAILED_TO_CREATE_QUEUE);
+
+		AppMqttScheduler_Budget_T * budgetPtr = &appMqttScheduler_Budgets[i];
+		budgetPtr->msgsCredit = budgetPtr->maxMsgsPerSec * APP_MQTT_SCHEDULER_CREDIT_PER_UNIT;
+		budgetPtr->bytesCredit = budgetPtr->maxBytesPerSec * APP_MQTT_SCHEDULER_CREDIT_PER_UNIT;
+		budgetPtr->refilledTicks = xTaskGetTickCount();
+	}
+
+	appMqttScheduler_WakeSemaphoreHandle = xSemaphoreCreateBinary();
+	if(NULL == appMqttScheduler_WakeSemaphoreHandle) return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_FAILED_TO_CREATE_SEMAPHORE);
+
+	if (pdPASS != xTaskCreate(	appMqttScheduler_Task,
+								(const char* const ) "MqttSchedulerTask",
+								taskStackSize,
+								NULL,
+								taskPriority,
+								&appMqttScheduler_TaskHandle)) {
+		return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_FAILED_TO_CREATE_TASK);
+	}
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Publish a message through the scheduler. Blocks until the message is published.
+ *
+ * @details Queues the message in the queue of its class and waits for the scheduler task to publish it.
+ * The scheduler takes every queued message and notifies its publisher, after at most the deadlines of the messages ahead plus its own deadline.
+ *
+ * @param[in] publishClass: the class of the message
+ * @param[in] publishInfoPtr: the publish info. must not be modified until the function returns.
+ *
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_MQTT_NOT_CONNECTED)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_APP_MQTT_SCHEDULER_QUEUE_FULL)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_APP_MQTT_SCHEDULER_DEADLINE_EXPIRED) if the message reached its deadline in the queue
+ * @return Retcode_T: retcode from @ref AppMqtt_Publish()
+ *
+ * @note Uses the task notification of the calling task. Do not call from the scheduler task, e.g. from a qos 1 completion callback.
+ */
+Retcode_T AppMqttScheduler_Publish(AppMqttScheduler_Class_T publishClass, const AppXDK_MQTT_Publish_T * publishInfoPtr) {
+
+	assert(publishInfoPtr);
+	assert(publishClass < APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES);
+	assert(appMqttScheduler_TaskHandle);
+	assert(xTaskGetCurrentTaskHandle() != appMqttScheduler_TaskHandle);
+
+	if(!AppMqtt_IsConnected()) return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_MQTT_NOT_CONNECTED);
+
+	QueueHandle_t queueHandle = appMqttScheduler_QueueHandles[publishClass];
+
+	AppMqttScheduler_Message_T message = {
+		.publishInfoPtr = publishInfoPtr,
+		.publisherTaskHandle = xTaskGetCurrentTaskHandle(),
+		.queuedTicks = xTaskGetTickCount(),
+		.queueDepth = uxQueueMessagesWaiting(queueHandle) + 1,
+	};
+
+	if(pdTRUE != xQueueSend(queueHandle, &message, 0)) return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_APP_MQTT_SCHEDULER_QUEUE_FULL);
+
+	xSemaphoreGive(appMqttScheduler_WakeSemaphoreHandle);
+
+	uint32_t retcode = (uint32_t) RETCODE_OK;
+	(void) xTaskNotifyWait(0, UINT32_MAX, &retcode, portMAX_DELAY);
+
+	return (Retcode_T) retcode;
+}
+/**
+ * @brief Get the number of messages waiting in the queue of a class.
+ * @param[in] publishClass: the class
+ * @return uint32_t: the number of messages waiting
+ */
+uint32_t AppMqttScheduler_GetQueueDepth(AppMqttScheduler_Class_T publishClass) {
+
+	assert(publishClass < APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES);
+
+	if(NULL == appMqttScheduler_QueueHandles[publishClass]) return 0;
+
+	return uxQueueMessagesWaiting(appMqttScheduler_QueueHandles[publishClass]);
+}
+/**
+ * @brief Add the credit earned since the last refill to a budget, capped at one second of budget.
+ * @param[in,out] budgetPtr: the budget
+ * @param[in] nowTicks: the current ticks
+ */
+static void appMqttScheduler_RefillBudget(AppMqttScheduler_Budget_T * budgetPtr, TickType_t nowTicks) {
+
+	int64_t elapsedMillis = (int64_t) ((nowTicks - budgetPtr->refilledTicks) * portTICK_PERIOD_MS);
+	budgetPtr->refilledTicks = nowTicks;
+
+	if(budgetPtr->maxMsgsPerSec > 0) {
+		int64_t maxCredit = budgetPtr->maxMsgsPerSec * APP_MQTT_SCHEDULER_CREDIT_PER_UNIT;
+		budgetPtr->msgsCredit += elapsedMillis * budgetPtr->maxMsgsPerSec;
+		if(budgetPtr->msgsCredit > maxCredit) budgetPtr->msgsCredit = maxCredit;
+	}
+	if(budgetPtr->maxBytesPerSec > 0) {
+		int64_t maxCredit = budgetPtr->maxBytesPerSec * APP_MQTT_SCHEDULER_CREDIT_PER_UNIT;
+		budgetPtr->bytesCredit += elapsedMillis * budgetPtr->maxBytesPerSec;
+		if(budgetPtr->bytesCredit > maxCredit) budgetPtr->bytesCredit = maxCredit;
+	}
+}
+/**
+ * @brief Get the time until a budget allows the next message.
+ * @param[in] budgetPtr: the budget
+ * @return uint32_t: the wait in millis, 0 if the next message is within budget
+ */
+static uint32_t appMqttScheduler_GetBudgetWaitMillis(const AppMqttScheduler_Budget_T * budgetPtr) {
+
+	int64_t waitMillis = 0;
+
+	if(budgetPtr->maxMsgsPerSec > 0 && budgetPtr->msgsCredit < APP_MQTT_SCHEDULER_CREDIT_PER_UNIT) {
+		waitMillis = (APP_MQTT_SCHEDULER_CREDIT_PER_UNIT - budgetPtr->msgsCredit + budgetPtr->maxMsgsPerSec - 1) / budgetPtr->maxMsgsPerSec;
+	}
+	if(budgetPtr->maxBytesPerSec > 0 && budgetPtr->bytesCredit < 0) {
+		int64_t bytesWaitMillis = (-budgetPtr->bytesCredit + budgetPtr->maxBytesPerSec - 1) / budgetPtr->maxBytesPerSec;
+		if(bytesWaitMillis > waitMillis) waitMillis = bytesWaitMillis;
+	}
+	return (uint32_t) waitMillis;
+}
+/**
+ * @brief Charge a message to a budget.
+ * @param[in,out] budgetPtr: the budget
+ * @param[in] payloadLength: the payload length of the message
+ */
+static void appMqttScheduler_ChargeBudget(AppMqttScheduler_Budget_T * budgetPtr, uint32_t payloadLength) {
+
+	if(budgetPtr->maxMsgsPerSec > 0) budgetPtr->msgsCredit -= APP_MQTT_SCHEDULER_CREDIT_PER_UNIT;
+
+	if(budgetPtr->maxBytesPerSec > 0) budgetPtr->bytesCredit -= payloadLength * APP_MQTT_SCHEDULER_CREDIT_PER_UNIT;
+}
+/**
+ * @brief Publish a message taken from a class queue and notify its publisher of the retcode.
+ * @details A message past its deadline is not published. Otherwise the publish gets a copy of the publish info with the time left as its deadline.
+ * @param[in] publishClass: the class
+ * @param[in] messagePtr: the message
+ */
+static void appMqttScheduler_PublishMessage(AppMqttScheduler_Class_T publishClass, const AppMqttScheduler_Message_T * messagePtr) {
+
+	uint32_t deadlineMillis = messagePtr->publishInfoPtr->deadlineMillis;
+	uint32_t waitMillis = (xTaskGetTickCount() - messagePtr->queuedTicks) * portTICK_PERIOD_MS;
+
+	Retcode_T retcode = RETCODE_OK;
+
+	if(deadlineMillis > 0 && waitMillis >= deadlineMillis) {
+		AppStatus_Stats_IncrementMqttPublishDeadlineMissedCounter(publishClass);
+		retcode = RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_APP_MQTT_SCHEDULER_DEADLINE_EXPIRED);
+		(void) xTaskNotify(messagePtr->publisherTaskHandle, (uint32_t) retcode, eSetValueWithOverwrite);
+		return;
+	}
+
+	AppStatus_Stats_UpdateMqttPublishClassStats(publishClass, messagePtr->queueDepth, waitMillis);
+
+	appMqttScheduler_ChargeBudget(&appMqttScheduler_Budgets[publishClass], messagePtr->publishInfoPtr->payloadLength);
+
+	AppXDK_MQTT_Publish_T publishInfo = *messagePtr->publishInfoPtr;
+	if(deadlineMillis > 0) publishInfo.deadlineMillis = deadlineMillis - waitMillis;
+
+	retcode = AppMqtt_Publish(&publishInfo);
+
+	if(RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED == Retcode_GetCode(retcode) || RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED_IN_FLIGHT == Retcode_GetCode(retcode)) {
+		AppStatus_Stats_IncrementMqttPublishDeadlineMissedCounter(publishClass);
+	}
+
+	(void) xTaskNotify(messagePtr->publisherTaskHandle, (uint32_t) retcode, eSetValueWithOverwrite);
+}
+/**
+ * @brief The scheduler task.
+ * @details Services the qos 1 messages in flight every #APP_MQTT_SCHEDULER_SERVICE_INTERVAL_IN_MS, whether messages are published or not, connected or not.
+ * @details Publishes the next message of the class with the highest priority and budget left, then starts over from the highest priority class.
+ * Otherwise waits for a new message, or until the first budget allows its next message.
+ * @param[in] pvParameters: unused
+ */
+static void appMqttScheduler_Task(void * pvParameters) {
+
+	BCDS_UNUSED(pvParameters);
+
+	TickType_t servicedTicks = xTaskGetTickCount();
+
+	while(1) {
+
+		TickType_t nowTicks = xTaskGetTickCount();
+		uint32_t waitMillis = APP_MQTT_SCHEDULER_SERVICE_INTERVAL_IN_MS;
+		bool isPublished = false;
+
+		// also while messages keep coming: qos 0 publishes don't service the window, and after a disconnect the failures are only passed on here
+		if((nowTicks - servicedTicks) >= MILLISECONDS(APP_MQTT_SCHEDULER_SERVICE_INTERVAL_IN_MS)) {
+			AppMqtt_ServicePublishWindow();
+			servicedTicks = nowTicks;
+		}
+
+		for(uint32_t i = 0; i < APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES && !isPublished; i++) {
+
+			if(0 == uxQueueMessagesWaiting(appMqttScheduler_QueueHandles[i])) continue;
+
+			AppMqttScheduler_Budget_T * budgetPtr = &appMqttScheduler_Budgets[i];
+			appMqttScheduler_RefillBudget(budgetPtr, nowTicks);
+
+			uint32_t budgetWaitMillis = appMqttScheduler_GetBudgetWaitMillis(budgetPtr);
+			if(budgetWaitMillis > 0) {
+				// lower classes may go ahead meanwhile
+				if(budgetWaitMillis < waitMillis) waitMillis = budgetWaitMillis;
+				continue;
+			}
+
+			AppMqttScheduler_Message_T message;
+			if(pdTRUE == xQueueReceive(appMqttScheduler_QueueHandles[i], &message, 0)) {
+				appMqttScheduler_PublishMessage((AppMqttScheduler_Class_T) i, &message);
+				isPublished = true;
+			}
+		}
+
+		if(isPublished) continue;
+
+		(void) xSemaphoreTake(appMqttScheduler_WakeSemaphoreHandle, MILLISECONDS(waitMillis));
+	}
+}
+
+/**@} */
+/** ************************************************************************* */
+
@@ -0,0 +1,56 @@
+/*
+ * AppMqttScheduler.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppMqttScheduler
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPMQTTSCHEDULER_H_
+#define SOURCE_APPMQTTSCHEDULER_H_
+
+#include "AppXDK_MQTT.h"
+
+/**
+ * @brief The classes of outbound messages, in the order of their priority.
+ */
+typedef enum {
+	AppMqttScheduler_Class_CommandResponse = 0, /**< responses to commands and configurations */
+	AppMqttScheduler_Class_Alarm, /**< button events, error and warning status messages */
+	AppMqttScheduler_Class_Status, /**< other status messages */
+	AppMqttScheduler_Class_Telemetry, /**< telemetry, capture, spectrum and orientation events */
+} AppMqttScheduler_Class_T;
+
+#define APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES					UINT32_C(4) /**< number of classes in #AppMqttScheduler_Class_T */
+
+#define APP_MQTT_SCHEDULER_QUEUE_LEN							UINT32_C(4) /**< max number of messages waiting per class */
+
+/**
+ * @brief Rate budgets per class. 0 for no limit. A class may burst up to one second of its budget.
+ */
+#define APP_MQTT_SCHEDULER_COMMAND_RESPONSE_MAX_MSGS_PER_SEC	UINT32_C(0) /**< command responses are not limited */
+#define APP_MQTT_SCHEDULER_COMMAND_RESPONSE_MAX_BYTES_PER_SEC	UINT32_C(0) /**< command responses are not limited */
+#define APP_MQTT_SCHEDULER_ALARM_MAX_MSGS_PER_SEC				UINT32_C(0) /**< alarms are not limited */
+#define APP_MQTT_SCHEDULER_ALARM_MAX_BYTES_PER_SEC				UINT32_C(0) /**< alarms are not limited */
+#define APP_MQTT_SCHEDULER_STATUS_MAX_MSGS_PER_SEC				UINT32_C(10) /**< status messages per second */
+#define APP_MQTT_SCHEDULER_STATUS_MAX_BYTES_PER_SEC				UINT32_C(0) /**< status bytes are not limited */
+#define APP_MQTT_SCHEDULER_TELEMETRY_MAX_MSGS_PER_SEC			UINT32_C(50) /**< telemetry messages per second */
+#define APP_MQTT_SCHEDULER_TELEMETRY_MAX_BYTES_PER_SEC			UINT32_C(32768) /**< telemetry payload bytes per second */
+
+Retcode_T AppMqttScheduler_Init(uint32_t taskPriority, uint32_t taskStackSize);
+
+Retcode_T AppMqttScheduler_Publish(AppMqttScheduler_Class_T publishClass, const AppXDK_MQTT_Publish_T * publishInfoPtr);
+
+uint32_t AppMqttScheduler_GetQueueDepth(AppMqttScheduler_Class_T publishClass);
+
+#endif /* SOURCE_APPMQTTSCHEDULER_H_ */
+
+/**@} */
+/** ************************************************************************* */
+
@@ -57,6 +57,49 @@ static const AppRuntimeConfig_TelemetryConfig_T appRuntimeConfig_DefaultTargetTe
 		.numberOfSamplesPerEvent = APP_RT_CFG_DEFAULT_NUM_SAMPLES_PER_EVENT,
 	    .qos = APP_RT_CFG_DEFAULT_QOS,
 	    .payloadFormat = APP_RT_CFG_DEFAULT_PAYLOAD_FORMAT,
+	    .payloadTimestampFormat = APP_RT_CFG_DEFAULT_PAYLOAD_TIMESTAMP_FORMAT,
+	    .queueBacklogEvents = APP_RT_CFG_DEFAULT_QUEUE_BACKLOG_EVENTS,
+	    .queueDropPolicy = APP_RT_CFG_DEFAULT_QUEUE_DROP_POLICY,
+	    .batchMaxBytes = APP_RT_CFG_DEFAULT_BATCH_MAX_BYTES,
+	    .batchMaxAgeMillis = APP_RT_CFG_DEFAULT_BATCH_MAX_AGE_MILLIS,
+	    .spillReplayEventsPerCycle = APP_RT_CFG_DEFAULT_SPILL_REPLAY_EVENTS_PER_CYCLE,
+	    .aggregateWindowMillis = APP_RT_CFG_DEFAULT_AGGREGATE_WINDOW_MILLIS,
+		.aggregates = {
+			.isCount = true,
+			.isMin = true,
+			.isMax = true,
+			.isMean = true,
+			.isStddev = true,
+			.isP50 = false,
+			.isP95 = false,
+			.isP99 = false,
+		},
+	    .quantileSketchBins = APP_RT_CFG_DEFAULT_QUANTILE_SKETCH_BINS,
+		.deadbands = {
+			.light = { .absolute = 0, .relativePercent = 0 },
+			.accelerator = { .absolute = 0, .relativePercent = 0 },
+			.gyro = { .absolute = 0, .relativePercent = 0 },
+			.magneto = { .absolute = 0, .relativePercent = 0 },
+			.humidity = { .absolute = 0, .relativePercent = 0 },
+			.temperature = { .absolute = 0, .relativePercent = 0 },
+		},
+	    .deadbandHeartbeatMillis = APP_RT_CFG_DEFAULT_DEADBAND_HEARTBEAT_MILLIS,
+	    .captureThresholdMilliG = APP_RT_CFG_DEFAULT_CAPTURE_THRESHOLD_MILLI_G,
+	    .capturePreTriggerMillis = APP_RT_CFG_DEFAULT_CAPTURE_PRE_TRIGGER_MILLIS,
+	    .capturePostTriggerMillis = APP_RT_CFG_DEFAULT_CAPTURE_POST_TRIGGER_MILLIS,
+	    .spectrumWindowSamples = APP_RT_CFG_DEFAULT_SPECTRUM_WINDOW_SAMPLES,
+	    .spectrumPeaks = APP_RT_CFG_DEFAULT_SPECTRUM_PEAKS,
+	    .fusionOutputMillis = APP_RT_CFG_DEFAULT_FUSION_OUTPUT_MILLIS,
+	    .fusionEulerAngles = APP_RT_CFG_DEFAULT_FUSION_EULER_ANGLES,
+		.sensorPeriodsMillis = { .light = 0, .accelerator = 0, .gyro = 0, .magneto = 0, .humidity = 0, .temperature = 0 },
+	    .samplingOverrunPolicy = APP_RT_CFG_DEFAULT_SAMPLING_OVERRUN_POLICY,
+	    .samplingWallClockAligned = APP_RT_CFG_DEFAULT_SAMPLING_WALL_CLOCK_ALIGNED,
+	    .qos1MaxInFlight = APP_RT_CFG_DEFAULT_QOS1_MAX_IN_FLIGHT,
+	    .rateControl = APP_RT_CFG_DEFAULT_RATE_CONTROL,
+	    .numberOfFidelityLevels = 0,
+	    .fidelityLevels = { { .mode = AppRuntimeConfig_Telemetry_FidelityMode_Decimated, .decimation = 0, .windowMillis = 0 } },
+	    .fidelityMaxLatencyMillis = APP_RT_CFG_DEFAULT_FIDELITY_MAX_LATENCY_MILLIS,
+	    .fidelityMaxBacklogEvents = APP_RT_CFG_DEFAULT_FIDELITY_MAX_BACKLOG_EVENTS,
 		.sensors = {
 			.isLight = true,
 			.isAccelerator = true,
@@ -147,6 +190,49 @@ static const AppRuntimeConfig_TelemetryConfig_T appRuntimeConfig_EmptyTargetTele
 		.numberOfSamplesPerEvent = 0,
 	    .qos = 0,
 	    .payloadFormat = AppRuntimeConfig_Telemetry_PayloadFormat_NULL,
+	    .payloadTimestampFormat = APP_RT_CFG_DEFAULT_PAYLOAD_TIMESTAMP_FORMAT,
+	    .queueBacklogEvents = 0,
+	    .queueDropPolicy = APP_RT_CFG_DEFAULT_QUEUE_DROP_POLICY,
+	    .batchMaxBytes = 0,
+	    .batchMaxAgeMillis = 0,
+	    .spillReplayEventsPerCycle = 0,
+	    .aggregateWindowMillis = 0,
+		.aggregates = {
+			.isCount = false,
+			.isMin = false,
+			.isMax = false,
+			.isMean = false,
+			.isStddev = false,
+			.isP50 = false,
+			.isP95 = false,
+			.isP99 = false,
+		},
+	    .quantileSketchBins = 0,
+		.deadbands = {
+			.light = { .absolute = 0, .relativePercent = 0 },
+			.accelerator = { .absolute = 0, .relativePercent = 0 },
+			.gyro = { .absolute = 0, .relativePercent = 0 },
+			.magneto = { .absolute = 0, .relativePercent = 0 },
+			.humidity = { .absolute = 0, .relativePercent = 0 },
+			.temperature = { .absolute = 0, .relativePercent = 0 },
+		},
+	    .deadbandHeartbeatMillis = 0,
+	    .captureThresholdMilliG = 0,
+	    .capturePreTriggerMillis = 0,
+	    .capturePostTriggerMillis = 0,
+	    .spectrumWindowSamples = 0,
+	    .spectrumPeaks = 0,
+	    .fusionOutputMillis = 0,
+	    .fusionEulerAngles = false,
+		.sensorPeriodsMillis = { .light = 0, .accelerator = 0, .gyro = 0, .magneto = 0, .humidity = 0, .temperature = 0 },
+	    .samplingOverrunPolicy = APP_RT_CFG_DEFAULT_SAMPLING_OVERRUN_POLICY,
+	    .samplingWallClockAligned = false,
+	    .qos1MaxInFlight = 0,
+	    .rateControl = false,
+	    .numberOfFidelityLevels = 0,
+	    .fidelityLevels = { { .mode = AppRuntimeConfig_Telemetry_FidelityMode_Decimated, .decimation = 0, .windowMillis = 0 } },
+	    .fidelityMaxLatencyMillis = 0,
+	    .fidelityMaxBacklogEvents = 0,
 		.sensors = {
 			.isLight = false,
 			.isAccelerator = false,
@@ -309,6 +395,21 @@ static cJSON * appRuntimeConfig_GetApplyFlagAsJsonString(AppRuntimeConfig_Apply_
 	else assert(0);
 	return NULL;
 }
+/**
+ * @brief Adds the deadband of a sensor to a JSON object, if it has one.
+ * @param[in,out] jsonHandle: the JSON object
+ * @param[in] sensorName: the name of the sensor, as in the 'sensors' element
+ * @param[in] deadbandPtr: the deadband
+ */
+static void appRuntimeConfig_AddDeadbandToJsonObject(cJSON * jsonHandle, const char * sensorName, const AppRuntimeConfig_Deadband_T * deadbandPtr) {
+
+	if(0 == deadbandPtr->absolute && 0 == deadbandPtr->relativePercent) return;
+
+	cJSON * deadbandJsonHandle = cJSON_CreateObject();
+	cJSON_AddNumberToObject(deadbandJsonHandle, "absolute", deadbandPtr->absolute);
+	cJSON_AddNumberToObject(deadbandJsonHandle, "relativePercent", deadbandPtr->relativePercent);
+	cJSON_AddItemToObject(jsonHandle, sensorName, deadbandJsonHandle);
+}
 /**
  * @brief Returns the JSON for the telemetry config.
  * @param[in] configPtr: the telemetry config pointer
@@ -350,8 +451,110 @@ static cJSON * appRuntimeConfig_GetTargetTelemetryConfigAsJsonObject(const AppRu
 		cJSON_AddItemToObject(receivedJsonHandle, "payloadFormat", cJSON_CreateString(APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V1_JSON_VERBOSE_STR));
 	} else if(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact == configPtr->received.payloadFormat) {
 		cJSON_AddItemToObject(receivedJsonHandle, "payloadFormat", cJSON_CreateString(APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V1_JSON_COMPACT_STR));
+	} else if(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Json_Columnar == configPtr->received.payloadFormat) {
+		cJSON_AddItemToObject(receivedJsonHandle, "payloadFormat", cJSON_CreateString(APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V2_JSON_COLUMNAR_STR));
+	} else if(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor == configPtr->received.payloadFormat) {
+		cJSON_AddItemToObject(receivedJsonHandle, "payloadFormat", cJSON_CreateString(APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V2_CBOR_STR));
+	} else if(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta == configPtr->received.payloadFormat) {
+		cJSON_AddItemToObject(receivedJsonHandle, "payloadFormat", cJSON_CreateString(APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V2_DELTA_STR));
 	} else assert(0);
 
+	if(AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601 == configPtr->received.payloadTimestampFormat) {
+		cJSON_AddItemToObject(receivedJsonHandle, "payloadTimestampFormat", cJSON_CreateString(APP_RT_CFG_TELEMETRY_TIMESTAMP_FORMAT_ISO_8601_STR));
+	} else if(AppRuntimeConfig_Telemetry_TimestampFormat_EpochMillis == configPtr->received.payloadTimestampFormat) {
+		cJSON_AddItemToObject(receivedJsonHandle, "payloadTimestampFormat", cJSON_CreateString(APP_RT_CFG_TELEMETRY_TIMESTAMP_FORMAT_EPOCH_MILLIS_STR));
+	} else assert(0);
+
+	cJSON_AddNumberToObject(receivedJsonHandle, "queueBacklogEvents", configPtr->received.queueBacklogEvents);
+
+	if(AppRuntimeConfig_Telemetry_QueueDropPolicy_DropOldest == configPtr->received.queueDropPolicy) {
+		cJSON_AddItemToObject(receivedJsonHandle, "queueDropPolicy", cJSON_CreateString(APP_RT_CFG_TELEMETRY_QUEUE_DROP_POLICY_DROP_OLDEST_STR));
+	} else if(AppRuntimeConfig_Telemetry_QueueDropPolicy_DropNewest == configPtr->received.queueDropPolicy) {
+		cJSON_AddItemToObject(receivedJsonHandle, "queueDropPolicy", cJSON_CreateString(APP_RT_CFG_TELEMETRY_QUEUE_DROP_POLICY_DROP_NEWEST_STR));
+	} else assert(0);
+
+	cJSON_AddNumberToObject(receivedJsonHandle, "batchMaxBytes", configPtr->received.batchMaxBytes);
+
+	cJSON_AddNumberToObject(receivedJsonHandle, "batchMaxAgeMillis", configPtr->received.batchMaxAgeMillis);
+
+	cJSON_AddNumberToObject(receivedJsonHandle, "spillReplayEventsPerCycle", configPtr->received.spillReplayEventsPerCycle);
+
+	cJSON_AddNumberToObject(receivedJsonHandle, "aggregateWindowMillis", configPtr->received.aggregateWindowMillis);
+
+	cJSON * aggregatesJsonArrayHandle = cJSON_CreateArray();
+	if(configPtr->received.aggregates.isCount) cJSON_AddItemToArray(aggregatesJsonArrayHandle, cJSON_CreateString(APP_RT_CFG_TELEMETRY_AGGREGATE_COUNT_STR));
+	if(configPtr->received.aggregates.isMin) cJSON_AddItemToArray(aggregatesJsonArrayHandle, cJSON_CreateString(APP_RT_CFG_TELEMETRY_AGGREGATE_MIN_STR));
+	if(configPtr->received.aggregates.isMax) cJSON_AddItemToArray(aggregatesJsonArrayHandle, cJSON_CreateString(APP_RT_CFG_TELEMETRY_AGGREGATE_MAX_STR));
+	if(configPtr->received.aggregates.isMean) cJSON_AddItemToArray(aggregatesJsonArrayHandle, cJSON_CreateString(APP_RT_CFG_TELEMETRY_AGGREGATE_MEAN_STR));
+	if(configPtr->received.aggregates.isStddev) cJSON_AddItemToArray(aggregatesJsonArrayHandle, cJSON_CreateString(APP_RT_CFG_TELEMETRY_AGGREGATE_STDDEV_STR));
+	if(configPtr->received.aggregates.isP50) cJSON_AddItemToArray(aggregatesJsonArrayHandle, cJSON_CreateString(APP_RT_CFG_TELEMETRY_AGGREGATE_P50_STR));
+	if(configPtr->received.aggregates.isP95) cJSON_AddItemToArray(aggregatesJsonArrayHandle, cJSON_CreateString(APP_RT_CFG_TELEMETRY_AGGREGATE_P95_STR));
+	if(configPtr->received.aggregates.isP99) cJSON_AddItemToArray(aggregatesJsonArrayHandle, cJSON_CreateString(APP_RT_CFG_TELEMETRY_AGGREGATE_P99_STR));
+	cJSON_AddItemToObject(receivedJsonHandle, "aggregates", aggregatesJsonArrayHandle);
+
+	cJSON_AddNumberToObject(receivedJsonHandle, "quantileSketchBins", configPtr->received.quantileSketchBins);
+
+	cJSON * deadbandsJsonHandle = cJSON_CreateObject();
+	appRuntimeConfig_AddDeadbandToJsonObject(deadbandsJsonHandle, "light", &configPtr->received.deadbands.light);
+	appRuntimeConfig_AddDeadbandToJsonObject(deadbandsJsonHandle, "accelerator", &configPtr->received.deadbands.accelerator);
+	appRuntimeConfig_AddDeadbandToJsonObject(deadbandsJsonHandle, "gyroscope", &configPtr->received.deadbands.gyro);
+	appRuntimeConfig_AddDeadbandToJsonObject(deadbandsJsonHandle, "magnetometer", &configPtr->received.deadbands.magneto);
+	appRuntimeConfig_AddDeadbandToJsonObject(deadbandsJsonHandle, "humidity", &configPtr->received.deadbands.humidity);
+	appRuntimeConfig_AddDeadbandToJsonObject(deadbandsJsonHandle, "temperature", &configPtr->received.deadbands.temperature);
+	cJSON_AddItemToObject(receivedJsonHandle, "deadbands", deadbandsJsonHandle);
+
+	cJSON_AddNumberToObject(receivedJsonHandle, "deadbandHeartbeatMillis", configPtr->received.deadbandHeartbeatMillis);
+
+	cJSON_AddNumberToObject(receivedJsonHandle, "captureThresholdMilliG", configPtr->received.captureThresholdMilliG);
+	cJSON_AddNumberToObject(receivedJsonHandle, "capturePreTriggerMillis", configPtr->received.capturePreTriggerMillis);
+	cJSON_AddNumberToObject(receivedJsonHandle, "capturePostTriggerMillis", configPtr->received.capturePostTriggerMillis);
+	cJSON_AddNumberToObject(receivedJsonHandle, "spectrumWindowSamples", configPtr->received.spectrumWindowSamples);
+	cJSON_AddNumberToObject(receivedJsonHandle, "spectrumPeaks", configPtr->received.spectrumPeaks);
+	cJSON_AddNumberToObject(receivedJsonHandle, "fusionOutputMillis", configPtr->received.fusionOutputMillis);
+	cJSON_AddBoolToObject(receivedJsonHandle, "fusionEulerAngles", configPtr->received.fusionEulerAngles);
+
+	cJSON * sensorPeriodsJsonHandle = cJSON_CreateObject();
+	if(configPtr->received.sensorPeriodsMillis.light > 0) cJSON_AddNumberToObject(sensorPeriodsJsonHandle, "light", configPtr->received.sensorPeriodsMillis.light);
+	if(configPtr->received.sensorPeriodsMillis.accelerator > 0) cJSON_AddNumberToObject(sensorPeriodsJsonHandle, "accelerator", configPtr->received.sensorPeriodsMillis.accelerator);
+	if(configPtr->received.sensorPeriodsMillis.gyro > 0) cJSON_AddNumberToObject(sensorPeriodsJsonHandle, "gyroscope", configPtr->received.sensorPeriodsMillis.gyro);
+	if(configPtr->received.sensorPeriodsMillis.magneto > 0) cJSON_AddNumberToObject(sensorPeriodsJsonHandle, "magnetometer", configPtr->received.sensorPeriodsMillis.magneto);
+	if(configPtr->received.sensorPeriodsMillis.humidity > 0) cJSON_AddNumberToObject(sensorPeriodsJsonHandle, "humidity", configPtr->received.sensorPeriodsMillis.humidity);
+	if(configPtr->received.sensorPeriodsMillis.temperature > 0) cJSON_AddNumberToObject(sensorPeriodsJsonHandle, "temperature", configPtr->received.sensorPeriodsMillis.temperature);
+	cJSON_AddItemToObject(receivedJsonHandle, "sensorPeriodsMillis", sensorPeriodsJsonHandle);
+
+	if(AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_Skip == configPtr->received.samplingOverrunPolicy) {
+		cJSON_AddItemToObject(receivedJsonHandle, "samplingOverrunPolicy", cJSON_CreateString(APP_RT_CFG_TELEMETRY_SAMPLING_OVERRUN_POLICY_SKIP_STR));
+	} else if(AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_CatchUp == configPtr->received.samplingOverrunPolicy) {
+		cJSON_AddItemToObject(receivedJsonHandle, "samplingOverrunPolicy", cJSON_CreateString(APP_RT_CFG_TELEMETRY_SAMPLING_OVERRUN_POLICY_CATCH_UP_STR));
+	} else assert(0);
+
+	cJSON_AddBoolToObject(receivedJsonHandle, "samplingWallClockAligned", configPtr->received.samplingWallClockAligned);
+
+	cJSON_AddNumberToObject(receivedJsonHandle, "qos1MaxInFlight", configPtr->received.qos1MaxInFlight);
+
+	cJSON_AddBoolToObject(receivedJsonHandle, "rateControl", configPtr->received.rateControl);
+
+	cJSON * fidelityLevelsJsonArrayHandle = cJSON_CreateArray();
+	for(uint8_t i = 0; i < configPtr->received.numberOfFidelityLevels; i++) {
+		const AppRuntimeConfig_FidelityLevel_T * levelPtr = &configPtr->received.fidelityLevels[i];
+		cJSON * levelJsonHandle = cJSON_CreateObject();
+		if(AppRuntimeConfig_Telemetry_FidelityMode_Decimated == levelPtr->mode) {
+			cJSON_AddItemToObject(levelJsonHandle, "mode", cJSON_CreateString(APP_RT_CFG_TELEMETRY_FIDELITY_MODE_DECIMATED_STR));
+			cJSON_AddNumberToObject(levelJsonHandle, "decimation", levelPtr->decimation);
+		} else if(AppRuntimeConfig_Telemetry_FidelityMode_Aggregate == levelPtr->mode) {
+			cJSON_AddItemToObject(levelJsonHandle, "mode", cJSON_CreateString(APP_RT_CFG_TELEMETRY_FIDELITY_MODE_AGGREGATE_STR));
+			cJSON_AddNumberToObject(levelJsonHandle, "windowMillis", levelPtr->windowMillis);
+		} else if(AppRuntimeConfig_Telemetry_FidelityMode_Heartbeat == levelPtr->mode) {
+			cJSON_AddItemToObject(levelJsonHandle, "mode", cJSON_CreateString(APP_RT_CFG_TELEMETRY_FIDELITY_MODE_HEARTBEAT_STR));
+			cJSON_AddNumberToObject(levelJsonHandle, "windowMillis", levelPtr->windowMillis);
+		} else assert(0);
+		cJSON_AddItemToArray(fidelityLevelsJsonArrayHandle, levelJsonHandle);
+	}
+	cJSON_AddItemToObject(receivedJsonHandle, "fidelityLevels", fidelityLevelsJsonArrayHandle);
+
+	cJSON_AddNumberToObject(receivedJsonHandle, "fidelityMaxLatencyMillis", configPtr->received.fidelityMaxLatencyMillis);
+	cJSON_AddNumberToObject(receivedJsonHandle, "fidelityMaxBacklogEvents", configPtr->received.fidelityMaxBacklogEvents);
+
 	cJSON * sensorsJsonArrayHandle = cJSON_CreateArray();
 	if(configPtr->received.sensors.isLight) cJSON_AddItemToArray(sensorsJsonArrayHandle, cJSON_CreateString("light"));
 	if(configPtr->received.sensors.isAccelerator) cJSON_AddItemToArray(sensorsJsonArrayHandle, cJSON_CreateString("accelerator"));
@@ -768,6 +971,19 @@ AppRuntimeConfig_Sensors_T * AppRuntimeConfig_DuplicateSensors(const AppRuntimeC
 
 	return newSensorsPtr;
 }
+/**
+ * @brief Calculates the number of samples of a capture window: the pre-trigger samples, the trigger sample and the post-trigger samples.
+ * @param[in] preTriggerMillis: capturePreTriggerMillis of the telemetry config
+ * @param[in] postTriggerMillis: capturePostTriggerMillis of the telemetry config
+ * @param[in] samplingPeriodicityMillis: the sampling period, also the period of the captured samples
+ * @return uint32_t: the number of samples
+ */
+uint32_t AppRuntimeConfig_GetCaptureNumberOfSamples(const uint32_t preTriggerMillis, const uint32_t postTriggerMillis, const uint32_t samplingPeriodicityMillis) {
+
+	assert(samplingPeriodicityMillis > 0);
+
+	return (preTriggerMillis / samplingPeriodicityMillis) + 1 + (postTriggerMillis / samplingPeriodicityMillis);
+}
 /**
  * @brief Create a new status config either from the default or empty structure.
  * @param[in] isFromDefault: flag to indicate if it is to be created from the default structure
@@ -1041,21 +1257,18 @@ static void appRuntimeConfig_ValidateTelemetryRTParams(AppRuntimeConfig_Telemetr
 
 }
 /**
- * @brief Create a temporary test queue and populates it with telemetry samples.
- * Used to validate that a configuration for number of samples per queue in combination with
- * the payload format does not exceed the max data length (#APP_MQTT_MAX_PUBLISH_DATA_LENGTH) for a single MQTT message.
+ * @brief Calculates the size of a batch of a single telemetry sample with @ref AppTelemetryPayload_GetBatchSize_Test().
+ * Used to validate that a single sample in the configured payload format fits into the batch byte budget, which is <= the max data length (#APP_MQTT_MAX_PUBLISH_DATA_LENGTH) for a single MQTT message.
+ * @details The telemetry queue flushes a batch early once the next sample would exceed the byte budget, so the number of samples per event is no longer limited by the message size.
+ * @details In the aggregation mode the size of a window of the single sample is calculated with @ref AppTelemetryPayload_GetAggregateSize_Test() instead.
  *
- * @param[in] numSamplesPerEvent: the number of telemetry samples in one message
- * @param[in] sensorsConfigPtr: the sensor configuration, determines which sensor readings to add to the samples
- * @param[in] payloadFormat: which payload format is to be applied
+ * @param[in] configPtr: the telemetry configuration: byte budget, sensors, payload format and aggregation
  * @param[in,out] statusPtr: the status pointer, contains the result status of the validation
  *
  */
-static void appRuntimeConfig_ValidateTelemetryQueueSize(
-		uint8_t numSamplesPerEvent,
-		AppRuntimeConfig_Sensors_T * sensorsConfigPtr,
-		AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat,
-		AppRuntimeConfigStatus_T * statusPtr) {
+static void appRuntimeConfig_ValidateTelemetryQueueSize(const AppRuntimeConfig_TelemetryConfig_T * configPtr, AppRuntimeConfigStatus_T * statusPtr) {
+
+	uint32_t batchMaxBytes = configPtr->received.batchMaxBytes;
 
 	statusPtr->success = true;
 	Retcode_T retcode = RETCODE_OK;
@@ -1065,36 +1278,119 @@ static void appRuntimeConfig_ValidateTelemetryQueueSize(
 	retcode = Sensor_GetData(&sensorValue);
 	if(RETCODE_OK != retcode) assert(0);
 
-	AppTelemetryQueueCreateNewTestQueue(numSamplesPerEvent);
-
-	for(int i = 0; i < numSamplesPerEvent; i++) {
-
-		AppTelemetryPayload_T * payloadPtr = AppTelemetryPayload_CreateNew_Test(xTaskGetTickCount(), &sensorValue, sensorsConfigPtr, payloadFormat);
-
-		AppTelemetryQueueTestQueueAddSample(payloadPtr);
+	uint32_t queueDataLength = 0;
+	if(configPtr->received.aggregateWindowMillis > 0) {
+		queueDataLength = AppTelemetryPayload_GetAggregateSize_Test(xTaskGetTickCount(), &sensorValue, &configPtr->received.sensors, &configPtr->received.aggregates, configPtr->received.payloadFormat);
+	} else {
+		queueDataLength = AppTelemetryPayload_GetBatchSize_Test(xTaskGetTickCount(), &sensorValue, &configPtr->received.sensors, configPtr->received.payloadFormat);
 	}
 
-	uint32_t queueDataLength = AppTelemetryQueueTestQueueGetDataSize();
-
 	#ifdef DEBUG_APP_RUNTIME_CONFIG
 	printf("[INFO] - appRuntimeConfig_ValidateTelemetryQueueSize: \r\n");
 	printf(" - queueDataLength:%lu \r\n", queueDataLength);
-	printf(" - queue contents:\r\n");
-	AppTelemetryQueueTestQueuePrint();
 	#endif
 
-	AppTelemetryQueueTestQueueDelete();
-
-	if(queueDataLength > APP_MQTT_MAX_PUBLISH_DATA_LENGTH) {
+	if(queueDataLength > batchMaxBytes) {
 		#ifdef DEBUG_APP_RUNTIME_CONFIG
-		printf("[ERROR] - appRuntimeConfig_ValidateTelemetryQueueSize: queueDataLength:%lu > APP_MQTT_MAX_PUBLISH_DATA_LENGTH:%lu\r\n", queueDataLength, APP_MQTT_MAX_PUBLISH_DATA_LENGTH);
+		printf("[ERROR] - appRuntimeConfig_ValidateTelemetryQueueSize: queueDataLength:%lu > batchMaxBytes:%lu\r\n", queueDataLength, batchMaxBytes);
 		#endif
 		statusPtr->success = false;
 		statusPtr->descrCode = AppStatusMessage_Descr_TelemetryMessageTooLarge;
-		statusPtr->details = copyString("sensor / samplesPerEvent combination yields too large a message for the XDK");
+		statusPtr->details = copyString("sensor / batchMaxBytes combination yields too large a message for the XDK");
 		return;
 	}
 }
+/**
+ * @brief Creates the telemetry configuration of a fidelity level from the target telemetry configuration.
+ * @details DECIMATED: only every nth sample is taken, the sampling period is stretched and the number of samples per event reduced, the publish period stays.<br/>
+ * AGGREGATE: the aggregation mode with the window of the level.<br/>
+ * HEARTBEAT: the aggregation mode with the window of the level, count and mean only. Capture, spectrum features and sensor fusion are off.<br/>
+ * The outputs of the sensor fusion and the sensor periods are kept within the sampling period and the publishing cycle of the level.
+ * @param[in] configPtr: the target telemetry configuration
+ * @param[in] rtParamsPtr: the telemetry runtime parameters calculated from the target telemetry configuration
+ * @param[in] level: the fidelity level. 0: the target telemetry configuration, 1 - numberOfFidelityLevels: the configured fidelity levels
+ * @param[out] levelConfigPtr: the telemetry configuration of the level. the timestamp, exchangeId and tags are not copied.
+ * @param[out] levelRtParamsPtr: the telemetry runtime parameters of the level
+ */
+static void appRuntimeConfig_GetTelemetryFidelityLevelConfig(const AppRuntimeConfig_TelemetryConfig_T * configPtr, const AppRuntimeConfig_TelemetryRTParams_T * rtParamsPtr, uint8_t level,
+																AppRuntimeConfig_TelemetryConfig_T * levelConfigPtr, AppRuntimeConfig_TelemetryRTParams_T * levelRtParamsPtr) {
+
+	assert(configPtr);
+	assert(rtParamsPtr);
+	assert(levelConfigPtr);
+	assert(levelRtParamsPtr);
+	assert(level <= configPtr->received.numberOfFidelityLevels);
+
+	*levelConfigPtr = *configPtr;
+	levelConfigPtr->received.timestampStr = NULL;
+	levelConfigPtr->received.exchangeIdStr = NULL;
+	levelConfigPtr->received.tagsJsonHandle = NULL;
+	*levelRtParamsPtr = *rtParamsPtr;
+
+	if(0 == level) return;
+
+	const AppRuntimeConfig_FidelityLevel_T * levelPtr = &configPtr->received.fidelityLevels[level - 1];
+
+	switch(levelPtr->mode) {
+	case AppRuntimeConfig_Telemetry_FidelityMode_Decimated: {
+		uint8_t numberOfSamplesPerEvent = rtParamsPtr->numberOfSamplesPerEvent / levelPtr->decimation;
+		if(0 == numberOfSamplesPerEvent) numberOfSamplesPerEvent = 1;
+		levelConfigPtr->received.numberOfSamplesPerEvent = numberOfSamplesPerEvent;
+		levelRtParamsPtr->numberOfSamplesPerEvent = numberOfSamplesPerEvent;
+		levelRtParamsPtr->samplingPeriodicityMillis = rtParamsPtr->publishPeriodcityMillis / numberOfSamplesPerEvent;
+	}
+		break;
+	case AppRuntimeConfig_Telemetry_FidelityMode_Aggregate:
+		levelConfigPtr->received.aggregateWindowMillis = levelPtr->windowMillis;
+		break;
+	case AppRuntimeConfig_Telemetry_FidelityMode_Heartbeat:
+		levelConfigPtr->received.aggregateWindowMillis = levelPtr->windowMillis;
+		levelConfigPtr->received.aggregates = (AppRuntimeConfig_Aggregates_T) { .isCount = true, .isMean = true };
+		levelConfigPtr->received.captureThresholdMilliG = 0;
+		levelConfigPtr->received.spectrumWindowSamples = 0;
+		levelConfigPtr->received.fusionOutputMillis = 0;
+		break;
+	default: assert(0);
+	}
+
+	// the filter outputs at most once per sample and the outputs of a publishing cycle fit into half its ring
+	if(levelConfigPtr->received.fusionOutputMillis > 0) {
+		uint32_t cycleMillis = (levelConfigPtr->received.aggregateWindowMillis > 0) ? levelConfigPtr->received.aggregateWindowMillis : levelRtParamsPtr->publishPeriodcityMillis;
+		uint32_t minFusionOutputMillis = (cycleMillis + APP_RT_CFG_TELEMETRY_MAX_FUSION_OUTPUTS_PER_CYCLE - 1) / APP_RT_CFG_TELEMETRY_MAX_FUSION_OUTPUTS_PER_CYCLE;
+		if(minFusionOutputMillis < levelRtParamsPtr->samplingPeriodicityMillis) minFusionOutputMillis = levelRtParamsPtr->samplingPeriodicityMillis;
+		if(levelConfigPtr->received.fusionOutputMillis < minFusionOutputMillis) levelConfigPtr->received.fusionOutputMillis = minFusionOutputMillis;
+	}
+
+	// a sensor is read at most once per sampling cycle
+	uint32_t * periodsPtr = (uint32_t *) &levelConfigPtr->received.sensorPeriodsMillis;
+	for(uint32_t i = 0; i < sizeof(AppRuntimeConfig_SensorPeriods_T) / sizeof(uint32_t); i++) {
+		if(periodsPtr[i] > 0 && periodsPtr[i] < levelRtParamsPtr->samplingPeriodicityMillis) periodsPtr[i] = 0;
+	}
+}
+/**
+ * @brief Validates the size of a single sample in the aggregation modes of the fidelity levels with @ref appRuntimeConfig_ValidateTelemetryQueueSize().
+ * The decimated levels publish the same batches as the target telemetry configuration.
+ *
+ * @param[in] configPtr: the target telemetry configuration
+ * @param[in] rtParamsPtr: the telemetry runtime parameters calculated from the target telemetry configuration
+ * @param[in,out] statusPtr: the status pointer, contains the result status of the validation
+ */
+static void appRuntimeConfig_ValidateTelemetryFidelityQueueSize(const AppRuntimeConfig_TelemetryConfig_T * configPtr, const AppRuntimeConfig_TelemetryRTParams_T * rtParamsPtr, AppRuntimeConfigStatus_T * statusPtr) {
+
+	statusPtr->success = true;
+
+	for(uint8_t level = 1; level <= configPtr->received.numberOfFidelityLevels; level++) {
+
+		if(AppRuntimeConfig_Telemetry_FidelityMode_Decimated == configPtr->received.fidelityLevels[level - 1].mode) continue;
+
+		AppRuntimeConfig_TelemetryConfig_T levelConfig;
+		AppRuntimeConfig_TelemetryRTParams_T levelRtParams;
+		appRuntimeConfig_GetTelemetryFidelityLevelConfig(configPtr, rtParamsPtr, level, &levelConfig, &levelRtParams);
+
+		appRuntimeConfig_ValidateTelemetryQueueSize(&levelConfig, statusPtr);
+		if(!statusPtr->success) return;
+	}
+}
 /**
  * @brief Read the 'timestamp' JSON element from jsonHandle.
  *
@@ -1168,6 +1464,179 @@ static bool appRuntimeConfig_ReadConfigTagsJson(const cJSON * jsonHandle, cJSON
 	*tagsJsonPtrPtr = cJSON_Duplicate(tagsJsonHandle, true);
 	return true;
 }
+/**
+ * @brief Read the optional 'deadbands' object from the JSON: per sensor name an object with the optional elements 'absolute' and 'relativePercent'.
+ * @param[in] jsonHandle: the JSON
+ * @param[in,out] deadbandsPtr: the deadbands. Sensors not in the object have no deadband.
+ * @param[in,out] statusPtr: the return status, set to false if a sensor name is unknown or a value out of range
+ *
+ * @return bool: success or failed
+ */
+static bool appRuntimeConfig_ReadTelemetryDeadbandsJson(const cJSON * jsonHandle, AppRuntimeConfig_Deadbands_T * deadbandsPtr, AppRuntimeConfigStatus_T * statusPtr) {
+
+	memset(deadbandsPtr, 0, sizeof(AppRuntimeConfig_Deadbands_T));
+
+	cJSON * deadbandsJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "deadbands");
+	if(deadbandsJsonHandle == NULL) return true;
+
+	for (int i = 0; i < cJSON_GetArraySize(deadbandsJsonHandle); i++) {
+
+		cJSON * deadbandJsonHandle = cJSON_GetArrayItem(deadbandsJsonHandle, i);
+		const char * sensorStr = (NULL == deadbandJsonHandle->string) ? "" : deadbandJsonHandle->string;
+
+		AppRuntimeConfig_Deadband_T * deadbandPtr = NULL;
+		if (strcmp(sensorStr, "light") == 0) deadbandPtr = &deadbandsPtr->light;
+		else if (strcmp(sensorStr, "accelerator") == 0) deadbandPtr = &deadbandsPtr->accelerator;
+		else if (strcmp(sensorStr, "gyroscope") == 0) deadbandPtr = &deadbandsPtr->gyro;
+		else if (strcmp(sensorStr, "magnetometer") == 0) deadbandPtr = &deadbandsPtr->magneto;
+		else if (strcmp(sensorStr, "humidity") == 0) deadbandPtr = &deadbandsPtr->humidity;
+		else if (strcmp(sensorStr, "temperature") == 0) deadbandPtr = &deadbandsPtr->temperature;
+		else {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_Deadbands;
+			statusPtr->details = copyString(sensorStr);
+			return false;
+		}
+
+		cJSON * absoluteJsonHandle = cJSON_GetObjectItem(deadbandJsonHandle, "absolute");
+		if(absoluteJsonHandle != NULL) {
+			if(absoluteJsonHandle->valueint < 0) {
+				statusPtr->success = false;
+				statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_Deadbands;
+				statusPtr->details = copyString("absolute");
+				return false;
+			}
+			deadbandPtr->absolute = absoluteJsonHandle->valueint;
+		}
+		cJSON * relativePercentJsonHandle = cJSON_GetObjectItem(deadbandJsonHandle, "relativePercent");
+		if(relativePercentJsonHandle != NULL) {
+			if(relativePercentJsonHandle->valueint < 0 || relativePercentJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_DEADBAND_RELATIVE_PERCENT) {
+				statusPtr->success = false;
+				statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_Deadbands;
+				statusPtr->details = copyString("relativePercent");
+				return false;
+			}
+			deadbandPtr->relativePercent = relativePercentJsonHandle->valueint;
+		}
+	}
+	return true;
+}
+/**
+ * @brief Read the optional 'sensorPeriodsMillis' object from the JSON: per sensor name its sampling period in millis.
+ * @param[in] jsonHandle: the JSON
+ * @param[in,out] sensorPeriodsPtr: the periods. Sensors not in the object are read every sampling cycle.
+ * @param[in,out] statusPtr: the return status, set to false if a sensor name is unknown or a value out of range
+ *
+ * @return bool: success or failed
+ */
+static bool appRuntimeConfig_ReadTelemetrySensorPeriodsJson(const cJSON * jsonHandle, AppRuntimeConfig_SensorPeriods_T * sensorPeriodsPtr, AppRuntimeConfigStatus_T * statusPtr) {
+
+	memset(sensorPeriodsPtr, 0, sizeof(AppRuntimeConfig_SensorPeriods_T));
+
+	cJSON * sensorPeriodsJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "sensorPeriodsMillis");
+	if(sensorPeriodsJsonHandle == NULL) return true;
+
+	for (int i = 0; i < cJSON_GetArraySize(sensorPeriodsJsonHandle); i++) {
+
+		cJSON * periodJsonHandle = cJSON_GetArrayItem(sensorPeriodsJsonHandle, i);
+		const char * sensorStr = (NULL == periodJsonHandle->string) ? "" : periodJsonHandle->string;
+
+		uint32_t * periodPtr = NULL;
+		if (strcmp(sensorStr, "light") == 0) periodPtr = &sensorPeriodsPtr->light;
+		else if (strcmp(sensorStr, "accelerator") == 0) periodPtr = &sensorPeriodsPtr->accelerator;
+		else if (strcmp(sensorStr, "gyroscope") == 0) periodPtr = &sensorPeriodsPtr->gyro;
+		else if (strcmp(sensorStr, "magnetometer") == 0) periodPtr = &sensorPeriodsPtr->magneto;
+		else if (strcmp(sensorStr, "humidity") == 0) periodPtr = &sensorPeriodsPtr->humidity;
+		else if (strcmp(sensorStr, "temperature") == 0) periodPtr = &sensorPeriodsPtr->temperature;
+		else {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_SensorPeriodsMillis;
+			statusPtr->details = copyString(sensorStr);
+			return false;
+		}
+
+		if(periodJsonHandle->valueint < 0 || periodJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_SENSOR_PERIOD_MILLIS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_SensorPeriodsMillis;
+			statusPtr->details = copyString(sensorStr);
+			return false;
+		}
+		*periodPtr = periodJsonHandle->valueint;
+	}
+	return true;
+}
+/**
+ * @brief Read the optional 'fidelityLevels' array from the JSON: per level its mode and the decimation or the window in millis.
+ * @param[in] jsonHandle: the JSON
+ * @param[in,out] levelsPtr: the levels, #APP_RT_CFG_TELEMETRY_MAX_FIDELITY_LEVELS
+ * @param[in,out] numberOfLevelsPtr: the number of levels read. 0 if the array is missing or empty.
+ * @param[in,out] statusPtr: the return status, set to false if there are too many levels, a mode is unknown or a value out of range
+ *
+ * @return bool: success or failed
+ */
+static bool appRuntimeConfig_ReadTelemetryFidelityLevelsJson(const cJSON * jsonHandle, AppRuntimeConfig_FidelityLevel_T * levelsPtr, uint8_t * numberOfLevelsPtr, AppRuntimeConfigStatus_T * statusPtr) {
+
+	memset(levelsPtr, 0, sizeof(AppRuntimeConfig_FidelityLevel_T) * APP_RT_CFG_TELEMETRY_MAX_FIDELITY_LEVELS);
+	*numberOfLevelsPtr = 0;
+
+	cJSON * levelsJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "fidelityLevels");
+	if(levelsJsonHandle == NULL) return true;
+
+	int numberOfLevels = cJSON_GetArraySize(levelsJsonHandle);
+	if(numberOfLevels > APP_RT_CFG_TELEMETRY_MAX_FIDELITY_LEVELS) {
+		statusPtr->success = false;
+		statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityLevels;
+		statusPtr->details = copyString("fidelityLevels");
+		return false;
+	}
+
+	for (int i = 0; i < numberOfLevels; i++) {
+
+		cJSON * levelJsonHandle = cJSON_GetArrayItem(levelsJsonHandle, i);
+		AppRuntimeConfig_FidelityLevel_T * levelPtr = &levelsPtr[i];
+
+		cJSON * modeJsonHandle = cJSON_GetObjectItem(levelJsonHandle, "mode");
+		if(modeJsonHandle == NULL || modeJsonHandle->valuestring == NULL) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityLevels;
+			statusPtr->details = copyString("mode");
+			return false;
+		}
+		if (strcmp(modeJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_FIDELITY_MODE_DECIMATED_STR) == 0) levelPtr->mode = AppRuntimeConfig_Telemetry_FidelityMode_Decimated;
+		else if (strcmp(modeJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_FIDELITY_MODE_AGGREGATE_STR) == 0) levelPtr->mode = AppRuntimeConfig_Telemetry_FidelityMode_Aggregate;
+		else if (strcmp(modeJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_FIDELITY_MODE_HEARTBEAT_STR) == 0) levelPtr->mode = AppRuntimeConfig_Telemetry_FidelityMode_Heartbeat;
+		else {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_UnknownValue_FidelityMode;
+			statusPtr->details = copyString(modeJsonHandle->valuestring);
+			return false;
+		}
+
+		if(AppRuntimeConfig_Telemetry_FidelityMode_Decimated == levelPtr->mode) {
+			cJSON * decimationJsonHandle = cJSON_GetObjectItem(levelJsonHandle, "decimation");
+			if(decimationJsonHandle == NULL ||
+					decimationJsonHandle->valueint < APP_RT_CFG_TELEMETRY_MIN_FIDELITY_DECIMATION || decimationJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_FIDELITY_DECIMATION) {
+				statusPtr->success = false;
+				statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityLevels;
+				statusPtr->details = copyString("decimation");
+				return false;
+			}
+			levelPtr->decimation = decimationJsonHandle->valueint;
+		} else {
+			cJSON * windowMillisJsonHandle = cJSON_GetObjectItem(levelJsonHandle, "windowMillis");
+			if(windowMillisJsonHandle == NULL ||
+					windowMillisJsonHandle->valueint < 1 || windowMillisJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_AGGREGATE_WINDOW_MILLIS) {
+				statusPtr->success = false;
+				statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityLevels;
+				statusPtr->details = copyString("windowMillis");
+				return false;
+			}
+			levelPtr->windowMillis = windowMillisJsonHandle->valueint;
+		}
+	}
+	*numberOfLevelsPtr = numberOfLevels;
+	return true;
+}
 /**
  * @brief Read the optional 'delay' element in the JSON.
  *
@@ -1619,6 +2088,15 @@ static AppRuntimeConfigStatus_T * appRuntimeConfig_PopulateAndValidateTelemetryC
 		else if(NULL != strstr(payloadFormtJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V1_JSON_COMPACT_STR) ) {
 			payloadFormat = AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact;
 		}
+		else if(NULL != strstr(payloadFormtJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V2_JSON_COLUMNAR_STR) ) {
+			payloadFormat = AppRuntimeConfig_Telemetry_PayloadFormat_V2_Json_Columnar;
+		}
+		else if(NULL != strstr(payloadFormtJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V2_CBOR_STR) ) {
+			payloadFormat = AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor;
+		}
+		else if(NULL != strstr(payloadFormtJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V2_DELTA_STR) ) {
+			payloadFormat = AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta;
+		}
 		else {
 			statusPtr->success = false;
 			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_UnknownValue_PayloadFormat;
@@ -1626,6 +2104,326 @@ static AppRuntimeConfigStatus_T * appRuntimeConfig_PopulateAndValidateTelemetryC
 			return statusPtr;
 		}
 	}
+	// 'payloadTimestampFormat' element - optional
+	AppRuntimeConfig_Telemetry_TimestampFormat_T payloadTimestampFormat = APP_RT_CFG_DEFAULT_PAYLOAD_TIMESTAMP_FORMAT;
+	cJSON * payloadTimestampFormatJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "payloadTimestampFormat");
+	if(payloadTimestampFormatJsonHandle != NULL) {
+		if(NULL != strstr(payloadTimestampFormatJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_TIMESTAMP_FORMAT_ISO_8601_STR) ) {
+			payloadTimestampFormat = AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601;
+		}
+		else if(NULL != strstr(payloadTimestampFormatJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_TIMESTAMP_FORMAT_EPOCH_MILLIS_STR) ) {
+			payloadTimestampFormat = AppRuntimeConfig_Telemetry_TimestampFormat_EpochMillis;
+		}
+		else {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_UnknownValue_PayloadTimestampFormat;
+			statusPtr->details = copyString(payloadTimestampFormatJsonHandle->valuestring);
+			return statusPtr;
+		}
+	}
+	// 'queueDropPolicy' element - optional
+	AppRuntimeConfig_Telemetry_QueueDropPolicy_T queueDropPolicy = APP_RT_CFG_DEFAULT_QUEUE_DROP_POLICY;
+	cJSON * queueDropPolicyJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "queueDropPolicy");
+	if(queueDropPolicyJsonHandle != NULL) {
+		if(NULL != strstr(queueDropPolicyJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_QUEUE_DROP_POLICY_DROP_OLDEST_STR) ) {
+			queueDropPolicy = AppRuntimeConfig_Telemetry_QueueDropPolicy_DropOldest;
+		}
+		else if(NULL != strstr(queueDropPolicyJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_QUEUE_DROP_POLICY_DROP_NEWEST_STR) ) {
+			queueDropPolicy = AppRuntimeConfig_Telemetry_QueueDropPolicy_DropNewest;
+		}
+		else {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_UnknownValue_QueueDropPolicy;
+			statusPtr->details = copyString(queueDropPolicyJsonHandle->valuestring);
+			return statusPtr;
+		}
+	}
+	// 'queueBacklogEvents' - optional
+	uint32_t queueBacklogEvents = APP_RT_CFG_DEFAULT_QUEUE_BACKLOG_EVENTS;
+	cJSON * queueBacklogEventsJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "queueBacklogEvents");
+	if(queueBacklogEventsJsonHandle != NULL) {
+		if(queueBacklogEventsJsonHandle->valueint < 1 ||
+			queueBacklogEventsJsonHandle->valueint > APP_RT_CFG_TELEMETRY_QUEUE_MAX_BACKLOG_EVENTS ||
+			(queueBacklogEventsJsonHandle->valueint > 1 && (uint32_t) (queueBacklogEventsJsonHandle->valueint * numberOfSamplesPerEventJsonHandle->valueint) > APP_RT_CFG_TELEMETRY_QUEUE_MAX_BACKLOG_SAMPLES)) {
+
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_QueueBacklogEvents;
+			statusPtr->details = copyString("queueBacklogEvents");
+			return statusPtr;
+		}
+		queueBacklogEvents = queueBacklogEventsJsonHandle->valueint;
+	} else {
+		// shrink the default backlog for large events
+		while(queueBacklogEvents > 1 && queueBacklogEvents * numberOfSamplesPerEventJsonHandle->valueint > APP_RT_CFG_TELEMETRY_QUEUE_MAX_BACKLOG_SAMPLES) queueBacklogEvents--;
+	}
+	// 'batchMaxBytes' - optional
+	uint32_t batchMaxBytes = APP_RT_CFG_DEFAULT_BATCH_MAX_BYTES;
+	cJSON * batchMaxBytesJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "batchMaxBytes");
+	if(batchMaxBytesJsonHandle != NULL) {
+		if(batchMaxBytesJsonHandle->valueint < 1 || batchMaxBytesJsonHandle->valueint > APP_MQTT_MAX_PUBLISH_DATA_LENGTH) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_BatchMaxBytes;
+			statusPtr->details = copyString("batchMaxBytes");
+			return statusPtr;
+		}
+		batchMaxBytes = batchMaxBytesJsonHandle->valueint;
+	}
+	// 'batchMaxAgeMillis' - optional
+	uint32_t batchMaxAgeMillis = APP_RT_CFG_DEFAULT_BATCH_MAX_AGE_MILLIS;
+	cJSON * batchMaxAgeMillisJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "batchMaxAgeMillis");
+	if(batchMaxAgeMillisJsonHandle != NULL) {
+		if(batchMaxAgeMillisJsonHandle->valueint < 0 || batchMaxAgeMillisJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_BATCH_AGE_MILLIS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_BatchMaxAgeMillis;
+			statusPtr->details = copyString("batchMaxAgeMillis");
+			return statusPtr;
+		}
+		batchMaxAgeMillis = batchMaxAgeMillisJsonHandle->valueint;
+	}
+	// 'spillReplayEventsPerCycle' - optional
+	uint8_t spillReplayEventsPerCycle = APP_RT_CFG_DEFAULT_SPILL_REPLAY_EVENTS_PER_CYCLE;
+	cJSON * spillReplayEventsPerCycleJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "spillReplayEventsPerCycle");
+	if(spillReplayEventsPerCycleJsonHandle != NULL) {
+		if(spillReplayEventsPerCycleJsonHandle->valueint < 0 || spillReplayEventsPerCycleJsonHandle->valueint > APP_RT_CFG_TELEMETRY_SPILL_MAX_REPLAY_EVENTS_PER_CYCLE) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_SpillReplayEventsPerCycle;
+			statusPtr->details = copyString("spillReplayEventsPerCycle");
+			return statusPtr;
+		}
+		spillReplayEventsPerCycle = spillReplayEventsPerCycleJsonHandle->valueint;
+	}
+	// 'aggregateWindowMillis' - optional
+	uint32_t aggregateWindowMillis = APP_RT_CFG_DEFAULT_AGGREGATE_WINDOW_MILLIS;
+	cJSON * aggregateWindowMillisJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "aggregateWindowMillis");
+	if(aggregateWindowMillisJsonHandle != NULL) {
+		if(aggregateWindowMillisJsonHandle->valueint < 0 || aggregateWindowMillisJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_AGGREGATE_WINDOW_MILLIS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_AggregateWindowMillis;
+			statusPtr->details = copyString("aggregateWindowMillis");
+			return statusPtr;
+		}
+		aggregateWindowMillis = aggregateWindowMillisJsonHandle->valueint;
+	}
+	// the statistics of a window are encoded as JSON only
+	if(aggregateWindowMillis > 0 && (AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor == payloadFormat || AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta == payloadFormat)) {
+		statusPtr->success = false;
+		statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_AggregateWindowMillis;
+		statusPtr->details = copyString("aggregateWindowMillis requires a JSON payloadFormat");
+		return statusPtr;
+	}
+	// 'aggregates' element - optional
+	AppRuntimeConfig_Aggregates_T aggregates = { .isCount = true, .isMin = true, .isMax = true, .isMean = true, .isStddev = true };
+	cJSON * aggregatesJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "aggregates");
+	if(aggregatesJsonHandle != NULL) {
+		if(cJSON_GetArraySize(aggregatesJsonHandle) < 1) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_UnknownValue_Aggregates;
+			statusPtr->details = copyString("aggregates");
+			return statusPtr;
+		}
+		memset(&aggregates, 0, sizeof(aggregates));
+		for (int i = 0; i < cJSON_GetArraySize(aggregatesJsonHandle); i++) {
+			const char * aggregateStr = cJSON_GetArrayItem(aggregatesJsonHandle, i)->valuestring;
+			if(NULL == aggregateStr) aggregateStr = "";
+			if (strcmp(aggregateStr, APP_RT_CFG_TELEMETRY_AGGREGATE_COUNT_STR) == 0) aggregates.isCount = true;
+			else if (strcmp(aggregateStr, APP_RT_CFG_TELEMETRY_AGGREGATE_MIN_STR) == 0) aggregates.isMin = true;
+			else if (strcmp(aggregateStr, APP_RT_CFG_TELEMETRY_AGGREGATE_MAX_STR) == 0) aggregates.isMax = true;
+			else if (strcmp(aggregateStr, APP_RT_CFG_TELEMETRY_AGGREGATE_MEAN_STR) == 0) aggregates.isMean = true;
+			else if (strcmp(aggregateStr, APP_RT_CFG_TELEMETRY_AGGREGATE_STDDEV_STR) == 0) aggregates.isStddev = true;
+			else if (strcmp(aggregateStr, APP_RT_CFG_TELEMETRY_AGGREGATE_P50_STR) == 0) aggregates.isP50 = true;
+			else if (strcmp(aggregateStr, APP_RT_CFG_TELEMETRY_AGGREGATE_P95_STR) == 0) aggregates.isP95 = true;
+			else if (strcmp(aggregateStr, APP_RT_CFG_TELEMETRY_AGGREGATE_P99_STR) == 0) aggregates.isP99 = true;
+			else {
+				statusPtr->success = false;
+				statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_UnknownValue_Aggregates;
+				statusPtr->details = copyString(aggregateStr);
+				return statusPtr;
+			}
+		}
+	}
+	// 'quantileSketchBins' - optional
+	uint16_t quantileSketchBins = APP_RT_CFG_DEFAULT_QUANTILE_SKETCH_BINS;
+	cJSON * quantileSketchBinsJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "quantileSketchBins");
+	if(quantileSketchBinsJsonHandle != NULL) {
+		if(quantileSketchBinsJsonHandle->valueint < APP_RT_CFG_TELEMETRY_MIN_QUANTILE_SKETCH_BINS || quantileSketchBinsJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_QUANTILE_SKETCH_BINS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_QuantileSketchBins;
+			statusPtr->details = copyString("quantileSketchBins");
+			return statusPtr;
+		}
+		quantileSketchBins = quantileSketchBinsJsonHandle->valueint;
+	}
+	// 'deadbands' element - optional
+	AppRuntimeConfig_Deadbands_T deadbands;
+	if(!appRuntimeConfig_ReadTelemetryDeadbandsJson(jsonHandle, &deadbands, statusPtr)) return statusPtr;
+	// 'deadbandHeartbeatMillis' - optional
+	uint32_t deadbandHeartbeatMillis = APP_RT_CFG_DEFAULT_DEADBAND_HEARTBEAT_MILLIS;
+	cJSON * deadbandHeartbeatMillisJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "deadbandHeartbeatMillis");
+	if(deadbandHeartbeatMillisJsonHandle != NULL) {
+		if(deadbandHeartbeatMillisJsonHandle->valueint < 0 || deadbandHeartbeatMillisJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_DEADBAND_HEARTBEAT_MILLIS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_DeadbandHeartbeatMillis;
+			statusPtr->details = copyString("deadbandHeartbeatMillis");
+			return statusPtr;
+		}
+		deadbandHeartbeatMillis = deadbandHeartbeatMillisJsonHandle->valueint;
+	}
+
+	// 'captureThresholdMilliG' - optional
+	uint16_t captureThresholdMilliG = APP_RT_CFG_DEFAULT_CAPTURE_THRESHOLD_MILLI_G;
+	cJSON * captureThresholdMilliGJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "captureThresholdMilliG");
+	if(captureThresholdMilliGJsonHandle != NULL) {
+		if(captureThresholdMilliGJsonHandle->valueint < 0 || captureThresholdMilliGJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_CAPTURE_THRESHOLD_MILLI_G) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_CaptureThresholdMilliG;
+			statusPtr->details = copyString("captureThresholdMilliG");
+			return statusPtr;
+		}
+		captureThresholdMilliG = captureThresholdMilliGJsonHandle->valueint;
+	}
+
+	// 'capturePreTriggerMillis' - optional
+	uint32_t capturePreTriggerMillis = APP_RT_CFG_DEFAULT_CAPTURE_PRE_TRIGGER_MILLIS;
+	cJSON * capturePreTriggerMillisJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "capturePreTriggerMillis");
+	if(capturePreTriggerMillisJsonHandle != NULL) {
+		if(capturePreTriggerMillisJsonHandle->valueint < 0 || capturePreTriggerMillisJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_CAPTURE_TRIGGER_MILLIS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_CapturePreTriggerMillis;
+			statusPtr->details = copyString("capturePreTriggerMillis");
+			return statusPtr;
+		}
+		capturePreTriggerMillis = capturePreTriggerMillisJsonHandle->valueint;
+	}
+
+	// 'capturePostTriggerMillis' - optional
+	uint32_t capturePostTriggerMillis = APP_RT_CFG_DEFAULT_CAPTURE_POST_TRIGGER_MILLIS;
+	cJSON * capturePostTriggerMillisJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "capturePostTriggerMillis");
+	if(capturePostTriggerMillisJsonHandle != NULL) {
+		if(capturePostTriggerMillisJsonHandle->valueint < 0 || capturePostTriggerMillisJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_CAPTURE_TRIGGER_MILLIS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_CapturePostTriggerMillis;
+			statusPtr->details = copyString("capturePostTriggerMillis");
+			return statusPtr;
+		}
+		capturePostTriggerMillis = capturePostTriggerMillisJsonHandle->valueint;
+	}
+
+	// 'spectrumWindowSamples' - optional
+	uint16_t spectrumWindowSamples = APP_RT_CFG_DEFAULT_SPECTRUM_WINDOW_SAMPLES;
+	cJSON * spectrumWindowSamplesJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "spectrumWindowSamples");
+	if(spectrumWindowSamplesJsonHandle != NULL) {
+		if(spectrumWindowSamplesJsonHandle->valueint != 0 && spectrumWindowSamplesJsonHandle->valueint != 256 && spectrumWindowSamplesJsonHandle->valueint != 512) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_SpectrumWindowSamples;
+			statusPtr->details = copyString("spectrumWindowSamples");
+			return statusPtr;
+		}
+		spectrumWindowSamples = spectrumWindowSamplesJsonHandle->valueint;
+	}
+
+	// 'spectrumPeaks' - optional
+	uint8_t spectrumPeaks = APP_RT_CFG_DEFAULT_SPECTRUM_PEAKS;
+	cJSON * spectrumPeaksJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "spectrumPeaks");
+	if(spectrumPeaksJsonHandle != NULL) {
+		if(spectrumPeaksJsonHandle->valueint < 1 || spectrumPeaksJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_SPECTRUM_PEAKS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_SpectrumPeaks;
+			statusPtr->details = copyString("spectrumPeaks");
+			return statusPtr;
+		}
+		spectrumPeaks = spectrumPeaksJsonHandle->valueint;
+	}
+
+	// 'fusionOutputMillis' - optional
+	uint32_t fusionOutputMillis = APP_RT_CFG_DEFAULT_FUSION_OUTPUT_MILLIS;
+	cJSON * fusionOutputMillisJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "fusionOutputMillis");
+	if(fusionOutputMillisJsonHandle != NULL) {
+		if(fusionOutputMillisJsonHandle->valueint < 0 || fusionOutputMillisJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_FUSION_OUTPUT_MILLIS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FusionOutputMillis;
+			statusPtr->details = copyString("fusionOutputMillis");
+			return statusPtr;
+		}
+		fusionOutputMillis = fusionOutputMillisJsonHandle->valueint;
+	}
+
+	// 'fusionEulerAngles' - optional
+	bool fusionEulerAngles = APP_RT_CFG_DEFAULT_FUSION_EULER_ANGLES;
+	cJSON * fusionEulerAnglesJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "fusionEulerAngles");
+	if(fusionEulerAnglesJsonHandle != NULL) fusionEulerAngles = fusionEulerAnglesJsonHandle->valueint;
+
+	// 'sensorPeriodsMillis' element - optional
+	AppRuntimeConfig_SensorPeriods_T sensorPeriodsMillis;
+	if(!appRuntimeConfig_ReadTelemetrySensorPeriodsJson(jsonHandle, &sensorPeriodsMillis, statusPtr)) return statusPtr;
+
+	// 'samplingOverrunPolicy' element - optional
+	AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_T samplingOverrunPolicy = APP_RT_CFG_DEFAULT_SAMPLING_OVERRUN_POLICY;
+	cJSON * samplingOverrunPolicyJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "samplingOverrunPolicy");
+	if(samplingOverrunPolicyJsonHandle != NULL) {
+		if(NULL != strstr(samplingOverrunPolicyJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_SAMPLING_OVERRUN_POLICY_SKIP_STR) ) {
+			samplingOverrunPolicy = AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_Skip;
+		}
+		else if(NULL != strstr(samplingOverrunPolicyJsonHandle->valuestring, APP_RT_CFG_TELEMETRY_SAMPLING_OVERRUN_POLICY_CATCH_UP_STR) ) {
+			samplingOverrunPolicy = AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_CatchUp;
+		}
+		else {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_UnknownValue_SamplingOverrunPolicy;
+			statusPtr->details = copyString(samplingOverrunPolicyJsonHandle->valuestring);
+			return statusPtr;
+		}
+	}
+	// 'samplingWallClockAligned' - optional
+	bool samplingWallClockAligned = APP_RT_CFG_DEFAULT_SAMPLING_WALL_CLOCK_ALIGNED;
+	cJSON * samplingWallClockAlignedJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "samplingWallClockAligned");
+	if(samplingWallClockAlignedJsonHandle != NULL) samplingWallClockAligned = samplingWallClockAlignedJsonHandle->valueint;
+
+	// 'qos1MaxInFlight' - optional
+	uint8_t qos1MaxInFlight = APP_RT_CFG_DEFAULT_QOS1_MAX_IN_FLIGHT;
+	cJSON * qos1MaxInFlightJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "qos1MaxInFlight");
+	if(qos1MaxInFlightJsonHandle != NULL) {
+		if(qos1MaxInFlightJsonHandle->valueint < 1 || qos1MaxInFlightJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_QOS1_IN_FLIGHT) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_Qos1MaxInFlight;
+			statusPtr->details = copyString("qos1MaxInFlight");
+			return statusPtr;
+		}
+		qos1MaxInFlight = qos1MaxInFlightJsonHandle->valueint;
+	}
+	// 'rateControl' - optional
+	bool rateControl = APP_RT_CFG_DEFAULT_RATE_CONTROL;
+	cJSON * rateControlJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "rateControl");
+	if(rateControlJsonHandle != NULL) rateControl = rateControlJsonHandle->valueint;
+
+	// 'fidelityLevels' element - optional
+	AppRuntimeConfig_FidelityLevel_T fidelityLevels[APP_RT_CFG_TELEMETRY_MAX_FIDELITY_LEVELS];
+	uint8_t numberOfFidelityLevels = 0;
+	if(!appRuntimeConfig_ReadTelemetryFidelityLevelsJson(jsonHandle, fidelityLevels, &numberOfFidelityLevels, statusPtr)) return statusPtr;
+
+	// 'fidelityMaxLatencyMillis' - optional
+	uint32_t fidelityMaxLatencyMillis = APP_RT_CFG_DEFAULT_FIDELITY_MAX_LATENCY_MILLIS;
+	cJSON * fidelityMaxLatencyMillisJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "fidelityMaxLatencyMillis");
+	if(fidelityMaxLatencyMillisJsonHandle != NULL) {
+		if(fidelityMaxLatencyMillisJsonHandle->valueint < 1 || fidelityMaxLatencyMillisJsonHandle->valueint > APP_RT_CFG_TELEMETRY_MAX_FIDELITY_MAX_LATENCY_MILLIS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityMaxLatencyMillis;
+			statusPtr->details = copyString("fidelityMaxLatencyMillis");
+			return statusPtr;
+		}
+		fidelityMaxLatencyMillis = fidelityMaxLatencyMillisJsonHandle->valueint;
+	}
+	// 'fidelityMaxBacklogEvents' - optional
+	uint8_t fidelityMaxBacklogEvents = APP_RT_CFG_DEFAULT_FIDELITY_MAX_BACKLOG_EVENTS;
+	cJSON * fidelityMaxBacklogEventsJsonHandle = cJSON_GetObjectItem((cJSON*)jsonHandle, "fidelityMaxBacklogEvents");
+	if(fidelityMaxBacklogEventsJsonHandle != NULL) {
+		if(fidelityMaxBacklogEventsJsonHandle->valueint < 1 || fidelityMaxBacklogEventsJsonHandle->valueint > APP_RT_CFG_TELEMETRY_QUEUE_MAX_BACKLOG_EVENTS) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityMaxBacklogEvents;
+			statusPtr->details = copyString("fidelityMaxBacklogEvents");
+			return statusPtr;
+		}
+		fidelityMaxBacklogEvents = fidelityMaxBacklogEventsJsonHandle->valueint;
+	}
 
 	// populate
 	configPtr->received.timestampStr = timestampStr;
@@ -1653,13 +2451,107 @@ static AppRuntimeConfigStatus_T * appRuntimeConfig_PopulateAndValidateTelemetryC
 	configPtr->received.numberOfSamplesPerEvent = numberOfSamplesPerEventJsonHandle->valueint;
 	configPtr->received.qos = qos;
 	configPtr->received.payloadFormat = payloadFormat;
+	configPtr->received.payloadTimestampFormat = payloadTimestampFormat;
+	configPtr->received.queueBacklogEvents = queueBacklogEvents;
+	configPtr->received.queueDropPolicy = queueDropPolicy;
+	configPtr->received.batchMaxBytes = batchMaxBytes;
+	configPtr->received.batchMaxAgeMillis = batchMaxAgeMillis;
+	configPtr->received.spillReplayEventsPerCycle = spillReplayEventsPerCycle;
+	configPtr->received.aggregateWindowMillis = aggregateWindowMillis;
+	configPtr->received.aggregates = aggregates;
+	configPtr->received.quantileSketchBins = quantileSketchBins;
+	configPtr->received.deadbands = deadbands;
+	configPtr->received.deadbandHeartbeatMillis = deadbandHeartbeatMillis;
+	configPtr->received.captureThresholdMilliG = captureThresholdMilliG;
+	configPtr->received.capturePreTriggerMillis = capturePreTriggerMillis;
+	configPtr->received.capturePostTriggerMillis = capturePostTriggerMillis;
+	configPtr->received.spectrumWindowSamples = spectrumWindowSamples;
+	configPtr->received.spectrumPeaks = spectrumPeaks;
+	configPtr->received.fusionOutputMillis = fusionOutputMillis;
+	configPtr->received.fusionEulerAngles = fusionEulerAngles;
+	configPtr->received.sensorPeriodsMillis = sensorPeriodsMillis;
+	configPtr->received.samplingOverrunPolicy = samplingOverrunPolicy;
+	configPtr->received.samplingWallClockAligned = samplingWallClockAligned;
+	configPtr->received.qos1MaxInFlight = qos1MaxInFlight;
+	configPtr->received.rateControl = rateControl;
+	memcpy(configPtr->received.fidelityLevels, fidelityLevels, sizeof(fidelityLevels));
+	configPtr->received.numberOfFidelityLevels = numberOfFidelityLevels;
+	configPtr->received.fidelityMaxLatencyMillis = fidelityMaxLatencyMillis;
+	configPtr->received.fidelityMaxBacklogEvents = fidelityMaxBacklogEvents;
 
 	AppRuntimeConfigStatus_T * calcStatusPtr = appRuntimeConfig_CalculateAndValidateTelemetryRTParams(configPtr->received.numberOfSamplesPerEvent, configPtr->received.numberOfEventsPerSecond, rtParamsPtr);
 	if(!calcStatusPtr->success) return calcStatusPtr;
 	AppRuntimeConfig_DeleteStatus(calcStatusPtr);
 
+	// a window holds at least one sample
+	if(configPtr->received.aggregateWindowMillis > 0 && configPtr->received.aggregateWindowMillis < rtParamsPtr->samplingPeriodicityMillis) {
+		statusPtr->success = false;
+		statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_AggregateWindowMillis;
+		statusPtr->details = copyString("aggregateWindowMillis < samplingPeriodicityMillis");
+		return statusPtr;
+	}
+
+	// the capture ring holds the samples before, at and after the trigger
+	if(configPtr->received.captureThresholdMilliG > 0 &&
+			AppRuntimeConfig_GetCaptureNumberOfSamples(configPtr->received.capturePreTriggerMillis, configPtr->received.capturePostTriggerMillis, rtParamsPtr->samplingPeriodicityMillis) > APP_RT_CFG_TELEMETRY_MAX_CAPTURE_SAMPLES) {
+		statusPtr->success = false;
+		statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_CaptureWindowTooLong;
+		statusPtr->details = copyString("(capturePreTriggerMillis + capturePostTriggerMillis) / samplingPeriodicityMillis");
+		return statusPtr;
+	}
+
+	// the filter outputs at most once per sample
+	if(configPtr->received.fusionOutputMillis > 0 && configPtr->received.fusionOutputMillis < rtParamsPtr->samplingPeriodicityMillis) {
+		statusPtr->success = false;
+		statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FusionOutputMillis;
+		statusPtr->details = copyString("fusionOutputMillis < samplingPeriodicityMillis");
+		return statusPtr;
+	}
+
+	// the outputs of a publishing cycle fit into half the ring of the sensor fusion
+	if(configPtr->received.fusionOutputMillis > 0) {
+		uint32_t cycleMillis = (configPtr->received.aggregateWindowMillis > 0) ? configPtr->received.aggregateWindowMillis : rtParamsPtr->publishPeriodcityMillis;
+		if(cycleMillis > configPtr->received.fusionOutputMillis * APP_RT_CFG_TELEMETRY_MAX_FUSION_OUTPUTS_PER_CYCLE) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FusionOutputMillis;
+			statusPtr->details = copyString("publishing cycle / fusionOutputMillis > 8");
+			return statusPtr;
+		}
+	}
+
+	// a sensor is read at most once per sampling cycle
+	const uint32_t * periodsPtr = (const uint32_t *) &configPtr->received.sensorPeriodsMillis;
+	for(uint32_t i = 0; i < sizeof(AppRuntimeConfig_SensorPeriods_T) / sizeof(uint32_t); i++) {
+		if(periodsPtr[i] > 0 && periodsPtr[i] < rtParamsPtr->samplingPeriodicityMillis) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_SensorPeriodsMillis;
+			statusPtr->details = copyString("sensorPeriodsMillis < samplingPeriodicityMillis");
+			return statusPtr;
+		}
+	}
+
+	// a window of a fidelity level holds at least one sample and its statistics are encoded as JSON only
+	for(uint8_t i = 0; i < configPtr->received.numberOfFidelityLevels; i++) {
+		const AppRuntimeConfig_FidelityLevel_T * levelPtr = &configPtr->received.fidelityLevels[i];
+		if(AppRuntimeConfig_Telemetry_FidelityMode_Decimated == levelPtr->mode) continue;
+		if(levelPtr->windowMillis < rtParamsPtr->samplingPeriodicityMillis) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityLevels;
+			statusPtr->details = copyString("windowMillis < samplingPeriodicityMillis");
+			return statusPtr;
+		}
+		if(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor == configPtr->received.payloadFormat || AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta == configPtr->received.payloadFormat) {
+			statusPtr->success = false;
+			statusPtr->descrCode = AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityLevels;
+			statusPtr->details = copyString("windowMillis requires a JSON payloadFormat");
+			return statusPtr;
+		}
+	}
+
 	if(appRuntimeConfig_isEnabled) {
-		appRuntimeConfig_ValidateTelemetryQueueSize(rtParamsPtr->numberOfSamplesPerEvent, &(configPtr->received.sensors), configPtr->received.payloadFormat, statusPtr);
+		appRuntimeConfig_ValidateTelemetryQueueSize(configPtr, statusPtr);
+		if(!statusPtr->success) return statusPtr;
+		appRuntimeConfig_ValidateTelemetryFidelityQueueSize(configPtr, rtParamsPtr, statusPtr);
 		if(!statusPtr->success) return statusPtr;
 	}
 
@@ -1986,11 +2878,8 @@ Retcode_T AppRuntimeConfig_Enable(void) {
 
 	AppRuntimeConfigStatus_T * statusPtr = AppRuntimeConfig_CreateNewStatus();
 
-	appRuntimeConfig_ValidateTelemetryQueueSize(
-			appRuntimeConfigPtr->activeTelemetryRTParamsPtr->numberOfSamplesPerEvent,
-			&(appRuntimeConfigPtr->targetTelemetryConfigPtr->received.sensors),
-			appRuntimeConfigPtr->targetTelemetryConfigPtr->received.payloadFormat,
-			statusPtr);
+	appRuntimeConfig_ValidateTelemetryQueueSize(appRuntimeConfigPtr->targetTelemetryConfigPtr, statusPtr);
+	if(statusPtr->success) appRuntimeConfig_ValidateTelemetryFidelityQueueSize(appRuntimeConfigPtr->targetTelemetryConfigPtr, appRuntimeConfigPtr->activeTelemetryRTParamsPtr, statusPtr);
 	if(!statusPtr->success) {
 		return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_RT_CONFIG_PUBLISH_DATA_LENGTH_EXCEEDS_MAX_LENGTH);
 	}
@@ -2109,39 +2998,79 @@ Retcode_T AppRuntimeConfig_PersistRuntimeConfig2File(void) {
 	return retcode;
 }
 /**
- * @brief Adapts the telemetry and sampling rate to meanPublishTicks.
- * @note Algorithm / logic needs revisiting.
- * @param[in] meanPublishTicks: the mean number of ticks measured for telemetry publish over a specific sampling size.
- * @return AppRuntimeConfig_TelemetryRTParams_T *: the new calculated runtime telemetry parameters.
+ * @brief Calculates the telemetry runtime parameters for a rate in permille of the target telemetry configuration.
+ * @details The publish period is stretched by 1000/ratePermille, the number of samples per event stays the same, so the sampling period follows.
+ * Always calculated from the target configuration, the adaptions don't accumulate rounding errors.
+ * @param[in] ratePermille: the rate in permille of the configured numberOfEventsPerSecond, 1-1000
+ * @return AppRuntimeConfig_TelemetryRTParams_T *: the new calculated runtime telemetry parameters. Apply with @ref AppRuntimeConfig_ApplyNewRuntimeConfig().
+ * @exception Retcode_RaiseError: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_APP_RUNTIME_CONFIG_RECEIVED_INVALID_RT_TELEMETRY)
+ * @see AppTelemetryRateControl
  */
-AppRuntimeConfig_TelemetryRTParams_T * AppRuntimeConfig_AdaptTelemetryRateDown(uint32_t meanPublishTicks) {
+AppRuntimeConfig_TelemetryRTParams_T * AppRuntimeConfig_AdaptTelemetryRate(uint32_t ratePermille) {
+
+	assert(ratePermille > 0);
+
+	AppRuntimeConfig_TelemetryRTParams_T * newRtParamsPtr = appRuntimeConfig_CreateTelemetryRTParams();
 
-/*
-	1) check the last time telemetry was adapted
-		- space it for at least 5 seconds
-	2) discard if
-		- only 1 tick apart?
-		- but apply if 5 x in a row 1 tick apart in 5 seconds
-*/
 	appRuntimeConfig_BlockAccess2AppRuntimeConfigPtr();
 
-	AppRuntimeConfig_TelemetryRTParams_T * newRtParamsPtr = appRuntimeConfig_DuplicateTelemetryRTParams(appRuntimeConfigPtr->activeTelemetryRTParamsPtr);
+	AppRuntimeConfigStatus_T * statusPtr  = appRuntimeConfig_CalculateAndValidateTelemetryRTParams(
+													appRuntimeConfigPtr->targetTelemetryConfigPtr->received.numberOfSamplesPerEvent,
+													appRuntimeConfigPtr->targetTelemetryConfigPtr->received.numberOfEventsPerSecond,
+													newRtParamsPtr);
 
 	appRuntimeConfig_AllowAccess2AppRuntimeConfigPtr();
 
-	// adapt the publish frequency
-	int32_t difference = meanPublishTicks - newRtParamsPtr->publishPeriodcityMillis;
-	if(difference > 0) {
+	if(!statusPtr->success) {
+		// the target telemetry config was validated when it was applied
+		Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_APP_RUNTIME_CONFIG_RECEIVED_INVALID_RT_TELEMETRY));
+	}
 
-		uint32_t newPublishPeriodcityMillis = newRtParamsPtr->publishPeriodcityMillis + (difference/2) + 1;
-		//uint32_t newPublishPeriodcityMillis = newrtParamsPtr->publishPeriodcityMillis + difference;
+	AppRuntimeConfig_DeleteStatus(statusPtr);
 
-		uint32_t newSamplingPeriodicityMillis = newPublishPeriodcityMillis / newRtParamsPtr->numberOfSamplesPerEvent;
+	if(ratePermille < 1000) {
+		newRtParamsPtr->publishPeriodcityMillis = (newRtParamsPtr->publishPeriodcityMillis * 1000) / ratePermille;
+		newRtParamsPtr->samplingPeriodicityMillis = newRtParamsPtr->publishPeriodcityMillis / newRtParamsPtr->numberOfSamplesPerEvent;
+	}
 
-		newRtParamsPtr->publishPeriodcityMillis = newPublishPeriodcityMillis;
-		newRtParamsPtr->samplingPeriodicityMillis = newSamplingPeriodicityMillis;
+	return newRtParamsPtr;
+}
+/**
+ * @brief Creates the telemetry configuration and the telemetry runtime parameters of a fidelity level of the target telemetry configuration.
+ * @details Always created from the target configuration, see @ref appRuntimeConfig_GetTelemetryFidelityLevelConfig().
+ * @param[in] level: the fidelity level. 0: the target telemetry configuration, 1 - numberOfFidelityLevels: the configured fidelity levels
+ * @param[out] levelConfigPtr: the telemetry configuration of the level, apply to the telemetry modules. the timestamp, exchangeId and tags are not copied.
+ * @return AppRuntimeConfig_TelemetryRTParams_T *: the new calculated runtime telemetry parameters. Apply with @ref AppRuntimeConfig_ApplyNewRuntimeConfig().
+ * @exception Retcode_RaiseError: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_APP_RUNTIME_CONFIG_RECEIVED_INVALID_RT_TELEMETRY)
+ * @see AppTelemetryFidelity
+ */
+AppRuntimeConfig_TelemetryRTParams_T * AppRuntimeConfig_AdaptTelemetryFidelity(uint8_t level, AppRuntimeConfig_TelemetryConfig_T * levelConfigPtr) {
+
+	assert(levelConfigPtr);
+
+	AppRuntimeConfig_TelemetryRTParams_T * newRtParamsPtr = appRuntimeConfig_CreateTelemetryRTParams();
+
+	appRuntimeConfig_BlockAccess2AppRuntimeConfigPtr();
+
+	AppRuntimeConfigStatus_T * statusPtr  = appRuntimeConfig_CalculateAndValidateTelemetryRTParams(
+													appRuntimeConfigPtr->targetTelemetryConfigPtr->received.numberOfSamplesPerEvent,
+													appRuntimeConfigPtr->targetTelemetryConfigPtr->received.numberOfEventsPerSecond,
+													newRtParamsPtr);
+
+	if(statusPtr->success) {
+		AppRuntimeConfig_TelemetryRTParams_T rtParams = *newRtParamsPtr;
+		appRuntimeConfig_GetTelemetryFidelityLevelConfig(appRuntimeConfigPtr->targetTelemetryConfigPtr, &rtParams, level, levelConfigPtr, newRtParamsPtr);
 	}
 
+	appRuntimeConfig_AllowAccess2AppRuntimeConfigPtr();
+
+	if(!statusPtr->success) {
+		// the target telemetry config was validated when it was applied
+		Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_APP_RUNTIME_CONFIG_RECEIVED_INVALID_RT_TELEMETRY));
+	}
+
+	AppRuntimeConfig_DeleteStatus(statusPtr);
+
 	return newRtParamsPtr;
 }
 /**
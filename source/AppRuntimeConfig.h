@@ -31,8 +31,30 @@
 #define APP_RT_CFG_DEFAULT_NUM_SAMPLES_PER_EVENT		(UINT8_C(1)) /**< default number of samples per event */
 #define APP_RT_CFG_DEFAULT_QOS							(UINT32_C(0)) /**< default qos */
 #define APP_RT_CFG_DEFAULT_PAYLOAD_FORMAT				AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose /**< default payload format */
+#define APP_RT_CFG_DEFAULT_PAYLOAD_TIMESTAMP_FORMAT		AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601 /**< default timestamp format of the JSON payload formats */
 #define APP_RT_CFG_DEFAULT_PUBLISH_PERIODICITY_MILLIS	(UINT32_C(1000)) /**< default publish period in millis. must match #APP_RT_CFG_DEFAULT_NUM_EVENTS_PER_SEC */
 #define APP_RT_CFG_DEFAULT_SAMPLING_PERIODICITY_MILLIS	(UINT32_C(1000)) /**< default sampling period in millis. must match #APP_RT_CFG_DEFAULT_NUM_SAMPLES_PER_EVENT*/
+#define APP_RT_CFG_DEFAULT_QUEUE_BACKLOG_EVENTS			(UINT8_C(4)) /**< default number of complete events the telemetry queue can hold before dropping samples */
+#define APP_RT_CFG_DEFAULT_QUEUE_DROP_POLICY			AppRuntimeConfig_Telemetry_QueueDropPolicy_DropOldest /**< default policy when the telemetry queue backlog is full */
+#define APP_RT_CFG_DEFAULT_SAMPLING_OVERRUN_POLICY		AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_Skip /**< default policy when a sampling cycle overruns its deadline */
+#define APP_RT_CFG_DEFAULT_SAMPLING_WALL_CLOCK_ALIGNED	(false) /**< default flag to align the sampling instants to multiples of the sampling period on the wall clock */
+#define APP_RT_CFG_DEFAULT_QOS1_MAX_IN_FLIGHT			(UINT8_C(1)) /**< default number of qos 1 messages in flight. 1: each message waits for the acknowledgement of the previous one */
+#define APP_RT_CFG_DEFAULT_RATE_CONTROL					(true) /**< default flag to adapt the telemetry rate to the measured publishing performance */
+#define APP_RT_CFG_DEFAULT_FIDELITY_MAX_LATENCY_MILLIS	(UINT32_C(1000)) /**< default mean time spent publishing per cycle at which the fidelity is stepped down */
+#define APP_RT_CFG_DEFAULT_FIDELITY_MAX_BACKLOG_EVENTS	(UINT8_C(2)) /**< default number of events queued up in a cycle at which the fidelity is stepped down */
+#define APP_RT_CFG_DEFAULT_BATCH_MAX_BYTES				(UINT32_C(880)) /**< default byte budget of an event, just under the max publish data length of #APP_MQTT_MAX_PUBLISH_DATA_LENGTH */
+#define APP_RT_CFG_DEFAULT_BATCH_MAX_AGE_MILLIS			(UINT32_C(0)) /**< default max age of an event in millis before it is flushed. 0: no limit */
+#define APP_RT_CFG_DEFAULT_SPILL_REPLAY_EVENTS_PER_CYCLE	(UINT8_C(2)) /**< default number of spilled events replayed per publishing cycle after a reconnect. 0 disables spilling to the SD card */
+#define APP_RT_CFG_DEFAULT_AGGREGATE_WINDOW_MILLIS		(UINT32_C(0)) /**< default window length in millis of the aggregation mode. 0: raw samples are published */
+#define APP_RT_CFG_DEFAULT_DEADBAND_HEARTBEAT_MILLIS	(UINT32_C(60000)) /**< default interval in millis after which a value suppressed by its deadband is sent anyway */
+#define APP_RT_CFG_DEFAULT_QUANTILE_SKETCH_BINS			(UINT16_C(128)) /**< default number of bins of a quantile sketch in the aggregation mode, 2 bytes each */
+#define APP_RT_CFG_DEFAULT_CAPTURE_THRESHOLD_MILLI_G		(UINT16_C(0)) /**< default accelerometer magnitude in milli g that triggers a capture. 0: capture disabled */
+#define APP_RT_CFG_DEFAULT_CAPTURE_PRE_TRIGGER_MILLIS	(UINT32_C(2000)) /**< default history in millis kept before the trigger of a capture */
+#define APP_RT_CFG_DEFAULT_CAPTURE_POST_TRIGGER_MILLIS	(UINT32_C(2000)) /**< default time in millis recorded after the trigger of a capture */
+#define APP_RT_CFG_DEFAULT_SPECTRUM_WINDOW_SAMPLES		(UINT16_C(0)) /**< default number of accelerometer samples per spectrum window. 0: spectrum features disabled */
+#define APP_RT_CFG_DEFAULT_SPECTRUM_PEAKS				(UINT8_C(3)) /**< default number of spectrum peaks sent per axis */
+#define APP_RT_CFG_DEFAULT_FUSION_OUTPUT_MILLIS			(UINT32_C(0)) /**< default interval in millis of the orientation outputs of the sensor fusion. 0: sensor fusion disabled */
+#define APP_RT_CFG_DEFAULT_FUSION_EULER_ANGLES			(false) /**< default flag to send the Euler angles with the orientation quaternions */
 
 #define APP_RT_CFG_DEFAULT_TOPIC_METHOD_CREATE			"CREATE" /**< topic default value for method create */
 #define APP_RT_CFG_DEFAULT_TOPIC_METHOD_UPDATE			"UPDATE" /**< topic default value for method update */
@@ -161,6 +183,59 @@ typedef struct {
 	bool isTemperature; /**< send temperature values */
 	bool isPressure; /**< send pressure values */
 } AppRuntimeConfig_Sensors_T;
+/**
+ * @brief Typedef for the selection of statistics sent per window in the aggregation mode.
+ */
+typedef struct {
+	bool isCount; /**< send the number of samples in the window */
+	bool isMin; /**< send the min value per sensor channel */
+	bool isMax; /**< send the max value per sensor channel */
+	bool isMean; /**< send the mean value per sensor channel */
+	bool isStddev; /**< send the standard deviation per sensor channel */
+	bool isP50; /**< send the median per accelerometer and gyroscope channel */
+	bool isP95; /**< send the 95th percentile per accelerometer and gyroscope channel */
+	bool isP99; /**< send the 99th percentile per accelerometer and gyroscope channel */
+} AppRuntimeConfig_Aggregates_T;
+/**
+ * @brief Typedef for the deadband of a sensor, applied to each of its channels.
+ * A value is sent only if it differs from the last sent value by more than the larger of the two. Both 0: every value is sent.
+ */
+typedef struct {
+	uint32_t absolute; /**< absolute deadband in the units of the payload value */
+	uint8_t relativePercent; /**< relative deadband in percent of the last sent value */
+} AppRuntimeConfig_Deadband_T;
+/**
+ * @brief Typedef for the deadbands per sensor (report by exception).
+ */
+typedef struct {
+	AppRuntimeConfig_Deadband_T light; /**< deadband of the light values */
+	AppRuntimeConfig_Deadband_T accelerator; /**< deadband of the accelerometer values */
+	AppRuntimeConfig_Deadband_T gyro; /**< deadband of the gyroscope values */
+	AppRuntimeConfig_Deadband_T magneto; /**< deadband of the magnetometer values */
+	AppRuntimeConfig_Deadband_T humidity; /**< deadband of the humidity values */
+	AppRuntimeConfig_Deadband_T temperature; /**< deadband of the temperature values */
+} AppRuntimeConfig_Deadbands_T;
+/**
+ * @brief Typedef for the sampling periods per sensor in millis. 0: the sensor is read every sampling cycle.
+ * @details A sensor with a longer period is read every period / samplingPeriodicityMillis cycles (rounded), its values are only sent in the samples it was read for.
+ */
+typedef struct {
+	uint32_t light; /**< period of the light sensor */
+	uint32_t accelerator; /**< period of the accelerometer */
+	uint32_t gyro; /**< period of the gyroscope */
+	uint32_t magneto; /**< period of the magnetometer */
+	uint32_t humidity; /**< period of the humidity sensor */
+	uint32_t temperature; /**< period of the temperature sensor */
+} AppRuntimeConfig_SensorPeriods_T;
+
+#define APP_RT_CFG_TELEMETRY_AGGREGATE_COUNT_STR		"COUNT" /**< json value for the number of samples aggregate */
+#define APP_RT_CFG_TELEMETRY_AGGREGATE_MIN_STR			"MIN" /**< json value for the min aggregate */
+#define APP_RT_CFG_TELEMETRY_AGGREGATE_MAX_STR			"MAX" /**< json value for the max aggregate */
+#define APP_RT_CFG_TELEMETRY_AGGREGATE_MEAN_STR			"MEAN" /**< json value for the mean aggregate */
+#define APP_RT_CFG_TELEMETRY_AGGREGATE_STDDEV_STR		"STDDEV" /**< json value for the standard deviation aggregate */
+#define APP_RT_CFG_TELEMETRY_AGGREGATE_P50_STR			"P50" /**< json value for the median aggregate */
+#define APP_RT_CFG_TELEMETRY_AGGREGATE_P95_STR			"P95" /**< json value for the 95th percentile aggregate */
+#define APP_RT_CFG_TELEMETRY_AGGREGATE_P99_STR			"P99" /**< json value for the 99th percentile aggregate */
 /**
  * @brief Typedef for telemetry payload format
  */
@@ -168,10 +243,93 @@ typedef enum {
 	AppRuntimeConfig_Telemetry_PayloadFormat_NULL = 0,
 	AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose,
 	AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact,
+	AppRuntimeConfig_Telemetry_PayloadFormat_V2_Json_Columnar,
+	AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor,
+	AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta,
 } AppRuntimeConfig_Telemetry_PayloadFormat_T;
 
 #define APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V1_JSON_VERBOSE_STR			"V1_JSON_VERBOSE" /**< json value for V1 json verbose payload format */
 #define APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V1_JSON_COMPACT_STR			"V1_JSON_COMPACT" /**< json value for V1 json compact payload format */
+#define APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V2_JSON_COLUMNAR_STR		"V2_JSON_COLUMNAR" /**< json value for V2 json columnar payload format, one object per event with an array per sensor value */
+#define APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V2_CBOR_STR				"V2_CBOR" /**< json value for V2 cbor payload format, binary, one integer keyed map per event with an array per sensor value */
+#define APP_RT_CFG_TELEMETRY_PAYLOAD_FORMAT_V2_DELTA_STR				"V2_DELTA" /**< json value for V2 delta payload format, binary, per sensor value a first value and varint deltas, delta of delta timestamps */
+
+/**
+ * @brief Typedef for the timestamp format of the JSON payload formats. The binary formats always send milliseconds since the epoch.
+ */
+typedef enum {
+	AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601 = 0, /**< ISO 8601 string with milliseconds, UTC */
+	AppRuntimeConfig_Telemetry_TimestampFormat_EpochMillis /**< integer milliseconds since the epoch, UTC */
+} AppRuntimeConfig_Telemetry_TimestampFormat_T;
+
+#define APP_RT_CFG_TELEMETRY_TIMESTAMP_FORMAT_ISO_8601_STR				"ISO_8601" /**< json value for ISO 8601 timestamp format */
+#define APP_RT_CFG_TELEMETRY_TIMESTAMP_FORMAT_EPOCH_MILLIS_STR			"EPOCH_MILLIS" /**< json value for epoch milliseconds timestamp format */
+
+/**
+ * @brief Typedef for the telemetry queue policy when the backlog is full, i.e. the publisher is behind.
+ */
+typedef enum {
+	AppRuntimeConfig_Telemetry_QueueDropPolicy_DropOldest = 0, /**< discard the oldest complete event to make room for new samples */
+	AppRuntimeConfig_Telemetry_QueueDropPolicy_DropNewest /**< discard new samples until the publisher has caught up */
+} AppRuntimeConfig_Telemetry_QueueDropPolicy_T;
+
+#define APP_RT_CFG_TELEMETRY_QUEUE_DROP_POLICY_DROP_OLDEST_STR			"DROP_OLDEST" /**< json value for drop oldest queue policy */
+#define APP_RT_CFG_TELEMETRY_QUEUE_DROP_POLICY_DROP_NEWEST_STR			"DROP_NEWEST" /**< json value for drop newest queue policy */
+
+/**
+ * @brief Typedef for the sampling policy when a sampling cycle overruns the deadline of the next one.
+ */
+typedef enum {
+	AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_Skip = 0, /**< drop the missed cycles and continue at the next deadline on the original grid */
+	AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_CatchUp /**< run the missed cycles back to back until the deadlines are met again, up to a bounded number of cycles */
+} AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_T;
+
+#define APP_RT_CFG_TELEMETRY_SAMPLING_OVERRUN_POLICY_SKIP_STR			"SKIP" /**< json value for skip sampling overrun policy */
+#define APP_RT_CFG_TELEMETRY_SAMPLING_OVERRUN_POLICY_CATCH_UP_STR		"CATCH_UP" /**< json value for catch up sampling overrun policy */
+
+/**
+ * @brief Typedef for the payload mode of a fidelity level below the configured telemetry.
+ */
+typedef enum {
+	AppRuntimeConfig_Telemetry_FidelityMode_Decimated = 0, /**< raw samples, only every nth of the configured samples is taken. same number of events per second */
+	AppRuntimeConfig_Telemetry_FidelityMode_Aggregate, /**< the aggregation mode with the window of the level and the configured statistics */
+	AppRuntimeConfig_Telemetry_FidelityMode_Heartbeat /**< the aggregation mode with the window of the level, count and mean only. capture, spectrum features and sensor fusion are off */
+} AppRuntimeConfig_Telemetry_FidelityMode_T;
+
+#define APP_RT_CFG_TELEMETRY_FIDELITY_MODE_DECIMATED_STR				"DECIMATED" /**< json value for decimated fidelity mode */
+#define APP_RT_CFG_TELEMETRY_FIDELITY_MODE_AGGREGATE_STR				"AGGREGATE" /**< json value for aggregate fidelity mode */
+#define APP_RT_CFG_TELEMETRY_FIDELITY_MODE_HEARTBEAT_STR				"HEARTBEAT" /**< json value for heartbeat fidelity mode */
+
+/**
+ * @brief Typedef for a fidelity level.
+ */
+typedef struct {
+	AppRuntimeConfig_Telemetry_FidelityMode_T mode; /**< the payload mode */
+	uint8_t decimation; /**< decimated mode: only every nth sample is taken */
+	uint32_t windowMillis; /**< aggregate and heartbeat modes: the window length in millis */
+} AppRuntimeConfig_FidelityLevel_T;
+
+#define APP_RT_CFG_TELEMETRY_QUEUE_MAX_BACKLOG_EVENTS					(UINT8_C(16)) /**< max number of events in the telemetry queue backlog */
+#define APP_RT_CFG_TELEMETRY_QUEUE_MAX_BACKLOG_SAMPLES					(UINT32_C(128)) /**< max number of samples in the telemetry queue backlog (backlog events x samples per event). bounds the heap used by the queue */
+#define APP_RT_CFG_TELEMETRY_MAX_BATCH_AGE_MILLIS						(UINT32_C(60000)) /**< max value for the max age of an event */
+#define APP_RT_CFG_TELEMETRY_SPILL_MAX_REPLAY_EVENTS_PER_CYCLE			(UINT8_C(10)) /**< max number of spilled events replayed per publishing cycle */
+#define APP_RT_CFG_TELEMETRY_MAX_AGGREGATE_WINDOW_MILLIS				(UINT32_C(3600000)) /**< max window length of the aggregation mode */
+#define APP_RT_CFG_TELEMETRY_MAX_DEADBAND_RELATIVE_PERCENT				(UINT8_C(100)) /**< max relative deadband in percent */
+#define APP_RT_CFG_TELEMETRY_MAX_DEADBAND_HEARTBEAT_MILLIS				(UINT32_C(3600000)) /**< max interval after which a suppressed value is sent anyway */
+#define APP_RT_CFG_TELEMETRY_MIN_QUANTILE_SKETCH_BINS					(UINT16_C(128)) /**< min number of bins of a quantile sketch. bounds the error of a quantile to 25% for any values, fewer bins give no useful bound for wide ranges */
+#define APP_RT_CFG_TELEMETRY_MAX_QUANTILE_SKETCH_BINS					(UINT16_C(512)) /**< max number of bins of a quantile sketch. bounds the heap used by the sketches of the 6 accelerometer and gyroscope channels to 6 KB */
+#define APP_RT_CFG_TELEMETRY_MAX_CAPTURE_THRESHOLD_MILLI_G				(UINT16_C(16000)) /**< max capture trigger threshold, the accelerometer range */
+#define APP_RT_CFG_TELEMETRY_MAX_CAPTURE_TRIGGER_MILLIS					(UINT32_C(60000)) /**< max pre- and post-trigger time of a capture */
+#define APP_RT_CFG_TELEMETRY_MAX_CAPTURE_SAMPLES						(UINT32_C(1024)) /**< max number of samples of a capture window. bounds the heap used by the capture ring to 6 KB */
+#define APP_RT_CFG_TELEMETRY_MAX_SPECTRUM_PEAKS							(UINT8_C(8)) /**< max number of spectrum peaks per axis, #APP_TELEMETRY_SPECTRUM_MAX_PEAKS */
+#define APP_RT_CFG_TELEMETRY_MAX_FUSION_OUTPUT_MILLIS					(UINT32_C(60000)) /**< max interval of the orientation outputs of the sensor fusion */
+#define APP_RT_CFG_TELEMETRY_MAX_FUSION_OUTPUTS_PER_CYCLE				(UINT32_C(8)) /**< max number of orientation outputs per publishing cycle, half the outputs held by the sensor fusion */
+#define APP_RT_CFG_TELEMETRY_MAX_SENSOR_PERIOD_MILLIS					(UINT32_C(3600000)) /**< max sampling period of a sensor */
+#define APP_RT_CFG_TELEMETRY_MAX_QOS1_IN_FLIGHT							(UINT8_C(8)) /**< max number of qos 1 messages in flight, #APP_MQTT_PUBLISH_WINDOW_MAX_SIZE. bounds the heap used by the copies of the messages */
+#define APP_RT_CFG_TELEMETRY_MAX_FIDELITY_LEVELS						(UINT8_C(3)) /**< max number of fidelity levels below the configured telemetry */
+#define APP_RT_CFG_TELEMETRY_MIN_FIDELITY_DECIMATION					(UINT8_C(2)) /**< min decimation of a decimated fidelity level */
+#define APP_RT_CFG_TELEMETRY_MAX_FIDELITY_DECIMATION					(UINT8_C(16)) /**< max decimation of a decimated fidelity level */
+#define APP_RT_CFG_TELEMETRY_MAX_FIDELITY_MAX_LATENCY_MILLIS			(UINT32_C(60000)) /**< max value for the publishing latency at which the fidelity is stepped down */
 
 /**
  * @brief Typedef telemetry config.
@@ -184,12 +342,39 @@ typedef struct {
         uint8_t delay2ApplyConfigSeconds; /**< delay in seconds */
         AppRuntimeConfig_Apply_T applyFlag;  /**< how to apply it */
         bool activateAtBootTime; /**< flag if telemetry sampling/publishing should be activated at boot time or not */
-        AppRuntimeConfig_SensorEnable_T sensorEnableFlag; /**< unused */
+        AppRuntimeConfig_SensorEnable_T sensorEnableFlag; /**< which sensors to power at boot and read per sampling cycle: all or only the required ones */
 		uint8_t numberOfEventsPerSecond; /**< number of events per second to publish */
 	    uint8_t numberOfSamplesPerEvent; /**< number of sensor samples per event */
 	    AppRuntimeConfig_Sensors_T sensors; /**< which sensor values to send */
 	    uint32_t qos; /**< the qos for telemetry events */
 	    AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat; /**< the payload format */
+	    AppRuntimeConfig_Telemetry_TimestampFormat_T payloadTimestampFormat; /**< the timestamp format of the JSON payload formats */
+	    uint8_t queueBacklogEvents; /**< number of complete events the telemetry queue holds while the publisher is behind */
+	    AppRuntimeConfig_Telemetry_QueueDropPolicy_T queueDropPolicy; /**< what to drop when the backlog is full */
+	    uint32_t batchMaxBytes; /**< byte budget of an event. the event is flushed before it exceeds the budget */
+	    uint32_t batchMaxAgeMillis; /**< max age of an event in millis, measured from its first sample. the event is flushed once reached. 0: no limit */
+	    uint8_t spillReplayEventsPerCycle; /**< number of events spilled to the SD card during an outage replayed per publishing cycle. 0 disables spilling */
+	    uint32_t aggregateWindowMillis; /**< window length in millis of the aggregation mode, one event with the statistics of the samples per window. 0: raw samples are published */
+	    AppRuntimeConfig_Aggregates_T aggregates; /**< which statistics to send per window in the aggregation mode */
+	    uint16_t quantileSketchBins; /**< number of bins of the quantile sketch per accelerometer and gyroscope channel in the aggregation mode. bounds memory and range at full accuracy: 128 bins keep any values within 25%, 256 within 12.5% and 512 within 6% */
+	    AppRuntimeConfig_Deadbands_T deadbands; /**< report by exception: a value is sent only if it moved beyond its deadband since the last sent value */
+	    uint32_t deadbandHeartbeatMillis; /**< a value suppressed by its deadband is sent anyway once the last sent value is this old. 0: no heartbeat */
+	    uint16_t captureThresholdMilliG; /**< accelerometer magnitude in milli g that triggers a capture of the raw accelerometer samples around it. 0: capture disabled */
+	    uint32_t capturePreTriggerMillis; /**< history in millis sent before the trigger of a capture */
+	    uint32_t capturePostTriggerMillis; /**< time in millis recorded after the trigger of a capture */
+	    uint16_t spectrumWindowSamples; /**< number of accelerometer samples per spectrum window: 256 or 512. 0: spectrum features disabled */
+	    uint8_t spectrumPeaks; /**< number of spectrum peaks sent per axis */
+	    uint32_t fusionOutputMillis; /**< interval in millis of the orientation outputs of the sensor fusion, the filter runs at the sampling period. 0: sensor fusion disabled */
+	    bool fusionEulerAngles; /**< flag to send roll, pitch and yaw with the orientation quaternions */
+	    AppRuntimeConfig_SensorPeriods_T sensorPeriodsMillis; /**< sampling period per sensor, multi-rate sampling: slow sensors are read less often than every sampling cycle */
+	    AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_T samplingOverrunPolicy; /**< what to do with the cycles missed when a sampling cycle overruns its deadline */
+	    bool samplingWallClockAligned; /**< flag to sample at multiples of the sampling period since the epoch on the SNTP synchronized clock instead of from the start of the sampling task */
+	    uint8_t qos1MaxInFlight; /**< number of qos 1 messages in flight before the publisher waits for an acknowledgement */
+	    bool rateControl; /**< flag to slow the publishing and sampling periods down under congestion and speed them back up to the configured rate, see @ref AppTelemetryRateControl */
+	    uint8_t numberOfFidelityLevels; /**< number of levels in fidelityLevels. 0: no fidelity ladder */
+	    AppRuntimeConfig_FidelityLevel_T fidelityLevels[APP_RT_CFG_TELEMETRY_MAX_FIDELITY_LEVELS]; /**< the levels stepped down to one by one under congestion, in the order of decreasing fidelity, see @ref AppTelemetryFidelity */
+	    uint32_t fidelityMaxLatencyMillis; /**< mean time in millis spent publishing per cycle at which the fidelity is stepped down */
+	    uint8_t fidelityMaxBacklogEvents; /**< number of events queued up in a cycle at which the fidelity is stepped down */
 	} received;  /**< the received config */
 } AppRuntimeConfig_TelemetryConfig_T;
 /**
@@ -228,6 +413,8 @@ AppRuntimeConfig_TopicConfig_T * AppRuntimeConfig_DuplicateTopicConfig(const App
 
 AppRuntimeConfig_Sensors_T * AppRuntimeConfig_DuplicateSensors(const AppRuntimeConfig_Sensors_T * orgSensorsPtr);
 
+uint32_t AppRuntimeConfig_GetCaptureNumberOfSamples(const uint32_t preTriggerMillis, const uint32_t postTriggerMillis, const uint32_t samplingPeriodicityMillis);
+
 AppRuntimeConfig_MqttBrokerConnectionConfig_T * AppRuntimeConfig_CreateMqttBrokerConnectionConfig(void);
 
 AppRuntimeConfig_StatusConfig_T * AppRuntimeConfig_CreateStatusConfig(void);
@@ -258,7 +445,9 @@ void AppRuntimeConfig_DeleteFile(void);
 
 Retcode_T AppRuntimeConfig_PersistRuntimeConfig2File(void);
 
-AppRuntimeConfig_TelemetryRTParams_T * AppRuntimeConfig_AdaptTelemetryRateDown(uint32_t meanPublishTicks);
+AppRuntimeConfig_TelemetryRTParams_T * AppRuntimeConfig_AdaptTelemetryRate(uint32_t ratePermille);
+
+AppRuntimeConfig_TelemetryRTParams_T * AppRuntimeConfig_AdaptTelemetryFidelity(uint8_t level, AppRuntimeConfig_TelemetryConfig_T * levelConfigPtr);
 
 AppRuntimeConfigStatus_T * AppRuntimeConfig_PopulateAndValidateMqttBrokerConnectionConfigFromJSON(const cJSON * jsonHandle, AppRuntimeConfig_MqttBrokerConnectionConfig_T * configPtr);
 
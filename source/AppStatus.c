@@ -15,6 +15,7 @@
  * @details Provides the management of Retcode_RaiseError().
  * @details Provides functions for collecting stats.
  * @details Module runs in its own command processor.
+ * @details Status messages are published through @ref AppMqttScheduler: responses to commands and configurations as command responses, errors and warnings as alarms.
  *
  * @author $(SOLACE_APP_AUTHOR)
  *
@@ -45,6 +46,7 @@ static cJSON * appStatus_JsonQueue2SendPtrArray[APP_STATUS_QUEUE_TO_SEND_MAX]; /
 static uint8_t appStatus_JsonQueue2Send_NextIndex = 0; /**< the index of the last queued message */
 #define APP_STATUS_QUEUE2SEND_WAIT_TICKS_MS			(UINT32_C(100)) /**< wait millis between sending queued messages to avoid disconnect */
 static SemaphoreHandle_t appStatus_JsonQueue_SemaphoreHandle = NULL; /**< queue semaphore */
+#define APP_STATUS_PUBLISH_DEADLINE_IN_MS			(UINT32_C(10000)) /**< deadline for publishing a status message, a stuck publish does not hold up the status processor for longer */
 #define APP_STATUS_JSON_QUEUE_SEMAPHORE_TAKE_ADD_WAIT_TICKS_MS		(UINT32_C(10000)) /**< wait millis for adding a message to the queue */
 #define APP_STATUS_JSON_QUEUE_SEMAPHORE_TAKE_SEND_WAIT_TICKS_MS		(UINT32_C(10)) /**< wait millis for sending messages from the queue */
 
@@ -56,8 +58,10 @@ static AppXDK_MQTT_Publish_T appStatus_MqttPublishInfo = {
 	.qos = 1UL,
 	.payload = NULL,
 	.payloadLength = 0UL,
+	.deadlineMillis = APP_STATUS_PUBLISH_DEADLINE_IN_MS,
 };
 static SemaphoreHandle_t appStatus_MqttPublishInfo_SemaphoreHandle = NULL; /**< semaphore to protect publish info */
+#define APP_STATUS_MQTT_PUBLISH_INFO_SEMAPHORE_TAKE_WAIT_IN_MS		(APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS * 2 + UINT32_C(1000)) /**< a publish may wait for the message the scheduler is publishing before its own, wait longer than both */
 
 static const CmdProcessor_T * appStatus_ProcessorHandle = NULL; /**< the status module command processor.*/
 static xTaskHandle appStatus_TaskHandle = NULL; /**< the task handle for periodic status messages */
@@ -74,16 +78,57 @@ static SemaphoreHandle_t appStatus_ErrorHandlingFunc_SemaphoreHandle = NULL; /**
  */
 #define APP_STATUS_ERROR_HANDLING_FUNC_SEMAPHORE_TAKE_WAIT_IN_MS 	(APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS * 2)
 
+/**
+ * @brief Structure for the stats of a class of the outbound publish scheduler, see @ref AppMqttScheduler.
+ */
+typedef struct {
+	uint32_t publishedCounter; /**< number of messages of the class published */
+	uint32_t queueDepthMax; /**< largest number of messages of the class waiting at the same time */
+	uint64_t waitTotalMillis; /**< total time in millis the messages of the class waited to be published */
+	uint32_t waitMaxMillis; /**< longest time in millis a message of the class waited to be published */
+	uint32_t deadlineMissedCounter; /**< number of messages of the class that missed their deadline, in the queue or while being published */
+} AppStatus_Stats_MqttPublishClass_T;
 /**
  * @brief Structure for stats.
  */
 typedef struct {
 	uint32_t mqttBrokerDisconnectCounter; /**< number of mqtt broker disconnects since boot */
+	uint32_t mqttPublishInFlightMax; /**< largest number of qos 1 messages in flight at the same time */
+	uint32_t mqttPublishFailedCounter; /**< number of qos 1 messages in flight that failed, not acknowledged in time, reported failed by the stack or the connection was lost */
+	AppStatus_Stats_MqttPublishClass_T mqttPublishClasses[APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES]; /**< the stats per class of the outbound publish scheduler, indexed by #AppMqttScheduler_Class_T */
 	uint32_t wlanDisconnectCounter; /**< number of WLAN disconnects since boot */
 	uint32_t statusSendFailedCounter; /**< number of status messages failed to send */
 	uint32_t telemetrySendFailedCounter; /**< number of telemetry messages failed to send */
 	uint32_t telemetrySendTooSlowCounter; /**< number of telemetry messages publish too slow */
 	uint32_t telemetrySamplingTooSlowCounter; /**< number of telemetry sampling cycles missed */
+	uint32_t telemetrySamplingAddSampleMaxTicks; /**< longest time in ticks the sampling task spent adding a sample to the telemetry queue */
+	AppRuntimeConfig_Sensors_T telemetrySamplingSensors; /**< the sensors read per sampling cycle, the read stats below are for this set */
+	uint32_t telemetrySamplingReadCounter; /**< number of sensor reads timed since the sensors read were set */
+	uint64_t telemetrySamplingReadTotalMicros; /**< total time in micro seconds of the sensor reads timed */
+	uint32_t telemetrySamplingReadMaxMicros; /**< longest time in micro seconds a sensor read took */
+	uint32_t telemetrySamplingReadHistogram[APP_STATUS_STATS_HISTOGRAM_BUCKETS]; /**< number of sensor reads per bucket of #APP_STATUS_STATS_READ_HISTOGRAM_UPPER_BOUNDS_MICROS */
+	uint32_t telemetrySamplingJitterHistogram[APP_STATUS_STATS_HISTOGRAM_BUCKETS]; /**< number of sampling intervals per bucket of their deviation from the sampling period, #APP_STATUS_STATS_JITTER_HISTOGRAM_UPPER_BOUNDS_MICROS */
+	uint32_t telemetrySamplingJitterMaxMicros; /**< largest deviation in micro seconds of a sampling interval from the sampling period */
+	uint32_t telemetrySamplingSkippedCyclesCounter; /**< number of sampling cycles skipped to get back onto the deadlines after an overrun */
+	uint32_t telemetrySamplingAlignCounter; /**< number of sampling cycles aligned to the wall clock */
+	uint64_t telemetrySamplingAlignTotalMicros; /**< total time in micro seconds the sensor reads of the aligned cycles started after their aligned instant */
+	uint32_t telemetrySamplingAlignMaxMicros; /**< longest time in micro seconds a sensor read of an aligned cycle started after its aligned instant */
+	uint32_t telemetryQueueDropOldestCounter; /**< number of samples discarded from a full telemetry queue backlog with policy drop oldest */
+	uint32_t telemetryQueueDropNewestCounter; /**< number of samples discarded from a full telemetry queue backlog with policy drop newest */
+	uint32_t telemetryQueueFlushOnCountCounter; /**< number of telemetry batches flushed because numberOfSamplesPerEvent reached */
+	uint32_t telemetryQueueFlushOnBytesCounter; /**< number of telemetry batches flushed because batchMaxBytes reached */
+	uint32_t telemetryQueueFlushOnAgeCounter; /**< number of telemetry batches flushed because batchMaxAgeMillis reached */
+	uint32_t telemetrySpilledEventsCounter; /**< number of telemetry events written to the SD card spill log while the broker was not reachable */
+	uint32_t telemetryReplayedEventsCounter; /**< number of telemetry events replayed from the SD card spill log */
+	uint32_t telemetrySpillDroppedEventsCounter; /**< number of telemetry events discarded from the SD card spill log because it was full or corrupt */
+	uint32_t telemetryDeadbandSentValuesCounter; /**< number of telemetry values sent with deadbands configured */
+	uint32_t telemetryDeadbandSuppressedValuesCounter; /**< number of telemetry values suppressed because they did not move beyond their deadband */
+	uint32_t telemetryCaptureTriggeredCounter; /**< number of accelerometer captures triggered */
+	uint32_t telemetryCaptureMissedCounter; /**< number of accelerometer capture triggers missed because the previous window was not uploaded yet */
+	uint32_t telemetryCaptureUploadedCounter; /**< number of accelerometer capture windows uploaded */
+	uint32_t telemetrySpectrumWindowsCounter; /**< number of accelerometer windows analysed for their vibration spectrum features */
+	uint32_t telemetrySpectrumComputeMaxTicks; /**< longest time in ticks the publishing task spent computing the spectrum features of a window */
+	uint32_t telemetryFusionDroppedOutputsCounter; /**< number of orientation outputs of the sensor fusion dropped because the publisher was behind */
 	uint32_t retcodeRaisedErrorCounter; /**< number of errors passed through Retcode_RaiseError() to #AppStatus_ErrorHandlingFunc() */
 	char * bootTimestampStr; /**< the boot timestamp string */
 	uint32_t bootBatteryVoltage; /**< boot battery voltage */
@@ -94,10 +139,41 @@ typedef struct {
  */
 static AppStatus_Stats_T appStatus_Stats = {
 	.mqttBrokerDisconnectCounter = 0,
+	.mqttPublishInFlightMax = 0,
+	.mqttPublishFailedCounter = 0,
+	.mqttPublishClasses = { { 0 } },
 	.wlanDisconnectCounter = 0,
 	.statusSendFailedCounter = 0,
 	.telemetrySendFailedCounter = 0,
 	.telemetrySamplingTooSlowCounter = 0,
+	.telemetrySamplingAddSampleMaxTicks = 0,
+	.telemetrySamplingSensors = { 0 },
+	.telemetrySamplingReadCounter = 0,
+	.telemetrySamplingReadTotalMicros = 0,
+	.telemetrySamplingReadMaxMicros = 0,
+	.telemetrySamplingReadHistogram = { 0 },
+	.telemetrySamplingJitterHistogram = { 0 },
+	.telemetrySamplingJitterMaxMicros = 0,
+	.telemetrySamplingSkippedCyclesCounter = 0,
+	.telemetrySamplingAlignCounter = 0,
+	.telemetrySamplingAlignTotalMicros = 0,
+	.telemetrySamplingAlignMaxMicros = 0,
+	.telemetryQueueDropOldestCounter = 0,
+	.telemetryQueueDropNewestCounter = 0,
+	.telemetryQueueFlushOnCountCounter = 0,
+	.telemetryQueueFlushOnBytesCounter = 0,
+	.telemetryQueueFlushOnAgeCounter = 0,
+	.telemetrySpilledEventsCounter = 0,
+	.telemetryReplayedEventsCounter = 0,
+	.telemetrySpillDroppedEventsCounter = 0,
+	.telemetryDeadbandSentValuesCounter = 0,
+	.telemetryDeadbandSuppressedValuesCounter = 0,
+	.telemetryCaptureTriggeredCounter = 0,
+	.telemetryCaptureMissedCounter = 0,
+	.telemetryCaptureUploadedCounter = 0,
+	.telemetrySpectrumWindowsCounter = 0,
+	.telemetrySpectrumComputeMaxTicks = 0,
+	.telemetryFusionDroppedOutputsCounter = 0,
 	.retcodeRaisedErrorCounter = 0,
 	.bootTimestampStr = NULL,
 	.bootBatteryVoltage = 0,
@@ -118,11 +194,37 @@ static const char * appStatus_DeviceId = NULL; /**< local copy of the device id
 static cJSON * appStatus_Stats_GetAsJson(void);
 static void appStatus_CreateRecurringTask(void);
 static void appStatus_Stats_IncrementMqttBrokerDisconnectCounter(void);
+static void appStatus_Stats_UpdateMqttPublishInFlightMax(uint32_t numberInFlight);
+static void appStatus_Stats_IncrementMqttPublishFailedCounter(void);
+static void appStatus_Stats_UpdateMqttPublishClassStats(AppMqttScheduler_Class_T publishClass, uint32_t queueDepth, uint32_t waitMillis);
+static void appStatus_Stats_IncrementMqttPublishDeadlineMissedCounter(AppMqttScheduler_Class_T publishClass);
+static cJSON * appStatus_Stats_GetMqttPublishClassesAsJson(const AppStatus_Stats_MqttPublishClass_T * classStatsPtr);
 static void appStatus_Stats_IncrementWlanDisconnectCounter(void);
 static void appStatus_Stats_IncrementStatusSendFailedCounter(void);
 static void appStatus_Stats_IncrementTelemetrySendFailedCounter(void);
 static void appStatus_Stats_IncrementTelemetrySendTooSlowCounter(void);
 static void appStatus_Stats_IncrementTelemetrySamplingTooSlowCounter(void);
+static void appStatus_Stats_UpdateTelemetrySamplingAddSampleMaxTicks(uint32_t ticks);
+static void appStatus_Stats_SetTelemetrySamplingSensors(const AppRuntimeConfig_Sensors_T * sensorsPtr);
+static void appStatus_Stats_UpdateTelemetrySamplingReadStats(uint32_t numberOfReads, uint32_t totalMicros, uint32_t maxMicros);
+static void appStatus_Stats_UpdateTelemetrySamplingHistograms(const uint32_t * jitterCountsPtr, uint32_t jitterMaxMicros, const uint32_t * readCountsPtr);
+static void appStatus_Stats_IncrementTelemetrySamplingSkippedCyclesCounter(uint32_t numberOfCycles);
+static void appStatus_Stats_UpdateTelemetrySamplingAlignStats(uint32_t numberOfCycles, uint32_t totalMicros, uint32_t maxMicros);
+static cJSON * appStatus_Stats_GetHistogramAsJson(const uint32_t * upperBoundsMicrosPtr, const uint32_t * countsPtr);
+static void appStatus_Stats_IncrementTelemetryQueueDropOldestCounter(uint32_t numberOfSamples);
+static void appStatus_Stats_IncrementTelemetryQueueDropNewestCounter(uint32_t numberOfSamples);
+static void appStatus_Stats_IncrementTelemetryQueueFlushOnCountCounter(void);
+static void appStatus_Stats_IncrementTelemetryQueueFlushOnBytesCounter(void);
+static void appStatus_Stats_IncrementTelemetryQueueFlushOnAgeCounter(void);
+static void appStatus_Stats_IncrementTelemetrySpilledEventsCounter(void);
+static void appStatus_Stats_IncrementTelemetryReplayedEventsCounter(void);
+static void appStatus_Stats_IncrementTelemetrySpillDroppedEventsCounter(uint32_t numberOfEvents);
+static void appStatus_Stats_IncrementTelemetryDeadbandCounters(uint32_t numberOfSent, uint32_t numberOfSuppressed);
+static void appStatus_Stats_IncrementTelemetryCaptureTriggeredCounter(void);
+static void appStatus_Stats_IncrementTelemetryCaptureMissedCounter(void);
+static void appStatus_Stats_IncrementTelemetryCaptureUploadedCounter(void);
+static void appStatus_Stats_UpdateTelemetrySpectrumStats(uint32_t computeTicks);
+static void appStatus_Stats_IncrementTelemetryFusionDroppedOutputsCounter(void);
 static void appStatus_Stats_IncrementRetcodeRaisedErrorCounter(void);
 static void appStatus_SetStatusConfig(AppRuntimeConfig_StatusConfig_T * statusConfigPtr);
 static void appStatus_SetPubTopic(AppRuntimeConfig_TopicConfig_T const * const topicConfigPtr);
@@ -312,7 +414,7 @@ Retcode_T AppStatus_NotifyReconnected2Broker(void) {
 static void appStatus_SetStatusConfig(AppRuntimeConfig_StatusConfig_T * statusConfigPtr) {
 
 	// make sure we are not publishing
-	if(pdTRUE == xSemaphoreTake(appStatus_MqttPublishInfo_SemaphoreHandle,  MILLISECONDS(APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS))) {
+	if(pdTRUE == xSemaphoreTake(appStatus_MqttPublishInfo_SemaphoreHandle, MILLISECONDS(APP_STATUS_MQTT_PUBLISH_INFO_SEMAPHORE_TAKE_WAIT_IN_MS))) {
 
 		appStatus_MqttPublishInfo.qos = statusConfigPtr->received.qos;
 		appStatus_isPeriodicStatus = statusConfigPtr->received.isSendPeriodicStatus;
@@ -333,7 +435,7 @@ static void appStatus_SetPubTopic(AppRuntimeConfig_TopicConfig_T const * const t
 	assert(topicConfigPtr);
 
 	// make sure we are not publishing
-	if(pdTRUE == xSemaphoreTake(appStatus_MqttPublishInfo_SemaphoreHandle, MILLISECONDS(APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS))) {
+	if(pdTRUE == xSemaphoreTake(appStatus_MqttPublishInfo_SemaphoreHandle, MILLISECONDS(APP_STATUS_MQTT_PUBLISH_INFO_SEMAPHORE_TAKE_WAIT_IN_MS))) {
 
 		if(appStatus_MqttPublishInfo.topic) free(appStatus_MqttPublishInfo.topic);
 		appStatus_MqttPublishInfo.topic = AppMisc_FormatTopic("%s/iot-control/%s/device/%s/status",
@@ -399,6 +501,22 @@ static cJSON * appStatus_GetStatusMessageAsJson(const AppStatusMessage_T * msgPt
 	return jsonHandle;
 
 }
+/**
+ * @brief Get the publish class of a JSON status message.
+ * @details Messages with an exchange id respond to a command or configuration. Errors and warnings are alarms.
+ * @param[in] jsonHandle: the JSON status message
+ * @return AppMqttScheduler_Class_T: the class
+ */
+static AppMqttScheduler_Class_T appStatus_GetPublishClass(const cJSON * jsonHandle) {
+
+	if(NULL != cJSON_GetObjectItem(jsonHandle, "exchangeId")) return AppMqttScheduler_Class_CommandResponse;
+
+	const cJSON * statusCodeJsonHandle = cJSON_GetObjectItem(jsonHandle, "statusCode");
+	if(NULL != statusCodeJsonHandle) {
+		if(AppStatusMessage_Status_Error == statusCodeJsonHandle->valueint || AppStatusMessage_Status_Warning == statusCodeJsonHandle->valueint) return AppMqttScheduler_Class_Alarm;
+	}
+	return AppMqttScheduler_Class_Status;
+}
 /**
  * @brief Internal function to send a JSON status message.
  * @details Only function that actually sends the status message. If it is a queued message, will not queue it again if module is not enabled or broker disconnected.
@@ -433,8 +551,7 @@ static Retcode_T appStatus_SendJsonMessage(cJSON * jsonHandle, bool isQueuedMsg,
 		}
 	}
 
-    // wait longer than AppMqtt_Publish() could take
-	if(pdTRUE == xSemaphoreTake(appStatus_MqttPublishInfo_SemaphoreHandle, MILLISECONDS(APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS + 1000 ))) {
+	if(pdTRUE == xSemaphoreTake(appStatus_MqttPublishInfo_SemaphoreHandle, MILLISECONDS(APP_STATUS_MQTT_PUBLISH_INFO_SEMAPHORE_TAKE_WAIT_IN_MS))) {
 
 		//now check if we need to calculate the timestamp
 		if(cJSON_GetObjectItem(jsonHandle, "timestamp") == NULL) {
@@ -457,7 +574,7 @@ static Retcode_T appStatus_SendJsonMessage(cJSON * jsonHandle, bool isQueuedMsg,
 		appStatus_MqttPublishInfo.payload = payloadStr;
 		appStatus_MqttPublishInfo.payloadLength = strlen(payloadStr);
 
-		retcode = AppMqtt_Publish(&appStatus_MqttPublishInfo);
+		retcode = AppMqttScheduler_Publish(appStatus_GetPublishClass(jsonHandle), &appStatus_MqttPublishInfo);
 		if(RETCODE_OK != retcode) {
 			if(!isQueuedMsg) appStatus_QueueJson4Sending(jsonHandle);
 			else cJSON_Delete(jsonHandle);
@@ -1061,6 +1178,35 @@ void AppStatus_SendWlanDisconnectedMessage(void) {
 void AppStatus_Stats_IncrementMqttBrokerDisconnectCounter(void) {
 	appStatus_Stats_IncrementMqttBrokerDisconnectCounter();
 }
+/**
+ * @brief Update the largest number of qos 1 messages in flight in the stats.
+ * @param[in] numberInFlight: the number of messages in flight
+ */
+void AppStatus_Stats_UpdateMqttPublishInFlightMax(uint32_t numberInFlight) {
+	appStatus_Stats_UpdateMqttPublishInFlightMax(numberInFlight);
+}
+/**
+ * @brief Increment the 'mqtt publish failed' counter in the stats.
+ */
+void AppStatus_Stats_IncrementMqttPublishFailedCounter(void) {
+	appStatus_Stats_IncrementMqttPublishFailedCounter();
+}
+/**
+ * @brief Add a message published by the outbound publish scheduler to the stats of its class.
+ * @param[in] publishClass: the class of the message
+ * @param[in] queueDepth: the number of messages of the class waiting when it was queued, with itself
+ * @param[in] waitMillis: the time in millis the message waited to be published
+ */
+void AppStatus_Stats_UpdateMqttPublishClassStats(AppMqttScheduler_Class_T publishClass, uint32_t queueDepth, uint32_t waitMillis) {
+	appStatus_Stats_UpdateMqttPublishClassStats(publishClass, queueDepth, waitMillis);
+}
+/**
+ * @brief Increment the 'deadline missed counter' of a class of the outbound publish scheduler in the stats.
+ * @param[in] publishClass: the class of the message
+ */
+void AppStatus_Stats_IncrementMqttPublishDeadlineMissedCounter(AppMqttScheduler_Class_T publishClass) {
+	appStatus_Stats_IncrementMqttPublishDeadlineMissedCounter(publishClass);
+}
 /**
  * @brief Increment the 'wlan disconnect counter' in the stats.
  */
@@ -1085,46 +1231,252 @@ void AppStatus_Stats_IncrementTelemetrySendTooSlowCounter(void) {
 void AppStatus_Stats_IncrementTelemetrySamplingTooSlowCounter(void) {
 	appStatus_Stats_IncrementTelemetrySamplingTooSlowCounter();
 }
+/**
+ * @brief Update the 'telemetry sampling add sample max ticks' if ticks is larger.
+ * @param[in] ticks: the time in ticks adding a sample took
+ */
+void AppStatus_Stats_UpdateTelemetrySamplingAddSampleMaxTicks(uint32_t ticks) {
+	appStatus_Stats_UpdateTelemetrySamplingAddSampleMaxTicks(ticks);
+}
+/**
+ * @brief Set the sensors read per sampling cycle. Resets the sensor read stats, they are kept per set of sensors.
+ * @param[in] sensorsPtr: the sensors read
+ */
+void AppStatus_Stats_SetTelemetrySamplingSensors(const AppRuntimeConfig_Sensors_T * sensorsPtr) {
+	appStatus_Stats_SetTelemetrySamplingSensors(sensorsPtr);
+}
+/**
+ * @brief Add sensor read times of the sampling task to the stats.
+ * @param[in] numberOfReads: the number of reads
+ * @param[in] totalMicros: the total time of the reads in micro seconds
+ * @param[in] maxMicros: the longest read in micro seconds
+ */
+void AppStatus_Stats_UpdateTelemetrySamplingReadStats(uint32_t numberOfReads, uint32_t totalMicros, uint32_t maxMicros) {
+	appStatus_Stats_UpdateTelemetrySamplingReadStats(numberOfReads, totalMicros, maxMicros);
+}
+/**
+ * @brief Add the histogram counts of the sampling task to the stats.
+ * @param[in] jitterCountsPtr: #APP_STATUS_STATS_HISTOGRAM_BUCKETS counts of sampling intervals per bucket of #APP_STATUS_STATS_JITTER_HISTOGRAM_UPPER_BOUNDS_MICROS
+ * @param[in] jitterMaxMicros: the largest deviation of an interval from the sampling period in micro seconds
+ * @param[in] readCountsPtr: #APP_STATUS_STATS_HISTOGRAM_BUCKETS counts of sensor reads per bucket of #APP_STATUS_STATS_READ_HISTOGRAM_UPPER_BOUNDS_MICROS
+ */
+void AppStatus_Stats_UpdateTelemetrySamplingHistograms(const uint32_t * jitterCountsPtr, uint32_t jitterMaxMicros, const uint32_t * readCountsPtr) {
+	appStatus_Stats_UpdateTelemetrySamplingHistograms(jitterCountsPtr, jitterMaxMicros, readCountsPtr);
+}
+/**
+ * @brief Increment the 'telemetry sampling skipped cycles' counter by the number of cycles skipped after an overrun.
+ * @param[in] numberOfCycles: the number of cycles skipped
+ */
+void AppStatus_Stats_IncrementTelemetrySamplingSkippedCyclesCounter(uint32_t numberOfCycles) {
+	appStatus_Stats_IncrementTelemetrySamplingSkippedCyclesCounter(numberOfCycles);
+}
+/**
+ * @brief Add the alignment errors of sampling cycles aligned to the wall clock to the stats.
+ * @param[in] numberOfCycles: the number of aligned cycles
+ * @param[in] totalMicros: the total time in micro seconds the sensor reads started after their aligned instants
+ * @param[in] maxMicros: the longest of these times in micro seconds
+ */
+void AppStatus_Stats_UpdateTelemetrySamplingAlignStats(uint32_t numberOfCycles, uint32_t totalMicros, uint32_t maxMicros) {
+	appStatus_Stats_UpdateTelemetrySamplingAlignStats(numberOfCycles, totalMicros, maxMicros);
+}
+/**
+ * @brief Increment the 'telemetry queue drop oldest' counter by the number of samples discarded.
+ * @param[in] numberOfSamples: the number of samples in the discarded batch
+ */
+void AppStatus_Stats_IncrementTelemetryQueueDropOldestCounter(uint32_t numberOfSamples) {
+	appStatus_Stats_IncrementTelemetryQueueDropOldestCounter(numberOfSamples);
+}
+/**
+ * @brief Increment the 'telemetry queue drop newest' counter by the number of samples discarded.
+ * @param[in] numberOfSamples: the number of samples, or windows in the aggregation mode, discarded
+ */
+void AppStatus_Stats_IncrementTelemetryQueueDropNewestCounter(uint32_t numberOfSamples) {
+	appStatus_Stats_IncrementTelemetryQueueDropNewestCounter(numberOfSamples);
+}
+/**
+ * @brief Increment the 'telemetry queue flush on count' counter.
+ */
+void AppStatus_Stats_IncrementTelemetryQueueFlushOnCountCounter(void) {
+	appStatus_Stats_IncrementTelemetryQueueFlushOnCountCounter();
+}
+/**
+ * @brief Increment the 'telemetry queue flush on bytes' counter.
+ */
+void AppStatus_Stats_IncrementTelemetryQueueFlushOnBytesCounter(void) {
+	appStatus_Stats_IncrementTelemetryQueueFlushOnBytesCounter();
+}
+/**
+ * @brief Increment the 'telemetry queue flush on age' counter.
+ */
+void AppStatus_Stats_IncrementTelemetryQueueFlushOnAgeCounter(void) {
+	appStatus_Stats_IncrementTelemetryQueueFlushOnAgeCounter();
+}
+/**
+ * @brief Increment the 'telemetry spilled events' counter.
+ */
+void AppStatus_Stats_IncrementTelemetrySpilledEventsCounter(void) {
+	appStatus_Stats_IncrementTelemetrySpilledEventsCounter();
+}
+/**
+ * @brief Increment the 'telemetry replayed events' counter.
+ */
+void AppStatus_Stats_IncrementTelemetryReplayedEventsCounter(void) {
+	appStatus_Stats_IncrementTelemetryReplayedEventsCounter();
+}
+/**
+ * @brief Increment the 'telemetry spill dropped events' counter by the number of events discarded.
+ * @param[in] numberOfEvents: the number of events discarded from the spill log
+ */
+void AppStatus_Stats_IncrementTelemetrySpillDroppedEventsCounter(uint32_t numberOfEvents) {
+	appStatus_Stats_IncrementTelemetrySpillDroppedEventsCounter(numberOfEvents);
+}
+/**
+ * @brief Add the number of values sent and suppressed by the deadband filter to the 'telemetry deadband' counters.
+ * @param[in] numberOfSent: the number of values sent
+ * @param[in] numberOfSuppressed: the number of values suppressed
+ */
+void AppStatus_Stats_IncrementTelemetryDeadbandCounters(uint32_t numberOfSent, uint32_t numberOfSuppressed) {
+	appStatus_Stats_IncrementTelemetryDeadbandCounters(numberOfSent, numberOfSuppressed);
+}
+/**
+ * @brief Increment the 'telemetry capture triggered' counter.
+ */
+void AppStatus_Stats_IncrementTelemetryCaptureTriggeredCounter(void) {
+	appStatus_Stats_IncrementTelemetryCaptureTriggeredCounter();
+}
+/**
+ * @brief Increment the 'telemetry capture missed' counter.
+ */
+void AppStatus_Stats_IncrementTelemetryCaptureMissedCounter(void) {
+	appStatus_Stats_IncrementTelemetryCaptureMissedCounter();
+}
+/**
+ * @brief Increment the 'telemetry capture uploaded' counter.
+ */
+void AppStatus_Stats_IncrementTelemetryCaptureUploadedCounter(void) {
+	appStatus_Stats_IncrementTelemetryCaptureUploadedCounter();
+}
+/**
+ * @brief Count a window analysed for its spectrum features and update the longest compute time.
+ * @param[in] computeTicks: the time in ticks computing the features took
+ */
+void AppStatus_Stats_UpdateTelemetrySpectrumStats(uint32_t computeTicks) {
+	appStatus_Stats_UpdateTelemetrySpectrumStats(computeTicks);
+}
+/**
+ * @brief Increment the 'telemetry fusion dropped outputs' counter.
+ */
+void AppStatus_Stats_IncrementTelemetryFusionDroppedOutputsCounter(void) {
+	appStatus_Stats_IncrementTelemetryFusionDroppedOutputsCounter();
+}
 /**
  * @brief Get the inernal stats as a JSON.
+ * @details Holds the stats semaphore only to take a copy of the stats. The sampling task increments stats, so measuring the battery and building the JSON is done outside.
  * @return cJSON *: the json pointer or NULL if xSemaphoreTake timeout
  */
 static cJSON * appStatus_Stats_GetAsJson(void) {
 
+	AppStatus_Stats_T stats;
+
 	if(pdTRUE == xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) )) {
+		stats = appStatus_Stats;
+		xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+	} else {
+		return NULL;
+	}
 
-		cJSON * jsonHandle = cJSON_CreateObject();
+	cJSON * jsonHandle = cJSON_CreateObject();
 
-		assert(appStatus_Stats.bootTimestampStr);
-		cJSON_AddItemToObject(jsonHandle, "bootTimestamp", cJSON_CreateString(appStatus_Stats.bootTimestampStr));
+	assert(stats.bootTimestampStr);
+	cJSON_AddItemToObject(jsonHandle, "bootTimestamp", cJSON_CreateString(stats.bootTimestampStr));
 
-		cJSON_AddNumberToObject(jsonHandle,"bootBatteryVoltage", appStatus_Stats.bootBatteryVoltage);
+	cJSON_AddNumberToObject(jsonHandle,"bootBatteryVoltage", stats.bootBatteryVoltage);
 
-		Retcode_T retcode = BatteryMonitor_MeasureSignal(&appStatus_Stats.currentBatteryVoltage);
+	Retcode_T retcode = BatteryMonitor_MeasureSignal(&stats.currentBatteryVoltage);
 
-		if(RETCODE_OK == retcode) cJSON_AddNumberToObject(jsonHandle,"currentBatteryVoltage", appStatus_Stats.currentBatteryVoltage);
-		else Retcode_RaiseError(retcode);
+	if(RETCODE_OK == retcode) cJSON_AddNumberToObject(jsonHandle,"currentBatteryVoltage", stats.currentBatteryVoltage);
+	else Retcode_RaiseError(retcode);
 
-		cJSON_AddNumberToObject(jsonHandle, "mqttBrokerDisconnectCounter", appStatus_Stats.mqttBrokerDisconnectCounter);
+	cJSON_AddNumberToObject(jsonHandle, "mqttBrokerDisconnectCounter", stats.mqttBrokerDisconnectCounter);
 
-		cJSON_AddNumberToObject(jsonHandle, "wlanDisconnectCounter", appStatus_Stats.wlanDisconnectCounter);
+	cJSON_AddNumberToObject(jsonHandle, "mqttPublishInFlightMax", stats.mqttPublishInFlightMax);
 
-		cJSON_AddNumberToObject(jsonHandle, "statusSendFailedCounter", appStatus_Stats.statusSendFailedCounter);
+	cJSON_AddNumberToObject(jsonHandle, "mqttPublishFailedCounter", stats.mqttPublishFailedCounter);
 
-		cJSON_AddNumberToObject(jsonHandle, "telemetrySendFailedCounter", appStatus_Stats.telemetrySendFailedCounter);
+	cJSON_AddItemToObject(jsonHandle, "mqttPublishClasses", appStatus_Stats_GetMqttPublishClassesAsJson(stats.mqttPublishClasses));
 
-		cJSON_AddNumberToObject(jsonHandle, "telemetrySendTooSlowCounter", appStatus_Stats.telemetrySendTooSlowCounter);
+	cJSON_AddNumberToObject(jsonHandle, "wlanDisconnectCounter", stats.wlanDisconnectCounter);
 
-		cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingTooSlowCounter", appStatus_Stats.telemetrySamplingTooSlowCounter);
+	cJSON_AddNumberToObject(jsonHandle, "statusSendFailedCounter", stats.statusSendFailedCounter);
 
-		cJSON_AddNumberToObject(jsonHandle, "retcodeRaisedErrorCounter", appStatus_Stats.retcodeRaisedErrorCounter);
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySendFailedCounter", stats.telemetrySendFailedCounter);
 
-		xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySendTooSlowCounter", stats.telemetrySendTooSlowCounter);
 
-		return jsonHandle;
-	} else {
-		return NULL;
-	}
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingTooSlowCounter", stats.telemetrySamplingTooSlowCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingAddSampleMaxTicks", stats.telemetrySamplingAddSampleMaxTicks);
+
+	cJSON * sensorsJsonArrayHandle = cJSON_CreateArray();
+	if(stats.telemetrySamplingSensors.isLight) cJSON_AddItemToArray(sensorsJsonArrayHandle, cJSON_CreateString("light"));
+	if(stats.telemetrySamplingSensors.isAccelerator) cJSON_AddItemToArray(sensorsJsonArrayHandle, cJSON_CreateString("accelerator"));
+	if(stats.telemetrySamplingSensors.isGyro) cJSON_AddItemToArray(sensorsJsonArrayHandle, cJSON_CreateString("gyroscope"));
+	if(stats.telemetrySamplingSensors.isMagneto) cJSON_AddItemToArray(sensorsJsonArrayHandle, cJSON_CreateString("magnetometer"));
+	if(stats.telemetrySamplingSensors.isHumidity) cJSON_AddItemToArray(sensorsJsonArrayHandle, cJSON_CreateString("humidity"));
+	if(stats.telemetrySamplingSensors.isTemperature) cJSON_AddItemToArray(sensorsJsonArrayHandle, cJSON_CreateString("temperature"));
+	if(stats.telemetrySamplingSensors.isPressure) cJSON_AddItemToArray(sensorsJsonArrayHandle, cJSON_CreateString("pressure"));
+	cJSON_AddItemToObject(jsonHandle, "telemetrySamplingSensors", sensorsJsonArrayHandle);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingReadCounter", stats.telemetrySamplingReadCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingReadMeanMicros", (stats.telemetrySamplingReadCounter > 0) ? (uint32_t) (stats.telemetrySamplingReadTotalMicros / stats.telemetrySamplingReadCounter) : 0);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingReadMaxMicros", stats.telemetrySamplingReadMaxMicros);
+
+	const uint32_t readUpperBoundsMicros[] = APP_STATUS_STATS_READ_HISTOGRAM_UPPER_BOUNDS_MICROS;
+	cJSON_AddItemToObject(jsonHandle, "telemetrySamplingReadHistogram", appStatus_Stats_GetHistogramAsJson(readUpperBoundsMicros, stats.telemetrySamplingReadHistogram));
+
+	const uint32_t jitterUpperBoundsMicros[] = APP_STATUS_STATS_JITTER_HISTOGRAM_UPPER_BOUNDS_MICROS;
+	cJSON_AddItemToObject(jsonHandle, "telemetrySamplingJitterHistogram", appStatus_Stats_GetHistogramAsJson(jitterUpperBoundsMicros, stats.telemetrySamplingJitterHistogram));
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingJitterMaxMicros", stats.telemetrySamplingJitterMaxMicros);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingSkippedCyclesCounter", stats.telemetrySamplingSkippedCyclesCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingAlignCounter", stats.telemetrySamplingAlignCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingAlignErrorMeanMicros", (stats.telemetrySamplingAlignCounter > 0) ? (uint32_t) (stats.telemetrySamplingAlignTotalMicros / stats.telemetrySamplingAlignCounter) : 0);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySamplingAlignErrorMaxMicros", stats.telemetrySamplingAlignMaxMicros);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetryQueueDropOldestCounter", stats.telemetryQueueDropOldestCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetryQueueDropNewestCounter", stats.telemetryQueueDropNewestCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetryQueueFlushOnCountCounter", stats.telemetryQueueFlushOnCountCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetryQueueFlushOnBytesCounter", stats.telemetryQueueFlushOnBytesCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetryQueueFlushOnAgeCounter", stats.telemetryQueueFlushOnAgeCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySpilledEventsCounter", stats.telemetrySpilledEventsCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetryReplayedEventsCounter", stats.telemetryReplayedEventsCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySpillDroppedEventsCounter", stats.telemetrySpillDroppedEventsCounter);
+	cJSON_AddNumberToObject(jsonHandle, "telemetryDeadbandSentValuesCounter", stats.telemetryDeadbandSentValuesCounter);
+	cJSON_AddNumberToObject(jsonHandle, "telemetryDeadbandSuppressedValuesCounter", stats.telemetryDeadbandSuppressedValuesCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "telemetryCaptureTriggeredCounter", stats.telemetryCaptureTriggeredCounter);
+	cJSON_AddNumberToObject(jsonHandle, "telemetryCaptureMissedCounter", stats.telemetryCaptureMissedCounter);
+	cJSON_AddNumberToObject(jsonHandle, "telemetryCaptureUploadedCounter", stats.telemetryCaptureUploadedCounter);
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySpectrumWindowsCounter", stats.telemetrySpectrumWindowsCounter);
+	cJSON_AddNumberToObject(jsonHandle, "telemetrySpectrumComputeMaxTicks", stats.telemetrySpectrumComputeMaxTicks);
+	cJSON_AddNumberToObject(jsonHandle, "telemetryFusionDroppedOutputsCounter", stats.telemetryFusionDroppedOutputsCounter);
+
+	cJSON_AddNumberToObject(jsonHandle, "retcodeRaisedErrorCounter", stats.retcodeRaisedErrorCounter);
+
+	return jsonHandle;
 }
 /**
  * @brief Increment the broker disconnect counter in the stats.
@@ -1134,6 +1486,72 @@ static void appStatus_Stats_IncrementMqttBrokerDisconnectCounter(void) {
 		appStatus_Stats.mqttBrokerDisconnectCounter++;
 	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
 }
+/**
+ * @brief Update the largest number of qos 1 messages in flight in the stats.
+ * @param[in] numberInFlight: the number of messages in flight
+ */
+static void appStatus_Stats_UpdateMqttPublishInFlightMax(uint32_t numberInFlight) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) )) {
+		if(numberInFlight > appStatus_Stats.mqttPublishInFlightMax) appStatus_Stats.mqttPublishInFlightMax = numberInFlight;
+	}
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the mqtt publish failed counter in the stats.
+ */
+static void appStatus_Stats_IncrementMqttPublishFailedCounter(void) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.mqttPublishFailedCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Add a message published by the outbound publish scheduler to the stats of its class.
+ * @param[in] publishClass: the class of the message
+ * @param[in] queueDepth: the number of messages of the class waiting when it was queued, with itself
+ * @param[in] waitMillis: the time in millis the message waited to be published
+ */
+static void appStatus_Stats_UpdateMqttPublishClassStats(AppMqttScheduler_Class_T publishClass, uint32_t queueDepth, uint32_t waitMillis) {
+	assert(publishClass < APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES);
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) )) {
+		AppStatus_Stats_MqttPublishClass_T * classStatsPtr = &appStatus_Stats.mqttPublishClasses[publishClass];
+		classStatsPtr->publishedCounter++;
+		if(queueDepth > classStatsPtr->queueDepthMax) classStatsPtr->queueDepthMax = queueDepth;
+		classStatsPtr->waitTotalMillis += waitMillis;
+		if(waitMillis > classStatsPtr->waitMaxMillis) classStatsPtr->waitMaxMillis = waitMillis;
+	}
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the deadline missed counter of a class of the outbound publish scheduler in the stats.
+ * @param[in] publishClass: the class of the message
+ */
+static void appStatus_Stats_IncrementMqttPublishDeadlineMissedCounter(AppMqttScheduler_Class_T publishClass) {
+	assert(publishClass < APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES);
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.mqttPublishClasses[publishClass].deadlineMissedCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Get the stats of the classes of the outbound publish scheduler as a JSON object with an object per class.
+ * @details Adds the current queue depth of each class.
+ * @param[in] classStatsPtr: the stats per class, indexed by #AppMqttScheduler_Class_T
+ * @return cJSON *: the newly created JSON object
+ */
+static cJSON * appStatus_Stats_GetMqttPublishClassesAsJson(const AppStatus_Stats_MqttPublishClass_T * classStatsPtr) {
+	const char * classNames[APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES] = { "commandResponse", "alarm", "status", "telemetry" };
+	cJSON * jsonHandle = cJSON_CreateObject();
+	for(uint32_t i = 0; i < APP_MQTT_SCHEDULER_NUMBER_OF_CLASSES; i++) {
+		cJSON * classJsonHandle = cJSON_CreateObject();
+		cJSON_AddNumberToObject(classJsonHandle, "publishedCounter", classStatsPtr[i].publishedCounter);
+		cJSON_AddNumberToObject(classJsonHandle, "queueDepth", AppMqttScheduler_GetQueueDepth((AppMqttScheduler_Class_T) i));
+		cJSON_AddNumberToObject(classJsonHandle, "queueDepthMax", classStatsPtr[i].queueDepthMax);
+		cJSON_AddNumberToObject(classJsonHandle, "waitMeanMillis", (classStatsPtr[i].publishedCounter > 0) ? (uint32_t) (classStatsPtr[i].waitTotalMillis / classStatsPtr[i].publishedCounter) : 0);
+		cJSON_AddNumberToObject(classJsonHandle, "waitMaxMillis", classStatsPtr[i].waitMaxMillis);
+		cJSON_AddNumberToObject(classJsonHandle, "deadlineMissedCounter", classStatsPtr[i].deadlineMissedCounter);
+		cJSON_AddItemToObject(jsonHandle, classNames[i], classJsonHandle);
+	}
+	return jsonHandle;
+}
 /**
  * @brief Increment the wlan disconnect counter in the stats.
  */
@@ -1174,6 +1592,225 @@ static void appStatus_Stats_IncrementTelemetrySamplingTooSlowCounter(void) {
 		appStatus_Stats.telemetrySamplingTooSlowCounter++;
 	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
 }
+/**
+ * @brief Update the longest time adding a sample to the telemetry queue took in the stats.
+ * @param[in] ticks: the time in ticks
+ */
+static void appStatus_Stats_UpdateTelemetrySamplingAddSampleMaxTicks(uint32_t ticks) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		if(ticks > appStatus_Stats.telemetrySamplingAddSampleMaxTicks) appStatus_Stats.telemetrySamplingAddSampleMaxTicks = ticks;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Set the sensors read per sampling cycle in the stats and reset the sensor read stats.
+ * @param[in] sensorsPtr: the sensors read
+ */
+static void appStatus_Stats_SetTelemetrySamplingSensors(const AppRuntimeConfig_Sensors_T * sensorsPtr) {
+	assert(sensorsPtr);
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) )) {
+		appStatus_Stats.telemetrySamplingSensors = *sensorsPtr;
+		appStatus_Stats.telemetrySamplingReadCounter = 0;
+		appStatus_Stats.telemetrySamplingReadTotalMicros = 0;
+		appStatus_Stats.telemetrySamplingReadMaxMicros = 0;
+		memset(appStatus_Stats.telemetrySamplingReadHistogram, 0, sizeof(appStatus_Stats.telemetrySamplingReadHistogram));
+	}
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Add sensor read times to the stats.
+ * @param[in] numberOfReads: the number of reads
+ * @param[in] totalMicros: the total time of the reads in micro seconds
+ * @param[in] maxMicros: the longest read in micro seconds
+ */
+static void appStatus_Stats_UpdateTelemetrySamplingReadStats(uint32_t numberOfReads, uint32_t totalMicros, uint32_t maxMicros) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) )) {
+		appStatus_Stats.telemetrySamplingReadCounter += numberOfReads;
+		appStatus_Stats.telemetrySamplingReadTotalMicros += totalMicros;
+		if(maxMicros > appStatus_Stats.telemetrySamplingReadMaxMicros) appStatus_Stats.telemetrySamplingReadMaxMicros = maxMicros;
+	}
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Add the histogram counts of the sampling task to the stats.
+ * @param[in] jitterCountsPtr: the counts per bucket of the sampling interval jitter
+ * @param[in] jitterMaxMicros: the largest jitter in micro seconds
+ * @param[in] readCountsPtr: the counts per bucket of the sensor read time
+ */
+static void appStatus_Stats_UpdateTelemetrySamplingHistograms(const uint32_t * jitterCountsPtr, uint32_t jitterMaxMicros, const uint32_t * readCountsPtr) {
+	assert(jitterCountsPtr);
+	assert(readCountsPtr);
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) )) {
+		for(uint32_t i = 0; i < APP_STATUS_STATS_HISTOGRAM_BUCKETS; i++) {
+			appStatus_Stats.telemetrySamplingJitterHistogram[i] += jitterCountsPtr[i];
+			appStatus_Stats.telemetrySamplingReadHistogram[i] += readCountsPtr[i];
+		}
+		if(jitterMaxMicros > appStatus_Stats.telemetrySamplingJitterMaxMicros) appStatus_Stats.telemetrySamplingJitterMaxMicros = jitterMaxMicros;
+	}
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Add the number of sampling cycles skipped after an overrun to the stats.
+ * @param[in] numberOfCycles: the number of cycles
+ */
+static void appStatus_Stats_IncrementTelemetrySamplingSkippedCyclesCounter(uint32_t numberOfCycles) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetrySamplingSkippedCyclesCounter += numberOfCycles;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Add the alignment errors of wall clock aligned sampling cycles to the stats.
+ * @param[in] numberOfCycles: the number of cycles
+ * @param[in] totalMicros: the total alignment error in micro seconds
+ * @param[in] maxMicros: the largest alignment error in micro seconds
+ */
+static void appStatus_Stats_UpdateTelemetrySamplingAlignStats(uint32_t numberOfCycles, uint32_t totalMicros, uint32_t maxMicros) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) )) {
+		appStatus_Stats.telemetrySamplingAlignCounter += numberOfCycles;
+		appStatus_Stats.telemetrySamplingAlignTotalMicros += totalMicros;
+		if(maxMicros > appStatus_Stats.telemetrySamplingAlignMaxMicros) appStatus_Stats.telemetrySamplingAlignMaxMicros = maxMicros;
+	}
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Get a histogram of the stats as a JSON object with the upper bounds of the buckets and the counts per bucket.
+ * @details The last of the #APP_STATUS_STATS_HISTOGRAM_BUCKETS buckets has no upper bound, so there is one bound less than counts.
+ * @param[in] upperBoundsMicrosPtr: the upper bounds in micro seconds of all but the last bucket
+ * @param[in] countsPtr: the counts per bucket
+ * @return cJSON *: the newly created JSON object
+ */
+static cJSON * appStatus_Stats_GetHistogramAsJson(const uint32_t * upperBoundsMicrosPtr, const uint32_t * countsPtr) {
+	cJSON * jsonHandle = cJSON_CreateObject();
+	cJSON * upperBoundsJsonArrayHandle = cJSON_CreateArray();
+	cJSON * countsJsonArrayHandle = cJSON_CreateArray();
+	for(uint32_t i = 0; i < APP_STATUS_STATS_HISTOGRAM_BUCKETS; i++) {
+		if(i < APP_STATUS_STATS_HISTOGRAM_BUCKETS - 1) cJSON_AddItemToArray(upperBoundsJsonArrayHandle, cJSON_CreateNumber(upperBoundsMicrosPtr[i]));
+		cJSON_AddItemToArray(countsJsonArrayHandle, cJSON_CreateNumber(countsPtr[i]));
+	}
+	cJSON_AddItemToObject(jsonHandle, "upperBoundsMicros", upperBoundsJsonArrayHandle);
+	cJSON_AddItemToObject(jsonHandle, "counts", countsJsonArrayHandle);
+	return jsonHandle;
+}
+/**
+ * @brief Add the number of samples dropped with policy drop oldest to the stats.
+ * @param[in] numberOfSamples: the number of samples
+ */
+static void appStatus_Stats_IncrementTelemetryQueueDropOldestCounter(uint32_t numberOfSamples) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetryQueueDropOldestCounter += numberOfSamples;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the number of samples dropped with policy drop newest in the stats.
+ */
+static void appStatus_Stats_IncrementTelemetryQueueDropNewestCounter(uint32_t numberOfSamples) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetryQueueDropNewestCounter += numberOfSamples;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the number of telemetry batches flushed because numberOfSamplesPerEvent reached in the stats.
+ */
+static void appStatus_Stats_IncrementTelemetryQueueFlushOnCountCounter(void) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetryQueueFlushOnCountCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the number of telemetry batches flushed because batchMaxBytes reached in the stats.
+ */
+static void appStatus_Stats_IncrementTelemetryQueueFlushOnBytesCounter(void) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetryQueueFlushOnBytesCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the number of telemetry batches flushed because batchMaxAgeMillis reached in the stats.
+ */
+static void appStatus_Stats_IncrementTelemetryQueueFlushOnAgeCounter(void) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetryQueueFlushOnAgeCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the telemetry spilled events counter in the stats.
+ */
+static void appStatus_Stats_IncrementTelemetrySpilledEventsCounter(void) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetrySpilledEventsCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the telemetry replayed events counter in the stats.
+ */
+static void appStatus_Stats_IncrementTelemetryReplayedEventsCounter(void) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetryReplayedEventsCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Add the number of events discarded from the spill log to the stats.
+ * @param[in] numberOfEvents: the number of events
+ */
+static void appStatus_Stats_IncrementTelemetrySpillDroppedEventsCounter(uint32_t numberOfEvents) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetrySpillDroppedEventsCounter += numberOfEvents;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Add the number of values sent and suppressed by the deadband filter to the stats.
+ * @param[in] numberOfSent: the number of values sent
+ * @param[in] numberOfSuppressed: the number of values suppressed
+ */
+static void appStatus_Stats_IncrementTelemetryDeadbandCounters(uint32_t numberOfSent, uint32_t numberOfSuppressed) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) )) {
+		appStatus_Stats.telemetryDeadbandSentValuesCounter += numberOfSent;
+		appStatus_Stats.telemetryDeadbandSuppressedValuesCounter += numberOfSuppressed;
+	}
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the telemetry capture triggered counter in the stats.
+ */
+static void appStatus_Stats_IncrementTelemetryCaptureTriggeredCounter(void) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetryCaptureTriggeredCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the telemetry capture missed counter in the stats.
+ */
+static void appStatus_Stats_IncrementTelemetryCaptureMissedCounter(void) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetryCaptureMissedCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the telemetry capture uploaded counter in the stats.
+ */
+static void appStatus_Stats_IncrementTelemetryCaptureUploadedCounter(void) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetryCaptureUploadedCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the telemetry spectrum windows counter and update the longest spectrum compute time in the stats.
+ * @param[in] computeTicks: the time in ticks
+ */
+static void appStatus_Stats_UpdateTelemetrySpectrumStats(uint32_t computeTicks) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) )) {
+		appStatus_Stats.telemetrySpectrumWindowsCounter++;
+		if(computeTicks > appStatus_Stats.telemetrySpectrumComputeMaxTicks) appStatus_Stats.telemetrySpectrumComputeMaxTicks = computeTicks;
+	}
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
+/**
+ * @brief Increment the telemetry fusion dropped outputs counter in the stats.
+ */
+static void appStatus_Stats_IncrementTelemetryFusionDroppedOutputsCounter(void) {
+	if(xSemaphoreTake(appStatus_Stats_SemaphoreHandle, MILLISECONDS(APP_STATUS_STATS_SEMAPHORE_TAKE_WAIT_MILLIS) ))
+		appStatus_Stats.telemetryFusionDroppedOutputsCounter++;
+	xSemaphoreGive(appStatus_Stats_SemaphoreHandle);
+}
 /**
  * @brief Increment the retcode raised error counter in the stats.
  */
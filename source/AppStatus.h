@@ -20,11 +20,16 @@
 #include "AppConfig.h"
 #include "AppRuntimeConfig.h"
 #include "AppTimestamp.h"
+#include "AppMqttScheduler.h"
 
 #include "BCDS_Retcode.h"
 #include "BCDS_CmdProcessor.h"
 #include "cJSON.h"
 
+#define APP_STATUS_STATS_HISTOGRAM_BUCKETS		UINT32_C(8) /**< number of buckets of a histogram in the stats, the last bucket has no upper bound */
+#define APP_STATUS_STATS_JITTER_HISTOGRAM_UPPER_BOUNDS_MICROS	{ 50, 100, 250, 500, 1000, 2000, 5000 } /**< upper bounds of the buckets of the sampling interval jitter histogram, all but the last bucket */
+#define APP_STATUS_STATS_READ_HISTOGRAM_UPPER_BOUNDS_MICROS		{ 250, 500, 1000, 2000, 5000, 10000, 20000 } /**< upper bounds of the buckets of the sensor read time histogram, all but the last bucket */
+
 /**
  * @brief Status message type.
  */
@@ -110,6 +115,14 @@ void AppStatus_SendWlanDisconnectedMessage(void);
 
 void AppStatus_Stats_IncrementMqttBrokerDisconnectCounter(void);
 
+void AppStatus_Stats_UpdateMqttPublishInFlightMax(uint32_t numberInFlight);
+
+void AppStatus_Stats_IncrementMqttPublishFailedCounter(void);
+
+void AppStatus_Stats_UpdateMqttPublishClassStats(AppMqttScheduler_Class_T publishClass, uint32_t queueDepth, uint32_t waitMillis);
+
+void AppStatus_Stats_IncrementMqttPublishDeadlineMissedCounter(AppMqttScheduler_Class_T publishClass);
+
 void AppStatus_Stats_IncrementWlanDisconnectCounter(void);
 
 void AppStatus_Stats_IncrementTelemetrySendFailedCounter(void);
@@ -118,6 +131,46 @@ void AppStatus_Stats_IncrementTelemetrySendTooSlowCounter(void);
 
 void AppStatus_Stats_IncrementTelemetrySamplingTooSlowCounter(void);
 
+void AppStatus_Stats_UpdateTelemetrySamplingAddSampleMaxTicks(uint32_t ticks);
+
+void AppStatus_Stats_SetTelemetrySamplingSensors(const AppRuntimeConfig_Sensors_T * sensorsPtr);
+
+void AppStatus_Stats_UpdateTelemetrySamplingReadStats(uint32_t numberOfReads, uint32_t totalMicros, uint32_t maxMicros);
+
+void AppStatus_Stats_UpdateTelemetrySamplingHistograms(const uint32_t * jitterCountsPtr, uint32_t jitterMaxMicros, const uint32_t * readCountsPtr);
+
+void AppStatus_Stats_IncrementTelemetrySamplingSkippedCyclesCounter(uint32_t numberOfCycles);
+
+void AppStatus_Stats_UpdateTelemetrySamplingAlignStats(uint32_t numberOfCycles, uint32_t totalMicros, uint32_t maxMicros);
+
+void AppStatus_Stats_IncrementTelemetryQueueDropOldestCounter(uint32_t numberOfSamples);
+
+void AppStatus_Stats_IncrementTelemetryQueueDropNewestCounter(uint32_t numberOfSamples);
+
+void AppStatus_Stats_IncrementTelemetryQueueFlushOnCountCounter(void);
+
+void AppStatus_Stats_IncrementTelemetryQueueFlushOnBytesCounter(void);
+
+void AppStatus_Stats_IncrementTelemetryQueueFlushOnAgeCounter(void);
+
+void AppStatus_Stats_IncrementTelemetrySpilledEventsCounter(void);
+
+void AppStatus_Stats_IncrementTelemetryReplayedEventsCounter(void);
+
+void AppStatus_Stats_IncrementTelemetrySpillDroppedEventsCounter(uint32_t numberOfEvents);
+
+void AppStatus_Stats_IncrementTelemetryDeadbandCounters(uint32_t numberOfSent, uint32_t numberOfSuppressed);
+
+void AppStatus_Stats_IncrementTelemetryCaptureTriggeredCounter(void);
+
+void AppStatus_Stats_IncrementTelemetryCaptureMissedCounter(void);
+
+void AppStatus_Stats_IncrementTelemetryCaptureUploadedCounter(void);
+
+void AppStatus_Stats_UpdateTelemetrySpectrumStats(uint32_t computeTicks);
+
+void AppStatus_Stats_IncrementTelemetryFusionDroppedOutputsCounter(void);
+
 Retcode_T AppStatus_InitErrorHandling(void);
 
 void AppStatus_ErrorHandlingFunc(Retcode_T retcode, bool isfromIsr);
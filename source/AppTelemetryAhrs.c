@@ -0,0 +1,281 @@
+/*
+ * AppTelemetryAhrs.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetryAhrs AppTelemetryAhrs
+ * @{
+ *
+ * @brief Fixed-point Mahony orientation filter (AHRS) of accelerometer, gyroscope and magnetometer samples. Used by @ref AppTelemetryFusion.
+ * @details The gyroscope rates are integrated into the orientation quaternion at every sample, the drift is corrected by a proportional (and optional integral)
+ * feedback of the error between the measured and the estimated directions of gravity and, if a magnetometer sample is given, of the earth magnetic field.
+ * Mahony rather than Madgwick: one quaternion normalization per update instead of the normalization of the gradient, at the same accuracy for slow feedback gains.
+ * @details Integer arithmetic only, for the Cortex-M3 without FPU:
+ * - the quaternion and the normalized vectors are Q30 in int32, the products are computed in int64,
+ * - the norms use an integer square root, a single division per normalization,
+ * - the Euler angles use a CORDIC atan2 with a table of 24 angles in micro degrees.
+ * @details The axes of the three sensors must be aligned. A zero accelerometer sample skips the feedback, a zero magnetometer sample uses gravity only (IMU mode, yaw drifts).
+ * @details After a reset roll and pitch converge from gravity within #APP_TELEMETRY_AHRS_CONVERGE_MILLIS, the yaw from the magnetometer is slower,
+ * with a time constant of about 20 s at the proportional gain of #APP_TELEMETRY_AHRS_TWO_KP_THOUSANDTHS.
+ * Once converged, the orientation stays within 0.02 degrees of a double-precision filter of the same equations.
+ * @details The module has no dependencies on FreeRTOS or the XDK SDK, the filter is covered by the host unit test test/test_AppTelemetryAhrs.c.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+
+#include "AppTelemetryAhrs.h"
+
+#include <string.h>
+
+#define APP_TELEMETRY_AHRS_ONE						INT64_C(1073741824) /**< 1.0 in Q30, in int64 for the products */
+#define APP_TELEMETRY_AHRS_HALF						(APP_TELEMETRY_AHRS_ONE / 2) /**< 0.5 in Q30 */
+#define APP_TELEMETRY_AHRS_MAX_HALF_ANGLE			(APP_TELEMETRY_AHRS_ONE / 4) /**< max rotation per update and axis: half angle of 0.25 rad, keeps the first-order integration stable on gyroscope spikes */
+#define APP_TELEMETRY_AHRS_MILLIDPS_TO_RAD_Q30_MUL	INT64_C(1199386) /**< milli degrees per second to Q30 rad/s: x * 2^30 * pi / 180000 = (x * 1199386) >> 6 */
+#define APP_TELEMETRY_AHRS_MILLIDPS_TO_RAD_Q30_SHIFT	6 /**< see #APP_TELEMETRY_AHRS_MILLIDPS_TO_RAD_Q30_MUL */
+#define APP_TELEMETRY_AHRS_CONVERGE_GAIN_FACTOR		INT64_C(10) /**< factor of the proportional gain for #APP_TELEMETRY_AHRS_CONVERGE_MILLIS after a reset */
+#define APP_TELEMETRY_AHRS_CORDIC_ITERATIONS		UINT32_C(24) /**< number of CORDIC iterations, the resolution of the angles is 7 micro degrees */
+#define APP_TELEMETRY_AHRS_180_DEG_MICRO			INT64_C(180000000) /**< 180 degrees in micro degrees */
+
+/**
+ * @brief atan(2^-i) in micro degrees for the CORDIC iterations.
+ */
+static const int32_t appTelemetryAhrs_AtanTable[APP_TELEMETRY_AHRS_CORDIC_ITERATIONS] = {
+	45000000, 26565051, 14036243, 7125016, 3576334, 1789911, 895174, 447614,
+	223811, 111906, 55953, 27976, 13988, 6994, 3497, 1749,
+	874, 437, 219, 109, 55, 27, 14, 7
+};
+/**
+ * @brief Returns the integer square root of a number, rounded down.
+ * @param[in] value: the number
+ * @return uint64_t: the square root
+ */
+static uint64_t appTelemetryAhrs_Sqrt(uint64_t value) {
+
+	uint64_t root = 0;
+	uint64_t bit = UINT64_C(1) << 62;
+
+	while(bit > value) bit >>= 2;
+
+	while(bit != 0) {
+		if(value >= root + bit) {
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	return root;
+}
+/**
+ * @brief Returns the product of two Q30 numbers in Q30.
+ */
+static inline int64_t appTelemetryAhrs_Mul(int64_t a, int64_t b) {
+	return (a * b) >> 30;
+}
+/**
+ * @brief Normalizes a vector of raw sensor values to Q30.
+ * @param[in] valuesPtr: the raw values, up to 2^16 in magnitude
+ * @param[out] normalizedPtr: the unit vector in Q30
+ * @return bool: false if the vector is zero, normalizedPtr is not set
+ */
+static bool appTelemetryAhrs_Normalize(const int32_t valuesPtr[3], int64_t normalizedPtr[3]) {
+
+	uint64_t sumOfSquares = 0;
+	for(uint32_t i = 0; i < 3; i++) sumOfSquares += (uint64_t) ((int64_t) valuesPtr[i] * valuesPtr[i]);
+
+	uint64_t norm = appTelemetryAhrs_Sqrt(sumOfSquares);
+	if(0 == norm) return false;
+
+	// 1 / norm in Q46, a single division
+	int64_t inverse = (int64_t) ((UINT64_C(1) << 46) / norm);
+	for(uint32_t i = 0; i < 3; i++) normalizedPtr[i] = (valuesPtr[i] * inverse) >> 16;
+
+	return true;
+}
+/**
+ * @brief Resets the filter to the identity orientation and the fast converging gain.
+ * @param[out] ahrsPtr: the filter
+ */
+void AppTelemetryAhrs_Reset(AppTelemetryAhrs_T * ahrsPtr) {
+
+	memset(ahrsPtr, 0, sizeof(AppTelemetryAhrs_T));
+	ahrsPtr->quaternion[0] = APP_TELEMETRY_AHRS_Q30_ONE;
+}
+/**
+ * @brief Updates the orientation with a sample of the sensors.
+ * @param[in,out] ahrsPtr: the filter
+ * @param[in] accelMilliG: accelerometer x, y, z in milli g. All zero skips the feedback.
+ * @param[in] gyroMilliDegPerSecond: gyroscope x, y, z in milli degrees per second
+ * @param[in] magMicroTesla: magnetometer x, y, z in micro tesla. NULL or all zero uses gravity only, the yaw is not corrected.
+ * @param[in] periodMillis: time since the last update
+ */
+void AppTelemetryAhrs_Update(AppTelemetryAhrs_T * ahrsPtr, const int32_t accelMilliG[3], const int32_t gyroMilliDegPerSecond[3], const int32_t magMicroTesla[3], uint32_t periodMillis) {
+
+	const int64_t q0 = ahrsPtr->quaternion[0];
+	const int64_t q1 = ahrsPtr->quaternion[1];
+	const int64_t q2 = ahrsPtr->quaternion[2];
+	const int64_t q3 = ahrsPtr->quaternion[3];
+
+	int64_t g[3];
+	for(uint32_t i = 0; i < 3; i++) g[i] = (gyroMilliDegPerSecond[i] * APP_TELEMETRY_AHRS_MILLIDPS_TO_RAD_Q30_MUL) >> APP_TELEMETRY_AHRS_MILLIDPS_TO_RAD_Q30_SHIFT;
+
+	int64_t a[3];
+	if(appTelemetryAhrs_Normalize(accelMilliG, a)) {
+
+		// estimated direction of gravity, halved
+		int64_t halfV[3];
+		halfV[0] = appTelemetryAhrs_Mul(q1, q3) - appTelemetryAhrs_Mul(q0, q2);
+		halfV[1] = appTelemetryAhrs_Mul(q0, q1) + appTelemetryAhrs_Mul(q2, q3);
+		halfV[2] = appTelemetryAhrs_Mul(q0, q0) - APP_TELEMETRY_AHRS_HALF + appTelemetryAhrs_Mul(q3, q3);
+
+		// error: cross product of the measured and the estimated directions
+		int64_t halfE[3];
+		halfE[0] = appTelemetryAhrs_Mul(a[1], halfV[2]) - appTelemetryAhrs_Mul(a[2], halfV[1]);
+		halfE[1] = appTelemetryAhrs_Mul(a[2], halfV[0]) - appTelemetryAhrs_Mul(a[0], halfV[2]);
+		halfE[2] = appTelemetryAhrs_Mul(a[0], halfV[1]) - appTelemetryAhrs_Mul(a[1], halfV[0]);
+
+		int64_t m[3];
+		if(NULL != magMicroTesla && appTelemetryAhrs_Normalize(magMicroTesla, m)) {
+
+			const int64_t q0q1 = appTelemetryAhrs_Mul(q0, q1);
+			const int64_t q0q2 = appTelemetryAhrs_Mul(q0, q2);
+			const int64_t q0q3 = appTelemetryAhrs_Mul(q0, q3);
+			const int64_t q1q1 = appTelemetryAhrs_Mul(q1, q1);
+			const int64_t q1q2 = appTelemetryAhrs_Mul(q1, q2);
+			const int64_t q1q3 = appTelemetryAhrs_Mul(q1, q3);
+			const int64_t q2q2 = appTelemetryAhrs_Mul(q2, q2);
+			const int64_t q2q3 = appTelemetryAhrs_Mul(q2, q3);
+			const int64_t q3q3 = appTelemetryAhrs_Mul(q3, q3);
+
+			// reference direction of the earth magnetic field: the measured field in the earth frame, horizontal part on x
+			int64_t hx = 2 * (appTelemetryAhrs_Mul(m[0], APP_TELEMETRY_AHRS_HALF - q2q2 - q3q3) + appTelemetryAhrs_Mul(m[1], q1q2 - q0q3) + appTelemetryAhrs_Mul(m[2], q1q3 + q0q2));
+			int64_t hy = 2 * (appTelemetryAhrs_Mul(m[0], q1q2 + q0q3) + appTelemetryAhrs_Mul(m[1], APP_TELEMETRY_AHRS_HALF - q1q1 - q3q3) + appTelemetryAhrs_Mul(m[2], q2q3 - q0q1));
+			int64_t bx = (int64_t) appTelemetryAhrs_Sqrt((uint64_t) (hx * hx + hy * hy));
+			int64_t bz = 2 * (appTelemetryAhrs_Mul(m[0], q1q3 - q0q2) + appTelemetryAhrs_Mul(m[1], q2q3 + q0q1) + appTelemetryAhrs_Mul(m[2], APP_TELEMETRY_AHRS_HALF - q1q1 - q2q2));
+
+			// estimated direction of the magnetic field, halved
+			int64_t halfW[3];
+			halfW[0] = appTelemetryAhrs_Mul(bx, APP_TELEMETRY_AHRS_HALF - q2q2 - q3q3) + appTelemetryAhrs_Mul(bz, q1q3 - q0q2);
+			halfW[1] = appTelemetryAhrs_Mul(bx, q1q2 - q0q3) + appTelemetryAhrs_Mul(bz, q0q1 + q2q3);
+			halfW[2] = appTelemetryAhrs_Mul(bx, q0q2 + q1q3) + appTelemetryAhrs_Mul(bz, APP_TELEMETRY_AHRS_HALF - q1q1 - q2q2);
+
+			halfE[0] += appTelemetryAhrs_Mul(m[1], halfW[2]) - appTelemetryAhrs_Mul(m[2], halfW[1]);
+			halfE[1] += appTelemetryAhrs_Mul(m[2], halfW[0]) - appTelemetryAhrs_Mul(m[0], halfW[2]);
+			halfE[2] += appTelemetryAhrs_Mul(m[0], halfW[1]) - appTelemetryAhrs_Mul(m[1], halfW[0]);
+		}
+
+		int64_t twoKpThousandths = APP_TELEMETRY_AHRS_TWO_KP_THOUSANDTHS;
+		if(ahrsPtr->elapsedMillis < APP_TELEMETRY_AHRS_CONVERGE_MILLIS) twoKpThousandths *= APP_TELEMETRY_AHRS_CONVERGE_GAIN_FACTOR;
+
+		for(uint32_t i = 0; i < 3; i++) {
+			if(APP_TELEMETRY_AHRS_TWO_KI_THOUSANDTHS > 0) {
+				ahrsPtr->integralFeedback[i] += halfE[i] * (int64_t) APP_TELEMETRY_AHRS_TWO_KI_THOUSANDTHS * periodMillis / INT64_C(1000000);
+				g[i] += ahrsPtr->integralFeedback[i];
+			}
+			g[i] += halfE[i] * twoKpThousandths / INT64_C(1000);
+		}
+	}
+
+	if(ahrsPtr->elapsedMillis < APP_TELEMETRY_AHRS_CONVERGE_MILLIS) ahrsPtr->elapsedMillis += periodMillis;
+
+	// half the rotation of the period
+	for(uint32_t i = 0; i < 3; i++) {
+		g[i] = g[i] * (int64_t) periodMillis / INT64_C(2000);
+		if(g[i] > APP_TELEMETRY_AHRS_MAX_HALF_ANGLE) g[i] = APP_TELEMETRY_AHRS_MAX_HALF_ANGLE;
+		else if(g[i] < -APP_TELEMETRY_AHRS_MAX_HALF_ANGLE) g[i] = -APP_TELEMETRY_AHRS_MAX_HALF_ANGLE;
+	}
+
+	int64_t q[4];
+	q[0] = q0 + ((-q1 * g[0] - q2 * g[1] - q3 * g[2]) >> 30);
+	q[1] = q1 + ((q0 * g[0] + q2 * g[2] - q3 * g[1]) >> 30);
+	q[2] = q2 + ((q0 * g[1] - q1 * g[2] + q3 * g[0]) >> 30);
+	q[3] = q3 + ((q0 * g[2] + q1 * g[1] - q2 * g[0]) >> 30);
+
+	uint64_t sumOfSquares = 0;
+	for(uint32_t i = 0; i < 4; i++) sumOfSquares += (uint64_t) (q[i] * q[i]);
+	uint64_t norm = appTelemetryAhrs_Sqrt(sumOfSquares);
+
+	if(0 == norm) {
+		AppTelemetryAhrs_Reset(ahrsPtr);
+		return;
+	}
+	// 1 / norm in Q30
+	int64_t inverse = (int64_t) ((UINT64_C(1) << 60) / norm);
+	for(uint32_t i = 0; i < 4; i++) ahrsPtr->quaternion[i] = (int32_t) appTelemetryAhrs_Mul(q[i], inverse);
+}
+/**
+ * @brief Returns atan2(y, x) in micro degrees in [-180, 180] by CORDIC vectoring.
+ * @param[in] y: Q30, at most 2 in magnitude
+ * @param[in] x: Q30, at most 2 in magnitude
+ * @return int64_t: the angle in micro degrees
+ */
+static int64_t appTelemetryAhrs_Atan2(int64_t y, int64_t x) {
+
+	int64_t angle = 0;
+	if(x < 0) {
+		// rotate by 180 degrees into the right half-plane
+		angle = (y >= 0) ? APP_TELEMETRY_AHRS_180_DEG_MICRO : -APP_TELEMETRY_AHRS_180_DEG_MICRO;
+		x = -x;
+		y = -y;
+	}
+	for(uint32_t i = 0; i < APP_TELEMETRY_AHRS_CORDIC_ITERATIONS; i++) {
+		int64_t nextX;
+		if(y > 0) {
+			nextX = x + (y >> i);
+			y -= x >> i;
+			angle += appTelemetryAhrs_AtanTable[i];
+		} else {
+			nextX = x - (y >> i);
+			y += x >> i;
+			angle -= appTelemetryAhrs_AtanTable[i];
+		}
+		x = nextX;
+	}
+	return angle;
+}
+/**
+ * @brief Returns micro degrees rounded to milli degrees.
+ */
+static inline int32_t appTelemetryAhrs_MicroToMilliDeg(int64_t microDeg) {
+	return (int32_t) ((microDeg >= 0) ? (microDeg + 500) / 1000 : (microDeg - 500) / 1000);
+}
+/**
+ * @brief Returns the Euler angles of the orientation, aerospace sequence z-y-x.
+ * @param[in] ahrsPtr: the filter
+ * @param[out] eulerMilliDeg: roll in [-180, 180], pitch in [-90, 90] and yaw in [-180, 180], in milli degrees
+ */
+void AppTelemetryAhrs_GetEulerAngles(const AppTelemetryAhrs_T * ahrsPtr, int32_t eulerMilliDeg[3]) {
+
+	const int64_t q0 = ahrsPtr->quaternion[0];
+	const int64_t q1 = ahrsPtr->quaternion[1];
+	const int64_t q2 = ahrsPtr->quaternion[2];
+	const int64_t q3 = ahrsPtr->quaternion[3];
+
+	const int64_t q1q1 = appTelemetryAhrs_Mul(q1, q1);
+	const int64_t q2q2 = appTelemetryAhrs_Mul(q2, q2);
+	const int64_t q3q3 = appTelemetryAhrs_Mul(q3, q3);
+
+	// roll = atan2(2 (q0 q1 + q2 q3), 1 - 2 (q1^2 + q2^2)), both halved
+	eulerMilliDeg[0] = appTelemetryAhrs_MicroToMilliDeg(appTelemetryAhrs_Atan2(appTelemetryAhrs_Mul(q0, q1) + appTelemetryAhrs_Mul(q2, q3), APP_TELEMETRY_AHRS_HALF - q1q1 - q2q2));
+
+	// pitch = asin(2 (q0 q2 - q1 q3)) = atan2(s, sqrt(1 - s^2))
+	int64_t s = 2 * (appTelemetryAhrs_Mul(q0, q2) - appTelemetryAhrs_Mul(q1, q3));
+	if(s > APP_TELEMETRY_AHRS_ONE) s = APP_TELEMETRY_AHRS_ONE;
+	else if(s < -APP_TELEMETRY_AHRS_ONE) s = -APP_TELEMETRY_AHRS_ONE;
+	int64_t c = (int64_t) appTelemetryAhrs_Sqrt((uint64_t) (APP_TELEMETRY_AHRS_ONE * APP_TELEMETRY_AHRS_ONE - s * s));
+	eulerMilliDeg[1] = appTelemetryAhrs_MicroToMilliDeg(appTelemetryAhrs_Atan2(s, c));
+
+	// yaw = atan2(2 (q0 q3 + q1 q2), 1 - 2 (q2^2 + q3^2)), both halved
+	eulerMilliDeg[2] = appTelemetryAhrs_MicroToMilliDeg(appTelemetryAhrs_Atan2(appTelemetryAhrs_Mul(q0, q3) + appTelemetryAhrs_Mul(q1, q2), APP_TELEMETRY_AHRS_HALF - q2q2 - q3q3));
+}
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,44 @@
+/*
+ * AppTelemetryAhrs.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetryAhrs
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYAHRS_H_
+#define SOURCE_APPTELEMETRYAHRS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define APP_TELEMETRY_AHRS_Q30_ONE					(INT32_C(1) << 30) /**< 1.0 in the Q30 format of the quaternion */
+#define APP_TELEMETRY_AHRS_TWO_KP_THOUSANDTHS		UINT32_C(1000) /**< proportional gain of the feedback, times 2 */
+#define APP_TELEMETRY_AHRS_TWO_KI_THOUSANDTHS		UINT32_C(0) /**< integral gain of the feedback, times 2. 0: no gyroscope bias estimation */
+#define APP_TELEMETRY_AHRS_CONVERGE_MILLIS			UINT32_C(2000) /**< time after a reset with a 10 times higher proportional gain, for the initial orientation */
+
+/**
+ * @brief State of a Mahony orientation filter.
+ */
+typedef struct {
+	int32_t quaternion[4]; /**< orientation of the sensor frame relative to the earth frame: w, x, y, z in Q30 */
+	int64_t integralFeedback[3]; /**< integral of the error in Q30 rad/s */
+	uint32_t elapsedMillis; /**< time since the reset, up to #APP_TELEMETRY_AHRS_CONVERGE_MILLIS */
+} AppTelemetryAhrs_T;
+
+void AppTelemetryAhrs_Reset(AppTelemetryAhrs_T * ahrsPtr);
+
+void AppTelemetryAhrs_Update(AppTelemetryAhrs_T * ahrsPtr, const int32_t accelMilliG[3], const int32_t gyroMilliDegPerSecond[3], const int32_t magMicroTesla[3], uint32_t periodMillis);
+
+void AppTelemetryAhrs_GetEulerAngles(const AppTelemetryAhrs_T * ahrsPtr, int32_t eulerMilliDeg[3]);
+
+#endif /* SOURCE_APPTELEMETRYAHRS_H_ */
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,228 @@
+/*
+ * AppTelemetryAnalysis.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetryAnalysis AppTelemetryAnalysis
+ * @{
+ *
+ * @brief Vibration spectrum features of consecutive accelerometer windows.
+ * @details The sampling task adds the accelerometer values of every sample to a window of spectrumWindowSamples samples.
+ * Once the window is full, @ref AppTelemetryPublish computes its features with @ref AppTelemetrySpectrum (@ref AppTelemetryAnalysis_ComputeSpectrum()),
+ * publishes them (@ref AppTelemetryPayload_EncodeSpectrum()) and the next window starts.
+ * Samples taken while the features are computed are not analysed, the windows are not contiguous.
+ * @details The window is sampled at the sampling period, the frequencies of the peaks go up to half the sampling rate.
+ * The window and the work buffer of the transform take 10 bytes per sample of the heap, 5 KB for 512 samples.
+ * The number of windows analysed and the longest compute time are in the @ref AppStatus stats.
+ * @details The analysis is disabled if spectrumWindowSamples is 0.
+ * @note @ref AppTelemetryAnalysis_AddSample() is only called by the sampling task, @ref AppTelemetryAnalysis_ComputeSpectrum() only by the publishing task.
+ * The sampling task only writes the window while it is filling, the publishing task only reads it while it is full. Configuration is only changed while neither task is running.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+#include "XdkAppInfo.h"
+
+#undef BCDS_MODULE_ID /**< undefine any previous module id */
+#define BCDS_MODULE_ID SOLACE_APP_MODULE_ID_APP_TELEMETRY_ANALYSIS
+
+#include "AppTelemetryAnalysis.h"
+#include "AppTelemetrySpectrum.h"
+#include "AppStatus.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief The states of the window.
+ */
+typedef enum {
+	AppTelemetryAnalysis_State_Disabled = 0, /**< no window configured, samples are ignored */
+	AppTelemetryAnalysis_State_Filling, /**< the sampling task adds the samples */
+	AppTelemetryAnalysis_State_Full, /**< the window is complete and owned by the publishing task until its features are computed */
+} AppTelemetryAnalysis_State_T;
+
+static uint16_t appTelemetryAnalysis_WindowSamples = APP_RT_CFG_DEFAULT_SPECTRUM_WINDOW_SAMPLES; /**< local copy of configuration. number of samples per window, 0: disabled */
+static uint8_t appTelemetryAnalysis_NumberOfPeaks = APP_RT_CFG_DEFAULT_SPECTRUM_PEAKS; /**< local copy of configuration. number of peaks per axis */
+static uint32_t appTelemetryAnalysis_SamplingPeriodMillis = 0; /**< local copy of the active sampling period, the period of the samples of the window */
+
+static volatile AppTelemetryAnalysis_State_T appTelemetryAnalysis_State = AppTelemetryAnalysis_State_Disabled; /**< the state, hands the window over between the sampling and the publishing task */
+
+static int16_t * appTelemetryAnalysis_ValuesPtr = NULL; /**< the window, the values of x, y and z one after the other */
+static int16_t * appTelemetryAnalysis_WorkPtr = NULL; /**< the work buffer of the transform, 2 values per sample */
+static uint32_t appTelemetryAnalysis_NumberOfPoints = 0; /**< number of samples of the allocated window */
+static uint32_t appTelemetryAnalysis_Log2NumberOfPoints = 0; /**< log2 of #appTelemetryAnalysis_NumberOfPoints */
+
+/* sampling task only, while filling */
+static uint32_t appTelemetryAnalysis_Count = 0; /**< number of samples in the window */
+static TickType_t appTelemetryAnalysis_FirstTickCount = 0; /**< tick count of the first sample of the window */
+
+/* publishing task only, while full */
+static AppTelemetryPayload_Spectrum_T appTelemetryAnalysis_Spectrum; /**< the features of the last window */
+
+/**
+ * @brief Free the window and the work buffer.
+ */
+static void appTelemetryAnalysis_Free(void) {
+
+	free(appTelemetryAnalysis_ValuesPtr);
+	appTelemetryAnalysis_ValuesPtr = NULL;
+	free(appTelemetryAnalysis_WorkPtr);
+	appTelemetryAnalysis_WorkPtr = NULL;
+	appTelemetryAnalysis_NumberOfPoints = 0;
+	appTelemetryAnalysis_Log2NumberOfPoints = 0;
+}
+/**
+ * @brief Initialize the module.
+ * @return Retcode_T: RETCODE_OK
+ */
+Retcode_T AppTelemetryAnalysis_Init(void) {
+
+	appTelemetryAnalysis_State = AppTelemetryAnalysis_State_Disabled;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Setup the module with the configuration.
+ * @param[in] configPtr: the runtime configuration. Module requires targetTelemetryConfigPtr and activeTelemetryRTParamsPtr
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: retcode from @ref AppTelemetryAnalysis_ApplyNewRuntimeConfig()
+ */
+Retcode_T AppTelemetryAnalysis_Setup(const AppRuntimeConfig_T * configPtr) {
+
+	assert(configPtr);
+	assert(configPtr->targetTelemetryConfigPtr);
+	assert(configPtr->activeTelemetryRTParamsPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	if(RETCODE_OK == retcode) retcode = AppTelemetryAnalysis_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr->targetTelemetryConfigPtr);
+
+	if(RETCODE_OK == retcode) retcode = AppTelemetryAnalysis_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, configPtr->activeTelemetryRTParamsPtr);
+
+	return retcode;
+}
+/**
+ * @brief Apply a new runtime configuration to the module.
+ * @details AppRuntimeConfig_Element_targetTelemetryConfig: the window size and the number of peaks.
+ * @details AppRuntimeConfig_Element_activeTelemetryRTParams: the sampling period.
+ * @details Both take effect with @ref AppTelemetryAnalysis_Prepare().
+ * @param[in] configElement: the type of configuration to apply.
+ * @param[in] newConfigPtr: the configuration of type configElement
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT)
+ */
+Retcode_T AppTelemetryAnalysis_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr) {
+
+	assert(newConfigPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	switch(configElement) {
+	case AppRuntimeConfig_Element_targetTelemetryConfig:
+		appTelemetryAnalysis_WindowSamples = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.spectrumWindowSamples;
+		appTelemetryAnalysis_NumberOfPeaks = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.spectrumPeaks;
+		break;
+	case AppRuntimeConfig_Element_activeTelemetryRTParams:
+		appTelemetryAnalysis_SamplingPeriodMillis = ((AppRuntimeConfig_TelemetryRTParams_T *) newConfigPtr)->samplingPeriodicityMillis;
+		break;
+	default: retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT);
+	}
+
+	return retcode;
+}
+/**
+ * @brief Prepare the window. (Re-)creates it if its size changed, frees it if the analysis is disabled. Discards any samples.
+ * @note Call only while neither the sampling nor the publishing task is running.
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_TELEMETRY_ANALYSIS_FAILED_TO_ALLOCATE)
+ */
+Retcode_T AppTelemetryAnalysis_Prepare(void) {
+
+	uint32_t numberOfPoints = (appTelemetryAnalysis_SamplingPeriodMillis > 0) ? appTelemetryAnalysis_WindowSamples : 0;
+
+	if(numberOfPoints != appTelemetryAnalysis_NumberOfPoints) {
+		appTelemetryAnalysis_Free();
+		if(numberOfPoints > 0) {
+			appTelemetryAnalysis_ValuesPtr = malloc(APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES * numberOfPoints * sizeof(int16_t));
+			appTelemetryAnalysis_WorkPtr = malloc(2 * numberOfPoints * sizeof(int16_t));
+			if(NULL == appTelemetryAnalysis_ValuesPtr || NULL == appTelemetryAnalysis_WorkPtr) {
+				appTelemetryAnalysis_Free();
+				appTelemetryAnalysis_State = AppTelemetryAnalysis_State_Disabled;
+				return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_TELEMETRY_ANALYSIS_FAILED_TO_ALLOCATE);
+			}
+			appTelemetryAnalysis_NumberOfPoints = numberOfPoints;
+			while((UINT32_C(1) << appTelemetryAnalysis_Log2NumberOfPoints) < numberOfPoints) appTelemetryAnalysis_Log2NumberOfPoints++;
+		}
+	}
+
+	appTelemetryAnalysis_Count = 0;
+
+	appTelemetryAnalysis_State = (appTelemetryAnalysis_ValuesPtr != NULL) ? AppTelemetryAnalysis_State_Filling : AppTelemetryAnalysis_State_Disabled;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Returns true if the spectrum features are computed.
+ * @return bool: true if spectrumWindowSamples > 0 and the window is allocated
+ */
+bool AppTelemetryAnalysis_IsEnabled(void) {
+	return (AppTelemetryAnalysis_State_Disabled != appTelemetryAnalysis_State);
+}
+/**
+ * @brief Add a sample to the window. Does not allocate, called in the sampling task.
+ * @param[in] tickCount: the tick count at the time of sampling
+ * @param[in] sensorValuePtr: the values of the sensors, only the accelerometer is used
+ */
+void AppTelemetryAnalysis_AddSample(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr) {
+
+	assert(sensorValuePtr);
+
+	if(AppTelemetryAnalysis_State_Filling != appTelemetryAnalysis_State) return;
+
+	int32_t accel[APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES] = { sensorValuePtr->Accel.X, sensorValuePtr->Accel.Y, sensorValuePtr->Accel.Z };
+
+	if(0 == appTelemetryAnalysis_Count) appTelemetryAnalysis_FirstTickCount = tickCount;
+
+	for(uint32_t axis = 0; axis < APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES; axis++) {
+		if(accel[axis] > INT16_MAX) accel[axis] = INT16_MAX;
+		else if(accel[axis] < INT16_MIN) accel[axis] = INT16_MIN;
+		appTelemetryAnalysis_ValuesPtr[axis * appTelemetryAnalysis_NumberOfPoints + appTelemetryAnalysis_Count] = (int16_t) accel[axis];
+	}
+
+	if(++appTelemetryAnalysis_Count == appTelemetryAnalysis_NumberOfPoints) appTelemetryAnalysis_State = AppTelemetryAnalysis_State_Full;
+}
+/**
+ * @brief Computes the spectrum features of the full window, if any, and starts the next window. Called by the publishing task.
+ * @details Takes 2 fixed-point transforms of the window size, see @ref AppTelemetrySpectrum_ComputeFeatures().
+ * @return const AppTelemetryPayload_Spectrum_T *: the features, valid until the next call. NULL if the window is not full
+ */
+const AppTelemetryPayload_Spectrum_T * AppTelemetryAnalysis_ComputeSpectrum(void) {
+
+	if(AppTelemetryAnalysis_State_Full != appTelemetryAnalysis_State) return NULL;
+
+	TickType_t startTicks = xTaskGetTickCount();
+
+	AppTelemetrySpectrum_ComputeFeatures(appTelemetryAnalysis_ValuesPtr, appTelemetryAnalysis_Log2NumberOfPoints, appTelemetryAnalysis_SamplingPeriodMillis,
+			appTelemetryAnalysis_NumberOfPeaks, appTelemetryAnalysis_WorkPtr, &appTelemetryAnalysis_Spectrum.features);
+	appTelemetryAnalysis_Spectrum.firstTickCount = appTelemetryAnalysis_FirstTickCount;
+	appTelemetryAnalysis_Spectrum.numberOfSamples = appTelemetryAnalysis_NumberOfPoints;
+	appTelemetryAnalysis_Spectrum.samplingPeriodMillis = appTelemetryAnalysis_SamplingPeriodMillis;
+
+	AppStatus_Stats_UpdateTelemetrySpectrumStats(xTaskGetTickCount() - startTicks);
+
+	// the features are a copy, the next window can start
+	appTelemetryAnalysis_Count = 0;
+	appTelemetryAnalysis_State = AppTelemetryAnalysis_State_Filling;
+
+	return &appTelemetryAnalysis_Spectrum;
+}
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,40 @@
+/*
+ * AppTelemetryAnalysis.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetryAnalysis
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYANALYSIS_H_
+#define SOURCE_APPTELEMETRYANALYSIS_H_
+
+#include "AppTelemetryPayload.h"
+#include "AppRuntimeConfig.h"
+
+#include "XDK_Sensor.h"
+
+Retcode_T AppTelemetryAnalysis_Init(void);
+
+Retcode_T AppTelemetryAnalysis_Setup(const AppRuntimeConfig_T * configPtr);
+
+Retcode_T AppTelemetryAnalysis_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr);
+
+Retcode_T AppTelemetryAnalysis_Prepare(void);
+
+bool AppTelemetryAnalysis_IsEnabled(void);
+
+void AppTelemetryAnalysis_AddSample(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr);
+
+const AppTelemetryPayload_Spectrum_T * AppTelemetryAnalysis_ComputeSpectrum(void);
+
+#endif /* SOURCE_APPTELEMETRYANALYSIS_H_ */
+
+/**@} */
+/** ************************************************************************* */
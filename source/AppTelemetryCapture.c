@@ -0,0 +1,302 @@
+/*
+ * AppTelemetryCapture.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetryCapture AppTelemetryCapture
+ * @{
+ *
+ * @brief Pre/post-trigger capture of the raw accelerometer samples around a threshold event.
+ * @details The sampling task adds every sample to a ring holding the last capturePreTriggerMillis of accelerometer samples.
+ * Once the magnitude of the acceleration rises to captureThresholdMilliG, the ring records capturePostTriggerMillis more samples and is then frozen.
+ * @ref AppTelemetryPublish uploads the frozen window in chunks that fit into a publish (@ref AppTelemetryPayload_EncodeCaptureChunk()) and the ring is re-armed.
+ * @details The samples are captured at the sampling period, the window holds at most #APP_RT_CFG_TELEMETRY_MAX_CAPTURE_SAMPLES samples.
+ * The magnitude includes gravity, i.e. it is about 1000 milli g at rest.
+ * Triggers while a window is frozen are counted as missed. Triggered, missed and uploaded captures are counted in @ref AppStatus stats.
+ * @details Capturing is disabled if captureThresholdMilliG is 0.
+ * @note @ref AppTelemetryCapture_AddSample() is only called by the sampling task, @ref AppTelemetryCapture_GetWindow() and @ref AppTelemetryCapture_ConsumeSamples() only by the publishing task.
+ * The sampling task only writes the ring while it is not frozen, the publishing task only reads it while it is frozen. Configuration is only changed while neither task is running.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+#include "XdkAppInfo.h"
+
+#undef BCDS_MODULE_ID /**< undefine any previous module id */
+#define BCDS_MODULE_ID SOLACE_APP_MODULE_ID_APP_TELEMETRY_CAPTURE
+
+#include "AppTelemetryCapture.h"
+#include "AppStatus.h"
+
+/**
+ * @brief The states of the capture ring.
+ */
+typedef enum {
+	AppTelemetryCapture_State_Disabled = 0, /**< no threshold configured, samples are ignored */
+	AppTelemetryCapture_State_Armed, /**< recording the pre-trigger history, waiting for the trigger */
+	AppTelemetryCapture_State_Triggered, /**< recording the post-trigger samples */
+	AppTelemetryCapture_State_Frozen, /**< the window is complete and owned by the publishing task until it is uploaded */
+} AppTelemetryCapture_State_T;
+
+static uint16_t appTelemetryCapture_ThresholdMilliG = APP_RT_CFG_DEFAULT_CAPTURE_THRESHOLD_MILLI_G; /**< local copy of configuration. magnitude that triggers a capture, 0: disabled */
+static uint32_t appTelemetryCapture_PreTriggerMillis = APP_RT_CFG_DEFAULT_CAPTURE_PRE_TRIGGER_MILLIS; /**< local copy of configuration. history before the trigger */
+static uint32_t appTelemetryCapture_PostTriggerMillis = APP_RT_CFG_DEFAULT_CAPTURE_POST_TRIGGER_MILLIS; /**< local copy of configuration. time recorded after the trigger */
+static uint32_t appTelemetryCapture_SamplingPeriodMillis = 0; /**< local copy of the active sampling period, the period of the captured samples */
+
+static volatile AppTelemetryCapture_State_T appTelemetryCapture_State = AppTelemetryCapture_State_Disabled; /**< the state, hands the ring over between the sampling and the publishing task */
+
+static AppTelemetryPayload_CaptureSample_T * appTelemetryCapture_SamplesPtr = NULL; /**< the ring */
+static uint32_t appTelemetryCapture_Capacity = 0; /**< number of samples of #appTelemetryCapture_SamplesPtr, the pre-trigger, trigger and post-trigger samples */
+static uint32_t appTelemetryCapture_NumberOfPostTriggerSamples = 0; /**< number of samples recorded after the trigger sample */
+
+/* sampling task only, while not frozen */
+static uint32_t appTelemetryCapture_WriteIndex = 0; /**< position of the next sample in the ring */
+static uint32_t appTelemetryCapture_Count = 0; /**< number of samples in the ring */
+static uint32_t appTelemetryCapture_RemainingPostTriggerSamples = 0; /**< number of post-trigger samples still to record */
+static bool appTelemetryCapture_isAboveThreshold = false; /**< the last sample was at or above the threshold. A capture is triggered by the rising edge only */
+
+/* publishing task only, while frozen */
+static AppTelemetryPayload_Capture_T appTelemetryCapture_Window; /**< the frozen window. The sampling task sets the numbers and the trigger at freeze */
+static bool appTelemetryCapture_isWindowOrdered = false; /**< the ring was rotated to hold the samples oldest first */
+static uint32_t appTelemetryCapture_NextSampleIndex = 0; /**< index of the first sample not uploaded yet */
+
+/**
+ * @brief Reverse the samples of the ring in [first, last).
+ * @param[in] first: index of the first sample
+ * @param[in] last: index after the last sample
+ */
+static void appTelemetryCapture_Reverse(uint32_t first, uint32_t last) {
+
+	while(first + 1 < last) {
+		AppTelemetryPayload_CaptureSample_T sample = appTelemetryCapture_SamplesPtr[first];
+		appTelemetryCapture_SamplesPtr[first++] = appTelemetryCapture_SamplesPtr[--last];
+		appTelemetryCapture_SamplesPtr[last] = sample;
+	}
+}
+/**
+ * @brief Discard the samples of the ring and arm it, if enabled.
+ */
+static void appTelemetryCapture_Rearm(void) {
+
+	appTelemetryCapture_WriteIndex = 0;
+	appTelemetryCapture_Count = 0;
+	appTelemetryCapture_RemainingPostTriggerSamples = 0;
+	appTelemetryCapture_isWindowOrdered = false;
+	appTelemetryCapture_NextSampleIndex = 0;
+
+	appTelemetryCapture_State = (appTelemetryCapture_SamplesPtr != NULL) ? AppTelemetryCapture_State_Armed : AppTelemetryCapture_State_Disabled;
+}
+/**
+ * @brief Freeze the ring, it holds the complete window.
+ */
+static void appTelemetryCapture_Freeze(void) {
+
+	appTelemetryCapture_Window.samplesPtr = appTelemetryCapture_SamplesPtr;
+	appTelemetryCapture_Window.numberOfSamples = appTelemetryCapture_Count;
+	appTelemetryCapture_Window.numberOfPreTriggerSamples = appTelemetryCapture_Count - 1 - appTelemetryCapture_NumberOfPostTriggerSamples;
+	appTelemetryCapture_Window.samplingPeriodMillis = appTelemetryCapture_SamplingPeriodMillis;
+
+	appTelemetryCapture_State = AppTelemetryCapture_State_Frozen;
+}
+/**
+ * @brief Initialize the module.
+ * @return Retcode_T: RETCODE_OK
+ */
+Retcode_T AppTelemetryCapture_Init(void) {
+
+	appTelemetryCapture_State = AppTelemetryCapture_State_Disabled;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Setup the module with the configuration.
+ * @param[in] configPtr: the runtime configuration. Module requires targetTelemetryConfigPtr and activeTelemetryRTParamsPtr
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: retcode from @ref AppTelemetryCapture_ApplyNewRuntimeConfig()
+ */
+Retcode_T AppTelemetryCapture_Setup(const AppRuntimeConfig_T * configPtr) {
+
+	assert(configPtr);
+	assert(configPtr->targetTelemetryConfigPtr);
+	assert(configPtr->activeTelemetryRTParamsPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	if(RETCODE_OK == retcode) retcode = AppTelemetryCapture_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr->targetTelemetryConfigPtr);
+
+	if(RETCODE_OK == retcode) retcode = AppTelemetryCapture_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, configPtr->activeTelemetryRTParamsPtr);
+
+	return retcode;
+}
+/**
+ * @brief Apply a new runtime configuration to the module.
+ * @details AppRuntimeConfig_Element_targetTelemetryConfig: the threshold, pre- and post-trigger times.
+ * @details AppRuntimeConfig_Element_activeTelemetryRTParams: the sampling period.
+ * @details Both take effect with @ref AppTelemetryCapture_Prepare().
+ * @param[in] configElement: the type of configuration to apply.
+ * @param[in] newConfigPtr: the configuration of type configElement
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT)
+ */
+Retcode_T AppTelemetryCapture_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr) {
+
+	assert(newConfigPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	switch(configElement) {
+	case AppRuntimeConfig_Element_targetTelemetryConfig:
+		appTelemetryCapture_ThresholdMilliG = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.captureThresholdMilliG;
+		appTelemetryCapture_PreTriggerMillis = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.capturePreTriggerMillis;
+		appTelemetryCapture_PostTriggerMillis = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.capturePostTriggerMillis;
+		break;
+	case AppRuntimeConfig_Element_activeTelemetryRTParams:
+		appTelemetryCapture_SamplingPeriodMillis = ((AppRuntimeConfig_TelemetryRTParams_T *) newConfigPtr)->samplingPeriodicityMillis;
+		break;
+	default: retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT);
+	}
+
+	return retcode;
+}
+/**
+ * @brief Prepare the capture ring. (Re-)creates it if its size changed, frees it if capturing is disabled. Discards any samples, including a window not uploaded yet.
+ * @note Call only while neither the sampling nor the publishing task is running.
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_TELEMETRY_CAPTURE_FAILED_TO_ALLOCATE)
+ */
+Retcode_T AppTelemetryCapture_Prepare(void) {
+
+	uint32_t capacity = 0;
+
+	if(appTelemetryCapture_ThresholdMilliG > 0 && appTelemetryCapture_SamplingPeriodMillis > 0) {
+		capacity = AppRuntimeConfig_GetCaptureNumberOfSamples(appTelemetryCapture_PreTriggerMillis, appTelemetryCapture_PostTriggerMillis, appTelemetryCapture_SamplingPeriodMillis);
+		appTelemetryCapture_NumberOfPostTriggerSamples = appTelemetryCapture_PostTriggerMillis / appTelemetryCapture_SamplingPeriodMillis;
+	}
+
+	if(capacity != appTelemetryCapture_Capacity) {
+		free(appTelemetryCapture_SamplesPtr);
+		appTelemetryCapture_SamplesPtr = NULL;
+		appTelemetryCapture_Capacity = 0;
+		if(capacity > 0) {
+			appTelemetryCapture_SamplesPtr = malloc(capacity * sizeof(AppTelemetryPayload_CaptureSample_T));
+			if(NULL == appTelemetryCapture_SamplesPtr) {
+				appTelemetryCapture_State = AppTelemetryCapture_State_Disabled;
+				return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_TELEMETRY_CAPTURE_FAILED_TO_ALLOCATE);
+			}
+			appTelemetryCapture_Capacity = capacity;
+		}
+	}
+
+	appTelemetryCapture_isAboveThreshold = false;
+
+	appTelemetryCapture_Rearm();
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Returns true if accelerometer threshold events are captured.
+ * @return bool: true if captureThresholdMilliG > 0 and the ring is allocated
+ */
+bool AppTelemetryCapture_IsEnabled(void) {
+	return (AppTelemetryCapture_State_Disabled != appTelemetryCapture_State);
+}
+/**
+ * @brief Add a sample to the capture ring and check for the trigger. Does not allocate, called in the sampling task.
+ * @details The magnitude is compared squared, with integer arithmetic only.
+ * @param[in] tickCount: the tick count at the time of sampling
+ * @param[in] sensorValuePtr: the values of the sensors, only the accelerometer is used
+ */
+void AppTelemetryCapture_AddSample(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr) {
+
+	assert(sensorValuePtr);
+
+	AppTelemetryCapture_State_T state = appTelemetryCapture_State;
+
+	if(AppTelemetryCapture_State_Disabled == state) return;
+
+	int32_t accel[3] = { sensorValuePtr->Accel.X, sensorValuePtr->Accel.Y, sensorValuePtr->Accel.Z };
+
+	int64_t magnitudeSquared = (int64_t) accel[0] * accel[0] + (int64_t) accel[1] * accel[1] + (int64_t) accel[2] * accel[2];
+	int64_t thresholdSquared = (int64_t) appTelemetryCapture_ThresholdMilliG * appTelemetryCapture_ThresholdMilliG;
+	bool isAboveThreshold = (magnitudeSquared >= thresholdSquared);
+	bool isRisingEdge = (isAboveThreshold && !appTelemetryCapture_isAboveThreshold);
+	appTelemetryCapture_isAboveThreshold = isAboveThreshold;
+
+	if(AppTelemetryCapture_State_Frozen == state) {
+		if(isRisingEdge) AppStatus_Stats_IncrementTelemetryCaptureMissedCounter();
+		return;
+	}
+
+	AppTelemetryPayload_CaptureSample_T * samplePtr = &appTelemetryCapture_SamplesPtr[appTelemetryCapture_WriteIndex];
+	for(uint32_t axis = 0; axis < 3; axis++) {
+		if(accel[axis] > INT16_MAX) accel[axis] = INT16_MAX;
+		else if(accel[axis] < INT16_MIN) accel[axis] = INT16_MIN;
+		samplePtr->accel[axis] = (int16_t) accel[axis];
+	}
+	if(++appTelemetryCapture_WriteIndex == appTelemetryCapture_Capacity) appTelemetryCapture_WriteIndex = 0;
+	if(appTelemetryCapture_Count < appTelemetryCapture_Capacity) appTelemetryCapture_Count++;
+
+	if(AppTelemetryCapture_State_Armed == state) {
+		if(!isRisingEdge) return;
+		appTelemetryCapture_Window.triggerTickCount = tickCount;
+		appTelemetryCapture_RemainingPostTriggerSamples = appTelemetryCapture_NumberOfPostTriggerSamples;
+		appTelemetryCapture_State = AppTelemetryCapture_State_Triggered;
+		AppStatus_Stats_IncrementTelemetryCaptureTriggeredCounter();
+	} else {
+		appTelemetryCapture_RemainingPostTriggerSamples--;
+	}
+
+	if(0 == appTelemetryCapture_RemainingPostTriggerSamples) appTelemetryCapture_Freeze();
+}
+/**
+ * @brief Returns the frozen window for upload. Called by the publishing task.
+ * @details On the first call for a window the ring is rotated in place to hold the samples oldest first.
+ * @param[out] nextSampleIndexPtr: index of the first sample not uploaded yet
+ * @return const AppTelemetryPayload_Capture_T *: the window, NULL if no window is frozen
+ */
+const AppTelemetryPayload_Capture_T * AppTelemetryCapture_GetWindow(uint32_t * nextSampleIndexPtr) {
+
+	assert(nextSampleIndexPtr);
+
+	if(AppTelemetryCapture_State_Frozen != appTelemetryCapture_State) return NULL;
+
+	if(!appTelemetryCapture_isWindowOrdered) {
+		// a full ring starts at the write index, rotate left by it
+		uint32_t oldestIndex = (appTelemetryCapture_Count == appTelemetryCapture_Capacity) ? appTelemetryCapture_WriteIndex : 0;
+		if(oldestIndex > 0) {
+			appTelemetryCapture_Reverse(0, oldestIndex);
+			appTelemetryCapture_Reverse(oldestIndex, appTelemetryCapture_Capacity);
+			appTelemetryCapture_Reverse(0, appTelemetryCapture_Capacity);
+		}
+		appTelemetryCapture_isWindowOrdered = true;
+		appTelemetryCapture_NextSampleIndex = 0;
+	}
+
+	*nextSampleIndexPtr = appTelemetryCapture_NextSampleIndex;
+
+	return &appTelemetryCapture_Window;
+}
+/**
+ * @brief Mark samples of the frozen window as uploaded. Re-arms the ring once the whole window is uploaded. Called by the publishing task.
+ * @param[in] numberOfSamples: the number of samples uploaded, following the ones consumed before
+ */
+void AppTelemetryCapture_ConsumeSamples(uint32_t numberOfSamples) {
+
+	if(AppTelemetryCapture_State_Frozen != appTelemetryCapture_State) return;
+
+	appTelemetryCapture_NextSampleIndex += numberOfSamples;
+
+	if(appTelemetryCapture_NextSampleIndex >= appTelemetryCapture_Window.numberOfSamples) {
+		AppStatus_Stats_IncrementTelemetryCaptureUploadedCounter();
+		appTelemetryCapture_Rearm();
+	}
+}
+
+/**@} */
+/** ************************************************************************* */
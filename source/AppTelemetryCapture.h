@@ -0,0 +1,42 @@
+/*
+ * AppTelemetryCapture.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetryCapture
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYCAPTURE_H_
+#define SOURCE_APPTELEMETRYCAPTURE_H_
+
+#include "AppTelemetryPayload.h"
+#include "AppRuntimeConfig.h"
+
+#include "XDK_Sensor.h"
+
+Retcode_T AppTelemetryCapture_Init(void);
+
+Retcode_T AppTelemetryCapture_Setup(const AppRuntimeConfig_T * configPtr);
+
+Retcode_T AppTelemetryCapture_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr);
+
+Retcode_T AppTelemetryCapture_Prepare(void);
+
+bool AppTelemetryCapture_IsEnabled(void);
+
+void AppTelemetryCapture_AddSample(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr);
+
+const AppTelemetryPayload_Capture_T * AppTelemetryCapture_GetWindow(uint32_t * nextSampleIndexPtr);
+
+void AppTelemetryCapture_ConsumeSamples(uint32_t numberOfSamples);
+
+#endif /* SOURCE_APPTELEMETRYCAPTURE_H_ */
+
+/**@} */
+/** ************************************************************************* */
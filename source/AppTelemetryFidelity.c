@@ -0,0 +1,330 @@
+/*
+ * AppTelemetryFidelity.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetryFidelity AppTelemetryFidelity
+ * @{
+ *
+ * @brief Graceful fidelity ladder: steps the telemetry down through the configured fidelity levels under congestion and back up on recovery.
+ * @details Level 0 is the configured telemetry, levels 1 - numberOfFidelityLevels are the configured fidelityLevels in the order of decreasing fidelity, e.g.
+ * full raw samples, decimated raw samples, windowed aggregates and a heartbeat. See @ref AppRuntimeConfig_AdaptTelemetryFidelity() for the modes.
+ * @details @ref AppTelemetryPublish adds the measurements of every publishing cycle while connected, see @ref AppTelemetryRateControl_Cycle_T.
+ * Once per #APP_TELEMETRY_FIDELITY_INTERVAL_IN_MS of cycles, or after every cycle if it is longer, the measurements are evaluated:
+ * - congested: the mean time spent publishing per cycle reached fidelityMaxLatencyMillis, the events queued up in a cycle reached fidelityMaxBacklogEvents
+ * or at least #APP_TELEMETRY_FIDELITY_CONGESTED_FAILED_PERCENT of the events failed. The fidelity is stepped down one level, not below the last level.<br/>
+ * - clear: no failures, no backlog and the mean time spent publishing per cycle below #APP_TELEMETRY_FIDELITY_CLEAR_LATENCY_PERCENT of fidelityMaxLatencyMillis.
+ * After #APP_TELEMETRY_FIDELITY_CLEAR_INTERVALS clear intervals in a row the fidelity is stepped up one level, up to the configured telemetry.<br/>
+ * - in between the level is kept.
+ * @details A new level is proposed to @ref AppController, which applies it with @ref AppRuntimeConfig_AdaptTelemetryFidelity() and confirms it.
+ * No measurements are taken while a proposal is pending. Each new level is sent as a status message.
+ * @details Only runs with fidelityLevels configured, replaces @ref AppTelemetryRateControl then.
+ * A new target telemetry configuration starts again at the configured telemetry.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+#include "XdkAppInfo.h"
+
+#undef BCDS_MODULE_ID /**< undefine any previous module id */
+#define BCDS_MODULE_ID SOLACE_APP_MODULE_ID_APP_TELEMETRY_FIDELITY
+
+#include "AppTelemetryFidelity.h"
+#include "AppStatus.h"
+
+static AppTelemetryFidelity_LevelChanged_Func_T appTelemetryFidelity_LevelChanged_Func = NULL; /**< the callback for a new level */
+
+static uint8_t appTelemetryFidelity_NumberOfLevels = 0; /**< local copy of configuration. number of fidelity levels, 0: disabled */
+
+static AppRuntimeConfig_FidelityLevel_T appTelemetryFidelity_Levels[APP_RT_CFG_TELEMETRY_MAX_FIDELITY_LEVELS]; /**< local copy of configuration. the fidelity levels */
+
+static uint32_t appTelemetryFidelity_MaxLatencyMillis = APP_RT_CFG_DEFAULT_FIDELITY_MAX_LATENCY_MILLIS; /**< local copy of configuration. fidelityMaxLatencyMillis */
+
+static uint32_t appTelemetryFidelity_MaxBacklogEvents = APP_RT_CFG_DEFAULT_FIDELITY_MAX_BACKLOG_EVENTS; /**< local copy of configuration. fidelityMaxBacklogEvents */
+
+static uint8_t appTelemetryFidelity_Level = APP_TELEMETRY_FIDELITY_CONFIGURED_LEVEL; /**< the applied level */
+
+static volatile bool appTelemetryFidelity_isProposalPending = false; /**< flag set while a new level waits to be applied */
+
+static volatile uint8_t appTelemetryFidelity_ProposedLevel = APP_TELEMETRY_FIDELITY_CONFIGURED_LEVEL; /**< the proposed level */
+
+static AppTelemetryFidelity_Reason_T appTelemetryFidelity_ProposedReason = AppTelemetryFidelity_Reason_Clear; /**< the reason for the proposed level */
+
+static uint32_t appTelemetryFidelity_NumberOfClearIntervals = 0; /**< number of clear intervals in a row */
+
+static AppTelemetryRateControl_Cycle_T appTelemetryFidelity_Interval; /**< the measurements of the cycles of the current interval, summed up */
+
+static uint32_t appTelemetryFidelity_NumberOfCycles = 0; /**< number of cycles in the current interval */
+
+static uint32_t appTelemetryFidelity_MaxCycleBacklogEvents = 0; /**< the most backlog events of a cycle in the current interval */
+
+/**
+ * @brief Returns the reason as a string for the status message.
+ * @param[in] reason: the reason
+ * @return const char *: the reason
+ */
+static const char * appTelemetryFidelity_GetReasonStr(AppTelemetryFidelity_Reason_T reason) {
+	switch(reason) {
+	case AppTelemetryFidelity_Reason_Latency: return "latency";
+	case AppTelemetryFidelity_Reason_Backlog: return "backlog";
+	case AppTelemetryFidelity_Reason_Failures: return "failures";
+	case AppTelemetryFidelity_Reason_Clear: return "clear";
+	default: assert(0);
+	}
+	return NULL;
+}
+/**
+ * @brief Returns the mode of a level as a string for the status message.
+ * @param[in] level: the level
+ * @return const char *: the mode
+ */
+static const char * appTelemetryFidelity_GetModeStr(uint8_t level) {
+
+	if(APP_TELEMETRY_FIDELITY_CONFIGURED_LEVEL == level) return "CONFIGURED";
+
+	switch(appTelemetryFidelity_Levels[level - 1].mode) {
+	case AppRuntimeConfig_Telemetry_FidelityMode_Decimated: return APP_RT_CFG_TELEMETRY_FIDELITY_MODE_DECIMATED_STR;
+	case AppRuntimeConfig_Telemetry_FidelityMode_Aggregate: return APP_RT_CFG_TELEMETRY_FIDELITY_MODE_AGGREGATE_STR;
+	case AppRuntimeConfig_Telemetry_FidelityMode_Heartbeat: return APP_RT_CFG_TELEMETRY_FIDELITY_MODE_HEARTBEAT_STR;
+	default: assert(0);
+	}
+	return NULL;
+}
+/**
+ * @brief Clears the measurements of the current interval.
+ */
+static void appTelemetryFidelity_ResetInterval(void) {
+	appTelemetryFidelity_Interval = (AppTelemetryRateControl_Cycle_T) { 0 };
+	appTelemetryFidelity_NumberOfCycles = 0;
+	appTelemetryFidelity_MaxCycleBacklogEvents = 0;
+}
+/**
+ * @brief Proposes a new level to the controller.
+ * @param[in] level: the new level
+ * @param[in] reason: the reason
+ */
+static void appTelemetryFidelity_Propose(uint8_t level, AppTelemetryFidelity_Reason_T reason) {
+
+	#ifdef DEBUG_APP_TELEMETRY_FIDELITY
+	printf("[INFO] - appTelemetryFidelity_Propose: level %u -> %u, reason: %s\r\n", appTelemetryFidelity_Level, level, appTelemetryFidelity_GetReasonStr(reason));
+	#endif
+
+	appTelemetryFidelity_ProposedLevel = level;
+	appTelemetryFidelity_ProposedReason = reason;
+	appTelemetryFidelity_isProposalPending = true;
+
+	if(NULL != appTelemetryFidelity_LevelChanged_Func) appTelemetryFidelity_LevelChanged_Func();
+}
+/**
+ * @brief Evaluates the measurements of a full interval. Proposes the next level down if congested or the next level up if clear for long enough.
+ */
+static void appTelemetryFidelity_Evaluate(void) {
+
+	const AppTelemetryRateControl_Cycle_T * intervalPtr = &appTelemetryFidelity_Interval;
+
+	uint32_t latencyMillis = intervalPtr->publishMillis / appTelemetryFidelity_NumberOfCycles;
+
+	bool isFailed = (intervalPtr->numberOfFailures > 0) &&
+			((intervalPtr->numberOfFailures * 100) >= (intervalPtr->numberOfEvents * APP_TELEMETRY_FIDELITY_CONGESTED_FAILED_PERCENT));
+
+	bool isBacklog = (appTelemetryFidelity_MaxCycleBacklogEvents >= appTelemetryFidelity_MaxBacklogEvents);
+
+	bool isLatency = (latencyMillis >= appTelemetryFidelity_MaxLatencyMillis);
+
+	bool isClear = (0 == intervalPtr->numberOfFailures) && (0 == intervalPtr->numberOfBacklogEvents) &&
+			((latencyMillis * 100) < (appTelemetryFidelity_MaxLatencyMillis * APP_TELEMETRY_FIDELITY_CLEAR_LATENCY_PERCENT));
+
+	#ifdef DEBUG_APP_TELEMETRY_FIDELITY
+	printf("[INFO] - appTelemetryFidelity_Evaluate: level:%u, cycles:%lu, latency:%lu ms, events:%lu, max backlog:%lu, failures:%lu\r\n",
+			appTelemetryFidelity_Level, appTelemetryFidelity_NumberOfCycles, latencyMillis, intervalPtr->numberOfEvents, appTelemetryFidelity_MaxCycleBacklogEvents, intervalPtr->numberOfFailures);
+	#endif
+
+	if(isFailed || isBacklog || isLatency) {
+
+		appTelemetryFidelity_NumberOfClearIntervals = 0;
+
+		if(appTelemetryFidelity_Level >= appTelemetryFidelity_NumberOfLevels) return;
+
+		AppTelemetryFidelity_Reason_T reason = AppTelemetryFidelity_Reason_Latency;
+		if(isFailed) reason = AppTelemetryFidelity_Reason_Failures;
+		else if(isBacklog) reason = AppTelemetryFidelity_Reason_Backlog;
+
+		appTelemetryFidelity_Propose(appTelemetryFidelity_Level + 1, reason);
+
+	} else if(isClear) {
+
+		if(APP_TELEMETRY_FIDELITY_CONFIGURED_LEVEL == appTelemetryFidelity_Level) return;
+
+		if(++appTelemetryFidelity_NumberOfClearIntervals < APP_TELEMETRY_FIDELITY_CLEAR_INTERVALS) return;
+
+		appTelemetryFidelity_NumberOfClearIntervals = 0;
+
+		appTelemetryFidelity_Propose(appTelemetryFidelity_Level - 1, AppTelemetryFidelity_Reason_Clear);
+
+	} else appTelemetryFidelity_NumberOfClearIntervals = 0;
+}
+/**
+ * @brief Initialize the module.
+ * @param[in] levelChanged_Func: the callback for a new level
+ * @return Retcode_T: RETCODE_OK
+ */
+Retcode_T AppTelemetryFidelity_Init(AppTelemetryFidelity_LevelChanged_Func_T levelChanged_Func) {
+
+	assert(levelChanged_Func);
+
+	appTelemetryFidelity_LevelChanged_Func = levelChanged_Func;
+
+	appTelemetryFidelity_NumberOfLevels = 0;
+	appTelemetryFidelity_Level = APP_TELEMETRY_FIDELITY_CONFIGURED_LEVEL;
+	appTelemetryFidelity_isProposalPending = false;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Setup the module with the configuration.
+ * @param[in] configPtr: the runtime configuration. Module requires targetTelemetryConfigPtr
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: retcode from @ref AppTelemetryFidelity_ApplyNewRuntimeConfig()
+ */
+Retcode_T AppTelemetryFidelity_Setup(const AppRuntimeConfig_T * configPtr) {
+
+	assert(configPtr);
+	assert(configPtr->targetTelemetryConfigPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	if(RETCODE_OK == retcode) retcode = AppTelemetryFidelity_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr->targetTelemetryConfigPtr);
+
+	return retcode;
+}
+/**
+ * @brief Apply a new runtime configuration to the module.
+ * @details AppRuntimeConfig_Element_targetTelemetryConfig: takes a copy of the levels and thresholds, starts again at the configured telemetry and discards a pending proposal.
+ * @note Call only while the publishing task is not running.
+ * @param[in] configElement: the type of configuration to apply.
+ * @param[in] newConfigPtr: the configuration of type configElement
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT)
+ */
+Retcode_T AppTelemetryFidelity_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr) {
+
+	assert(newConfigPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	switch(configElement) {
+	case AppRuntimeConfig_Element_targetTelemetryConfig: {
+		const AppRuntimeConfig_TelemetryConfig_T * configPtr = (const AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr;
+		appTelemetryFidelity_NumberOfLevels = configPtr->received.numberOfFidelityLevels;
+		memcpy(appTelemetryFidelity_Levels, configPtr->received.fidelityLevels, sizeof(appTelemetryFidelity_Levels));
+		appTelemetryFidelity_MaxLatencyMillis = configPtr->received.fidelityMaxLatencyMillis;
+		appTelemetryFidelity_MaxBacklogEvents = configPtr->received.fidelityMaxBacklogEvents;
+		appTelemetryFidelity_Level = APP_TELEMETRY_FIDELITY_CONFIGURED_LEVEL;
+		appTelemetryFidelity_NumberOfClearIntervals = 0;
+		appTelemetryFidelity_isProposalPending = false;
+	}
+		break;
+	default: retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT);
+	}
+
+	return retcode;
+}
+/**
+ * @brief Starts a new interval. Called by the publishing task when it starts.
+ */
+void AppTelemetryFidelity_Start(void) {
+	appTelemetryFidelity_ResetInterval();
+}
+/**
+ * @brief Adds the measurements of a publishing cycle. Evaluates them once the interval is full.
+ * @details Ignored while disabled or while a proposal is pending.
+ * @note Called by the publishing task only for cycles it was connected throughout.
+ * @param[in] cyclePtr: the measurements
+ */
+void AppTelemetryFidelity_AddCycle(const AppTelemetryRateControl_Cycle_T * cyclePtr) {
+
+	assert(cyclePtr);
+
+	if(0 == appTelemetryFidelity_NumberOfLevels || appTelemetryFidelity_isProposalPending) return;
+
+	appTelemetryFidelity_Interval.cycleMillis += cyclePtr->cycleMillis;
+	appTelemetryFidelity_Interval.publishMillis += cyclePtr->publishMillis;
+	appTelemetryFidelity_Interval.numberOfEvents += cyclePtr->numberOfEvents;
+	appTelemetryFidelity_Interval.numberOfBacklogEvents += cyclePtr->numberOfBacklogEvents;
+	appTelemetryFidelity_Interval.numberOfFailures += cyclePtr->numberOfFailures;
+	if(cyclePtr->numberOfBacklogEvents > appTelemetryFidelity_MaxCycleBacklogEvents) appTelemetryFidelity_MaxCycleBacklogEvents = cyclePtr->numberOfBacklogEvents;
+	appTelemetryFidelity_NumberOfCycles++;
+
+	if(appTelemetryFidelity_Interval.cycleMillis < APP_TELEMETRY_FIDELITY_INTERVAL_IN_MS) return;
+
+	appTelemetryFidelity_Evaluate();
+
+	appTelemetryFidelity_ResetInterval();
+}
+/**
+ * @brief Returns the pending proposal.
+ * @param[out] levelPtr: the proposed level
+ * @return bool: true if a proposal is pending, false if it was discarded in the meantime
+ */
+bool AppTelemetryFidelity_GetProposal(uint8_t * levelPtr) {
+
+	assert(levelPtr);
+
+	if(!appTelemetryFidelity_isProposalPending) return false;
+
+	*levelPtr = appTelemetryFidelity_ProposedLevel;
+
+	return true;
+}
+/**
+ * @brief Discards the pending proposal, e.g. if the controller is busy. Measuring continues with the level in place.
+ */
+void AppTelemetryFidelity_DiscardProposal(void) {
+	appTelemetryFidelity_isProposalPending = false;
+}
+/**
+ * @brief Confirms the pending proposal was applied. Sends a status message with the new level, a warning if the fidelity was stepped down.
+ * @note Call only while the publishing task is not running.
+ * @param[in] levelConfigPtr: the applied telemetry configuration of the level
+ * @param[in] rtParamsPtr: the applied telemetry runtime parameters
+ */
+void AppTelemetryFidelity_ConfirmProposal(const AppRuntimeConfig_TelemetryConfig_T * levelConfigPtr, const AppRuntimeConfig_TelemetryRTParams_T * rtParamsPtr) {
+
+	assert(levelConfigPtr);
+	assert(rtParamsPtr);
+
+	if(!appTelemetryFidelity_isProposalPending) return;
+
+	AppStatusMessage_StatusCode_T statusCode = (appTelemetryFidelity_ProposedLevel > appTelemetryFidelity_Level) ? AppStatusMessage_Status_Warning : AppStatusMessage_Status_Info;
+
+	appTelemetryFidelity_Level = appTelemetryFidelity_ProposedLevel;
+	appTelemetryFidelity_isProposalPending = false;
+
+	cJSON * jsonHandle = cJSON_CreateObject();
+	cJSON_AddNumberToObject(jsonHandle, "level", appTelemetryFidelity_Level);
+	cJSON_AddStringToObject(jsonHandle, "mode", appTelemetryFidelity_GetModeStr(appTelemetryFidelity_Level));
+	cJSON_AddStringToObject(jsonHandle, "reason", appTelemetryFidelity_GetReasonStr(appTelemetryFidelity_ProposedReason));
+	cJSON_AddNumberToObject(jsonHandle, "publishPeriodcityMillis", rtParamsPtr->publishPeriodcityMillis);
+	cJSON_AddNumberToObject(jsonHandle, "samplingPeriodicityMillis", rtParamsPtr->samplingPeriodicityMillis);
+	cJSON_AddNumberToObject(jsonHandle, "aggregateWindowMillis", levelConfigPtr->received.aggregateWindowMillis);
+
+	AppStatusMessage_T * msg = AppStatus_CreateMessage(statusCode, AppStatusMessage_Descr_TelemetryFidelityChanged, NULL);
+	AppStatus_AddStatusItem(msg, "telemetryFidelity", jsonHandle);
+	AppStatus_SendStatusMessage(msg);
+}
+/**
+ * @brief Returns the applied level.
+ * @return uint8_t: the level. #APP_TELEMETRY_FIDELITY_CONFIGURED_LEVEL: the configured telemetry
+ */
+uint8_t AppTelemetryFidelity_GetLevel(void) {
+	return appTelemetryFidelity_Level;
+}
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,63 @@
+/*
+ * AppTelemetryFidelity.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetryFidelity
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYFIDELITY_H_
+#define SOURCE_APPTELEMETRYFIDELITY_H_
+
+#include "AppRuntimeConfig.h"
+#include "AppTelemetryRateControl.h"
+
+#define APP_TELEMETRY_FIDELITY_CONFIGURED_LEVEL				UINT8_C(0) /**< the level of the configured telemetry */
+#define APP_TELEMETRY_FIDELITY_INTERVAL_IN_MS				UINT32_C(10000) /**< the measurements are evaluated once per interval of publishing cycles, at least once per cycle */
+#define APP_TELEMETRY_FIDELITY_CONGESTED_FAILED_PERCENT		UINT32_C(10) /**< congested if at least this percentage of the events failed to publish */
+#define APP_TELEMETRY_FIDELITY_CLEAR_LATENCY_PERCENT		UINT32_C(50) /**< clear if the mean publishing latency is below this percentage of fidelityMaxLatencyMillis */
+#define APP_TELEMETRY_FIDELITY_CLEAR_INTERVALS				UINT32_C(3) /**< number of clear intervals in a row before the fidelity is stepped up */
+
+/**
+ * @brief The reason for a new level.
+ */
+typedef enum {
+	AppTelemetryFidelity_Reason_Latency = 0, /**< the mean time spent publishing per cycle reached fidelityMaxLatencyMillis */
+	AppTelemetryFidelity_Reason_Backlog, /**< the events queued up in a cycle reached fidelityMaxBacklogEvents */
+	AppTelemetryFidelity_Reason_Failures, /**< too many events failed to publish */
+	AppTelemetryFidelity_Reason_Clear, /**< no congestion for #APP_TELEMETRY_FIDELITY_CLEAR_INTERVALS intervals */
+} AppTelemetryFidelity_Reason_T;
+/**
+ * @brief Callback function typedef for a new level. The controller gets the level with @ref AppTelemetryFidelity_GetProposal().
+ * @note Called in the publishing task, the level must be applied in another context.
+ */
+typedef void (*AppTelemetryFidelity_LevelChanged_Func_T)(void);
+
+Retcode_T AppTelemetryFidelity_Init(AppTelemetryFidelity_LevelChanged_Func_T levelChanged_Func);
+
+Retcode_T AppTelemetryFidelity_Setup(const AppRuntimeConfig_T * configPtr);
+
+Retcode_T AppTelemetryFidelity_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr);
+
+void AppTelemetryFidelity_Start(void);
+
+void AppTelemetryFidelity_AddCycle(const AppTelemetryRateControl_Cycle_T * cyclePtr);
+
+bool AppTelemetryFidelity_GetProposal(uint8_t * levelPtr);
+
+void AppTelemetryFidelity_DiscardProposal(void);
+
+void AppTelemetryFidelity_ConfirmProposal(const AppRuntimeConfig_TelemetryConfig_T * levelConfigPtr, const AppRuntimeConfig_TelemetryRTParams_T * rtParamsPtr);
+
+uint8_t AppTelemetryFidelity_GetLevel(void);
+
+#endif /* SOURCE_APPTELEMETRYFIDELITY_H_ */
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,218 @@
+/*
+ * AppTelemetryFusion.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetryFusion AppTelemetryFusion
+ * @{
+ *
+ * @brief Sensor fusion of the accelerometer, gyroscope and magnetometer samples into orientation quaternions.
+ * @details The sampling task updates a fixed-point Mahony filter (@ref AppTelemetryAhrs) with every sample, at the sampling period.
+ * Every fusionOutputMillis it adds the orientation quaternion, and the Euler angles if fusionEulerAngles is configured,
+ * to a ring of #APP_TELEMETRY_FUSION_MAX_ORIENTATIONS outputs. @ref AppTelemetryPublish publishes them on the orientation topic (@ref AppTelemetryPayload_EncodeOrientations()),
+ * 4 or 7 values per output instead of the 9 raw values per sample.
+ * @details The filter takes about 2 seconds to converge after @ref AppTelemetryFusion_Prepare(). A zero magnetometer sample is fused without the yaw correction.
+ * If the publisher falls behind, new outputs are dropped and counted in the @ref AppStatus stats.
+ * @details The sensor fusion is disabled if fusionOutputMillis is 0. It is independent of the sensors selected for the telemetry events:
+ * deselect accelerator, gyroscope and magnetometer to publish the orientations only.
+ * @note @ref AppTelemetryFusion_AddSample() is only called by the sampling task (producer of the ring), @ref AppTelemetryFusion_PeekOrientations()
+ * and @ref AppTelemetryFusion_ReleaseOrientations() only by the publishing task (consumer). Configuration is only changed while neither task is running.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+#include "XdkAppInfo.h"
+
+#undef BCDS_MODULE_ID /**< undefine any previous module id */
+#define BCDS_MODULE_ID SOLACE_APP_MODULE_ID_APP_TELEMETRY_FUSION
+
+#include "AppTelemetryFusion.h"
+#include "AppTelemetryAhrs.h"
+#include "AppTelemetryRing.h"
+#include "AppStatus.h"
+
+static uint32_t appTelemetryFusion_OutputMillis = APP_RT_CFG_DEFAULT_FUSION_OUTPUT_MILLIS; /**< local copy of configuration. interval of the outputs, 0: disabled */
+static bool appTelemetryFusion_IsEulerAngles = APP_RT_CFG_DEFAULT_FUSION_EULER_ANGLES; /**< local copy of configuration. compute the Euler angles of the outputs */
+static uint32_t appTelemetryFusion_SamplingPeriodMillis = 0; /**< local copy of the active sampling period, the update period of the filter */
+
+static volatile bool appTelemetryFusion_IsEnabled = false; /**< true once the ring is prepared and the filter runs */
+
+static AppTelemetryRing_T appTelemetryFusion_Ring; /**< the outputs, written by the sampling task, read by the publishing task */
+static bool appTelemetryFusion_IsRingCreated = false; /**< true if #appTelemetryFusion_Ring is allocated */
+
+/* sampling task only */
+static AppTelemetryAhrs_T appTelemetryFusion_Ahrs; /**< the filter */
+static uint32_t appTelemetryFusion_MillisSinceOutput = 0; /**< time since the last output */
+
+/**
+ * @brief Initialize the module.
+ * @return Retcode_T: RETCODE_OK
+ */
+Retcode_T AppTelemetryFusion_Init(void) {
+
+	appTelemetryFusion_IsEnabled = false;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Setup the module with the configuration.
+ * @param[in] configPtr: the runtime configuration. Module requires targetTelemetryConfigPtr and activeTelemetryRTParamsPtr
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: retcode from @ref AppTelemetryFusion_ApplyNewRuntimeConfig()
+ */
+Retcode_T AppTelemetryFusion_Setup(const AppRuntimeConfig_T * configPtr) {
+
+	assert(configPtr);
+	assert(configPtr->targetTelemetryConfigPtr);
+	assert(configPtr->activeTelemetryRTParamsPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	if(RETCODE_OK == retcode) retcode = AppTelemetryFusion_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr->targetTelemetryConfigPtr);
+
+	if(RETCODE_OK == retcode) retcode = AppTelemetryFusion_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, configPtr->activeTelemetryRTParamsPtr);
+
+	return retcode;
+}
+/**
+ * @brief Apply a new runtime configuration to the module.
+ * @details AppRuntimeConfig_Element_targetTelemetryConfig: the output interval and the Euler angles flag.
+ * @details AppRuntimeConfig_Element_activeTelemetryRTParams: the sampling period.
+ * @details Both take effect with @ref AppTelemetryFusion_Prepare().
+ * @param[in] configElement: the type of configuration to apply.
+ * @param[in] newConfigPtr: the configuration of type configElement
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT)
+ */
+Retcode_T AppTelemetryFusion_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr) {
+
+	assert(newConfigPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	switch(configElement) {
+	case AppRuntimeConfig_Element_targetTelemetryConfig:
+		appTelemetryFusion_OutputMillis = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.fusionOutputMillis;
+		appTelemetryFusion_IsEulerAngles = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.fusionEulerAngles;
+		break;
+	case AppRuntimeConfig_Element_activeTelemetryRTParams:
+		appTelemetryFusion_SamplingPeriodMillis = ((AppRuntimeConfig_TelemetryRTParams_T *) newConfigPtr)->samplingPeriodicityMillis;
+		break;
+	default: retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT);
+	}
+
+	return retcode;
+}
+/**
+ * @brief Prepare the sensor fusion. Creates the ring of outputs if enabled, frees it if disabled. Discards any outputs and resets the filter.
+ * @note Call only while neither the sampling nor the publishing task is running.
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_TELEMETRY_FUSION_FAILED_TO_ALLOCATE)
+ */
+Retcode_T AppTelemetryFusion_Prepare(void) {
+
+	bool isEnabled = (appTelemetryFusion_OutputMillis > 0 && appTelemetryFusion_SamplingPeriodMillis > 0);
+
+	appTelemetryFusion_IsEnabled = false;
+
+	if(!isEnabled) {
+		if(appTelemetryFusion_IsRingCreated) AppTelemetryRing_Delete(&appTelemetryFusion_Ring);
+		appTelemetryFusion_IsRingCreated = false;
+		return RETCODE_OK;
+	}
+
+	if(!appTelemetryFusion_IsRingCreated) {
+		if(!AppTelemetryRing_Create(&appTelemetryFusion_Ring, sizeof(AppTelemetryPayload_Orientation_T), APP_TELEMETRY_FUSION_MAX_ORIENTATIONS)) {
+			return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_TELEMETRY_FUSION_FAILED_TO_ALLOCATE);
+		}
+		appTelemetryFusion_IsRingCreated = true;
+	}
+	AppTelemetryRing_Reset(&appTelemetryFusion_Ring);
+
+	AppTelemetryAhrs_Reset(&appTelemetryFusion_Ahrs);
+	appTelemetryFusion_MillisSinceOutput = 0;
+
+	appTelemetryFusion_IsEnabled = true;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Returns true if the sensor fusion is running.
+ * @return bool: true if fusionOutputMillis > 0 and the ring is allocated
+ */
+bool AppTelemetryFusion_IsEnabled(void) {
+	return appTelemetryFusion_IsEnabled;
+}
+/**
+ * @brief Update the filter with a sample and add an output to the ring if one is due. Does not allocate, called in the sampling task.
+ * @param[in] tickCount: the tick count at the time of sampling
+ * @param[in] sensorValuePtr: the values of the sensors, the accelerometer, gyroscope and magnetometer are used
+ */
+void AppTelemetryFusion_AddSample(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr) {
+
+	assert(sensorValuePtr);
+
+	if(!appTelemetryFusion_IsEnabled) return;
+
+	const int32_t accel[3] = { sensorValuePtr->Accel.X, sensorValuePtr->Accel.Y, sensorValuePtr->Accel.Z };
+	const int32_t gyro[3] = { sensorValuePtr->Gyro.X, sensorValuePtr->Gyro.Y, sensorValuePtr->Gyro.Z };
+	const int32_t mag[3] = { sensorValuePtr->Mag.X, sensorValuePtr->Mag.Y, sensorValuePtr->Mag.Z };
+
+	AppTelemetryAhrs_Update(&appTelemetryFusion_Ahrs, accel, gyro, mag, appTelemetryFusion_SamplingPeriodMillis);
+
+	appTelemetryFusion_MillisSinceOutput += appTelemetryFusion_SamplingPeriodMillis;
+	if(appTelemetryFusion_MillisSinceOutput < appTelemetryFusion_OutputMillis) return;
+	appTelemetryFusion_MillisSinceOutput -= appTelemetryFusion_OutputMillis;
+
+	AppTelemetryPayload_Orientation_T * orientationPtr = (AppTelemetryPayload_Orientation_T *) AppTelemetryRing_GetWriteSlot(&appTelemetryFusion_Ring);
+	if(NULL == orientationPtr) {
+		AppStatus_Stats_IncrementTelemetryFusionDroppedOutputsCounter();
+		return;
+	}
+
+	orientationPtr->tickCount = tickCount;
+	for(uint32_t i = 0; i < 4; i++) orientationPtr->quaternion[i] = appTelemetryFusion_Ahrs.quaternion[i];
+	if(appTelemetryFusion_IsEulerAngles) AppTelemetryAhrs_GetEulerAngles(&appTelemetryFusion_Ahrs, orientationPtr->eulerMilliDeg);
+
+	AppTelemetryRing_CommitWrite(&appTelemetryFusion_Ring);
+}
+/**
+ * @brief Copies the oldest outputs in the ring without removing them. Called by the publishing task.
+ * @param[out] orientationsPtr: receives the outputs, oldest first
+ * @param[in] maxNumberOfOrientations: max number of outputs to copy
+ * @return uint32_t: the number of outputs copied
+ */
+uint32_t AppTelemetryFusion_PeekOrientations(AppTelemetryPayload_Orientation_T * orientationsPtr, uint32_t maxNumberOfOrientations) {
+
+	assert(orientationsPtr);
+
+	if(!appTelemetryFusion_IsEnabled) return 0;
+
+	uint32_t numberOfOrientations = AppTelemetryRing_BeginRead(&appTelemetryFusion_Ring);
+	if(numberOfOrientations > maxNumberOfOrientations) numberOfOrientations = maxNumberOfOrientations;
+
+	for(uint32_t i = 0; i < numberOfOrientations; i++) {
+		orientationsPtr[i] = *(const AppTelemetryPayload_Orientation_T *) AppTelemetryRing_GetReadSlot(&appTelemetryFusion_Ring, i);
+	}
+	return numberOfOrientations;
+}
+/**
+ * @brief Removes the oldest outputs from the ring once they are published. Called by the publishing task.
+ * @param[in] numberOfOrientations: the number of outputs, at most the number returned by the last @ref AppTelemetryFusion_PeekOrientations()
+ */
+void AppTelemetryFusion_ReleaseOrientations(uint32_t numberOfOrientations) {
+
+	if(!appTelemetryFusion_IsEnabled || 0 == numberOfOrientations) return;
+
+	// the sampling task never drops outputs from the ring, the release cannot fail
+	AppTelemetryRing_Release(&appTelemetryFusion_Ring, numberOfOrientations);
+}
+
+/**@} */
+/** ************************************************************************* */
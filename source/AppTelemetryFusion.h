@@ -0,0 +1,44 @@
+/*
+ * AppTelemetryFusion.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetryFusion
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYFUSION_H_
+#define SOURCE_APPTELEMETRYFUSION_H_
+
+#include "AppTelemetryPayload.h"
+#include "AppRuntimeConfig.h"
+
+#include "XDK_Sensor.h"
+
+#define APP_TELEMETRY_FUSION_MAX_ORIENTATIONS		(2 * APP_RT_CFG_TELEMETRY_MAX_FUSION_OUTPUTS_PER_CYCLE) /**< max number of orientation outputs held until they are published, two publishing cycles */
+
+Retcode_T AppTelemetryFusion_Init(void);
+
+Retcode_T AppTelemetryFusion_Setup(const AppRuntimeConfig_T * configPtr);
+
+Retcode_T AppTelemetryFusion_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr);
+
+Retcode_T AppTelemetryFusion_Prepare(void);
+
+bool AppTelemetryFusion_IsEnabled(void);
+
+void AppTelemetryFusion_AddSample(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr);
+
+uint32_t AppTelemetryFusion_PeekOrientations(AppTelemetryPayload_Orientation_T * orientationsPtr, uint32_t maxNumberOfOrientations);
+
+void AppTelemetryFusion_ReleaseOrientations(uint32_t numberOfOrientations);
+
+#endif /* SOURCE_APPTELEMETRYFUSION_H_ */
+
+/**@} */
+/** ************************************************************************* */
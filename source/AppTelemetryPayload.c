@@ -9,6 +9,24 @@
  * @{
  *
  * @brief This module abstracts the telemetry payload implementation. It is used by @ref AppTelemetrySampling and @ref AppTelemetryPublish.
+ * @details Batches are encoded by a streaming encoder directly into a caller provided buffer, see @ref AppTelemetryPayload_EncodeBatch().
+ * It writes the 'V1 JSON' formats byte for byte as cJSON_PrintUnformatted() does, with integer arithmetic only and without building a cJSON tree.
+ * The temperature is kept in milli degrees celsius, the JSON formats send it in degrees celsius with the digits cJSON prints for it, e.g. 17.071, the binary formats in milli degrees.
+ * The 'V2 JSON columnar' format sends the device id and the timestamp of the first sample once per batch, followed by the millisecond offsets ("dt") and one array per selected channel.
+ * Its size is not the sum of independent sample sizes, hence the batch size is tracked per batch, see @ref AppTelemetryPayload_BatchSize_T.
+ * The 'V2 CBOR' format is the binary equivalent of the columnar format: an integer keyed map per batch, integers in their shortest encoding
+ * and the timestamp as milliseconds since the epoch.
+ * The 'V2 Delta' format compresses the columns of a batch: delta of delta sample offsets and value deltas to the previous sample, as zig-zag varints.
+ * Slowly changing signals encode in about one byte per value.
+ * In the aggregation mode a window of samples is sent as one JSON object with count, min, max, mean and standard deviation per sensor channel instead,
+ * see @ref AppTelemetryPayload_AddSampleToAggregate() and @ref AppTelemetryPayload_EncodeAggregate().
+ * The accelerometer and gyroscope channels of a window can carry p50, p95 and p99 in addition, estimated by a fixed memory @ref AppTelemetrySketch per channel,
+ * see @ref AppTelemetryPayload_SetAggregateQuantiles().
+ * Capture windows around accelerometer threshold events are sent in chunks of JSON objects with one array per axis, see @ref AppTelemetryPayload_EncodeCaptureChunk().
+ * The vibration spectrum features of accelerometer windows are sent as JSON objects with RMS, crest factor and peaks per axis, see @ref AppTelemetryPayload_EncodeSpectrum().
+ * The orientation outputs of the sensor fusion are sent as JSON objects with one array per quaternion component and Euler angle, see @ref AppTelemetryPayload_EncodeOrientations().
+ * With deadbands configured, values that did not move beyond their deadband since the last sent value are suppressed (report by exception), see @ref AppTelemetryPayload_ApplyDeadband().
+ * The batch encoders are covered by the host unit test test/test_AppTelemetryPayload.c.
  *
  * @author $(SOLACE_APP_AUTHOR)
  *
@@ -25,14 +43,221 @@
 #include "AppTelemetryPayload.h"
 #include "AppMisc.h"
 
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
 /* copies of local configuration */
 static const char * appTelemetryPayload_DeviceId = NULL; /**< local copy of the device id */
+static char * appTelemetryPayload_DeviceIdJsonStr = NULL; /**< the device id as quoted and escaped JSON string, written by the encoder */
+static uint32_t appTelemetryPayload_DeviceIdJsonLength = 0; /**< length of #appTelemetryPayload_DeviceIdJsonStr */
+static uint32_t appTelemetryPayload_DeviceIdLength = 0; /**< length of #appTelemetryPayload_DeviceId */
 static AppRuntimeConfig_Telemetry_PayloadFormat_T appTelemetryPayload_PayloadFormat = APP_RT_CFG_DEFAULT_PAYLOAD_FORMAT; /**< local copy of payload format configuration */
+static AppRuntimeConfig_Telemetry_TimestampFormat_T appTelemetryPayload_TimestampFormat = APP_RT_CFG_DEFAULT_PAYLOAD_TIMESTAMP_FORMAT; /**< local copy of the timestamp format configuration of the JSON formats */
 static AppRuntimeConfig_Sensors_T * appTelemetryPayload_TargetTelemetrySensorsPtr = NULL; /**< local copy of sensors configuration */
+static AppRuntimeConfig_Aggregates_T appTelemetryPayload_Aggregates = { .isCount = true, .isMin = true, .isMax = true, .isMean = true, .isStddev = true, .isP50 = false, .isP95 = false, .isP99 = false }; /**< local copy of the statistics sent per window in the aggregation mode */
+static AppRuntimeConfig_Deadbands_T appTelemetryPayload_Deadbands; /**< local copy of the deadbands per sensor */
+static TickType_t appTelemetryPayload_DeadbandHeartbeatTicks = MILLISECONDS(APP_RT_CFG_DEFAULT_DEADBAND_HEARTBEAT_MILLIS); /**< a suppressed value is sent anyway once the last sent value is this old, 0 for never */
+static bool appTelemetryPayload_IsFusionEulerAngles = APP_RT_CFG_DEFAULT_FUSION_EULER_ANGLES; /**< local copy of configuration. send the Euler angles with the orientations */
+
+static AppTimestamp_StrCache_T appTelemetryPayload_TimestampStrCache = APP_TIMESTAMP_STR_CACHE_INIT; /**< timestamp string cache of the encoder, used in the publishing task only */
+
+/**
+ * @brief Index into the element names of a format. The sensor channels follow #AppTelemetryPayload_Name_DeviceId.
+ */
+typedef enum {
+	AppTelemetryPayload_Name_Timestamp = 0,
+	AppTelemetryPayload_Name_DeviceId,
+	AppTelemetryPayload_Name_Humidity,
+	AppTelemetryPayload_Name_Light,
+	AppTelemetryPayload_Name_Temperature,
+	AppTelemetryPayload_Name_AccelX,
+	AppTelemetryPayload_Name_AccelY,
+	AppTelemetryPayload_Name_AccelZ,
+	AppTelemetryPayload_Name_GyroX,
+	AppTelemetryPayload_Name_GyroY,
+	AppTelemetryPayload_Name_GyroZ,
+	AppTelemetryPayload_Name_MagR,
+	AppTelemetryPayload_Name_MagX,
+	AppTelemetryPayload_Name_MagY,
+	AppTelemetryPayload_Name_MagZ,
+	AppTelemetryPayload_Name_NumberOf, /**< number of names */
+} AppTelemetryPayload_Name_T;
+
+#define APP_TELEMETRY_PAYLOAD_JSON_EPOCH_MILLIS_LENGTH		UINT32_C(13) /**< 'JSON': number of digits of a timestamp in milliseconds since the epoch, until the year 2286 */
+#define APP_TELEMETRY_PAYLOAD_JSON_NULL_LENGTH				UINT32_C(4) /**< 'JSON': length of null, sent for a value suppressed by the deadband filter */
+#define APP_TELEMETRY_PAYLOAD_V1_JSON_BATCH_OVERHEAD		UINT32_C(2) /**< 'V1 JSON': size of the enclosing array of a batch in bytes */
+#define APP_TELEMETRY_PAYLOAD_V1_JSON_BATCH_SEPARATOR		UINT32_C(1) /**< 'V1 JSON': size of the separator between two samples of a batch in bytes */
+#define APP_TELEMETRY_PAYLOAD_JSON_TEMPERATURE_UNIT			INT32_C(1000) /**< 'JSON': the temperature is kept in milli degrees celsius and sent in degrees celsius with up to 3 decimals */
+
+/**
+ * @brief The element names of the 'V1 JSON Verbose' format, indexed by #AppTelemetryPayload_Name_T. Must match appTelemetryPayload_CreateNew_V1_Json_Verbose().
+ */
+static const char * const appTelemetryPayload_Names_V1_Json_Verbose[] = {
+	"timestamp", "deviceId", "humidity", "light", "temperature",
+	"acceleratorX", "acceleratorY", "acceleratorZ", "gyroX", "gyroY", "gyroZ", "magR", "magX", "magY", "magZ"
+};
+/**
+ * @brief The element names of the 'V1 JSON Compact' format, indexed by #AppTelemetryPayload_Name_T. Must match appTelemetryPayload_CreateNew_V1_Json_Compact().
+ */
+static const char * const appTelemetryPayload_Names_V1_Json_Compact[] = {
+	"ts", "id", "h", "l", "t",
+	"aX", "aY", "aZ", "gX", "gY", "gZ", "mR", "mX", "mY", "mZ"
+};
+/**
+ * @brief The element names of the 'V2 JSON Columnar' format, indexed by #AppTelemetryPayload_Name_T.
+ */
+static const char * const appTelemetryPayload_Names_V2_Json_Columnar[] = {
+	"ts", "id", "h", "l", "t",
+	"aX", "aY", "aZ", "gX", "gY", "gZ", "mR", "mX", "mY", "mZ"
+};
+#define APP_TELEMETRY_PAYLOAD_V2_JSON_COLUMNAR_OFFSETS_NAME		"dt" /**< 'V2 JSON Columnar': name of the array of sample offsets in milliseconds to the timestamp */
+/**
+ * @brief The map keys of the 'V2 CBOR' format, indexed by #AppTelemetryPayload_Name_T. All keys are < 24 and encode in a single byte.
+ */
+static const uint8_t appTelemetryPayload_Keys_V2_Cbor[] = {
+	1, 0, 3, 4, 5,
+	6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+};
+#define APP_TELEMETRY_PAYLOAD_V2_CBOR_OFFSETS_KEY		UINT8_C(2) /**< 'V2 CBOR': key of the array of sample offsets in milliseconds to the timestamp */
+#define APP_TELEMETRY_PAYLOAD_V2_CBOR_TIMESTAMP_LENGTH	UINT32_C(9) /**< 'V2 CBOR': size of the timestamp in milliseconds since the epoch, an unsigned integer > 2^32 */
+
+#define APP_TELEMETRY_PAYLOAD_V2_DELTA_VERSION			UINT8_C(1) /**< 'V2 Delta': version, the first byte of a batch */
+#define APP_TELEMETRY_PAYLOAD_V2_DELTA_FLAG_TIMESTAMP	UINT32_C(0x01) /**< 'V2 Delta': flag for the timestamp. The flags of the selected sensor channels follow, in the order of #AppTelemetryPayload_Name_T */
+#define APP_TELEMETRY_PAYLOAD_V2_DELTA_TIMESTAMP_LENGTH	UINT32_C(6) /**< 'V2 Delta': size of the timestamp in milliseconds since the epoch as varint, < 2^42 */
+
+/**
+ * @brief Index into the member names of a window in the aggregation mode.
+ */
+typedef enum {
+	AppTelemetryPayload_AggregateName_Duration = 0,
+	AppTelemetryPayload_AggregateName_Count,
+	AppTelemetryPayload_AggregateName_Min,
+	AppTelemetryPayload_AggregateName_Max,
+	AppTelemetryPayload_AggregateName_Mean,
+	AppTelemetryPayload_AggregateName_Stddev,
+	AppTelemetryPayload_AggregateName_P50, /**< the quantiles follow in the order of the aggregate quantiles */
+	AppTelemetryPayload_AggregateName_P95,
+	AppTelemetryPayload_AggregateName_P99,
+	AppTelemetryPayload_AggregateName_NumberOf, /**< number of names */
+} AppTelemetryPayload_AggregateName_T;
+/**
+ * @brief The member names of a window with the 'V1 JSON Verbose' format, indexed by #AppTelemetryPayload_AggregateName_T.
+ */
+static const char * const appTelemetryPayload_AggregateNames_Verbose[] = {
+	"durationMillis", "count", "min", "max", "mean", "stddev", "p50", "p95", "p99"
+};
+/**
+ * @brief The member names of a window with the 'V1 JSON Compact' and 'V2 JSON Columnar' formats, indexed by #AppTelemetryPayload_AggregateName_T.
+ */
+static const char * const appTelemetryPayload_AggregateNames_Compact[] = {
+	"dt", "n", "min", "max", "avg", "sd", "p50", "p95", "p99"
+};
+#define APP_TELEMETRY_PAYLOAD_AGGREGATE_DECIMALS		UINT32_C(3) /**< number of decimals of the mean and the standard deviation of a window */
+/**
+ * @brief The quantiles of a window in permille, indexed as #AppTelemetryPayload_Aggregate_T.quantiles.
+ */
+static const uint32_t appTelemetryPayload_QuantilesPermille[APP_TELEMETRY_PAYLOAD_NUMBER_OF_QUANTILES] = { 500, 950, 990 };
+
+/**
+ * @brief Index into the member names of a capture chunk.
+ */
+typedef enum {
+	AppTelemetryPayload_CaptureName_SamplingPeriod = 0,
+	AppTelemetryPayload_CaptureName_NumberOfSamples,
+	AppTelemetryPayload_CaptureName_NumberOfPreTriggerSamples,
+	AppTelemetryPayload_CaptureName_FirstIndex,
+	AppTelemetryPayload_CaptureName_NumberOf, /**< number of names */
+} AppTelemetryPayload_CaptureName_T;
+/**
+ * @brief The member names of a capture chunk with the 'V1 JSON Verbose' format, indexed by #AppTelemetryPayload_CaptureName_T.
+ */
+static const char * const appTelemetryPayload_CaptureNames_Verbose[] = {
+	"samplingPeriodMillis", "numberOfSamples", "numberOfPreTriggerSamples", "firstIndex"
+};
+/**
+ * @brief The member names of a capture chunk with all other formats, indexed by #AppTelemetryPayload_CaptureName_T.
+ */
+static const char * const appTelemetryPayload_CaptureNames_Compact[] = {
+	"dt", "n", "pre", "i"
+};
+
+/**
+ * @brief Index into the member names of the spectrum features of a window.
+ */
+typedef enum {
+	AppTelemetryPayload_SpectrumName_SamplingPeriod = 0,
+	AppTelemetryPayload_SpectrumName_NumberOfSamples,
+	AppTelemetryPayload_SpectrumName_Resolution,
+	AppTelemetryPayload_SpectrumName_Rms,
+	AppTelemetryPayload_SpectrumName_CrestFactor,
+	AppTelemetryPayload_SpectrumName_Peaks,
+	AppTelemetryPayload_SpectrumName_NumberOf, /**< number of names */
+} AppTelemetryPayload_SpectrumName_T;
+/**
+ * @brief The member names of the spectrum features with the 'V1 JSON Verbose' format, indexed by #AppTelemetryPayload_SpectrumName_T.
+ */
+static const char * const appTelemetryPayload_SpectrumNames_Verbose[] = {
+	"samplingPeriodMillis", "numberOfSamples", "resolutionHz", "rms", "crestFactor", "peaks"
+};
+/**
+ * @brief The member names of the spectrum features with all other formats, indexed by #AppTelemetryPayload_SpectrumName_T.
+ */
+static const char * const appTelemetryPayload_SpectrumNames_Compact[] = {
+	"dt", "n", "df", "rms", "cf", "pk"
+};
+
+/**
+ * @brief Index into the member names of the orientation outputs.
+ */
+typedef enum {
+	AppTelemetryPayload_OrientationName_Offsets = 0,
+	AppTelemetryPayload_OrientationName_QuaternionW,
+	AppTelemetryPayload_OrientationName_QuaternionX,
+	AppTelemetryPayload_OrientationName_QuaternionY,
+	AppTelemetryPayload_OrientationName_QuaternionZ,
+	AppTelemetryPayload_OrientationName_Roll,
+	AppTelemetryPayload_OrientationName_Pitch,
+	AppTelemetryPayload_OrientationName_Yaw,
+	AppTelemetryPayload_OrientationName_NumberOf, /**< number of names */
+} AppTelemetryPayload_OrientationName_T;
+/**
+ * @brief The member names of the orientation outputs with the 'V1 JSON Verbose' format, indexed by #AppTelemetryPayload_OrientationName_T.
+ */
+static const char * const appTelemetryPayload_OrientationNames_Verbose[] = {
+	"offsetsMillis", "quaternionW", "quaternionX", "quaternionY", "quaternionZ", "roll", "pitch", "yaw"
+};
+/**
+ * @brief The member names of the orientation outputs with all other formats, indexed by #AppTelemetryPayload_OrientationName_T.
+ */
+static const char * const appTelemetryPayload_OrientationNames_Compact[] = {
+	"dt", "qw", "qx", "qy", "qz", "roll", "pitch", "yaw"
+};
+
+#define APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_UNSIGNED	UINT8_C(0) /**< CBOR major type: unsigned integer */
+#define APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_NEGATIVE	UINT8_C(1) /**< CBOR major type: negative integer -1-n */
+#define APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_TEXT		UINT8_C(3) /**< CBOR major type: UTF-8 text string */
+#define APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_ARRAY		UINT8_C(4) /**< CBOR major type: array */
+#define APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_MAP		UINT8_C(5) /**< CBOR major type: map */
+#define APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_SIMPLE	UINT8_C(7) /**< CBOR major type: simple values */
+#define APP_TELEMETRY_PAYLOAD_CBOR_SIMPLE_NULL			UINT8_C(22) /**< CBOR simple value null, a single byte 0xF6 */
+
+/**
+ * @brief Output of the streaming encoder.
+ */
+typedef struct {
+	char * bufferPtr; /**< the caller provided buffer */
+	uint32_t bufferSize; /**< size of the buffer, including the terminating 0 */
+	uint32_t length; /**< number of characters written */
+	bool isOverflow; /**< true if a write did not fit into the buffer */
+	uint64_t firstMillisSinceEpoch; /**< time of the sample at firstTickCount, 0 to take the timestamps from the tick counts with @ref AppTimestamp_GetTimestamp() */
+	TickType_t firstTickCount; /**< tick count of the sample at firstMillisSinceEpoch */
+} AppTelemetryPayload_Writer_T;
 
 /* forwards */
-static AppTelemetryPayload_T * appTelemetryPayload_CreateNew_V1_Json_Verbose(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr);
-static AppTelemetryPayload_T * appTelemetryPayload_CreateNew_V1_Json_Compact(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr);
+static AppTelemetryPayload_T * appTelemetryPayload_CreateNew_V1_Json_Verbose(const AppTelemetryPayload_Sample_T * samplePtr);
+static AppTelemetryPayload_T * appTelemetryPayload_CreateNew_V1_Json_Compact(const AppTelemetryPayload_Sample_T * samplePtr);
+static char * appTelemetryPayload_CreateJsonStr(const char * str);
 
 /**
  * @brief Initialize the module.
@@ -43,6 +268,11 @@ Retcode_T AppTelemetryPayload_Init(const char * deviceId) {
 
 	appTelemetryPayload_DeviceId = copyString(deviceId);
 
+	appTelemetryPayload_DeviceIdJsonStr = appTelemetryPayload_CreateJsonStr(deviceId);
+	appTelemetryPayload_DeviceIdJsonLength = (uint32_t) strlen(appTelemetryPayload_DeviceIdJsonStr);
+
+	appTelemetryPayload_DeviceIdLength = (uint32_t) strlen(appTelemetryPayload_DeviceId);
+
 	return RETCODE_OK;
 }
 /**
@@ -79,27 +309,63 @@ Retcode_T AppTelemetryPayload_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigEleme
 	AppRuntimeConfig_TelemetryConfig_T * configPtr = (AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr;
 
 	appTelemetryPayload_PayloadFormat = configPtr->received.payloadFormat;
+	appTelemetryPayload_TimestampFormat = configPtr->received.payloadTimestampFormat;
 
 	if(appTelemetryPayload_TargetTelemetrySensorsPtr) AppRuntimeConfig_DeleteSensors(appTelemetryPayload_TargetTelemetrySensorsPtr);
 
 	appTelemetryPayload_TargetTelemetrySensorsPtr = AppRuntimeConfig_DuplicateSensors(&configPtr->received.sensors);
 
+	appTelemetryPayload_Aggregates = configPtr->received.aggregates;
+
+	appTelemetryPayload_Deadbands = configPtr->received.deadbands;
+	appTelemetryPayload_DeadbandHeartbeatTicks = MILLISECONDS(configPtr->received.deadbandHeartbeatMillis);
+
+	appTelemetryPayload_IsFusionEulerAngles = configPtr->received.fusionEulerAngles;
+
 	return retcode;
 }
+/**
+ * @brief Populate a binary sample record from the sensor readings. Does not allocate, called in the sampling task.
+ * @param[out] samplePtr: the sample record to populate
+ * @param[in] tickCount: the tick count at the time of sampling
+ * @param[in] sensorValuePtr: the values of the sensors
+ * @param[in] presentSensors: APP_TELEMETRY_PAYLOAD_SENSOR_* bits of the sensors read for this sample, the other values are not sent
+ */
+void AppTelemetryPayload_PopulateSample(AppTelemetryPayload_Sample_T * samplePtr, const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr, uint8_t presentSensors) {
+
+	assert(samplePtr);
+	assert(sensorValuePtr);
+
+	samplePtr->tickCount = tickCount;
+	samplePtr->humidity = sensorValuePtr->RH;
+	samplePtr->light = sensorValuePtr->Light;
+	samplePtr->temperature = (int32_t) lroundf(sensorValuePtr->Temp);
+	samplePtr->accel[0] = sensorValuePtr->Accel.X;
+	samplePtr->accel[1] = sensorValuePtr->Accel.Y;
+	samplePtr->accel[2] = sensorValuePtr->Accel.Z;
+	samplePtr->gyro[0] = sensorValuePtr->Gyro.X;
+	samplePtr->gyro[1] = sensorValuePtr->Gyro.Y;
+	samplePtr->gyro[2] = sensorValuePtr->Gyro.Z;
+	samplePtr->mag[0] = sensorValuePtr->Mag.R;
+	samplePtr->mag[1] = sensorValuePtr->Mag.X;
+	samplePtr->mag[2] = sensorValuePtr->Mag.Y;
+	samplePtr->mag[3] = sensorValuePtr->Mag.Z;
+	samplePtr->suppressedChannels = 0;
+	samplePtr->presentSensors = presentSensors;
+}
 /**
  * @brief Create a new payload structure in the format as configured previously.
- * @param[in] tickCount: the current tick count, will be converted into a timestamp string
- * @param[in] sensorValuePtr: the values of the sensors to populate the payload
+ * @param[in] samplePtr: the sample record. Its tick count will be converted into a timestamp string.
  * @return AppTelemetryPayload_T *: the newly created telemetry payload structure
  */
-AppTelemetryPayload_T * AppTelemetryPayload_CreateNew(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr) {
+AppTelemetryPayload_T * AppTelemetryPayload_CreateNew(const AppTelemetryPayload_Sample_T * samplePtr) {
 
 	switch(appTelemetryPayload_PayloadFormat) {
 	case AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose:
-		return appTelemetryPayload_CreateNew_V1_Json_Verbose(tickCount, sensorValuePtr);
+		return appTelemetryPayload_CreateNew_V1_Json_Verbose(samplePtr);
 		break;
 	case AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact:
-		return appTelemetryPayload_CreateNew_V1_Json_Compact(tickCount, sensorValuePtr);
+		return appTelemetryPayload_CreateNew_V1_Json_Compact(samplePtr);
 		break;
 	default:
 		Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_TELEMETRY_PAYLOAD_UNSUPPORTED_FORMAT));
@@ -108,118 +374,2004 @@ AppTelemetryPayload_T * AppTelemetryPayload_CreateNew(const TickType_t tickCount
 	}
 }
 /**
- * @brief Create a test payload based on a new configuration. Used to test whether new configuration is valid. Leaves module's configuration intact.
- * @param[in] tickCount: the current tick count
- * @param[in] sensorValuePtr: the sensor values
- * @param[in] sensorsConfigPtr: the new sensor configuration to be tested
- * @param[in] payloadFormat: the payload format to be tested
- * @return AppTelemetryPayload_T *: the newly created telemetry payload structure
- * @see AppTelemetryPayload_CreateNew()
+ * @brief Create the payload string of a batch of samples in the format as configured previously, using cJSON.
+ * @details Reference for @ref AppTelemetryPayload_EncodeBatch(), which should be used instead.
+ * @param[in] samplesPtr: array of numberOfSamples sample records
+ * @param[in] numberOfSamples: the number of samples in the batch
+ * @return char *: the payload string, free after use. NULL if it could not be created.
  */
-AppTelemetryPayload_T * AppTelemetryPayload_CreateNew_Test(
-		const TickType_t tickCount,
-		const Sensor_Value_T * sensorValuePtr,
-		const AppRuntimeConfig_Sensors_T * sensorsConfigPtr,
-		AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat) {
+char * AppTelemetryPayload_CreateBatchStr(const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples) {
 
-	// remember old values
-	AppRuntimeConfig_Sensors_T * orgSensorsConfigPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
-	AppRuntimeConfig_Telemetry_PayloadFormat_T orgPayloadFormat = appTelemetryPayload_PayloadFormat;
+	assert(samplesPtr);
 
-	appTelemetryPayload_TargetTelemetrySensorsPtr = (AppRuntimeConfig_Sensors_T *) sensorsConfigPtr;
-	appTelemetryPayload_PayloadFormat = payloadFormat;
+	cJSON * batchJsonHandle = cJSON_CreateArray();
+	if(NULL == batchJsonHandle) return NULL;
 
-	AppTelemetryPayload_T * testPayloadPtr = AppTelemetryPayload_CreateNew(tickCount, sensorValuePtr);
+	for(uint32_t i = 0; i < numberOfSamples; i++) cJSON_AddItemToArray(batchJsonHandle, AppTelemetryPayload_CreateNew(&samplesPtr[i]));
 
-	// restore original values
-	appTelemetryPayload_TargetTelemetrySensorsPtr = orgSensorsConfigPtr;
-	appTelemetryPayload_PayloadFormat = orgPayloadFormat;
+	char * payloadStr = cJSON_PrintUnformatted(batchJsonHandle);
+	cJSON_Delete(batchJsonHandle);
 
-	return testPayloadPtr;
+	return payloadStr;
 }
 /**
- * @brief Create a 'V1 JSON Verbose' payload.
- * @param[in] tickCount: the current tick count. Is converted to a timestamp using @ref AppTimestamp.
- * @param[in] sensorValuePtr: the values of the sensor readings
- * @return AppTelemetryPayload_T *: the created payload
+ * @brief Returns true if the sensor of a channel is selected in the sensor configuration.
+ * @param[in] sensorsPtr: the sensor configuration
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @return bool: true if selected
+ */
+static bool appTelemetryPayload_IsChannelSelected(const AppRuntimeConfig_Sensors_T * sensorsPtr, AppTelemetryPayload_Name_T name) {
+
+	switch(name) {
+	case AppTelemetryPayload_Name_Humidity: return sensorsPtr->isHumidity;
+	case AppTelemetryPayload_Name_Light: return sensorsPtr->isLight;
+	case AppTelemetryPayload_Name_Temperature: return sensorsPtr->isTemperature;
+	case AppTelemetryPayload_Name_AccelX:
+	case AppTelemetryPayload_Name_AccelY:
+	case AppTelemetryPayload_Name_AccelZ: return sensorsPtr->isAccelerator;
+	case AppTelemetryPayload_Name_GyroX:
+	case AppTelemetryPayload_Name_GyroY:
+	case AppTelemetryPayload_Name_GyroZ: return sensorsPtr->isGyro;
+	case AppTelemetryPayload_Name_MagR:
+	case AppTelemetryPayload_Name_MagX:
+	case AppTelemetryPayload_Name_MagY:
+	case AppTelemetryPayload_Name_MagZ: return sensorsPtr->isMagneto;
+	default: assert(0); return false;
+	}
+}
+/**
+ * @brief Returns the value of a channel as kept in the sample record and sent by the binary formats, the temperature in milli degrees celsius.
+ * @param[in] samplePtr: the sample record
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @return int32_t: the value
  */
-static AppTelemetryPayload_T * appTelemetryPayload_CreateNew_V1_Json_Verbose(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr) {
+static int32_t appTelemetryPayload_GetChannelValue(const AppTelemetryPayload_Sample_T * samplePtr, AppTelemetryPayload_Name_T name) {
 
-	char * timestampStr = AppTimestamp_CreateTimestampStr(AppTimestamp_GetTimestamp(tickCount));
+	switch(name) {
+	case AppTelemetryPayload_Name_Humidity: return (int32_t) samplePtr->humidity;
+	case AppTelemetryPayload_Name_Light: return (int32_t) samplePtr->light;
+	case AppTelemetryPayload_Name_Temperature: return samplePtr->temperature;
+	case AppTelemetryPayload_Name_AccelX:
+	case AppTelemetryPayload_Name_AccelY:
+	case AppTelemetryPayload_Name_AccelZ: return samplePtr->accel[name - AppTelemetryPayload_Name_AccelX];
+	case AppTelemetryPayload_Name_GyroX:
+	case AppTelemetryPayload_Name_GyroY:
+	case AppTelemetryPayload_Name_GyroZ: return samplePtr->gyro[name - AppTelemetryPayload_Name_GyroX];
+	case AppTelemetryPayload_Name_MagR:
+	case AppTelemetryPayload_Name_MagX:
+	case AppTelemetryPayload_Name_MagY:
+	case AppTelemetryPayload_Name_MagZ: return samplePtr->mag[name - AppTelemetryPayload_Name_MagR];
+	default: assert(0); return 0;
+	}
+}
+/**
+ * @brief Returns the value of a channel that is sent as 1 in the JSON formats: #APP_TELEMETRY_PAYLOAD_JSON_TEMPERATURE_UNIT for the temperature, 1 for the other channels.
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @return int32_t: the value of one unit
+ */
+static inline int32_t appTelemetryPayload_GetUnit_Json(AppTelemetryPayload_Name_T name) {
+	return (AppTelemetryPayload_Name_Temperature == name) ? APP_TELEMETRY_PAYLOAD_JSON_TEMPERATURE_UNIT : 1;
+}
+/**
+ * @brief Set the value of a channel as kept in the sample record. Inverse of appTelemetryPayload_GetChannelValue().
+ * @param[in,out] samplePtr: the sample record
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @param[in] value: the value
+ */
+static void appTelemetryPayload_SetChannelValue(AppTelemetryPayload_Sample_T * samplePtr, AppTelemetryPayload_Name_T name, int32_t value) {
 
-	cJSON *sampleJSON = cJSON_CreateObject();
+	switch(name) {
+	case AppTelemetryPayload_Name_Humidity: samplePtr->humidity = (uint32_t) value; break;
+	case AppTelemetryPayload_Name_Light: samplePtr->light = (uint32_t) value; break;
+	case AppTelemetryPayload_Name_Temperature: samplePtr->temperature = value; break;
+	case AppTelemetryPayload_Name_AccelX:
+	case AppTelemetryPayload_Name_AccelY:
+	case AppTelemetryPayload_Name_AccelZ: samplePtr->accel[name - AppTelemetryPayload_Name_AccelX] = value; break;
+	case AppTelemetryPayload_Name_GyroX:
+	case AppTelemetryPayload_Name_GyroY:
+	case AppTelemetryPayload_Name_GyroZ: samplePtr->gyro[name - AppTelemetryPayload_Name_GyroX] = value; break;
+	case AppTelemetryPayload_Name_MagR:
+	case AppTelemetryPayload_Name_MagX:
+	case AppTelemetryPayload_Name_MagY:
+	case AppTelemetryPayload_Name_MagZ: samplePtr->mag[name - AppTelemetryPayload_Name_MagR] = value; break;
+	default: assert(0);
+	}
+}
+/**
+ * @brief Returns true if the value of a channel was suppressed by its deadband, i.e. is not sent.
+ * @param[in] samplePtr: the sample record
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @return bool: true if suppressed
+ */
+static inline bool appTelemetryPayload_IsChannelSuppressed(const AppTelemetryPayload_Sample_T * samplePtr, AppTelemetryPayload_Name_T name) {
+	return (0 != (samplePtr->suppressedChannels & (UINT16_C(1) << (name - AppTelemetryPayload_Name_Humidity))));
+}
+/**
+ * @brief Returns the presence bit of the sensor of a channel.
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @return uint8_t: the APP_TELEMETRY_PAYLOAD_SENSOR_* bit
+ */
+static uint8_t appTelemetryPayload_GetChannelSensor(AppTelemetryPayload_Name_T name) {
 
-	cJSON_AddItemToObject(sampleJSON, "timestamp", cJSON_CreateString(timestampStr));
-	free(timestampStr);
+	switch(name) {
+	case AppTelemetryPayload_Name_Humidity: return APP_TELEMETRY_PAYLOAD_SENSOR_HUMIDITY;
+	case AppTelemetryPayload_Name_Light: return APP_TELEMETRY_PAYLOAD_SENSOR_LIGHT;
+	case AppTelemetryPayload_Name_Temperature: return APP_TELEMETRY_PAYLOAD_SENSOR_TEMPERATURE;
+	case AppTelemetryPayload_Name_AccelX:
+	case AppTelemetryPayload_Name_AccelY:
+	case AppTelemetryPayload_Name_AccelZ: return APP_TELEMETRY_PAYLOAD_SENSOR_ACCEL;
+	case AppTelemetryPayload_Name_GyroX:
+	case AppTelemetryPayload_Name_GyroY:
+	case AppTelemetryPayload_Name_GyroZ: return APP_TELEMETRY_PAYLOAD_SENSOR_GYRO;
+	case AppTelemetryPayload_Name_MagR:
+	case AppTelemetryPayload_Name_MagX:
+	case AppTelemetryPayload_Name_MagY:
+	case AppTelemetryPayload_Name_MagZ: return APP_TELEMETRY_PAYLOAD_SENSOR_MAG;
+	default: assert(0); return 0;
+	}
+}
+/**
+ * @brief Returns true if the sensor of a channel was read for the sample.
+ * @param[in] samplePtr: the sample record
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @return bool: true if present
+ */
+static inline bool appTelemetryPayload_IsChannelPresent(const AppTelemetryPayload_Sample_T * samplePtr, AppTelemetryPayload_Name_T name) {
+	return (0 != (samplePtr->presentSensors & appTelemetryPayload_GetChannelSensor(name)));
+}
+/**
+ * @brief Returns true if the value of a channel is not sent: suppressed by its deadband or its sensor was not read for the sample.
+ * @param[in] samplePtr: the sample record
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @return bool: true if omitted
+ */
+static inline bool appTelemetryPayload_IsChannelOmitted(const AppTelemetryPayload_Sample_T * samplePtr, AppTelemetryPayload_Name_T name) {
+	return (appTelemetryPayload_IsChannelSuppressed(samplePtr, name) || !appTelemetryPayload_IsChannelPresent(samplePtr, name));
+}
+/**
+ * @brief Returns true if any of the selected sensors is present, i.e. a sample with these presence bits has values to send.
+ * @param[in] presentSensors: APP_TELEMETRY_PAYLOAD_SENSOR_* bits of the sensors read
+ * @return bool: true if a selected sensor is present
+ */
+bool AppTelemetryPayload_IsAnySensorPresent(uint8_t presentSensors) {
 
-	cJSON_AddItemToObject(sampleJSON, "deviceId", cJSON_CreateString(appTelemetryPayload_DeviceId));
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+		if(appTelemetryPayload_IsChannelSelected(appTelemetryPayload_TargetTelemetrySensorsPtr, name) && (presentSensors & appTelemetryPayload_GetChannelSensor(name))) return true;
+	}
+	return false;
+}
+/**
+ * @brief Returns the deadband of the sensor of a channel.
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @return const AppRuntimeConfig_Deadband_T *: the deadband
+ */
+static const AppRuntimeConfig_Deadband_T * appTelemetryPayload_GetDeadband(AppTelemetryPayload_Name_T name) {
+
+	switch(name) {
+	case AppTelemetryPayload_Name_Humidity: return &appTelemetryPayload_Deadbands.humidity;
+	case AppTelemetryPayload_Name_Light: return &appTelemetryPayload_Deadbands.light;
+	case AppTelemetryPayload_Name_Temperature: return &appTelemetryPayload_Deadbands.temperature;
+	case AppTelemetryPayload_Name_AccelX:
+	case AppTelemetryPayload_Name_AccelY:
+	case AppTelemetryPayload_Name_AccelZ: return &appTelemetryPayload_Deadbands.accelerator;
+	case AppTelemetryPayload_Name_GyroX:
+	case AppTelemetryPayload_Name_GyroY:
+	case AppTelemetryPayload_Name_GyroZ: return &appTelemetryPayload_Deadbands.gyro;
+	case AppTelemetryPayload_Name_MagR:
+	case AppTelemetryPayload_Name_MagX:
+	case AppTelemetryPayload_Name_MagY:
+	case AppTelemetryPayload_Name_MagZ: return &appTelemetryPayload_Deadbands.magneto;
+	default: assert(0); return NULL;
+	}
+}
+/**
+ * @brief Returns true if a deadband is configured for any of the selected sensors, i.e. values may be suppressed.
+ * @return bool: true if the deadband filter is active
+ */
+bool AppTelemetryPayload_IsDeadband(void) {
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+		if(!appTelemetryPayload_IsChannelSelected(appTelemetryPayload_TargetTelemetrySensorsPtr, name)) continue;
+		const AppRuntimeConfig_Deadband_T * deadbandPtr = appTelemetryPayload_GetDeadband(name);
+		if(deadbandPtr->absolute > 0 || deadbandPtr->relativePercent > 0) return true;
+	}
+	return false;
+}
+/**
+ * @brief Reset the deadband filter, the values of the next sample are all sent.
+ * @param[out] statePtr: the filter state
+ */
+void AppTelemetryPayload_ResetDeadband(AppTelemetryPayload_DeadbandState_T * statePtr) {
 
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isHumidity) cJSON_AddNumberToObject(sampleJSON, "humidity", (long int ) sensorValuePtr->RH);
+	assert(statePtr);
 
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isLight) cJSON_AddNumberToObject(sampleJSON, "light", (long int ) sensorValuePtr->Light);
+	statePtr->isValid = false;
+}
+/**
+ * @brief Apply the deadband filter (report by exception) to a sample. Does not allocate, called in the sampling task.
+ * @details A value of a selected channel is sent if its sensor has no deadband, if it differs from the last sent value by more than
+ * the larger of the absolute and the relative deadband, or if the last sent value is as old as the heartbeat interval, so consumers can tell 'unchanged' from 'dead'.
+ * Otherwise the value is suppressed: its bit is set in the suppressedChannels of the sample and the value is replaced by the last sent value.
+ * The absolute deadband is in the unit of the JSON formats, for the temperature in degrees celsius.
+ * @details The JSON formats omit a suppressed value ('V1') or send null ('V2 JSON Columnar'), 'V2 CBOR' sends null
+ * and 'V2 Delta' sends it as unchanged, i.e. a delta of 0 in a single byte.
+ * A channel whose sensor was not read for the sample is neither sent nor suppressed, it holds the last sent value and is omitted in the same way.
+ * @param[in,out] statePtr: the filter state
+ * @param[in,out] samplePtr: the sample record
+ * @param[out] numberOfSuppressedPtr: the number of values suppressed
+ * @return uint32_t: the number of values sent. 0 if all values were suppressed, the sample does not need to be sent.
+ */
+uint32_t AppTelemetryPayload_ApplyDeadband(AppTelemetryPayload_DeadbandState_T * statePtr, AppTelemetryPayload_Sample_T * samplePtr, uint32_t * numberOfSuppressedPtr) {
 
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isTemperature) cJSON_AddNumberToObject(sampleJSON, "temperature", (sensorValuePtr->Temp / 1000));
+	assert(statePtr);
+	assert(samplePtr);
+	assert(numberOfSuppressedPtr);
 
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isAccelerator) {
-		cJSON_AddNumberToObject(sampleJSON, "acceleratorX", sensorValuePtr->Accel.X);
-		cJSON_AddNumberToObject(sampleJSON, "acceleratorY", sensorValuePtr->Accel.Y);
-		cJSON_AddNumberToObject(sampleJSON, "acceleratorZ", sensorValuePtr->Accel.Z);
+	uint32_t numberOfSent = 0;
+	*numberOfSuppressedPtr = 0;
+	samplePtr->suppressedChannels = 0;
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+
+		if(!appTelemetryPayload_IsChannelSelected(appTelemetryPayload_TargetTelemetrySensorsPtr, name)) continue;
+
+		AppTelemetryPayload_DeadbandChannel_T * channelPtr = &statePtr->channels[name - AppTelemetryPayload_Name_Humidity];
+
+		if(!appTelemetryPayload_IsChannelPresent(samplePtr, name)) {
+			if(statePtr->isValid) appTelemetryPayload_SetChannelValue(samplePtr, name, channelPtr->lastValue);
+			continue;
+		}
+		const AppRuntimeConfig_Deadband_T * deadbandPtr = appTelemetryPayload_GetDeadband(name);
+		int32_t value = appTelemetryPayload_GetChannelValue(samplePtr, name);
+
+		bool isSent = !statePtr->isValid || (0 == deadbandPtr->absolute && 0 == deadbandPtr->relativePercent);
+
+		if(!isSent && appTelemetryPayload_DeadbandHeartbeatTicks > 0) {
+			isSent = ((samplePtr->tickCount - channelPtr->lastTickCount) >= appTelemetryPayload_DeadbandHeartbeatTicks);
+		}
+		if(!isSent) {
+			int64_t lastValue = channelPtr->lastValue;
+			int64_t delta = (int64_t) value - lastValue;
+			int64_t band = ((lastValue < 0) ? -lastValue : lastValue) * deadbandPtr->relativePercent / 100;
+			// the absolute deadband is in the unit of the JSON formats
+			int64_t absolute = (int64_t) deadbandPtr->absolute * appTelemetryPayload_GetUnit_Json(name);
+			if(band < absolute) band = absolute;
+			isSent = (delta > band || -delta > band);
+		}
+
+		if(isSent) {
+			channelPtr->lastValue = value;
+			channelPtr->lastTickCount = samplePtr->tickCount;
+			numberOfSent++;
+		} else {
+			samplePtr->suppressedChannels |= (uint16_t) (UINT16_C(1) << (name - AppTelemetryPayload_Name_Humidity));
+			appTelemetryPayload_SetChannelValue(samplePtr, name, channelPtr->lastValue);
+			(*numberOfSuppressedPtr)++;
+		}
 	}
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isGyro) {
-		cJSON_AddNumberToObject(sampleJSON, "gyroX", sensorValuePtr->Gyro.X);
-		cJSON_AddNumberToObject(sampleJSON, "gyroY", sensorValuePtr->Gyro.Y);
-		cJSON_AddNumberToObject(sampleJSON, "gyroZ", sensorValuePtr->Gyro.Z);
+	statePtr->isValid = true;
+
+	return numberOfSent;
+}
+/**
+ * @brief Returns the offset of a sample to the first sample of its batch in milliseconds.
+ * @param[in] firstTickCount: the tick count of the first sample
+ * @param[in] tickCount: the tick count of the sample
+ * @return int32_t: the offset in milliseconds
+ */
+static inline int32_t appTelemetryPayload_GetOffsetMillis(TickType_t firstTickCount, TickType_t tickCount) {
+	return (int32_t) ((tickCount - firstTickCount) * portTICK_PERIOD_MS);
+}
+/**
+ * @brief Returns the number of characters of a number printed as an integer, as cJSON does.
+ * @param[in] value: the number
+ * @return uint32_t: the number of characters
+ */
+static uint32_t appTelemetryPayload_GetNumberLength(int32_t value) {
+
+	uint32_t length = (value < 0) ? 2 : 1;
+	uint32_t absValue = (value < 0) ? (uint32_t) (-(int64_t) value) : (uint32_t) value;
+
+	while(absValue >= 10) {
+		absValue /= 10;
+		length++;
 	}
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isMagneto) {
-		cJSON_AddNumberToObject(sampleJSON, "magR", sensorValuePtr->Mag.R);
-		cJSON_AddNumberToObject(sampleJSON, "magX", sensorValuePtr->Mag.X);
-		cJSON_AddNumberToObject(sampleJSON, "magY", sensorValuePtr->Mag.Y);
-		cJSON_AddNumberToObject(sampleJSON, "magZ", sensorValuePtr->Mag.Z);
+	return length;
+}
+/**
+ * @brief Returns the number of characters of a number of thousandths written by appTelemetryPayload_WriteMilli().
+ * @param[in] milli: the number of thousandths
+ * @return uint32_t: the number of characters
+ */
+static uint32_t appTelemetryPayload_GetMilliLength(int32_t milli) {
+
+	uint32_t absValue = (milli < 0) ? (uint32_t) (-(int64_t) milli) : (uint32_t) milli;
+	uint32_t decimals = absValue % APP_TELEMETRY_PAYLOAD_JSON_TEMPERATURE_UNIT;
+
+	// sign and integer digits
+	uint32_t length = ((milli < 0) ? 1 : 0) + appTelemetryPayload_GetNumberLength((int32_t) (absValue / APP_TELEMETRY_PAYLOAD_JSON_TEMPERATURE_UNIT));
+
+	if(decimals > 0) {
+		// decimal point and 3 decimals, less the trailing zeros
+		length += 4;
+		for(; 0 == decimals % 10; decimals /= 10) length--;
 	}
+	return length;
+}
+/**
+ * @brief Returns the number of characters of the value of a channel in the JSON formats, see appTelemetryPayload_WriteValue_Json().
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @param[in] value: the value as kept in the sample record
+ * @return uint32_t: the number of characters
+ */
+static inline uint32_t appTelemetryPayload_GetValueLength_Json(AppTelemetryPayload_Name_T name, int32_t value) {
+	return (AppTelemetryPayload_Name_Temperature == name) ? appTelemetryPayload_GetMilliLength(value) : appTelemetryPayload_GetNumberLength(value);
+}
+/**
+ * @brief Returns the number of characters of a JSON member: "name":value
+ * @param[in] name: the member name
+ * @param[in] valueLength: the number of characters of the value
+ * @return uint32_t: the number of characters
+ */
+static inline uint32_t appTelemetryPayload_GetMemberLength(const char * name, uint32_t valueLength) {
+	return (uint32_t) strlen(name) + 3 + valueLength;
+}
+/**
+ * @brief Returns the number of bytes of a CBOR head (initial byte and argument) in its shortest form.
+ * @param[in] argument: the argument of the head: value, length or number of items
+ * @return uint32_t: the number of bytes
+ */
+static uint32_t appTelemetryPayload_GetCborHeadLength(uint64_t argument) {
 
-	return (AppTelemetryPayload_T *) sampleJSON;
+	if(argument < 24) return 1;
+	if(argument <= UINT8_MAX) return 2;
+	if(argument <= UINT16_MAX) return 3;
+	if(argument <= UINT32_MAX) return 5;
+	return 9;
 }
 /**
- * @brief Create a 'V1 JSON Compact' payload.
- * @param[in] tickCount: the current tick count. Is converted to a timestamp using @ref AppTimestamp.
- * @param[in] sensorValuePtr: the values of the sensor readings
- * @return AppTelemetryPayload_T *: the created payload
+ * @brief Returns the number of bytes of an integer encoded as CBOR unsigned or negative integer.
+ * @param[in] value: the number
+ * @return uint32_t: the number of bytes
  */
-static AppTelemetryPayload_T * appTelemetryPayload_CreateNew_V1_Json_Compact(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr) {
+static inline uint32_t appTelemetryPayload_GetCborIntLength(int32_t value) {
+	return appTelemetryPayload_GetCborHeadLength((value < 0) ? (uint64_t) (-1 - (int64_t) value) : (uint64_t) value);
+}
+/**
+ * @brief Returns the number of bytes of an unsigned LEB128 varint, 7 bits per byte.
+ * @param[in] value: the number
+ * @return uint32_t: the number of bytes
+ */
+static uint32_t appTelemetryPayload_GetVarintLength(uint64_t value) {
 
-	char * timestampStr = AppTimestamp_CreateTimestampStr(AppTimestamp_GetTimestamp(tickCount));
+	uint32_t length = 1;
 
-	cJSON *sampleJSON = cJSON_CreateObject();
+	while(value >= 0x80) {
+		value >>= 7;
+		length++;
+	}
+	return length;
+}
+/**
+ * @brief Zig-zag encodes a signed number, so numbers of small magnitude result in short varints: 0, -1, 1, -2 .. become 0, 1, 2, 3 ..
+ * @param[in] value: the number
+ * @return uint64_t: the zig-zag encoded number
+ */
+static inline uint64_t appTelemetryPayload_ZigZag(int64_t value) {
+	return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+}
+/**
+ * @brief Returns the number of arrays in a 'V2' batch: the offsets and one per selected sensor channel.
+ * @return uint32_t: the number of arrays
+ */
+static uint32_t appTelemetryPayload_GetNumberOfArrays_V2(void) {
 
-	cJSON_AddItemToObject(sampleJSON, "ts", cJSON_CreateString(timestampStr));
-	free(timestampStr);
+	uint32_t numberOfArrays = 1;
 
-	cJSON_AddItemToObject(sampleJSON, "id", cJSON_CreateString(appTelemetryPayload_DeviceId));
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+		if(appTelemetryPayload_IsChannelSelected(appTelemetryPayload_TargetTelemetrySensorsPtr, name)) numberOfArrays++;
+	}
+	return numberOfArrays;
+}
+/**
+ * @brief Returns the number of characters of the timestamp value in the JSON formats, as configured previously.
+ * @return uint32_t: the number of characters, including the quotes of the string
+ */
+static inline uint32_t appTelemetryPayload_GetTimestampValueLength_Json(void) {
+	return (AppRuntimeConfig_Telemetry_TimestampFormat_EpochMillis == appTelemetryPayload_TimestampFormat) ? APP_TELEMETRY_PAYLOAD_JSON_EPOCH_MILLIS_LENGTH : APP_TIMESTAMP_STRING_LENGTH + 2;
+}
+/**
+ * @brief Returns the size of one sample in a 'V1 JSON' format as printed unformatted by cJSON.
+ * @param[in] samplePtr: the sample record
+ * @param[in] names: the element names of the format
+ * @return uint32_t: the size in bytes
+ */
+static uint32_t appTelemetryPayload_GetSampleSize_V1_Json(const AppTelemetryPayload_Sample_T * samplePtr, const char * const names[]) {
 
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isHumidity) cJSON_AddNumberToObject(sampleJSON, "h", (long int ) sensorValuePtr->RH);
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
 
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isLight) cJSON_AddNumberToObject(sampleJSON, "l", (long int ) sensorValuePtr->Light);
+	// braces and the comma between timestamp and device id
+	uint32_t size = 3;
 
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isTemperature) cJSON_AddNumberToObject(sampleJSON, "t", (sensorValuePtr->Temp / 1000));
+	size += appTelemetryPayload_GetMemberLength(names[AppTelemetryPayload_Name_Timestamp], appTelemetryPayload_GetTimestampValueLength_Json());
+	size += appTelemetryPayload_GetMemberLength(names[AppTelemetryPayload_Name_DeviceId], appTelemetryPayload_DeviceIdJsonLength);
 
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isAccelerator) {
-		cJSON_AddNumberToObject(sampleJSON, "aX", sensorValuePtr->Accel.X);
-		cJSON_AddNumberToObject(sampleJSON, "aY", sensorValuePtr->Accel.Y);
-		cJSON_AddNumberToObject(sampleJSON, "aZ", sensorValuePtr->Accel.Z);
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+		if(appTelemetryPayload_IsChannelSelected(sensorsPtr, name) && !appTelemetryPayload_IsChannelOmitted(samplePtr, name)) {
+			size += 1 + appTelemetryPayload_GetMemberLength(names[name], appTelemetryPayload_GetValueLength_Json(name, appTelemetryPayload_GetChannelValue(samplePtr, name)));
+		}
 	}
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isGyro) {
-		cJSON_AddNumberToObject(sampleJSON, "gX", sensorValuePtr->Gyro.X);
-		cJSON_AddNumberToObject(sampleJSON, "gY", sensorValuePtr->Gyro.Y);
-		cJSON_AddNumberToObject(sampleJSON, "gZ", sensorValuePtr->Gyro.Z);
+	return size;
+}
+/**
+ * @brief Returns the size of an empty batch in the 'V2 JSON Columnar' format: device id, timestamp and empty arrays.
+ * @return uint32_t: the size in bytes
+ */
+static uint32_t appTelemetryPayload_GetBatchOverhead_V2_Json_Columnar(void) {
+
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+	const char * const * names = appTelemetryPayload_Names_V2_Json_Columnar;
+
+	// braces and the commas before timestamp and offsets
+	uint32_t size = 4;
+
+	size += appTelemetryPayload_GetMemberLength(names[AppTelemetryPayload_Name_DeviceId], appTelemetryPayload_DeviceIdJsonLength);
+	size += appTelemetryPayload_GetMemberLength(names[AppTelemetryPayload_Name_Timestamp], appTelemetryPayload_GetTimestampValueLength_Json());
+	size += appTelemetryPayload_GetMemberLength(APP_TELEMETRY_PAYLOAD_V2_JSON_COLUMNAR_OFFSETS_NAME, 2);
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+		if(appTelemetryPayload_IsChannelSelected(sensorsPtr, name)) size += 1 + appTelemetryPayload_GetMemberLength(names[name], 2);
 	}
-	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isMagneto) {
-		cJSON_AddNumberToObject(sampleJSON, "mR", sensorValuePtr->Mag.R);
-		cJSON_AddNumberToObject(sampleJSON, "mX", sensorValuePtr->Mag.X);
-		cJSON_AddNumberToObject(sampleJSON, "mY", sensorValuePtr->Mag.Y);
-		cJSON_AddNumberToObject(sampleJSON, "mZ", sensorValuePtr->Mag.Z);
+	return size;
+}
+/**
+ * @brief Returns the number of bytes a sample adds to a batch in the 'V2 JSON Columnar' format: its offset and values, with separators if it is not the first sample.
+ * @param[in] batchSizePtr: the batch the sample is added to
+ * @param[in] samplePtr: the sample record
+ * @return uint32_t: the size in bytes
+ */
+static uint32_t appTelemetryPayload_GetSampleSize_V2_Json_Columnar(const AppTelemetryPayload_BatchSize_T * batchSizePtr, const AppTelemetryPayload_Sample_T * samplePtr) {
+
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+
+	bool isFirst = (0 == batchSizePtr->numberOfSamples);
+	uint32_t separator = isFirst ? 0 : 1;
+
+	uint32_t size = separator + appTelemetryPayload_GetNumberLength(isFirst ? 0 : appTelemetryPayload_GetOffsetMillis(batchSizePtr->firstTickCount, samplePtr->tickCount));
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+		if(!appTelemetryPayload_IsChannelSelected(sensorsPtr, name)) continue;
+		size += separator + (appTelemetryPayload_IsChannelOmitted(samplePtr, name) ?
+				APP_TELEMETRY_PAYLOAD_JSON_NULL_LENGTH : appTelemetryPayload_GetValueLength_Json(name, appTelemetryPayload_GetChannelValue(samplePtr, name)));
 	}
+	return size;
+}
+/**
+ * @brief Returns the size of an empty batch in the 'V2 CBOR' format: the map with device id, timestamp and empty arrays.
+ * @return uint32_t: the size in bytes
+ */
+static uint32_t appTelemetryPayload_GetBatchOverhead_V2_Cbor(void) {
 
-	return (AppTelemetryPayload_T *) sampleJSON;
+	uint32_t numberOfArrays = appTelemetryPayload_GetNumberOfArrays_V2();
+
+	// map head, keys and heads of the empty arrays are single bytes
+	uint32_t size = 1 + 2 * numberOfArrays;
+
+	size += 1 + appTelemetryPayload_GetCborHeadLength(appTelemetryPayload_DeviceIdLength) + appTelemetryPayload_DeviceIdLength;
+	size += 1 + APP_TELEMETRY_PAYLOAD_V2_CBOR_TIMESTAMP_LENGTH;
+
+	return size;
+}
+/**
+ * @brief Returns the number of bytes a sample adds to a batch in the 'V2 CBOR' format: its offset and values, and the growth of the array heads.
+ * @param[in] batchSizePtr: the batch the sample is added to
+ * @param[in] samplePtr: the sample record
+ * @return uint32_t: the size in bytes
+ */
+static uint32_t appTelemetryPayload_GetSampleSize_V2_Cbor(const AppTelemetryPayload_BatchSize_T * batchSizePtr, const AppTelemetryPayload_Sample_T * samplePtr) {
+
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+
+	bool isFirst = (0 == batchSizePtr->numberOfSamples);
+
+	uint32_t size = appTelemetryPayload_GetCborIntLength(isFirst ? 0 : appTelemetryPayload_GetOffsetMillis(batchSizePtr->firstTickCount, samplePtr->tickCount));
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+		if(!appTelemetryPayload_IsChannelSelected(sensorsPtr, name)) continue;
+		size += appTelemetryPayload_IsChannelOmitted(samplePtr, name) ? 1 : appTelemetryPayload_GetCborIntLength(appTelemetryPayload_GetChannelValue(samplePtr, name));
+	}
+
+	size += appTelemetryPayload_GetNumberOfArrays_V2() *
+			(appTelemetryPayload_GetCborHeadLength(batchSizePtr->numberOfSamples + 1) - appTelemetryPayload_GetCborHeadLength(batchSizePtr->numberOfSamples));
+
+	return size;
+}
+/**
+ * @brief Returns the flags of a 'V2 Delta' batch: timestamp and selected sensor channels.
+ * @param[in] isTimestamp: true if the batch contains the timestamp
+ * @return uint32_t: the flags
+ */
+static uint32_t appTelemetryPayload_GetFlags_V2_Delta(bool isTimestamp) {
+
+	uint32_t flags = isTimestamp ? APP_TELEMETRY_PAYLOAD_V2_DELTA_FLAG_TIMESTAMP : 0;
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+		if(appTelemetryPayload_IsChannelSelected(appTelemetryPayload_TargetTelemetrySensorsPtr, name)) flags |= UINT32_C(1) << (name - AppTelemetryPayload_Name_Humidity + 1);
+	}
+	return flags;
+}
+/**
+ * @brief Returns the size of an empty batch in the 'V2 Delta' format: version, flags, device id, timestamp and number of samples.
+ * @return uint32_t: the size in bytes
+ */
+static uint32_t appTelemetryPayload_GetBatchOverhead_V2_Delta(void) {
+
+	// version and number of samples
+	uint32_t size = 2;
+
+	size += appTelemetryPayload_GetVarintLength(appTelemetryPayload_GetFlags_V2_Delta(true));
+	size += appTelemetryPayload_GetVarintLength(appTelemetryPayload_DeviceIdLength) + appTelemetryPayload_DeviceIdLength;
+	size += APP_TELEMETRY_PAYLOAD_V2_DELTA_TIMESTAMP_LENGTH;
+
+	return size;
+}
+/**
+ * @brief Returns the number of bytes a sample adds to a batch in the 'V2 Delta' format.
+ * @details The first sample adds its values. The following samples add the delta of deltas of their offset and the deltas of their values to the last sample.
+ * @param[in] batchSizePtr: the batch the sample is added to
+ * @param[in] samplePtr: the sample record
+ * @return uint32_t: the size in bytes
+ */
+static uint32_t appTelemetryPayload_GetSampleSize_V2_Delta(const AppTelemetryPayload_BatchSize_T * batchSizePtr, const AppTelemetryPayload_Sample_T * samplePtr) {
+
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+
+	bool isFirst = (0 == batchSizePtr->numberOfSamples);
+
+	uint32_t size = appTelemetryPayload_GetVarintLength(batchSizePtr->numberOfSamples + 1) - appTelemetryPayload_GetVarintLength(batchSizePtr->numberOfSamples);
+
+	if(!isFirst) {
+		int32_t offsetDeltaMillis = appTelemetryPayload_GetOffsetMillis(batchSizePtr->lastSample.tickCount, samplePtr->tickCount);
+		size += appTelemetryPayload_GetVarintLength(appTelemetryPayload_ZigZag((int64_t) offsetDeltaMillis - batchSizePtr->lastOffsetDeltaMillis));
+	}
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+		if(!appTelemetryPayload_IsChannelSelected(sensorsPtr, name)) continue;
+
+		int64_t value = appTelemetryPayload_GetChannelValue(samplePtr, name);
+		if(!isFirst) value -= appTelemetryPayload_GetChannelValue(&batchSizePtr->lastSample, name);
+
+		size += appTelemetryPayload_GetVarintLength(appTelemetryPayload_ZigZag(value));
+	}
+	return size;
+}
+/**
+ * @brief Returns the names of a 'V1 JSON' format.
+ * @param[in] payloadFormat: the payload format
+ * @return const char * const *: the names, NULL if payloadFormat is not a 'V1 JSON' format
+ */
+static const char * const * appTelemetryPayload_GetNames_V1_Json(AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat) {
+
+	switch(payloadFormat) {
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose:
+		return appTelemetryPayload_Names_V1_Json_Verbose;
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact:
+		return appTelemetryPayload_Names_V1_Json_Compact;
+	default:
+		return NULL;
+	}
+}
+/**
+ * @brief Reset the size of a batch to an empty batch.
+ * @param[out] batchSizePtr: the batch size
+ */
+void AppTelemetryPayload_ResetBatchSize(AppTelemetryPayload_BatchSize_T * batchSizePtr) {
+
+	assert(batchSizePtr);
+
+	batchSizePtr->numberOfSamples = 0;
+	batchSizePtr->size = 0;
+	batchSizePtr->firstTickCount = 0;
+	batchSizePtr->lastOffsetDeltaMillis = 0;
+}
+/**
+ * @brief Returns the encoded size of the batch if the sample was added, in the format as configured previously.
+ * @details Computed without encoding, does not allocate. Called in the sampling task to track the size of the open batch.
+ * Add the sample with @ref AppTelemetryPayload_AddSampleToBatchSize().
+ * @param[in] batchSizePtr: the batch size so far
+ * @param[in] samplePtr: the sample record
+ * @return uint32_t: the size in bytes
+ */
+uint32_t AppTelemetryPayload_GetBatchSizeWithSample(const AppTelemetryPayload_BatchSize_T * batchSizePtr, const AppTelemetryPayload_Sample_T * samplePtr) {
+
+	assert(batchSizePtr);
+	assert(samplePtr);
+
+	bool isFirst = (0 == batchSizePtr->numberOfSamples);
+
+	switch(appTelemetryPayload_PayloadFormat) {
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose:
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact:
+		return (isFirst ? APP_TELEMETRY_PAYLOAD_V1_JSON_BATCH_OVERHEAD : batchSizePtr->size + APP_TELEMETRY_PAYLOAD_V1_JSON_BATCH_SEPARATOR)
+				+ appTelemetryPayload_GetSampleSize_V1_Json(samplePtr, appTelemetryPayload_GetNames_V1_Json(appTelemetryPayload_PayloadFormat));
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V2_Json_Columnar:
+		return (isFirst ? appTelemetryPayload_GetBatchOverhead_V2_Json_Columnar() : batchSizePtr->size)
+				+ appTelemetryPayload_GetSampleSize_V2_Json_Columnar(batchSizePtr, samplePtr);
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor:
+		return (isFirst ? appTelemetryPayload_GetBatchOverhead_V2_Cbor() : batchSizePtr->size)
+				+ appTelemetryPayload_GetSampleSize_V2_Cbor(batchSizePtr, samplePtr);
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta:
+		return (isFirst ? appTelemetryPayload_GetBatchOverhead_V2_Delta() : batchSizePtr->size)
+				+ appTelemetryPayload_GetSampleSize_V2_Delta(batchSizePtr, samplePtr);
+	default:
+		Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_TELEMETRY_PAYLOAD_UNSUPPORTED_FORMAT));
+		return 0;
+	}
+}
+/**
+ * @brief Add a sample to the batch size.
+ * @param[in,out] batchSizePtr: the batch size
+ * @param[in] samplePtr: the sample record
+ * @param[in] batchSize: the size returned by @ref AppTelemetryPayload_GetBatchSizeWithSample() for the sample
+ */
+void AppTelemetryPayload_AddSampleToBatchSize(AppTelemetryPayload_BatchSize_T * batchSizePtr, const AppTelemetryPayload_Sample_T * samplePtr, uint32_t batchSize) {
+
+	assert(batchSizePtr);
+	assert(samplePtr);
+
+	if(0 == batchSizePtr->numberOfSamples) batchSizePtr->firstTickCount = samplePtr->tickCount;
+	else batchSizePtr->lastOffsetDeltaMillis = appTelemetryPayload_GetOffsetMillis(batchSizePtr->lastSample.tickCount, samplePtr->tickCount);
+
+	batchSizePtr->lastSample = *samplePtr;
+	batchSizePtr->numberOfSamples++;
+	batchSizePtr->size = batchSize;
+}
+/**
+ * @brief Returns the size of a batch of a single sample based on a new configuration. Used to test whether a new configuration is valid. Leaves module's configuration intact.
+ * @details Calculated with ISO 8601 timestamps, an upper bound for both timestamp formats.
+ * @param[in] tickCount: the current tick count
+ * @param[in] sensorValuePtr: the sensor values
+ * @param[in] sensorsConfigPtr: the new sensor configuration to be tested
+ * @param[in] payloadFormat: the payload format to be tested
+ * @return uint32_t: the size in bytes
+ * @see AppTelemetryPayload_GetBatchSizeWithSample()
+ */
+uint32_t AppTelemetryPayload_GetBatchSize_Test(
+		const TickType_t tickCount,
+		const Sensor_Value_T * sensorValuePtr,
+		const AppRuntimeConfig_Sensors_T * sensorsConfigPtr,
+		AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat) {
+
+	// remember old values
+	AppRuntimeConfig_Sensors_T * orgSensorsConfigPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+	AppRuntimeConfig_Telemetry_PayloadFormat_T orgPayloadFormat = appTelemetryPayload_PayloadFormat;
+	AppRuntimeConfig_Telemetry_TimestampFormat_T orgTimestampFormat = appTelemetryPayload_TimestampFormat;
+
+	appTelemetryPayload_TargetTelemetrySensorsPtr = (AppRuntimeConfig_Sensors_T *) sensorsConfigPtr;
+	appTelemetryPayload_PayloadFormat = payloadFormat;
+	// the longer of the timestamp formats
+	appTelemetryPayload_TimestampFormat = AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601;
+
+	AppTelemetryPayload_Sample_T sample;
+	AppTelemetryPayload_PopulateSample(&sample, tickCount, sensorValuePtr, APP_TELEMETRY_PAYLOAD_SENSOR_ALL);
+
+	AppTelemetryPayload_BatchSize_T batchSize;
+	AppTelemetryPayload_ResetBatchSize(&batchSize);
+
+	uint32_t size = AppTelemetryPayload_GetBatchSizeWithSample(&batchSize, &sample);
+
+	// restore original values
+	appTelemetryPayload_TargetTelemetrySensorsPtr = orgSensorsConfigPtr;
+	appTelemetryPayload_PayloadFormat = orgPayloadFormat;
+	appTelemetryPayload_TimestampFormat = orgTimestampFormat;
+
+	return size;
+}
+/**
+ * @brief Write length characters. Sets isOverflow if they don't fit, keeping room for the terminating 0.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] chars: the characters
+ * @param[in] length: the number of characters
+ */
+static void appTelemetryPayload_WriteChars(AppTelemetryPayload_Writer_T * writerPtr, const char * chars, uint32_t length) {
+
+	if(writerPtr->isOverflow || writerPtr->length + length >= writerPtr->bufferSize) {
+		writerPtr->isOverflow = true;
+		return;
+	}
+	memcpy(&writerPtr->bufferPtr[writerPtr->length], chars, length);
+	writerPtr->length += length;
+}
+/**
+ * @brief Write a single character.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] c: the character
+ */
+static inline void appTelemetryPayload_WriteChar(AppTelemetryPayload_Writer_T * writerPtr, char c) {
+	appTelemetryPayload_WriteChars(writerPtr, &c, 1);
+}
+/**
+ * @brief Write a number as an integer, as cJSON prints integral numbers ("%d"). Integer arithmetic only.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] value: the number
+ */
+static void appTelemetryPayload_WriteNumber(AppTelemetryPayload_Writer_T * writerPtr, int32_t value) {
+
+	// "-2147483648"
+	char digits[11];
+	uint32_t pos = sizeof(digits);
+	uint32_t absValue = (value < 0) ? (uint32_t) (-(int64_t) value) : (uint32_t) value;
+
+	do {
+		digits[--pos] = (char) ('0' + (absValue % 10));
+		absValue /= 10;
+	} while(absValue > 0);
+
+	if(value < 0) digits[--pos] = '-';
+
+	appTelemetryPayload_WriteChars(writerPtr, &digits[pos], sizeof(digits) - pos);
+}
+/**
+ * @brief Write a number of thousandths as decimal number without trailing zeros, e.g. 17.071, -1.5 or 20. Integer arithmetic only.
+ * @details The digits are the ones cJSON prints ("%1.15g") for the number divided by 1000.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] milli: the number of thousandths
+ */
+static void appTelemetryPayload_WriteMilli(AppTelemetryPayload_Writer_T * writerPtr, int32_t milli) {
+
+	// "-2147483.648"
+	char digits[12];
+	uint32_t pos = sizeof(digits);
+	uint32_t absValue = (milli < 0) ? (uint32_t) (-(int64_t) milli) : (uint32_t) milli;
+	uint32_t decimals = absValue % APP_TELEMETRY_PAYLOAD_JSON_TEMPERATURE_UNIT;
+
+	if(decimals > 0) {
+		uint32_t numberOfDecimals = 3;
+		for(; 0 == decimals % 10; decimals /= 10) numberOfDecimals--;
+		for(uint32_t i = 0; i < numberOfDecimals; i++) {
+			digits[--pos] = (char) ('0' + (decimals % 10));
+			decimals /= 10;
+		}
+		digits[--pos] = '.';
+	}
+	absValue /= APP_TELEMETRY_PAYLOAD_JSON_TEMPERATURE_UNIT;
+	do {
+		digits[--pos] = (char) ('0' + (absValue % 10));
+		absValue /= 10;
+	} while(absValue > 0);
+
+	if(milli < 0) digits[--pos] = '-';
+
+	appTelemetryPayload_WriteChars(writerPtr, &digits[pos], sizeof(digits) - pos);
+}
+/**
+ * @brief Write the value of a channel in the JSON formats: the temperature in degrees celsius with up to 3 decimals, see appTelemetryPayload_WriteMilli(), the other channels as integers.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] name: the channel, #AppTelemetryPayload_Name_Humidity .. #AppTelemetryPayload_Name_MagZ
+ * @param[in] value: the value as kept in the sample record
+ */
+static inline void appTelemetryPayload_WriteValue_Json(AppTelemetryPayload_Writer_T * writerPtr, AppTelemetryPayload_Name_T name, int32_t value) {
+
+	if(AppTelemetryPayload_Name_Temperature == name) appTelemetryPayload_WriteMilli(writerPtr, value);
+	else appTelemetryPayload_WriteNumber(writerPtr, value);
+}
+/**
+ * @brief Write a CBOR head in its shortest form: the major type and the argument, big endian.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] majorType: the major type, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_*
+ * @param[in] argument: the argument: value, length or number of items
+ */
+static void appTelemetryPayload_WriteCborHead(AppTelemetryPayload_Writer_T * writerPtr, uint8_t majorType, uint64_t argument) {
+
+	char head[9];
+	uint32_t length = appTelemetryPayload_GetCborHeadLength(argument);
+
+	switch(length) {
+	case 1: head[0] = (char) ((majorType << 5) | (uint8_t) argument); break;
+	case 2: head[0] = (char) ((majorType << 5) | 24); break;
+	case 3: head[0] = (char) ((majorType << 5) | 25); break;
+	case 5: head[0] = (char) ((majorType << 5) | 26); break;
+	default: head[0] = (char) ((majorType << 5) | 27); break;
+	}
+	for(uint32_t i = length - 1; i > 0; i--) {
+		head[i] = (char) (argument & 0xFF);
+		argument >>= 8;
+	}
+	appTelemetryPayload_WriteChars(writerPtr, head, length);
+}
+/**
+ * @brief Write an integer as CBOR unsigned or negative integer.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] value: the number
+ */
+static inline void appTelemetryPayload_WriteCborInt(AppTelemetryPayload_Writer_T * writerPtr, int32_t value) {
+
+	if(value < 0) appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_NEGATIVE, (uint64_t) (-1 - (int64_t) value));
+	else appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_UNSIGNED, (uint64_t) value);
+}
+/**
+ * @brief Write an unsigned LEB128 varint: 7 bits per byte, least significant first, the high bit set on all but the last byte.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] value: the number
+ */
+static void appTelemetryPayload_WriteVarint(AppTelemetryPayload_Writer_T * writerPtr, uint64_t value) {
+
+	char bytes[10];
+	uint32_t length = 0;
+
+	while(value >= 0x80) {
+		bytes[length++] = (char) ((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	bytes[length++] = (char) value;
+
+	appTelemetryPayload_WriteChars(writerPtr, bytes, length);
+}
+/**
+ * @brief Write a member name: "name":
+ * @param[in,out] writerPtr: the writer
+ * @param[in] name: the member name, must not need escaping
+ */
+static void appTelemetryPayload_WriteName(AppTelemetryPayload_Writer_T * writerPtr, const char * name) {
+
+	appTelemetryPayload_WriteChar(writerPtr, '"');
+	appTelemetryPayload_WriteChars(writerPtr, name, (uint32_t) strlen(name));
+	appTelemetryPayload_WriteChars(writerPtr, "\":", 2);
+}
+/**
+ * @brief Returns the timestamp of a sample: from the time base of the writer if set, otherwise from the tick count.
+ * @param[in] writerPtr: the writer
+ * @param[in] tickCount: the tick count of the sample
+ * @return AppTimestamp_T: the timestamp
+ */
+static AppTimestamp_T appTelemetryPayload_GetTimestamp(const AppTelemetryPayload_Writer_T * writerPtr, TickType_t tickCount) {
+
+	if(0 == writerPtr->firstMillisSinceEpoch) return AppTimestamp_GetTimestamp(tickCount);
+
+	uint64_t millisSinceEpoch = writerPtr->firstMillisSinceEpoch + (uint64_t) (int64_t) appTelemetryPayload_GetOffsetMillis(writerPtr->firstTickCount, tickCount);
+
+	AppTimestamp_T timestamp = { .secondsSinceEpoch = millisSinceEpoch / 1000, .millis = (uint16_t) (millisSinceEpoch % 1000), .tickCount = 0, .isTickCount = false };
+
+	return timestamp;
+}
+/**
+ * @brief Write the timestamp member of a sample in the timestamp format as configured previously: "name":"timestamp" or "name":millisSinceEpoch
+ * @details As with cJSON, nothing is written if @ref AppTimestamp is not enabled yet.
+ * The string is formatted with @ref AppTimestamp_FormatTimestampStrCached(), only the seconds and millis are formatted for most samples.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] name: the member name
+ * @param[in] tickCount: the tick count of the sample
+ * @return bool: true if the member was written
+ */
+static bool appTelemetryPayload_WriteTimestampMember(AppTelemetryPayload_Writer_T * writerPtr, const char * name, TickType_t tickCount) {
+
+	if(AppRuntimeConfig_Telemetry_TimestampFormat_EpochMillis == appTelemetryPayload_TimestampFormat) {
+
+		uint64_t millisSinceEpoch = 0;
+
+		if(!AppTimestamp_GetMillisSinceEpoch(appTelemetryPayload_GetTimestamp(writerPtr, tickCount), &millisSinceEpoch)) return false;
+
+		// "18446744073709551615"
+		char digits[20];
+		uint32_t pos = sizeof(digits);
+		do {
+			digits[--pos] = (char) ('0' + (millisSinceEpoch % 10));
+			millisSinceEpoch /= 10;
+		} while(millisSinceEpoch > 0);
+
+		appTelemetryPayload_WriteName(writerPtr, name);
+		appTelemetryPayload_WriteChars(writerPtr, &digits[pos], sizeof(digits) - pos);
+
+		return true;
+	}
+
+	char timestampStr[APP_TIMESTAMP_STRING_LENGTH + 1];
+
+	if(!AppTimestamp_FormatTimestampStrCached(appTelemetryPayload_GetTimestamp(writerPtr, tickCount), &appTelemetryPayload_TimestampStrCache, timestampStr)) return false;
+
+	appTelemetryPayload_WriteName(writerPtr, name);
+	appTelemetryPayload_WriteChar(writerPtr, '"');
+	appTelemetryPayload_WriteChars(writerPtr, timestampStr, APP_TIMESTAMP_STRING_LENGTH);
+	appTelemetryPayload_WriteChar(writerPtr, '"');
+
+	return true;
+}
+/**
+ * @brief Encode a batch in a 'V1 JSON' format: an array of sample objects, members in the order of appTelemetryPayload_CreateNew_V1_Json_Verbose() / appTelemetryPayload_CreateNew_V1_Json_Compact().
+ * @param[in,out] writerPtr: the writer
+ * @param[in] samplesPtr: array of numberOfSamples sample records
+ * @param[in] numberOfSamples: the number of samples
+ * @param[in] names: the element names of the format
+ */
+static void appTelemetryPayload_EncodeBatch_V1_Json(AppTelemetryPayload_Writer_T * writerPtr, const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples, const char * const names[]) {
+
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+
+	appTelemetryPayload_WriteChar(writerPtr, '[');
+
+	for(uint32_t i = 0; i < numberOfSamples && !writerPtr->isOverflow; i++) {
+
+		if(i > 0) appTelemetryPayload_WriteChar(writerPtr, ',');
+
+		appTelemetryPayload_WriteChar(writerPtr, '{');
+
+		if(appTelemetryPayload_WriteTimestampMember(writerPtr, names[AppTelemetryPayload_Name_Timestamp], samplesPtr[i].tickCount)) appTelemetryPayload_WriteChar(writerPtr, ',');
+
+		appTelemetryPayload_WriteName(writerPtr, names[AppTelemetryPayload_Name_DeviceId]);
+		appTelemetryPayload_WriteChars(writerPtr, appTelemetryPayload_DeviceIdJsonStr, appTelemetryPayload_DeviceIdJsonLength);
+
+		for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+			if(appTelemetryPayload_IsChannelSelected(sensorsPtr, name) && !appTelemetryPayload_IsChannelOmitted(&samplesPtr[i], name)) {
+				appTelemetryPayload_WriteChar(writerPtr, ',');
+				appTelemetryPayload_WriteName(writerPtr, names[name]);
+				appTelemetryPayload_WriteValue_Json(writerPtr, name, appTelemetryPayload_GetChannelValue(&samplesPtr[i], name));
+			}
+		}
+
+		appTelemetryPayload_WriteChar(writerPtr, '}');
+	}
+
+	appTelemetryPayload_WriteChar(writerPtr, ']');
+}
+/**
+ * @brief Encode a batch in the 'V2 JSON Columnar' format.
+ * @details One object per batch: the device id and the timestamp of the first sample once,
+ * the offsets of the samples to the timestamp in milliseconds and an array of values per selected sensor channel.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] samplesPtr: array of numberOfSamples sample records, at least 1
+ * @param[in] numberOfSamples: the number of samples
+ */
+static void appTelemetryPayload_EncodeBatch_V2_Json_Columnar(AppTelemetryPayload_Writer_T * writerPtr, const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples) {
+
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+	const char * const * names = appTelemetryPayload_Names_V2_Json_Columnar;
+
+	appTelemetryPayload_WriteChar(writerPtr, '{');
+
+	appTelemetryPayload_WriteName(writerPtr, names[AppTelemetryPayload_Name_DeviceId]);
+	appTelemetryPayload_WriteChars(writerPtr, appTelemetryPayload_DeviceIdJsonStr, appTelemetryPayload_DeviceIdJsonLength);
+
+	appTelemetryPayload_WriteChar(writerPtr, ',');
+	if(appTelemetryPayload_WriteTimestampMember(writerPtr, names[AppTelemetryPayload_Name_Timestamp], samplesPtr[0].tickCount)) appTelemetryPayload_WriteChar(writerPtr, ',');
+
+	appTelemetryPayload_WriteName(writerPtr, APP_TELEMETRY_PAYLOAD_V2_JSON_COLUMNAR_OFFSETS_NAME);
+	appTelemetryPayload_WriteChar(writerPtr, '[');
+	for(uint32_t i = 0; i < numberOfSamples; i++) {
+		if(i > 0) appTelemetryPayload_WriteChar(writerPtr, ',');
+		appTelemetryPayload_WriteNumber(writerPtr, appTelemetryPayload_GetOffsetMillis(samplesPtr[0].tickCount, samplesPtr[i].tickCount));
+	}
+	appTelemetryPayload_WriteChar(writerPtr, ']');
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf && !writerPtr->isOverflow; name++) {
+
+		if(!appTelemetryPayload_IsChannelSelected(sensorsPtr, name)) continue;
+
+		appTelemetryPayload_WriteChar(writerPtr, ',');
+		appTelemetryPayload_WriteName(writerPtr, names[name]);
+		appTelemetryPayload_WriteChar(writerPtr, '[');
+		for(uint32_t i = 0; i < numberOfSamples; i++) {
+			if(i > 0) appTelemetryPayload_WriteChar(writerPtr, ',');
+			if(appTelemetryPayload_IsChannelOmitted(&samplesPtr[i], name)) appTelemetryPayload_WriteChars(writerPtr, "null", APP_TELEMETRY_PAYLOAD_JSON_NULL_LENGTH);
+			else appTelemetryPayload_WriteValue_Json(writerPtr, name, appTelemetryPayload_GetChannelValue(&samplesPtr[i], name));
+		}
+		appTelemetryPayload_WriteChar(writerPtr, ']');
+	}
+
+	appTelemetryPayload_WriteChar(writerPtr, '}');
+}
+/**
+ * @brief Encode a batch in the 'V2 CBOR' format.
+ * @details One definite length map per batch with the keys of #appTelemetryPayload_Keys_V2_Cbor: the device id as text and the timestamp of the first sample
+ * as milliseconds since the epoch once, the offsets of the samples to the timestamp in milliseconds and an array of values per selected sensor channel.
+ * All numbers are integers in their shortest encoding.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] samplesPtr: array of numberOfSamples sample records, at least 1
+ * @param[in] numberOfSamples: the number of samples
+ */
+static void appTelemetryPayload_EncodeBatch_V2_Cbor(AppTelemetryPayload_Writer_T * writerPtr, const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples) {
+
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+	const uint8_t * keys = appTelemetryPayload_Keys_V2_Cbor;
+
+	uint64_t millisSinceEpoch = 0;
+	bool isTimestamp = AppTimestamp_GetMillisSinceEpoch(appTelemetryPayload_GetTimestamp(writerPtr, samplesPtr[0].tickCount), &millisSinceEpoch);
+
+	appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_MAP, (isTimestamp ? 2 : 1) + appTelemetryPayload_GetNumberOfArrays_V2());
+
+	appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_UNSIGNED, keys[AppTelemetryPayload_Name_DeviceId]);
+	appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_TEXT, appTelemetryPayload_DeviceIdLength);
+	appTelemetryPayload_WriteChars(writerPtr, appTelemetryPayload_DeviceId, appTelemetryPayload_DeviceIdLength);
+
+	// as with the JSON formats, no timestamp if AppTimestamp is not enabled yet
+	if(isTimestamp) {
+		appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_UNSIGNED, keys[AppTelemetryPayload_Name_Timestamp]);
+		appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_UNSIGNED, millisSinceEpoch);
+	}
+
+	appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_UNSIGNED, APP_TELEMETRY_PAYLOAD_V2_CBOR_OFFSETS_KEY);
+	appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_ARRAY, numberOfSamples);
+	for(uint32_t i = 0; i < numberOfSamples; i++) {
+		appTelemetryPayload_WriteCborInt(writerPtr, appTelemetryPayload_GetOffsetMillis(samplesPtr[0].tickCount, samplesPtr[i].tickCount));
+	}
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf && !writerPtr->isOverflow; name++) {
+
+		if(!appTelemetryPayload_IsChannelSelected(sensorsPtr, name)) continue;
+
+		appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_UNSIGNED, keys[name]);
+		appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_ARRAY, numberOfSamples);
+		for(uint32_t i = 0; i < numberOfSamples; i++) {
+			if(appTelemetryPayload_IsChannelOmitted(&samplesPtr[i], name)) appTelemetryPayload_WriteCborHead(writerPtr, APP_TELEMETRY_PAYLOAD_CBOR_MAJOR_TYPE_SIMPLE, APP_TELEMETRY_PAYLOAD_CBOR_SIMPLE_NULL);
+			else appTelemetryPayload_WriteCborInt(writerPtr, appTelemetryPayload_GetChannelValue(&samplesPtr[i], name));
+		}
+	}
+}
+/**
+ * @brief Encode a batch in the 'V2 Delta' format.
+ * @details Layout, all numbers are varints (appTelemetryPayload_WriteVarint()), signed numbers zig-zag encoded (appTelemetryPayload_ZigZag()):
+ * - version #APP_TELEMETRY_PAYLOAD_V2_DELTA_VERSION (1 byte)
+ * - flags: #APP_TELEMETRY_PAYLOAD_V2_DELTA_FLAG_TIMESTAMP and one bit per selected sensor channel
+ * - length of the device id, followed by the device id
+ * - timestamp of the first sample in milliseconds since the epoch, if flagged
+ * - number of samples n
+ * - n-1 signed delta of deltas of the sample offsets in milliseconds. The first offset and the delta before it are 0.
+ * - per selected sensor channel: the signed value of the first sample, followed by n-1 signed deltas to the previous value.
+ *   A value suppressed by the deadband filter holds the last sent value and is sent as unchanged.
+ *
+ * Stable signals encode in one byte per value.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] samplesPtr: array of numberOfSamples sample records, at least 1
+ * @param[in] numberOfSamples: the number of samples
+ */
+static void appTelemetryPayload_EncodeBatch_V2_Delta(AppTelemetryPayload_Writer_T * writerPtr, const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples) {
+
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+
+	uint64_t millisSinceEpoch = 0;
+	bool isTimestamp = AppTimestamp_GetMillisSinceEpoch(appTelemetryPayload_GetTimestamp(writerPtr, samplesPtr[0].tickCount), &millisSinceEpoch);
+
+	appTelemetryPayload_WriteChar(writerPtr, (char) APP_TELEMETRY_PAYLOAD_V2_DELTA_VERSION);
+	appTelemetryPayload_WriteVarint(writerPtr, appTelemetryPayload_GetFlags_V2_Delta(isTimestamp));
+
+	appTelemetryPayload_WriteVarint(writerPtr, appTelemetryPayload_DeviceIdLength);
+	appTelemetryPayload_WriteChars(writerPtr, appTelemetryPayload_DeviceId, appTelemetryPayload_DeviceIdLength);
+
+	if(isTimestamp) appTelemetryPayload_WriteVarint(writerPtr, millisSinceEpoch);
+
+	appTelemetryPayload_WriteVarint(writerPtr, numberOfSamples);
+
+	int32_t lastOffsetDeltaMillis = 0;
+	for(uint32_t i = 1; i < numberOfSamples; i++) {
+		int32_t offsetDeltaMillis = appTelemetryPayload_GetOffsetMillis(samplesPtr[i - 1].tickCount, samplesPtr[i].tickCount);
+		appTelemetryPayload_WriteVarint(writerPtr, appTelemetryPayload_ZigZag((int64_t) offsetDeltaMillis - lastOffsetDeltaMillis));
+		lastOffsetDeltaMillis = offsetDeltaMillis;
+	}
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf && !writerPtr->isOverflow; name++) {
+
+		if(!appTelemetryPayload_IsChannelSelected(sensorsPtr, name)) continue;
+
+		int64_t lastValue = 0;
+		for(uint32_t i = 0; i < numberOfSamples; i++) {
+			int64_t value = appTelemetryPayload_GetChannelValue(&samplesPtr[i], name);
+			appTelemetryPayload_WriteVarint(writerPtr, appTelemetryPayload_ZigZag(value - lastValue));
+			lastValue = value;
+		}
+	}
+}
+/**
+ * @brief Returns true if the format as configured previously is binary, i.e. the payload is not a string.
+ * @return bool: true for 'V2 CBOR' and 'V2 Delta'
+ */
+bool AppTelemetryPayload_IsBinaryFormat(void) {
+	return (AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor == appTelemetryPayload_PayloadFormat ||
+			AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta == appTelemetryPayload_PayloadFormat);
+}
+/**
+ * @brief Encode a batch of samples in the format as configured previously into a caller provided buffer.
+ * @details The timestamps are taken from the tick counts of the samples, see @ref AppTelemetryPayload_EncodeBatchAt().
+ * @param[in] samplesPtr: array of numberOfSamples sample records
+ * @param[in] numberOfSamples: the number of samples in the batch, at least 1
+ * @param[out] bufferPtr: the buffer, receives the payload followed by a terminating 0
+ * @param[in] bufferSize: the size of the buffer
+ * @param[out] lengthPtr: the length of the payload, without the terminating 0
+ * @return Retcode_T: retcode from @ref AppTelemetryPayload_EncodeBatchAt()
+ */
+Retcode_T AppTelemetryPayload_EncodeBatch(const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr) {
+	return AppTelemetryPayload_EncodeBatchAt(samplesPtr, numberOfSamples, 0, bufferPtr, bufferSize, lengthPtr);
+}
+/**
+ * @brief Encode a batch of samples in the format as configured previously into a caller provided buffer, with the time of the first sample given.
+ * @details Used for batches spilled in a previous run, their tick counts only give the offsets between the samples.
+ * @details Streaming encoder: does not allocate and does not build a cJSON tree.
+ * For the 'V1 JSON' formats the output is identical to cJSON_PrintUnformatted() of an array of @ref AppTelemetryPayload_CreateNew() payloads.
+ * The 'V2 CBOR' and 'V2 Delta' payloads are binary and may contain 0 bytes, use the length, see @ref AppTelemetryPayload_IsBinaryFormat().
+ * @param[in] samplesPtr: array of numberOfSamples sample records
+ * @param[in] numberOfSamples: the number of samples in the batch, at least 1
+ * @param[in] firstMillisSinceEpoch: the time of the first sample in milliseconds since the epoch, 0 to take the timestamps from the tick counts with @ref AppTimestamp_GetTimestamp()
+ * @param[out] bufferPtr: the buffer, receives the payload followed by a terminating 0
+ * @param[in] bufferSize: the size of the buffer
+ * @param[out] lengthPtr: the length of the payload, without the terminating 0
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_PAYLOAD_UNSUPPORTED_FORMAT)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL)
+ */
+Retcode_T AppTelemetryPayload_EncodeBatchAt(const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples, uint64_t firstMillisSinceEpoch, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr) {
+
+	assert(samplesPtr);
+	assert(numberOfSamples > 0);
+	assert(bufferPtr);
+	assert(lengthPtr);
+
+	AppTelemetryPayload_Writer_T writer = { .bufferPtr = bufferPtr, .bufferSize = bufferSize, .length = 0, .isOverflow = false, .firstMillisSinceEpoch = firstMillisSinceEpoch, .firstTickCount = samplesPtr[0].tickCount };
+
+	switch(appTelemetryPayload_PayloadFormat) {
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose:
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact:
+		appTelemetryPayload_EncodeBatch_V1_Json(&writer, samplesPtr, numberOfSamples, appTelemetryPayload_GetNames_V1_Json(appTelemetryPayload_PayloadFormat));
+		break;
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V2_Json_Columnar:
+		appTelemetryPayload_EncodeBatch_V2_Json_Columnar(&writer, samplesPtr, numberOfSamples);
+		break;
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor:
+		appTelemetryPayload_EncodeBatch_V2_Cbor(&writer, samplesPtr, numberOfSamples);
+		break;
+	case AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta:
+		appTelemetryPayload_EncodeBatch_V2_Delta(&writer, samplesPtr, numberOfSamples);
+		break;
+	default:
+		return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_PAYLOAD_UNSUPPORTED_FORMAT);
+	}
+
+	if(writer.isOverflow) {
+		*lengthPtr = 0;
+		if(bufferSize > 0) bufferPtr[0] = '\0';
+		return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL);
+	}
+
+	bufferPtr[writer.length] = '\0';
+	*lengthPtr = writer.length;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Reset a window to an empty window.
+ * @param[out] aggregatePtr: the window
+ */
+void AppTelemetryPayload_ResetAggregate(AppTelemetryPayload_Aggregate_T * aggregatePtr) {
+
+	assert(aggregatePtr);
+
+	aggregatePtr->numberOfSamples = 0;
+	aggregatePtr->firstTickCount = 0;
+	aggregatePtr->lastTickCount = 0;
+
+	for(uint32_t channel = 0; channel < APP_TELEMETRY_PAYLOAD_NUMBER_OF_CHANNELS; channel++) aggregatePtr->channels[channel].numberOfValues = 0;
+}
+/**
+ * @brief Add a sample to the statistics of a window. Does not allocate, called in the sampling task.
+ * @details Updates min, max, mean and the sum of the squared differences to the mean of the selected sensor channels with Welford's algorithm:
+ * numerically stable in a single pass, without keeping the samples. Channels whose sensor was not read for the sample are not updated.
+ * @param[in,out] aggregatePtr: the window
+ * @param[in] samplePtr: the sample record
+ */
+void AppTelemetryPayload_AddSampleToAggregate(AppTelemetryPayload_Aggregate_T * aggregatePtr, const AppTelemetryPayload_Sample_T * samplePtr) {
+
+	assert(aggregatePtr);
+	assert(samplePtr);
+
+	if(0 == aggregatePtr->numberOfSamples) aggregatePtr->firstTickCount = samplePtr->tickCount;
+	aggregatePtr->lastTickCount = samplePtr->tickCount;
+	aggregatePtr->numberOfSamples++;
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+
+		if(!appTelemetryPayload_IsChannelSelected(appTelemetryPayload_TargetTelemetrySensorsPtr, name) || !appTelemetryPayload_IsChannelPresent(samplePtr, name)) continue;
+
+		AppTelemetryPayload_ChannelAggregate_T * channelPtr = &aggregatePtr->channels[name - AppTelemetryPayload_Name_Humidity];
+		int32_t value = appTelemetryPayload_GetChannelValue(samplePtr, name);
+
+		channelPtr->numberOfValues++;
+
+		if(1 == channelPtr->numberOfValues) {
+			channelPtr->min = value;
+			channelPtr->max = value;
+			channelPtr->mean = value;
+			channelPtr->m2 = 0;
+			continue;
+		}
+		if(value < channelPtr->min) channelPtr->min = value;
+		if(value > channelPtr->max) channelPtr->max = value;
+
+		double delta = value - channelPtr->mean;
+		channelPtr->mean += delta / channelPtr->numberOfValues;
+		channelPtr->m2 += delta * (value - channelPtr->mean);
+	}
+}
+/**
+ * @brief Returns the sample standard deviation of a channel of a window.
+ * @param[in] channelPtr: the channel of the window
+ * @return double: the standard deviation, 0 for a channel of a single value
+ */
+static inline double appTelemetryPayload_GetStddev(const AppTelemetryPayload_ChannelAggregate_T * channelPtr) {
+	return (channelPtr->numberOfValues > 1) ? sqrt(channelPtr->m2 / (channelPtr->numberOfValues - 1)) : 0;
+}
+/**
+ * @brief Returns a decimal number in thousandths, rounded half away from zero.
+ * @param[in] value: the number
+ * @return int64_t: the number of thousandths
+ */
+static inline int64_t appTelemetryPayload_GetThousandths(double value) {
+	return (int64_t) (value * 1000 + ((value < 0) ? -0.5 : 0.5));
+}
+/**
+ * @brief Returns the number of characters of a number of thousandths written by appTelemetryPayload_WriteThousandths().
+ * @param[in] thousandths: the number of thousandths
+ * @return uint32_t: the number of characters
+ */
+static uint32_t appTelemetryPayload_GetThousandthsLength(int64_t thousandths) {
+
+	uint64_t absValue = (thousandths < 0) ? (uint64_t) -thousandths : (uint64_t) thousandths;
+
+	// sign, integer digits, decimal point and decimals
+	uint32_t length = ((thousandths < 0) ? UINT32_C(2) : UINT32_C(1)) + 1 + APP_TELEMETRY_PAYLOAD_AGGREGATE_DECIMALS;
+
+	for(absValue /= 1000; absValue >= 10; absValue /= 10) length++;
+
+	return length;
+}
+/**
+ * @brief Returns the number of characters of a decimal number written by appTelemetryPayload_WriteDecimal().
+ * @param[in] value: the number
+ * @return uint32_t: the number of characters
+ */
+static inline uint32_t appTelemetryPayload_GetDecimalLength(double value) {
+	return appTelemetryPayload_GetThousandthsLength(appTelemetryPayload_GetThousandths(value));
+}
+/**
+ * @brief Returns true if a quantile is selected.
+ * @param[in] quantile: index of the quantile, see #appTelemetryPayload_QuantilesPermille
+ * @return bool: true if selected
+ */
+static inline bool appTelemetryPayload_IsQuantileSelected(uint32_t quantile) {
+
+	switch(quantile) {
+	case 0: return appTelemetryPayload_Aggregates.isP50;
+	case 1: return appTelemetryPayload_Aggregates.isP95;
+	case 2: return appTelemetryPayload_Aggregates.isP99;
+	default: assert(0); return false;
+	}
+}
+/**
+ * @brief Returns true if any quantile is selected, i.e. the accelerometer and gyroscope channels are fed into sketches.
+ * @return bool: true if p50, p95 or p99 is selected
+ */
+bool AppTelemetryPayload_IsQuantileAggregate(void) {
+	return (appTelemetryPayload_Aggregates.isP50 || appTelemetryPayload_Aggregates.isP95 || appTelemetryPayload_Aggregates.isP99);
+}
+/**
+ * @brief Returns true if a channel has quantiles.
+ * @param[in] name: the channel
+ * @return bool: true for the accelerometer and gyroscope channels
+ */
+static inline bool appTelemetryPayload_IsSketchChannel(AppTelemetryPayload_Name_T name) {
+	return (name >= AppTelemetryPayload_Name_AccelX && name <= AppTelemetryPayload_Name_GyroZ);
+}
+/**
+ * @brief Returns true if any of the statistics of a channel is selected, i.e. the channel is sent.
+ * @param[in] name: the channel
+ * @return bool: true if min, max, mean or standard deviation is selected, or a quantile for a channel with quantiles
+ */
+static inline bool appTelemetryPayload_IsChannelAggregate(AppTelemetryPayload_Name_T name) {
+	return (appTelemetryPayload_Aggregates.isMin || appTelemetryPayload_Aggregates.isMax || appTelemetryPayload_Aggregates.isMean || appTelemetryPayload_Aggregates.isStddev
+			|| (appTelemetryPayload_IsSketchChannel(name) && AppTelemetryPayload_IsQuantileAggregate()));
+}
+/**
+ * @brief Add the accelerometer and gyroscope values of a sample to their sketches. Does not allocate, called in the sampling task.
+ * @param[in,out] sketchesPtr: #APP_TELEMETRY_PAYLOAD_NUMBER_OF_SKETCH_CHANNELS sketches, accelerometer x, y, z, gyroscope x, y, z
+ * @param[in] samplePtr: the sample record
+ */
+void AppTelemetryPayload_AddSampleToSketches(AppTelemetrySketch_T * sketchesPtr, const AppTelemetryPayload_Sample_T * samplePtr) {
+
+	assert(sketchesPtr);
+	assert(samplePtr);
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_AccelX; name <= AppTelemetryPayload_Name_GyroZ; name++) {
+
+		if(!appTelemetryPayload_IsChannelSelected(appTelemetryPayload_TargetTelemetrySensorsPtr, name) || !appTelemetryPayload_IsChannelPresent(samplePtr, name)) continue;
+
+		AppTelemetrySketch_Add(&sketchesPtr[name - AppTelemetryPayload_Name_AccelX], appTelemetryPayload_GetChannelValue(samplePtr, name));
+	}
+}
+/**
+ * @brief Set the quantiles of a window from the sketches of its samples and reset the sketches for the next window. Called in the sampling task.
+ * @param[in,out] aggregatePtr: the window
+ * @param[in,out] sketchesPtr: #APP_TELEMETRY_PAYLOAD_NUMBER_OF_SKETCH_CHANNELS sketches, see @ref AppTelemetryPayload_AddSampleToSketches()
+ */
+void AppTelemetryPayload_SetAggregateQuantiles(AppTelemetryPayload_Aggregate_T * aggregatePtr, AppTelemetrySketch_T * sketchesPtr) {
+
+	assert(aggregatePtr);
+	assert(sketchesPtr);
+
+	for(uint32_t channel = 0; channel < APP_TELEMETRY_PAYLOAD_NUMBER_OF_SKETCH_CHANNELS; channel++) {
+
+		for(uint32_t quantile = 0; quantile < APP_TELEMETRY_PAYLOAD_NUMBER_OF_QUANTILES; quantile++) {
+			aggregatePtr->quantiles[channel][quantile] = AppTelemetrySketch_GetQuantile(&sketchesPtr[channel], appTelemetryPayload_QuantilesPermille[quantile]);
+		}
+		AppTelemetrySketch_Reset(&sketchesPtr[channel]);
+	}
+}
+/**
+ * @brief Returns the encoded size of a window in the format as configured previously, see @ref AppTelemetryPayload_EncodeAggregate().
+ * @details Computed without encoding, does not allocate. The timestamp is included, without it the encoded size is smaller.
+ * @param[in] aggregatePtr: the window, at least 1 sample
+ * @return uint32_t: the size in bytes
+ */
+uint32_t AppTelemetryPayload_GetAggregateSize(const AppTelemetryPayload_Aggregate_T * aggregatePtr) {
+
+	assert(aggregatePtr);
+
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+	const AppRuntimeConfig_Aggregates_T * aggregatesPtr = &appTelemetryPayload_Aggregates;
+
+	bool isVerbose = (AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose == appTelemetryPayload_PayloadFormat);
+	const char * const * names = isVerbose ? appTelemetryPayload_Names_V1_Json_Verbose : appTelemetryPayload_Names_V1_Json_Compact;
+	const char * const * aggregateNames = isVerbose ? appTelemetryPayload_AggregateNames_Verbose : appTelemetryPayload_AggregateNames_Compact;
+
+	// braces and the commas before timestamp and duration
+	uint32_t size = 4;
+
+	size += appTelemetryPayload_GetMemberLength(names[AppTelemetryPayload_Name_DeviceId], appTelemetryPayload_DeviceIdJsonLength);
+	size += appTelemetryPayload_GetMemberLength(names[AppTelemetryPayload_Name_Timestamp], appTelemetryPayload_GetTimestampValueLength_Json());
+	size += appTelemetryPayload_GetMemberLength(aggregateNames[AppTelemetryPayload_AggregateName_Duration],
+				appTelemetryPayload_GetNumberLength(appTelemetryPayload_GetOffsetMillis(aggregatePtr->firstTickCount, aggregatePtr->lastTickCount)));
+
+	if(aggregatesPtr->isCount) size += 1 + appTelemetryPayload_GetMemberLength(aggregateNames[AppTelemetryPayload_AggregateName_Count], appTelemetryPayload_GetNumberLength((int32_t) aggregatePtr->numberOfSamples));
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf; name++) {
+
+		const AppTelemetryPayload_ChannelAggregate_T * channelPtr = &aggregatePtr->channels[name - AppTelemetryPayload_Name_Humidity];
+
+		if(!appTelemetryPayload_IsChannelSelected(sensorsPtr, name) || !appTelemetryPayload_IsChannelAggregate(name) || 0 == channelPtr->numberOfValues) continue;
+
+		// braces, the separators are counted with the members and one removed
+		uint32_t objectSize = 1;
+
+		if(aggregatesPtr->isMin) objectSize += 1 + appTelemetryPayload_GetMemberLength(aggregateNames[AppTelemetryPayload_AggregateName_Min], appTelemetryPayload_GetValueLength_Json(name, channelPtr->min));
+		if(aggregatesPtr->isMax) objectSize += 1 + appTelemetryPayload_GetMemberLength(aggregateNames[AppTelemetryPayload_AggregateName_Max], appTelemetryPayload_GetValueLength_Json(name, channelPtr->max));
+		if(aggregatesPtr->isMean) objectSize += 1 + appTelemetryPayload_GetMemberLength(aggregateNames[AppTelemetryPayload_AggregateName_Mean], appTelemetryPayload_GetDecimalLength(channelPtr->mean / appTelemetryPayload_GetUnit_Json(name)));
+		if(aggregatesPtr->isStddev) objectSize += 1 + appTelemetryPayload_GetMemberLength(aggregateNames[AppTelemetryPayload_AggregateName_Stddev], appTelemetryPayload_GetDecimalLength(appTelemetryPayload_GetStddev(channelPtr) / appTelemetryPayload_GetUnit_Json(name)));
+
+		for(uint32_t quantile = 0; quantile < APP_TELEMETRY_PAYLOAD_NUMBER_OF_QUANTILES && appTelemetryPayload_IsSketchChannel(name); quantile++) {
+			if(!appTelemetryPayload_IsQuantileSelected(quantile)) continue;
+			objectSize += 1 + appTelemetryPayload_GetMemberLength(aggregateNames[AppTelemetryPayload_AggregateName_P50 + quantile],
+								appTelemetryPayload_GetNumberLength(aggregatePtr->quantiles[name - AppTelemetryPayload_Name_AccelX][quantile]));
+		}
+
+		size += 1 + appTelemetryPayload_GetMemberLength(names[name], objectSize);
+	}
+	return size;
+}
+/**
+ * @brief Write a number of thousandths as decimal number with #APP_TELEMETRY_PAYLOAD_AGGREGATE_DECIMALS decimals, e.g. -12.345. Integer arithmetic only.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] thousandths: the number of thousandths
+ */
+static void appTelemetryPayload_WriteThousandths(AppTelemetryPayload_Writer_T * writerPtr, int64_t thousandths) {
+
+	uint64_t absValue = (thousandths < 0) ? (uint64_t) -thousandths : (uint64_t) thousandths;
+
+	// "-9223372036854775.808"
+	char digits[21];
+	uint32_t pos = sizeof(digits);
+
+	for(uint32_t i = 0; i < APP_TELEMETRY_PAYLOAD_AGGREGATE_DECIMALS; i++) {
+		digits[--pos] = (char) ('0' + (absValue % 10));
+		absValue /= 10;
+	}
+	digits[--pos] = '.';
+	do {
+		digits[--pos] = (char) ('0' + (absValue % 10));
+		absValue /= 10;
+	} while(absValue > 0);
+
+	if(thousandths < 0) digits[--pos] = '-';
+
+	appTelemetryPayload_WriteChars(writerPtr, &digits[pos], sizeof(digits) - pos);
+}
+/**
+ * @brief Write a decimal number with #APP_TELEMETRY_PAYLOAD_AGGREGATE_DECIMALS decimals, e.g. -12.345. Integer arithmetic after rounding.
+ * @param[in,out] writerPtr: the writer
+ * @param[in] value: the number
+ */
+static inline void appTelemetryPayload_WriteDecimal(AppTelemetryPayload_Writer_T * writerPtr, double value) {
+	appTelemetryPayload_WriteThousandths(writerPtr, appTelemetryPayload_GetThousandths(value));
+}
+/**
+ * @brief Encode a window in the aggregation mode into a caller provided buffer, with the names of the JSON format as configured previously.
+ * @details One object per window: the device id, the timestamp of the first sample, the offset of the last sample in milliseconds
+ * and the number of samples, followed by an object with the selected statistics per selected sensor channel, e.g.
+ * {"id":"xdk","ts":"2019-07-26T10:00:00.000Z","dt":9900,"n":100,"h":{"min":40,"max":42,"avg":41.230,"sd":0.512}}
+ * The quantiles are written for the accelerometer and gyroscope channels only, a channel without any selected statistic or without values in the window is omitted.
+ * The count is the number of samples, a channel of a sensor read at a longer period has fewer values.
+ * Mean and standard deviation are written with #APP_TELEMETRY_PAYLOAD_AGGREGATE_DECIMALS decimals, the standard deviation is the sample standard deviation.
+ * The statistics of the temperature are in degrees celsius, as its samples.
+ * 'V1 JSON Verbose' uses its names, the other JSON formats the compact names.
+ * @param[in] aggregatePtr: the window, at least 1 sample
+ * @param[out] bufferPtr: the buffer, receives the payload followed by a terminating 0
+ * @param[in] bufferSize: the size of the buffer
+ * @param[out] lengthPtr: the length of the payload, without the terminating 0
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_PAYLOAD_UNSUPPORTED_FORMAT) - a binary format
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL)
+ */
+Retcode_T AppTelemetryPayload_EncodeAggregate(const AppTelemetryPayload_Aggregate_T * aggregatePtr, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr) {
+
+	assert(aggregatePtr);
+	assert(aggregatePtr->numberOfSamples > 0);
+	assert(bufferPtr);
+	assert(lengthPtr);
+
+	if(AppTelemetryPayload_IsBinaryFormat()) return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_PAYLOAD_UNSUPPORTED_FORMAT);
+
+	const AppRuntimeConfig_Sensors_T * sensorsPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+	const AppRuntimeConfig_Aggregates_T * aggregatesPtr = &appTelemetryPayload_Aggregates;
+
+	bool isVerbose = (AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose == appTelemetryPayload_PayloadFormat);
+	const char * const * names = isVerbose ? appTelemetryPayload_Names_V1_Json_Verbose : appTelemetryPayload_Names_V1_Json_Compact;
+	const char * const * aggregateNames = isVerbose ? appTelemetryPayload_AggregateNames_Verbose : appTelemetryPayload_AggregateNames_Compact;
+
+	AppTelemetryPayload_Writer_T writer = { .bufferPtr = bufferPtr, .bufferSize = bufferSize, .length = 0, .isOverflow = false };
+	AppTelemetryPayload_Writer_T * writerPtr = &writer;
+
+	appTelemetryPayload_WriteChar(writerPtr, '{');
+
+	appTelemetryPayload_WriteName(writerPtr, names[AppTelemetryPayload_Name_DeviceId]);
+	appTelemetryPayload_WriteChars(writerPtr, appTelemetryPayload_DeviceIdJsonStr, appTelemetryPayload_DeviceIdJsonLength);
+
+	appTelemetryPayload_WriteChar(writerPtr, ',');
+	if(appTelemetryPayload_WriteTimestampMember(writerPtr, names[AppTelemetryPayload_Name_Timestamp], aggregatePtr->firstTickCount)) appTelemetryPayload_WriteChar(writerPtr, ',');
+
+	appTelemetryPayload_WriteName(writerPtr, aggregateNames[AppTelemetryPayload_AggregateName_Duration]);
+	appTelemetryPayload_WriteNumber(writerPtr, appTelemetryPayload_GetOffsetMillis(aggregatePtr->firstTickCount, aggregatePtr->lastTickCount));
+
+	if(aggregatesPtr->isCount) {
+		appTelemetryPayload_WriteChar(writerPtr, ',');
+		appTelemetryPayload_WriteName(writerPtr, aggregateNames[AppTelemetryPayload_AggregateName_Count]);
+		appTelemetryPayload_WriteNumber(writerPtr, (int32_t) aggregatePtr->numberOfSamples);
+	}
+
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_Humidity; name < AppTelemetryPayload_Name_NumberOf && !writerPtr->isOverflow; name++) {
+
+		const AppTelemetryPayload_ChannelAggregate_T * channelPtr = &aggregatePtr->channels[name - AppTelemetryPayload_Name_Humidity];
+
+		if(!appTelemetryPayload_IsChannelSelected(sensorsPtr, name) || !appTelemetryPayload_IsChannelAggregate(name) || 0 == channelPtr->numberOfValues) continue;
+
+		char separator = '{';
+
+		appTelemetryPayload_WriteChar(writerPtr, ',');
+		appTelemetryPayload_WriteName(writerPtr, names[name]);
+
+		if(aggregatesPtr->isMin) {
+			appTelemetryPayload_WriteChar(writerPtr, separator);
+			appTelemetryPayload_WriteName(writerPtr, aggregateNames[AppTelemetryPayload_AggregateName_Min]);
+			appTelemetryPayload_WriteValue_Json(writerPtr, name, channelPtr->min);
+			separator = ',';
+		}
+		if(aggregatesPtr->isMax) {
+			appTelemetryPayload_WriteChar(writerPtr, separator);
+			appTelemetryPayload_WriteName(writerPtr, aggregateNames[AppTelemetryPayload_AggregateName_Max]);
+			appTelemetryPayload_WriteValue_Json(writerPtr, name, channelPtr->max);
+			separator = ',';
+		}
+		if(aggregatesPtr->isMean) {
+			appTelemetryPayload_WriteChar(writerPtr, separator);
+			appTelemetryPayload_WriteName(writerPtr, aggregateNames[AppTelemetryPayload_AggregateName_Mean]);
+			appTelemetryPayload_WriteDecimal(writerPtr, channelPtr->mean / appTelemetryPayload_GetUnit_Json(name));
+			separator = ',';
+		}
+		if(aggregatesPtr->isStddev) {
+			appTelemetryPayload_WriteChar(writerPtr, separator);
+			appTelemetryPayload_WriteName(writerPtr, aggregateNames[AppTelemetryPayload_AggregateName_Stddev]);
+			appTelemetryPayload_WriteDecimal(writerPtr, appTelemetryPayload_GetStddev(channelPtr) / appTelemetryPayload_GetUnit_Json(name));
+			separator = ',';
+		}
+		for(uint32_t quantile = 0; quantile < APP_TELEMETRY_PAYLOAD_NUMBER_OF_QUANTILES && appTelemetryPayload_IsSketchChannel(name); quantile++) {
+			if(!appTelemetryPayload_IsQuantileSelected(quantile)) continue;
+			appTelemetryPayload_WriteChar(writerPtr, separator);
+			appTelemetryPayload_WriteName(writerPtr, aggregateNames[AppTelemetryPayload_AggregateName_P50 + quantile]);
+			appTelemetryPayload_WriteNumber(writerPtr, aggregatePtr->quantiles[name - AppTelemetryPayload_Name_AccelX][quantile]);
+			separator = ',';
+		}
+		appTelemetryPayload_WriteChar(writerPtr, '}');
+	}
+
+	appTelemetryPayload_WriteChar(writerPtr, '}');
+
+	if(writer.isOverflow) {
+		*lengthPtr = 0;
+		if(bufferSize > 0) bufferPtr[0] = '\0';
+		return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL);
+	}
+
+	bufferPtr[writer.length] = '\0';
+	*lengthPtr = writer.length;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Write a member with a number value: "name":value
+ * @param[in,out] writerPtr: the writer
+ * @param[in] name: the member name, must not need escaping
+ * @param[in] value: the number
+ */
+static inline void appTelemetryPayload_WriteNumberMember(AppTelemetryPayload_Writer_T * writerPtr, const char * name, int32_t value) {
+	appTelemetryPayload_WriteName(writerPtr, name);
+	appTelemetryPayload_WriteNumber(writerPtr, value);
+}
+/**
+ * @brief Encode the next chunk of a capture window into a caller provided buffer, with as many samples as fit.
+ * @details A chunk is a JSON object, the capture windows are sent as JSON in all payload formats:
+ * the device id, the timestamp of the trigger sample, the sample period, the number of samples and pre-trigger samples of the window,
+ * the index of the first sample of the chunk in the window and one array per accelerometer axis.
+ * The receiver reassembles a window from the chunks with the same device id and timestamp.
+ * 'V1 JSON Verbose' uses its names, the other formats the compact names.
+ * @param[in] capturePtr: the window
+ * @param[in] firstSampleIndex: index of the first sample of the chunk, < capturePtr->numberOfSamples
+ * @param[out] bufferPtr: the buffer, receives the payload followed by a terminating 0
+ * @param[in] bufferSize: the size of the buffer
+ * @param[out] lengthPtr: the length of the payload, without the terminating 0
+ * @param[out] numberOfSamplesPtr: the number of samples in the chunk
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL) - not even one sample fits
+ */
+Retcode_T AppTelemetryPayload_EncodeCaptureChunk(const AppTelemetryPayload_Capture_T * capturePtr, uint32_t firstSampleIndex, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr, uint32_t * numberOfSamplesPtr) {
+
+	assert(capturePtr);
+	assert(capturePtr->samplesPtr);
+	assert(firstSampleIndex < capturePtr->numberOfSamples);
+	assert(bufferPtr);
+	assert(lengthPtr);
+	assert(numberOfSamplesPtr);
+
+	bool isVerbose = (AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose == appTelemetryPayload_PayloadFormat);
+	const char * const * names = isVerbose ? appTelemetryPayload_Names_V1_Json_Verbose : appTelemetryPayload_Names_V1_Json_Compact;
+	const char * const * captureNames = isVerbose ? appTelemetryPayload_CaptureNames_Verbose : appTelemetryPayload_CaptureNames_Compact;
+
+	AppTelemetryPayload_Writer_T writer = { .bufferPtr = bufferPtr, .bufferSize = bufferSize, .length = 0, .isOverflow = false };
+	AppTelemetryPayload_Writer_T * writerPtr = &writer;
+
+	appTelemetryPayload_WriteChar(writerPtr, '{');
+
+	appTelemetryPayload_WriteName(writerPtr, names[AppTelemetryPayload_Name_DeviceId]);
+	appTelemetryPayload_WriteChars(writerPtr, appTelemetryPayload_DeviceIdJsonStr, appTelemetryPayload_DeviceIdJsonLength);
+
+	appTelemetryPayload_WriteChar(writerPtr, ',');
+	if(appTelemetryPayload_WriteTimestampMember(writerPtr, names[AppTelemetryPayload_Name_Timestamp], capturePtr->triggerTickCount)) appTelemetryPayload_WriteChar(writerPtr, ',');
+
+	appTelemetryPayload_WriteNumberMember(writerPtr, captureNames[AppTelemetryPayload_CaptureName_SamplingPeriod], (int32_t) capturePtr->samplingPeriodMillis);
+	appTelemetryPayload_WriteChar(writerPtr, ',');
+	appTelemetryPayload_WriteNumberMember(writerPtr, captureNames[AppTelemetryPayload_CaptureName_NumberOfSamples], (int32_t) capturePtr->numberOfSamples);
+	appTelemetryPayload_WriteChar(writerPtr, ',');
+	appTelemetryPayload_WriteNumberMember(writerPtr, captureNames[AppTelemetryPayload_CaptureName_NumberOfPreTriggerSamples], (int32_t) capturePtr->numberOfPreTriggerSamples);
+	appTelemetryPayload_WriteChar(writerPtr, ',');
+	appTelemetryPayload_WriteNumberMember(writerPtr, captureNames[AppTelemetryPayload_CaptureName_FirstIndex], (int32_t) firstSampleIndex);
+
+	// fit the samples into what is left after the arrays: ,"name":[] per axis and the closing brace, keeping room for the terminating 0
+	uint32_t available = 0;
+	uint32_t overhead = 1 + 1;
+	for(uint32_t axis = 0; axis < 3; axis++) overhead += 1 + appTelemetryPayload_GetMemberLength(names[AppTelemetryPayload_Name_AccelX + axis], 2);
+	if(!writer.isOverflow && writer.length + overhead <= bufferSize) available = bufferSize - writer.length - overhead;
+
+	uint32_t numberOfSamples = 0;
+	for(uint32_t i = firstSampleIndex; i < capturePtr->numberOfSamples; i++) {
+		const AppTelemetryPayload_CaptureSample_T * samplePtr = &capturePtr->samplesPtr[i];
+		uint32_t sampleLength = (numberOfSamples > 0) ? 3 : 0;
+		for(uint32_t axis = 0; axis < 3; axis++) sampleLength += appTelemetryPayload_GetNumberLength(samplePtr->accel[axis]);
+		if(sampleLength > available) break;
+		available -= sampleLength;
+		numberOfSamples++;
+	}
+
+	for(uint32_t axis = 0; axis < 3 && numberOfSamples > 0; axis++) {
+		appTelemetryPayload_WriteChar(writerPtr, ',');
+		appTelemetryPayload_WriteName(writerPtr, names[AppTelemetryPayload_Name_AccelX + axis]);
+		appTelemetryPayload_WriteChar(writerPtr, '[');
+		for(uint32_t i = 0; i < numberOfSamples; i++) {
+			if(i > 0) appTelemetryPayload_WriteChar(writerPtr, ',');
+			appTelemetryPayload_WriteNumber(writerPtr, capturePtr->samplesPtr[firstSampleIndex + i].accel[axis]);
+		}
+		appTelemetryPayload_WriteChar(writerPtr, ']');
+	}
+
+	appTelemetryPayload_WriteChar(writerPtr, '}');
+
+	if(writer.isOverflow || numberOfSamples == 0) {
+		*lengthPtr = 0;
+		*numberOfSamplesPtr = 0;
+		if(bufferSize > 0) bufferPtr[0] = '\0';
+		return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL);
+	}
+
+	bufferPtr[writer.length] = '\0';
+	*lengthPtr = writer.length;
+	*numberOfSamplesPtr = numberOfSamples;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Encode the vibration spectrum features of an accelerometer window into a caller provided buffer.
+ * @details A JSON object, the features are sent as JSON in all payload formats:
+ * the device id, the timestamp of the first sample, the sample period, the number of samples, the frequency resolution in Hz
+ * and an object per accelerometer axis with the RMS and the crest factor of the values without their mean and the peaks as [frequency in Hz, amplitude] pairs, highest first, e.g.
+ * {"id":"xdk","ts":"2019-07-26T10:00:00.000Z","dt":10,"n":256,"df":0.390,"aX":{"rms":28.967,"cf":1.657,"pk":[[12.500,40.156],[31.250,8.157]]},"aY":{..},"aZ":{..}}
+ * The RMS and the amplitudes are in milli g, all decimals with #APP_TELEMETRY_PAYLOAD_AGGREGATE_DECIMALS decimals.
+ * 'V1 JSON Verbose' uses its names, the other formats the compact names.
+ * @param[in] spectrumPtr: the features of the window
+ * @param[out] bufferPtr: the buffer, receives the payload followed by a terminating 0
+ * @param[in] bufferSize: the size of the buffer
+ * @param[out] lengthPtr: the length of the payload, without the terminating 0
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL)
+ */
+Retcode_T AppTelemetryPayload_EncodeSpectrum(const AppTelemetryPayload_Spectrum_T * spectrumPtr, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr) {
+
+	assert(spectrumPtr);
+	assert(spectrumPtr->numberOfSamples > 0);
+	assert(spectrumPtr->samplingPeriodMillis > 0);
+	assert(bufferPtr);
+	assert(lengthPtr);
+
+	bool isVerbose = (AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose == appTelemetryPayload_PayloadFormat);
+	const char * const * names = isVerbose ? appTelemetryPayload_Names_V1_Json_Verbose : appTelemetryPayload_Names_V1_Json_Compact;
+	const char * const * spectrumNames = isVerbose ? appTelemetryPayload_SpectrumNames_Verbose : appTelemetryPayload_SpectrumNames_Compact;
+
+	AppTelemetryPayload_Writer_T writer = { .bufferPtr = bufferPtr, .bufferSize = bufferSize, .length = 0, .isOverflow = false };
+	AppTelemetryPayload_Writer_T * writerPtr = &writer;
+
+	appTelemetryPayload_WriteChar(writerPtr, '{');
+
+	appTelemetryPayload_WriteName(writerPtr, names[AppTelemetryPayload_Name_DeviceId]);
+	appTelemetryPayload_WriteChars(writerPtr, appTelemetryPayload_DeviceIdJsonStr, appTelemetryPayload_DeviceIdJsonLength);
+
+	appTelemetryPayload_WriteChar(writerPtr, ',');
+	if(appTelemetryPayload_WriteTimestampMember(writerPtr, names[AppTelemetryPayload_Name_Timestamp], spectrumPtr->firstTickCount)) appTelemetryPayload_WriteChar(writerPtr, ',');
+
+	appTelemetryPayload_WriteNumberMember(writerPtr, spectrumNames[AppTelemetryPayload_SpectrumName_SamplingPeriod], (int32_t) spectrumPtr->samplingPeriodMillis);
+	appTelemetryPayload_WriteChar(writerPtr, ',');
+	appTelemetryPayload_WriteNumberMember(writerPtr, spectrumNames[AppTelemetryPayload_SpectrumName_NumberOfSamples], (int32_t) spectrumPtr->numberOfSamples);
+	appTelemetryPayload_WriteChar(writerPtr, ',');
+	appTelemetryPayload_WriteName(writerPtr, spectrumNames[AppTelemetryPayload_SpectrumName_Resolution]);
+	// milli Hz = 1000 * 1000 / (N * period in millis)
+	appTelemetryPayload_WriteThousandths(writerPtr, (int64_t) (UINT64_C(1000000) / ((uint64_t) spectrumPtr->numberOfSamples * spectrumPtr->samplingPeriodMillis)));
+
+	for(uint32_t axis = 0; axis < APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES && !writerPtr->isOverflow; axis++) {
+
+		const AppTelemetrySpectrum_AxisFeatures_T * axisPtr = &spectrumPtr->features.axes[axis];
+
+		appTelemetryPayload_WriteChar(writerPtr, ',');
+		appTelemetryPayload_WriteName(writerPtr, names[AppTelemetryPayload_Name_AccelX + axis]);
+		appTelemetryPayload_WriteChar(writerPtr, '{');
+		appTelemetryPayload_WriteName(writerPtr, spectrumNames[AppTelemetryPayload_SpectrumName_Rms]);
+		appTelemetryPayload_WriteThousandths(writerPtr, axisPtr->rmsThousandths);
+		appTelemetryPayload_WriteChar(writerPtr, ',');
+		appTelemetryPayload_WriteName(writerPtr, spectrumNames[AppTelemetryPayload_SpectrumName_CrestFactor]);
+		appTelemetryPayload_WriteThousandths(writerPtr, axisPtr->crestFactorThousandths);
+		appTelemetryPayload_WriteChar(writerPtr, ',');
+		appTelemetryPayload_WriteName(writerPtr, spectrumNames[AppTelemetryPayload_SpectrumName_Peaks]);
+		appTelemetryPayload_WriteChar(writerPtr, '[');
+		for(uint32_t i = 0; i < axisPtr->numberOfPeaks; i++) {
+			if(i > 0) appTelemetryPayload_WriteChar(writerPtr, ',');
+			appTelemetryPayload_WriteChar(writerPtr, '[');
+			appTelemetryPayload_WriteThousandths(writerPtr, axisPtr->peaks[i].frequencyMilliHz);
+			appTelemetryPayload_WriteChar(writerPtr, ',');
+			appTelemetryPayload_WriteThousandths(writerPtr, axisPtr->peaks[i].amplitudeThousandths);
+			appTelemetryPayload_WriteChar(writerPtr, ']');
+		}
+		appTelemetryPayload_WriteChars(writerPtr, "]}", 2);
+	}
+
+	appTelemetryPayload_WriteChar(writerPtr, '}');
+
+	if(writer.isOverflow) {
+		*lengthPtr = 0;
+		if(bufferSize > 0) bufferPtr[0] = '\0';
+		return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL);
+	}
+
+	bufferPtr[writer.length] = '\0';
+	*lengthPtr = writer.length;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Returns the value of an orientation output for one of its arrays.
+ * @param[in] orientationPtr: the output
+ * @param[in] firstTickCount: tick count of the first output of the event
+ * @param[in] name: the array
+ * @return int64_t: the offset in milliseconds for #AppTelemetryPayload_OrientationName_Offsets, otherwise thousandths of the quaternion component or of the angle in degrees
+ */
+static int64_t appTelemetryPayload_GetOrientationValue(const AppTelemetryPayload_Orientation_T * orientationPtr, TickType_t firstTickCount, AppTelemetryPayload_OrientationName_T name) {
+
+	if(AppTelemetryPayload_OrientationName_Offsets == name) return appTelemetryPayload_GetOffsetMillis(firstTickCount, orientationPtr->tickCount);
+
+	if(name >= AppTelemetryPayload_OrientationName_Roll) return orientationPtr->eulerMilliDeg[name - AppTelemetryPayload_OrientationName_Roll];
+
+	// Q30 to thousandths, rounded half away from zero
+	int64_t scaled = (int64_t) orientationPtr->quaternion[name - AppTelemetryPayload_OrientationName_QuaternionW] * 1000;
+	return (scaled + ((scaled < 0) ? -(INT64_C(1) << 29) : (INT64_C(1) << 29))) / (INT64_C(1) << 30);
+}
+/**
+ * @brief Encode orientation outputs of the sensor fusion into a caller provided buffer, with as many outputs as fit.
+ * @details A JSON object, the orientations are sent as JSON in all payload formats:
+ * the device id, the timestamp of the first output, the offsets of the outputs in milliseconds and one array per quaternion component,
+ * followed by one array per Euler angle in degrees if fusionEulerAngles is configured, e.g.
+ * {"id":"xdk","ts":"2019-07-26T10:00:00.000Z","dt":[0,100],"qw":[0.998,0.998],"qx":[0.052,0.053],"qy":[-0.026,-0.026],"qz":[0.000,0.001],"roll":[6.021,6.102],"pitch":[-2.947,-2.951],"yaw":[0.157,0.172]}
+ * The quaternion components and the angles are written with #APP_TELEMETRY_PAYLOAD_AGGREGATE_DECIMALS decimals.
+ * 'V1 JSON Verbose' uses its names, the other formats the compact names.
+ * @param[in] orientationsPtr: the outputs, oldest first
+ * @param[in] numberOfOrientations: the number of outputs, at least 1
+ * @param[out] bufferPtr: the buffer, receives the payload followed by a terminating 0
+ * @param[in] bufferSize: the size of the buffer
+ * @param[out] lengthPtr: the length of the payload, without the terminating 0
+ * @param[out] numberEncodedPtr: the number of outputs in the payload, the oldest ones
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL) - not even one output fits
+ */
+Retcode_T AppTelemetryPayload_EncodeOrientations(const AppTelemetryPayload_Orientation_T * orientationsPtr, uint32_t numberOfOrientations, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr, uint32_t * numberEncodedPtr) {
+
+	assert(orientationsPtr);
+	assert(numberOfOrientations > 0);
+	assert(bufferPtr);
+	assert(lengthPtr);
+	assert(numberEncodedPtr);
+
+	bool isVerbose = (AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose == appTelemetryPayload_PayloadFormat);
+	const char * const * names = isVerbose ? appTelemetryPayload_Names_V1_Json_Verbose : appTelemetryPayload_Names_V1_Json_Compact;
+	const char * const * orientationNames = isVerbose ? appTelemetryPayload_OrientationNames_Verbose : appTelemetryPayload_OrientationNames_Compact;
+	uint32_t numberOfArrays = appTelemetryPayload_IsFusionEulerAngles ? AppTelemetryPayload_OrientationName_NumberOf : AppTelemetryPayload_OrientationName_Roll;
+	TickType_t firstTickCount = orientationsPtr[0].tickCount;
+
+	AppTelemetryPayload_Writer_T writer = { .bufferPtr = bufferPtr, .bufferSize = bufferSize, .length = 0, .isOverflow = false };
+	AppTelemetryPayload_Writer_T * writerPtr = &writer;
+
+	appTelemetryPayload_WriteChar(writerPtr, '{');
+
+	appTelemetryPayload_WriteName(writerPtr, names[AppTelemetryPayload_Name_DeviceId]);
+	appTelemetryPayload_WriteChars(writerPtr, appTelemetryPayload_DeviceIdJsonStr, appTelemetryPayload_DeviceIdJsonLength);
+
+	appTelemetryPayload_WriteChar(writerPtr, ',');
+	if(appTelemetryPayload_WriteTimestampMember(writerPtr, names[AppTelemetryPayload_Name_Timestamp], firstTickCount)) appTelemetryPayload_WriteChar(writerPtr, ',');
+
+	// fit the outputs into what is left after the arrays: "name":[] per array, the commas between them and the closing brace, keeping room for the terminating 0
+	uint32_t available = 0;
+	uint32_t overhead = (numberOfArrays - 1) + 1 + 1;
+	for(uint32_t name = 0; name < numberOfArrays; name++) overhead += appTelemetryPayload_GetMemberLength(orientationNames[name], 2);
+	if(!writer.isOverflow && writer.length + overhead <= bufferSize) available = bufferSize - writer.length - overhead;
+
+	uint32_t numberEncoded = 0;
+	for(uint32_t i = 0; i < numberOfOrientations; i++) {
+		uint32_t orientationLength = (numberEncoded > 0) ? numberOfArrays : 0;
+		for(uint32_t name = 0; name < numberOfArrays; name++) {
+			int64_t value = appTelemetryPayload_GetOrientationValue(&orientationsPtr[i], firstTickCount, (AppTelemetryPayload_OrientationName_T) name);
+			orientationLength += (AppTelemetryPayload_OrientationName_Offsets == name) ? appTelemetryPayload_GetNumberLength((int32_t) value) : appTelemetryPayload_GetThousandthsLength(value);
+		}
+		if(orientationLength > available) break;
+		available -= orientationLength;
+		numberEncoded++;
+	}
+
+	for(uint32_t name = 0; name < numberOfArrays && numberEncoded > 0; name++) {
+		if(name > 0) appTelemetryPayload_WriteChar(writerPtr, ',');
+		appTelemetryPayload_WriteName(writerPtr, orientationNames[name]);
+		appTelemetryPayload_WriteChar(writerPtr, '[');
+		for(uint32_t i = 0; i < numberEncoded; i++) {
+			if(i > 0) appTelemetryPayload_WriteChar(writerPtr, ',');
+			int64_t value = appTelemetryPayload_GetOrientationValue(&orientationsPtr[i], firstTickCount, (AppTelemetryPayload_OrientationName_T) name);
+			if(AppTelemetryPayload_OrientationName_Offsets == name) appTelemetryPayload_WriteNumber(writerPtr, (int32_t) value);
+			else appTelemetryPayload_WriteThousandths(writerPtr, value);
+		}
+		appTelemetryPayload_WriteChar(writerPtr, ']');
+	}
+
+	appTelemetryPayload_WriteChar(writerPtr, '}');
+
+	if(writer.isOverflow || numberEncoded == 0) {
+		*lengthPtr = 0;
+		*numberEncodedPtr = 0;
+		if(bufferSize > 0) bufferPtr[0] = '\0';
+		return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL);
+	}
+
+	bufferPtr[writer.length] = '\0';
+	*lengthPtr = writer.length;
+	*numberEncodedPtr = numberEncoded;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Returns the size of a window of a single sample based on a new configuration. Used to test whether a new configuration of the aggregation mode is valid. Leaves module's configuration intact.
+ * @details Calculated with ISO 8601 timestamps, an upper bound for both timestamp formats. Windows of more samples may be longer by the digits of the count, the standard deviation and the quantiles.
+ * @param[in] tickCount: the current tick count
+ * @param[in] sensorValuePtr: the sensor values
+ * @param[in] sensorsConfigPtr: the new sensor configuration to be tested
+ * @param[in] aggregatesConfigPtr: the new selection of statistics to be tested
+ * @param[in] payloadFormat: the payload format to be tested
+ * @return uint32_t: the size in bytes
+ * @see AppTelemetryPayload_GetAggregateSize()
+ */
+uint32_t AppTelemetryPayload_GetAggregateSize_Test(
+		const TickType_t tickCount,
+		const Sensor_Value_T * sensorValuePtr,
+		const AppRuntimeConfig_Sensors_T * sensorsConfigPtr,
+		const AppRuntimeConfig_Aggregates_T * aggregatesConfigPtr,
+		AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat) {
+
+	// remember old values
+	AppRuntimeConfig_Sensors_T * orgSensorsConfigPtr = appTelemetryPayload_TargetTelemetrySensorsPtr;
+	AppRuntimeConfig_Aggregates_T orgAggregates = appTelemetryPayload_Aggregates;
+	AppRuntimeConfig_Telemetry_PayloadFormat_T orgPayloadFormat = appTelemetryPayload_PayloadFormat;
+	AppRuntimeConfig_Telemetry_TimestampFormat_T orgTimestampFormat = appTelemetryPayload_TimestampFormat;
+
+	appTelemetryPayload_TargetTelemetrySensorsPtr = (AppRuntimeConfig_Sensors_T *) sensorsConfigPtr;
+	appTelemetryPayload_Aggregates = *aggregatesConfigPtr;
+	appTelemetryPayload_PayloadFormat = payloadFormat;
+	// the longer of the timestamp formats
+	appTelemetryPayload_TimestampFormat = AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601;
+
+	AppTelemetryPayload_Sample_T sample;
+	AppTelemetryPayload_PopulateSample(&sample, tickCount, sensorValuePtr, APP_TELEMETRY_PAYLOAD_SENSOR_ALL);
+
+	AppTelemetryPayload_Aggregate_T aggregate;
+	AppTelemetryPayload_ResetAggregate(&aggregate);
+	AppTelemetryPayload_AddSampleToAggregate(&aggregate, &sample);
+	// the quantiles of a single sample are its values
+	for(AppTelemetryPayload_Name_T name = AppTelemetryPayload_Name_AccelX; name <= AppTelemetryPayload_Name_GyroZ; name++) {
+		for(uint32_t quantile = 0; quantile < APP_TELEMETRY_PAYLOAD_NUMBER_OF_QUANTILES; quantile++) {
+			aggregate.quantiles[name - AppTelemetryPayload_Name_AccelX][quantile] = appTelemetryPayload_GetChannelValue(&sample, name);
+		}
+	}
+
+	uint32_t size = AppTelemetryPayload_GetAggregateSize(&aggregate);
+
+	// restore original values
+	appTelemetryPayload_TargetTelemetrySensorsPtr = orgSensorsConfigPtr;
+	appTelemetryPayload_Aggregates = orgAggregates;
+	appTelemetryPayload_PayloadFormat = orgPayloadFormat;
+	appTelemetryPayload_TimestampFormat = orgTimestampFormat;
+
+	return size;
+}
+/**
+ * @brief Add the timestamp of a sample to a cJSON object in the timestamp format as configured previously. Nothing is added if @ref AppTimestamp is not enabled yet.
+ * @param[in] objectJsonHandle: the object
+ * @param[in] name: the member name
+ * @param[in] tickCount: the tick count of the sample
+ */
+static void appTelemetryPayload_AddTimestampToObject(cJSON * objectJsonHandle, const char * name, TickType_t tickCount) {
+
+	AppTimestamp_T timestamp = AppTimestamp_GetTimestamp(tickCount);
+
+	if(AppRuntimeConfig_Telemetry_TimestampFormat_EpochMillis == appTelemetryPayload_TimestampFormat) {
+		uint64_t millisSinceEpoch = 0;
+		if(AppTimestamp_GetMillisSinceEpoch(timestamp, &millisSinceEpoch)) cJSON_AddNumberToObject(objectJsonHandle, name, (double) millisSinceEpoch);
+	} else {
+		char timestampStr[APP_TIMESTAMP_STRING_LENGTH + 1];
+		if(AppTimestamp_FormatTimestampStr(timestamp, timestampStr)) cJSON_AddItemToObject(objectJsonHandle, name, cJSON_CreateString(timestampStr));
+	}
+}
+/**
+ * @brief Create a 'V1 JSON Verbose' payload.
+ * @param[in] samplePtr: the sample record. Its tick count is converted to a timestamp using @ref AppTimestamp.
+ * @return AppTelemetryPayload_T *: the created payload
+ */
+static AppTelemetryPayload_T * appTelemetryPayload_CreateNew_V1_Json_Verbose(const AppTelemetryPayload_Sample_T * samplePtr) {
+
+	cJSON *sampleJSON = cJSON_CreateObject();
+
+	appTelemetryPayload_AddTimestampToObject(sampleJSON, "timestamp", samplePtr->tickCount);
+
+	cJSON_AddItemToObject(sampleJSON, "deviceId", cJSON_CreateString(appTelemetryPayload_DeviceId));
+
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isHumidity && !appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_Humidity)) cJSON_AddNumberToObject(sampleJSON, "humidity", (long int ) samplePtr->humidity);
+
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isLight && !appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_Light)) cJSON_AddNumberToObject(sampleJSON, "light", (long int ) samplePtr->light);
+
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isTemperature && !appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_Temperature)) cJSON_AddNumberToObject(sampleJSON, "temperature", (samplePtr->temperature / 1000.0));
+
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isAccelerator) {
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_AccelX)) cJSON_AddNumberToObject(sampleJSON, "acceleratorX", samplePtr->accel[0]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_AccelY)) cJSON_AddNumberToObject(sampleJSON, "acceleratorY", samplePtr->accel[1]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_AccelZ)) cJSON_AddNumberToObject(sampleJSON, "acceleratorZ", samplePtr->accel[2]);
+	}
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isGyro) {
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_GyroX)) cJSON_AddNumberToObject(sampleJSON, "gyroX", samplePtr->gyro[0]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_GyroY)) cJSON_AddNumberToObject(sampleJSON, "gyroY", samplePtr->gyro[1]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_GyroZ)) cJSON_AddNumberToObject(sampleJSON, "gyroZ", samplePtr->gyro[2]);
+	}
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isMagneto) {
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_MagR)) cJSON_AddNumberToObject(sampleJSON, "magR", samplePtr->mag[0]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_MagX)) cJSON_AddNumberToObject(sampleJSON, "magX", samplePtr->mag[1]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_MagY)) cJSON_AddNumberToObject(sampleJSON, "magY", samplePtr->mag[2]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_MagZ)) cJSON_AddNumberToObject(sampleJSON, "magZ", samplePtr->mag[3]);
+	}
+
+	return (AppTelemetryPayload_T *) sampleJSON;
+}
+/**
+ * @brief Create a 'V1 JSON Compact' payload.
+ * @param[in] samplePtr: the sample record. Its tick count is converted to a timestamp using @ref AppTimestamp.
+ * @return AppTelemetryPayload_T *: the created payload
+ */
+static AppTelemetryPayload_T * appTelemetryPayload_CreateNew_V1_Json_Compact(const AppTelemetryPayload_Sample_T * samplePtr) {
+
+	cJSON *sampleJSON = cJSON_CreateObject();
+
+	appTelemetryPayload_AddTimestampToObject(sampleJSON, "ts", samplePtr->tickCount);
+
+	cJSON_AddItemToObject(sampleJSON, "id", cJSON_CreateString(appTelemetryPayload_DeviceId));
+
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isHumidity && !appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_Humidity)) cJSON_AddNumberToObject(sampleJSON, "h", (long int ) samplePtr->humidity);
+
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isLight && !appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_Light)) cJSON_AddNumberToObject(sampleJSON, "l", (long int ) samplePtr->light);
+
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isTemperature && !appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_Temperature)) cJSON_AddNumberToObject(sampleJSON, "t", (samplePtr->temperature / 1000.0));
+
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isAccelerator) {
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_AccelX)) cJSON_AddNumberToObject(sampleJSON, "aX", samplePtr->accel[0]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_AccelY)) cJSON_AddNumberToObject(sampleJSON, "aY", samplePtr->accel[1]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_AccelZ)) cJSON_AddNumberToObject(sampleJSON, "aZ", samplePtr->accel[2]);
+	}
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isGyro) {
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_GyroX)) cJSON_AddNumberToObject(sampleJSON, "gX", samplePtr->gyro[0]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_GyroY)) cJSON_AddNumberToObject(sampleJSON, "gY", samplePtr->gyro[1]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_GyroZ)) cJSON_AddNumberToObject(sampleJSON, "gZ", samplePtr->gyro[2]);
+	}
+	if (appTelemetryPayload_TargetTelemetrySensorsPtr->isMagneto) {
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_MagR)) cJSON_AddNumberToObject(sampleJSON, "mR", samplePtr->mag[0]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_MagX)) cJSON_AddNumberToObject(sampleJSON, "mX", samplePtr->mag[1]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_MagY)) cJSON_AddNumberToObject(sampleJSON, "mY", samplePtr->mag[2]);
+		if(!appTelemetryPayload_IsChannelOmitted(samplePtr, AppTelemetryPayload_Name_MagZ)) cJSON_AddNumberToObject(sampleJSON, "mZ", samplePtr->mag[3]);
+	}
+
+	return (AppTelemetryPayload_T *) sampleJSON;
+}
+/**
+ * @brief Create the quoted JSON string of str, escaped as cJSON prints strings.
+ * @param[in] str: the string
+ * @return char *: the JSON string, free after use
+ */
+static char * appTelemetryPayload_CreateJsonStr(const char * str) {
+
+	assert(str);
+
+	// worst case: every character escaped as \u00XX
+	char * jsonStr = (char *) malloc(strlen(str) * 6 + 3);
+	if(NULL == jsonStr) return NULL;
+
+	char * outPtr = jsonStr;
+	*outPtr++ = '"';
+
+	for(const char * inPtr = str; *inPtr != '\0'; inPtr++) {
+		unsigned char c = (unsigned char) *inPtr;
+		switch(c) {
+		case '"': *outPtr++ = '\\'; *outPtr++ = '"'; break;
+		case '\\': *outPtr++ = '\\'; *outPtr++ = '\\'; break;
+		case '\b': *outPtr++ = '\\'; *outPtr++ = 'b'; break;
+		case '\f': *outPtr++ = '\\'; *outPtr++ = 'f'; break;
+		case '\n': *outPtr++ = '\\'; *outPtr++ = 'n'; break;
+		case '\r': *outPtr++ = '\\'; *outPtr++ = 'r'; break;
+		case '\t': *outPtr++ = '\\'; *outPtr++ = 't'; break;
+		default:
+			if(c < 32) outPtr += sprintf(outPtr, "\\u%04x", c);
+			else *outPtr++ = (char) c;
+			break;
+		}
+	}
+	*outPtr++ = '"';
+	*outPtr = '\0';
+
+	return jsonStr;
 }
 /**
  * @brief Delete a payload.
@@ -17,6 +17,8 @@
 
 #include "AppRuntimeConfig.h"
 #include "AppTimestamp.h"
+#include "AppTelemetrySketch.h"
+#include "AppTelemetrySpectrum.h"
 
 #include "XDK_Sensor.h"
 
@@ -25,18 +27,173 @@
  */
 typedef cJSON AppTelemetryPayload_T;
 
+#define APP_TELEMETRY_PAYLOAD_SENSOR_HUMIDITY		UINT8_C(0x01) /**< presence bit of the humidity sensor */
+#define APP_TELEMETRY_PAYLOAD_SENSOR_LIGHT			UINT8_C(0x02) /**< presence bit of the light sensor */
+#define APP_TELEMETRY_PAYLOAD_SENSOR_TEMPERATURE	UINT8_C(0x04) /**< presence bit of the temperature sensor */
+#define APP_TELEMETRY_PAYLOAD_SENSOR_ACCEL			UINT8_C(0x08) /**< presence bit of the accelerometer */
+#define APP_TELEMETRY_PAYLOAD_SENSOR_GYRO			UINT8_C(0x10) /**< presence bit of the gyroscope */
+#define APP_TELEMETRY_PAYLOAD_SENSOR_MAG			UINT8_C(0x20) /**< presence bit of the magnetometer */
+#define APP_TELEMETRY_PAYLOAD_SENSOR_ALL			UINT8_C(0x3F) /**< presence bits of all sensors */
+
+/**
+ * @brief Compact binary sample record. Holds the raw sensor readings used by the payload formats, stored in the @ref AppTelemetryQueue.
+ */
+typedef struct {
+	TickType_t tickCount; /**< tick count at the time the sample was taken */
+	uint32_t humidity; /**< relative humidity in % */
+	uint32_t light; /**< light in milli lux */
+	int32_t temperature; /**< temperature in milli degrees celsius */
+	int32_t accel[3]; /**< accelerometer x, y, z */
+	int32_t gyro[3]; /**< gyroscope x, y, z */
+	int32_t mag[4]; /**< magnetometer r, x, y, z */
+	uint16_t suppressedChannels; /**< bit per sensor channel, humidity = bit 0 .. magnetometer z = bit 12: the value is within its deadband and not sent, it holds the last sent value */
+	uint8_t presentSensors; /**< APP_TELEMETRY_PAYLOAD_SENSOR_* bits of the sensors read for this sample. The values of the other sensors hold their last reading and are not sent */
+} AppTelemetryPayload_Sample_T;
+/**
+ * @brief Tracks the encoded size of a batch while it is filled. See @ref AppTelemetryPayload_GetBatchSizeWithSample().
+ */
+typedef struct {
+	uint32_t numberOfSamples; /**< number of samples in the batch */
+	uint32_t size; /**< encoded size of the batch in bytes */
+	TickType_t firstTickCount; /**< tick count of the first sample */
+	AppTelemetryPayload_Sample_T lastSample; /**< the last sample added, the values are encoded as deltas to it */
+	int32_t lastOffsetDeltaMillis; /**< offset of the last sample to the one before in milliseconds, the timestamps are encoded as delta of deltas */
+} AppTelemetryPayload_BatchSize_T;
+
+#define APP_TELEMETRY_PAYLOAD_NUMBER_OF_CHANNELS		UINT32_C(13) /**< number of sensor channels: humidity, light, temperature, accelerometer x, y, z, gyroscope x, y, z, magnetometer r, x, y, z */
+#define APP_TELEMETRY_PAYLOAD_NUMBER_OF_SKETCH_CHANNELS	UINT32_C(6) /**< number of sensor channels with quantiles in the aggregation mode: accelerometer x, y, z, gyroscope x, y, z */
+#define APP_TELEMETRY_PAYLOAD_NUMBER_OF_QUANTILES		UINT32_C(3) /**< number of quantiles per channel: p50, p95, p99 */
+/**
+ * @brief Deadband filter state of a sensor channel.
+ */
+typedef struct {
+	int32_t lastValue; /**< the last sent value, as in the payload */
+	TickType_t lastTickCount; /**< tick count of the last sent value */
+} AppTelemetryPayload_DeadbandChannel_T;
+/**
+ * @brief State of the deadband filter (report by exception). See @ref AppTelemetryPayload_ApplyDeadband().
+ */
+typedef struct {
+	bool isValid; /**< false until the first sample, all of its values are sent */
+	AppTelemetryPayload_DeadbandChannel_T channels[APP_TELEMETRY_PAYLOAD_NUMBER_OF_CHANNELS]; /**< the state per sensor channel */
+} AppTelemetryPayload_DeadbandState_T;
+/**
+ * @brief Running statistics of a sensor channel over a window, updated with Welford's algorithm.
+ */
+typedef struct {
+	int32_t min; /**< min value */
+	int32_t max; /**< max value */
+	double mean; /**< mean of the values so far */
+	double m2; /**< sum of the squared differences to the mean */
+	uint32_t numberOfValues; /**< number of values, less than the number of samples if the sensor is read at a longer period. The channel is omitted if 0 */
+} AppTelemetryPayload_ChannelAggregate_T;
+/**
+ * @brief Statistics of the samples of a window in the aggregation mode. See @ref AppTelemetryPayload_AddSampleToAggregate().
+ */
+typedef struct {
+	uint32_t numberOfSamples; /**< number of samples in the window */
+	TickType_t firstTickCount; /**< tick count of the first sample */
+	TickType_t lastTickCount; /**< tick count of the last sample */
+	AppTelemetryPayload_ChannelAggregate_T channels[APP_TELEMETRY_PAYLOAD_NUMBER_OF_CHANNELS]; /**< the statistics per sensor channel, only the selected channels are updated */
+	int32_t quantiles[APP_TELEMETRY_PAYLOAD_NUMBER_OF_SKETCH_CHANNELS][APP_TELEMETRY_PAYLOAD_NUMBER_OF_QUANTILES]; /**< p50, p95, p99 of the accelerometer and gyroscope channels, see @ref AppTelemetryPayload_SetAggregateQuantiles() */
+} AppTelemetryPayload_Aggregate_T;
+/**
+ * @brief Accelerometer sample of a capture window. Accelerometer x, y, z in milli g, within the +-16 g range of the sensor.
+ */
+typedef struct {
+	int16_t accel[3]; /**< accelerometer x, y, z */
+} AppTelemetryPayload_CaptureSample_T;
+/**
+ * @brief A frozen capture window around an accelerometer threshold event. See @ref AppTelemetryPayload_EncodeCaptureChunk().
+ */
+typedef struct {
+	const AppTelemetryPayload_CaptureSample_T * samplesPtr; /**< the samples, oldest first */
+	uint32_t numberOfSamples; /**< number of samples in the window */
+	uint32_t numberOfPreTriggerSamples; /**< number of samples before the trigger sample, which is samplesPtr[numberOfPreTriggerSamples] */
+	TickType_t triggerTickCount; /**< tick count of the trigger sample */
+	uint32_t samplingPeriodMillis; /**< the period of the samples in milliseconds */
+} AppTelemetryPayload_Capture_T;
+/**
+ * @brief The vibration spectrum features of an accelerometer window. See @ref AppTelemetryPayload_EncodeSpectrum().
+ */
+typedef struct {
+	TickType_t firstTickCount; /**< tick count of the first sample of the window */
+	uint32_t numberOfSamples; /**< number of samples of the window */
+	uint32_t samplingPeriodMillis; /**< the period of the samples in milliseconds */
+	AppTelemetrySpectrum_Features_T features; /**< the features per axis, in milli g */
+} AppTelemetryPayload_Spectrum_T;
+/**
+ * @brief An orientation output of the sensor fusion. See @ref AppTelemetryPayload_EncodeOrientations().
+ */
+typedef struct {
+	TickType_t tickCount; /**< tick count of the sample of the output */
+	int32_t quaternion[4]; /**< orientation quaternion w, x, y, z in Q30 (1.0 = 2^30) */
+	int32_t eulerMilliDeg[3]; /**< roll, pitch and yaw in milli degrees, only set if fusionEulerAngles is configured */
+} AppTelemetryPayload_Orientation_T;
+
 Retcode_T AppTelemetryPayload_Init(const char * deviceId);
 
 Retcode_T AppTelemetryPayload_Setup(const AppRuntimeConfig_T * configPtr);
 
 Retcode_T AppTelemetryPayload_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr);
 
-AppTelemetryPayload_T * AppTelemetryPayload_CreateNew(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr);
+void AppTelemetryPayload_PopulateSample(AppTelemetryPayload_Sample_T * samplePtr, const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr, uint8_t presentSensors);
+
+bool AppTelemetryPayload_IsAnySensorPresent(uint8_t presentSensors);
+
+AppTelemetryPayload_T * AppTelemetryPayload_CreateNew(const AppTelemetryPayload_Sample_T * samplePtr);
+
+bool AppTelemetryPayload_IsDeadband(void);
+
+void AppTelemetryPayload_ResetDeadband(AppTelemetryPayload_DeadbandState_T * statePtr);
+
+uint32_t AppTelemetryPayload_ApplyDeadband(AppTelemetryPayload_DeadbandState_T * statePtr, AppTelemetryPayload_Sample_T * samplePtr, uint32_t * numberOfSuppressedPtr);
+
+void AppTelemetryPayload_ResetBatchSize(AppTelemetryPayload_BatchSize_T * batchSizePtr);
+
+uint32_t AppTelemetryPayload_GetBatchSizeWithSample(const AppTelemetryPayload_BatchSize_T * batchSizePtr, const AppTelemetryPayload_Sample_T * samplePtr);
+
+void AppTelemetryPayload_AddSampleToBatchSize(AppTelemetryPayload_BatchSize_T * batchSizePtr, const AppTelemetryPayload_Sample_T * samplePtr, uint32_t batchSize);
+
+bool AppTelemetryPayload_IsBinaryFormat(void);
+
+Retcode_T AppTelemetryPayload_EncodeBatch(const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr);
+
+Retcode_T AppTelemetryPayload_EncodeBatchAt(const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples, uint64_t firstMillisSinceEpoch, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr);
+
+void AppTelemetryPayload_ResetAggregate(AppTelemetryPayload_Aggregate_T * aggregatePtr);
+
+void AppTelemetryPayload_AddSampleToAggregate(AppTelemetryPayload_Aggregate_T * aggregatePtr, const AppTelemetryPayload_Sample_T * samplePtr);
+
+bool AppTelemetryPayload_IsQuantileAggregate(void);
+
+void AppTelemetryPayload_AddSampleToSketches(AppTelemetrySketch_T * sketchesPtr, const AppTelemetryPayload_Sample_T * samplePtr);
+
+void AppTelemetryPayload_SetAggregateQuantiles(AppTelemetryPayload_Aggregate_T * aggregatePtr, AppTelemetrySketch_T * sketchesPtr);
+
+uint32_t AppTelemetryPayload_GetAggregateSize(const AppTelemetryPayload_Aggregate_T * aggregatePtr);
+
+Retcode_T AppTelemetryPayload_EncodeAggregate(const AppTelemetryPayload_Aggregate_T * aggregatePtr, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr);
+
+Retcode_T AppTelemetryPayload_EncodeCaptureChunk(const AppTelemetryPayload_Capture_T * capturePtr, uint32_t firstSampleIndex, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr, uint32_t * numberOfSamplesPtr);
+
+Retcode_T AppTelemetryPayload_EncodeSpectrum(const AppTelemetryPayload_Spectrum_T * spectrumPtr, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr);
+
+Retcode_T AppTelemetryPayload_EncodeOrientations(const AppTelemetryPayload_Orientation_T * orientationsPtr, uint32_t numberOfOrientations, char * bufferPtr, uint32_t bufferSize, uint32_t * lengthPtr, uint32_t * numberEncodedPtr);
+
+char * AppTelemetryPayload_CreateBatchStr(const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples);
+
+uint32_t AppTelemetryPayload_GetBatchSize_Test(
+		const TickType_t tickCount,
+		const Sensor_Value_T * sensorValuePtr,
+		const AppRuntimeConfig_Sensors_T * sensorsConfigPtr,
+		AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat);
 
-AppTelemetryPayload_T * AppTelemetryPayload_CreateNew_Test(
+uint32_t AppTelemetryPayload_GetAggregateSize_Test(
 		const TickType_t tickCount,
 		const Sensor_Value_T * sensorValuePtr,
 		const AppRuntimeConfig_Sensors_T * sensorsConfigPtr,
+		const AppRuntimeConfig_Aggregates_T * aggregatesConfigPtr,
 		AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat);
 
 void AppTelemetryPayload_Delete(AppTelemetryPayload_T * payloadPtr);
@@ -9,9 +9,23 @@
  * @{
  *
  * @brief Module to publish telemetry / sensor samples based on configured intervals.
+ * @details Batches that cannot be published because the broker is not reachable are spilled to the SD card and replayed after the reconnect.
+ * @details In the aggregation mode one event per window is published, windows are not spilled.
+ * @details Accelerometer capture windows are published in chunks on their own topic, see @ref AppTelemetryCapture.
+ * @details The vibration spectrum features of accelerometer windows are published on their own topic, see @ref AppTelemetryAnalysis.
+ * @details The orientation outputs of the sensor fusion are published on their own topic, see @ref AppTelemetryFusion.
+ * @details With qos 1 and more than one message in flight the events are pipelined: a publish returns once the event is in flight.
+ * The live batches in flight are kept until their outcome, one that fails later is spilled by the publishing task like a batch that failed to publish.
+ * Other events that fail later are counted.
  * @see AppTelemetrySampling
  * @see AppTelemetryPayload
  * @see AppTelemetryQueue
+ * @see AppTelemetrySpill
+ * @see AppTelemetryCapture
+ * @see AppTelemetryAnalysis
+ * @see AppTelemetryFusion
+ * @see AppTelemetryRateControl
+ * @see AppTelemetryFidelity
  *
  * @author $(SOLACE_APP_AUTHOR)
  *
@@ -28,10 +42,17 @@
 
 #include "AppTelemetryPublish.h"
 #include "AppMqtt.h"
+#include "AppMqttScheduler.h"
 #include "AppRuntimeConfig.h"
 #include "AppConfig.h"
 #include "AppMisc.h"
 #include "AppTelemetryQueue.h"
+#include "AppTelemetrySpill.h"
+#include "AppTelemetryCapture.h"
+#include "AppTelemetryAnalysis.h"
+#include "AppTelemetryFusion.h"
+#include "AppTelemetryRateControl.h"
+#include "AppTelemetryFidelity.h"
 #include "AppStatus.h"
 
 #include "FreeRTOS.h"
@@ -45,6 +66,7 @@ static uint32_t appTelemetryPublish_PublishTaskStackSize = 1024; /**< the task s
 static SemaphoreHandle_t appTelemetryPublish_TaskSemaphoreHandle = NULL; /**< the task semaphore */
 #define APP_TELEMETRY_PUBLISHING_TASK_INTERNAL_WAIT_TICKS			UINT32_C(10) /**< wait ticks for semaphore to start task */
 #define APP_TELEMETRY_PUBLISHING_TASK_DELETE_INTERNAL_WAIT_TICKS	UINT32_C(5000) /**< wait ticks for semaphore to delete task */
+#define APP_TELEMETRY_PUBLISH_MIN_DEADLINE_IN_MS					UINT32_C(500) /**< the publish deadline is one cycle, at least this */
 
 /**
  * @brief Publish information structure.
@@ -55,14 +77,66 @@ static AppXDK_MQTT_Publish_T appTelemetryPublish_MqttPublishInfo = {
 	.payload = NULL,
 	.payloadLength = 0UL,
 };
+/**
+ * @brief Publish information structure of the accelerometer capture chunks.
+ */
+static AppXDK_MQTT_Publish_T appTelemetryPublish_CaptureMqttPublishInfo = {
+	.topic = NULL,
+	.qos = 0UL,
+	.payload = NULL,
+	.payloadLength = 0UL,
+};
+/**
+ * @brief Publish information structure of the vibration spectrum features.
+ */
+static AppXDK_MQTT_Publish_T appTelemetryPublish_SpectrumMqttPublishInfo = {
+	.topic = NULL,
+	.qos = 0UL,
+	.payload = NULL,
+	.payloadLength = 0UL,
+};
+/**
+ * @brief Publish information structure of the orientation outputs of the sensor fusion.
+ */
+static AppXDK_MQTT_Publish_T appTelemetryPublish_OrientationMqttPublishInfo = {
+	.topic = NULL,
+	.qos = 0UL,
+	.payload = NULL,
+	.payloadLength = 0UL,
+};
 
 static TickType_t appTelemetryPublish_publishPeriodcityMillis = 1000; /**< internal configuration for publish interval in millis */
 
+static uint32_t appTelemetryPublish_AggregateWindowMillis = APP_RT_CFG_DEFAULT_AGGREGATE_WINDOW_MILLIS; /**< window length of the aggregation mode, 0 for raw samples */
+
 static const char * appTelemetryPublish_DeviceId = NULL; /**< internal device id */
 
+static AppTelemetryPayload_Sample_T * appTelemetryPublish_BatchPtr = NULL; /**< buffer for the batch retrieved from the queue */
+
+static uint8_t appTelemetryPublish_BatchSize = 0; /**< number of samples #appTelemetryPublish_BatchPtr holds */
+
+static char appTelemetryPublish_PayloadBuffer[APP_MQTT_MAX_PUBLISH_DATA_LENGTH + 1]; /**< buffer the batch payload is encoded into */
+
+static AppTelemetryPayload_Aggregate_T appTelemetryPublish_Aggregate; /**< buffer for the window retrieved from the queue in the aggregation mode */
+
+static AppTelemetryPayload_Orientation_T appTelemetryPublish_Orientations[APP_TELEMETRY_FUSION_MAX_ORIENTATIONS]; /**< buffer for the orientation outputs retrieved from the sensor fusion */
+
+/**
+ * @brief A live batch in flight with pipelined qos 1, kept until its outcome so it can be spilled if it failed.
+ */
+typedef struct {
+	AppTelemetryPayload_Sample_T * samplesPtr; /**< copy of the samples of the batch, NULL for a free slot */
+	uint8_t numberOfSamples; /**< number of samples of the batch */
+	volatile bool isCompleted; /**< flag set by the completion callback in the publishing task of @ref AppMqttScheduler */
+	volatile bool isAcknowledged; /**< the outcome, valid once isCompleted is set */
+} AppTelemetryPublish_InFlightBatch_T;
+
+static AppTelemetryPublish_InFlightBatch_T appTelemetryPublish_InFlightBatches[APP_MQTT_PUBLISH_WINDOW_MAX_SIZE]; /**< the live batches in flight, at most one per message in flight */
+
 
 /* forward declarations */
 static void appTelemetryPublishing_TelemetryPublishTask(void* pvParameters);
+static void appTelemetryPublish_PublishCompleted(uint16_t packetId, bool isAcknowledged, void * contextPtr);
 
 /**
  * @brief Initialize the module.
@@ -122,9 +196,9 @@ Retcode_T AppTelemetryPublish_Setup(const AppRuntimeConfig_T  * configPtr) {
  * @brief Applies a new runtime config to the module.
  *
  * @details Extracts the following, depending on configElement
- * @details AppRuntimeConfig_Element_targetTelemetryConfig: qos
- * @details AppRuntimeConfig_Element_topicConfig: creates the new topic
- * @details AppRuntimeConfig_Element_activeTelemetryRTParams: the publishing frequency
+ * @details AppRuntimeConfig_Element_targetTelemetryConfig: qos, qos 1 messages in flight
+ * @details AppRuntimeConfig_Element_topicConfig: creates the new topics
+ * @details AppRuntimeConfig_Element_activeTelemetryRTParams: the publishing frequency, (re-)allocates the batch buffer
  *
  * @note Call only if publishing task is not running.
  *
@@ -134,6 +208,7 @@ Retcode_T AppTelemetryPublish_Setup(const AppRuntimeConfig_T  * configPtr) {
  * @return Retcode_T: RETCODE_OK
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT)
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_FAILED_TO_TAKE_SEMAPHORE_IN_TIME)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_TELEMETRY_QUEUE_FAILED_TO_ALLOCATE)
  */
 Retcode_T AppTelemetryPublish_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr) {
 
@@ -148,6 +223,21 @@ Retcode_T AppTelemetryPublish_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigEleme
 		switch(configElement) {
 		case AppRuntimeConfig_Element_targetTelemetryConfig: {
 			appTelemetryPublish_MqttPublishInfo.qos = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.qos;
+			appTelemetryPublish_CaptureMqttPublishInfo.qos = appTelemetryPublish_MqttPublishInfo.qos;
+			appTelemetryPublish_SpectrumMqttPublishInfo.qos = appTelemetryPublish_MqttPublishInfo.qos;
+			appTelemetryPublish_OrientationMqttPublishInfo.qos = appTelemetryPublish_MqttPublishInfo.qos;
+
+			uint8_t qos1MaxInFlight = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.qos1MaxInFlight;
+			AppMqtt_SetQos1MaxInFlight(qos1MaxInFlight);
+			bool isQos1Pipelined = (1 == appTelemetryPublish_MqttPublishInfo.qos && qos1MaxInFlight > 1);
+
+			AppMqttPublishWindow_Completed_Func_T publishCompleted_Func = isQos1Pipelined ? appTelemetryPublish_PublishCompleted : NULL;
+			appTelemetryPublish_MqttPublishInfo.publishCompletedCallback_Func = publishCompleted_Func;
+			appTelemetryPublish_CaptureMqttPublishInfo.publishCompletedCallback_Func = publishCompleted_Func;
+			appTelemetryPublish_SpectrumMqttPublishInfo.publishCompletedCallback_Func = publishCompleted_Func;
+			appTelemetryPublish_OrientationMqttPublishInfo.publishCompletedCallback_Func = publishCompleted_Func;
+
+			appTelemetryPublish_AggregateWindowMillis = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.aggregateWindowMillis;
 		}
 		break;
 		case AppRuntimeConfig_Element_topicConfig: {
@@ -158,11 +248,41 @@ Retcode_T AppTelemetryPublish_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigEleme
 														((AppRuntimeConfig_TopicConfig_T * ) newConfigPtr)->received.methodCreate,
 														((AppRuntimeConfig_TopicConfig_T * ) newConfigPtr)->received.baseTopic,
 														appTelemetryPublish_DeviceId);
+
+			if(appTelemetryPublish_CaptureMqttPublishInfo.topic != NULL) free(appTelemetryPublish_CaptureMqttPublishInfo.topic);
+
+			appTelemetryPublish_CaptureMqttPublishInfo.topic = AppMisc_FormatTopic("%s/iot-event/%s/%s/capture",
+														((AppRuntimeConfig_TopicConfig_T * ) newConfigPtr)->received.methodCreate,
+														((AppRuntimeConfig_TopicConfig_T * ) newConfigPtr)->received.baseTopic,
+														appTelemetryPublish_DeviceId);
+
+			if(appTelemetryPublish_SpectrumMqttPublishInfo.topic != NULL) free(appTelemetryPublish_SpectrumMqttPublishInfo.topic);
+
+			appTelemetryPublish_SpectrumMqttPublishInfo.topic = AppMisc_FormatTopic("%s/iot-event/%s/%s/spectrum",
+														((AppRuntimeConfig_TopicConfig_T * ) newConfigPtr)->received.methodCreate,
+														((AppRuntimeConfig_TopicConfig_T * ) newConfigPtr)->received.baseTopic,
+														appTelemetryPublish_DeviceId);
+
+			if(appTelemetryPublish_OrientationMqttPublishInfo.topic != NULL) free(appTelemetryPublish_OrientationMqttPublishInfo.topic);
+
+			appTelemetryPublish_OrientationMqttPublishInfo.topic = AppMisc_FormatTopic("%s/iot-event/%s/%s/orientation",
+														((AppRuntimeConfig_TopicConfig_T * ) newConfigPtr)->received.methodCreate,
+														((AppRuntimeConfig_TopicConfig_T * ) newConfigPtr)->received.baseTopic,
+														appTelemetryPublish_DeviceId);
 		}
 		break;
-		case AppRuntimeConfig_Element_activeTelemetryRTParams:
+		case AppRuntimeConfig_Element_activeTelemetryRTParams: {
 			appTelemetryPublish_publishPeriodcityMillis = ((AppRuntimeConfig_TelemetryRTParams_T *) newConfigPtr)->publishPeriodcityMillis;
-			break;
+
+			uint8_t batchSize = ((AppRuntimeConfig_TelemetryRTParams_T *) newConfigPtr)->numberOfSamplesPerEvent;
+			if(batchSize != appTelemetryPublish_BatchSize) {
+				if(NULL != appTelemetryPublish_BatchPtr) free(appTelemetryPublish_BatchPtr);
+				appTelemetryPublish_BatchPtr = (AppTelemetryPayload_Sample_T *) malloc(batchSize * sizeof(AppTelemetryPayload_Sample_T));
+				appTelemetryPublish_BatchSize = (NULL == appTelemetryPublish_BatchPtr) ? 0 : batchSize;
+				if(NULL == appTelemetryPublish_BatchPtr) retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_TELEMETRY_QUEUE_FAILED_TO_ALLOCATE);
+			}
+		}
+		break;
 		default: retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT);
 		}
 
@@ -172,6 +292,32 @@ Retcode_T AppTelemetryPublish_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigEleme
 
 	return retcode;
 }
+/**
+ * @brief Spill the events left in the queue before it is prepared for a new configuration, e.g. a new fidelity level of @ref AppTelemetryFidelity.
+ * @details The open batch is closed first. The batches are spilled if @ref AppTelemetrySpill_IsEnabled(), so they are replayed with the next publishing cycles.
+ * A batch that can't be spilled and the windows of the aggregation mode, which are not spilled, are counted as failed.
+ * @note Call only while the sampling and the publishing task are not running and before the new configuration is applied.
+ */
+void AppTelemetryPublish_SpillQueuedEvents(void) {
+
+	assert(appTelemetryPublish_TaskHandle==NULL);
+
+	AppTelemetryQueue_PushStats();
+
+	if(AppTelemetryQueue_IsAggregateMode()) {
+		while(RETCODE_OK == AppTelemetryQueue_RetrieveAggregate(&appTelemetryPublish_Aggregate)) AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+		return;
+	}
+
+	AppTelemetryQueue_CloseOpenBatch();
+
+	uint8_t numberOfSamples = 0;
+	while(RETCODE_OK == AppTelemetryQueue_RetrieveBatch(appTelemetryPublish_BatchPtr, appTelemetryPublish_BatchSize, &numberOfSamples)) {
+		Retcode_T retcode = RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_TELEMETRY_SPILL_NOT_ENABLED);
+		if(AppTelemetrySpill_IsEnabled()) retcode = AppTelemetrySpill_Append(appTelemetryPublish_BatchPtr, numberOfSamples);
+		if(RETCODE_OK != retcode) AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+	}
+}
 /**
  * @brief Create the publishing task.
  *
@@ -229,9 +375,256 @@ bool AppTelemetryPublish_isTaskRunning(void) {
 	} else assert(0);
 	return isRunning;
 }
+/**
+ * @brief Completion callback of a pipelined qos 1 event.
+ * @details Sets the outcome of a live batch, it is spilled or released by the publish task, see @ref appTelemetryPublish_SpillFailedBatches().
+ * Counts the other events that failed.
+ * An abandoned event may still be acknowledged, it is only handled with its outcome, so a live batch is not spilled while it may be delivered.
+ * typedef: @ref AppMqttPublishWindow_Completed_Func_T()
+ * @param[in] packetId: unused
+ * @param[in] isAcknowledged: the outcome
+ * @param[in] isAbandoned: true if the event timed out, its outcome follows
+ * @param[in] contextPtr: the #AppTelemetryPublish_InFlightBatch_T of a live batch, NULL for other events
+ */
+static void appTelemetryPublish_PublishCompleted(uint16_t packetId, bool isAcknowledged, bool isAbandoned, void * contextPtr) {
+
+	BCDS_UNUSED(packetId);
+
+	if(isAbandoned) return;
+
+	AppTelemetryPublish_InFlightBatch_T * batchPtr = (AppTelemetryPublish_InFlightBatch_T *) contextPtr;
+
+	if(NULL == batchPtr) {
+		if(!isAcknowledged) AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+		return;
+	}
+	batchPtr->isAcknowledged = isAcknowledged;
+	batchPtr->isCompleted = true;
+}
+/**
+ * @brief Keep a copy of a live batch before it is published with pipelined qos 1.
+ * @param[in] samplesPtr: the samples
+ * @param[in] numberOfSamples: the number of samples
+ * @return AppTelemetryPublish_InFlightBatch_T *: the batch, NULL if no slot is free or the copy could not be allocated. The batch is then only counted if it fails
+ */
+static AppTelemetryPublish_InFlightBatch_T * appTelemetryPublish_KeepInFlightBatch(const AppTelemetryPayload_Sample_T * samplesPtr, uint8_t numberOfSamples) {
+
+	for(uint32_t i = 0; i < APP_MQTT_PUBLISH_WINDOW_MAX_SIZE; i++) {
+
+		AppTelemetryPublish_InFlightBatch_T * batchPtr = &appTelemetryPublish_InFlightBatches[i];
+		if(NULL != batchPtr->samplesPtr) continue;
+
+		batchPtr->samplesPtr = (AppTelemetryPayload_Sample_T *) malloc(numberOfSamples * sizeof(AppTelemetryPayload_Sample_T));
+		if(NULL == batchPtr->samplesPtr) return NULL;
+
+		memcpy(batchPtr->samplesPtr, samplesPtr, numberOfSamples * sizeof(AppTelemetryPayload_Sample_T));
+		batchPtr->numberOfSamples = numberOfSamples;
+		batchPtr->isAcknowledged = false;
+		batchPtr->isCompleted = false;
+		return batchPtr;
+	}
+	return NULL;
+}
+/**
+ * @brief Free the copy of a live batch.
+ * @param[in] batchPtr: the batch
+ */
+static void appTelemetryPublish_ReleaseInFlightBatch(AppTelemetryPublish_InFlightBatch_T * batchPtr) {
+	free(batchPtr->samplesPtr);
+	batchPtr->samplesPtr = NULL;
+}
+/**
+ * @brief Spill the live batches that failed in flight, if @ref AppTelemetrySpill_IsEnabled(), release the completed ones.
+ * @details Called by the publishing task, so the spill log is only written from one task. A batch that can't be spilled is counted as failed.
+ */
+static void appTelemetryPublish_SpillFailedBatches(void) {
+
+	for(uint32_t i = 0; i < APP_MQTT_PUBLISH_WINDOW_MAX_SIZE; i++) {
+
+		AppTelemetryPublish_InFlightBatch_T * batchPtr = &appTelemetryPublish_InFlightBatches[i];
+		if(NULL == batchPtr->samplesPtr || !batchPtr->isCompleted) continue;
+
+		if(!batchPtr->isAcknowledged) {
+			Retcode_T retcode = RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_TELEMETRY_SPILL_NOT_ENABLED);
+			if(AppTelemetrySpill_IsEnabled()) retcode = AppTelemetrySpill_Append(batchPtr->samplesPtr, batchPtr->numberOfSamples);
+			if(RETCODE_OK != retcode) AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+		}
+		appTelemetryPublish_ReleaseInFlightBatch(batchPtr);
+	}
+}
+/**
+ * @brief Publish the payload encoded into #appTelemetryPublish_PayloadBuffer.
+ * @param[in] publishInfoPtr: #appTelemetryPublish_MqttPublishInfo, #appTelemetryPublish_CaptureMqttPublishInfo, #appTelemetryPublish_SpectrumMqttPublishInfo or #appTelemetryPublish_OrientationMqttPublishInfo
+ * @param[in] payloadLength: the length of the payload
+ * @return Retcode_T: retcode from @ref AppMqttScheduler_Publish()
+ */
+static Retcode_T appTelemetryPublish_PublishPayload(AppXDK_MQTT_Publish_T * publishInfoPtr, uint32_t payloadLength) {
+
+	publishInfoPtr->payload = appTelemetryPublish_PayloadBuffer;
+	publishInfoPtr->payloadLength = payloadLength;
+
+	#ifdef DEBUG_APP_TELEMETRY_PUBLISH_EVERY_MESSAGE
+	printf("[INFO] - appTelemetryPublish_PublishPayload: publishing:\r\n");
+	printf("\ttopic:%s, qos=%lu\r\n", publishInfoPtr->topic, publishInfoPtr->qos);
+	// capture chunks, spectrum features and orientations are always JSON
+	if(publishInfoPtr == &appTelemetryPublish_MqttPublishInfo && AppTelemetryPayload_IsBinaryFormat()) printf("\tpayload:<binary>\r\n");
+	else printf("\tpayload:%s\r\n", publishInfoPtr->payload);
+	printf("\tpayload length:%lu\r\n", publishInfoPtr->payloadLength);
+	#endif
+
+	Retcode_T retcode = AppMqttScheduler_Publish(AppMqttScheduler_Class_Telemetry, publishInfoPtr);
+
+	publishInfoPtr->payload = NULL;
+
+	return retcode;
+}
+/**
+ * @brief Encode a batch of samples into #appTelemetryPublish_PayloadBuffer and publish it.
+ * @details A live batch published with pipelined qos 1 is kept until its outcome, see @ref appTelemetryPublish_KeepInFlightBatch().
+ * A replayed batch is published with synchronous qos 1 instead: RETCODE_OK means acknowledged, its spill record is only consumed then.
+ * @param[in] samplesPtr: the samples
+ * @param[in] numberOfSamples: the number of samples
+ * @param[in] firstMillisSinceEpoch: the time of the first sample of a spilled batch, 0 to take the timestamps from the tick counts
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_MQTT_NOT_CONNECTED)
+ * @return Retcode_T: retcode from @ref AppTelemetryPayload_EncodeBatchAt()
+ * @return Retcode_T: retcode from @ref AppMqttScheduler_Publish()
+ */
+static Retcode_T appTelemetryPublish_PublishBatch(const AppTelemetryPayload_Sample_T * samplesPtr, uint8_t numberOfSamples, uint64_t firstMillisSinceEpoch) {
+
+	// don't format a payload that can't be sent
+	if(!AppMqtt_IsConnected()) return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_MQTT_NOT_CONNECTED);
+
+	uint32_t payloadLength = 0;
+	Retcode_T retcode = AppTelemetryPayload_EncodeBatchAt(samplesPtr, numberOfSamples, firstMillisSinceEpoch, appTelemetryPublish_PayloadBuffer, sizeof(appTelemetryPublish_PayloadBuffer), &payloadLength);
+	if(RETCODE_OK != retcode) return retcode;
+
+	// a batch replayed with its time since the epoch may be of a previous run, its tick counts can't be spilled again.
+	// it stays in the spill log until acknowledged, hence it is not pipelined
+	AppMqttPublishWindow_Completed_Func_T publishCompleted_Func = appTelemetryPublish_MqttPublishInfo.publishCompletedCallback_Func;
+	AppTelemetryPublish_InFlightBatch_T * batchPtr = NULL;
+	if(0 != firstMillisSinceEpoch) appTelemetryPublish_MqttPublishInfo.publishCompletedCallback_Func = NULL;
+	else if(NULL != publishCompleted_Func) batchPtr = appTelemetryPublish_KeepInFlightBatch(samplesPtr, numberOfSamples);
+
+	appTelemetryPublish_MqttPublishInfo.publishCompletedContextPtr = batchPtr;
+	retcode = appTelemetryPublish_PublishPayload(&appTelemetryPublish_MqttPublishInfo, payloadLength);
+	appTelemetryPublish_MqttPublishInfo.publishCompletedContextPtr = NULL;
+	appTelemetryPublish_MqttPublishInfo.publishCompletedCallback_Func = publishCompleted_Func;
+
+	// not in flight, the caller handles the failed publish
+	if(RETCODE_OK != retcode && NULL != batchPtr) appTelemetryPublish_ReleaseInFlightBatch(batchPtr);
+
+	return retcode;
+}
+/**
+ * @brief Encode a window of the aggregation mode into #appTelemetryPublish_PayloadBuffer and publish it.
+ * @param[in] aggregatePtr: the window
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_MQTT_NOT_CONNECTED)
+ * @return Retcode_T: retcode from @ref AppTelemetryPayload_EncodeAggregate()
+ * @return Retcode_T: retcode from @ref AppMqttScheduler_Publish()
+ */
+static Retcode_T appTelemetryPublish_PublishAggregate(const AppTelemetryPayload_Aggregate_T * aggregatePtr) {
+
+	if(!AppMqtt_IsConnected()) return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_MQTT_NOT_CONNECTED);
+
+	uint32_t payloadLength = 0;
+	Retcode_T retcode = AppTelemetryPayload_EncodeAggregate(aggregatePtr, appTelemetryPublish_PayloadBuffer, sizeof(appTelemetryPublish_PayloadBuffer), &payloadLength);
+	if(RETCODE_OK != retcode) return retcode;
+
+	return appTelemetryPublish_PublishPayload(&appTelemetryPublish_MqttPublishInfo, payloadLength);
+}
+/**
+ * @brief Publish the frozen accelerometer capture window, if any, in chunks of as many samples as fit into #appTelemetryPublish_PayloadBuffer.
+ * @details Stops on the first chunk that fails to publish, the window is continued with that chunk in the next cycle.
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_MQTT_NOT_CONNECTED)
+ * @return Retcode_T: retcode from @ref AppTelemetryPayload_EncodeCaptureChunk()
+ * @return Retcode_T: retcode from @ref AppMqttScheduler_Publish()
+ */
+static Retcode_T appTelemetryPublish_PublishCapture(void) {
+
+	Retcode_T retcode = RETCODE_OK;
+	uint32_t nextSampleIndex = 0;
+	const AppTelemetryPayload_Capture_T * capturePtr = NULL;
+
+	while(RETCODE_OK == retcode && NULL != (capturePtr = AppTelemetryCapture_GetWindow(&nextSampleIndex))) {
+
+		if(!AppMqtt_IsConnected()) return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_MQTT_NOT_CONNECTED);
+
+		uint32_t payloadLength = 0;
+		uint32_t numberOfSamples = 0;
+		retcode = AppTelemetryPayload_EncodeCaptureChunk(capturePtr, nextSampleIndex, appTelemetryPublish_PayloadBuffer, sizeof(appTelemetryPublish_PayloadBuffer), &payloadLength, &numberOfSamples);
+
+		if(RETCODE_OK == retcode) retcode = appTelemetryPublish_PublishPayload(&appTelemetryPublish_CaptureMqttPublishInfo, payloadLength);
+
+		if(RETCODE_OK == retcode) AppTelemetryCapture_ConsumeSamples(numberOfSamples);
+	}
+
+	return retcode;
+}
+/**
+ * @brief Compute the spectrum features of the full accelerometer window, if any, encode them into #appTelemetryPublish_PayloadBuffer and publish them.
+ * @details The features of a window that fails to publish are discarded.
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: retcode from @ref AppTelemetryPayload_EncodeSpectrum()
+ * @return Retcode_T: retcode from @ref AppMqttScheduler_Publish()
+ */
+static Retcode_T appTelemetryPublish_PublishSpectrum(void) {
+
+	const AppTelemetryPayload_Spectrum_T * spectrumPtr = AppTelemetryAnalysis_ComputeSpectrum();
+	if(NULL == spectrumPtr) return RETCODE_OK;
+
+	uint32_t payloadLength = 0;
+	Retcode_T retcode = AppTelemetryPayload_EncodeSpectrum(spectrumPtr, appTelemetryPublish_PayloadBuffer, sizeof(appTelemetryPublish_PayloadBuffer), &payloadLength);
+	if(RETCODE_OK != retcode) return retcode;
+
+	return appTelemetryPublish_PublishPayload(&appTelemetryPublish_SpectrumMqttPublishInfo, payloadLength);
+}
+/**
+ * @brief Publish the orientation outputs of the sensor fusion, if any, in events of as many outputs as fit into #appTelemetryPublish_PayloadBuffer.
+ * @details Stops on the first event that fails to publish, its outputs stay in the ring for the next cycle.
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_MQTT_NOT_CONNECTED)
+ * @return Retcode_T: retcode from @ref AppTelemetryPayload_EncodeOrientations()
+ * @return Retcode_T: retcode from @ref AppMqttScheduler_Publish()
+ */
+static Retcode_T appTelemetryPublish_PublishOrientations(void) {
+
+	Retcode_T retcode = RETCODE_OK;
+	uint32_t numberOfOrientations = 0;
+
+	while(RETCODE_OK == retcode && 0 < (numberOfOrientations = AppTelemetryFusion_PeekOrientations(appTelemetryPublish_Orientations, APP_TELEMETRY_FUSION_MAX_ORIENTATIONS))) {
+
+		if(!AppMqtt_IsConnected()) return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_MQTT_NOT_CONNECTED);
+
+		uint32_t payloadLength = 0;
+		uint32_t numberEncoded = 0;
+		retcode = AppTelemetryPayload_EncodeOrientations(appTelemetryPublish_Orientations, numberOfOrientations, appTelemetryPublish_PayloadBuffer, sizeof(appTelemetryPublish_PayloadBuffer), &payloadLength, &numberEncoded);
+
+		if(RETCODE_OK == retcode) retcode = appTelemetryPublish_PublishPayload(&appTelemetryPublish_OrientationMqttPublishInfo, payloadLength);
+
+		if(RETCODE_OK == retcode) AppTelemetryFusion_ReleaseOrientations(numberEncoded);
+	}
+
+	return retcode;
+}
 /**
  * @brief The publishing task. Waits for a full queue for #appTelemetryPublish_publishPeriodcityMillis millis and publishes all payloads in the queue.
+ * @details Drains the backlog: publishes up to @ref AppTelemetryQueue_GetBacklogSize() complete batches per wake-up, so a publisher that fell behind catches up.
+ * @details A batch that fails to publish is spilled to the SD card if @ref AppTelemetrySpill_IsEnabled(), and draining continues.
+ * A qos 1 batch that missed its deadline while in flight is not spilled, it may still be delivered. It is counted as failed and draining stops.
+ * Otherwise draining stops on the first failed publish. Before draining, the live batches that failed in flight with pipelined qos 1 are spilled, see @ref appTelemetryPublish_SpillFailedBatches().
+ * @details While connected, replays up to @ref AppTelemetrySpill_GetReplayEventsPerCycle() spilled batches per wake-up after the live ones, oldest first.
+ * A replayed batch is published with synchronous qos 1 and consumed from the log once acknowledged, the replay stops at the first one that is not.
+ * @details While connected, publishes the spectrum features of a full accelerometer window, the orientation outputs of the sensor fusion and a frozen accelerometer capture window
+ * after the live events, before the replay.
+ * The window waits while not connected.
+ * @details In the aggregation mode the cycle is the window length and the closed windows are published instead of batches, a window that fails to publish is counted and discarded.
+ * @details Each publish has a deadline of one cycle, see #APP_TELEMETRY_PUBLISH_MIN_DEADLINE_IN_MS. A publish missing it is abandoned and handled like a failed publish, so a stuck broker delays the loop by one cycle per event.
  * Keeps track in the stats of slow publishing loops.
+ * @details Adds the measurements of every cycle it was connected throughout to @ref AppTelemetryRateControl and @ref AppTelemetryFidelity: the time spent publishing after the wait for the full queue,
+ * the live events drained, those beyond the first as backlog, and the failed publishes. Failures of pipelined events reported later are not included.
  */
 static void appTelemetryPublishing_TelemetryPublishTask(void* pvParameters) {
 	BCDS_UNUSED(pvParameters);
@@ -242,12 +635,26 @@ static void appTelemetryPublishing_TelemetryPublishTask(void* pvParameters) {
 	printf("[INFO] - appTelemetryPublishing_TelemetryPublishTask: qos:%lu\r\n", appTelemetryPublish_MqttPublishInfo.qos);
 	#endif
 
-    char * payloadStr = NULL;
-
     // counters for measuring publish times
     TickType_t loopStartTicks = 0;
     uint32_t loopDurationTicks = 0;
 
+    // measurements for the rate control and the fidelity ladder
+    TickType_t publishStartTicks = 0;
+    bool isConnectedAtPublishStart = false;
+    AppTelemetryRateControl_Cycle_T rateControlCycle;
+
+    TickType_t cycleMillis = (appTelemetryPublish_AggregateWindowMillis > 0) ? appTelemetryPublish_AggregateWindowMillis : appTelemetryPublish_publishPeriodcityMillis;
+
+    uint32_t deadlineMillis = (cycleMillis > APP_TELEMETRY_PUBLISH_MIN_DEADLINE_IN_MS) ? cycleMillis : APP_TELEMETRY_PUBLISH_MIN_DEADLINE_IN_MS;
+    appTelemetryPublish_MqttPublishInfo.deadlineMillis = deadlineMillis;
+    appTelemetryPublish_CaptureMqttPublishInfo.deadlineMillis = deadlineMillis;
+    appTelemetryPublish_SpectrumMqttPublishInfo.deadlineMillis = deadlineMillis;
+    appTelemetryPublish_OrientationMqttPublishInfo.deadlineMillis = deadlineMillis;
+
+    AppTelemetryRateControl_Start();
+    AppTelemetryFidelity_Start();
+
 	while (1) {
 
 		if(pdTRUE == xSemaphoreTake(appTelemetryPublish_TaskSemaphoreHandle, APP_TELEMETRY_PUBLISHING_TASK_INTERNAL_WAIT_TICKS)) {
@@ -255,46 +662,145 @@ static void appTelemetryPublishing_TelemetryPublishTask(void* pvParameters) {
 			// measure the publishing time
 			loopStartTicks = xTaskGetTickCount();
 
+			rateControlCycle = (AppTelemetryRateControl_Cycle_T) { .cycleMillis = cycleMillis };
+
 			/**
 			 * Wait for the full queue for one cycle target time
 			 */
-			if( RETCODE_OK != AppTelemetryQueue_Wait4FullQueue(appTelemetryPublish_publishPeriodcityMillis) ) {
+			Retcode_T waitRetcode = AppTelemetryQueue_Wait4FullQueue(cycleMillis);
+
+			publishStartTicks = xTaskGetTickCount();
+			isConnectedAtPublishStart = AppMqtt_IsConnected();
+
+			appTelemetryPublish_SpillFailedBatches();
+
+			if( RETCODE_OK != waitRetcode ) {
 				/*
 				 * Observed:
 				 * - when sampling has been suspended for changing frequency. happens 1 time. ok, don't do anything
 				 * - when button (ISR) takes too much time from sampling - press button constantly
 				 * - when sending recurring status message (e.g. full status) with qos=1
+				 * - with deadbands configured, when the values did not change. expected, not counted
 				 */
-				AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+				if(!AppTelemetryPayload_IsDeadband()) AppStatus_Stats_IncrementTelemetrySendFailedCounter();
 
 			} else {
 
-		    	payloadStr = AppTelemetryQueue_RetrieveData();
-		    	assert(payloadStr != NULL);
+				uint8_t maxNumberOfEvents = AppTelemetryQueue_GetBacklogSize();
+				uint8_t numberOfEvents = 0;
+				uint8_t numberOfSamples = 0;
+				Retcode_T retcode = RETCODE_OK;
+
+				if(appTelemetryPublish_AggregateWindowMillis > 0) {
+					do {
+						// the sampling task dropped the remaining windows
+						if(RETCODE_OK != AppTelemetryQueue_RetrieveAggregate(&appTelemetryPublish_Aggregate)) break;
+
+						retcode = appTelemetryPublish_PublishAggregate(&appTelemetryPublish_Aggregate);
 
-				appTelemetryPublish_MqttPublishInfo.payload = payloadStr;
-				appTelemetryPublish_MqttPublishInfo.payloadLength = strlen(payloadStr);
+						if(RETCODE_OK != retcode) {
+							AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+							rateControlCycle.numberOfFailures++;
+						}
 
-				#ifdef DEBUG_APP_TELEMETRY_PUBLISH_EVERY_MESSAGE
-				printf("[INFO] - appTelemetryPublishing_TelemetryPublishTask: publishing:\r\n");
-				printf("\ttopic:%s, qos=%lu\r\n", appTelemetryPublish_MqttPublishInfo.Topic, appTelemetryPublish_MqttPublishInfo.QoS);
-				printf("\tpayload:%s\r\n", appTelemetryPublish_MqttPublishInfo.Payload);
-				printf("\tpayload length:%lu\r\n", appTelemetryPublish_MqttPublishInfo.PayloadLength);
-				#endif
+						numberOfEvents++;
 
-				Retcode_T retcode = AppMqtt_Publish(&appTelemetryPublish_MqttPublishInfo);
+					} while(RETCODE_OK == retcode && numberOfEvents < maxNumberOfEvents && AppTelemetryQueue_IsBatchAvailable());
 
-				if(RETCODE_OK != retcode) AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+				} else do {
+					// the sampling task dropped the remaining batches
+					if(RETCODE_OK != AppTelemetryQueue_RetrieveBatch(appTelemetryPublish_BatchPtr, appTelemetryPublish_BatchSize, &numberOfSamples)) break;
 
-				free(payloadStr);
+					retcode = appTelemetryPublish_PublishBatch(appTelemetryPublish_BatchPtr, numberOfSamples, 0);
+
+					// a spilled batch is still a failed publish for the rate control
+					if(RETCODE_OK != retcode) rateControlCycle.numberOfFailures++;
+
+					// keep the batch for replay and carry on draining. a qos 1 batch still in flight may be delivered, spilling it would publish it twice
+					if(RETCODE_OK != retcode && AppTelemetrySpill_IsEnabled() && RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED_IN_FLIGHT != Retcode_GetCode(retcode)) {
+						if(RETCODE_OK == AppTelemetrySpill_Append(appTelemetryPublish_BatchPtr, numberOfSamples)) retcode = RETCODE_OK;
+					}
+
+					if(RETCODE_OK != retcode) AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+
+					numberOfEvents++;
+
+				} while(RETCODE_OK == retcode && numberOfEvents < maxNumberOfEvents && AppTelemetryQueue_IsBatchAvailable());
+
+				rateControlCycle.numberOfEvents = numberOfEvents;
+				if(numberOfEvents > 1) rateControlCycle.numberOfBacklogEvents = numberOfEvents - 1;
 
 			} // full queue
 
+			// samples dropped by the sampling task
+			AppTelemetryQueue_PushStats();
+
+			// features of a full spectrum window
+			if(AppMqtt_IsConnected() && AppTelemetryAnalysis_IsEnabled()) {
+				if(RETCODE_OK != appTelemetryPublish_PublishSpectrum()) {
+					AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+					rateControlCycle.numberOfFailures++;
+				}
+			}
+
+			// orientations of the sensor fusion
+			if(AppMqtt_IsConnected() && AppTelemetryFusion_IsEnabled()) {
+				if(RETCODE_OK != appTelemetryPublish_PublishOrientations()) {
+					AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+					rateControlCycle.numberOfFailures++;
+				}
+			}
+
+			// upload a captured window
+			if(AppMqtt_IsConnected() && AppTelemetryCapture_IsEnabled()) {
+				if(RETCODE_OK != appTelemetryPublish_PublishCapture()) {
+					AppStatus_Stats_IncrementTelemetrySendFailedCounter();
+					rateControlCycle.numberOfFailures++;
+				}
+			}
+
+			// catch up on the spilled batches
+			if(AppMqtt_IsConnected()) {
+
+				const AppTelemetryPayload_Sample_T * replaySamplesPtr = NULL;
+				uint8_t numberOfReplaySamples = 0;
+				uint64_t replayMillisSinceEpoch = 0;
+
+				for(uint8_t i = 0; i < AppTelemetrySpill_GetReplayEventsPerCycle(); i++) {
+
+					if(RETCODE_OK != AppTelemetrySpill_ReadNext(&replaySamplesPtr, &numberOfReplaySamples, &replayMillisSinceEpoch)) break;
+
+					Retcode_T retcode = appTelemetryPublish_PublishBatch(replaySamplesPtr, numberOfReplaySamples, replayMillisSinceEpoch);
+
+					// a batch that can't be encoded would block the replay forever, e.g. spilled under a different configuration
+					if(RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL == Retcode_GetCode(retcode)) {
+						AppTelemetrySpill_Consume();
+						AppStatus_Stats_IncrementTelemetrySpillDroppedEventsCounter(1);
+						continue;
+					}
+					// not acknowledged: replayed again later. one that missed its deadline in flight may then be delivered twice, not lost
+					if(RETCODE_OK != retcode) {
+						rateControlCycle.numberOfFailures++;
+						break;
+					}
+
+					// acknowledged, see appTelemetryPublish_PublishBatch()
+					AppTelemetrySpill_Consume();
+					AppStatus_Stats_IncrementTelemetryReplayedEventsCounter();
+				}
+			}
+
 			loopDurationTicks = (xTaskGetTickCount()-loopStartTicks);
-			if(loopDurationTicks > appTelemetryPublish_publishPeriodcityMillis) {
+			if(loopDurationTicks > cycleMillis) {
 				AppStatus_Stats_IncrementTelemetrySendTooSlowCounter();
 			}
 
+			if(isConnectedAtPublishStart && AppMqtt_IsConnected()) {
+				rateControlCycle.publishMillis = (xTaskGetTickCount() - publishStartTicks) * portTICK_PERIOD_MS;
+				AppTelemetryRateControl_AddCycle(&rateControlCycle);
+				AppTelemetryFidelity_AddCycle(&rateControlCycle);
+			}
+
 			xSemaphoreGive(appTelemetryPublish_TaskSemaphoreHandle);
 
 		} // task semaphore
@@ -29,6 +29,8 @@ Retcode_T AppTelemetryPublish_DeletePublishingTask(void);
 
 bool AppTelemetryPublish_isTaskRunning(void);
 
+void AppTelemetryPublish_SpillQueuedEvents(void);
+
 #endif /* SOURCE_APPTELEMETRYPUBLISH_H_ */
 
 /**@} */
@@ -8,10 +8,30 @@
  * @defgroup AppTelemetryQueue AppTelemetryQueue
  * @{
  *
- * @brief Implements the telemetry queue, which is a JSON array. The queue is filled by @ref AppTelemetrySampling and read by @ref AppTelemetryPublish.
- * @details Has an internal write queue and a read queue. When the write queue is full, the read queue pointer will point to the write
- * queue and the write queue is created again. At this point, a read-trigger semaphore is released to notify waiting publishers / readers of the queue that it is ready for reading.
- * @details Provides also functions to create a 'test' queue - to verify that a new configuration would result in a valid queue size.
+ * @brief Implements the telemetry queue. The queue is filled by @ref AppTelemetrySampling and read by @ref AppTelemetryPublish.
+ * @details The queue is a lock-free single-producer / single-consumer ring (@ref AppTelemetryRing) of compact binary sample records (#AppTelemetryPayload_Sample_T).
+ * The sampling task writes the record in place, the publishing task copies a batch of records out and formats the payload outside of any critical section.
+ * @details The ring is sized at configuration time to a backlog of queueBacklogEvents batches of numberOfSamplesPerEvent samples, so short publishing stalls are absorbed.
+ * Adding a sample does not allocate and does not take a semaphore, unless a flush has to be counted in the stats.
+ * @details A batch is flushed on whichever comes first:
+ * - it holds numberOfSamplesPerEvent samples
+ * - the next sample would take its encoded size (@ref AppTelemetryPayload_GetBatchSizeWithSample()) over batchMaxBytes
+ * - its first sample is batchMaxAgeMillis old. Checked when a sample is added, so the age is exceeded by at most one sampling period.
+ *
+ * The sampling task marks the end of a flushed batch in the ring and flags the first sample of each batch, so the reader finds the batch boundaries.
+ * Once a batch is flushed, the read-trigger semaphore is released to notify a waiting publisher / reader of the queue that it is ready for reading.
+ * The flush reasons are counted in @ref AppStatus stats.
+ * @details If the backlog is full, the queueDropPolicy decides whether the oldest complete batch or the new sample is discarded. Drops are counted locally and pushed to the @ref AppStatus stats by the publishing task.
+ * @details In the aggregation mode (aggregateWindowMillis > 0) the sampling task folds each sample into an open window (#AppTelemetryPayload_Aggregate_T) instead.
+ * A window is closed once the next sample would fall outside of it and is then written to the ring as one element, which holds queueBacklogEvents windows.
+ * The drop policy applies to whole windows. The reader retrieves the windows with @ref AppTelemetryQueue_RetrieveAggregate().
+ * With quantiles selected, the accelerometer and gyroscope values of the open window are also counted in a quantile sketch per channel (@ref AppTelemetrySketch),
+ * allocated once with quantileSketchBins bins when the queue is prepared. The quantiles are copied into the window when it is closed.
+ * @details With deadbands configured the sampling task runs each sample through the deadband filter (@ref AppTelemetryPayload_ApplyDeadband()) before it is added to the open batch.
+ * A sample with all of its values suppressed is not added. The numbers of sent and suppressed values are counted in @ref AppStatus stats when a batch is flushed.
+ * The deadbands do not apply in the aggregation mode.
+ * @details With multi-rate sampling each sample carries the presence bits of the sensors read for it, the values of the other sensors are not sent.
+ * A sample without any of the selected sensors present is not added. In the aggregation mode the statistics of a channel only count the samples its sensor was read for.
  *
  * @author $(SOLACE_APP_AUTHOR)
  *
@@ -26,6 +46,8 @@
 #define BCDS_MODULE_ID SOLACE_APP_MODULE_ID_APP_TELEMETRY_QUEUE
 
 #include "AppTelemetryQueue.h"
+#include "AppTelemetryRing.h"
+#include "AppStatus.h"
 #include "AppMisc.h"
 
 #include "FreeRTOS.h"
@@ -36,6 +58,7 @@ static SemaphoreHandle_t appTelemetryQueue_ChangeSemaphoreHandle = NULL; /**< se
 
 /**
  * @brief Block access to the queue to change its configuration.
+ * @return bool: true if access was blocked, false if the semaphore could not be taken in time
  */
 static bool appTelemetryQueue_BlockAccess(void) {
 	if(pdTRUE != xSemaphoreTake(appTelemetryQueue_ChangeSemaphoreHandle, MILLISECONDS(APP_TELEMETRY_QUEUE_CHANGE_INTERNAL_WAIT_TICKS)) ) {
@@ -50,18 +73,64 @@ static void appTelemetryQueue_AllowAccess(void) {
 	xSemaphoreGive(appTelemetryQueue_ChangeSemaphoreHandle);
 }
 
-// the write queue
-static cJSON * appTelemetryQueue_WriteJsonHandle = NULL;		/**< the write queue handle */
-static uint8_t appTelemetryQueue_WriteJsonArrayCurrentSize = 0;	/**< the current size of the write queue */
-static SemaphoreHandle_t appTelemetryQueue_WriteSemaphoreHandle = NULL; /**< semaphore for the write queue */
-// the read queue
-static cJSON * appTelemetryQueue_ReadJsonHandle = NULL; /**< the read queue handle */
-static SemaphoreHandle_t appTelemetryQueue_ReadSemaphoreHandle = NULL; /**< the read queue semaphore */
-#define APP_TELEMETRY_QUEUE_READ_INTERNAL_WAIT_TICKS			UINT32_C(10) /**< wait ticks to get the read semaphore */
+/**
+ * @brief Element of the ring: a sample and the batch boundary.
+ */
+typedef struct {
+	AppTelemetryPayload_Sample_T sample; /**< the sample */
+	bool isBatchStart; /**< true for the first sample of a batch */
+} AppTelemetryQueue_Element_T;
+/**
+ * @brief Reason for flushing a batch.
+ */
+typedef enum {
+	AppTelemetryQueue_FlushReason_Count = 0, /**< numberOfSamplesPerEvent reached */
+	AppTelemetryQueue_FlushReason_Bytes, /**< the next sample would exceed batchMaxBytes */
+	AppTelemetryQueue_FlushReason_Age, /**< batchMaxAgeMillis reached */
+} AppTelemetryQueue_FlushReason_T;
+
+static AppTelemetryRing_T appTelemetryQueue_Ring = { .bufferPtr = NULL, .elementSize = 0, .capacity = 0, .writeIndex = 0, .readIndex = 0, .dropSequence = 0, .markIndex = 0, .dropMark = 0 }; /**< the sample ring */
 // trigger for reading
-static SemaphoreHandle_t appTelemetryQueue_ReadTriggerSemaphoreHandle = NULL; /**< semaphore to trigger reading / indicate the queue is full */
+static SemaphoreHandle_t appTelemetryQueue_ReadTriggerSemaphoreHandle = NULL; /**< semaphore to trigger reading / indicate a batch is complete */
+
+static uint8_t appTelemetryQueue_FullSize = 1; /**< variable for the full size of a batch in the telemetry queue */
+
+static uint8_t appTelemetryQueue_BacklogSize = APP_RT_CFG_DEFAULT_QUEUE_BACKLOG_EVENTS; /**< number of batches the ring holds */
+
+static AppRuntimeConfig_Telemetry_QueueDropPolicy_T appTelemetryQueue_DropPolicy = APP_RT_CFG_DEFAULT_QUEUE_DROP_POLICY; /**< what to discard if the backlog is full */
+
+static uint32_t appTelemetryQueue_BatchMaxBytes = APP_RT_CFG_DEFAULT_BATCH_MAX_BYTES; /**< byte budget of a batch */
+
+static TickType_t appTelemetryQueue_BatchMaxAgeTicks = MILLISECONDS(APP_RT_CFG_DEFAULT_BATCH_MAX_AGE_MILLIS); /**< max age of a batch, 0 for no limit */
+
+static TickType_t appTelemetryQueue_AggregateWindowTicks = MILLISECONDS(APP_RT_CFG_DEFAULT_AGGREGATE_WINDOW_MILLIS); /**< window length of the aggregation mode, 0 for raw samples */
+
+static TickType_t appTelemetryQueue_SamplingPeriodTicks = 0; /**< the sampling period, to close a window before the sample that would exceed it */
+
+/* the open batch, sampling task only */
+static AppTelemetryPayload_BatchSize_T appTelemetryQueue_OpenBatchSize = { .numberOfSamples = 0, .size = 0, .firstTickCount = 0 }; /**< number of samples and encoded size of the open batch */
+
+/* the deadband filter, sampling task only */
+static AppTelemetryPayload_DeadbandState_T appTelemetryQueue_DeadbandState = { .isValid = false }; /**< last sent value per sensor channel */
+
+static volatile uint32_t appTelemetryQueue_DropOldestCount = 0; /**< samples dropped with policy drop oldest, written by the sampling task only, see @ref AppTelemetryQueue_PushStats() */
+
+static volatile uint32_t appTelemetryQueue_DropNewestCount = 0; /**< samples / windows dropped with policy drop newest, written by the sampling task only, see @ref AppTelemetryQueue_PushStats() */
+
+static uint32_t appTelemetryQueue_DropOldestPushedCount = 0; /**< appTelemetryQueue_DropOldestCount at the last push to the stats, publishing task only */
+
+static uint32_t appTelemetryQueue_DropNewestPushedCount = 0; /**< appTelemetryQueue_DropNewestCount at the last push to the stats, publishing task only */
 
-static uint8_t appTelemetryQueue_FullSize = 1; /**< variable for the full size of the telemetry queue */
+static uint32_t appTelemetryQueue_DeadbandSentCount = 0; /**< number of values sent since the last flush, counted in the stats on flush */
+
+static uint32_t appTelemetryQueue_DeadbandSuppressedCount = 0; /**< number of values suppressed since the last flush, counted in the stats on flush */
+
+/* the open window of the aggregation mode, sampling task only */
+static AppTelemetryPayload_Aggregate_T appTelemetryQueue_OpenAggregate; /**< statistics of the samples of the open window */
+
+static AppTelemetrySketch_T appTelemetryQueue_Sketches[APP_TELEMETRY_PAYLOAD_NUMBER_OF_SKETCH_CHANNELS]; /**< quantile sketches of the accelerometer and gyroscope values of the open window */
+
+static uint32_t appTelemetryQueue_QuantileSketchBins = 0; /**< number of bins per sketch, 0 if no quantile is selected */
 
 /**
  * @brief Initialize the module.
@@ -77,17 +146,6 @@ Retcode_T AppTelemetryQueue_Init(void) {
 		if(appTelemetryQueue_ChangeSemaphoreHandle == NULL) return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_FAILED_TO_CREATE_SEMAPHORE);
 		xSemaphoreGive(appTelemetryQueue_ChangeSemaphoreHandle);
 	}
-
-	if(RETCODE_OK == retcode) {
-		appTelemetryQueue_WriteSemaphoreHandle = xSemaphoreCreateBinary();
-		if(appTelemetryQueue_WriteSemaphoreHandle == NULL) return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_FAILED_TO_CREATE_SEMAPHORE);
-		xSemaphoreGive(appTelemetryQueue_WriteSemaphoreHandle);
-	}
-	if(RETCODE_OK == retcode) {
-		appTelemetryQueue_ReadSemaphoreHandle = xSemaphoreCreateBinary();
-		if(appTelemetryQueue_ReadSemaphoreHandle == NULL) return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_FAILED_TO_CREATE_SEMAPHORE);
-		xSemaphoreGive(appTelemetryQueue_ReadSemaphoreHandle);
-	}
 	if(RETCODE_OK == retcode) {
 		appTelemetryQueue_ReadTriggerSemaphoreHandle = xSemaphoreCreateBinary();
 		if(appTelemetryQueue_ReadTriggerSemaphoreHandle == NULL) return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_FAILED_TO_CREATE_SEMAPHORE);
@@ -98,7 +156,7 @@ Retcode_T AppTelemetryQueue_Init(void) {
 }
 /**
  * @brief Setup the module with the configuration.
- * @param[in] configPtr: the runtime configuration
+ * @param[in] configPtr: the runtime configuration. Module requires targetTelemetryConfigPtr, activeTelemetryRTParamsPtr
  * @return Retcode_T: RETCODE_OK
  * @return Retcode_T: retcode from @ref AppTelemetryQueue_ApplyNewRuntimeConfig()
  */
@@ -106,31 +164,52 @@ Retcode_T AppTelemetryQueue_Setup(const AppRuntimeConfig_T * configPtr) {
 	Retcode_T retcode = RETCODE_OK;
 
 	assert(configPtr != NULL);
+	assert(configPtr->targetTelemetryConfigPtr);
 	assert(configPtr->activeTelemetryRTParamsPtr);
 
+	if(RETCODE_OK == retcode) retcode = AppTelemetryQueue_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr->targetTelemetryConfigPtr);
+
 	if(RETCODE_OK == retcode) retcode = AppTelemetryQueue_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, configPtr->activeTelemetryRTParamsPtr);
 
 	return retcode;
 }
 /**
- * @brief Prepare the telemetry queue. Creates the internal write and read JSON handles, releases the write / read semaphores respectively and blocks the read-trigger semaphore.
- * @param[in] queueSize: the number of samples in the queue before the read trigger semaphore is released. Saved in internal variable #appTelemetryQueue_FullSize
+ * @brief Prepare the telemetry queue. (Re-)creates the ring if the batch or backlog size or the mode changed, discards any samples and blocks the read-trigger semaphore.
+ * @details In the aggregation mode the ring holds queueBacklogEvents windows. The quantile sketches are (re-)created if their number of bins changed.
+ * @note Call only while neither the sampling nor the publishing task is running.
+ * @param[in] queueSize: the number of samples in a batch before the read trigger semaphore is released. Saved in internal variable #appTelemetryQueue_FullSize
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_TELEMETRY_QUEUE_SIZE_IS_ZERO)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_TELEMETRY_QUEUE_FAILED_TO_ALLOCATE)
  */
-static void appTelemetryQueue_Prepare(uint8_t queueSize) {
+static Retcode_T appTelemetryQueue_Prepare(uint8_t queueSize) {
 
-	assert(queueSize>0);
+	if(0 == queueSize) return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_TELEMETRY_QUEUE_SIZE_IS_ZERO);
 
-	// set ready to write
-	if(NULL != appTelemetryQueue_WriteJsonHandle) cJSON_Delete(appTelemetryQueue_WriteJsonHandle);
-	appTelemetryQueue_WriteJsonHandle = cJSON_CreateArray();
-	appTelemetryQueue_WriteJsonArrayCurrentSize = 0;
-	xSemaphoreGive(appTelemetryQueue_WriteSemaphoreHandle);
+	bool isAggregate = (appTelemetryQueue_AggregateWindowTicks > 0);
+	uint32_t capacity = isAggregate ? appTelemetryQueue_BacklogSize : (uint32_t) queueSize * appTelemetryQueue_BacklogSize;
+	uint32_t elementSize = isAggregate ? sizeof(AppTelemetryPayload_Aggregate_T) : sizeof(AppTelemetryQueue_Element_T);
 
-	// set ready to read
-	if(NULL != appTelemetryQueue_ReadJsonHandle) cJSON_Delete(appTelemetryQueue_ReadJsonHandle);
-	appTelemetryQueue_ReadJsonHandle = NULL;
-	xSemaphoreGive(appTelemetryQueue_ReadSemaphoreHandle);
-	//if(pdTRUE != xSemaphoreTake(appTelemetryQueue_ReadSemaphoreHandle, 0)) assert(0);
+	if(capacity != appTelemetryQueue_Ring.capacity || elementSize != appTelemetryQueue_Ring.elementSize) {
+		AppTelemetryRing_Delete(&appTelemetryQueue_Ring);
+		if(!AppTelemetryRing_Create(&appTelemetryQueue_Ring, elementSize, capacity)) {
+			return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_TELEMETRY_QUEUE_FAILED_TO_ALLOCATE);
+		}
+	} else {
+		AppTelemetryRing_Reset(&appTelemetryQueue_Ring);
+	}
+
+	uint32_t numberOfBins = isAggregate ? appTelemetryQueue_QuantileSketchBins : 0;
+	for(uint32_t i = 0; i < APP_TELEMETRY_PAYLOAD_NUMBER_OF_SKETCH_CHANNELS; i++) {
+		if(numberOfBins != appTelemetryQueue_Sketches[i].numberOfBins) {
+			AppTelemetrySketch_Delete(&appTelemetryQueue_Sketches[i]);
+			if(numberOfBins > 0 && !AppTelemetrySketch_Create(&appTelemetryQueue_Sketches[i], numberOfBins)) {
+				return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_TELEMETRY_QUEUE_FAILED_TO_ALLOCATE);
+			}
+		} else if(numberOfBins > 0) {
+			AppTelemetrySketch_Reset(&appTelemetryQueue_Sketches[i]);
+		}
+	}
 
 	// block the read trigger
 	xSemaphoreGive(appTelemetryQueue_ReadTriggerSemaphoreHandle);
@@ -138,199 +217,432 @@ static void appTelemetryQueue_Prepare(uint8_t queueSize) {
 
 	// set the size
 	appTelemetryQueue_FullSize = queueSize;
+
+	AppTelemetryPayload_ResetBatchSize(&appTelemetryQueue_OpenBatchSize);
+
+	AppTelemetryPayload_ResetAggregate(&appTelemetryQueue_OpenAggregate);
+
+	AppTelemetryPayload_ResetDeadband(&appTelemetryQueue_DeadbandState);
+	appTelemetryQueue_DeadbandSentCount = 0;
+	appTelemetryQueue_DeadbandSuppressedCount = 0;
+
+	return RETCODE_OK;
 }
 /**
  * @brief External interface to prepare the telemetry queue.
  * @see appTelemetryQueue_Prepare()
  * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_QUEUE_CANT_TAKE_SEMAPHORE)
+ * @return Retcode_T: retcode from @ref appTelemetryQueue_Prepare()
  */
 Retcode_T AppTelemetryQueue_Prepare(void) {
 
-	assert(appTelemetryQueue_BlockAccess());
+	if(!appTelemetryQueue_BlockAccess()) return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_QUEUE_CANT_TAKE_SEMAPHORE);
 
-	Retcode_T retcode = RETCODE_OK;
-
-	appTelemetryQueue_Prepare(appTelemetryQueue_FullSize);
+	Retcode_T retcode = appTelemetryQueue_Prepare(appTelemetryQueue_FullSize);
 
 	appTelemetryQueue_AllowAccess();
 
 	return retcode;
 
 }
+/**
+ * @brief Apply the runtime parameters of a new telemetry rate of @ref AppTelemetryRateControl without discarding the queued samples.
+ * @details The rate control keeps the number of samples per event and stretches the sampling period, so the ring keeps its layout:
+ * only the sampling period is taken over, the flushed batches, the open batch or window and the deadband state are kept.
+ * Use instead of #AppRuntimeConfig_Element_activeTelemetryRTParams with @ref AppTelemetryQueue_ApplyNewRuntimeConfig(), and don't call @ref AppTelemetryQueue_Prepare() afterwards.
+ * Parameters with a different number of samples per event change the layout: nothing is applied, apply them with @ref AppTelemetryQueue_ApplyNewRuntimeConfig() instead.
+ * @note Call only while neither the sampling nor the publishing task is running.
+ * @param[in] rtParamsPtr: the runtime parameters of the new rate
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_TELEMETRY_QUEUE_LAYOUT_CHANGED)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_QUEUE_CANT_TAKE_SEMAPHORE)
+ */
+Retcode_T AppTelemetryQueue_ApplyNewRate(const AppRuntimeConfig_TelemetryRTParams_T * rtParamsPtr) {
+
+	assert(rtParamsPtr);
+
+	if(rtParamsPtr->numberOfSamplesPerEvent != appTelemetryQueue_FullSize) return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_TELEMETRY_QUEUE_LAYOUT_CHANGED);
+
+	if(!appTelemetryQueue_BlockAccess()) return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_QUEUE_CANT_TAKE_SEMAPHORE);
+
+	appTelemetryQueue_SamplingPeriodTicks = MILLISECONDS(rtParamsPtr->samplingPeriodicityMillis);
+
+	appTelemetryQueue_AllowAccess();
+
+	return RETCODE_OK;
+}
 /**
  * @brief Apply a new runtime configuration to the module.
- * @param[in] configElement: the type of configuration to apply. Only #AppRuntimeConfig_Element_activeTelemetryRTParams is supported.
+ * @details AppRuntimeConfig_Element_targetTelemetryConfig: the backlog size, drop policy, flush criteria, aggregation window and number of sketch bins. Takes effect with the next #AppRuntimeConfig_Element_activeTelemetryRTParams or @ref AppTelemetryQueue_Prepare().
+ * @details AppRuntimeConfig_Element_activeTelemetryRTParams: the batch size and sampling period. Prepares the queue.
+ * @param[in] configElement: the type of configuration to apply.
  * @param[in] newConfigPtr: the configuration of type configElement
+ * @return Retcode_T: RETCODE_OK
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_QUEUE_CANT_TAKE_SEMAPHORE)
+ * @return Retcode_T: retcode from @ref appTelemetryQueue_Prepare()
  */
 Retcode_T AppTelemetryQueue_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr) {
 
 	assert(newConfigPtr);
 
-	if(configElement != AppRuntimeConfig_Element_activeTelemetryRTParams) return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT);
-
-	assert(appTelemetryQueue_BlockAccess());
-
 	Retcode_T retcode = RETCODE_OK;
 
-	appTelemetryQueue_Prepare(((AppRuntimeConfig_TelemetryRTParams_T *) newConfigPtr)->numberOfSamplesPerEvent);
+	if(!appTelemetryQueue_BlockAccess()) return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_QUEUE_CANT_TAKE_SEMAPHORE);
+
+	switch(configElement) {
+	case AppRuntimeConfig_Element_targetTelemetryConfig:
+		appTelemetryQueue_BacklogSize = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.queueBacklogEvents;
+		appTelemetryQueue_DropPolicy = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.queueDropPolicy;
+		if(0 == appTelemetryQueue_BacklogSize) appTelemetryQueue_BacklogSize = 1;
+		appTelemetryQueue_BatchMaxBytes = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.batchMaxBytes;
+		appTelemetryQueue_BatchMaxAgeTicks = MILLISECONDS(((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.batchMaxAgeMillis);
+		appTelemetryQueue_AggregateWindowTicks = MILLISECONDS(((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.aggregateWindowMillis);
+		{
+			const AppRuntimeConfig_Aggregates_T * aggregatesPtr = &((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.aggregates;
+			bool isQuantile = (aggregatesPtr->isP50 || aggregatesPtr->isP95 || aggregatesPtr->isP99);
+			appTelemetryQueue_QuantileSketchBins = isQuantile ? ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.quantileSketchBins : 0;
+		}
+		break;
+	case AppRuntimeConfig_Element_activeTelemetryRTParams:
+		appTelemetryQueue_SamplingPeriodTicks = MILLISECONDS(((AppRuntimeConfig_TelemetryRTParams_T *) newConfigPtr)->samplingPeriodicityMillis);
+		retcode = appTelemetryQueue_Prepare(((AppRuntimeConfig_TelemetryRTParams_T *) newConfigPtr)->numberOfSamplesPerEvent);
+		break;
+	default: retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT);
+	}
 
 	appTelemetryQueue_AllowAccess();
 
 	return retcode;
 }
 /**
- * @brief Add a sensor sample to the queue. Waits a max of waitTicks to obtain the write semaphore handle.
- *
- * @param[in] payloadPtr : the sample payload to add
- * @param[in] waitTicks : the ticks to wait to obtain the queue write semaphore handle
- *
+ * @brief Flush the open batch: makes it visible to the reader and releases the read-trigger semaphore. Sampling task only.
+ * @details Also counts the values sent and suppressed by the deadband filter since the last flush in the stats.
+ * @param[in] flushReason: the reason, counted in the stats
+ */
+static void appTelemetryQueue_FlushOpenBatch(AppTelemetryQueue_FlushReason_T flushReason) {
+
+	AppTelemetryRing_SetMark(&appTelemetryQueue_Ring);
+
+	AppTelemetryPayload_ResetBatchSize(&appTelemetryQueue_OpenBatchSize);
+
+	xSemaphoreGive(appTelemetryQueue_ReadTriggerSemaphoreHandle);
+
+	switch(flushReason) {
+	case AppTelemetryQueue_FlushReason_Count: AppStatus_Stats_IncrementTelemetryQueueFlushOnCountCounter(); break;
+	case AppTelemetryQueue_FlushReason_Bytes: AppStatus_Stats_IncrementTelemetryQueueFlushOnBytesCounter(); break;
+	case AppTelemetryQueue_FlushReason_Age: AppStatus_Stats_IncrementTelemetryQueueFlushOnAgeCounter(); break;
+	default: assert(0);
+	}
+
+	if(appTelemetryQueue_DeadbandSentCount > 0 || appTelemetryQueue_DeadbandSuppressedCount > 0) {
+		AppStatus_Stats_IncrementTelemetryDeadbandCounters(appTelemetryQueue_DeadbandSentCount, appTelemetryQueue_DeadbandSuppressedCount);
+		appTelemetryQueue_DeadbandSentCount = 0;
+		appTelemetryQueue_DeadbandSuppressedCount = 0;
+	}
+}
+/**
+ * @brief Flush the open batch if its first sample is batchMaxAgeMillis old. Sampling task only.
+ * @param[in] tickCount: the current tick count
+ */
+static void appTelemetryQueue_CheckOpenBatchAge(const TickType_t tickCount) {
+
+	if(appTelemetryQueue_OpenBatchSize.numberOfSamples > 0 && appTelemetryQueue_BatchMaxAgeTicks > 0 && (tickCount - appTelemetryQueue_OpenBatchSize.firstTickCount) >= appTelemetryQueue_BatchMaxAgeTicks) {
+		appTelemetryQueue_FlushOpenBatch(AppTelemetryQueue_FlushReason_Age);
+	}
+}
+/**
+ * @brief Drop the oldest flushed batch to make room. Sampling task only.
+ * @details Counts the dropped samples locally, the publishing task pushes them to the stats with @ref AppTelemetryQueue_PushStats().
+ */
+static void appTelemetryQueue_DropOldestBatch(void) {
+
+	uint32_t numberOfFlushedSamples = AppTelemetryRing_BeginDrop(&appTelemetryQueue_Ring);
+
+	if(0 == numberOfFlushedSamples) return;
+
+	// a window is a single element
+	uint32_t batchSize = 1;
+	while(appTelemetryQueue_AggregateWindowTicks == 0 && batchSize < numberOfFlushedSamples && !((const AppTelemetryQueue_Element_T *) AppTelemetryRing_GetDropSlot(&appTelemetryQueue_Ring, batchSize))->isBatchStart) batchSize++;
+
+	// fails only if the reader released a batch in the meantime, either way there is room now
+	if(appTelemetryQueue_AggregateWindowTicks > 0) {
+		// count the samples of the window
+		uint32_t numberOfSamples = ((const AppTelemetryPayload_Aggregate_T *) AppTelemetryRing_GetDropSlot(&appTelemetryQueue_Ring, 0))->numberOfSamples;
+		if(AppTelemetryRing_DropOldest(&appTelemetryQueue_Ring, batchSize)) appTelemetryQueue_DropOldestCount += numberOfSamples;
+		return;
+	}
+
+	if(AppTelemetryRing_DropOldest(&appTelemetryQueue_Ring, batchSize)) appTelemetryQueue_DropOldestCount += batchSize;
+}
+/**
+ * @brief Add a sample to the open window of the aggregation mode and close the window if the next sample would fall outside of it. Sampling task only.
+ * @details The closed window is copied into the ring and the read-trigger semaphore released. If the backlog is full, the drop policy applies to whole windows.
+ * @param[in] tickCount : the tick count at the time of sampling
+ * @param[in] sensorValuePtr : the sensor readings
+ * @param[in] presentSensors : APP_TELEMETRY_PAYLOAD_SENSOR_* bits of the sensors read for the sample
  * @return Retcode_T: RETCODE_OK
- * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_QUEUE_ALREADY_FULL) - indicates sync mismatch between reader and writer
- * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_QUEUE_CANT_TAKE_SEMAPHORE) when queue is blocked for writing
- *
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_TELEMETRY_QUEUE_ALREADY_FULL) - the reader is behind, the closed window was discarded
  */
-Retcode_T AppTelemetryQueue_AddSample(AppTelemetryPayload_T * payloadPtr, const uint32_t waitTicks) {
+static Retcode_T appTelemetryQueue_AddSampleToAggregate(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr, uint8_t presentSensors) {
 
-	assert(payloadPtr);
+	AppTelemetryPayload_Sample_T sample;
+	AppTelemetryPayload_PopulateSample(&sample, tickCount, sensorValuePtr, presentSensors);
 
-	assert(appTelemetryQueue_BlockAccess());
+	AppTelemetryPayload_AddSampleToAggregate(&appTelemetryQueue_OpenAggregate, &sample);
+	if(appTelemetryQueue_QuantileSketchBins > 0) AppTelemetryPayload_AddSampleToSketches(appTelemetryQueue_Sketches, &sample);
 
-	Retcode_T retcode = RETCODE_OK;
+	if((tickCount - appTelemetryQueue_OpenAggregate.firstTickCount) + appTelemetryQueue_SamplingPeriodTicks < appTelemetryQueue_AggregateWindowTicks) return RETCODE_OK;
+
+	if(appTelemetryQueue_QuantileSketchBins > 0) AppTelemetryPayload_SetAggregateQuantiles(&appTelemetryQueue_OpenAggregate, appTelemetryQueue_Sketches);
 
-	if(pdTRUE == xSemaphoreTake(appTelemetryQueue_WriteSemaphoreHandle, waitTicks)) {
+	AppTelemetryPayload_Aggregate_T * aggregatePtr = (AppTelemetryPayload_Aggregate_T *) AppTelemetryRing_GetWriteSlot(&appTelemetryQueue_Ring);
 
-		if ( appTelemetryQueue_WriteJsonArrayCurrentSize < appTelemetryQueue_FullSize ) {
+	if(NULL == aggregatePtr && AppRuntimeConfig_Telemetry_QueueDropPolicy_DropOldest == appTelemetryQueue_DropPolicy) {
+		appTelemetryQueue_DropOldestBatch();
+		aggregatePtr = (AppTelemetryPayload_Aggregate_T *) AppTelemetryRing_GetWriteSlot(&appTelemetryQueue_Ring);
+	}
 
-			assert(appTelemetryQueue_WriteJsonHandle);
+	if(NULL == aggregatePtr) {
+		AppTelemetryPayload_ResetAggregate(&appTelemetryQueue_OpenAggregate);
+		appTelemetryQueue_DropNewestCount++;
+		return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_TELEMETRY_QUEUE_ALREADY_FULL);
+	}
 
-			// add the item
-			cJSON_AddItemToArray(appTelemetryQueue_WriteJsonHandle, payloadPtr);
-			appTelemetryQueue_WriteJsonArrayCurrentSize++;
+	*aggregatePtr = appTelemetryQueue_OpenAggregate;
 
-			// is it full now? if so, change over
-			if(appTelemetryQueue_WriteJsonArrayCurrentSize == appTelemetryQueue_FullSize) {
+	AppTelemetryRing_CommitWrite(&appTelemetryQueue_Ring);
+	AppTelemetryRing_SetMark(&appTelemetryQueue_Ring);
 
-				// set the read handle
-				if(pdTRUE == xSemaphoreTake(appTelemetryQueue_ReadSemaphoreHandle, APP_TELEMETRY_QUEUE_READ_INTERNAL_WAIT_TICKS)) {
+	AppTelemetryPayload_ResetAggregate(&appTelemetryQueue_OpenAggregate);
 
-					// the old one may not have been pickup up
-					if(NULL != appTelemetryQueue_ReadJsonHandle) cJSON_Delete(appTelemetryQueue_ReadJsonHandle);
+	xSemaphoreGive(appTelemetryQueue_ReadTriggerSemaphoreHandle);
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Add a sensor sample to the queue. Called by the sampling task only (single producer).
+ * @details Populates the record in place in the ring. Does not allocate and does not block, unless a flush has to be counted in the stats. Drops are counted locally, see @ref AppTelemetryQueue_PushStats().
+ * Flushes the open batch before the sample if the sample would take it over the byte budget, and after the sample if it is full or old enough.
+ * @details If the backlog is full: #AppRuntimeConfig_Telemetry_QueueDropPolicy_DropOldest discards the oldest flushed batch,
+ * #AppRuntimeConfig_Telemetry_QueueDropPolicy_DropNewest discards this sample.
+ * @details With deadbands configured, the sample is run through the deadband filter first. If all of its values are suppressed, it is not added
+ * and only the age of the open batch is checked. The same applies to a sample without any of the selected sensors present.
+ * @details In the aggregation mode the sample is added to the open window instead, see appTelemetryQueue_AddSampleToAggregate().
+ *
+ * @param[in] tickCount : the tick count at the time of sampling
+ * @param[in] sensorValuePtr : the sensor readings, the values of sensors not read for the sample hold their last reading
+ * @param[in] presentSensors : APP_TELEMETRY_PAYLOAD_SENSOR_* bits of the sensors read for the sample
+ *
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_TELEMETRY_QUEUE_ALREADY_FULL) - the reader is behind, the sample was discarded
+ *
+ */
+Retcode_T AppTelemetryQueue_AddSample(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr, uint8_t presentSensors) {
 
-					appTelemetryQueue_ReadJsonHandle = appTelemetryQueue_WriteJsonHandle;
+	assert(sensorValuePtr);
 
-					xSemaphoreGive(appTelemetryQueue_ReadSemaphoreHandle);
+	if(appTelemetryQueue_AggregateWindowTicks > 0) return appTelemetryQueue_AddSampleToAggregate(tickCount, sensorValuePtr, presentSensors);
 
-					// trigger read
-					// note: at config change it may be that last message was not read
-					// hence, give semaphore without checking
-					//if(pdTRUE != xSemaphoreGive(appTelemetryQueueReadTriggerSemaphoreHandle)) assert(0);
-					xSemaphoreGive(appTelemetryQueue_ReadTriggerSemaphoreHandle);
+	// nothing to send, none of the selected sensors was read
+	if(!AppTelemetryPayload_IsAnySensorPresent(presentSensors)) {
+		appTelemetryQueue_CheckOpenBatchAge(tickCount);
+		return RETCODE_OK;
+	}
 
-				} else {
-					assert(0);
-				}
+	AppTelemetryQueue_Element_T * elementPtr = (AppTelemetryQueue_Element_T *) AppTelemetryRing_GetWriteSlot(&appTelemetryQueue_Ring);
 
-				// create a new write handle
-				appTelemetryQueue_WriteJsonHandle = cJSON_CreateArray();
-				appTelemetryQueue_WriteJsonArrayCurrentSize = 0;
+	if(NULL == elementPtr && AppRuntimeConfig_Telemetry_QueueDropPolicy_DropOldest == appTelemetryQueue_DropPolicy) {
+		appTelemetryQueue_DropOldestBatch();
+		elementPtr = (AppTelemetryQueue_Element_T *) AppTelemetryRing_GetWriteSlot(&appTelemetryQueue_Ring);
+	}
 
-			}
+	if(NULL == elementPtr) {
+		appTelemetryQueue_DropNewestCount++;
+		return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_TELEMETRY_QUEUE_ALREADY_FULL);
+	}
 
-		} else {
-			// indicates sync mismatch between writer & reader
-			retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_QUEUE_ALREADY_FULL);
+	AppTelemetryPayload_PopulateSample(&elementPtr->sample, tickCount, sensorValuePtr, presentSensors);
+
+	if(AppTelemetryPayload_IsDeadband()) {
+		uint32_t numberOfSuppressed = 0;
+		uint32_t numberOfSent = AppTelemetryPayload_ApplyDeadband(&appTelemetryQueue_DeadbandState, &elementPtr->sample, &numberOfSuppressed);
+		appTelemetryQueue_DeadbandSentCount += numberOfSent;
+		appTelemetryQueue_DeadbandSuppressedCount += numberOfSuppressed;
+		// nothing to send, the slot is not committed
+		if(0 == numberOfSent) {
+			appTelemetryQueue_CheckOpenBatchAge(tickCount);
+			return RETCODE_OK;
 		}
+	}
 
-		// allow writing again
-		xSemaphoreGive(appTelemetryQueue_WriteSemaphoreHandle);
+	uint32_t batchSize = AppTelemetryPayload_GetBatchSizeWithSample(&appTelemetryQueue_OpenBatchSize, &elementPtr->sample);
 
-	} else retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_QUEUE_CANT_TAKE_SEMAPHORE);
+	// the sample doesn't fit into the open batch any more
+	if(appTelemetryQueue_OpenBatchSize.numberOfSamples > 0 && batchSize > appTelemetryQueue_BatchMaxBytes) {
+		appTelemetryQueue_FlushOpenBatch(AppTelemetryQueue_FlushReason_Bytes);
+		batchSize = AppTelemetryPayload_GetBatchSizeWithSample(&appTelemetryQueue_OpenBatchSize, &elementPtr->sample);
+	}
 
-	appTelemetryQueue_AllowAccess();
+	elementPtr->isBatchStart = (0 == appTelemetryQueue_OpenBatchSize.numberOfSamples);
 
-	return retcode;
+	AppTelemetryPayload_AddSampleToBatchSize(&appTelemetryQueue_OpenBatchSize, &elementPtr->sample, batchSize);
+
+	AppTelemetryRing_CommitWrite(&appTelemetryQueue_Ring);
+
+	if(appTelemetryQueue_OpenBatchSize.numberOfSamples >= appTelemetryQueue_FullSize) {
+		appTelemetryQueue_FlushOpenBatch(AppTelemetryQueue_FlushReason_Count);
+	} else if(appTelemetryQueue_BatchMaxAgeTicks > 0 && (tickCount - appTelemetryQueue_OpenBatchSize.firstTickCount) >= appTelemetryQueue_BatchMaxAgeTicks) {
+		appTelemetryQueue_FlushOpenBatch(AppTelemetryQueue_FlushReason_Age);
+	}
+
+	return RETCODE_OK;
 }
 /**
- * @brief Wait for waitTicks for a full queue based on the read-trigger semaphore. Used by @ref AppTelemetryPublish
- * @param[in] waitTicks: the number of ticks to wait for the read-trigger semaphore to become available
+ * @brief Wait for waitTicks for a flushed batch in the queue. Used by @ref AppTelemetryPublish
+ * @details Returns immediately if a flushed batch is available, otherwise waits on the read-trigger semaphore.
+ * @param[in] waitTicks: the max number of ticks to wait for a complete batch
  * @return Retcode_T: RETCODE_OK
- * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_QUEUE_CANT_TAKE_SEMAPHORE)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_QUEUE_NOT_FULL)
  */
 Retcode_T AppTelemetryQueue_Wait4FullQueue(uint32_t waitTicks) {
-	Retcode_T retcode = RETCODE_OK;
 
-	if(pdTRUE != xSemaphoreTake(appTelemetryQueue_ReadTriggerSemaphoreHandle, waitTicks)) retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_QUEUE_CANT_TAKE_SEMAPHORE);
+	TickType_t startTicks = xTaskGetTickCount();
+	TickType_t elapsedTicks = 0;
 
-	return retcode;
+	while(0 == AppTelemetryRing_GetMarkedCount(&appTelemetryQueue_Ring)) {
+
+		elapsedTicks = xTaskGetTickCount() - startTicks;
+		if(elapsedTicks >= waitTicks) return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_QUEUE_NOT_FULL);
+
+		// a stale trigger just causes another check
+		xSemaphoreTake(appTelemetryQueue_ReadTriggerSemaphoreHandle, waitTicks - elapsedTicks);
+	}
+
+	return RETCODE_OK;
 }
 /**
- * @brief Retrieve the data from a full queue as a string and delete the internal read queue. Used by @ref AppTelemetryPublish.
- * @return char *: the data string to publish
+ * @brief Retrieve the oldest flushed batch from the queue and release its samples. Used by @ref AppTelemetryPublish (single consumer).
+ * @details Copies the sample records out of the ring, formatting of the payload is left to the caller.
+ * If the sampling task dropped the batch while it was being copied, the copy is discarded and the next oldest batch is retrieved.
+ * @param[out] samplesPtr: array of maxNumberOfSamples sample records to copy the batch into
+ * @param[in] maxNumberOfSamples: the size of the array, must be >= numberOfSamplesPerEvent
+ * @param[out] numberOfSamplesPtr: the number of samples copied
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_QUEUE_NOT_FULL) - there is no flushed batch
  */
-char * AppTelemetryQueue_RetrieveData(void) {
+Retcode_T AppTelemetryQueue_RetrieveBatch(AppTelemetryPayload_Sample_T * samplesPtr, uint8_t maxNumberOfSamples, uint8_t * numberOfSamplesPtr) {
 
-	assert(appTelemetryQueue_BlockAccess());
+	assert(samplesPtr);
+	assert(numberOfSamplesPtr);
+	assert(0 == appTelemetryQueue_AggregateWindowTicks);
 
-	char * payloadStr = NULL;
-	if(pdTRUE == xSemaphoreTake(appTelemetryQueue_ReadSemaphoreHandle, APP_TELEMETRY_QUEUE_READ_INTERNAL_WAIT_TICKS)) {
+	assert(appTelemetryQueue_FullSize <= maxNumberOfSamples);
 
-		if(appTelemetryQueue_ReadJsonHandle != NULL) {
-			payloadStr = cJSON_PrintUnformatted(appTelemetryQueue_ReadJsonHandle);
-			cJSON_Delete(appTelemetryQueue_ReadJsonHandle);
-			appTelemetryQueue_ReadJsonHandle = NULL;
-		}
+	*numberOfSamplesPtr = 0;
 
-		xSemaphoreGive(appTelemetryQueue_ReadSemaphoreHandle);
+	// each retry means the producer dropped a batch, bounded by the backlog
+	for(uint8_t attempt = 0; attempt <= appTelemetryQueue_BacklogSize; attempt++) {
 
-	} else assert(0);
+		AppTelemetryRing_BeginRead(&appTelemetryQueue_Ring);
 
-	appTelemetryQueue_AllowAccess();
+		uint32_t numberOfFlushedSamples = AppTelemetryRing_GetReadMarkedCount(&appTelemetryQueue_Ring);
+		if(0 == numberOfFlushedSamples) break;
+
+		uint8_t batchSize = 0;
+		do {
+			const AppTelemetryQueue_Element_T * elementPtr = (const AppTelemetryQueue_Element_T *) AppTelemetryRing_GetReadSlot(&appTelemetryQueue_Ring, batchSize);
+			if(batchSize > 0 && elementPtr->isBatchStart) break;
+			samplesPtr[batchSize++] = elementPtr->sample;
+		} while(batchSize < numberOfFlushedSamples && batchSize < maxNumberOfSamples);
+
+		if(AppTelemetryRing_Release(&appTelemetryQueue_Ring, batchSize)) {
+			*numberOfSamplesPtr = batchSize;
+			return RETCODE_OK;
+		}
+	}
 
-	return payloadStr;
+	return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_QUEUE_NOT_FULL);
 }
+/**
+ * @brief Retrieve the oldest closed window of the aggregation mode from the queue and release it. Used by @ref AppTelemetryPublish (single consumer).
+ * @details If the sampling task dropped the window while it was being copied, the copy is discarded and the next oldest window is retrieved.
+ * @param[out] aggregatePtr: the window to copy into
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_QUEUE_NOT_FULL) - there is no closed window
+ */
+Retcode_T AppTelemetryQueue_RetrieveAggregate(AppTelemetryPayload_Aggregate_T * aggregatePtr) {
+
+	assert(aggregatePtr);
+	assert(appTelemetryQueue_AggregateWindowTicks > 0);
+
+	// each retry means the producer dropped a window, bounded by the backlog
+	for(uint8_t attempt = 0; attempt <= appTelemetryQueue_BacklogSize; attempt++) {
+
+		AppTelemetryRing_BeginRead(&appTelemetryQueue_Ring);
+
+		if(0 == AppTelemetryRing_GetReadMarkedCount(&appTelemetryQueue_Ring)) break;
+
+		*aggregatePtr = *((const AppTelemetryPayload_Aggregate_T *) AppTelemetryRing_GetReadSlot(&appTelemetryQueue_Ring, 0));
 
-/* TEST queue */
+		if(AppTelemetryRing_Release(&appTelemetryQueue_Ring, 1)) return RETCODE_OK;
+	}
 
-cJSON *TestTelemetryQueueJSONArray = NULL; /**< the test queue */
-uint8_t TestTelemetryQueueSize = 1; /**< test queue size with default */
+	return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_QUEUE_NOT_FULL);
+}
 /**
- * @brief Create a new test queue.
- * @param[in] queueSize: the size / number of payload messages in the queue.
+ * @brief Returns true if the queue is in the aggregation mode, i.e. holds windows to be retrieved with @ref AppTelemetryQueue_RetrieveAggregate().
+ * @return bool: true if aggregateWindowMillis > 0
  */
-void AppTelemetryQueueCreateNewTestQueue(uint8_t queueSize) {
-	TestTelemetryQueueJSONArray = cJSON_CreateArray();
-	TestTelemetryQueueSize = queueSize;
+bool AppTelemetryQueue_IsAggregateMode(void) {
+	return (appTelemetryQueue_AggregateWindowTicks > 0);
 }
 /**
- * @brief Add a sample / payload to the test queue.
- * @param[in] payloadPtr: the payload to add
+ * @brief Returns true if at least one flushed batch is waiting in the queue. Used by @ref AppTelemetryPublish to drain the backlog.
+ * @return bool: true if a flushed batch is available
  */
-void AppTelemetryQueueTestQueueAddSample(AppTelemetryPayload_T * payloadPtr) {
-	cJSON_AddItemToArray(TestTelemetryQueueJSONArray, payloadPtr);
+bool AppTelemetryQueue_IsBatchAvailable(void) {
+	return (AppTelemetryRing_GetMarkedCount(&appTelemetryQueue_Ring) > 0);
 }
 /**
- * @brief Get the length / size of the raw data from the test queue.
- * @return uint32_t: the size in bytes.
+ * @brief Make the samples of the open batch visible to the reader, so they can be retrieved before the queue is prepared for a new configuration.
+ * @details Not counted as a flush in the stats. In the aggregation mode the open window is not closed, it is discarded when the queue is prepared.
+ * @note Call only while the sampling task is not running.
  */
-uint32_t AppTelemetryQueueTestQueueGetDataSize(void) {
-	char *s = cJSON_PrintUnformatted(TestTelemetryQueueJSONArray);
-	int32_t s_length = strlen(s);
-	free(s);
-	return s_length;
+void AppTelemetryQueue_CloseOpenBatch(void) {
+
+	if(appTelemetryQueue_AggregateWindowTicks > 0 || 0 == appTelemetryQueue_OpenBatchSize.numberOfSamples) return;
+
+	AppTelemetryRing_SetMark(&appTelemetryQueue_Ring);
+
+	AppTelemetryPayload_ResetBatchSize(&appTelemetryQueue_OpenBatchSize);
 }
 /**
- * @brief Delete the test queue.
+ * @brief Push the samples dropped by the sampling task since the last call to the stats. Called by @ref AppTelemetryPublish once per cycle.
+ * @details The sampling task only increments its own counters, so it never blocks on the stats semaphore when the backlog is full.
+ * The counters are single-writer and only ever incremented; the difference to the last pushed value is correct across a wraparound.
  */
-void AppTelemetryQueueTestQueueDelete(void) {
-	cJSON_Delete(TestTelemetryQueueJSONArray);
-	TestTelemetryQueueJSONArray = NULL;
+void AppTelemetryQueue_PushStats(void) {
+
+	uint32_t dropOldestCount = appTelemetryQueue_DropOldestCount;
+	uint32_t dropNewestCount = appTelemetryQueue_DropNewestCount;
+
+	if(dropOldestCount != appTelemetryQueue_DropOldestPushedCount) {
+		AppStatus_Stats_IncrementTelemetryQueueDropOldestCounter(dropOldestCount - appTelemetryQueue_DropOldestPushedCount);
+		appTelemetryQueue_DropOldestPushedCount = dropOldestCount;
+	}
+	if(dropNewestCount != appTelemetryQueue_DropNewestPushedCount) {
+		AppStatus_Stats_IncrementTelemetryQueueDropNewestCounter(dropNewestCount - appTelemetryQueue_DropNewestPushedCount);
+		appTelemetryQueue_DropNewestPushedCount = dropNewestCount;
+	}
 }
 /**
- * @brief Print the test queue on the console.
+ * @brief Returns the number of batches the queue can hold.
+ * @return uint8_t: the backlog size in batches
  */
-void AppTelemetryQueueTestQueuePrint(void) {
-	printJSON(TestTelemetryQueueJSONArray);
+uint8_t AppTelemetryQueue_GetBacklogSize(void) {
+	return appTelemetryQueue_BacklogSize;
 }
 
 /**@} */
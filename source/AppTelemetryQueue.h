@@ -26,23 +26,25 @@ Retcode_T AppTelemetryQueue_Prepare(void);
 
 Retcode_T AppTelemetryQueue_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr);
 
-Retcode_T AppTelemetryQueue_AddSample(AppTelemetryPayload_T * payloadPtr, const uint32_t waitTicks);
+Retcode_T AppTelemetryQueue_ApplyNewRate(const AppRuntimeConfig_TelemetryRTParams_T * rtParamsPtr);
+
+Retcode_T AppTelemetryQueue_AddSample(const TickType_t tickCount, const Sensor_Value_T * sensorValuePtr, uint8_t presentSensors);
 
 Retcode_T AppTelemetryQueue_Wait4FullQueue(const uint32_t waitTicks);
 
-char * AppTelemetryQueue_RetrieveData(void);
+Retcode_T AppTelemetryQueue_RetrieveBatch(AppTelemetryPayload_Sample_T * samplesPtr, uint8_t maxNumberOfSamples, uint8_t * numberOfSamplesPtr);
 
-/* the test queue */
+Retcode_T AppTelemetryQueue_RetrieveAggregate(AppTelemetryPayload_Aggregate_T * aggregatePtr);
 
-void AppTelemetryQueueCreateNewTestQueue(uint8_t queueSize);
+bool AppTelemetryQueue_IsAggregateMode(void);
 
-void AppTelemetryQueueTestQueueAddSample(AppTelemetryPayload_T * payloadPtr);
+bool AppTelemetryQueue_IsBatchAvailable(void);
 
-uint32_t AppTelemetryQueueTestQueueGetDataSize(void);
+void AppTelemetryQueue_CloseOpenBatch(void);
 
-void AppTelemetryQueueTestQueueDelete(void);
+uint8_t AppTelemetryQueue_GetBacklogSize(void);
 
-void AppTelemetryQueueTestQueuePrint(void);
+void AppTelemetryQueue_PushStats(void);
 
 #endif /* SOURCE_APPTELEMETRYQUEUE_H_ */
 
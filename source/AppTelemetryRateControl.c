@@ -0,0 +1,301 @@
+/*
+ * AppTelemetryRateControl.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetryRateControl AppTelemetryRateControl
+ * @{
+ *
+ * @brief Closed-loop control of the telemetry rate with additive increase / multiplicative decrease (AIMD).
+ * @details @ref AppTelemetryPublish adds the measurements of every publishing cycle while connected: the time spent publishing, the live events taken from the queue and the failed publishes.
+ * Once per #APP_TELEMETRY_RATE_CONTROL_INTERVAL_IN_MS of cycles the measurements are evaluated:
+ * - congested: at least #APP_TELEMETRY_RATE_CONTROL_CONGESTED_FAILED_PERCENT of the events failed, the backlog events are at least #APP_TELEMETRY_RATE_CONTROL_CONGESTED_BACKLOG_PERCENT of the cycles
+ * or publishing took at least #APP_TELEMETRY_RATE_CONTROL_CONGESTED_LOAD_PERCENT of the cycles. The rate is cut to #APP_TELEMETRY_RATE_CONTROL_DECREASE_PERCENT, not below #APP_TELEMETRY_RATE_CONTROL_MIN_RATE_PERMILLE.<br/>
+ * - clear: no failures, no backlog and publishing took less than #APP_TELEMETRY_RATE_CONTROL_CLEAR_LOAD_PERCENT of the cycles.
+ * After #APP_TELEMETRY_RATE_CONTROL_CLEAR_INTERVALS clear intervals in a row the rate is raised by #APP_TELEMETRY_RATE_CONTROL_INCREASE_PERMILLE, up to the configured rate.<br/>
+ * - in between the rate is kept, the gap between the two load thresholds keeps the rate from oscillating.
+ * @details The rate is in permille of the configured numberOfEventsPerSecond. A new rate is proposed to @ref AppController, which applies it with @ref AppRuntimeConfig_AdaptTelemetryRate()
+ * and confirms it. No measurements are taken while a proposal is pending. Each new rate is sent as a status message.
+ * @details Only runs with the rateControl flag set and for raw samples, the aggregation mode publishes one event per window.
+ * With fidelityLevels configured @ref AppTelemetryFidelity adapts the telemetry instead.
+ * A new target telemetry configuration starts again at the configured rate.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+#include "XdkAppInfo.h"
+
+#undef BCDS_MODULE_ID /**< undefine any previous module id */
+#define BCDS_MODULE_ID SOLACE_APP_MODULE_ID_APP_TELEMETRY_RATE_CONTROL
+
+#include "AppTelemetryRateControl.h"
+#include "AppStatus.h"
+
+static AppTelemetryRateControl_RateChanged_Func_T appTelemetryRateControl_RateChanged_Func = NULL; /**< the callback for a new rate */
+
+static bool appTelemetryRateControl_isEnabled = false; /**< local copy of configuration. rateControl, raw samples and no fidelity levels */
+
+static uint32_t appTelemetryRateControl_RatePermille = APP_TELEMETRY_RATE_CONTROL_FULL_RATE_PERMILLE; /**< the applied rate */
+
+static volatile bool appTelemetryRateControl_isProposalPending = false; /**< flag set while a new rate waits to be applied */
+
+static volatile uint32_t appTelemetryRateControl_ProposedRatePermille = APP_TELEMETRY_RATE_CONTROL_FULL_RATE_PERMILLE; /**< the proposed rate */
+
+static AppTelemetryRateControl_Reason_T appTelemetryRateControl_ProposedReason = AppTelemetryRateControl_Reason_Clear; /**< the reason for the proposed rate */
+
+static uint32_t appTelemetryRateControl_NumberOfClearIntervals = 0; /**< number of clear intervals in a row */
+
+static AppTelemetryRateControl_Cycle_T appTelemetryRateControl_Interval; /**< the measurements of the cycles of the current interval, summed up */
+
+static uint32_t appTelemetryRateControl_NumberOfCycles = 0; /**< number of cycles in the current interval */
+
+/**
+ * @brief Returns the reason as a string for the status message.
+ * @param[in] reason: the reason
+ * @return const char *: the reason
+ */
+static const char * appTelemetryRateControl_GetReasonStr(AppTelemetryRateControl_Reason_T reason) {
+	switch(reason) {
+	case AppTelemetryRateControl_Reason_Load: return "load";
+	case AppTelemetryRateControl_Reason_Failures: return "failures";
+	case AppTelemetryRateControl_Reason_Backlog: return "backlog";
+	case AppTelemetryRateControl_Reason_Clear: return "clear";
+	default: assert(0);
+	}
+	return NULL;
+}
+/**
+ * @brief Clears the measurements of the current interval.
+ */
+static void appTelemetryRateControl_ResetInterval(void) {
+	appTelemetryRateControl_Interval = (AppTelemetryRateControl_Cycle_T) { 0 };
+	appTelemetryRateControl_NumberOfCycles = 0;
+}
+/**
+ * @brief Proposes a new rate to the controller.
+ * @param[in] ratePermille: the new rate
+ * @param[in] reason: the reason
+ */
+static void appTelemetryRateControl_Propose(uint32_t ratePermille, AppTelemetryRateControl_Reason_T reason) {
+
+	#ifdef DEBUG_APP_TELEMETRY_RATE_CONTROL
+	printf("[INFO] - appTelemetryRateControl_Propose: rate %lu -> %lu permille, reason: %s\r\n", appTelemetryRateControl_RatePermille, ratePermille, appTelemetryRateControl_GetReasonStr(reason));
+	#endif
+
+	appTelemetryRateControl_ProposedRatePermille = ratePermille;
+	appTelemetryRateControl_ProposedReason = reason;
+	appTelemetryRateControl_isProposalPending = true;
+
+	if(NULL != appTelemetryRateControl_RateChanged_Func) appTelemetryRateControl_RateChanged_Func();
+}
+/**
+ * @brief Evaluates the measurements of a full interval. Proposes a new rate if congested or clear for long enough.
+ */
+static void appTelemetryRateControl_Evaluate(void) {
+
+	const AppTelemetryRateControl_Cycle_T * intervalPtr = &appTelemetryRateControl_Interval;
+
+	uint32_t loadPercent = (intervalPtr->publishMillis * 100) / intervalPtr->cycleMillis;
+
+	bool isFailed = (intervalPtr->numberOfFailures > 0) &&
+			((intervalPtr->numberOfFailures * 100) >= (intervalPtr->numberOfEvents * APP_TELEMETRY_RATE_CONTROL_CONGESTED_FAILED_PERCENT));
+
+	bool isBacklog = (intervalPtr->numberOfBacklogEvents > 0) &&
+			((intervalPtr->numberOfBacklogEvents * 100) >= (appTelemetryRateControl_NumberOfCycles * APP_TELEMETRY_RATE_CONTROL_CONGESTED_BACKLOG_PERCENT));
+
+	bool isLoad = (loadPercent >= APP_TELEMETRY_RATE_CONTROL_CONGESTED_LOAD_PERCENT);
+
+	bool isClear = (0 == intervalPtr->numberOfFailures) && (0 == intervalPtr->numberOfBacklogEvents) && (loadPercent < APP_TELEMETRY_RATE_CONTROL_CLEAR_LOAD_PERCENT);
+
+	#ifdef DEBUG_APP_TELEMETRY_RATE_CONTROL
+	printf("[INFO] - appTelemetryRateControl_Evaluate: cycles:%lu, load:%lu%%, events:%lu, backlog:%lu, failures:%lu\r\n",
+			appTelemetryRateControl_NumberOfCycles, loadPercent, intervalPtr->numberOfEvents, intervalPtr->numberOfBacklogEvents, intervalPtr->numberOfFailures);
+	#endif
+
+	if(isFailed || isBacklog || isLoad) {
+
+		appTelemetryRateControl_NumberOfClearIntervals = 0;
+
+		if(appTelemetryRateControl_RatePermille <= APP_TELEMETRY_RATE_CONTROL_MIN_RATE_PERMILLE) return;
+
+		uint32_t ratePermille = (appTelemetryRateControl_RatePermille * APP_TELEMETRY_RATE_CONTROL_DECREASE_PERCENT) / 100;
+		if(ratePermille < APP_TELEMETRY_RATE_CONTROL_MIN_RATE_PERMILLE) ratePermille = APP_TELEMETRY_RATE_CONTROL_MIN_RATE_PERMILLE;
+
+		AppTelemetryRateControl_Reason_T reason = AppTelemetryRateControl_Reason_Load;
+		if(isFailed) reason = AppTelemetryRateControl_Reason_Failures;
+		else if(isBacklog) reason = AppTelemetryRateControl_Reason_Backlog;
+
+		appTelemetryRateControl_Propose(ratePermille, reason);
+
+	} else if(isClear) {
+
+		if(appTelemetryRateControl_RatePermille >= APP_TELEMETRY_RATE_CONTROL_FULL_RATE_PERMILLE) return;
+
+		if(++appTelemetryRateControl_NumberOfClearIntervals < APP_TELEMETRY_RATE_CONTROL_CLEAR_INTERVALS) return;
+
+		appTelemetryRateControl_NumberOfClearIntervals = 0;
+
+		uint32_t ratePermille = appTelemetryRateControl_RatePermille + APP_TELEMETRY_RATE_CONTROL_INCREASE_PERMILLE;
+		if(ratePermille > APP_TELEMETRY_RATE_CONTROL_FULL_RATE_PERMILLE) ratePermille = APP_TELEMETRY_RATE_CONTROL_FULL_RATE_PERMILLE;
+
+		appTelemetryRateControl_Propose(ratePermille, AppTelemetryRateControl_Reason_Clear);
+
+	} else appTelemetryRateControl_NumberOfClearIntervals = 0;
+}
+/**
+ * @brief Initialize the module.
+ * @param[in] rateChanged_Func: the callback for a new rate
+ * @return Retcode_T: RETCODE_OK
+ */
+Retcode_T AppTelemetryRateControl_Init(AppTelemetryRateControl_RateChanged_Func_T rateChanged_Func) {
+
+	assert(rateChanged_Func);
+
+	appTelemetryRateControl_RateChanged_Func = rateChanged_Func;
+
+	appTelemetryRateControl_isEnabled = false;
+	appTelemetryRateControl_RatePermille = APP_TELEMETRY_RATE_CONTROL_FULL_RATE_PERMILLE;
+	appTelemetryRateControl_isProposalPending = false;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Setup the module with the configuration.
+ * @param[in] configPtr: the runtime configuration. Module requires targetTelemetryConfigPtr
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: retcode from @ref AppTelemetryRateControl_ApplyNewRuntimeConfig()
+ */
+Retcode_T AppTelemetryRateControl_Setup(const AppRuntimeConfig_T * configPtr) {
+
+	assert(configPtr);
+	assert(configPtr->targetTelemetryConfigPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	if(RETCODE_OK == retcode) retcode = AppTelemetryRateControl_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr->targetTelemetryConfigPtr);
+
+	return retcode;
+}
+/**
+ * @brief Apply a new runtime configuration to the module.
+ * @details AppRuntimeConfig_Element_targetTelemetryConfig: enables the control, starts again at the configured rate and discards a pending proposal.
+ * @note Call only while the publishing task is not running.
+ * @param[in] configElement: the type of configuration to apply.
+ * @param[in] newConfigPtr: the configuration of type configElement
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT)
+ */
+Retcode_T AppTelemetryRateControl_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr) {
+
+	assert(newConfigPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	switch(configElement) {
+	case AppRuntimeConfig_Element_targetTelemetryConfig: {
+		const AppRuntimeConfig_TelemetryConfig_T * configPtr = (const AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr;
+		appTelemetryRateControl_isEnabled = configPtr->received.rateControl && (0 == configPtr->received.aggregateWindowMillis) && (0 == configPtr->received.numberOfFidelityLevels);
+		appTelemetryRateControl_RatePermille = APP_TELEMETRY_RATE_CONTROL_FULL_RATE_PERMILLE;
+		appTelemetryRateControl_NumberOfClearIntervals = 0;
+		appTelemetryRateControl_isProposalPending = false;
+	}
+		break;
+	default: retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT);
+	}
+
+	return retcode;
+}
+/**
+ * @brief Starts a new interval. Called by the publishing task when it starts.
+ */
+void AppTelemetryRateControl_Start(void) {
+	appTelemetryRateControl_ResetInterval();
+}
+/**
+ * @brief Adds the measurements of a publishing cycle. Evaluates them once the interval is full.
+ * @details Ignored while disabled or while a proposal is pending.
+ * @note Called by the publishing task only for cycles it was connected throughout.
+ * @param[in] cyclePtr: the measurements
+ */
+void AppTelemetryRateControl_AddCycle(const AppTelemetryRateControl_Cycle_T * cyclePtr) {
+
+	assert(cyclePtr);
+
+	if(!appTelemetryRateControl_isEnabled || appTelemetryRateControl_isProposalPending) return;
+
+	appTelemetryRateControl_Interval.cycleMillis += cyclePtr->cycleMillis;
+	appTelemetryRateControl_Interval.publishMillis += cyclePtr->publishMillis;
+	appTelemetryRateControl_Interval.numberOfEvents += cyclePtr->numberOfEvents;
+	appTelemetryRateControl_Interval.numberOfBacklogEvents += cyclePtr->numberOfBacklogEvents;
+	appTelemetryRateControl_Interval.numberOfFailures += cyclePtr->numberOfFailures;
+	appTelemetryRateControl_NumberOfCycles++;
+
+	if(appTelemetryRateControl_Interval.cycleMillis < APP_TELEMETRY_RATE_CONTROL_INTERVAL_IN_MS) return;
+
+	appTelemetryRateControl_Evaluate();
+
+	appTelemetryRateControl_ResetInterval();
+}
+/**
+ * @brief Returns the pending proposal.
+ * @param[out] ratePermillePtr: the proposed rate
+ * @return bool: true if a proposal is pending, false if it was discarded in the meantime
+ */
+bool AppTelemetryRateControl_GetProposal(uint32_t * ratePermillePtr) {
+
+	assert(ratePermillePtr);
+
+	if(!appTelemetryRateControl_isProposalPending) return false;
+
+	*ratePermillePtr = appTelemetryRateControl_ProposedRatePermille;
+
+	return true;
+}
+/**
+ * @brief Discards the pending proposal, e.g. if the controller is busy. Measuring continues with the rate in place.
+ */
+void AppTelemetryRateControl_DiscardProposal(void) {
+	appTelemetryRateControl_isProposalPending = false;
+}
+/**
+ * @brief Confirms the pending proposal was applied. Sends a status message with the new rate, a warning if the rate was decreased.
+ * @note Call only while the publishing task is not running.
+ * @param[in] rtParamsPtr: the applied telemetry runtime parameters
+ */
+void AppTelemetryRateControl_ConfirmProposal(const AppRuntimeConfig_TelemetryRTParams_T * rtParamsPtr) {
+
+	assert(rtParamsPtr);
+
+	if(!appTelemetryRateControl_isProposalPending) return;
+
+	AppStatusMessage_StatusCode_T statusCode = (appTelemetryRateControl_ProposedRatePermille < appTelemetryRateControl_RatePermille) ? AppStatusMessage_Status_Warning : AppStatusMessage_Status_Info;
+
+	appTelemetryRateControl_RatePermille = appTelemetryRateControl_ProposedRatePermille;
+	appTelemetryRateControl_isProposalPending = false;
+
+	cJSON * jsonHandle = cJSON_CreateObject();
+	cJSON_AddNumberToObject(jsonHandle, "ratePermille", appTelemetryRateControl_RatePermille);
+	cJSON_AddStringToObject(jsonHandle, "reason", appTelemetryRateControl_GetReasonStr(appTelemetryRateControl_ProposedReason));
+	cJSON_AddNumberToObject(jsonHandle, "publishPeriodcityMillis", rtParamsPtr->publishPeriodcityMillis);
+	cJSON_AddNumberToObject(jsonHandle, "samplingPeriodicityMillis", rtParamsPtr->samplingPeriodicityMillis);
+
+	AppStatusMessage_T * msg = AppStatus_CreateMessage(statusCode, AppStatusMessage_Descr_TelemetryRateAdapted, NULL);
+	AppStatus_AddStatusItem(msg, "telemetryRate", jsonHandle);
+	AppStatus_SendStatusMessage(msg);
+}
+/**
+ * @brief Returns the applied rate.
+ * @return uint32_t: the rate in permille of the configured numberOfEventsPerSecond
+ */
+uint32_t AppTelemetryRateControl_GetRatePermille(void) {
+	return appTelemetryRateControl_RatePermille;
+}
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,77 @@
+/*
+ * AppTelemetryRateControl.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetryRateControl
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYRATECONTROL_H_
+#define SOURCE_APPTELEMETRYRATECONTROL_H_
+
+#include "AppRuntimeConfig.h"
+
+#define APP_TELEMETRY_RATE_CONTROL_FULL_RATE_PERMILLE			UINT32_C(1000) /**< the configured rate */
+#define APP_TELEMETRY_RATE_CONTROL_MIN_RATE_PERMILLE			UINT32_C(63) /**< the rate is not decreased below this, 4 halvings of the configured rate */
+#define APP_TELEMETRY_RATE_CONTROL_INTERVAL_IN_MS				UINT32_C(10000) /**< the measurements are evaluated once per interval of publishing cycles */
+#define APP_TELEMETRY_RATE_CONTROL_DECREASE_PERCENT				UINT32_C(50) /**< multiplicative decrease: the rate is set to this percentage when congested */
+#define APP_TELEMETRY_RATE_CONTROL_INCREASE_PERMILLE			UINT32_C(125) /**< additive increase: the rate is raised by this when clear */
+#define APP_TELEMETRY_RATE_CONTROL_CONGESTED_LOAD_PERCENT		UINT32_C(90) /**< congested if publishing takes at least this percentage of the cycles */
+#define APP_TELEMETRY_RATE_CONTROL_CLEAR_LOAD_PERCENT			UINT32_C(50) /**< clear if publishing takes less than this percentage of the cycles */
+#define APP_TELEMETRY_RATE_CONTROL_CONGESTED_FAILED_PERCENT		UINT32_C(10) /**< congested if at least this percentage of the events failed to publish */
+#define APP_TELEMETRY_RATE_CONTROL_CONGESTED_BACKLOG_PERCENT	UINT32_C(50) /**< congested if the backlog events are at least this percentage of the cycles */
+#define APP_TELEMETRY_RATE_CONTROL_CLEAR_INTERVALS				UINT32_C(3) /**< number of clear intervals in a row before the rate is increased */
+
+/**
+ * @brief The reason for a new rate.
+ */
+typedef enum {
+	AppTelemetryRateControl_Reason_Load = 0, /**< publishing took too much of the cycles */
+	AppTelemetryRateControl_Reason_Failures, /**< too many events failed to publish */
+	AppTelemetryRateControl_Reason_Backlog, /**< the events queued up faster than they were published */
+	AppTelemetryRateControl_Reason_Clear, /**< no congestion for #APP_TELEMETRY_RATE_CONTROL_CLEAR_INTERVALS intervals */
+} AppTelemetryRateControl_Reason_T;
+/**
+ * @brief The measurements of one publishing cycle.
+ */
+typedef struct {
+	uint32_t cycleMillis; /**< the cycle length */
+	uint32_t publishMillis; /**< the time spent publishing in the cycle */
+	uint32_t numberOfEvents; /**< number of live events taken from the queue */
+	uint32_t numberOfBacklogEvents; /**< number of live events beyond the one expected per cycle */
+	uint32_t numberOfFailures; /**< number of publishes that failed */
+} AppTelemetryRateControl_Cycle_T;
+/**
+ * @brief Callback function typedef for a new rate. The controller gets the rate with @ref AppTelemetryRateControl_GetProposal().
+ * @note Called in the publishing task, the rate must be applied in another context.
+ */
+typedef void (*AppTelemetryRateControl_RateChanged_Func_T)(void);
+
+Retcode_T AppTelemetryRateControl_Init(AppTelemetryRateControl_RateChanged_Func_T rateChanged_Func);
+
+Retcode_T AppTelemetryRateControl_Setup(const AppRuntimeConfig_T * configPtr);
+
+Retcode_T AppTelemetryRateControl_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr);
+
+void AppTelemetryRateControl_Start(void);
+
+void AppTelemetryRateControl_AddCycle(const AppTelemetryRateControl_Cycle_T * cyclePtr);
+
+bool AppTelemetryRateControl_GetProposal(uint32_t * ratePermillePtr);
+
+void AppTelemetryRateControl_DiscardProposal(void);
+
+void AppTelemetryRateControl_ConfirmProposal(const AppRuntimeConfig_TelemetryRTParams_T * rtParamsPtr);
+
+uint32_t AppTelemetryRateControl_GetRatePermille(void);
+
+#endif /* SOURCE_APPTELEMETRYRATECONTROL_H_ */
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,287 @@
+/*
+ * AppTelemetryRing.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetryRing AppTelemetryRing
+ * @{
+ *
+ * @brief Lock-free single-producer / single-consumer ring buffer of fixed size elements. Used by @ref AppTelemetryQueue and @ref AppTelemetryFusion.
+ * @details The producer obtains a slot with @ref AppTelemetryRing_GetWriteSlot(), fills it in place and publishes it with @ref AppTelemetryRing_CommitWrite().
+ * The consumer takes a snapshot with @ref AppTelemetryRing_BeginRead(), reads slots with @ref AppTelemetryRing_GetReadSlot() and hands them back with @ref AppTelemetryRing_Release().
+ * @details The producer can set a mark with @ref AppTelemetryRing_SetMark(), e.g. at the end of a batch of variable length. The consumer reads up to the mark, elements after it are still being collected.
+ * @details If the consumer falls behind, the producer can discard the oldest elements with @ref AppTelemetryRing_DropOldest() instead of discarding the new one.
+ * The consumer detects this in @ref AppTelemetryRing_Release(), the elements it read may have been overwritten and must be discarded.
+ * @details No locks and no heap on the write / read path; storage is allocated once in @ref AppTelemetryRing_Create().
+ * Only the producer writes the write index. The read index is advanced by the consumer in @ref AppTelemetryRing_Release() and by the producer in @ref AppTelemetryRing_DropOldest(),
+ * both with a compare-and-swap from their snapshot, so exactly one of two concurrent updates succeeds. A memory barrier orders the slot contents against the index update.
+ * @details The module has no dependencies on FreeRTOS or the XDK SDK, see test/test_AppTelemetryRing.c for the host unit test.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+
+#include "AppTelemetryRing.h"
+
+#include <stdlib.h>
+#include <assert.h>
+
+/**
+ * @brief Full memory barrier. Orders the slot contents against the index update between producer and consumer.
+ */
+#define APP_TELEMETRY_RING_MEMORY_BARRIER()		__sync_synchronize()
+/**
+ * @brief Atomic compare-and-swap of the read index. Returns true if it was swapped.
+ */
+#define APP_TELEMETRY_RING_CAS(ptr, expected, desired)		__sync_bool_compare_and_swap((ptr), (expected), (desired))
+
+/**
+ * @brief Advance a ring index by numElements. Indices run over [0, 2*capacity).
+ * @param[in] ringPtr: the ring
+ * @param[in] index: the index to advance
+ * @param[in] numElements: number of elements to advance by, must be <= capacity
+ * @return uint32_t: the new index
+ */
+static inline uint32_t appTelemetryRing_Advance(const AppTelemetryRing_T * ringPtr, uint32_t index, uint32_t numElements) {
+	index += numElements;
+	if(index >= 2 * ringPtr->capacity) index -= 2 * ringPtr->capacity;
+	return index;
+}
+/**
+ * @brief Returns the number of elements from ring index fromIndex to ring index toIndex.
+ * @param[in] ringPtr: the ring
+ * @param[in] fromIndex: the start index
+ * @param[in] toIndex: the end index
+ * @return uint32_t: the number of elements
+ */
+static inline uint32_t appTelemetryRing_Distance(const AppTelemetryRing_T * ringPtr, uint32_t fromIndex, uint32_t toIndex) {
+	if(toIndex >= fromIndex) return toIndex - fromIndex;
+	return (2 * ringPtr->capacity) - (fromIndex - toIndex);
+}
+/**
+ * @brief Map a ring index to the element storage.
+ * @param[in] ringPtr: the ring
+ * @param[in] index: the ring index
+ * @return uint8_t *: pointer to the element
+ */
+static inline uint8_t * appTelemetryRing_Slot(const AppTelemetryRing_T * ringPtr, uint32_t index) {
+	if(index >= ringPtr->capacity) index -= ringPtr->capacity;
+	return ringPtr->bufferPtr + (index * ringPtr->elementSize);
+}
+/**
+ * @brief Create the ring. Allocates the element storage.
+ * @param[in,out] ringPtr: the ring to initialize
+ * @param[in] elementSize: size of one element in bytes
+ * @param[in] capacity: max number of elements
+ * @return bool: true if successful, false if the storage could not be allocated
+ */
+bool AppTelemetryRing_Create(AppTelemetryRing_T * ringPtr, uint32_t elementSize, uint32_t capacity) {
+
+	assert(ringPtr);
+	assert(elementSize > 0);
+	assert(capacity > 0);
+
+	ringPtr->bufferPtr = (uint8_t *) malloc(elementSize * capacity);
+	if(NULL == ringPtr->bufferPtr) return false;
+
+	ringPtr->elementSize = elementSize;
+	ringPtr->capacity = capacity;
+	ringPtr->writeIndex = 0;
+	ringPtr->readIndex = 0;
+	ringPtr->dropSequence = 0;
+	ringPtr->markIndex = 0;
+	ringPtr->readMark = 0;
+	ringPtr->readMarkDropSequence = 0;
+	ringPtr->dropMark = 0;
+
+	return true;
+}
+/**
+ * @brief Delete the ring's element storage. Ring must not be in use by producer or consumer.
+ * @param[in,out] ringPtr: the ring
+ */
+void AppTelemetryRing_Delete(AppTelemetryRing_T * ringPtr) {
+
+	assert(ringPtr);
+
+	if(NULL != ringPtr->bufferPtr) free(ringPtr->bufferPtr);
+	ringPtr->bufferPtr = NULL;
+	ringPtr->capacity = 0;
+	ringPtr->writeIndex = 0;
+	ringPtr->readIndex = 0;
+}
+/**
+ * @brief Discard all elements. Ring must not be in use by producer or consumer.
+ * @param[in,out] ringPtr: the ring
+ */
+void AppTelemetryRing_Reset(AppTelemetryRing_T * ringPtr) {
+
+	assert(ringPtr);
+
+	ringPtr->writeIndex = 0;
+	ringPtr->readIndex = 0;
+	ringPtr->dropSequence = 0;
+	ringPtr->markIndex = 0;
+	ringPtr->readMark = 0;
+	ringPtr->readMarkDropSequence = 0;
+	ringPtr->dropMark = 0;
+}
+/**
+ * @brief Returns the number of committed elements not yet released. Can be called by producer and consumer.
+ * @param[in] ringPtr: the ring
+ * @return uint32_t: the number of elements
+ */
+uint32_t AppTelemetryRing_GetCount(const AppTelemetryRing_T * ringPtr) {
+
+	uint32_t writeIndex = ringPtr->writeIndex;
+	uint32_t readIndex = ringPtr->readIndex;
+
+	return appTelemetryRing_Distance(ringPtr, readIndex, writeIndex);
+}
+/**
+ * @brief Producer: returns the next free slot to fill in place.
+ * @details The slot becomes visible to the consumer only after @ref AppTelemetryRing_CommitWrite().
+ * @param[in] ringPtr: the ring
+ * @return void *: the slot, or NULL if the ring is full
+ */
+void * AppTelemetryRing_GetWriteSlot(AppTelemetryRing_T * ringPtr) {
+
+	if(AppTelemetryRing_GetCount(ringPtr) >= ringPtr->capacity) return NULL;
+
+	return (void *) appTelemetryRing_Slot(ringPtr, ringPtr->writeIndex);
+}
+/**
+ * @brief Producer: publishes the slot returned by @ref AppTelemetryRing_GetWriteSlot().
+ * @param[in] ringPtr: the ring
+ * @return uint32_t: the number of elements in the ring after the commit
+ */
+uint32_t AppTelemetryRing_CommitWrite(AppTelemetryRing_T * ringPtr) {
+
+	APP_TELEMETRY_RING_MEMORY_BARRIER();
+
+	ringPtr->writeIndex = appTelemetryRing_Advance(ringPtr, ringPtr->writeIndex, 1);
+
+	return AppTelemetryRing_GetCount(ringPtr);
+}
+/**
+ * @brief Producer: marks the current write position. Elements committed so far are complete and can be read up to the mark.
+ * @param[in] ringPtr: the ring
+ */
+void AppTelemetryRing_SetMark(AppTelemetryRing_T * ringPtr) {
+
+	APP_TELEMETRY_RING_MEMORY_BARRIER();
+
+	ringPtr->markIndex = ringPtr->writeIndex;
+}
+/**
+ * @brief Returns the number of elements up to the mark not yet released. Can be called by producer and consumer.
+ * @param[in] ringPtr: the ring
+ * @return uint32_t: the number of elements
+ */
+uint32_t AppTelemetryRing_GetMarkedCount(const AppTelemetryRing_T * ringPtr) {
+
+	uint32_t readIndex = ringPtr->readIndex;
+
+	APP_TELEMETRY_RING_MEMORY_BARRIER();
+
+	return appTelemetryRing_Distance(ringPtr, readIndex, ringPtr->markIndex);
+}
+/**
+ * @brief Producer: takes a snapshot of the read position to find out how many of the oldest elements to drop with @ref AppTelemetryRing_GetDropSlot().
+ * @param[in] ringPtr: the ring
+ * @return uint32_t: the number of elements up to the mark, only those can be dropped
+ */
+uint32_t AppTelemetryRing_BeginDrop(AppTelemetryRing_T * ringPtr) {
+
+	ringPtr->dropMark = ringPtr->readIndex;
+
+	return appTelemetryRing_Distance(ringPtr, ringPtr->dropMark, ringPtr->markIndex);
+}
+/**
+ * @brief Producer: returns the element at offset from the oldest element at @ref AppTelemetryRing_BeginDrop().
+ * @details Elements are only written by the producer, reading them while the consumer does is safe.
+ * @param[in] ringPtr: the ring
+ * @param[in] offset: 0 for the oldest element, must be < the count returned by @ref AppTelemetryRing_BeginDrop()
+ * @return const void *: the element
+ */
+const void * AppTelemetryRing_GetDropSlot(const AppTelemetryRing_T * ringPtr, uint32_t offset) {
+	return (const void *) appTelemetryRing_Slot(ringPtr, appTelemetryRing_Advance(ringPtr, ringPtr->dropMark, offset));
+}
+/**
+ * @brief Producer: discards the oldest numElements from the position at @ref AppTelemetryRing_BeginDrop() to make room for new ones.
+ * @details Use when the ring is full and the oldest data is less valuable than the newest.
+ * A consumer currently reading these elements will fail its @ref AppTelemetryRing_Release().
+ * @param[in] ringPtr: the ring
+ * @param[in] numElements: the number of elements to drop, must be <= the count returned by @ref AppTelemetryRing_BeginDrop()
+ * @return bool: true if the elements were dropped, false if the consumer released elements in the meantime. Then try @ref AppTelemetryRing_GetWriteSlot() again.
+ */
+bool AppTelemetryRing_DropOldest(AppTelemetryRing_T * ringPtr, uint32_t numElements) {
+
+	// invalidate the consumer's snapshot before the slots can be overwritten
+	ringPtr->dropSequence++;
+
+	APP_TELEMETRY_RING_MEMORY_BARRIER();
+
+	return APP_TELEMETRY_RING_CAS(&ringPtr->readIndex, ringPtr->dropMark, appTelemetryRing_Advance(ringPtr, ringPtr->dropMark, numElements));
+}
+/**
+ * @brief Consumer: takes a snapshot of the read position. Call before reading slots with @ref AppTelemetryRing_GetReadSlot().
+ * @param[in] ringPtr: the ring
+ * @return uint32_t: the number of elements available for reading
+ */
+uint32_t AppTelemetryRing_BeginRead(AppTelemetryRing_T * ringPtr) {
+
+	ringPtr->readMarkDropSequence = ringPtr->dropSequence;
+
+	APP_TELEMETRY_RING_MEMORY_BARRIER();
+
+	ringPtr->readMark = ringPtr->readIndex;
+
+	return appTelemetryRing_Distance(ringPtr, ringPtr->readMark, ringPtr->writeIndex);
+}
+/**
+ * @brief Consumer: returns the number of elements from the position at @ref AppTelemetryRing_BeginRead() up to the mark.
+ * @param[in] ringPtr: the ring
+ * @return uint32_t: the number of elements
+ */
+uint32_t AppTelemetryRing_GetReadMarkedCount(const AppTelemetryRing_T * ringPtr) {
+
+	APP_TELEMETRY_RING_MEMORY_BARRIER();
+
+	return appTelemetryRing_Distance(ringPtr, ringPtr->readMark, ringPtr->markIndex);
+}
+/**
+ * @brief Consumer: returns the element at offset from the oldest element at @ref AppTelemetryRing_BeginRead().
+ * @param[in] ringPtr: the ring
+ * @param[in] offset: 0 for the oldest element, must be < the count returned by @ref AppTelemetryRing_BeginRead()
+ * @return const void *: the element
+ */
+const void * AppTelemetryRing_GetReadSlot(const AppTelemetryRing_T * ringPtr, uint32_t offset) {
+
+	APP_TELEMETRY_RING_MEMORY_BARRIER();
+
+	return (const void *) appTelemetryRing_Slot(ringPtr, appTelemetryRing_Advance(ringPtr, ringPtr->readMark, offset));
+}
+/**
+ * @brief Consumer: hands the oldest numElements back to the producer.
+ * @param[in] ringPtr: the ring
+ * @param[in] numElements: the number of elements to release, must be <= the count returned by @ref AppTelemetryRing_BeginRead()
+ * @return bool: true if released. false if the producer dropped elements since @ref AppTelemetryRing_BeginRead(); the elements read may have been overwritten and must be discarded.
+ */
+bool AppTelemetryRing_Release(AppTelemetryRing_T * ringPtr, uint32_t numElements) {
+
+	APP_TELEMETRY_RING_MEMORY_BARRIER();
+
+	if(ringPtr->dropSequence != ringPtr->readMarkDropSequence) return false;
+
+	return APP_TELEMETRY_RING_CAS(&ringPtr->readIndex, ringPtr->readMark, appTelemetryRing_Advance(ringPtr, ringPtr->readMark, numElements));
+}
+
+/**@} */
+/** ************************************************************************* */
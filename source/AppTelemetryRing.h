@@ -0,0 +1,72 @@
+/*
+ * AppTelemetryRing.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetryRing
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYRING_H_
+#define SOURCE_APPTELEMETRYRING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Single-producer / single-consumer ring of fixed size elements.
+ * @details writeIndex is only modified by the producer. readIndex is modified by the consumer and, to drop the oldest elements of a full ring, by the producer; both use compare-and-swap on it.
+ * Both run over [0, 2*capacity) so a full ring can be told apart from an empty one without sacrificing a slot.
+ */
+typedef struct {
+	uint8_t * bufferPtr; /**< the element storage, allocated by @ref AppTelemetryRing_Create() */
+	uint32_t elementSize; /**< size of one element in bytes */
+	uint32_t capacity; /**< max number of elements in the ring */
+	volatile uint32_t writeIndex; /**< producer position */
+	volatile uint32_t readIndex; /**< consumer position */
+	volatile uint32_t dropSequence; /**< incremented by the producer before it drops elements, see @ref AppTelemetryRing_DropOldest() */
+	volatile uint32_t markIndex; /**< producer position at the last @ref AppTelemetryRing_SetMark(), e.g. the end of the last complete batch */
+	uint32_t readMark; /**< consumer only: readIndex at @ref AppTelemetryRing_BeginRead() */
+	uint32_t readMarkDropSequence; /**< consumer only: dropSequence at @ref AppTelemetryRing_BeginRead() */
+	uint32_t dropMark; /**< producer only: readIndex at @ref AppTelemetryRing_BeginDrop() */
+} AppTelemetryRing_T;
+
+bool AppTelemetryRing_Create(AppTelemetryRing_T * ringPtr, uint32_t elementSize, uint32_t capacity);
+
+void AppTelemetryRing_Delete(AppTelemetryRing_T * ringPtr);
+
+void AppTelemetryRing_Reset(AppTelemetryRing_T * ringPtr);
+
+uint32_t AppTelemetryRing_GetCount(const AppTelemetryRing_T * ringPtr);
+
+void * AppTelemetryRing_GetWriteSlot(AppTelemetryRing_T * ringPtr);
+
+uint32_t AppTelemetryRing_CommitWrite(AppTelemetryRing_T * ringPtr);
+
+void AppTelemetryRing_SetMark(AppTelemetryRing_T * ringPtr);
+
+uint32_t AppTelemetryRing_GetMarkedCount(const AppTelemetryRing_T * ringPtr);
+
+uint32_t AppTelemetryRing_BeginDrop(AppTelemetryRing_T * ringPtr);
+
+const void * AppTelemetryRing_GetDropSlot(const AppTelemetryRing_T * ringPtr, uint32_t offset);
+
+bool AppTelemetryRing_DropOldest(AppTelemetryRing_T * ringPtr, uint32_t numElements);
+
+uint32_t AppTelemetryRing_BeginRead(AppTelemetryRing_T * ringPtr);
+
+uint32_t AppTelemetryRing_GetReadMarkedCount(const AppTelemetryRing_T * ringPtr);
+
+const void * AppTelemetryRing_GetReadSlot(const AppTelemetryRing_T * ringPtr, uint32_t offset);
+
+bool AppTelemetryRing_Release(AppTelemetryRing_T * ringPtr, uint32_t numElements);
+
+#endif /* SOURCE_APPTELEMETRYRING_H_ */
+
+/**@} */
+/** ************************************************************************* */
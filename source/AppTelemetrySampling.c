@@ -10,6 +10,32 @@
  *
  * @brief Module to take periodic sensor samples based on the configuration.
  *
+ * @details With sensorsEnable = SELECTED only the sensors of the telemetry configuration, plus the ones the capture, spectrum and fusion features need,
+ * are powered and configured at boot and read per sampling cycle. Sensor_Enable() runs once at boot, so a new configuration can narrow the sensors read
+ * but sensors not powered at boot read as 0 until the configuration is persisted and the device rebooted.
+ * The time Sensor_GetData() takes is measured with the cycle counter and reported to the stats for the sensors read.
+ *
+ * @details Multi-rate sampling: each sensor has its own period (sensorPeriodsMillis), a multiple of the sampling period, rounded.
+ * A sampling cycle only reads the sensors due, the others hold their last reading, and the sample carries the presence bits of the sensors read,
+ * so the payload only contains the values read. All sensors are due in the first cycle of the task.
+ * If the sensors due change, they are set up with Sensor_Setup() at the end of the cycle before, ahead of their deadline, so the setup is neither
+ * in the read times nor delays the read. The read times of all sets of sensors due share one histogram and maximum, with multi-rate sampling
+ * the histogram may show a peak per set.
+ * The accelerometer is read every cycle if capturing or the spectrum features are configured, accelerometer and gyroscope if the sensor fusion is,
+ * the fusion uses the last magnetometer reading in between.
+ *
+ * @details Drift-free sampling: the cycles start on absolute deadlines, multiples of the sampling period from the start of the task (vTaskDelayUntil()),
+ * so the time the loop takes does not add up. A cycle ending after the deadline of the next one is an overrun, handled by samplingOverrunPolicy:
+ * SKIP drops the missed cycles and continues on the next deadline ahead, CATCH_UP runs them back to back unless more than
+ * #APP_TELEMETRY_SAMPLING_MAX_CATCH_UP_CYCLES are missed. The deviation of each interval between two sensor reads from the sampling period (jitter)
+ * and the time of each read are counted in fixed bucket histograms of the stats. The intervals are measured with the tick count and the SysTick counter,
+ * only between two reads on schedule: the cycles after an overrun, skipped or caught up, and cycles starting a period or more late are left out of the jitter.
+ *
+ * @details Wall clock alignment: with samplingWallClockAligned the first deadline is the next multiple of the sampling period since the epoch
+ * on the SNTP synchronized clock of @ref AppTimestamp, so devices with the same sampling period sample at the same instants and their timestamps
+ * land on the same marks. How late the sensor reads start after their aligned instant is measured with the tick count and the SysTick counter
+ * and reported to the stats.
+ *
  * @see AppTelemetryPayload
  * @see AppTelemetryQueue
  * @see AppTelemetryPublish
@@ -29,11 +55,17 @@
 #include "AppTelemetrySampling.h"
 #include "AppTelemetryPayload.h"
 #include "AppTelemetryQueue.h"
+#include "AppTelemetryCapture.h"
+#include "AppTelemetryAnalysis.h"
+#include "AppTelemetryFusion.h"
 #include "AppMisc.h"
 #include "AppStatus.h"
+#include "AppTimestamp.h"
 
 #include "XDK_Sensor.h"
 
+#include "em_device.h"
+
 #include "FreeRTOS.h"
 #include "semphr.h"
 #include "task.h"
@@ -49,6 +81,32 @@ static SemaphoreHandle_t appTelemetrySampling_TaskSemaphoreHandle = NULL; /**< s
 static TickType_t appTelemetrySampling_SamplingPeriodicityMillis = 1000; /**< local copy of configuration for sampling interval in millis */
 static char * appTelemetrySampling_DeviceId = NULL; /**< local copy of device id */
 
+static AppRuntimeConfig_Sensors_T appTelemetrySampling_PoweredSensors; /**< the sensors powered and configured at boot by Sensor_Enable() */
+static AppRuntimeConfig_Sensors_T appTelemetrySampling_ReadSensors; /**< the sensors read by Sensor_GetData() per sampling cycle, a subset of #appTelemetrySampling_PoweredSensors */
+#define APP_TELEMETRY_SAMPLING_READ_STATS_CYCLES	UINT32_C(32) /**< number of sampling cycles the read times are accumulated over before they are reported to the stats */
+static AppRuntimeConfig_Sensors_T appTelemetrySampling_EnabledSensors; /**< the sensors enabled in #appTelemetrySampling_SensorSetup, read by the next Sensor_GetData() */
+
+static AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_T appTelemetrySampling_OverrunPolicy = APP_RT_CFG_DEFAULT_SAMPLING_OVERRUN_POLICY; /**< local copy of configuration for the cycles missed by an overrun */
+static bool appTelemetrySampling_isWallClockAligned = APP_RT_CFG_DEFAULT_SAMPLING_WALL_CLOCK_ALIGNED; /**< local copy of configuration to align the deadlines to the wall clock */
+#define APP_TELEMETRY_SAMPLING_MAX_CATCH_UP_CYCLES	UINT32_C(4) /**< max number of missed cycles run back to back with policy catch up, more are skipped */
+static const uint32_t appTelemetrySampling_JitterUpperBoundsMicros[APP_STATUS_STATS_HISTOGRAM_BUCKETS - 1] = APP_STATUS_STATS_JITTER_HISTOGRAM_UPPER_BOUNDS_MICROS; /**< bucket bounds of the jitter histogram */
+static const uint32_t appTelemetrySampling_ReadUpperBoundsMicros[APP_STATUS_STATS_HISTOGRAM_BUCKETS - 1] = APP_STATUS_STATS_READ_HISTOGRAM_UPPER_BOUNDS_MICROS; /**< bucket bounds of the read time histogram */
+
+/**
+ * @brief Number of sampling cycles per read of a sensor, 1: every cycle.
+ */
+typedef struct {
+	uint32_t light; /**< cycles of the light sensor */
+	uint32_t accelerator; /**< cycles of the accelerometer */
+	uint32_t gyro; /**< cycles of the gyroscope */
+	uint32_t magneto; /**< cycles of the magnetometer */
+	uint32_t humidity; /**< cycles of the humidity sensor */
+	uint32_t temperature; /**< cycles of the temperature sensor */
+} AppTelemetrySampling_SensorCycles_T;
+
+static AppRuntimeConfig_SensorPeriods_T appTelemetrySampling_SensorPeriodsMillis; /**< local copy of configuration for the sampling period per sensor, 0 for sensors read every cycle */
+static AppTelemetrySampling_SensorCycles_T appTelemetrySampling_SensorCycles = { .light = 1, .accelerator = 1, .gyro = 1, .magneto = 1, .humidity = 1, .temperature = 1 }; /**< the sampling cycles per read, from #appTelemetrySampling_SensorPeriodsMillis */
+
 
 #define APP_TEMPERATURE_OFFSET_CORRECTION               (-3459)/**< Macro for static temperature offset correction. Self heating, temperature correction factor */
 /**
@@ -68,6 +126,17 @@ static Sensor_Setup_T appTelemetrySampling_SensorSetup = {
 
 /* forward declarations */
 static void appTelemetrySampling_TelemetrySamplingTask(void* pvParameters);
+static void appTelemetrySampling_GetRequiredSensors(const AppRuntimeConfig_TelemetryConfig_T * configPtr, AppRuntimeConfig_Sensors_T * sensorsPtr);
+static void appTelemetrySampling_SetSensorEnable(const AppRuntimeConfig_Sensors_T * sensorsPtr);
+static void appTelemetrySampling_StartCycleCounter(void);
+static void appTelemetrySampling_SetSensorPeriods(const AppRuntimeConfig_TelemetryConfig_T * configPtr);
+static void appTelemetrySampling_UpdateSensorCycles(void);
+static void appTelemetrySampling_GetDueSensors(uint32_t cycle, AppRuntimeConfig_Sensors_T * sensorsPtr);
+static uint8_t appTelemetrySampling_GetPresentSensors(const AppRuntimeConfig_Sensors_T * sensorsPtr);
+static void appTelemetrySampling_SetupDueSensors(uint32_t cycle);
+static uint32_t appTelemetrySampling_GetHistogramBucket(const uint32_t * upperBoundsMicrosPtr, uint32_t micros);
+static TickType_t appTelemetrySampling_GetTickCount(uint32_t cyclesPerMicro, uint32_t * subTickMicrosPtr);
+static uint32_t appTelemetrySampling_GetMicrosSinceTick(TickType_t tickCount, uint32_t cyclesPerMicro);
 
 
 /**
@@ -105,7 +174,8 @@ Retcode_T AppTelemetrySampling_Init(const char * deviceId, uint32_t samplingTask
 }
 /**
  * @brief Setup of the sampling module. Call in @ref AppController_Setup().
- * @param[in] configPtr: the runtime configuration. Only reads activeTelemetryRTParamsPtr.
+ * @details Selects the sensors powered at boot from targetTelemetryConfigPtr, see @ref appTelemetrySampling_GetRequiredSensors(), and their sampling periods.
+ * @param[in] configPtr: the runtime configuration. Reads targetTelemetryConfigPtr and activeTelemetryRTParamsPtr.
  * @return Retcode_T: RETCODE_OK
  * @return Retcode_T: retcode from Sensor_Setup()
  * @return Retcode_T: retcode from @ref AppTelemetrySampling_ApplyNewRuntimeConfig()
@@ -113,10 +183,22 @@ Retcode_T AppTelemetrySampling_Init(const char * deviceId, uint32_t samplingTask
 Retcode_T AppTelemetrySampling_Setup(const AppRuntimeConfig_T * configPtr) {
 
 	assert(configPtr);
+	assert(configPtr->targetTelemetryConfigPtr);
 	assert(configPtr->activeTelemetryRTParamsPtr);
 
 	Retcode_T retcode = RETCODE_OK;
 
+	appTelemetrySampling_GetRequiredSensors(configPtr->targetTelemetryConfigPtr, &appTelemetrySampling_PoweredSensors);
+	appTelemetrySampling_ReadSensors = appTelemetrySampling_PoweredSensors;
+	appTelemetrySampling_SetSensorEnable(&appTelemetrySampling_ReadSensors);
+	AppStatus_Stats_SetTelemetrySamplingSensors(&appTelemetrySampling_ReadSensors);
+
+	appTelemetrySampling_SetSensorPeriods(configPtr->targetTelemetryConfigPtr);
+	appTelemetrySampling_OverrunPolicy = configPtr->targetTelemetryConfigPtr->received.samplingOverrunPolicy;
+	appTelemetrySampling_isWallClockAligned = configPtr->targetTelemetryConfigPtr->received.samplingWallClockAligned;
+
+	appTelemetrySampling_StartCycleCounter();
+
 	if (RETCODE_OK == retcode) retcode = Sensor_Setup(&appTelemetrySampling_SensorSetup);
 
 	if (RETCODE_OK == retcode) retcode = AppTelemetrySampling_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_activeTelemetryRTParams, configPtr->activeTelemetryRTParamsPtr);
@@ -132,10 +214,15 @@ Retcode_T AppTelemetrySampling_Enable(void) {
 }
 /**
  * @brief Apply a new configuration. Call only when the sampling task is not running.
- * @param[in] configElement: the configuration element to apply. only #AppRuntimeConfig_Element_activeTelemetryRTParams is supported.
+ * @details A new #AppRuntimeConfig_Element_targetTelemetryConfig selects the sensors read per cycle among the sensors powered at boot.
+ * Sensor_Enable() only runs once at boot, sensors required but not powered read as 0 until the device is rebooted with the configuration persisted.
+ * Both elements update the number of sampling cycles per read of each sensor, #AppRuntimeConfig_Element_targetTelemetryConfig also the overrun policy and the wall clock alignment.
+ * @param[in] configElement: the configuration element to apply. #AppRuntimeConfig_Element_activeTelemetryRTParams and #AppRuntimeConfig_Element_targetTelemetryConfig are supported.
  * @param[in] newConfigPtr: the new configuration of type configElement
  * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: retcode from Sensor_Setup()
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT)
+ * @exception Retcode_RaiseError: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_APP_TELEMETRY_SAMPLING_SENSORS_NOT_POWERED) if a required sensor was not powered at boot
  */
 Retcode_T AppTelemetrySampling_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr) {
 
@@ -148,13 +235,238 @@ Retcode_T AppTelemetrySampling_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElem
 	case AppRuntimeConfig_Element_activeTelemetryRTParams:
 
 		appTelemetrySampling_SamplingPeriodicityMillis = ((AppRuntimeConfig_TelemetryRTParams_T *) newConfigPtr)->samplingPeriodicityMillis;
+		appTelemetrySampling_UpdateSensorCycles();
 
+		break;
+	case AppRuntimeConfig_Element_targetTelemetryConfig: {
+
+		AppRuntimeConfig_Sensors_T required;
+		appTelemetrySampling_GetRequiredSensors((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr, &required);
+
+		AppRuntimeConfig_Sensors_T read = {
+			.isLight = required.isLight && appTelemetrySampling_PoweredSensors.isLight,
+			.isAccelerator = required.isAccelerator && appTelemetrySampling_PoweredSensors.isAccelerator,
+			.isGyro = required.isGyro && appTelemetrySampling_PoweredSensors.isGyro,
+			.isMagneto = required.isMagneto && appTelemetrySampling_PoweredSensors.isMagneto,
+			.isHumidity = required.isHumidity && appTelemetrySampling_PoweredSensors.isHumidity,
+			.isTemperature = required.isTemperature && appTelemetrySampling_PoweredSensors.isTemperature,
+			.isPressure = required.isPressure && appTelemetrySampling_PoweredSensors.isPressure,
+		};
+		if(0 != memcmp(&read, &required, sizeof(read))) Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_APP_TELEMETRY_SAMPLING_SENSORS_NOT_POWERED));
+
+		if(0 != memcmp(&read, &appTelemetrySampling_ReadSensors, sizeof(read))) {
+			appTelemetrySampling_ReadSensors = read;
+			appTelemetrySampling_SetSensorEnable(&appTelemetrySampling_ReadSensors);
+			AppStatus_Stats_SetTelemetrySamplingSensors(&appTelemetrySampling_ReadSensors);
+			// only copies the selection, the sensors were enabled at boot
+			retcode = Sensor_Setup(&appTelemetrySampling_SensorSetup);
+		}
+
+		appTelemetrySampling_SetSensorPeriods((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr);
+		appTelemetrySampling_OverrunPolicy = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.samplingOverrunPolicy;
+		appTelemetrySampling_isWallClockAligned = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.samplingWallClockAligned;
+	}
 		break;
 	default: return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT);
 	}
 
 	return retcode;
 }
+/**
+ * @brief Get the sensors a telemetry configuration requires.
+ * @details All sensors with #AppRuntimeConfig_SensorEnable_All. Otherwise the sensors selected plus the accelerometer for capturing and the spectrum features,
+ * and accelerometer, gyroscope and magnetometer for the sensor fusion.
+ * @param[in] configPtr: the telemetry configuration
+ * @param[out] sensorsPtr: the required sensors
+ */
+static void appTelemetrySampling_GetRequiredSensors(const AppRuntimeConfig_TelemetryConfig_T * configPtr, AppRuntimeConfig_Sensors_T * sensorsPtr) {
+
+	assert(configPtr);
+	assert(sensorsPtr);
+
+	if(AppRuntimeConfig_SensorEnable_SelectedOnly != configPtr->received.sensorEnableFlag) {
+		AppRuntimeConfig_Sensors_T all = { .isLight = true, .isAccelerator = true, .isGyro = true, .isMagneto = true, .isHumidity = true, .isTemperature = true, .isPressure = true, };
+		*sensorsPtr = all;
+		return;
+	}
+
+	*sensorsPtr = configPtr->received.sensors;
+
+	if(configPtr->received.captureThresholdMilliG > 0 || configPtr->received.spectrumWindowSamples > 0) sensorsPtr->isAccelerator = true;
+
+	if(configPtr->received.fusionOutputMillis > 0) {
+		sensorsPtr->isAccelerator = true;
+		sensorsPtr->isGyro = true;
+		sensorsPtr->isMagneto = true;
+	}
+}
+/**
+ * @brief Set the sensors enabled in #appTelemetrySampling_SensorSetup.
+ * @param[in] sensorsPtr: the sensors
+ */
+static void appTelemetrySampling_SetSensorEnable(const AppRuntimeConfig_Sensors_T * sensorsPtr) {
+
+	assert(sensorsPtr);
+
+	appTelemetrySampling_SensorSetup.Enable.Accel = sensorsPtr->isAccelerator;
+	appTelemetrySampling_SensorSetup.Enable.Mag = sensorsPtr->isMagneto;
+	appTelemetrySampling_SensorSetup.Enable.Gyro = sensorsPtr->isGyro;
+	appTelemetrySampling_SensorSetup.Enable.Humidity = sensorsPtr->isHumidity;
+	appTelemetrySampling_SensorSetup.Enable.Temp = sensorsPtr->isTemperature;
+	appTelemetrySampling_SensorSetup.Enable.Pressure = sensorsPtr->isPressure;
+	appTelemetrySampling_SensorSetup.Enable.Light = sensorsPtr->isLight;
+	appTelemetrySampling_SensorSetup.Enable.Noise = false;
+
+	appTelemetrySampling_EnabledSensors = *sensorsPtr;
+}
+/**
+ * @brief Set the sampling periods of the sensors from a telemetry configuration and update the cycles per read.
+ * @details The accelerometer is read every cycle for capturing, the spectrum features and the sensor fusion, the gyroscope for the sensor fusion.
+ * @param[in] configPtr: the telemetry configuration
+ */
+static void appTelemetrySampling_SetSensorPeriods(const AppRuntimeConfig_TelemetryConfig_T * configPtr) {
+
+	assert(configPtr);
+
+	appTelemetrySampling_SensorPeriodsMillis = configPtr->received.sensorPeriodsMillis;
+
+	if(configPtr->received.captureThresholdMilliG > 0 || configPtr->received.spectrumWindowSamples > 0 || configPtr->received.fusionOutputMillis > 0) {
+		appTelemetrySampling_SensorPeriodsMillis.accelerator = 0;
+	}
+	if(configPtr->received.fusionOutputMillis > 0) appTelemetrySampling_SensorPeriodsMillis.gyro = 0;
+
+	appTelemetrySampling_UpdateSensorCycles();
+}
+/**
+ * @brief Returns the number of sampling cycles per read for a sensor period, rounded to the nearest multiple of the sampling period.
+ * @param[in] periodMillis: the period of the sensor, 0 for every cycle
+ * @return uint32_t: the number of cycles, at least 1
+ */
+static uint32_t appTelemetrySampling_GetCycles(uint32_t periodMillis) {
+
+	uint32_t cycles = (periodMillis + appTelemetrySampling_SamplingPeriodicityMillis / 2) / appTelemetrySampling_SamplingPeriodicityMillis;
+
+	return (cycles > 0) ? cycles : 1;
+}
+/**
+ * @brief Update #appTelemetrySampling_SensorCycles from the sensor periods and the sampling period.
+ */
+static void appTelemetrySampling_UpdateSensorCycles(void) {
+
+	if(0 == appTelemetrySampling_SamplingPeriodicityMillis) return;
+
+	appTelemetrySampling_SensorCycles.light = appTelemetrySampling_GetCycles(appTelemetrySampling_SensorPeriodsMillis.light);
+	appTelemetrySampling_SensorCycles.accelerator = appTelemetrySampling_GetCycles(appTelemetrySampling_SensorPeriodsMillis.accelerator);
+	appTelemetrySampling_SensorCycles.gyro = appTelemetrySampling_GetCycles(appTelemetrySampling_SensorPeriodsMillis.gyro);
+	appTelemetrySampling_SensorCycles.magneto = appTelemetrySampling_GetCycles(appTelemetrySampling_SensorPeriodsMillis.magneto);
+	appTelemetrySampling_SensorCycles.humidity = appTelemetrySampling_GetCycles(appTelemetrySampling_SensorPeriodsMillis.humidity);
+	appTelemetrySampling_SensorCycles.temperature = appTelemetrySampling_GetCycles(appTelemetrySampling_SensorPeriodsMillis.temperature);
+}
+/**
+ * @brief Get the sensors due in a sampling cycle: the sensors read whose number of cycles per read divides the cycle.
+ * @details The pressure is not sent, it is read with humidity and temperature, all three from the same BME280.
+ * @param[in] cycle: the sampling cycle of the task, 0 for the first
+ * @param[out] sensorsPtr: the sensors due
+ */
+static void appTelemetrySampling_GetDueSensors(uint32_t cycle, AppRuntimeConfig_Sensors_T * sensorsPtr) {
+
+	assert(sensorsPtr);
+
+	const AppRuntimeConfig_Sensors_T * readPtr = &appTelemetrySampling_ReadSensors;
+	const AppTelemetrySampling_SensorCycles_T * cyclesPtr = &appTelemetrySampling_SensorCycles;
+
+	sensorsPtr->isLight = readPtr->isLight && (0 == cycle % cyclesPtr->light);
+	sensorsPtr->isAccelerator = readPtr->isAccelerator && (0 == cycle % cyclesPtr->accelerator);
+	sensorsPtr->isGyro = readPtr->isGyro && (0 == cycle % cyclesPtr->gyro);
+	sensorsPtr->isMagneto = readPtr->isMagneto && (0 == cycle % cyclesPtr->magneto);
+	sensorsPtr->isHumidity = readPtr->isHumidity && (0 == cycle % cyclesPtr->humidity);
+	sensorsPtr->isTemperature = readPtr->isTemperature && (0 == cycle % cyclesPtr->temperature);
+	sensorsPtr->isPressure = readPtr->isPressure && (sensorsPtr->isHumidity || sensorsPtr->isTemperature);
+}
+/**
+ * @brief Returns the presence bits of a sample for the sensors read.
+ * @param[in] sensorsPtr: the sensors read
+ * @return uint8_t: the APP_TELEMETRY_PAYLOAD_SENSOR_* bits
+ */
+static uint8_t appTelemetrySampling_GetPresentSensors(const AppRuntimeConfig_Sensors_T * sensorsPtr) {
+
+	assert(sensorsPtr);
+
+	uint8_t presentSensors = 0;
+
+	if(sensorsPtr->isHumidity) presentSensors |= APP_TELEMETRY_PAYLOAD_SENSOR_HUMIDITY;
+	if(sensorsPtr->isLight) presentSensors |= APP_TELEMETRY_PAYLOAD_SENSOR_LIGHT;
+	if(sensorsPtr->isTemperature) presentSensors |= APP_TELEMETRY_PAYLOAD_SENSOR_TEMPERATURE;
+	if(sensorsPtr->isAccelerator) presentSensors |= APP_TELEMETRY_PAYLOAD_SENSOR_ACCEL;
+	if(sensorsPtr->isGyro) presentSensors |= APP_TELEMETRY_PAYLOAD_SENSOR_GYRO;
+	if(sensorsPtr->isMagneto) presentSensors |= APP_TELEMETRY_PAYLOAD_SENSOR_MAG;
+
+	return presentSensors;
+}
+/**
+ * @brief Select the sensors due in a sampling cycle for the next Sensor_GetData(), only set up again if they change.
+ * @details Called before the deadline of the cycle, so the setup is neither part of the read times nor delays the read.
+ * @param[in] cycle: the sampling cycle of the task, 0 for the first
+ * @exception Retcode_RaiseError: retcode from Sensor_Setup()
+ */
+static void appTelemetrySampling_SetupDueSensors(uint32_t cycle) {
+
+	AppRuntimeConfig_Sensors_T dueSensors;
+
+	appTelemetrySampling_GetDueSensors(cycle, &dueSensors);
+	if(0 != memcmp(&dueSensors, &appTelemetrySampling_EnabledSensors, sizeof(dueSensors))) {
+		appTelemetrySampling_SetSensorEnable(&dueSensors);
+		Retcode_T retcode = Sensor_Setup(&appTelemetrySampling_SensorSetup);
+		if(RETCODE_OK != retcode) Retcode_RaiseError(retcode);
+	}
+}
+/**
+ * @brief Get the histogram bucket of a time.
+ * @param[in] upperBoundsMicrosPtr: the upper bounds of all but the last bucket, ascending
+ * @param[in] micros: the time in micro seconds
+ * @return uint32_t: the index of the first bucket with an upper bound >= micros, the last bucket if none
+ */
+static uint32_t appTelemetrySampling_GetHistogramBucket(const uint32_t * upperBoundsMicrosPtr, uint32_t micros) {
+	uint32_t bucket = 0;
+	while(bucket < APP_STATUS_STATS_HISTOGRAM_BUCKETS - 1 && micros > upperBoundsMicrosPtr[bucket]) bucket++;
+	return bucket;
+}
+/**
+ * @brief Returns the current tick count and the time since its start, below the tick resolution from the SysTick counter.
+ * @param[in] cyclesPerMicro: the core clock cycles per micro second, the clock of the SysTick
+ * @param[out] subTickMicrosPtr: the micro seconds since the start of the current tick
+ * @return TickType_t: the current tick count
+ */
+static TickType_t appTelemetrySampling_GetTickCount(uint32_t cyclesPerMicro, uint32_t * subTickMicrosPtr) {
+	TickType_t currentTickCount = 0;
+	uint32_t tickElapsedCycles = 0;
+	// the SysTick counts down from LOAD within a tick, read again if the tick count moved in between
+	do {
+		currentTickCount = xTaskGetTickCount();
+		tickElapsedCycles = SysTick->LOAD - SysTick->VAL;
+	} while(currentTickCount != xTaskGetTickCount());
+	*subTickMicrosPtr = tickElapsedCycles / cyclesPerMicro;
+	return currentTickCount;
+}
+/**
+ * @brief Returns the time since the start of a tick in micro seconds, below the tick resolution from the SysTick counter.
+ * @param[in] tickCount: the tick, at or before the current tick count
+ * @param[in] cyclesPerMicro: the core clock cycles per micro second, the clock of the SysTick
+ * @return uint32_t: the micro seconds since the start of tickCount
+ */
+static uint32_t appTelemetrySampling_GetMicrosSinceTick(TickType_t tickCount, uint32_t cyclesPerMicro) {
+	uint32_t subTickMicros = 0;
+	TickType_t currentTickCount = appTelemetrySampling_GetTickCount(cyclesPerMicro, &subTickMicros);
+	return (currentTickCount - tickCount) * portTICK_RATE_MS * UINT32_C(1000) + subTickMicros;
+}
+/**
+ * @brief Start the cycle counter of the core to time the sensor reads below the tick resolution.
+ */
+static void appTelemetrySampling_StartCycleCounter(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
 /**
  * @brief Create the sampling task. Call only if it isn't running.
  * @return Retcode_T: RETCODE_OK
@@ -210,12 +522,20 @@ bool AppTelemetrySampling_isTaskRunning(void) {
 }
 /**
  * @brief The sampling task.
- * Runs a loop with a delay of the configured sampling interval. Reads the sensor data, creates a new @ref AppTelemetryPayload and adds it to the
- * @ref AppTelemetryQueue.
- * Updates the stats if sampling is slower than expected interval using @ref AppStatus_Stats_IncrementTelemetrySamplingTooSlowCounter().
+ * Runs a loop on absolute deadlines of the configured sampling interval with vTaskDelayUntil(). Reads the sensors due in the cycle (appTelemetrySampling_GetDueSensors()) and adds the data
+ * as a binary sample record with the presence bits of the sensors read to the @ref AppTelemetryQueue. The sensors due in the next cycle are set up before its deadline (appTelemetrySampling_SetupDueSensors()). Formatting into a payload happens in @ref AppTelemetryPublish.
+ * Also adds the sample to the accelerometer capture ring of @ref AppTelemetryCapture, which checks it for the capture trigger,
+ * to the spectrum window of @ref AppTelemetryAnalysis and to the orientation filter of @ref AppTelemetryFusion.
+ * Updates the stats if a cycle overruns the next deadline using @ref AppStatus_Stats_IncrementTelemetrySamplingTooSlowCounter(),
+ * the cycles dropped by the overrun policy using @ref AppStatus_Stats_IncrementTelemetrySamplingSkippedCyclesCounter(). Skipped cycles still count for multi-rate sampling.
+ * Reports the time reading the sensors took every #APP_TELEMETRY_SAMPLING_READ_STATS_CYCLES cycles using @ref AppStatus_Stats_UpdateTelemetrySamplingReadStats(),
+ * together with the histograms of the read times and of the interval jitter between reads on schedule using @ref AppStatus_Stats_UpdateTelemetrySamplingHistograms()
+ * and, if aligned to the wall clock, how late the reads started after their aligned instants using @ref AppStatus_Stats_UpdateTelemetrySamplingAlignStats().
+ * Reports the longest time adding a sample took using @ref AppStatus_Stats_UpdateTelemetrySamplingAddSampleMaxTicks().
  * @param[in] pvParameters: unused.
  * @exception Retcode_RaiseError: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_APP_TELEMETRY_SAMPLING_ERROR_READING_SENSOR_DATA)
- * @exception Retcode_RaiseError: retcode from @ref AppTelemetryQueue_AddSample()
+ * @exception Retcode_RaiseError: retcode from Sensor_Setup() if the sensors due could not be selected
+ * @exception Retcode_RaiseError: retcode from @ref AppTelemetryQueue_AddSample() if severity is not a warning
  * @exception Retcode_RaiseError: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_APP_TELEMETRY_SAMPLING_ADD_SAMPLE_TO_QUEUE))
  */
 static void appTelemetrySampling_TelemetrySamplingTask(void* pvParameters) {
@@ -228,17 +548,110 @@ static void appTelemetrySampling_TelemetrySamplingTask(void* pvParameters) {
     memset(&sensorValue, 0x00, sizeof(sensorValue));
 
     TickType_t startLoopTicks = 0;
-    int32_t loopDelayTicks = 0;
 
-    AppTelemetryPayload_T * payloadPtr = NULL;
+    // absolute deadlines, the next one is wakeTicks + periodTicks
+    const TickType_t periodTicks = MILLISECONDS(appTelemetrySampling_SamplingPeriodicityMillis);
+    TickType_t wakeTicks = xTaskGetTickCount();
+    TickType_t lateTicks = 0;
+    uint32_t missedCycles = 0;
+
+    // wall clock alignment, the first deadline is the next multiple of the sampling period since the epoch
+    bool isAligned = false;
+    uint32_t alignMicros = 0;
+    uint32_t alignCount = 0;
+    uint32_t alignTotalMicros = 0;
+    uint32_t alignMaxMicros = 0;
+
+    // longest time adding a sample took, only reported to the stats when exceeded
+    uint32_t addSampleTicks = 0;
+    uint32_t addSampleMaxTicks = 0;
+
+    // sensor read times, accumulated and reported to the stats every APP_TELEMETRY_SAMPLING_READ_STATS_CYCLES cycles
+    uint32_t cyclesPerMicro = SystemCoreClockGet() / UINT32_C(1000000);
+    uint32_t readStartCycles = 0;
+    uint32_t readMicros = 0;
+    uint32_t readCount = 0;
+    uint32_t readTotalMicros = 0;
+    uint32_t readMaxMicros = 0;
+    uint32_t readHistogram[APP_STATUS_STATS_HISTOGRAM_BUCKETS] = { 0 };
+
+    // deviation of the interval between two reads from the sampling period, only between two reads on schedule:
+    // measured in ticks and the SysTick remainder, the cycle counter wraps within about 90 s at 48 MHz
+    const uint32_t periodMicros = appTelemetrySampling_SamplingPeriodicityMillis * UINT32_C(1000);
+    TickType_t readStartTicks = 0;
+    uint32_t readStartSubTickMicros = 0;
+    TickType_t lastReadStartTicks = 0;
+    uint32_t lastReadStartSubTickMicros = 0;
+    bool isOverrun = false;
+    bool isOnSchedule = false;
+    bool isLastReadOnSchedule = false;
+    uint32_t intervalMicros = 0;
+    uint32_t jitterMicros = 0;
+    uint32_t jitterMaxMicros = 0;
+    uint32_t jitterHistogram[APP_STATUS_STATS_HISTOGRAM_BUCKETS] = { 0 };
+
+    // multi-rate sampling, the values of sensors not due hold their last reading. the sensors due are set up before the deadline of their cycle
+    uint32_t cycle = 0;
+    uint8_t presentSensors = 0;
+
+    appTelemetrySampling_SetupDueSensors(cycle);
+
+    if(appTelemetrySampling_isWallClockAligned) {
+    	isAligned = AppTimestamp_GetAlignedTickCount(wakeTicks, appTelemetrySampling_SamplingPeriodicityMillis, &wakeTicks);
+    	if(isAligned) vTaskDelay(wakeTicks - xTaskGetTickCount());
+    }
 
     while (1) {
 
     	if(pdTRUE == xSemaphoreTake(appTelemetrySampling_TaskSemaphoreHandle, APP_TELEMETRY_SAMPLING_TASK_INTERNAL_WAIT_TICKS)) {
 
     		startLoopTicks = xTaskGetTickCount();
+    		// a cycle after an overrun follows skipped cycles or is caught up, a cycle starting a period late was held up otherwise
+    		isOnSchedule = !isOverrun && (startLoopTicks - wakeTicks) < periodTicks;
+
+    		presentSensors = appTelemetrySampling_GetPresentSensors(&appTelemetrySampling_EnabledSensors);
+
+    		if(isAligned) {
+    			alignMicros = appTelemetrySampling_GetMicrosSinceTick(wakeTicks, cyclesPerMicro);
+    			alignCount++;
+    			alignTotalMicros += alignMicros;
+    			if(alignMicros > alignMaxMicros) alignMaxMicros = alignMicros;
+    		}
 
+    		readStartTicks = appTelemetrySampling_GetTickCount(cyclesPerMicro, &readStartSubTickMicros);
+    		readStartCycles = DWT->CYCCNT;
     		retcode = Sensor_GetData(&sensorValue);
+    		readMicros = (DWT->CYCCNT - readStartCycles) / cyclesPerMicro;
+
+    		// both reads on schedule: less than two periods apart, no overflow
+    		if(isOnSchedule && isLastReadOnSchedule) {
+    			intervalMicros = (readStartTicks - lastReadStartTicks) * portTICK_RATE_MS * UINT32_C(1000) + readStartSubTickMicros - lastReadStartSubTickMicros;
+    			jitterMicros = (intervalMicros > periodMicros) ? intervalMicros - periodMicros : periodMicros - intervalMicros;
+    			jitterHistogram[appTelemetrySampling_GetHistogramBucket(appTelemetrySampling_JitterUpperBoundsMicros, jitterMicros)]++;
+    			if(jitterMicros > jitterMaxMicros) jitterMaxMicros = jitterMicros;
+    		}
+    		lastReadStartTicks = readStartTicks;
+    		lastReadStartSubTickMicros = readStartSubTickMicros;
+    		isLastReadOnSchedule = isOnSchedule;
+
+    		readCount++;
+    		readTotalMicros += readMicros;
+    		if(readMicros > readMaxMicros) readMaxMicros = readMicros;
+    		readHistogram[appTelemetrySampling_GetHistogramBucket(appTelemetrySampling_ReadUpperBoundsMicros, readMicros)]++;
+    		if(readCount == APP_TELEMETRY_SAMPLING_READ_STATS_CYCLES) {
+    			AppStatus_Stats_UpdateTelemetrySamplingReadStats(readCount, readTotalMicros, readMaxMicros);
+    			AppStatus_Stats_UpdateTelemetrySamplingHistograms(jitterHistogram, jitterMaxMicros, readHistogram);
+    			if(isAligned) AppStatus_Stats_UpdateTelemetrySamplingAlignStats(alignCount, alignTotalMicros, alignMaxMicros);
+    			readCount = 0;
+    			readTotalMicros = 0;
+    			readMaxMicros = 0;
+    			jitterMaxMicros = 0;
+    			alignCount = 0;
+    			alignTotalMicros = 0;
+    			alignMaxMicros = 0;
+    			memset(readHistogram, 0, sizeof(readHistogram));
+    			memset(jitterHistogram, 0, sizeof(jitterHistogram));
+    		}
 
     		if(RETCODE_OK != retcode) {
 				// never observed
@@ -247,24 +660,40 @@ static void appTelemetrySampling_TelemetrySamplingTask(void* pvParameters) {
 
 			} else {
 
-				payloadPtr = AppTelemetryPayload_CreateNew(startLoopTicks, &sensorValue);
+				addSampleTicks = xTaskGetTickCount();
+				retcode_addQueue = AppTelemetryQueue_AddSample(startLoopTicks, &sensorValue, presentSensors);
+				AppTelemetryCapture_AddSample(startLoopTicks, &sensorValue);
+				AppTelemetryAnalysis_AddSample(startLoopTicks, &sensorValue);
+				AppTelemetryFusion_AddSample(startLoopTicks, &sensorValue);
+				addSampleTicks = xTaskGetTickCount() - addSampleTicks;
 
-				retcode_addQueue = AppTelemetryQueue_AddSample(payloadPtr, appTelemetrySampling_SamplingPeriodicityMillis);
+				if(addSampleTicks > addSampleMaxTicks) {
+					addSampleMaxTicks = addSampleTicks;
+					AppStatus_Stats_UpdateTelemetrySamplingAddSampleMaxTicks(addSampleMaxTicks);
+				}
 
-				if(RETCODE_OK != retcode_addQueue) {
+				// a full queue means the publisher is behind, the sample is discarded
+				if(RETCODE_OK != retcode_addQueue && RETCODE_SEVERITY_WARNING != Retcode_GetSeverity(retcode_addQueue)) {
 					// never observed
 					Retcode_RaiseError(retcode_addQueue);
 					Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_APP_TELEMETRY_SAMPLING_ADD_SAMPLE_TO_QUEUE));
-					AppTelemetryPayload_Delete(payloadPtr);
 				}
 			}
 
-			//calculate delay and wait
-			loopDelayTicks = appTelemetrySampling_SamplingPeriodicityMillis-(xTaskGetTickCount()-startLoopTicks);
-			if(loopDelayTicks > 0) vTaskDelay((TickType_t) loopDelayTicks);
-			else {
+			// overrun: the deadline of the next cycle has passed. catching up runs the missed cycles without delay
+			lateTicks = xTaskGetTickCount() - wakeTicks;
+			isOverrun = (lateTicks >= periodTicks);
+			if(isOverrun) {
 				AppStatus_Stats_IncrementTelemetrySamplingTooSlowCounter();
+				missedCycles = lateTicks / periodTicks;
+				if(AppRuntimeConfig_Telemetry_SamplingOverrunPolicy_Skip == appTelemetrySampling_OverrunPolicy || missedCycles > APP_TELEMETRY_SAMPLING_MAX_CATCH_UP_CYCLES) {
+					wakeTicks += missedCycles * periodTicks;
+					cycle += missedCycles;
+					AppStatus_Stats_IncrementTelemetrySamplingSkippedCyclesCounter(missedCycles);
+				}
 			}
+			appTelemetrySampling_SetupDueSensors(++cycle);
+			vTaskDelayUntil(&wakeTicks, periodTicks);
 
 			xSemaphoreGive(appTelemetrySampling_TaskSemaphoreHandle);
     	} // task semaphore
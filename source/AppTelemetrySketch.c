@@ -0,0 +1,273 @@
+/*
+ * AppTelemetrySketch.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetrySketch AppTelemetrySketch
+ * @{
+ *
+ * @brief Fixed memory quantile sketch of integer sensor values. Used by @ref AppTelemetryQueue for the quantiles of a window in the aggregation mode.
+ * @details A log-linear bucketing of the values, as DDSketch with a linearly interpolated mapping: values below 2^#APP_TELEMETRY_SKETCH_SUB_BUCKET_BITS have a bucket each,
+ * above, every power of two is split into 2^#APP_TELEMETRY_SKETCH_SUB_BUCKET_BITS buckets. A quantile is returned as the middle of its bucket,
+ * so its relative error is at most 1/2^(#APP_TELEMETRY_SKETCH_SUB_BUCKET_BITS + 1), about 3%, and it is clamped to the lowest and highest value added. The bucket of a value is computed with integer arithmetic only.
+ * @details The memory is bounded by the number of bins, 2 bytes each, allocated once in @ref AppTelemetrySketch_Create().
+ * If the values span more buckets than there are bins, adjacent buckets are merged pairwise (uniform collapse, as UDDSketch) and the level is incremented.
+ * Unlike collapsing the lowest buckets, this keeps the median of values around 0 and both tails usable.
+ * @details Every level doubles the error bound: relative 2^level / 32 above 16 * 2^level, absolute 2^level below, so 3%, 6%, 12.5%, 25% and 50% up to level 4.
+ * Beyond level 4 a bucket spans several powers of two and the quantiles are only an order of magnitude.
+ * The accelerometer range of +-16 g in milli g spans 351 buckets, the gyroscope range of +-2000 deg/s in milli deg/s 573 and the whole int32 range 896:
+ * with 512 bins any values stay within level 1, with 256 within level 2 and with 128 within level 3.
+ * @details If a bin would overflow, all bins are halved. The distribution of the values so far is kept, but values added afterwards weigh twice as much.
+ * This only happens in windows of more than 65535 values in one bucket.
+ * @details Adding a value does not allocate, it is O(1) unless the range of the values grows.
+ * @details The module has no dependencies on FreeRTOS or the XDK SDK, the accuracy is covered by the host unit test test/test_AppTelemetrySketch.c.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+
+#include "AppTelemetrySketch.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define APP_TELEMETRY_SKETCH_SUB_BUCKETS		(UINT32_C(1) << APP_TELEMETRY_SKETCH_SUB_BUCKET_BITS) /**< number of buckets per power of two */
+
+/**
+ * @brief Returns the index of the bucket of a value before any merging. Monotonic in the value, 0 for 0 and negative for negative values.
+ * @param[in] value: the value
+ * @return int32_t: the index
+ */
+static int32_t appTelemetrySketch_GetIndex(int32_t value) {
+
+	uint32_t absValue = (value < 0) ? (uint32_t) (-(int64_t) value) : (uint32_t) value;
+	uint32_t index = absValue;
+
+	if(absValue >= APP_TELEMETRY_SKETCH_SUB_BUCKETS) {
+		uint32_t shift = (31 - (uint32_t) __builtin_clz(absValue)) - APP_TELEMETRY_SKETCH_SUB_BUCKET_BITS;
+		// the top bits of the value, in [SUB_BUCKETS, 2 * SUB_BUCKETS)
+		index = shift * APP_TELEMETRY_SKETCH_SUB_BUCKETS + (absValue >> shift);
+	}
+	return (value < 0) ? -(int32_t) index : (int32_t) index;
+}
+/**
+ * @brief Returns the lowest absolute value of the bucket of a non-negative index. Inverse of appTelemetrySketch_GetIndex().
+ * @param[in] index: the index
+ * @return int64_t: the value
+ */
+static int64_t appTelemetrySketch_GetLowerValue(uint32_t index) {
+
+	if(index < APP_TELEMETRY_SKETCH_SUB_BUCKETS) return index;
+
+	uint32_t shift = index / APP_TELEMETRY_SKETCH_SUB_BUCKETS - 1;
+	return (int64_t) (index - shift * APP_TELEMETRY_SKETCH_SUB_BUCKETS) << shift;
+}
+/**
+ * @brief Returns the key of a key after merging adjacent buckets once. Monotonic, the key 0 absorbs -1 and 1.
+ * @param[in] key: the key
+ * @return int32_t: the merged key
+ */
+static inline int32_t appTelemetrySketch_MergeKey(int32_t key) {
+	return (key < 0) ? -((-key) >> 1) : (key >> 1);
+}
+/**
+ * @brief Returns the key of a value at the level of the sketch.
+ * @param[in] sketchPtr: the sketch
+ * @param[in] value: the value
+ * @return int32_t: the key
+ */
+static inline int32_t appTelemetrySketch_GetKey(const AppTelemetrySketch_T * sketchPtr, int32_t value) {
+	int32_t index = appTelemetrySketch_GetIndex(value);
+	return (index < 0) ? -((-index) >> sketchPtr->level) : (index >> sketchPtr->level);
+}
+/**
+ * @brief Returns the value representing a bucket at the level of the sketch, the middle of its range.
+ * @param[in] sketchPtr: the sketch
+ * @param[in] key: the key of the bucket
+ * @return int32_t: the value
+ */
+static int32_t appTelemetrySketch_GetValue(const AppTelemetrySketch_T * sketchPtr, int32_t key) {
+
+	// the bucket around 0 is symmetric
+	if(0 == key) return 0;
+
+	uint32_t absKey = (key < 0) ? (uint32_t) -key : (uint32_t) key;
+	int64_t lowerValue = appTelemetrySketch_GetLowerValue(absKey << sketchPtr->level);
+	int64_t upperValue = appTelemetrySketch_GetLowerValue((absKey + 1) << sketchPtr->level) - 1;
+	int64_t absValue = (lowerValue + upperValue + 1) / 2;
+
+	if(key < 0) return (-absValue < INT32_MIN) ? INT32_MIN : (int32_t) -absValue;
+	return (absValue > INT32_MAX) ? INT32_MAX : (int32_t) absValue;
+}
+/**
+ * @brief Halve all bins, rounding up so no bin becomes empty, and recount the values.
+ * @param[in,out] sketchPtr: the sketch
+ */
+static void appTelemetrySketch_Halve(AppTelemetrySketch_T * sketchPtr) {
+
+	sketchPtr->count = 0;
+	for(uint32_t i = 0; i < sketchPtr->numberOfBins; i++) {
+		sketchPtr->countsPtr[i] = (uint16_t) ((sketchPtr->countsPtr[i] + 1U) >> 1);
+		sketchPtr->count += sketchPtr->countsPtr[i];
+	}
+}
+/**
+ * @brief Merge adjacent buckets pairwise and increment the level. Up to 3 bins merge into the bin of key 0.
+ * @param[in,out] sketchPtr: the sketch
+ */
+static void appTelemetrySketch_Merge(AppTelemetrySketch_T * sketchPtr) {
+
+	uint16_t * countsPtr = sketchPtr->countsPtr;
+	uint32_t numberOfUsedBins = (uint32_t) (sketchPtr->maxKey - sketchPtr->minKey) + 1;
+
+	for(uint32_t i = 0; i < numberOfUsedBins; i++) {
+		if(countsPtr[i] > UINT16_MAX / 3) {
+			appTelemetrySketch_Halve(sketchPtr);
+			break;
+		}
+	}
+
+	int32_t minKey = appTelemetrySketch_MergeKey(sketchPtr->minKey);
+
+	// the merged bin is never behind the bin, so merge in place from the front
+	for(uint32_t i = 0; i < numberOfUsedBins; i++) {
+		uint16_t count = countsPtr[i];
+		countsPtr[i] = 0;
+		countsPtr[appTelemetrySketch_MergeKey(sketchPtr->minKey + (int32_t) i) - minKey] += count;
+	}
+
+	sketchPtr->minKey = minKey;
+	sketchPtr->maxKey = appTelemetrySketch_MergeKey(sketchPtr->maxKey);
+	sketchPtr->level++;
+}
+/**
+ * @brief Create a sketch. Allocates its bins.
+ * @param[out] sketchPtr: the sketch
+ * @param[in] numberOfBins: the number of bins, >= 2. Bounds the memory to 2 bytes per bin. Values spanning up to numberOfBins buckets are kept at the best accuracy
+ * @return bool: false if the bins could not be allocated
+ */
+bool AppTelemetrySketch_Create(AppTelemetrySketch_T * sketchPtr, uint32_t numberOfBins) {
+
+	assert(sketchPtr);
+	assert(numberOfBins > 1);
+
+	sketchPtr->countsPtr = (uint16_t *) malloc(numberOfBins * sizeof(uint16_t));
+	if(NULL == sketchPtr->countsPtr) return false;
+
+	sketchPtr->numberOfBins = numberOfBins;
+	AppTelemetrySketch_Reset(sketchPtr);
+
+	return true;
+}
+/**
+ * @brief Delete the sketch's bins.
+ * @param[in,out] sketchPtr: the sketch
+ */
+void AppTelemetrySketch_Delete(AppTelemetrySketch_T * sketchPtr) {
+
+	assert(sketchPtr);
+
+	if(NULL != sketchPtr->countsPtr) free(sketchPtr->countsPtr);
+	sketchPtr->countsPtr = NULL;
+	sketchPtr->numberOfBins = 0;
+	sketchPtr->count = 0;
+}
+/**
+ * @brief Discard all values.
+ * @param[in,out] sketchPtr: the sketch
+ */
+void AppTelemetrySketch_Reset(AppTelemetrySketch_T * sketchPtr) {
+
+	assert(sketchPtr);
+
+	if(NULL != sketchPtr->countsPtr) memset(sketchPtr->countsPtr, 0, sketchPtr->numberOfBins * sizeof(uint16_t));
+	sketchPtr->level = 0;
+	sketchPtr->minKey = 0;
+	sketchPtr->maxKey = 0;
+	sketchPtr->count = 0;
+	sketchPtr->minValue = 0;
+	sketchPtr->maxValue = 0;
+}
+/**
+ * @brief Add a value to the sketch. Does not allocate.
+ * @param[in,out] sketchPtr: the sketch
+ * @param[in] value: the value
+ */
+void AppTelemetrySketch_Add(AppTelemetrySketch_T * sketchPtr, int32_t value) {
+
+	assert(sketchPtr);
+	assert(sketchPtr->countsPtr);
+
+	int32_t key = appTelemetrySketch_GetKey(sketchPtr, value);
+
+	if(0 == sketchPtr->count) {
+		sketchPtr->minKey = key;
+		sketchPtr->maxKey = key;
+		sketchPtr->minValue = value;
+		sketchPtr->maxValue = value;
+	} else {
+		if(value < sketchPtr->minValue) sketchPtr->minValue = value;
+		if(value > sketchPtr->maxValue) sketchPtr->maxValue = value;
+
+		// merge until the range of keys fits into the bins
+		while((uint32_t) (((key > sketchPtr->maxKey) ? key : sketchPtr->maxKey) - ((key < sketchPtr->minKey) ? key : sketchPtr->minKey)) >= sketchPtr->numberOfBins) {
+			appTelemetrySketch_Merge(sketchPtr);
+			key = appTelemetrySketch_MergeKey(key);
+		}
+		if(key < sketchPtr->minKey) {
+			uint32_t shift = (uint32_t) (sketchPtr->minKey - key);
+			memmove(&sketchPtr->countsPtr[shift], &sketchPtr->countsPtr[0], (sketchPtr->numberOfBins - shift) * sizeof(uint16_t));
+			memset(&sketchPtr->countsPtr[0], 0, shift * sizeof(uint16_t));
+			sketchPtr->minKey = key;
+		}
+		if(key > sketchPtr->maxKey) sketchPtr->maxKey = key;
+	}
+
+	uint32_t bin = (uint32_t) (key - sketchPtr->minKey);
+
+	if(UINT16_MAX == sketchPtr->countsPtr[bin]) appTelemetrySketch_Halve(sketchPtr);
+
+	sketchPtr->countsPtr[bin]++;
+	sketchPtr->count++;
+}
+/**
+ * @brief Returns a quantile of the values added.
+ * @details The value of rank floor(q * (count - 1)) of the sorted values, represented by the middle of its bucket and clamped to the range of the values added.
+ * @param[in] sketchPtr: the sketch
+ * @param[in] permille: the quantile in per mille, e.g. 990 for the 99th percentile
+ * @return int32_t: the quantile, 0 if the sketch is empty
+ */
+int32_t AppTelemetrySketch_GetQuantile(const AppTelemetrySketch_T * sketchPtr, uint32_t permille) {
+
+	assert(sketchPtr);
+	assert(permille <= 1000);
+
+	if(0 == sketchPtr->count) return 0;
+
+	uint32_t rank = (uint32_t) ((uint64_t) permille * (sketchPtr->count - 1) / 1000);
+	uint32_t cumulativeCount = 0;
+	int32_t key = sketchPtr->maxKey;
+
+	for(uint32_t i = 0; i < sketchPtr->numberOfBins; i++) {
+		cumulativeCount += sketchPtr->countsPtr[i];
+		if(cumulativeCount > rank) {
+			key = sketchPtr->minKey + (int32_t) i;
+			break;
+		}
+	}
+	int32_t value = appTelemetrySketch_GetValue(sketchPtr, key);
+
+	if(value < sketchPtr->minValue) return sketchPtr->minValue;
+	if(value > sketchPtr->maxValue) return sketchPtr->maxValue;
+	return value;
+}
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,52 @@
+/*
+ * AppTelemetrySketch.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetrySketch
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYSKETCH_H_
+#define SOURCE_APPTELEMETRYSKETCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define APP_TELEMETRY_SKETCH_SUB_BUCKET_BITS		UINT32_C(4) /**< log2 of the number of buckets per power of two. Bounds the relative error of a quantile to 2^level / 2^(bits+1), see @ref AppTelemetrySketch */
+
+/**
+ * @brief Fixed memory quantile sketch of integer values.
+ * @details A bucket covers a range of values of relative width 2^level / 2^#APP_TELEMETRY_SKETCH_SUB_BUCKET_BITS, its key is monotonic in the value.
+ * The sketch counts the values of up to numberOfBins consecutive keys.
+ */
+typedef struct {
+	uint16_t * countsPtr; /**< the counts per bin, allocated by @ref AppTelemetrySketch_Create() */
+	uint32_t numberOfBins; /**< number of bins */
+	uint32_t level; /**< number of times adjacent buckets were merged to fit the range of the values into the bins */
+	int32_t minKey; /**< key of the first bin */
+	int32_t maxKey; /**< highest key counted */
+	uint32_t count; /**< number of values counted */
+	int32_t minValue; /**< lowest value added, bounds the quantiles */
+	int32_t maxValue; /**< highest value added, bounds the quantiles */
+} AppTelemetrySketch_T;
+
+bool AppTelemetrySketch_Create(AppTelemetrySketch_T * sketchPtr, uint32_t numberOfBins);
+
+void AppTelemetrySketch_Delete(AppTelemetrySketch_T * sketchPtr);
+
+void AppTelemetrySketch_Reset(AppTelemetrySketch_T * sketchPtr);
+
+void AppTelemetrySketch_Add(AppTelemetrySketch_T * sketchPtr, int32_t value);
+
+int32_t AppTelemetrySketch_GetQuantile(const AppTelemetrySketch_T * sketchPtr, uint32_t permille);
+
+#endif /* SOURCE_APPTELEMETRYSKETCH_H_ */
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,368 @@
+/*
+ * AppTelemetrySpectrum.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetrySpectrum AppTelemetrySpectrum
+ * @{
+ *
+ * @brief Fixed-point vibration spectrum features of accelerometer windows. Used by @ref AppTelemetryAnalysis.
+ * @details Per axis of a window: the RMS and the crest factor of the values without their mean, and the top-K peaks of the amplitude spectrum.
+ * @details The spectrum is computed by an in-place radix-2 decimation-in-time FFT on Q15 values, with integer arithmetic only, for the Cortex-M3 without FPU:
+ * - the values are shifted to use 14 bits before the transform (block floating point) and a Hann window is applied,
+ * - each stage scales by 1/2 with rounding, which cannot overflow, the transform is scaled by 1/N,
+ * - the twiddles come from a single sine table in flash for the max number of points, smaller transforms use every n-th entry,
+ * - the butterflies are computed with the twiddle in the outer loop, the first twiddle of a stage (1) without multiplies,
+ * - x and y are transformed together as the real and imaginary part of one complex transform and separated using the symmetry of real transforms,
+ *   so a window of 3 axes takes 2 transforms. x and y of very different amplitudes are transformed one by one instead, the smaller one would drown in the rounding errors of the larger one.
+ * @details The amplitude of a peak is the amplitude of a sine at the center of the bin, corrected for the gain of the Hann window.
+ * A sine between two bins reads up to 15% low (scalloping loss of the Hann window).
+ * @details The rounding of each stage costs about 3 dB of SNR per doubling of the points: a full scale input is transformed at about 70 dB SNR with 16 points
+ * and 54 dB with 512 points. An input below full scale loses that ratio in addition, e.g. an axis 1/8 of the other axis of its transform about 18 dB.
+ * @details The module has no dependencies on FreeRTOS or the XDK SDK, the transform and the features are covered by the host unit test test/test_AppTelemetrySpectrum.c.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+
+#include "AppTelemetrySpectrum.h"
+
+#include <string.h>
+#include <assert.h>
+
+#define APP_TELEMETRY_SPECTRUM_INPUT_MAX		INT32_C(16383) /**< max absolute value of the input of a transform, a complex input of two axes stays below 2^15 */
+#define APP_TELEMETRY_SPECTRUM_MAX_PAIR_SHIFT_DIFFERENCE	INT32_C(2) /**< x and y share a transform if their scales differ by at most 2^2, otherwise the smaller axis would lose its resolution */
+
+/**
+ * @brief Q15 sine table: sin(2 pi k / #APP_TELEMETRY_SPECTRUM_MAX_POINTS) for k in [0, 3/4 * #APP_TELEMETRY_SPECTRUM_MAX_POINTS]. The cosine is the sine a quarter period later.
+ */
+static const int16_t appTelemetrySpectrum_SineTable[APP_TELEMETRY_SPECTRUM_MAX_POINTS * 3 / 4 + 1] = {
+	0, 402, 804, 1206, 1608, 2009, 2411, 2811, 3212, 3612, 4011, 4410,
+	4808, 5205, 5602, 5998, 6393, 6787, 7180, 7571, 7962, 8351, 8740, 9127,
+	9512, 9896, 10279, 10660, 11039, 11417, 11793, 12167, 12540, 12910, 13279, 13646,
+	14010, 14373, 14733, 15091, 15447, 15800, 16151, 16500, 16846, 17190, 17531, 17869,
+	18205, 18538, 18868, 19195, 19520, 19841, 20160, 20475, 20788, 21097, 21403, 21706,
+	22006, 22302, 22595, 22884, 23170, 23453, 23732, 24008, 24279, 24548, 24812, 25073,
+	25330, 25583, 25833, 26078, 26320, 26557, 26791, 27020, 27246, 27467, 27684, 27897,
+	28106, 28311, 28511, 28707, 28899, 29086, 29269, 29448, 29622, 29792, 29957, 30118,
+	30274, 30425, 30572, 30715, 30853, 30986, 31114, 31238, 31357, 31471, 31581, 31686,
+	31786, 31881, 31972, 32058, 32138, 32214, 32286, 32352, 32413, 32470, 32522, 32568,
+	32610, 32647, 32679, 32706, 32729, 32746, 32758, 32766, 32767, 32766, 32758, 32746,
+	32729, 32706, 32679, 32647, 32610, 32568, 32522, 32470, 32413, 32352, 32286, 32214,
+	32138, 32058, 31972, 31881, 31786, 31686, 31581, 31471, 31357, 31238, 31114, 30986,
+	30853, 30715, 30572, 30425, 30274, 30118, 29957, 29792, 29622, 29448, 29269, 29086,
+	28899, 28707, 28511, 28311, 28106, 27897, 27684, 27467, 27246, 27020, 26791, 26557,
+	26320, 26078, 25833, 25583, 25330, 25073, 24812, 24548, 24279, 24008, 23732, 23453,
+	23170, 22884, 22595, 22302, 22006, 21706, 21403, 21097, 20788, 20475, 20160, 19841,
+	19520, 19195, 18868, 18538, 18205, 17869, 17531, 17190, 16846, 16500, 16151, 15800,
+	15447, 15091, 14733, 14373, 14010, 13646, 13279, 12910, 12540, 12167, 11793, 11417,
+	11039, 10660, 10279, 9896, 9512, 9127, 8740, 8351, 7962, 7571, 7180, 6787,
+	6393, 5998, 5602, 5205, 4808, 4410, 4011, 3612, 3212, 2811, 2411, 2009,
+	1608, 1206, 804, 402, 0, -402, -804, -1206, -1608, -2009, -2411, -2811,
+	-3212, -3612, -4011, -4410, -4808, -5205, -5602, -5998, -6393, -6787, -7180, -7571,
+	-7962, -8351, -8740, -9127, -9512, -9896, -10279, -10660, -11039, -11417, -11793, -12167,
+	-12540, -12910, -13279, -13646, -14010, -14373, -14733, -15091, -15447, -15800, -16151, -16500,
+	-16846, -17190, -17531, -17869, -18205, -18538, -18868, -19195, -19520, -19841, -20160, -20475,
+	-20788, -21097, -21403, -21706, -22006, -22302, -22595, -22884, -23170, -23453, -23732, -24008,
+	-24279, -24548, -24812, -25073, -25330, -25583, -25833, -26078, -26320, -26557, -26791, -27020,
+	-27246, -27467, -27684, -27897, -28106, -28311, -28511, -28707, -28899, -29086, -29269, -29448,
+	-29622, -29792, -29957, -30118, -30274, -30425, -30572, -30715, -30853, -30986, -31114, -31238,
+	-31357, -31471, -31581, -31686, -31786, -31881, -31972, -32058, -32138, -32214, -32286, -32352,
+	-32413, -32470, -32522, -32568, -32610, -32647, -32679, -32706, -32729, -32746, -32758, -32766,
+	-32768
+};
+/**
+ * @brief Returns cos(2 pi k / #APP_TELEMETRY_SPECTRUM_MAX_POINTS) in Q15.
+ * @param[in] index: k, in [0, #APP_TELEMETRY_SPECTRUM_MAX_POINTS / 2]
+ * @return int32_t: the cosine
+ */
+static inline int32_t appTelemetrySpectrum_GetCos(uint32_t index) {
+	return appTelemetrySpectrum_SineTable[index + APP_TELEMETRY_SPECTRUM_MAX_POINTS / 4];
+}
+/**
+ * @brief Returns the integer square root of a number, rounded down.
+ * @param[in] value: the number
+ * @return uint32_t: the square root
+ */
+static uint32_t appTelemetrySpectrum_Sqrt(uint64_t value) {
+
+	uint64_t root = 0;
+	uint64_t bit = UINT64_C(1) << 62;
+
+	while(bit > value) bit >>= 2;
+
+	while(bit != 0) {
+		if(value >= root + bit) {
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (uint32_t) root;
+}
+/**
+ * @brief In-place radix-2 decimation-in-time FFT of Q15 values, scaled by 1/N. Integer arithmetic only.
+ * @details The input must be below 2^15 in magnitude, i.e. |re + j im| < 32768. Each stage halves the values, so no stage can overflow.
+ * @param[in,out] rePtr: the real parts, array of 2^log2NumberOfPoints values
+ * @param[in,out] imPtr: the imaginary parts, array of 2^log2NumberOfPoints values
+ * @param[in] log2NumberOfPoints: log2 of the number of points, at most #APP_TELEMETRY_SPECTRUM_LOG2_MAX_POINTS
+ */
+void AppTelemetrySpectrum_Fft(int16_t * rePtr, int16_t * imPtr, uint32_t log2NumberOfPoints) {
+
+	assert(rePtr);
+	assert(imPtr);
+	assert(log2NumberOfPoints >= 1 && log2NumberOfPoints <= APP_TELEMETRY_SPECTRUM_LOG2_MAX_POINTS);
+
+	const uint32_t numberOfPoints = UINT32_C(1) << log2NumberOfPoints;
+
+	// bit reversed order
+	for(uint32_t i = 0, j = 0; i < numberOfPoints - 1; i++) {
+		if(i < j) {
+			int16_t re = rePtr[i]; rePtr[i] = rePtr[j]; rePtr[j] = re;
+			int16_t im = imPtr[i]; imPtr[i] = imPtr[j]; imPtr[j] = im;
+		}
+		uint32_t bit = numberOfPoints >> 1;
+		while(j & bit) {
+			j ^= bit;
+			bit >>= 1;
+		}
+		j |= bit;
+	}
+
+	for(uint32_t half = 1; half < numberOfPoints; half <<= 1) {
+
+		const uint32_t span = half << 1;
+		const uint32_t tableStep = APP_TELEMETRY_SPECTRUM_MAX_POINTS / span;
+
+		// twiddle 1
+		for(uint32_t i = 0; i < numberOfPoints; i += span) {
+			int32_t re = rePtr[i + half];
+			int32_t im = imPtr[i + half];
+			rePtr[i + half] = (int16_t) ((rePtr[i] - re + 1) >> 1);
+			imPtr[i + half] = (int16_t) ((imPtr[i] - im + 1) >> 1);
+			rePtr[i] = (int16_t) ((rePtr[i] + re + 1) >> 1);
+			imPtr[i] = (int16_t) ((imPtr[i] + im + 1) >> 1);
+		}
+
+		for(uint32_t k = 1; k < half; k++) {
+			// W = cos - j sin
+			const int32_t c = appTelemetrySpectrum_GetCos(k * tableStep);
+			const int32_t s = appTelemetrySpectrum_SineTable[k * tableStep];
+
+			for(uint32_t i = k; i < numberOfPoints; i += span) {
+				int32_t re = (c * rePtr[i + half] + s * imPtr[i + half] + (INT32_C(1) << 14)) >> 15;
+				int32_t im = (c * imPtr[i + half] - s * rePtr[i + half] + (INT32_C(1) << 14)) >> 15;
+				rePtr[i + half] = (int16_t) ((rePtr[i] - re + 1) >> 1);
+				imPtr[i + half] = (int16_t) ((imPtr[i] - im + 1) >> 1);
+				rePtr[i] = (int16_t) ((rePtr[i] + re + 1) >> 1);
+				imPtr[i] = (int16_t) ((imPtr[i] + im + 1) >> 1);
+			}
+		}
+	}
+}
+/**
+ * @brief Computes the RMS and the crest factor of the values of an axis and the shift that scales them to #APP_TELEMETRY_SPECTRUM_INPUT_MAX.
+ * @param[in] valuesPtr: the values of the axis
+ * @param[in] numberOfPoints: the number of values
+ * @param[out] featuresPtr: receives the RMS and the crest factor
+ * @param[out] meanPtr: the mean, rounded
+ * @return int32_t: the shift, to the left if positive, to the right if negative
+ */
+static int32_t appTelemetrySpectrum_ComputeStatistics(const int16_t * valuesPtr, uint32_t numberOfPoints, AppTelemetrySpectrum_AxisFeatures_T * featuresPtr, int32_t * meanPtr) {
+
+	int64_t sum = 0;
+	uint64_t sumOfSquares = 0;
+
+	for(uint32_t i = 0; i < numberOfPoints; i++) {
+		int32_t value = valuesPtr[i];
+		sum += value;
+		sumOfSquares += (uint64_t) ((int64_t) value * value);
+	}
+
+	// sum of the squared deviations from the mean: (N * sum(x^2) - sum(x)^2) / N
+	uint64_t sumOfSquaredDeviations = (numberOfPoints * sumOfSquares - (uint64_t) (sum * sum)) / numberOfPoints;
+	featuresPtr->rmsThousandths = appTelemetrySpectrum_Sqrt(sumOfSquaredDeviations * UINT64_C(1000000) / numberOfPoints);
+
+	int32_t mean = (int32_t) ((sum + ((sum < 0) ? -(int64_t) (numberOfPoints / 2) : (int64_t) (numberOfPoints / 2))) / (int64_t) numberOfPoints);
+	int32_t maxDeviation = 0;
+
+	for(uint32_t i = 0; i < numberOfPoints; i++) {
+		int32_t deviation = valuesPtr[i] - mean;
+		if(deviation < 0) deviation = -deviation;
+		if(deviation > maxDeviation) maxDeviation = deviation;
+	}
+
+	featuresPtr->crestFactorThousandths = (featuresPtr->rmsThousandths > 0) ? (uint32_t) ((uint64_t) maxDeviation * UINT64_C(1000000) / featuresPtr->rmsThousandths) : 0;
+
+	*meanPtr = mean;
+
+	int32_t shift = 0;
+	if(maxDeviation > APP_TELEMETRY_SPECTRUM_INPUT_MAX) {
+		while((maxDeviation >> -shift) > APP_TELEMETRY_SPECTRUM_INPUT_MAX) shift--;
+	} else if(maxDeviation > 0) {
+		while((maxDeviation << (shift + 1)) <= APP_TELEMETRY_SPECTRUM_INPUT_MAX) shift++;
+	}
+	return shift;
+}
+/**
+ * @brief Fill one part of the input of a transform with the values of an axis: without the mean, scaled and with the Hann window applied.
+ * @param[in] valuesPtr: the values of the axis
+ * @param[in] log2NumberOfPoints: log2 of the number of values
+ * @param[in] mean: the mean of the values
+ * @param[in] shift: the scale, to the left if positive, to the right if negative
+ * @param[out] inputPtr: the real or imaginary parts of the input
+ */
+static void appTelemetrySpectrum_FillInput(const int16_t * valuesPtr, uint32_t log2NumberOfPoints, int32_t mean, int32_t shift, int16_t * inputPtr) {
+
+	const uint32_t numberOfPoints = UINT32_C(1) << log2NumberOfPoints;
+	const uint32_t tableStep = APP_TELEMETRY_SPECTRUM_MAX_POINTS >> log2NumberOfPoints;
+
+	for(uint32_t i = 0; i < numberOfPoints; i++) {
+		int32_t value = valuesPtr[i] - mean;
+		value = (shift >= 0) ? (value * (INT32_C(1) << shift)) : (value >> -shift);
+		// Hann window: (1 - cos(2 pi i / N)) / 2, symmetric around N / 2
+		uint32_t index = (i <= numberOfPoints / 2) ? i : numberOfPoints - i;
+		int32_t window = (INT32_C(32767) - appTelemetrySpectrum_GetCos(index * tableStep)) >> 1;
+		inputPtr[i] = (int16_t) ((value * window) >> 15);
+	}
+}
+/**
+ * @brief Returns 4 times the squared magnitude of bin k of the transform of one real input, separated from a transform of two real inputs z = x + j y.
+ * @details X[k] = (Z[k] + conj(Z[N-k])) / 2, Y[k] = (Z[k] - conj(Z[N-k])) / 2j. For a single real input in the real parts, X[k] = Z[k].
+ * @param[in] rePtr: the real parts of the transform
+ * @param[in] imPtr: the imaginary parts of the transform
+ * @param[in] numberOfPoints: the number of points
+ * @param[in] k: the bin, in [1, N/2)
+ * @param[in] isImaginaryInput: false for x, true for y
+ * @return uint64_t: 4 |X[k]|^2 or 4 |Y[k]|^2
+ */
+static inline uint64_t appTelemetrySpectrum_GetPower4(const int16_t * rePtr, const int16_t * imPtr, uint32_t numberOfPoints, uint32_t k, bool isImaginaryInput) {
+
+	int32_t re, im;
+
+	if(isImaginaryInput) {
+		re = imPtr[k] + imPtr[numberOfPoints - k];
+		im = rePtr[numberOfPoints - k] - rePtr[k];
+	} else {
+		re = rePtr[k] + rePtr[numberOfPoints - k];
+		im = imPtr[k] - imPtr[numberOfPoints - k];
+	}
+	return (uint64_t) ((int64_t) re * re) + (uint64_t) ((int64_t) im * im);
+}
+/**
+ * @brief Find the highest local maxima of the amplitude spectrum of an axis, excluding DC and the Nyquist frequency.
+ * @param[in] rePtr: the real parts of the transform
+ * @param[in] imPtr: the imaginary parts of the transform
+ * @param[in] log2NumberOfPoints: log2 of the number of points
+ * @param[in] isImaginaryInput: the axis was the imaginary part of the input
+ * @param[in] shift: the scale of the input, to the left if positive, to the right if negative
+ * @param[in] samplingPeriodMillis: the sampling period
+ * @param[in] numberOfPeaks: the max number of peaks
+ * @param[in,out] featuresPtr: the RMS of the axis, receives the peaks
+ */
+static void appTelemetrySpectrum_FindPeaks(const int16_t * rePtr, const int16_t * imPtr, uint32_t log2NumberOfPoints, bool isImaginaryInput, int32_t shift,
+		uint32_t samplingPeriodMillis, uint32_t numberOfPeaks, AppTelemetrySpectrum_AxisFeatures_T * featuresPtr) {
+
+	featuresPtr->numberOfPeaks = 0;
+	// a constant axis has no spectrum, only the rounding errors of the other axis of the transform
+	if(0 == featuresPtr->rmsThousandths) return;
+
+	const uint32_t numberOfPoints = UINT32_C(1) << log2NumberOfPoints;
+
+	uint64_t peakPowers[APP_TELEMETRY_SPECTRUM_MAX_PEAKS];
+	uint32_t peakBins[APP_TELEMETRY_SPECTRUM_MAX_PEAKS];
+	uint32_t count = 0;
+
+	uint64_t previous = 0;
+	uint64_t current = appTelemetrySpectrum_GetPower4(rePtr, imPtr, numberOfPoints, 1, isImaginaryInput);
+
+	for(uint32_t k = 1; k < numberOfPoints / 2; k++) {
+
+		uint64_t next = (k + 1 < numberOfPoints / 2) ? appTelemetrySpectrum_GetPower4(rePtr, imPtr, numberOfPoints, k + 1, isImaginaryInput) : 0;
+
+		if(current > previous && current >= next && (count < numberOfPeaks || current > peakPowers[count - 1])) {
+			// insert, highest first
+			uint32_t i = (count < numberOfPeaks) ? count++ : count - 1;
+			for(; i > 0 && peakPowers[i - 1] < current; i--) {
+				peakPowers[i] = peakPowers[i - 1];
+				peakBins[i] = peakBins[i - 1];
+			}
+			peakPowers[i] = current;
+			peakBins[i] = k;
+		}
+		previous = current;
+		current = next;
+	}
+
+	featuresPtr->numberOfPeaks = count;
+
+	for(uint32_t i = 0; i < count; i++) {
+		// amplitude of the scaled input: 4 |X| for the Hann window and the 1/N scaling, i.e. 2 sqrt(4 |X|^2)
+		uint32_t amplitudeThousandths = appTelemetrySpectrum_Sqrt(peakPowers[i] * UINT64_C(4000000));
+		featuresPtr->peaks[i].amplitudeThousandths = (shift >= 0) ? (amplitudeThousandths >> shift) : (amplitudeThousandths << -shift);
+		featuresPtr->peaks[i].frequencyMilliHz = (uint32_t) ((uint64_t) peakBins[i] * UINT64_C(1000000) / ((uint64_t) numberOfPoints * samplingPeriodMillis));
+	}
+}
+/**
+ * @brief Computes the features of a window of 3 axes: RMS, crest factor and the highest peaks of the amplitude spectrum per axis.
+ * @details Does not allocate. Takes 2 transforms of 2^log2NumberOfPoints points, 3 if the amplitudes of x and y differ by more than a factor of 4.
+ * @param[in] valuesPtr: the values, 3 consecutive arrays of 2^log2NumberOfPoints values: x, y, z
+ * @param[in] log2NumberOfPoints: log2 of the number of values per axis, in [4, #APP_TELEMETRY_SPECTRUM_LOG2_MAX_POINTS]
+ * @param[in] samplingPeriodMillis: the sampling period of the values, for the frequencies of the peaks
+ * @param[in] numberOfPeaks: max number of peaks per axis, at most #APP_TELEMETRY_SPECTRUM_MAX_PEAKS
+ * @param[out] workPtr: work buffer of 2 * 2^log2NumberOfPoints values
+ * @param[out] featuresPtr: the features
+ */
+void AppTelemetrySpectrum_ComputeFeatures(const int16_t * valuesPtr, uint32_t log2NumberOfPoints, uint32_t samplingPeriodMillis, uint32_t numberOfPeaks,
+		int16_t * workPtr, AppTelemetrySpectrum_Features_T * featuresPtr) {
+
+	assert(valuesPtr);
+	assert(workPtr);
+	assert(featuresPtr);
+	assert((UINT32_C(1) << log2NumberOfPoints) >= APP_TELEMETRY_SPECTRUM_MIN_POINTS && log2NumberOfPoints <= APP_TELEMETRY_SPECTRUM_LOG2_MAX_POINTS);
+	assert(samplingPeriodMillis > 0);
+	assert(numberOfPeaks <= APP_TELEMETRY_SPECTRUM_MAX_PEAKS);
+
+	const uint32_t numberOfPoints = UINT32_C(1) << log2NumberOfPoints;
+	int16_t * rePtr = workPtr;
+	int16_t * imPtr = &workPtr[numberOfPoints];
+
+	int32_t means[APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES];
+	int32_t shifts[APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES];
+
+	for(uint32_t axis = 0; axis < APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES; axis++) {
+		shifts[axis] = appTelemetrySpectrum_ComputeStatistics(&valuesPtr[axis * numberOfPoints], numberOfPoints, &featuresPtr->axes[axis], &means[axis]);
+	}
+
+	uint32_t firstSingleAxis = 0;
+
+	int32_t shiftDifference = shifts[0] - shifts[1];
+	if(shiftDifference >= -APP_TELEMETRY_SPECTRUM_MAX_PAIR_SHIFT_DIFFERENCE && shiftDifference <= APP_TELEMETRY_SPECTRUM_MAX_PAIR_SHIFT_DIFFERENCE) {
+		// x and y in one transform, at the scale of the larger one
+		int32_t shift = (shifts[0] < shifts[1]) ? shifts[0] : shifts[1];
+		appTelemetrySpectrum_FillInput(&valuesPtr[0], log2NumberOfPoints, means[0], shift, rePtr);
+		appTelemetrySpectrum_FillInput(&valuesPtr[numberOfPoints], log2NumberOfPoints, means[1], shift, imPtr);
+		AppTelemetrySpectrum_Fft(rePtr, imPtr, log2NumberOfPoints);
+		appTelemetrySpectrum_FindPeaks(rePtr, imPtr, log2NumberOfPoints, false, shift, samplingPeriodMillis, numberOfPeaks, &featuresPtr->axes[0]);
+		appTelemetrySpectrum_FindPeaks(rePtr, imPtr, log2NumberOfPoints, true, shift, samplingPeriodMillis, numberOfPeaks, &featuresPtr->axes[1]);
+		firstSingleAxis = 2;
+	}
+
+	for(uint32_t axis = firstSingleAxis; axis < APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES; axis++) {
+		appTelemetrySpectrum_FillInput(&valuesPtr[axis * numberOfPoints], log2NumberOfPoints, means[axis], shifts[axis], rePtr);
+		memset(imPtr, 0, numberOfPoints * sizeof(int16_t));
+		AppTelemetrySpectrum_Fft(rePtr, imPtr, log2NumberOfPoints);
+		appTelemetrySpectrum_FindPeaks(rePtr, imPtr, log2NumberOfPoints, false, shifts[axis], samplingPeriodMillis, numberOfPeaks, &featuresPtr->axes[axis]);
+	}
+}
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,58 @@
+/*
+ * AppTelemetrySpectrum.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetrySpectrum
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYSPECTRUM_H_
+#define SOURCE_APPTELEMETRYSPECTRUM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define APP_TELEMETRY_SPECTRUM_LOG2_MAX_POINTS		UINT32_C(9) /**< log2 of the max number of points of a transform */
+#define APP_TELEMETRY_SPECTRUM_MAX_POINTS			(UINT32_C(1) << APP_TELEMETRY_SPECTRUM_LOG2_MAX_POINTS) /**< max number of points of a transform */
+#define APP_TELEMETRY_SPECTRUM_MIN_POINTS			UINT32_C(16) /**< min number of points of a transform */
+#define APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES		UINT32_C(3) /**< number of axes of a window: x, y, z */
+#define APP_TELEMETRY_SPECTRUM_MAX_PEAKS			UINT32_C(8) /**< max number of peaks per axis */
+
+/**
+ * @brief A peak of the amplitude spectrum.
+ */
+typedef struct {
+	uint32_t frequencyMilliHz; /**< frequency of the bin in milli Hz */
+	uint32_t amplitudeThousandths; /**< amplitude of a sine at the frequency in thousandths of the unit of the values */
+} AppTelemetrySpectrum_Peak_T;
+/**
+ * @brief Features of an axis of a window.
+ */
+typedef struct {
+	uint32_t rmsThousandths; /**< RMS of the values without their mean, in thousandths of the unit of the values */
+	uint32_t crestFactorThousandths; /**< largest deviation from the mean over the RMS, in thousandths. 0 if the RMS is 0 */
+	uint32_t numberOfPeaks; /**< number of peaks found, at most the number requested */
+	AppTelemetrySpectrum_Peak_T peaks[APP_TELEMETRY_SPECTRUM_MAX_PEAKS]; /**< the peaks, highest amplitude first */
+} AppTelemetrySpectrum_AxisFeatures_T;
+/**
+ * @brief Features of a window. See @ref AppTelemetrySpectrum_ComputeFeatures().
+ */
+typedef struct {
+	AppTelemetrySpectrum_AxisFeatures_T axes[APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES]; /**< the features per axis */
+} AppTelemetrySpectrum_Features_T;
+
+void AppTelemetrySpectrum_Fft(int16_t * rePtr, int16_t * imPtr, uint32_t log2NumberOfPoints);
+
+void AppTelemetrySpectrum_ComputeFeatures(const int16_t * valuesPtr, uint32_t log2NumberOfPoints, uint32_t samplingPeriodMillis, uint32_t numberOfPeaks,
+		int16_t * workPtr, AppTelemetrySpectrum_Features_T * featuresPtr);
+
+#endif /* SOURCE_APPTELEMETRYSPECTRUM_H_ */
+
+/**@} */
+/** ************************************************************************* */
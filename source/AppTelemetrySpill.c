@@ -0,0 +1,333 @@
+/*
+ * AppTelemetrySpill.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetrySpill AppTelemetrySpill
+ * @{
+ *
+ * @brief Store-and-forward of telemetry events on the SD card while the broker is not reachable.
+ * @details @ref AppTelemetryPublish appends every batch it cannot publish to a segmented log (@ref AppTelemetrySpillLog) on the SD card.
+ * Once the connection is back, it replays up to spillReplayEventsPerCycle events from the log per publishing cycle, alongside the live events.
+ * @details The events are stored as binary sample records and formatted at replay time.
+ * Each event is stored with the time of its first sample in milliseconds since the epoch; the tick counts of the samples only give the offsets, they are meaningless after a reboot.
+ * @ref AppTelemetrySpill_Enable() rebuilds the log index from the SD card, so events spilled before a reset are replayed after it.
+ * Events spilled before the time was known and left from a previous run can't be timestamped and are discarded.
+ * @details If the log is full, the oldest segment is discarded. Spilled, replayed and discarded events are counted in @ref AppStatus stats.
+ * @details Spilling is disabled if no SD card is available or spillReplayEventsPerCycle is 0.
+ * @note Append, read and consume are only called by the publishing task; configuration is only changed while it is not running.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+#include "XdkAppInfo.h"
+
+#undef BCDS_MODULE_ID /**< undefine any previous module id */
+#define BCDS_MODULE_ID SOLACE_APP_MODULE_ID_APP_TELEMETRY_SPILL
+
+#include "AppTelemetrySpill.h"
+#include "AppTelemetrySpillLog.h"
+#include "AppStatus.h"
+#include "AppTimestamp.h"
+
+#include "XDK_Storage.h"
+
+#define APP_TELEMETRY_SPILL_SEGMENT_SIZE			UINT32_C(65536) /**< max size of a segment file in bytes */
+#define APP_TELEMETRY_SPILL_NUMBER_OF_SEGMENTS		UINT32_C(16) /**< number of segment files */
+
+static bool appTelemetrySpill_isSdCardAvailable = false; /**< flag if the SD card was available at enable */
+
+static uint8_t appTelemetrySpill_ReplayEventsPerCycle = APP_RT_CFG_DEFAULT_SPILL_REPLAY_EVENTS_PER_CYCLE; /**< local copy of configuration. number of events to replay per publishing cycle */
+
+static AppTelemetrySpillLog_T appTelemetrySpill_Log; /**< the spill log */
+
+static uint32_t appTelemetrySpill_NumberOfDroppedEvents = 0; /**< number of dropped events already counted in the stats */
+
+static uint32_t appTelemetrySpill_NumberOfPreviousRunEvents = 0; /**< number of the oldest events in the log that were spilled in a previous run */
+
+static AppTelemetryPayload_Sample_T * appTelemetrySpill_ReplayBufferPtr = NULL; /**< buffer for the event read from the log */
+
+static uint32_t appTelemetrySpill_ReplayBufferSize = 0; /**< size of #appTelemetrySpill_ReplayBufferPtr in bytes */
+
+/**
+ * @brief Storage function for the log: write to a file on the SD card.
+ * @see AppTelemetrySpillLog_Write_Func_T
+ */
+static bool appTelemetrySpill_StorageWrite(const char * fileName, const uint8_t * bufferPtr, uint32_t length, uint32_t offset) {
+
+	Storage_Write_T storageWrite = {
+		.FileName = fileName,
+		.WriteBuffer = (uint8_t *) bufferPtr,
+		.BytesToWrite = length,
+		.ActualBytesWritten = 0UL,
+		.Offset = offset
+	};
+
+	if(RETCODE_OK != Storage_Write(STORAGE_MEDIUM_SD_CARD, &storageWrite)) return false;
+
+	return (storageWrite.ActualBytesWritten == length);
+}
+/**
+ * @brief Storage function for the log: read from a file on the SD card.
+ * @see AppTelemetrySpillLog_Read_Func_T
+ */
+static bool appTelemetrySpill_StorageRead(const char * fileName, uint8_t * bufferPtr, uint32_t length, uint32_t offset) {
+
+	Storage_Read_T storageRead = {
+		.FileName = fileName,
+		.ReadBuffer = bufferPtr,
+		.BytesToRead = length,
+		.ActualBytesRead = 0UL,
+		.Offset = offset
+	};
+
+	if(RETCODE_OK != Storage_Read(STORAGE_MEDIUM_SD_CARD, &storageRead)) return false;
+
+	return (storageRead.ActualBytesRead == length);
+}
+/**
+ * @brief Storage function for the log: delete a file on the SD card.
+ * @see AppTelemetrySpillLog_Delete_Func_T
+ */
+static bool appTelemetrySpill_StorageDelete(const char * fileName) {
+	return (RETCODE_OK == Storage_Delete(STORAGE_MEDIUM_SD_CARD, fileName));
+}
+/**
+ * @brief The SD card storage functions for the log.
+ */
+static const AppTelemetrySpillLog_Storage_T appTelemetrySpill_Storage = {
+	.writeFunc = appTelemetrySpill_StorageWrite,
+	.readFunc = appTelemetrySpill_StorageRead,
+	.deleteFunc = appTelemetrySpill_StorageDelete
+};
+/**
+ * @brief Add events dropped by the log since the last call to the stats.
+ */
+static void appTelemetrySpill_UpdateDroppedStats(void) {
+
+	uint32_t numberOfDroppedEvents = appTelemetrySpill_Log.numberOfDroppedRecords;
+
+	if(numberOfDroppedEvents != appTelemetrySpill_NumberOfDroppedEvents) {
+		AppStatus_Stats_IncrementTelemetrySpillDroppedEventsCounter(numberOfDroppedEvents - appTelemetrySpill_NumberOfDroppedEvents);
+		appTelemetrySpill_NumberOfDroppedEvents = numberOfDroppedEvents;
+	}
+}
+/**
+ * @brief Initialize the module.
+ * @return Retcode_T: RETCODE_OK
+ */
+Retcode_T AppTelemetrySpill_Init(void) {
+
+	appTelemetrySpill_isSdCardAvailable = false;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Setup the module with the configuration.
+ * @param[in] configPtr: the runtime configuration. Module requires targetTelemetryConfigPtr
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: retcode from @ref AppTelemetrySpill_ApplyNewRuntimeConfig()
+ */
+Retcode_T AppTelemetrySpill_Setup(const AppRuntimeConfig_T * configPtr) {
+
+	assert(configPtr);
+	assert(configPtr->targetTelemetryConfigPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	if(RETCODE_OK == retcode) retcode = AppTelemetrySpill_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, configPtr->targetTelemetryConfigPtr);
+
+	return retcode;
+}
+/**
+ * @brief Apply a new runtime configuration to the module.
+ * @details AppRuntimeConfig_Element_targetTelemetryConfig: the replay rate. Events already in the log are kept.
+ * @note Call only while the publishing task is not running.
+ * @param[in] configElement: the type of configuration to apply.
+ * @param[in] newConfigPtr: the configuration of type configElement
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT)
+ */
+Retcode_T AppTelemetrySpill_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr) {
+
+	assert(newConfigPtr);
+
+	Retcode_T retcode = RETCODE_OK;
+
+	switch(configElement) {
+	case AppRuntimeConfig_Element_targetTelemetryConfig:
+		appTelemetrySpill_ReplayEventsPerCycle = ((AppRuntimeConfig_TelemetryConfig_T *) newConfigPtr)->received.spillReplayEventsPerCycle;
+		break;
+	default: retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_UNSUPPORTED_RUNTIME_CONFIG_ELEMENT);
+	}
+
+	return retcode;
+}
+/**
+ * @brief Enable the module. Opens the log on the SD card, the events of a previous run are kept for replay.
+ * @details If no SD card is available, spilling stays disabled and telemetry is not captured during an outage.
+ * @note Call after @ref AppConfig has set up the storage.
+ * @return Retcode_T: RETCODE_OK
+ */
+Retcode_T AppTelemetrySpill_Enable(void) {
+
+	bool status = false;
+	Retcode_T retcode = Storage_IsAvailable(STORAGE_MEDIUM_SD_CARD, &status);
+
+	appTelemetrySpill_isSdCardAvailable = ((RETCODE_OK == retcode) && status);
+
+	if(!appTelemetrySpill_isSdCardAvailable) {
+		printf("[WARNING] - AppTelemetrySpill_Enable: SD card not available, telemetry will not be spilled during an outage.\r\n");
+		return RETCODE_OK;
+	}
+
+	AppTelemetrySpillLog_Open(&appTelemetrySpill_Log, &appTelemetrySpill_Storage, APP_TELEMETRY_SPILL_SEGMENT_SIZE, APP_TELEMETRY_SPILL_NUMBER_OF_SEGMENTS);
+	appTelemetrySpill_NumberOfDroppedEvents = 0;
+	appTelemetrySpill_NumberOfPreviousRunEvents = appTelemetrySpill_Log.numberOfRecoveredRecords;
+
+	if(appTelemetrySpill_NumberOfPreviousRunEvents > 0) printf("[INFO] - AppTelemetrySpill_Enable: %lu events of a previous run to replay.\r\n", (unsigned long) appTelemetrySpill_NumberOfPreviousRunEvents);
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Returns true if telemetry is spilled to the SD card while the broker is not reachable.
+ * @return bool: true if the SD card is available and spillReplayEventsPerCycle > 0
+ */
+bool AppTelemetrySpill_IsEnabled(void) {
+	return (appTelemetrySpill_isSdCardAvailable && appTelemetrySpill_ReplayEventsPerCycle > 0);
+}
+/**
+ * @brief Returns the configured number of events to replay per publishing cycle.
+ * @return uint8_t: the number of events
+ */
+uint8_t AppTelemetrySpill_GetReplayEventsPerCycle(void) {
+	return appTelemetrySpill_ReplayEventsPerCycle;
+}
+/**
+ * @brief Append an event to the log. If the log is full, the oldest events are discarded.
+ * @details The event is stored with the time of its first sample in milliseconds since the epoch, 0 if @ref AppTimestamp is not enabled yet.
+ * @param[in] samplesPtr: the samples of the event
+ * @param[in] numberOfSamples: the number of samples
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_TELEMETRY_SPILL_NOT_ENABLED)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_SPILL_WRITE_FAILED)
+ */
+Retcode_T AppTelemetrySpill_Append(const AppTelemetryPayload_Sample_T * samplesPtr, uint8_t numberOfSamples) {
+
+	assert(samplesPtr);
+
+	if(!AppTelemetrySpill_IsEnabled()) return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_TELEMETRY_SPILL_NOT_ENABLED);
+
+	uint64_t millisSinceEpoch = 0;
+	if(!AppTimestamp_GetMillisSinceEpoch(AppTimestamp_GetTimestamp(samplesPtr[0].tickCount), &millisSinceEpoch)) millisSinceEpoch = 0;
+
+	AppTelemetrySpillLog_Result_T result = AppTelemetrySpillLog_Append(&appTelemetrySpill_Log, samplesPtr, sizeof(AppTelemetryPayload_Sample_T), numberOfSamples, millisSinceEpoch);
+
+	appTelemetrySpill_UpdateDroppedStats();
+
+	if(AppTelemetrySpillLog_Result_Ok != result) return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_SPILL_WRITE_FAILED);
+
+	AppStatus_Stats_IncrementTelemetrySpilledEventsCounter();
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Read the oldest event in the log. Call @ref AppTelemetrySpill_Consume() once it has been published.
+ * @details Corrupt events and events of a previous run without a time are discarded and counted in the stats.
+ * @param[out] samplesPtrPtr: the samples of the event. Owned by the module, valid until the next call.
+ * @param[out] numberOfSamplesPtr: the number of samples
+ * @param[out] firstMillisSinceEpochPtr: the time of the first sample in milliseconds since the epoch, 0 if spilled in this run before the time was known. Encode with @ref AppTelemetryPayload_EncodeBatchAt().
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_INFO, #RETCODE_SOLAPP_TELEMETRY_SPILL_EMPTY)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_SPILL_READ_FAILED)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_TELEMETRY_SPILL_FAILED_TO_ALLOCATE)
+ */
+Retcode_T AppTelemetrySpill_ReadNext(const AppTelemetryPayload_Sample_T ** samplesPtrPtr, uint8_t * numberOfSamplesPtr, uint64_t * firstMillisSinceEpochPtr) {
+
+	assert(samplesPtrPtr);
+	assert(numberOfSamplesPtr);
+	assert(firstMillisSinceEpochPtr);
+
+	if(!appTelemetrySpill_isSdCardAvailable) return RETCODE(RETCODE_SEVERITY_INFO, RETCODE_SOLAPP_TELEMETRY_SPILL_EMPTY);
+
+	uint16_t elementSize = 0;
+	uint16_t numberOfElements = 0;
+	uint64_t millisSinceEpoch = 0;
+	AppTelemetrySpillLog_Result_T result = AppTelemetrySpillLog_Result_Corrupt;
+
+	// corrupt records discard the rest of their segment, the log shrinks with every attempt
+	while(AppTelemetrySpillLog_Result_Corrupt == result) {
+
+		// the oldest events are dropped first, the remaining ones of the previous run are still the oldest
+		uint32_t numberOfEvents = AppTelemetrySpillLog_GetNumberOfRecords(&appTelemetrySpill_Log);
+		if(appTelemetrySpill_NumberOfPreviousRunEvents > numberOfEvents) appTelemetrySpill_NumberOfPreviousRunEvents = numberOfEvents;
+
+		result = AppTelemetrySpillLog_ReadNext(&appTelemetrySpill_Log, appTelemetrySpill_ReplayBufferPtr, appTelemetrySpill_ReplayBufferSize, &elementSize, &numberOfElements, &millisSinceEpoch);
+
+		if(AppTelemetrySpillLog_Result_BufferTooSmall == result) {
+			uint32_t bufferSize = (uint32_t) elementSize * numberOfElements;
+			if(NULL != appTelemetrySpill_ReplayBufferPtr) free(appTelemetrySpill_ReplayBufferPtr);
+			appTelemetrySpill_ReplayBufferPtr = (AppTelemetryPayload_Sample_T *) malloc(bufferSize);
+			appTelemetrySpill_ReplayBufferSize = (NULL == appTelemetrySpill_ReplayBufferPtr) ? 0 : bufferSize;
+			if(NULL == appTelemetrySpill_ReplayBufferPtr) return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_SPILL_FAILED_TO_ALLOCATE);
+
+			result = AppTelemetrySpillLog_ReadNext(&appTelemetrySpill_Log, appTelemetrySpill_ReplayBufferPtr, appTelemetrySpill_ReplayBufferSize, &elementSize, &numberOfElements, &millisSinceEpoch);
+		}
+
+		// the tick counts of a previous run can't be turned into a time
+		if(AppTelemetrySpillLog_Result_Ok == result && 0 == millisSinceEpoch && appTelemetrySpill_NumberOfPreviousRunEvents > 0) {
+			AppTelemetrySpill_Consume();
+			AppStatus_Stats_IncrementTelemetrySpillDroppedEventsCounter(1);
+			result = AppTelemetrySpillLog_Result_Corrupt;
+		}
+	}
+
+	appTelemetrySpill_UpdateDroppedStats();
+
+	if(AppTelemetrySpillLog_Result_Empty == result) return RETCODE(RETCODE_SEVERITY_INFO, RETCODE_SOLAPP_TELEMETRY_SPILL_EMPTY);
+
+	if(AppTelemetrySpillLog_Result_Ok != result) return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_SPILL_READ_FAILED);
+
+	// written by a different firmware version
+	if(sizeof(AppTelemetryPayload_Sample_T) != elementSize || numberOfElements > UINT8_MAX) {
+		AppTelemetrySpill_Consume();
+		AppStatus_Stats_IncrementTelemetrySpillDroppedEventsCounter(1);
+		return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_SPILL_READ_FAILED);
+	}
+
+	*samplesPtrPtr = appTelemetrySpill_ReplayBufferPtr;
+	*numberOfSamplesPtr = (uint8_t) numberOfElements;
+	*firstMillisSinceEpochPtr = millisSinceEpoch;
+
+	return RETCODE_OK;
+}
+/**
+ * @brief Remove the event returned by the last successful @ref AppTelemetrySpill_ReadNext() from the log.
+ */
+void AppTelemetrySpill_Consume(void) {
+
+	if(!appTelemetrySpill_isSdCardAvailable) return;
+
+	if(appTelemetrySpill_NumberOfPreviousRunEvents > 0) appTelemetrySpill_NumberOfPreviousRunEvents--;
+
+	AppTelemetrySpillLog_Consume(&appTelemetrySpill_Log);
+}
+/**
+ * @brief Returns the number of events in the log.
+ * @return uint32_t: the number of events
+ */
+uint32_t AppTelemetrySpill_GetNumberOfEvents(void) {
+
+	if(!appTelemetrySpill_isSdCardAvailable) return 0;
+
+	return AppTelemetrySpillLog_GetNumberOfRecords(&appTelemetrySpill_Log);
+}
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,44 @@
+/*
+ * AppTelemetrySpill.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetrySpill
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYSPILL_H_
+#define SOURCE_APPTELEMETRYSPILL_H_
+
+#include "AppTelemetryPayload.h"
+#include "AppRuntimeConfig.h"
+
+Retcode_T AppTelemetrySpill_Init(void);
+
+Retcode_T AppTelemetrySpill_Setup(const AppRuntimeConfig_T * configPtr);
+
+Retcode_T AppTelemetrySpill_ApplyNewRuntimeConfig(AppRuntimeConfig_ConfigElement_T configElement, const void * newConfigPtr);
+
+Retcode_T AppTelemetrySpill_Enable(void);
+
+bool AppTelemetrySpill_IsEnabled(void);
+
+uint8_t AppTelemetrySpill_GetReplayEventsPerCycle(void);
+
+Retcode_T AppTelemetrySpill_Append(const AppTelemetryPayload_Sample_T * samplesPtr, uint8_t numberOfSamples);
+
+Retcode_T AppTelemetrySpill_ReadNext(const AppTelemetryPayload_Sample_T ** samplesPtrPtr, uint8_t * numberOfSamplesPtr, uint64_t * firstMillisSinceEpochPtr);
+
+void AppTelemetrySpill_Consume(void);
+
+uint32_t AppTelemetrySpill_GetNumberOfEvents(void);
+
+#endif /* SOURCE_APPTELEMETRYSPILL_H_ */
+
+/**@} */
+/** ************************************************************************* */
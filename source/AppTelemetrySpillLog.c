@@ -0,0 +1,461 @@
+/*
+ * AppTelemetrySpillLog.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+ * @defgroup AppTelemetrySpillLog AppTelemetrySpillLog
+ * @{
+ *
+ * @brief Append-only, segmented log of binary records. Used by @ref AppTelemetrySpill to store telemetry batches on the SD card while the broker is not reachable.
+ * @details The log is spread over a fixed number of segment files, written in sequence and reused round-robin.
+ * A segment starts with an 8 byte header: 'X','S','P','L' followed by the segment sequence number (uint32, little endian).
+ * @details Each record is a 16 byte header followed by the record data:
+ * - marker 0x5A, 0xA5. The first byte is overwritten with 0x00 once the record is consumed.
+ * - element size (uint16, little endian)
+ * - number of elements (uint16, little endian)
+ * - Fletcher-16 checksum of the record data (uint16, little endian)
+ * - timestamp of the record given by the caller (uint64, little endian), e.g. milliseconds since the epoch
+ * @details A record that fails the checks (e.g. a torn write) discards the rest of its segment.
+ * @details @ref AppTelemetrySpillLog_Open() rebuilds the index from the segment files: it finds the newest run of consecutive segment sequence numbers,
+ * skips the consumed records and continues writing after the last complete record. Records consumed just before a reset may be read again.
+ * @details The module has no dependencies on FreeRTOS or the XDK SDK, storage access goes through #AppTelemetrySpillLog_Storage_T. See test/test_AppTelemetrySpillLog.c for the host unit test with file-backed storage functions.
+ *
+ * @author $(SOLACE_APP_AUTHOR)
+ *
+ * @date $(SOLACE_APP_DATE)
+ *
+ * @file
+ *
+ **/
+
+#include "AppTelemetrySpillLog.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#define APP_TELEMETRY_SPILL_LOG_FILE_NAME_FORMAT		"/TLMSPL%02u.BIN" /**< segment file name format, 8.3 file names */
+#define APP_TELEMETRY_SPILL_LOG_RECORD_MARKER_0			UINT8_C(0x5A) /**< first byte of a record header */
+#define APP_TELEMETRY_SPILL_LOG_RECORD_MARKER_1			UINT8_C(0xA5) /**< second byte of a record header */
+#define APP_TELEMETRY_SPILL_LOG_RECORD_CONSUMED_MARKER_0	UINT8_C(0x00) /**< first byte of the header of a consumed record */
+
+/**
+ * @brief Write a uint16 little endian.
+ * @param[out] bufferPtr: the buffer
+ * @param[in] value: the value
+ */
+static inline void appTelemetrySpillLog_PutUint16(uint8_t * bufferPtr, uint16_t value) {
+	bufferPtr[0] = (uint8_t) (value & 0xFF);
+	bufferPtr[1] = (uint8_t) (value >> 8);
+}
+/**
+ * @brief Read a uint16 little endian.
+ * @param[in] bufferPtr: the buffer
+ * @return uint16_t: the value
+ */
+static inline uint16_t appTelemetrySpillLog_GetUint16(const uint8_t * bufferPtr) {
+	return (uint16_t) (bufferPtr[0] | (bufferPtr[1] << 8));
+}
+/**
+ * @brief Write a uint64 little endian.
+ * @param[out] bufferPtr: the buffer
+ * @param[in] value: the value
+ */
+static inline void appTelemetrySpillLog_PutUint64(uint8_t * bufferPtr, uint64_t value) {
+	for(uint32_t i = 0; i < 8; i++) bufferPtr[i] = (uint8_t) ((value >> (8 * i)) & 0xFF);
+}
+/**
+ * @brief Read a uint64 little endian.
+ * @param[in] bufferPtr: the buffer
+ * @return uint64_t: the value
+ */
+static inline uint64_t appTelemetrySpillLog_GetUint64(const uint8_t * bufferPtr) {
+	uint64_t value = 0;
+	for(uint32_t i = 0; i < 8; i++) value |= ((uint64_t) bufferPtr[i]) << (8 * i);
+	return value;
+}
+/**
+ * @brief Fletcher-16 checksum.
+ * @param[in] dataPtr: the data
+ * @param[in] length: the length of the data in bytes
+ * @return uint16_t: the checksum
+ */
+static uint16_t appTelemetrySpillLog_Checksum(const uint8_t * dataPtr, uint32_t length) {
+	uint32_t sum1 = 0;
+	uint32_t sum2 = 0;
+	for(uint32_t i = 0; i < length; i++) {
+		sum1 = (sum1 + dataPtr[i]) % 255;
+		sum2 = (sum2 + sum1) % 255;
+	}
+	return (uint16_t) ((sum2 << 8) | sum1);
+}
+/**
+ * @brief Returns the file name of the segment with sequence number segmentSeq.
+ * @param[in] logPtr: the log
+ * @param[in] segmentSeq: the segment sequence number
+ * @param[out] fileNameBuffer: buffer of #APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH
+ */
+static void appTelemetrySpillLog_GetFileName(const AppTelemetrySpillLog_T * logPtr, uint32_t segmentSeq, char * fileNameBuffer) {
+	snprintf(fileNameBuffer, APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH, APP_TELEMETRY_SPILL_LOG_FILE_NAME_FORMAT, (uint8_t) (segmentSeq % logPtr->numberOfSegments));
+}
+/**
+ * @brief Delete the segment file with sequence number segmentSeq.
+ * @param[in] logPtr: the log
+ * @param[in] segmentSeq: the segment sequence number
+ */
+static void appTelemetrySpillLog_DeleteSegment(const AppTelemetrySpillLog_T * logPtr, uint32_t segmentSeq) {
+	char fileName[APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH];
+	appTelemetrySpillLog_GetFileName(logPtr, segmentSeq, fileName);
+	logPtr->storage.deleteFunc(fileName);
+}
+/**
+ * @brief Delete all segments and start over with an empty log in the next segment.
+ * @param[in,out] logPtr: the log
+ */
+static void appTelemetrySpillLog_Restart(AppTelemetrySpillLog_T * logPtr) {
+
+	for(uint32_t segmentSeq = logPtr->readSegmentSeq; segmentSeq != logPtr->writeSegmentSeq + 1; segmentSeq++) {
+		appTelemetrySpillLog_DeleteSegment(logPtr, segmentSeq);
+		logPtr->segmentRecords[segmentSeq % logPtr->numberOfSegments] = 0;
+	}
+	logPtr->writeSegmentSeq++;
+	logPtr->readSegmentSeq = logPtr->writeSegmentSeq;
+	logPtr->writeOffset = 0;
+	logPtr->readOffset = APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE;
+	logPtr->pendingRecordSize = 0;
+	logPtr->numberOfRecords = 0;
+}
+/**
+ * @brief Drop the records left in the read segment and move on to the next segment.
+ * @param[in,out] logPtr: the log
+ */
+static void appTelemetrySpillLog_DropReadSegment(AppTelemetrySpillLog_T * logPtr) {
+
+	uint32_t slot = logPtr->readSegmentSeq % logPtr->numberOfSegments;
+
+	logPtr->numberOfDroppedRecords += logPtr->segmentRecords[slot];
+	logPtr->numberOfRecords -= logPtr->segmentRecords[slot];
+	logPtr->segmentRecords[slot] = 0;
+	logPtr->pendingRecordSize = 0;
+
+	if(logPtr->readSegmentSeq == logPtr->writeSegmentSeq) {
+		// nothing left at all
+		appTelemetrySpillLog_Restart(logPtr);
+	} else {
+		appTelemetrySpillLog_DeleteSegment(logPtr, logPtr->readSegmentSeq);
+		logPtr->readSegmentSeq++;
+		logPtr->readOffset = APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE;
+	}
+}
+/**
+ * @brief Start a new write segment. Drops the oldest segment if all segments are in use.
+ * @param[in,out] logPtr: the log
+ * @return bool: true if successful, false if the segment header could not be written
+ */
+static bool appTelemetrySpillLog_StartSegment(AppTelemetrySpillLog_T * logPtr) {
+
+	if(0 != logPtr->writeOffset) logPtr->writeSegmentSeq++;
+
+	if(logPtr->writeSegmentSeq - logPtr->readSegmentSeq >= logPtr->numberOfSegments) appTelemetrySpillLog_DropReadSegment(logPtr);
+
+	char fileName[APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH];
+	appTelemetrySpillLog_GetFileName(logPtr, logPtr->writeSegmentSeq, fileName);
+
+	// no stale records from a previous use of the file
+	logPtr->storage.deleteFunc(fileName);
+
+	uint8_t header[APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE] = { 'X', 'S', 'P', 'L', 0, 0, 0, 0 };
+	appTelemetrySpillLog_PutUint16(&header[4], (uint16_t) (logPtr->writeSegmentSeq & 0xFFFF));
+	appTelemetrySpillLog_PutUint16(&header[6], (uint16_t) (logPtr->writeSegmentSeq >> 16));
+
+	if(!logPtr->storage.writeFunc(fileName, header, sizeof(header), 0)) {
+		logPtr->writeOffset = 0;
+		return false;
+	}
+	logPtr->writeOffset = APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE;
+	logPtr->segmentRecords[logPtr->writeSegmentSeq % logPtr->numberOfSegments] = 0;
+
+	return true;
+}
+/**
+ * @brief Read the header of the segment file in slot.
+ * @param[in] logPtr: the log
+ * @param[in] slot: the segment slot, < numberOfSegments
+ * @param[out] segmentSeqPtr: the sequence number of the segment
+ * @return bool: true if the file exists and has a valid header for this slot
+ */
+static bool appTelemetrySpillLog_ReadSegmentHeader(const AppTelemetrySpillLog_T * logPtr, uint32_t slot, uint32_t * segmentSeqPtr) {
+
+	char fileName[APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH];
+	appTelemetrySpillLog_GetFileName(logPtr, slot, fileName);
+
+	uint8_t header[APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE];
+	if(!logPtr->storage.readFunc(fileName, header, sizeof(header), 0)) return false;
+	if('X' != header[0] || 'S' != header[1] || 'P' != header[2] || 'L' != header[3]) return false;
+
+	*segmentSeqPtr = (uint32_t) appTelemetrySpillLog_GetUint16(&header[4]) | ((uint32_t) appTelemetrySpillLog_GetUint16(&header[6]) << 16);
+
+	// written with a different number of segments
+	return (slot == *segmentSeqPtr % logPtr->numberOfSegments);
+}
+/**
+ * @brief Scan the records of the segment with sequence number segmentSeq and count the unread ones.
+ * @details Stops at the first record that is incomplete or has no valid marker, e.g. the end of the segment or a torn write.
+ * @param[in,out] logPtr: the log, the record count of the segment slot is set
+ * @param[in] segmentSeq: the segment sequence number
+ * @param[out] firstOffsetPtr: the offset of the first unread record, the end offset if there is none
+ * @return uint32_t: the offset after the last complete record
+ */
+static uint32_t appTelemetrySpillLog_ScanSegment(AppTelemetrySpillLog_T * logPtr, uint32_t segmentSeq, uint32_t * firstOffsetPtr) {
+
+	char fileName[APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH];
+	appTelemetrySpillLog_GetFileName(logPtr, segmentSeq, fileName);
+
+	uint32_t slot = segmentSeq % logPtr->numberOfSegments;
+	uint32_t offset = APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE;
+	bool isFirstOffset = false;
+
+	logPtr->segmentRecords[slot] = 0;
+
+	while(offset + APP_TELEMETRY_SPILL_LOG_RECORD_HEADER_SIZE <= logPtr->maxSegmentSize) {
+
+		uint8_t header[APP_TELEMETRY_SPILL_LOG_RECORD_HEADER_SIZE];
+		if(!logPtr->storage.readFunc(fileName, header, sizeof(header), offset)) break;
+
+		bool isUnread = (APP_TELEMETRY_SPILL_LOG_RECORD_MARKER_0 == header[0]);
+		if(APP_TELEMETRY_SPILL_LOG_RECORD_MARKER_1 != header[1] || (!isUnread && APP_TELEMETRY_SPILL_LOG_RECORD_CONSUMED_MARKER_0 != header[0])) break;
+
+		uint32_t dataSize = (uint32_t) appTelemetrySpillLog_GetUint16(&header[2]) * appTelemetrySpillLog_GetUint16(&header[4]);
+		uint32_t recordSize = APP_TELEMETRY_SPILL_LOG_RECORD_HEADER_SIZE + dataSize;
+		if(offset + recordSize > logPtr->maxSegmentSize) break;
+
+		// the data of a torn write is incomplete, the checksum is verified when the record is read
+		uint8_t lastByte;
+		if(dataSize > 0 && !logPtr->storage.readFunc(fileName, &lastByte, 1, offset + recordSize - 1)) break;
+
+		if(isUnread) {
+			if(!isFirstOffset) *firstOffsetPtr = offset;
+			isFirstOffset = true;
+			logPtr->segmentRecords[slot]++;
+		}
+		offset += recordSize;
+	}
+
+	if(!isFirstOffset) *firstOffsetPtr = offset;
+
+	return offset;
+}
+/**
+ * @brief Open the log and rebuild the index from the segment files of a previous run.
+ * @details The segments with the newest run of consecutive sequence numbers are kept, any other segment files are deleted.
+ * Writing continues after the last complete record of the newest segment, reading with the oldest unread record.
+ * The number of unread records found is in numberOfRecoveredRecords.
+ * @param[in,out] logPtr: the log to initialize
+ * @param[in] storagePtr: the storage functions, copied
+ * @param[in] maxSegmentSize: the max size of a segment file in bytes
+ * @param[in] numberOfSegments: the number of segment files, <= #APP_TELEMETRY_SPILL_LOG_MAX_NUMBER_OF_SEGMENTS
+ */
+void AppTelemetrySpillLog_Open(AppTelemetrySpillLog_T * logPtr, const AppTelemetrySpillLog_Storage_T * storagePtr, uint32_t maxSegmentSize, uint32_t numberOfSegments) {
+
+	assert(logPtr);
+	assert(storagePtr);
+	assert(numberOfSegments > 0 && numberOfSegments <= APP_TELEMETRY_SPILL_LOG_MAX_NUMBER_OF_SEGMENTS);
+	assert(maxSegmentSize > APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE + APP_TELEMETRY_SPILL_LOG_RECORD_HEADER_SIZE);
+
+	memset(logPtr, 0, sizeof(*logPtr));
+	logPtr->storage = *storagePtr;
+	logPtr->maxSegmentSize = maxSegmentSize;
+	logPtr->numberOfSegments = numberOfSegments;
+	logPtr->readOffset = APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE;
+
+	uint32_t segmentSeqs[APP_TELEMETRY_SPILL_LOG_MAX_NUMBER_OF_SEGMENTS];
+	bool isSegment[APP_TELEMETRY_SPILL_LOG_MAX_NUMBER_OF_SEGMENTS];
+	bool isAnySegment = false;
+	uint32_t lastSegmentSeq = 0;
+
+	for(uint32_t slot = 0; slot < numberOfSegments; slot++) {
+		isSegment[slot] = appTelemetrySpillLog_ReadSegmentHeader(logPtr, slot, &segmentSeqs[slot]);
+		if(isSegment[slot] && (!isAnySegment || segmentSeqs[slot] > lastSegmentSeq)) lastSegmentSeq = segmentSeqs[slot];
+		isAnySegment = isAnySegment || isSegment[slot];
+	}
+
+	// the segments in use are consecutive, ending with the newest one
+	uint32_t firstSegmentSeq = lastSegmentSeq;
+	while(isAnySegment && firstSegmentSeq > 0 && lastSegmentSeq - (firstSegmentSeq - 1) < numberOfSegments) {
+		uint32_t slot = (firstSegmentSeq - 1) % numberOfSegments;
+		if(!isSegment[slot] || segmentSeqs[slot] != firstSegmentSeq - 1) break;
+		firstSegmentSeq--;
+	}
+
+	for(uint32_t slot = 0; slot < numberOfSegments; slot++) {
+		bool isInUse = isSegment[slot] && segmentSeqs[slot] >= firstSegmentSeq && segmentSeqs[slot] <= lastSegmentSeq;
+		if(!isInUse) appTelemetrySpillLog_DeleteSegment(logPtr, slot);
+	}
+
+	if(!isAnySegment) return;
+
+	for(uint32_t segmentSeq = firstSegmentSeq; segmentSeq <= lastSegmentSeq; segmentSeq++) {
+		uint32_t firstOffset = APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE;
+		uint32_t endOffset = appTelemetrySpillLog_ScanSegment(logPtr, segmentSeq, &firstOffset);
+		if(segmentSeq == firstSegmentSeq) logPtr->readOffset = firstOffset;
+		if(segmentSeq == lastSegmentSeq) logPtr->writeOffset = endOffset;
+		logPtr->numberOfRecords += logPtr->segmentRecords[segmentSeq % numberOfSegments];
+	}
+	logPtr->readSegmentSeq = firstSegmentSeq;
+	logPtr->writeSegmentSeq = lastSegmentSeq;
+	logPtr->numberOfRecoveredRecords = logPtr->numberOfRecords;
+
+	// everything was consumed, start with a fresh segment
+	if(0 == logPtr->numberOfRecords) appTelemetrySpillLog_Restart(logPtr);
+}
+/**
+ * @brief Append a record of numberOfElements elements to the log.
+ * @details Starts a new segment if the record doesn't fit into the current one. If all segments are in use, the oldest segment is dropped.
+ * @param[in,out] logPtr: the log
+ * @param[in] elementsPtr: the elements, elementSize x numberOfElements bytes
+ * @param[in] elementSize: the size of one element
+ * @param[in] numberOfElements: the number of elements
+ * @param[in] timestamp: the timestamp of the record, stored with it
+ * @return AppTelemetrySpillLog_Result_T: #AppTelemetrySpillLog_Result_Ok, #AppTelemetrySpillLog_Result_RecordTooLarge, #AppTelemetrySpillLog_Result_StorageError
+ */
+AppTelemetrySpillLog_Result_T AppTelemetrySpillLog_Append(AppTelemetrySpillLog_T * logPtr, const void * elementsPtr, uint16_t elementSize, uint16_t numberOfElements, uint64_t timestamp) {
+
+	assert(logPtr);
+	assert(elementsPtr);
+
+	uint32_t dataSize = (uint32_t) elementSize * numberOfElements;
+	uint32_t recordSize = APP_TELEMETRY_SPILL_LOG_RECORD_HEADER_SIZE + dataSize;
+
+	if(APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE + recordSize > logPtr->maxSegmentSize) return AppTelemetrySpillLog_Result_RecordTooLarge;
+
+	if(0 == logPtr->writeOffset || logPtr->writeOffset + recordSize > logPtr->maxSegmentSize) {
+		if(!appTelemetrySpillLog_StartSegment(logPtr)) return AppTelemetrySpillLog_Result_StorageError;
+	}
+
+	uint8_t header[APP_TELEMETRY_SPILL_LOG_RECORD_HEADER_SIZE] = { APP_TELEMETRY_SPILL_LOG_RECORD_MARKER_0, APP_TELEMETRY_SPILL_LOG_RECORD_MARKER_1 };
+	appTelemetrySpillLog_PutUint16(&header[2], elementSize);
+	appTelemetrySpillLog_PutUint16(&header[4], numberOfElements);
+	appTelemetrySpillLog_PutUint16(&header[6], appTelemetrySpillLog_Checksum((const uint8_t *) elementsPtr, dataSize));
+	appTelemetrySpillLog_PutUint64(&header[8], timestamp);
+
+	char fileName[APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH];
+	appTelemetrySpillLog_GetFileName(logPtr, logPtr->writeSegmentSeq, fileName);
+
+	// a failed write leaves the write position, the next record overwrites it
+	if(!logPtr->storage.writeFunc(fileName, header, sizeof(header), logPtr->writeOffset)) return AppTelemetrySpillLog_Result_StorageError;
+	if(!logPtr->storage.writeFunc(fileName, (const uint8_t *) elementsPtr, dataSize, logPtr->writeOffset + sizeof(header))) return AppTelemetrySpillLog_Result_StorageError;
+
+	logPtr->writeOffset += recordSize;
+	logPtr->segmentRecords[logPtr->writeSegmentSeq % logPtr->numberOfSegments]++;
+	logPtr->numberOfRecords++;
+
+	return AppTelemetrySpillLog_Result_Ok;
+}
+/**
+ * @brief Read the oldest record without removing it. Call @ref AppTelemetrySpillLog_Consume() once it has been processed.
+ * @param[in,out] logPtr: the log
+ * @param[out] bufferPtr: the buffer for the record data
+ * @param[in] bufferSize: the size of the buffer
+ * @param[out] elementSizePtr: the element size of the record
+ * @param[out] numberOfElementsPtr: the number of elements in the record
+ * @param[out] timestampPtr: the timestamp of the record
+ * @return AppTelemetrySpillLog_Result_T: #AppTelemetrySpillLog_Result_Ok, #AppTelemetrySpillLog_Result_Empty
+ * @return AppTelemetrySpillLog_Result_T: #AppTelemetrySpillLog_Result_BufferTooSmall - elementSizePtr and numberOfElementsPtr are set, call again with a larger buffer
+ * @return AppTelemetrySpillLog_Result_T: #AppTelemetrySpillLog_Result_Corrupt - the rest of the segment was dropped, call again for the next record
+ */
+AppTelemetrySpillLog_Result_T AppTelemetrySpillLog_ReadNext(AppTelemetrySpillLog_T * logPtr, void * bufferPtr, uint32_t bufferSize, uint16_t * elementSizePtr, uint16_t * numberOfElementsPtr, uint64_t * timestampPtr) {
+
+	assert(logPtr);
+	assert(elementSizePtr);
+	assert(numberOfElementsPtr);
+	assert(timestampPtr);
+
+	logPtr->pendingRecordSize = 0;
+
+	if(0 == logPtr->numberOfRecords) return AppTelemetrySpillLog_Result_Empty;
+
+	// skip read segments, the records are in a later segment
+	while(0 == logPtr->segmentRecords[logPtr->readSegmentSeq % logPtr->numberOfSegments]) {
+		appTelemetrySpillLog_DeleteSegment(logPtr, logPtr->readSegmentSeq);
+		logPtr->readSegmentSeq++;
+		logPtr->readOffset = APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE;
+	}
+
+	char fileName[APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH];
+	appTelemetrySpillLog_GetFileName(logPtr, logPtr->readSegmentSeq, fileName);
+
+	uint8_t header[APP_TELEMETRY_SPILL_LOG_RECORD_HEADER_SIZE];
+
+	if(!logPtr->storage.readFunc(fileName, header, sizeof(header), logPtr->readOffset) ||
+		APP_TELEMETRY_SPILL_LOG_RECORD_MARKER_0 != header[0] ||
+		APP_TELEMETRY_SPILL_LOG_RECORD_MARKER_1 != header[1]) {
+
+		appTelemetrySpillLog_DropReadSegment(logPtr);
+		return AppTelemetrySpillLog_Result_Corrupt;
+	}
+
+	*elementSizePtr = appTelemetrySpillLog_GetUint16(&header[2]);
+	*numberOfElementsPtr = appTelemetrySpillLog_GetUint16(&header[4]);
+	*timestampPtr = appTelemetrySpillLog_GetUint64(&header[8]);
+
+	uint32_t dataSize = (uint32_t) *elementSizePtr * *numberOfElementsPtr;
+
+	if(dataSize > bufferSize) return AppTelemetrySpillLog_Result_BufferTooSmall;
+
+	if(!logPtr->storage.readFunc(fileName, (uint8_t *) bufferPtr, dataSize, logPtr->readOffset + sizeof(header)) ||
+		appTelemetrySpillLog_Checksum((const uint8_t *) bufferPtr, dataSize) != appTelemetrySpillLog_GetUint16(&header[6])) {
+
+		appTelemetrySpillLog_DropReadSegment(logPtr);
+		return AppTelemetrySpillLog_Result_Corrupt;
+	}
+
+	logPtr->pendingRecordSize = sizeof(header) + dataSize;
+
+	return AppTelemetrySpillLog_Result_Ok;
+}
+/**
+ * @brief Remove the record returned by the last successful @ref AppTelemetrySpillLog_ReadNext(). Deletes segment files once all their records are consumed.
+ * @details Marks the record as consumed in its segment file, so it is skipped when the index is rebuilt. If the mark can't be written, the record is read again after a reboot.
+ * @param[in,out] logPtr: the log
+ */
+void AppTelemetrySpillLog_Consume(AppTelemetrySpillLog_T * logPtr) {
+
+	assert(logPtr);
+
+	if(0 == logPtr->pendingRecordSize) return;
+
+	uint32_t slot = logPtr->readSegmentSeq % logPtr->numberOfSegments;
+
+	char fileName[APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH];
+	appTelemetrySpillLog_GetFileName(logPtr, logPtr->readSegmentSeq, fileName);
+
+	const uint8_t consumedMarker = APP_TELEMETRY_SPILL_LOG_RECORD_CONSUMED_MARKER_0;
+	logPtr->storage.writeFunc(fileName, &consumedMarker, sizeof(consumedMarker), logPtr->readOffset);
+
+	logPtr->readOffset += logPtr->pendingRecordSize;
+	logPtr->pendingRecordSize = 0;
+	logPtr->segmentRecords[slot]--;
+	logPtr->numberOfRecords--;
+
+	if(0 == logPtr->numberOfRecords) {
+		// start with a fresh segment next time, keeps the files small
+		appTelemetrySpillLog_Restart(logPtr);
+	} else if(0 == logPtr->segmentRecords[slot] && logPtr->readSegmentSeq != logPtr->writeSegmentSeq) {
+		appTelemetrySpillLog_DeleteSegment(logPtr, logPtr->readSegmentSeq);
+		logPtr->readSegmentSeq++;
+		logPtr->readOffset = APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE;
+	}
+}
+/**
+ * @brief Returns the number of records in the log.
+ * @param[in] logPtr: the log
+ * @return uint32_t: the number of records
+ */
+uint32_t AppTelemetrySpillLog_GetNumberOfRecords(const AppTelemetrySpillLog_T * logPtr) {
+	return logPtr->numberOfRecords;
+}
+
+/**@} */
+/** ************************************************************************* */
@@ -0,0 +1,93 @@
+/*
+ * AppTelemetrySpillLog.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @ingroup AppTelemetrySpillLog
+* @{
+* @author $(SOLACE_APP_AUTHOR)
+* @date $(SOLACE_APP_DATE)
+* @file
+*/
+
+#ifndef SOURCE_APPTELEMETRYSPILLLOG_H_
+#define SOURCE_APPTELEMETRYSPILLLOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define APP_TELEMETRY_SPILL_LOG_MAX_NUMBER_OF_SEGMENTS		UINT32_C(32) /**< max number of segment files */
+#define APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE			UINT32_C(8) /**< size of the segment header in bytes */
+#define APP_TELEMETRY_SPILL_LOG_RECORD_HEADER_SIZE			UINT32_C(16) /**< size of the record header in bytes */
+#define APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH			UINT32_C(16) /**< buffer size for a segment file name */
+
+/**
+ * @brief Storage function: write length bytes from bufferPtr at offset into file fileName. Creates the file if it doesn't exist.
+ * @return bool: true if all bytes were written
+ */
+typedef bool (*AppTelemetrySpillLog_Write_Func_T)(const char * fileName, const uint8_t * bufferPtr, uint32_t length, uint32_t offset);
+/**
+ * @brief Storage function: read length bytes at offset from file fileName into bufferPtr.
+ * @return bool: true if exactly length bytes were read, false if the file doesn't exist or is shorter
+ */
+typedef bool (*AppTelemetrySpillLog_Read_Func_T)(const char * fileName, uint8_t * bufferPtr, uint32_t length, uint32_t offset);
+/**
+ * @brief Storage function: delete file fileName.
+ * @return bool: true if deleted, false if it didn't exist or couldn't be deleted
+ */
+typedef bool (*AppTelemetrySpillLog_Delete_Func_T)(const char * fileName);
+/**
+ * @brief The storage the log is written to. On the XDK the SD card, on a host e.g. plain files.
+ */
+typedef struct {
+	AppTelemetrySpillLog_Write_Func_T writeFunc; /**< write function */
+	AppTelemetrySpillLog_Read_Func_T readFunc; /**< read function */
+	AppTelemetrySpillLog_Delete_Func_T deleteFunc; /**< delete function */
+} AppTelemetrySpillLog_Storage_T;
+/**
+ * @brief Result of the log operations.
+ */
+typedef enum {
+	AppTelemetrySpillLog_Result_Ok = 0, /**< success */
+	AppTelemetrySpillLog_Result_Empty, /**< no records in the log */
+	AppTelemetrySpillLog_Result_BufferTooSmall, /**< the read buffer is too small for the next record */
+	AppTelemetrySpillLog_Result_RecordTooLarge, /**< the record does not fit into a segment */
+	AppTelemetrySpillLog_Result_StorageError, /**< the storage failed to write */
+	AppTelemetrySpillLog_Result_Corrupt, /**< a record failed the checks, the rest of its segment was discarded */
+} AppTelemetrySpillLog_Result_T;
+/**
+ * @brief Append-only log of records spread over a fixed number of segment files.
+ * @details Segments are written in sequence. If all segments are in use, the oldest segment is deleted and its records are dropped.
+ * The index is kept in memory and rebuilt from the segment files by @ref AppTelemetrySpillLog_Open(), so the records survive a reboot.
+ */
+typedef struct {
+	AppTelemetrySpillLog_Storage_T storage; /**< the storage functions */
+	uint32_t maxSegmentSize; /**< max size of a segment file in bytes */
+	uint32_t numberOfSegments; /**< number of segment files, <= #APP_TELEMETRY_SPILL_LOG_MAX_NUMBER_OF_SEGMENTS */
+	uint32_t writeSegmentSeq; /**< sequence number of the segment being written */
+	uint32_t writeOffset; /**< write position in the write segment, 0 if the segment has not been created yet */
+	uint32_t readSegmentSeq; /**< sequence number of the segment being read */
+	uint32_t readOffset; /**< read position in the read segment */
+	uint32_t pendingRecordSize; /**< size of the record returned by @ref AppTelemetrySpillLog_ReadNext(), 0 if none */
+	uint32_t numberOfRecords; /**< number of records in the log */
+	uint32_t numberOfDroppedRecords; /**< number of records dropped since open, because the log was full or records were corrupt */
+	uint32_t numberOfRecoveredRecords; /**< number of unread records found by @ref AppTelemetrySpillLog_Open() */
+	uint32_t segmentRecords[APP_TELEMETRY_SPILL_LOG_MAX_NUMBER_OF_SEGMENTS]; /**< number of unread records per segment slot */
+} AppTelemetrySpillLog_T;
+
+void AppTelemetrySpillLog_Open(AppTelemetrySpillLog_T * logPtr, const AppTelemetrySpillLog_Storage_T * storagePtr, uint32_t maxSegmentSize, uint32_t numberOfSegments);
+
+AppTelemetrySpillLog_Result_T AppTelemetrySpillLog_Append(AppTelemetrySpillLog_T * logPtr, const void * elementsPtr, uint16_t elementSize, uint16_t numberOfElements, uint64_t timestamp);
+
+AppTelemetrySpillLog_Result_T AppTelemetrySpillLog_ReadNext(AppTelemetrySpillLog_T * logPtr, void * bufferPtr, uint32_t bufferSize, uint16_t * elementSizePtr, uint16_t * numberOfElementsPtr, uint64_t * timestampPtr);
+
+void AppTelemetrySpillLog_Consume(AppTelemetrySpillLog_T * logPtr);
+
+uint32_t AppTelemetrySpillLog_GetNumberOfRecords(const AppTelemetrySpillLog_T * logPtr);
+
+#endif /* SOURCE_APPTELEMETRYSPILLLOG_H_ */
+
+/**@} */
+/** ************************************************************************* */
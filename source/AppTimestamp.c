@@ -29,6 +29,7 @@
 #include "AppMisc.h"
 
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 
 
@@ -150,7 +151,7 @@ AppTimestamp_T AppTimestamp_GetTimestamp(const TickType_t tickCount) {
 
 		timestamp.secondsSinceEpoch = millisSinceEpoch / 1000;
 
-		timestamp.millis = millisSinceEpoch % 1000;
+		timestamp.millis = (uint16_t) (millisSinceEpoch % 1000);
 
 		timestamp.isTickCount = false;
 
@@ -161,11 +162,155 @@ AppTimestamp_T AppTimestamp_GetTimestamp(const TickType_t tickCount) {
 
 	return timestamp;
 }
+/**
+ * @brief Formats milliseconds since the epoch with #APP_TIMESTAMP_STRING_FORMAT.
+ * @param[in] millisSinceEpoch: the milliseconds since the epoch
+ * @param[out] timestampStr: buffer of at least #APP_TIMESTAMP_STRING_LENGTH + 1 characters
+ */
+static void appTimestamp_FormatMillisSinceEpoch(uint64_t millisSinceEpoch, char * timestampStr) {
+
+	time_t tt = (time_t) (millisSinceEpoch / 1000);
+
+	struct tm * gmTime = gmtime(&tt);
+
+	snprintf(timestampStr, APP_TIMESTAMP_STRING_LENGTH + 1, APP_TIMESTAMP_STRING_FORMAT,
+			gmTime->tm_year - 100, gmTime->tm_mon + 1, gmTime->tm_mday,
+			gmTime->tm_hour, gmTime->tm_min, gmTime->tm_sec, (uint16_t) (millisSinceEpoch % 1000));
+}
+/**
+ * @brief Returns the timestamp as milliseconds since the epoch.
+ * @details If timestamp.isTickCount==true, it calculates the past time.
+ *
+ * @param[in] timestamp: the timestamp generated with @ref AppTimestamp_GetTimestamp()
+ * @param[out] millisSinceEpochPtr: receives the milliseconds since the epoch
+ *
+ * @return bool: true if set, false if module is not enabled yet
+ */
+bool AppTimestamp_GetMillisSinceEpoch(AppTimestamp_T timestamp, uint64_t * millisSinceEpochPtr) {
+
+	assert(millisSinceEpochPtr);
+
+	if(!appTimestamp_isEnabled) return false;
+
+	if(timestamp.isTickCount) {
+		// calculate past time
+		assert(appTimestamp_ServerSNTPTimeTickOffset > timestamp.tickCount);
+
+		TickType_t ticks = appTimestamp_ServerSNTPTimeTickOffset - timestamp.tickCount;
+
+		*millisSinceEpochPtr = appTimestamp_ServerSNTPTimeMillis - ((uint64_t) ticks);
+
+	} else {
+		*millisSinceEpochPtr = timestamp.secondsSinceEpoch * 1000 + timestamp.millis;
+	}
+
+	return true;
+}
+/**
+ * @brief Returns the first tick count at or after tickCount whose time is a multiple of periodMillis since the epoch.
+ * @details Devices synchronized with the same SNTP server get the same instants, within the accuracy of their synchronization.
+ *
+ * @param[in] tickCount: the earliest tick count
+ * @param[in] periodMillis: the period in milliseconds, > 0
+ * @param[out] alignedTickCountPtr: receives the aligned tick count
+ *
+ * @return bool: true if set, false if module is not enabled yet
+ */
+bool AppTimestamp_GetAlignedTickCount(const TickType_t tickCount, const uint32_t periodMillis, TickType_t * alignedTickCountPtr) {
+
+	assert(alignedTickCountPtr);
+	assert(periodMillis > 0);
+
+	if(!appTimestamp_isEnabled) return false;
+
+	uint64_t millisSinceEpoch = (uint64_t) (TickType_t) (tickCount - appTimestamp_ServerSNTPTimeTickOffset) + appTimestamp_ServerSNTPTimeMillis;
+
+	uint32_t offsetMillis = (uint32_t) (millisSinceEpoch % periodMillis);
+
+	*alignedTickCountPtr = tickCount + ((offsetMillis > 0) ? (periodMillis - offsetMillis) : 0);
+
+	return true;
+}
+/**
+ * @brief Formats the timestamp into a caller provided buffer. Does not allocate.
+ * @details If timestamp.isTickCount==true, it calculates the past time.
+ *
+ * @see #APP_TIMESTAMP_STRING_FORMAT
+ *
+ * @param[in] timestamp: the timestamp generated with @ref AppTimestamp_GetTimestamp()
+ * @param[out] timestampStr: buffer of at least #APP_TIMESTAMP_STRING_LENGTH + 1 characters
+ *
+ * @return bool: true if formatted, false if module is not enabled yet
+ */
+bool AppTimestamp_FormatTimestampStr(AppTimestamp_T timestamp, char * timestampStr) {
+
+	assert(timestampStr);
+
+	uint64_t millisSinceEpoch = 0;
+
+	if(!AppTimestamp_GetMillisSinceEpoch(timestamp, &millisSinceEpoch)) return false;
+
+	appTimestamp_FormatMillisSinceEpoch(millisSinceEpoch, timestampStr);
+
+	return true;
+}
+/**
+ * @brief Formats the timestamp into a caller provided buffer, as @ref AppTimestamp_FormatTimestampStr() does.
+ * @details Formats the date, hour and minute with gmtime() and snprintf() only once per minute and keeps them in the cache.
+ * Within the same minute only the seconds and millis are written. Does not allocate.
+ *
+ * @param[in] timestamp: the timestamp generated with @ref AppTimestamp_GetTimestamp()
+ * @param[in,out] cachePtr: the cache, owned by the calling task
+ * @param[out] timestampStr: buffer of at least #APP_TIMESTAMP_STRING_LENGTH + 1 characters
+ *
+ * @return bool: true if formatted, false if module is not enabled yet
+ */
+bool AppTimestamp_FormatTimestampStrCached(AppTimestamp_T timestamp, AppTimestamp_StrCache_T * cachePtr, char * timestampStr) {
+
+	assert(cachePtr);
+	assert(timestampStr);
+
+	uint64_t millisSinceEpoch = 0;
+
+	if(!AppTimestamp_GetMillisSinceEpoch(timestamp, &millisSinceEpoch)) return false;
+
+	uint32_t millis = (uint32_t) (millisSinceEpoch % 1000);
+	uint64_t secondsSinceEpoch = millisSinceEpoch / 1000;
+	uint64_t minutesSinceEpoch = secondsSinceEpoch / 60;
+	uint32_t seconds = (uint32_t) (secondsSinceEpoch - minutesSinceEpoch * 60);
+
+	if(!cachePtr->isValid || cachePtr->minutesSinceEpoch != minutesSinceEpoch) {
+
+		appTimestamp_FormatMillisSinceEpoch(millisSinceEpoch, timestampStr);
+
+		memcpy(cachePtr->prefixStr, timestampStr, APP_TIMESTAMP_STRING_PREFIX_LENGTH);
+		cachePtr->minutesSinceEpoch = minutesSinceEpoch;
+		cachePtr->isValid = true;
+
+		return true;
+	}
+
+	memcpy(timestampStr, cachePtr->prefixStr, APP_TIMESTAMP_STRING_PREFIX_LENGTH);
+
+	// "SS.mmmZ"
+	char * secondsStr = &timestampStr[APP_TIMESTAMP_STRING_PREFIX_LENGTH];
+	secondsStr[0] = (char) ('0' + seconds / 10);
+	secondsStr[1] = (char) ('0' + seconds % 10);
+	secondsStr[2] = '.';
+	secondsStr[3] = (char) ('0' + millis / 100);
+	secondsStr[4] = (char) ('0' + (millis / 10) % 10);
+	secondsStr[5] = (char) ('0' + millis % 10);
+	secondsStr[6] = 'Z';
+	secondsStr[7] = '\0';
+
+	return true;
+}
 /**
  * @brief Returns the formatted timestamp string for the timestamp.
  * @details If timestamp.isTickCount==true, it calculates the past time.
  *
  * @see #APP_TIMESTAMP_STRING_FORMAT
+ * @see AppTimestamp_FormatTimestampStr()
  *
  * @param[in] timestamp: the timestamp generated with @ref AppTimestamp_GetTimestamp()
  *
@@ -193,40 +338,11 @@ char * AppTimestamp_CreateTimestampStr(AppTimestamp_T timestamp) {
 
 	if(!appTimestamp_isEnabled) return NULL;
 
-	if(timestamp.isTickCount) {
-		// calculate past time
-		assert(appTimestamp_ServerSNTPTimeTickOffset > timestamp.tickCount);
-
-		TickType_t ticks = appTimestamp_ServerSNTPTimeTickOffset - timestamp.tickCount;
-
-		uint64_t millisSinceEpoch = appTimestamp_ServerSNTPTimeMillis - ((uint64_t) ticks);
-
-		timestamp.secondsSinceEpoch = millisSinceEpoch / 1000;
-
-		timestamp.millis = millisSinceEpoch % 1000;
+	char * timestampStr = (char *) malloc(APP_TIMESTAMP_STRING_LENGTH + 1);
 
-		timestamp.isTickCount = false;
-
-	}
-
-	time_t tt = (time_t) timestamp.secondsSinceEpoch;
-
-	struct tm * gmTime = gmtime(&tt);
-
-	size_t sz;
-
-	sz = snprintf(NULL, 0, APP_TIMESTAMP_STRING_FORMAT,
-			gmTime->tm_year - 100, gmTime->tm_mon + 1, gmTime->tm_mday,
-			gmTime->tm_hour, gmTime->tm_min, gmTime->tm_sec, timestamp.millis);
-
-	char * timestampStr = (char *) malloc(sz + 1);
-
-	snprintf(timestampStr, sz + 1, APP_TIMESTAMP_STRING_FORMAT,
-			gmTime->tm_year - 100, gmTime->tm_mon + 1, gmTime->tm_mday,
-			gmTime->tm_hour, gmTime->tm_min, gmTime->tm_sec, timestamp.millis);
+	if(NULL != timestampStr) AppTimestamp_FormatTimestampStr(timestamp, timestampStr);
 
 	return timestampStr;
-
 }
 
 
@@ -19,6 +19,9 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#define APP_TIMESTAMP_STRING_LENGTH		UINT32_C(24) /**< length of the string created by @ref AppTimestamp_CreateTimestampStr(), without the terminating 0 */
+#define APP_TIMESTAMP_STRING_PREFIX_LENGTH	UINT32_C(17) /**< length of the date, hour and minute of the timestamp string: "YYYY-MM-DDTHH:MM:" */
+
 /**
  * @brief Timestamp structure.
  * @details if isTickCount==true, tickCount is set correctly
@@ -30,6 +33,17 @@ typedef struct {
 	TickType_t tickCount; /**< the tick count if #isTickCount is true */
 	bool isTickCount; /**< flag to indicate if structure contains tickCount or secondsSinceEpoch & millis */
 } AppTimestamp_T;
+/**
+ * @brief Cache of the formatted date, hour and minute for @ref AppTimestamp_FormatTimestampStrCached().
+ * @details Owned by the caller, not shared between tasks. Initialize with #APP_TIMESTAMP_STR_CACHE_INIT.
+ */
+typedef struct {
+	bool isValid; /**< flag if prefixStr has been formatted */
+	uint64_t minutesSinceEpoch; /**< the minute prefixStr was formatted for */
+	char prefixStr[APP_TIMESTAMP_STRING_PREFIX_LENGTH]; /**< the formatted date, hour and minute, not 0 terminated */
+} AppTimestamp_StrCache_T;
+
+#define APP_TIMESTAMP_STR_CACHE_INIT		{ .isValid = false, .minutesSinceEpoch = 0 } /**< initializer for an empty #AppTimestamp_StrCache_T */
 
 Retcode_T AppTimestamp_Init(void);
 
@@ -39,6 +53,14 @@ Retcode_T AppTimestamp_Enable(void);
 
 AppTimestamp_T AppTimestamp_GetTimestamp(const TickType_t tickCount);
 
+bool AppTimestamp_GetMillisSinceEpoch(AppTimestamp_T timestamp, uint64_t * millisSinceEpochPtr);
+
+bool AppTimestamp_GetAlignedTickCount(const TickType_t tickCount, const uint32_t periodMillis, TickType_t * alignedTickCountPtr);
+
+bool AppTimestamp_FormatTimestampStr(AppTimestamp_T timestamp, char * timestampStr);
+
+bool AppTimestamp_FormatTimestampStrCached(AppTimestamp_T timestamp, AppTimestamp_StrCache_T * cachePtr, char * timestampStr);
+
 char * AppTimestamp_CreateTimestampStr(AppTimestamp_T appTimestamp);
 
 #endif /* SOURCE_APPTIMESTAMP_H_ */
@@ -14,6 +14,10 @@
  * @brief Implements the MQTT interface to the ServalPal module.
  * Adapted from the original XDK module: XDK_MQTT.h and MQTT.c.
  * @details Added single use / single call protection using semaphores. Added internal state management.
+ * @details Qos 1 messages are pipelined through a window of messages in flight, see @ref AppMqttPublishWindow.
+ * Up to @ref AppXDK_MQTT_SetQos1MaxInFlight() messages are in flight, so the qos 1 throughput scales with the window instead of the round trip to the broker.
+ * The event handler only queues the publish events for the window, they are applied in order by the publishing task holding the module,
+ * together with the timeouts of the messages in flight. The completion callbacks are called in the publishing task.
  *
  * @author $(SOLACE_APP_AUTHOR)
  *
@@ -30,6 +34,7 @@
 
 #include "AppXDK_MQTT.h"
 #include "AppMisc.h"
+#include "AppStatus.h"
 
 #include <stdio.h>
 
@@ -44,6 +49,8 @@
 
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "task.h"
+#include "queue.h"
 #include "BCDS_BSP_Board.h"
 
 
@@ -90,10 +97,29 @@ static bool appXDK_MQTT_ConnectionStatus = false; /**< flag to indicate connecti
 static bool appXDK_MQTT_SubscriptionStatus = false; /**< flag to indicate subscription status between caller and event handler */
 static bool appXDK_MQTT_UnsubscribeStatus = false; /**< flag to indicate unsubscribe status between caller and event handler */
 static bool appXDK_MQTT_PublishStatus = false; /**< flag to indicate publish status between caller and event handler */
+static volatile bool appXDK_MQTT_isPublishPending = false; /**< flag set while a qos 0 publish waits for its event. cleared when the publish misses its deadline, so the late event is ignored */
 static Retcode_T appXDK_MQTT_EventHandler_Retcode = RETCODE_OK; /**< event handler retcode to consume in caller */
 static MqttEvent_t appXDK_MQTT_EventHandler_ServalEvent = -1; /**< the serval event from event handler call */
 static MqttEvent_t appXDK_MQTT_EventHandler_PriorServalEvent = -1; /**< the prior serval event, from pervious event handler call */
 
+/**
+ * @brief Publish events of the event handler for the qos 1 publish window.
+ */
+typedef enum {
+	AppXDK_MQTT_PublishWindowEvent_Acknowledged, /**< the broker acknowledged the oldest message in flight */
+	AppXDK_MQTT_PublishWindowEvent_Failed, /**< the stack reported the oldest message in flight failed or timed out */
+	AppXDK_MQTT_PublishWindowEvent_Disconnected, /**< the connection was closed, the messages in flight failed */
+} AppXDK_MQTT_PublishWindowEvent_T;
+
+#define APP_XDK_MQTT_PUBLISH_WINDOW_EVENT_QUEUE_LENGTH		(APP_MQTT_PUBLISH_WINDOW_MAX_SIZE * 2) /**< length of the event queue, a message in flight has one outcome event, plus the disconnect */
+#define APP_XDK_MQTT_PUBLISH_WINDOW_WAIT_SLICE_IN_MS		UINT32_C(1000) /**< max wait for a publish event before checking the timeouts of the messages in flight */
+
+static AppMqttPublishWindow_T appXDK_MQTT_PublishWindow; /**< the qos 1 messages in flight. only accessed while holding #appXDK_MQTT_ExternalInterface_SemaphoreHandle */
+static QueueHandle_t appXDK_MQTT_PublishWindowEventQueueHandle = NULL; /**< the publish events of the event handler for #appXDK_MQTT_PublishWindow, in order */
+static volatile uint32_t appXDK_MQTT_Qos1MaxInFlight = 1; /**< number of qos 1 messages allowed in flight, applied to #appXDK_MQTT_PublishWindow on the next publish */
+static uint16_t appXDK_MQTT_SyncPublishPacketId = 0; /**< packet id of the qos 1 message a publish without completion callback waits for. 0 for none */
+static bool appXDK_MQTT_isSyncPublishCompleted = false; /**< flag set when the message of #appXDK_MQTT_SyncPublishPacketId completed, the outcome is in #appXDK_MQTT_PublishStatus */
+
 /**
  * @brief Translates internal state to a retcode for caller.
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_APP_XDK_MQTT_MODULE_BUSY_CONNECTING)
@@ -219,6 +245,117 @@ static void appXDK_MQTT_PrintEvents(uint32_t counter, MqttEvent_t event, MqttEve
 }
 #endif
 
+/**
+ * @brief Check if a publish event is for the qos 1 publish window.
+ * @param[in] servalEventData: the data of the event, can be NULL
+ * @return bool: true for the events of qos 1 messages
+ */
+static bool appXDK_MQTT_IsPublishWindowEvent(const MqttEventData_t * servalEventData) {
+	return (NULL != servalEventData && 1 == servalEventData->publish.qos);
+}
+/**
+ * @brief Queue a publish event for the qos 1 publish window. Called by the event handler.
+ * @param[in] event: the event
+ * @exception Retcode_RaiseError: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_EVENT_LOST), the message times out and stays in the window until the connection is closed
+ */
+static void appXDK_MQTT_QueuePublishWindowEvent(AppXDK_MQTT_PublishWindowEvent_T event) {
+	if(pdTRUE != xQueueSend(appXDK_MQTT_PublishWindowEventQueueHandle, &event, 0UL)) {
+		Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_EVENT_LOST));
+	}
+}
+/**
+ * @brief Send a message of the qos 1 publish window.
+ * @param[in] messagePtr: the message
+ * @return bool: true if the stack accepted the message
+ */
+static bool appXDK_MQTT_SendPublishWindowMessage(const AppMqttPublishWindow_Message_T * messagePtr) {
+
+	StringDescr_T topicDescription;
+	StringDescr_wrap(&topicDescription, messagePtr->topic);
+
+	appXDK_MQTT_AppInitiatedInteraction = true;
+
+	retcode_t servalRetcode = Mqtt_publish(&appXDK_MQTT_ServalSession, topicDescription, messagePtr->payload, messagePtr->payloadLength, (uint8_t) 1, false);
+
+	#ifdef DEBUG_APP_XDK_MQTT
+	if(RC_OK != servalRetcode) printf("[ERROR] - appXDK_MQTT_SendPublishWindowMessage : Serval Mqtt_publish() call failed for packetId: %u.\r\n", messagePtr->packetId);
+	#endif
+
+	return (RC_OK == servalRetcode);
+}
+/**
+ * @brief Apply a publish event of the event handler to the qos 1 publish window and call the completion callbacks.
+ * @param[in] event: the event
+ */
+static void appXDK_MQTT_ApplyPublishWindowEvent(AppXDK_MQTT_PublishWindowEvent_T event) {
+
+	AppMqttPublishWindow_Completion_T completion;
+
+	switch(event) {
+	case AppXDK_MQTT_PublishWindowEvent_Acknowledged:
+		if(AppMqttPublishWindow_Complete(&appXDK_MQTT_PublishWindow, true, &completion)) AppMqttPublishWindow_NotifyCompletion(&completion);
+		break;
+	case AppXDK_MQTT_PublishWindowEvent_Failed:
+		if(AppMqttPublishWindow_Complete(&appXDK_MQTT_PublishWindow, false, &completion)) {
+			if(!completion.wasAbandoned) AppStatus_Stats_IncrementMqttPublishFailedCounter();
+			AppMqttPublishWindow_NotifyCompletion(&completion);
+		}
+		break;
+	case AppXDK_MQTT_PublishWindowEvent_Disconnected:
+		while(AppMqttPublishWindow_Complete(&appXDK_MQTT_PublishWindow, false, &completion)) {
+			if(!completion.wasAbandoned) AppStatus_Stats_IncrementMqttPublishFailedCounter();
+			AppMqttPublishWindow_NotifyCompletion(&completion);
+		}
+		break;
+	default: assert(0);
+	}
+}
+/**
+ * @brief Apply the queued publish events to the qos 1 publish window and abandon the messages not acknowledged in time.
+ * @note Call only while holding #appXDK_MQTT_ExternalInterface_SemaphoreHandle.
+ */
+static void appXDK_MQTT_ServicePublishWindow(void) {
+
+	AppXDK_MQTT_PublishWindowEvent_T event;
+	while(pdTRUE == xQueueReceive(appXDK_MQTT_PublishWindowEventQueueHandle, &event, 0UL)) appXDK_MQTT_ApplyPublishWindowEvent(event);
+
+	AppMqttPublishWindow_Completion_T completion;
+	while(AppMqttPublishWindow_AbandonTimedOut(&appXDK_MQTT_PublishWindow, xTaskGetTickCount(), &completion)) {
+		AppStatus_Stats_IncrementMqttPublishFailedCounter();
+		AppMqttPublishWindow_NotifyCompletion(&completion);
+	}
+}
+/**
+ * @brief Wait for the next publish event of the event handler, at most waitMillis, then service the qos 1 publish window.
+ * @note Call only while holding #appXDK_MQTT_ExternalInterface_SemaphoreHandle.
+ * @param[in] waitMillis: the max wait
+ */
+static void appXDK_MQTT_WaitForPublishWindowEvent(uint32_t waitMillis) {
+
+	AppXDK_MQTT_PublishWindowEvent_T event;
+	if(pdTRUE == xQueueReceive(appXDK_MQTT_PublishWindowEventQueueHandle, &event, MILLISECONDS(waitMillis))) appXDK_MQTT_ApplyPublishWindowEvent(event);
+
+	appXDK_MQTT_ServicePublishWindow();
+}
+/**
+ * @brief Completion callback of a qos 1 message published without completion callback. Sets the outcome for the waiting publish.
+ * typedef: @ref AppMqttPublishWindow_Completed_Func_T()
+ * @param[in] packetId: the packet id of the message
+ * @param[in] isAcknowledged: the outcome
+ * @param[in] isAbandoned: unused, an abandoned message fails the publish, its later outcome is not waited for
+ * @param[in] contextPtr: unused
+ */
+static void appXDK_MQTT_SyncPublishCompleted(uint16_t packetId, bool isAcknowledged, bool isAbandoned, void * contextPtr) {
+
+	BCDS_UNUSED(isAbandoned);
+	BCDS_UNUSED(contextPtr);
+
+	// a message whose publish gave up waiting
+	if(packetId != appXDK_MQTT_SyncPublishPacketId) return;
+
+	appXDK_MQTT_PublishStatus = isAcknowledged;
+	appXDK_MQTT_isSyncPublishCompleted = true;
+}
 /**
  * @brief Callback function used by the stack to communicate events to the application.
  * Each event will bring with it specialized data that will contain more information.
@@ -227,6 +364,7 @@ static void appXDK_MQTT_PrintEvents(uint32_t counter, MqttEvent_t event, MqttEve
  * The initiator of the interaction - @ref AppXDK_MQTT_ConnectToBroker(), @ref AppXDK_MQTT_SubsribeToTopic(), @ref AppXDK_MQTT_UnsubsribeFromTopics(), @ref AppXDK_MQTT_PublishToTopic()
  * will block on (take) a semaphore. This callback event handler will release the semaphore so the initiator can continue synchronously.
  * Implements a typical async -> sync conversion using semaphores.
+ * @details The publish events of qos 1 messages are queued for the publish window instead, see @ref appXDK_MQTT_QueuePublishWindowEvent().
  *
  * @details Sets the #appXDK_MQTT_EventHandler_Retcode variable for the initiator of the interaction to read:
  * @details - #appXDK_MQTT_EventHandler_Retcode: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_APP_XDK_MQTT_CONNECT_SEMAPHORE_ERROR)
@@ -363,6 +501,8 @@ static retcode_t appXDK_MQTT_EventHandler(MqttSession_T * servalSession, MqttEve
     	xSemaphoreGive(appXDK_MQTT_UnsubscribeSemaphoreHandle);
     	xSemaphoreGive(appXDK_MQTT_PublishSemaphoreHandle);
 
+    	appXDK_MQTT_QueuePublishWindowEvent(AppXDK_MQTT_PublishWindowEvent_Disconnected);
+
         appXDK_MQTT_SetupInfo.brokerDisconnectCallback_Func();
         break;
 
@@ -409,19 +549,40 @@ static retcode_t appXDK_MQTT_EventHandler(MqttSession_T * servalSession, MqttEve
      * publish data events
      */
     case MQTT_PUBLISHED_DATA:
+    	if(appXDK_MQTT_IsPublishWindowEvent(servalEventData)) {
+    		appXDK_MQTT_QueuePublishWindowEvent(AppXDK_MQTT_PublishWindowEvent_Acknowledged);
+    		break;
+    	}
+		// the late event of an abandoned publish
+		if(!appXDK_MQTT_isPublishPending) break;
+		appXDK_MQTT_isPublishPending = false;
 		appXDK_MQTT_PublishStatus = true;
 		if (pdTRUE != xSemaphoreGive(appXDK_MQTT_PublishSemaphoreHandle)) appXDK_MQTT_EventHandler_Retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_SEMAPHORE_ERROR);
 		break;
     case MQTT_PUBLISH_SEND_FAILED:
     	// Triggered if sending the publish or release message caused an error
+    	if(appXDK_MQTT_IsPublishWindowEvent(servalEventData)) {
+    		appXDK_MQTT_QueuePublishWindowEvent(AppXDK_MQTT_PublishWindowEvent_Failed);
+    		break;
+    	}
+    	if(!appXDK_MQTT_isPublishPending) break;
+    	appXDK_MQTT_isPublishPending = false;
     	appXDK_MQTT_PublishStatus = false;
 		if (pdTRUE != xSemaphoreGive(appXDK_MQTT_PublishSemaphoreHandle)) appXDK_MQTT_EventHandler_Retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_SEMAPHORE_ERROR);
         break;
     case MQTT_PUBLISH_SEND_ACK_FAILED:
+    	if(!appXDK_MQTT_isPublishPending) break;
+    	appXDK_MQTT_isPublishPending = false;
     	appXDK_MQTT_PublishStatus = false;
 		if (pdTRUE != xSemaphoreGive(appXDK_MQTT_PublishSemaphoreHandle)) appXDK_MQTT_EventHandler_Retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_SEMAPHORE_ERROR);
         break;
 	case MQTT_PUBLISH_TIMEOUT:
+		if(appXDK_MQTT_IsPublishWindowEvent(servalEventData)) {
+			appXDK_MQTT_QueuePublishWindowEvent(AppXDK_MQTT_PublishWindowEvent_Failed);
+			break;
+		}
+		if(!appXDK_MQTT_isPublishPending) break;
+		appXDK_MQTT_isPublishPending = false;
 		appXDK_MQTT_PublishStatus = false;
 		if (pdTRUE != xSemaphoreGive(appXDK_MQTT_PublishSemaphoreHandle)) appXDK_MQTT_EventHandler_Retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_SEMAPHORE_ERROR);
         break;
@@ -461,6 +622,7 @@ static retcode_t appXDK_MQTT_EventHandler(MqttSession_T * servalSession, MqttEve
  * @param[in] setupInfoPtr: the mqtt setup information.
  * @return Retcode_T: RETCODE_OK
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_FAILED_TO_CREATE_SEMAPHORE)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_APP_XDK_MQTT_FAILED_TO_CREATE_PUBLISH_WINDOW_QUEUE)
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_APP_XDK_MQTT_SERVAL_INIT_FAILED) if call to Mqtt_initialize() failed
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_APP_XDK_MQTT_SERVAL_INIT_FAILED) if call to Mqtt_initializeInternalSession() failed
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_APP_XDK_MQTT_UNSUPPORTED_SCHEME)
@@ -495,6 +657,11 @@ Retcode_T AppXDK_MQTT_Init(const AppXDK_MQTT_Setup_T * setupInfoPtr) {
 	if(appXDK_MQTT_ConnectSemaphoreHandle == NULL) return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_FAILED_TO_CREATE_SEMAPHORE);
 	xSemaphoreGive(appXDK_MQTT_ConnectSemaphoreHandle);
 
+	appXDK_MQTT_PublishWindowEventQueueHandle = xQueueCreate(APP_XDK_MQTT_PUBLISH_WINDOW_EVENT_QUEUE_LENGTH, sizeof(AppXDK_MQTT_PublishWindowEvent_T));
+	if(NULL == appXDK_MQTT_PublishWindowEventQueueHandle) return RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_APP_XDK_MQTT_FAILED_TO_CREATE_PUBLISH_WINDOW_QUEUE);
+
+	AppMqttPublishWindow_Init(&appXDK_MQTT_PublishWindow, appXDK_MQTT_Qos1MaxInFlight, MILLISECONDS(APP_XDK_MQTT_PUBLISH_WINDOW_TIMEOUT_IN_MS));
+
 	appXDK_MQTT_SetupInfo = *setupInfoPtr;
 
     switch (appXDK_MQTT_SetupInfo.mqttType) {
@@ -911,20 +1078,123 @@ Retcode_T AppXDK_MQTT_UnsubsribeFromTopics(const uint8_t numTopics, const char *
 
     return retcode;
 }
+/**
+ * @brief Get the max time a publish may take.
+ * @param[in] publishPtr: the publish information
+ * @return uint32_t: the deadline in millis, #APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS without a deadline
+ */
+static uint32_t appXDK_MQTT_GetPublishDeadlineMillis(const AppXDK_MQTT_Publish_T * publishPtr) {
+	return (0 == publishPtr->deadlineMillis) ? APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS : publishPtr->deadlineMillis;
+}
+/**
+ * @brief Get the retcode for a publish that got no outcome in time.
+ * @details A publish with a deadline is abandoned, the connection may still be fine. Without a deadline, the broker did not answer within #APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS.
+ * @param[in] publishPtr: the publish information
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_APP_XDK_MQTT_TIMEOUT_NO_PUBLISH_CALLBACK_RECEIVED_FROM_BROKER)
+ */
+static Retcode_T appXDK_MQTT_GetPublishDeadlineRetcode(const AppXDK_MQTT_Publish_T * publishPtr) {
+	if(0 != publishPtr->deadlineMillis) return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED);
+	return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_APP_XDK_MQTT_TIMEOUT_NO_PUBLISH_CALLBACK_RECEIVED_FROM_BROKER);
+}
+/**
+ * @brief Publish a qos 1 message through the publish window.
+ * @details Waits for a free place in the window, sends the message and returns if the publish info has a completion callback.
+ * Otherwise waits for the outcome of the message. All waits together are bounded by the deadline of the publish.
+ * A message that misses the deadline while waiting for its outcome stays in the window, its outcome is ignored.
+ * It may still be delivered, the caller must not publish it again, see #RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED_IN_FLIGHT.
+ * @note Call only while holding #appXDK_MQTT_ExternalInterface_SemaphoreHandle.
+ *
+ * @param[in] publishPtr: the publish information
+ * @param[in] startTicks: ticks when the publish started
+ *
+ * @return Retcode_T: RETCODE_OK
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_FULL) without a deadline
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_MQTT_PUBLISH_FAILED_NO_CONNECTION) if the connection was lost while waiting for a free place
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_FAILED_TO_ALLOCATE)
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_APP_XDK_MQTT_SERVAL_MQTT_PUBLISH_CALL_FAILED)
+ * @return Retcode_T: retcode from @ref appXDK_MQTT_GetPublishDeadlineRetcode() if the deadline was missed before the message was sent
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_WARNING, #RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED_IN_FLIGHT) if the deadline was missed while waiting for the outcome
+ * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_FAILED)
+ */
+static Retcode_T appXDK_MQTT_PublishQos1(const AppXDK_MQTT_Publish_T * publishPtr, TickType_t startTicks) {
+
+	TickType_t timeoutTicks = MILLISECONDS(appXDK_MQTT_GetPublishDeadlineMillis(publishPtr));
+
+	AppMqttPublishWindow_SetMaxInFlight(&appXDK_MQTT_PublishWindow, appXDK_MQTT_Qos1MaxInFlight);
+
+	appXDK_MQTT_ServicePublishWindow();
+
+	while(AppMqttPublishWindow_IsFull(&appXDK_MQTT_PublishWindow)) {
+		TickType_t elapsedTicks = xTaskGetTickCount() - startTicks;
+		if(elapsedTicks >= timeoutTicks) {
+			if(0 != publishPtr->deadlineMillis) return appXDK_MQTT_GetPublishDeadlineRetcode(publishPtr);
+			return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_FULL);
+		}
+		uint32_t waitMillis = (timeoutTicks - elapsedTicks) * portTICK_PERIOD_MS;
+		appXDK_MQTT_WaitForPublishWindowEvent((waitMillis < APP_XDK_MQTT_PUBLISH_WINDOW_WAIT_SLICE_IN_MS) ? waitMillis : APP_XDK_MQTT_PUBLISH_WINDOW_WAIT_SLICE_IN_MS);
+	}
+
+	if(!appXDK_MQTT_ConnectionStatus) return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_MQTT_PUBLISH_FAILED_NO_CONNECTION);
+
+	bool isSync = (NULL == publishPtr->publishCompletedCallback_Func);
+
+	AppMqttPublishWindow_Message_T * messagePtr = AppMqttPublishWindow_Add(&appXDK_MQTT_PublishWindow, publishPtr->topic, publishPtr->payload, publishPtr->payloadLength,
+														isSync ? appXDK_MQTT_SyncPublishCompleted : publishPtr->publishCompletedCallback_Func,
+														isSync ? NULL : publishPtr->publishCompletedContextPtr,
+														xTaskGetTickCount());
+	if(NULL == messagePtr) return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_FAILED_TO_ALLOCATE);
+
+	if(isSync) {
+		appXDK_MQTT_SyncPublishPacketId = messagePtr->packetId;
+		appXDK_MQTT_PublishStatus = false;
+		appXDK_MQTT_isSyncPublishCompleted = false;
+	}
+
+	if(!appXDK_MQTT_SendPublishWindowMessage(messagePtr)) {
+		AppMqttPublishWindow_RemoveNewest(&appXDK_MQTT_PublishWindow, NULL);
+		appXDK_MQTT_SyncPublishPacketId = 0;
+		return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_APP_XDK_MQTT_SERVAL_MQTT_PUBLISH_CALL_FAILED);
+	}
+
+	AppStatus_Stats_UpdateMqttPublishInFlightMax(AppMqttPublishWindow_GetNumberInFlight(&appXDK_MQTT_PublishWindow));
+
+	if(!isSync) return RETCODE_OK;
+
+	// wait for the outcome
+	while(!appXDK_MQTT_isSyncPublishCompleted) {
+		TickType_t elapsedTicks = xTaskGetTickCount() - startTicks;
+		if(elapsedTicks >= timeoutTicks) {
+			#ifdef DEBUG_APP_XDK_MQTT
+			printf("[ERROR] - appXDK_MQTT_PublishQos1 : Failed, message not acknowledged in time.\r\n");
+			#endif
+			appXDK_MQTT_SyncPublishPacketId = 0;
+			if(0 != publishPtr->deadlineMillis) return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED_IN_FLIGHT);
+			return appXDK_MQTT_GetPublishDeadlineRetcode(publishPtr);
+		}
+		uint32_t waitMillis = (timeoutTicks - elapsedTicks) * portTICK_PERIOD_MS;
+		appXDK_MQTT_WaitForPublishWindowEvent((waitMillis < APP_XDK_MQTT_PUBLISH_WINDOW_WAIT_SLICE_IN_MS) ? waitMillis : APP_XDK_MQTT_PUBLISH_WINDOW_WAIT_SLICE_IN_MS);
+	}
+	appXDK_MQTT_SyncPublishPacketId = 0;
+
+	return appXDK_MQTT_PublishStatus ? RETCODE_OK : RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_FAILED);
+}
 /**
  * @brief Publish a message.
  *
  * @details Waits different lenghts of time for qos=0 and qos=1 (#APP_XDK_MQTT_TAKE_EXTERNAL_INTERFACE_PUBLISH_QOS_0_SEMAPHORE_WAIT_IN_MS, #APP_XDK_MQTT_TAKE_EXTERNAL_INTERFACE_PUBLISH_QOS_1_SEMAPHORE_WAIT_IN_MS)
- *
- * @note This does not seem to work correctly for QoS=1 publishing. Frequently receives a disconnect event.
+ * @details Qos 1 messages go through the publish window, see @ref appXDK_MQTT_PublishQos1(). With a completion callback in the publish info the call returns once the message is in flight.
+ * @details All waits are bounded by the deadline in the publish info, if set. A qos 0 publish without an event in time is abandoned:
+ * its late event is ignored and the next publish starts with a free publish semaphore.
  *
  * @param[in] publishPtr: the publish information
  *
  * @return Retcode_T: RETCODE_OK
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_APP_XDK_MQTT_SERVAL_MQTT_PUBLISH_CALL_FAILED)
- * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_APP_XDK_MQTT_TIMEOUT_NO_PUBLISH_CALLBACK_RECEIVED_FROM_BROKER)
+ * @return Retcode_T: retcode from @ref appXDK_MQTT_GetPublishDeadlineRetcode()
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_ERROR, #RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_FAILED)
  * @return Retcode_T: RETCODE(RETCODE_SEVERITY_FATAL, #RETCODE_SOLAPP_APP_XDK_MQTT_UNSUPPORTED_SCHEME)
+ * @return Retcode_T: retcode from @ref appXDK_MQTT_PublishQos1()
  *
  */
 Retcode_T AppXDK_MQTT_PublishToTopic(const AppXDK_MQTT_Publish_T * publishPtr) {
@@ -934,9 +1204,15 @@ Retcode_T AppXDK_MQTT_PublishToTopic(const AppXDK_MQTT_Publish_T * publishPtr) {
 	assert(publishPtr->payload);
 	assert(publishPtr->payloadLength > 0);
 
+	TickType_t startTicks = xTaskGetTickCount();
+	uint32_t deadlineMillis = appXDK_MQTT_GetPublishDeadlineMillis(publishPtr);
+
 	uint32_t waitMillis = (publishPtr->qos==0) ? APP_XDK_MQTT_TAKE_EXTERNAL_INTERFACE_PUBLISH_QOS_0_SEMAPHORE_WAIT_IN_MS : APP_XDK_MQTT_TAKE_EXTERNAL_INTERFACE_PUBLISH_QOS_1_SEMAPHORE_WAIT_IN_MS;
+	bool isWaitCutByDeadline = (0 != publishPtr->deadlineMillis && deadlineMillis < waitMillis);
+	if(isWaitCutByDeadline) waitMillis = deadlineMillis;
 	if(pdTRUE != xSemaphoreTake(appXDK_MQTT_ExternalInterface_SemaphoreHandle,  MILLISECONDS(waitMillis))) {
-		// note: this should not happen, if it does, raise fatal error
+		// note: this should not happen within the full wait, if it does, raise fatal error
+		if(isWaitCutByDeadline) return appXDK_MQTT_GetPublishDeadlineRetcode(publishPtr);
 		if(publishPtr->qos==1) Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_FAILED_FOR_QOS_1));
 		return appXDK_MQTT_GetModuleBusyRetcode();
 	}
@@ -955,6 +1231,11 @@ Retcode_T AppXDK_MQTT_PublishToTopic(const AppXDK_MQTT_Publish_T * publishPtr) {
 
 	case AppXDK_MQTT_TypeServalStack: {
 
+		if(1 == publishPtr->qos) {
+			retcode = appXDK_MQTT_PublishQos1(publishPtr, startTicks);
+			break;
+		}
+
 		static StringDescr_T publishTopicDescription;
 		StringDescr_wrap(&publishTopicDescription, publishPtr->topic);
 
@@ -967,22 +1248,28 @@ Retcode_T AppXDK_MQTT_PublishToTopic(const AppXDK_MQTT_Publish_T * publishPtr) {
         	appXDK_MQTT_AppInitiatedInteraction = true;
 
     		appXDK_MQTT_PublishStatus = false;
+    		appXDK_MQTT_isPublishPending = true;
 
     		if (RC_OK != Mqtt_publish(&appXDK_MQTT_ServalSession, publishTopicDescription, publishPtr->payload, publishPtr->payloadLength, (uint8_t) publishPtr->qos, false)) {
 				#ifdef DEBUG_APP_XDK_MQTT
             	printf("[ERROR] - AppXDK_MQTT_PublishToTopic : Serval Mqtt_publish() call failed.\r\n");
 				#endif
+            	appXDK_MQTT_isPublishPending = false;
                 retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_APP_XDK_MQTT_SERVAL_MQTT_PUBLISH_CALL_FAILED);
             }
         }
 
         // wait for the callback
         if (RETCODE_OK == retcode) {
-			if (pdTRUE != xSemaphoreTake(appXDK_MQTT_PublishSemaphoreHandle, pdMS_TO_TICKS(APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS))) {
+        	TickType_t elapsedTicks = xTaskGetTickCount() - startTicks;
+        	TickType_t waitTicks = (elapsedTicks < MILLISECONDS(deadlineMillis)) ? (MILLISECONDS(deadlineMillis) - elapsedTicks) : 0;
+			if (pdTRUE != xSemaphoreTake(appXDK_MQTT_PublishSemaphoreHandle, waitTicks)) {
 				#ifdef DEBUG_APP_XDK_MQTT
 				printf("[ERROR] - AppXDK_MQTT_PublishToTopic : Failed, never received any PUBLISH_XXX event.\r\n");
 				#endif
-				retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_APP_XDK_MQTT_TIMEOUT_NO_PUBLISH_CALLBACK_RECEIVED_FROM_BROKER);
+				// abandon the publish, the semaphore is given back below
+				appXDK_MQTT_isPublishPending = false;
+				retcode = appXDK_MQTT_GetPublishDeadlineRetcode(publishPtr);
 			}
 			else {
 				// check the retcode of the event handler
@@ -1016,6 +1303,33 @@ Retcode_T AppXDK_MQTT_PublishToTopic(const AppXDK_MQTT_Publish_T * publishPtr) {
 
     return retcode;
 }
+/**
+ * @brief Set the number of qos 1 messages allowed in flight. Takes effect with the next qos 1 publish.
+ * @details 1 waits for the acknowledgement of each message before the next one is sent.
+ * @param[in] maxInFlight: 1-#APP_MQTT_PUBLISH_WINDOW_MAX_SIZE
+ */
+void AppXDK_MQTT_SetQos1MaxInFlight(uint32_t maxInFlight) {
+
+	assert(maxInFlight >= 1 && maxInFlight <= APP_MQTT_PUBLISH_WINDOW_MAX_SIZE);
+
+	appXDK_MQTT_Qos1MaxInFlight = maxInFlight;
+}
+/**
+ * @brief Service the qos 1 publish window without publishing: apply the publish events, call the completion callbacks, abandon the messages that timed out.
+ * @details Call periodically while messages may be in flight, otherwise this only happens with the next publish.
+ * Skipped if the module is busy.
+ */
+void AppXDK_MQTT_ServicePublishWindow(void) {
+
+	if(pdTRUE != xSemaphoreTake(appXDK_MQTT_ExternalInterface_SemaphoreHandle, MILLISECONDS(APP_XDK_MQTT_TAKE_EXTERNAL_INTERFACE_PUBLISH_QOS_0_SEMAPHORE_WAIT_IN_MS))) return;
+
+	appXDK_MQTT_State = AppXDK_MQTT_State_Publishing;
+
+	appXDK_MQTT_ServicePublishWindow();
+
+	appXDK_MQTT_State = AppXDK_MQTT_State_Ready;
+	xSemaphoreGive(appXDK_MQTT_ExternalInterface_SemaphoreHandle);
+}
 
 
 /**@}*/
@@ -19,12 +19,14 @@
 #include "BCDS_Retcode.h"
 #include "BCDS_CmdProcessor.h"
 #include "Serval_Mqtt.h"
+#include "AppMqttPublishWindow.h"
 
 
 #define APP_XDK_MQTT_CONNECT_TIMEOUT_IN_MS                  UINT32_C(60000) /**< connect timeout */
 #define APP_XDK_MQTT_SUBSCRIBE_TIMEOUT_IN_MS				UINT32_C(60000) /**< subscribe timeout */
 #define APP_XDK_MQTT_UNSUBSCRIBE_TIMEOUT_IN_MS				UINT32_C(60000) /**< unsubscribe timeout */
 #define APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS					UINT32_C(60000) /**< publish timeout */
+#define APP_XDK_MQTT_PUBLISH_WINDOW_TIMEOUT_IN_MS			APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS /**< a qos 1 message in flight not acknowledged in time fails, see @ref AppMqttPublishWindow_AbandonTimedOut() */
 
 /**
  * @brief Enum to represent the supported MQTT types.
@@ -81,6 +83,9 @@ typedef struct {
     uint32_t qos; /**< The MQTT Quality of Service level. If 0, the message is send in a fire and forget way and it will arrive at most once. If 1 Message reception is acknowledged by the other side, retransmission could occur. */
     const char * payload; /**< Pointer to the payload to be published */
     uint32_t payloadLength; /**< Length of the payload to be published */
+    AppMqttPublishWindow_Completed_Func_T publishCompletedCallback_Func; /**< qos 1 only. If set, the publish returns once the message is in flight and the callback is called when it is acknowledged or failed, and before that if it is abandoned. If NULL, the publish waits for the outcome */
+    void * publishCompletedContextPtr; /**< context passed to publishCompletedCallback_Func */
+    uint32_t deadlineMillis; /**< max millis the publish may take, including the wait in the scheduler queue. A publish missing it is abandoned. 0 for no deadline, the publish times out after #APP_XDK_MQTT_PUBLISH_TIMEOUT_IN_MS */
 } AppXDK_MQTT_Publish_T;
 /**
  * @brief Structure to represent the MQTT subscribe features.
@@ -104,6 +109,10 @@ Retcode_T AppXDK_MQTT_UnsubsribeFromTopics(const uint8_t numTopics, const char *
 
 Retcode_T AppXDK_MQTT_PublishToTopic(const AppXDK_MQTT_Publish_T * publishPtr);
 
+void AppXDK_MQTT_SetQos1MaxInFlight(uint32_t maxInFlight);
+
+void AppXDK_MQTT_ServicePublishWindow(void);
+
 
 #endif /* SOURCE_APPXDK_MQTT_H_ */
 
@@ -80,6 +80,7 @@
 #define APP_STATUS_RECURRING_TASK_PRIOIRTY			(UINT32_C(4)) /**< APP_STATUS_RECURRING_TASK_PRIOIRTY */
 #define APP_BUTTONS_PROCESSOR_PRIORITY				(UINT32_C(4)) /**< APP_BUTTONS_PROCESSOR_PRIORITY */
 #define SERVAL_PROCESSOR_PRIORITY					(UINT32_C(4)) /**< SERVAL_PROCESSOR_PRIORITY */
+#define APP_MQTT_SCHEDULER_TASK_PRIORITY			(UINT32_C(4)) /**< APP_MQTT_SCHEDULER_TASK_PRIORITY */
 
 /**
  * @brief Processor & task parameters.
@@ -106,6 +107,8 @@
 #define APP_STATUS_PROCESSOR_STACK_SIZE				(UINT32_C(1024))	/**< APP_STATUS_PROCESSOR_STACK_SIZE */
 #define APP_STATUS_PROCESSOR_QUEUE_LEN   			(UINT32_C(10))		/**< APP_STATUS_PROCESSOR_QUEUE_LEN */
 #define APP_STATUS_RECURRING_TASK_STACK_SIZE		(UINT32_C(1024))	/**< APP_STATUS_RECURRING_TASK_STACK_SIZE */
+
+#define APP_MQTT_SCHEDULER_TASK_STACK_SIZE			(UINT32_C(1024))	/**< APP_MQTT_SCHEDULER_TASK_STACK_SIZE */
 /**@} */
 
 
@@ -147,6 +150,13 @@ enum Solace_App_ModuleID_E {
 	SOLACE_APP_MODULE_ID_APP_STATUS,					/**< 76 */
 	SOLACE_APP_MODULE_ID_APP_VERSION,					/**< 77 */
 	SOLACE_APP_MODULE_ID_APP_TIMESTAMP,					/**< 78 */
+	SOLACE_APP_MODULE_ID_APP_TELEMETRY_SPILL,			/**< 79 */
+	SOLACE_APP_MODULE_ID_APP_TELEMETRY_CAPTURE,			/**< 80 */
+	SOLACE_APP_MODULE_ID_APP_TELEMETRY_ANALYSIS,		/**< 81 */
+	SOLACE_APP_MODULE_ID_APP_TELEMETRY_FUSION,			/**< 82 */
+	SOLACE_APP_MODULE_ID_APP_MQTT_SCHEDULER,			/**< 83 */
+	SOLACE_APP_MODULE_ID_APP_TELEMETRY_RATE_CONTROL,	/**< 84 */
+	SOLACE_APP_MODULE_ID_APP_TELEMETRY_FIDELITY,		/**< 85 */
 };
 /**@} */
 
@@ -256,6 +266,27 @@ enum Solace_App_Retcode_E {
 	RETCODE_SOLAPP_TELEMETRY_PAYLOAD_UNSUPPORTED_FORMAT, 								/**< 292 */
 	RETCODE_SOLAPP_APP_CONTROLLER_BUSY_FAILED_TO_SETUP_AFTER_DISCONNECT, 				/**< 293 */
 	RETCODE_SOLAPP_APPLY_NEW_RUNTIME_CONFIG_TOPIC, 										/**< 294 */
+	RETCODE_SOLAPP_TELEMETRY_QUEUE_FAILED_TO_ALLOCATE, 									/**< 295 */
+	RETCODE_SOLAPP_TELEMETRY_SPILL_NOT_ENABLED, 										/**< 296 */
+	RETCODE_SOLAPP_TELEMETRY_SPILL_WRITE_FAILED, 										/**< 297 */
+	RETCODE_SOLAPP_TELEMETRY_SPILL_EMPTY, 												/**< 298 */
+	RETCODE_SOLAPP_TELEMETRY_SPILL_READ_FAILED, 										/**< 299 */
+	RETCODE_SOLAPP_TELEMETRY_SPILL_FAILED_TO_ALLOCATE, 									/**< 300 */
+	RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL, 									/**< 301 */
+	RETCODE_SOLAPP_TELEMETRY_CAPTURE_FAILED_TO_ALLOCATE, 								/**< 302 */
+	RETCODE_SOLAPP_TELEMETRY_ANALYSIS_FAILED_TO_ALLOCATE, 								/**< 303 */
+	RETCODE_SOLAPP_TELEMETRY_FUSION_FAILED_TO_ALLOCATE, 								/**< 304 */
+	RETCODE_SOLAPP_APP_TELEMETRY_SAMPLING_SENSORS_NOT_POWERED, 							/**< 305 */
+	RETCODE_SOLAPP_APP_XDK_MQTT_FAILED_TO_CREATE_PUBLISH_WINDOW_QUEUE, 					/**< 306 */
+	RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_FULL, 									/**< 307 */
+	RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_FAILED_TO_ALLOCATE, 						/**< 308 */
+	RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_WINDOW_EVENT_LOST, 								/**< 309 */
+	RETCODE_SOLAPP_APP_MQTT_SCHEDULER_FAILED_TO_CREATE_QUEUE, 							/**< 310 */
+	RETCODE_SOLAPP_APP_MQTT_SCHEDULER_QUEUE_FULL, 										/**< 311 */
+	RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED, 								/**< 312 */
+	RETCODE_SOLAPP_APP_MQTT_SCHEDULER_DEADLINE_EXPIRED, 								/**< 313 */
+	RETCODE_SOLAPP_APP_XDK_MQTT_PUBLISH_DEADLINE_MISSED_IN_FLIGHT, 					/**< 314 */
+	RETCODE_SOLAPP_TELEMETRY_QUEUE_LAYOUT_CHANGED, 										/**< 315 */
 };
 
 /**@} */
@@ -346,6 +377,33 @@ typedef enum {
 	AppStatusMessage_Descr_TelemetryConfig_QoS_1_Unsupported_Using_QoS_0,							/**< 50 */
 	AppStatusMessage_Descr_WlanWasDisconnected, 													/**< 51 */
 	AppStatusMessage_Descr_VersionInfo,																/**< 52 */
+	AppStatusMessage_Descr_TelemetryConfig_UnknownValue_QueueDropPolicy,							/**< 53 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_QueueBacklogEvents,							/**< 54 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_SpillReplayEventsPerCycle,					/**< 55 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_BatchMaxBytes,								/**< 56 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_BatchMaxAgeMillis,							/**< 57 */
+	AppStatusMessage_Descr_TelemetryConfig_UnknownValue_PayloadTimestampFormat,						/**< 58 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_AggregateWindowMillis,						/**< 59 */
+	AppStatusMessage_Descr_TelemetryConfig_UnknownValue_Aggregates,									/**< 60 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_Deadbands,									/**< 61 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_DeadbandHeartbeatMillis,					/**< 62 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_QuantileSketchBins,						/**< 63 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_CaptureThresholdMilliG,					/**< 64 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_CapturePreTriggerMillis,				/**< 65 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_CapturePostTriggerMillis,				/**< 66 */
+	AppStatusMessage_Descr_TelemetryConfig_CaptureWindowTooLong,								/**< 67 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_SpectrumWindowSamples,					/**< 68 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_SpectrumPeaks,							/**< 69 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FusionOutputMillis,					/**< 70 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_SensorPeriodsMillis,					/**< 71 */
+	AppStatusMessage_Descr_TelemetryConfig_UnknownValue_SamplingOverrunPolicy,					/**< 72 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_Qos1MaxInFlight,						/**< 73 */
+	AppStatusMessage_Descr_TelemetryRateAdapted,												/**< 74 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityLevels,						/**< 75 */
+	AppStatusMessage_Descr_TelemetryConfig_UnknownValue_FidelityMode,						/**< 76 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityMaxLatencyMillis,				/**< 77 */
+	AppStatusMessage_Descr_TelemetryConfig_InvalidValue_FidelityMaxBacklogEvents,				/**< 78 */
+	AppStatusMessage_Descr_TelemetryFidelityChanged,											/**< 79 */
 
 } AppStatusMessage_DescrCode_T;
 /**@} */
@@ -11,7 +11,35 @@ TIMESTAMP=$(gdate +"%Y-%m-%dT%T.%3NZ")
 MODE="telemetry"
 
 # "apply": "PERSISTENT" or "TRANSIENT"
-# "payloadFormat" : "V1_JSON_VERBOSE" or "V1_JSON_COMPACT"
+# "payloadFormat" : "V1_JSON_VERBOSE", "V1_JSON_COMPACT", "V2_JSON_COLUMNAR", "V2_CBOR" or "V2_DELTA"
+# "payloadTimestampFormat" : "ISO_8601" or "EPOCH_MILLIS", timestamp format of the JSON payload formats
+# "queueBacklogEvents" : 1-16, events held while publishing is behind. queueBacklogEvents x samplesPerEvent <= 128
+# "queueDropPolicy" : "DROP_OLDEST" or "DROP_NEWEST"
+# "batchMaxBytes" : max encoded size of an event, flushed early if the next sample would exceed it
+# "batchMaxAgeMillis" : 0-60000, event flushed early once its first sample is this old. 0 for no limit
+# "spillReplayEventsPerCycle" : 0-10, events spilled to the SD card during an outage replayed per publishing cycle. 0 disables spilling
+# "aggregateWindowMillis" : 0-3600000, aggregation mode: one event per window with the statistics of the samples. 0 sends the samples. JSON payload formats only
+# "aggregates" : "COUNT", "MIN", "MAX", "MEAN", "STDDEV", "P50", "P95", "P99", the statistics sent per window. The quantiles apply to accelerator and gyroscope
+# "quantileSketchBins" : 128-512, bins of the quantile sketch per accelerator and gyroscope channel
+# "deadbands" : per sensor { "absolute": >=0, "relativePercent": 0-100 }, a value is only sent if it moved beyond the deadband since the last sent value
+# "deadbandHeartbeatMillis" : 0-3600000, a suppressed value is sent anyway once the last sent value is this old. 0 for no heartbeat
+# "captureThresholdMilliG" : 0-16000, accelerator magnitude (incl. gravity) that triggers a capture of the raw samples around it, sent on the capture topic. 0 disables capturing
+# "capturePreTriggerMillis" / "capturePostTriggerMillis" : 0-60000, time captured before / after the trigger. at most 1024 samples at the sampling period
+# "spectrumWindowSamples" : 0, 256, 512, accelerator samples per window of the vibration spectrum features (rms, crest factor, peaks), sent on the spectrum topic. 0 disables the features
+# "spectrumPeaks" : 1-8, spectrum peaks sent per axis
+# "fusionOutputMillis" : 0-60000, interval of the orientation quaternions of the sensor fusion, sent on the orientation topic. >= sampling period, at most 8 per publishing cycle. 0 disables the sensor fusion
+# "fusionEulerAngles" : true or false, send roll, pitch and yaw with the quaternions
+# "sensorPeriodsMillis" : per sensor 0-3600000 (>= sampling period), multi-rate sampling: the sensor is read at this period instead of every sampling period. samples only contain the sensors read for them
+# "samplingOverrunPolicy" : "SKIP" or "CATCH_UP", the sampling cycles missed when a cycle overruns the next deadline are skipped or sampled back to back (at most 4)
+# "samplingWallClockAligned" : true or false, sample at multiples of the sampling period since the epoch (e.g. every exact 100 ms mark) so the samples of many devices line up
+# "qos1MaxInFlight" : 1-8, qos 1 events in flight before waiting for an acknowledgement. 1 waits for each event
+# "rateControl" : true or false, slow publishing and sampling down when publishing falls behind and speed them back up to the configured rate
+# "fidelityLevels" : up to 3 levels stepped down to under congestion and back up on recovery, replaces rateControl. [] for none. e.g.
+#   [ { "mode": "DECIMATED", "decimation": 4 }, { "mode": "AGGREGATE", "windowMillis": 1000 }, { "mode": "HEARTBEAT", "windowMillis": 60000 } ]
+#   DECIMATED: decimation 2-16, every nth sample. AGGREGATE / HEARTBEAT: windowMillis >= sampling period, JSON payload formats only. HEARTBEAT sends count and mean only
+# "fidelityMaxLatencyMillis" : 1-60000, mean time spent publishing per cycle at which the fidelity is stepped down
+# "fidelityMaxBacklogEvents" : 1-16, events queued up in a cycle at which the fidelity is stepped down
+# "sensorsEnable" : "ALL" or "SELECTED", sensors powered and read per sampling cycle. SELECTED: only the sensors below and those capture, spectrum and fusion need. sensors not powered at boot need a PERSISTENT config and a reboot
 # sensors:
 #   "humidity",
 #   "light",
@@ -35,6 +63,45 @@ PAYLOAD='
   "samplesPerEvent": 2,
   "qos": 0,
   "payloadFormat" : "V1_JSON_COMPACT",
+  "payloadTimestampFormat" : "ISO_8601",
+  "queueBacklogEvents": 4,
+  "queueDropPolicy": "DROP_OLDEST",
+  "batchMaxBytes": 880,
+  "batchMaxAgeMillis": 0,
+  "spillReplayEventsPerCycle": 2,
+  "aggregateWindowMillis": 0,
+  "aggregates": [
+    "COUNT",
+    "MIN",
+    "MAX",
+    "MEAN",
+    "STDDEV"
+  ],
+  "quantileSketchBins": 128,
+  "deadbands": {
+    "temperature": { "absolute": 1 },
+    "light": { "relativePercent": 5 }
+  },
+  "deadbandHeartbeatMillis": 60000,
+  "captureThresholdMilliG": 0,
+  "capturePreTriggerMillis": 2000,
+  "capturePostTriggerMillis": 2000,
+  "spectrumWindowSamples": 0,
+  "spectrumPeaks": 3,
+  "fusionOutputMillis": 0,
+  "fusionEulerAngles": false,
+  "sensorPeriodsMillis": {
+    "humidity": 10000,
+    "temperature": 10000
+  },
+  "samplingOverrunPolicy": "SKIP",
+  "samplingWallClockAligned": false,
+  "qos1MaxInFlight": 1,
+  "rateControl": true,
+  "fidelityLevels": [],
+  "fidelityMaxLatencyMillis": 1000,
+  "fidelityMaxBacklogEvents": 2,
+  "sensorsEnable": "ALL",
   "sensors": [
     "humidity",
     "light",
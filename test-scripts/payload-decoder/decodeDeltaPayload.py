@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+#
+# Reference decoder for the V2_DELTA telemetry payload format.
+# Reads one binary payload (one event) from a file or stdin and prints it in the
+# V2_JSON_COLUMNAR structure.
+#
+# usage: ./decodeDeltaPayload.py [payload-file]
+#
+import sys
+import json
+import datetime
+
+VERSION = 1
+FLAG_TIMESTAMP = 0x01
+# sensor channels in the order of their flags and columns
+CHANNELS = ["h", "l", "t", "aX", "aY", "aZ", "gX", "gY", "gZ", "mR", "mX", "mY", "mZ"]
+
+
+class Reader:
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def byte(self):
+        if self.pos >= len(self.data):
+            raise ValueError("payload truncated at byte %d" % self.pos)
+        b = self.data[self.pos]
+        self.pos += 1
+        return b
+
+    def bytes(self, length):
+        if self.pos + length > len(self.data):
+            raise ValueError("payload truncated at byte %d" % self.pos)
+        b = self.data[self.pos:self.pos + length]
+        self.pos += length
+        return b
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            b = self.byte()
+            value |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                return value
+
+    def signed(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+
+def decode(data):
+    reader = Reader(data)
+
+    version = reader.byte()
+    if version != VERSION:
+        raise ValueError("unsupported version %d" % version)
+
+    flags = reader.varint()
+    event = {"id": reader.bytes(reader.varint()).decode("utf-8")}
+
+    if flags & FLAG_TIMESTAMP:
+        millis = reader.varint()
+        ts = datetime.datetime.fromtimestamp(millis / 1000.0, tz=datetime.timezone.utc)
+        event["ts"] = ts.strftime("%Y-%m-%dT%H:%M:%S.") + "%03dZ" % (millis % 1000)
+
+    numberOfSamples = reader.varint()
+
+    # delta of deltas of the offsets
+    offsets = [0]
+    delta = 0
+    for _ in range(1, numberOfSamples):
+        delta += reader.signed()
+        offsets.append(offsets[-1] + delta)
+    event["dt"] = offsets
+
+    # first value and deltas per selected channel
+    for i, name in enumerate(CHANNELS):
+        if not flags & (1 << (i + 1)):
+            continue
+        values = []
+        value = 0
+        for _ in range(numberOfSamples):
+            value += reader.signed()
+            values.append(value)
+        if name == "t":
+            # milli degrees celsius, printed in degrees as the JSON formats
+            values = [v / 1000 if v % 1000 else v // 1000 for v in values]
+        event[name] = values
+
+    if reader.pos != len(data):
+        raise ValueError("%d trailing bytes" % (len(data) - reader.pos))
+
+    return event
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], "rb") as f:
+            payload = f.read()
+    else:
+        payload = sys.stdin.buffer.read()
+
+    print(json.dumps(decode(payload), separators=(",", ":")))
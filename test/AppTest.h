@@ -0,0 +1,87 @@
+/*
+ * AppTest.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @defgroup AppTest AppTest
+* @{
+* @brief Minimal check macros for the host unit tests in this folder. A test program returns non-zero if any check failed.
+* @file
+*/
+
+#ifndef TEST_APPTEST_H_
+#define TEST_APPTEST_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static int appTest_NumberOfFailures = 0; /**< number of failed checks */
+
+/**
+ * @brief Check a condition, print the location if it fails.
+ */
+#define APP_TEST_CHECK(cond) do { \
+	if(!(cond)) { \
+		appTest_NumberOfFailures++; \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+	} \
+} while(0)
+
+/**
+ * @brief Check a condition, print the location and a formatted message if it fails.
+ */
+#define APP_TEST_CHECK_MSG(cond, ...) do { \
+	if(!(cond)) { \
+		appTest_NumberOfFailures++; \
+		printf("%s:%d: check failed: %s: ", __FILE__, __LINE__, #cond); \
+		printf(__VA_ARGS__); \
+		printf("\n"); \
+	} \
+} while(0)
+
+/**
+ * @brief Run a test function and print its name.
+ */
+#define APP_TEST_RUN(func) do { \
+	printf("%s\n", #func); \
+	func(); \
+} while(0)
+
+/**
+ * @brief Returns the exit code of the test program.
+ */
+#define APP_TEST_RESULT() (appTest_NumberOfFailures == 0 ? 0 : 1)
+
+/**
+ * @brief Returns the monotonic time in nanoseconds, for the timings the tests print. Host timings, not those of the XDK.
+ */
+static inline uint64_t appTest_GetNanos(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t) now.tv_sec * UINT64_C(1000000000) + (uint64_t) now.tv_nsec;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define APP_TEST_CYCLES_UNIT	"cycles" /**< unit of appTest_GetCycles(): the time stamp counter, reference cycles */
+/**
+ * @brief Returns the time stamp counter of the host.
+ */
+static inline uint64_t appTest_GetCycles(void) { return __rdtsc(); }
+#else
+#define APP_TEST_CYCLES_UNIT	"ns" /**< unit of appTest_GetCycles(): no cycle counter, nanoseconds */
+/**
+ * @brief Returns the monotonic time in nanoseconds, the host has no time stamp counter.
+ */
+static inline uint64_t appTest_GetCycles(void) { return appTest_GetNanos(); }
+#endif
+
+#endif /* TEST_APPTEST_H_ */
+
+/**@} */
+/** ************************************************************************* */
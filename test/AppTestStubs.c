@@ -0,0 +1,65 @@
+/*
+ * AppTestStubs.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host implementations of the XDK SDK functions declared in stubs/, linked into the tests that compile modules with SDK dependencies.
+* @details The tick count and the SNTP time are set by the test, so @ref AppTimestamp_Enable() gives a known baseline.
+* The cJSON functions fail, the tested encoders write into caller buffers and don't use cJSON. The benchmarks define APP_TEST_CJSON and link the real cJSON instead.
+* The functions of the app modules that are not compiled into the tests are copies without the locking.
+* @file
+*/
+
+#include "task.h"
+#include "XDK_SNTP.h"
+#include "cJSON.h"
+#include "AppRuntimeConfig.h"
+#include "AppMisc.h"
+
+#include <string.h>
+
+TickType_t appTestStubs_TickCount = 0; /**< returned by xTaskGetTickCount() */
+uint64_t appTestStubs_SntpSeconds = 0; /**< returned by SNTP_GetTimeFromServer() */
+
+TickType_t xTaskGetTickCount(void) { return appTestStubs_TickCount; }
+
+void vTaskDelay(TickType_t ticks) { appTestStubs_TickCount += ticks; }
+
+Retcode_T SNTP_Setup(SNTP_Setup_T * setupPtr) { (void) setupPtr; return RETCODE_OK; }
+
+Retcode_T SNTP_Enable(void) { return RETCODE_OK; }
+
+Retcode_T SNTP_GetTimeFromServer(uint64_t * secondsPtr, uint32_t timeoutMillis) {
+	(void) timeoutMillis;
+	*secondsPtr = appTestStubs_SntpSeconds;
+	return RETCODE_OK;
+}
+
+#ifndef APP_TEST_CJSON
+cJSON * cJSON_CreateObject(void) { return NULL; }
+cJSON * cJSON_CreateArray(void) { return NULL; }
+cJSON * cJSON_CreateString(const char * string) { (void) string; return NULL; }
+cJSON * cJSON_AddNumberToObject(cJSON * object, const char * name, const double number) { (void) object; (void) name; (void) number; return NULL; }
+void cJSON_AddItemToObject(cJSON * object, const char * name, cJSON * item) { (void) object; (void) name; (void) item; }
+void cJSON_AddItemToArray(cJSON * array, cJSON * item) { (void) array; (void) item; }
+char * cJSON_PrintUnformatted(const cJSON * item) { (void) item; return NULL; }
+void cJSON_Delete(cJSON * item) { (void) item; }
+#endif /* APP_TEST_CJSON */
+
+AppRuntimeConfig_Sensors_T * AppRuntimeConfig_DuplicateSensors(const AppRuntimeConfig_Sensors_T * orgSensorsPtr) {
+	AppRuntimeConfig_Sensors_T * newSensorsPtr = malloc(sizeof(AppRuntimeConfig_Sensors_T));
+	*newSensorsPtr = *orgSensorsPtr;
+	return newSensorsPtr;
+}
+
+void AppRuntimeConfig_DeleteSensors(AppRuntimeConfig_Sensors_T * sensorsPtr) { free(sensorsPtr); }
+
+char * copyString(const char * str) {
+	if(NULL == str) return NULL;
+	size_t len = strlen(str) + 1;
+	char * copy = malloc(len);
+	if(copy) memcpy(copy, str, len);
+	return copy;
+}
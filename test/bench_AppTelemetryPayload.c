@@ -0,0 +1,202 @@
+/*
+ * bench_AppTelemetryPayload.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host benchmark of the 'V1 JSON' encoders of @ref AppTelemetryPayload: the streaming encoder @ref AppTelemetryPayload_EncodeBatch()
+* against the cJSON reference @ref AppTelemetryPayload_CreateBatchStr(), linked against the real cJSON sources.
+* @details Prints per format the bytes per second of both encoders, the peak heap of the cJSON one, counted by the cJSON_InitHooks() allocator,
+* and checks that both outputs are identical. The streaming encoder does not allocate, its memory is the caller's buffer.
+* Not part of the unit tests, see README.md: make bench CJSON_DIR=<folder of cJSON.c and cJSON.h>
+* @file
+*/
+
+#include "AppTest.h"
+#include "AppTelemetryPayload.h"
+#include "cJSON.h"
+#include "task.h"
+#include "XDK_SNTP.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_DEVICE_ID				"xdk-bench" /**< the device id */
+#define BENCH_SNTP_SECONDS			UINT64_C(1700000000) /**< the SNTP time at enable */
+#define BENCH_NUMBER_OF_SAMPLES		UINT32_C(50) /**< number of samples per batch */
+#define BENCH_BUFFER_SIZE			UINT32_C(65536) /**< size of the payload buffer */
+#define BENCH_MIN_NANOS				UINT64_C(300000000) /**< minimum duration of a measurement */
+#define BENCH_ALLOC_HEADER_SIZE		UINT32_C(16) /**< the size of an allocation is kept in front of it, keeps the alignment of malloc() */
+
+static AppTelemetryPayload_Sample_T bench_Samples[BENCH_NUMBER_OF_SAMPLES]; /**< the batch */
+
+static char bench_Buffer[BENCH_BUFFER_SIZE]; /**< the payload buffer of the streaming encoder */
+
+static size_t bench_HeapSize = 0; /**< bytes allocated by cJSON */
+
+static size_t bench_PeakHeapSize = 0; /**< maximum of bench_HeapSize */
+
+/**
+ * @brief The cJSON allocator: counts the allocated bytes.
+ */
+static void * bench_Malloc(size_t size) {
+
+	unsigned char * blockPtr = malloc(BENCH_ALLOC_HEADER_SIZE + size);
+	if(NULL == blockPtr) return NULL;
+
+	memcpy(blockPtr, &size, sizeof(size));
+	bench_HeapSize += size;
+	if(bench_HeapSize > bench_PeakHeapSize) bench_PeakHeapSize = bench_HeapSize;
+
+	return blockPtr + BENCH_ALLOC_HEADER_SIZE;
+}
+
+/**
+ * @brief The cJSON deallocator, see bench_Malloc().
+ */
+static void bench_Free(void * ptr) {
+
+	if(NULL == ptr) return;
+
+	unsigned char * blockPtr = (unsigned char *) ptr - BENCH_ALLOC_HEADER_SIZE;
+	size_t size = 0;
+	memcpy(&size, blockPtr, sizeof(size));
+	bench_HeapSize -= size;
+
+	free(blockPtr);
+}
+
+/**
+ * @brief Fill the batch with all sensors present, varying values with decimals of the temperature, a sampling period of 10 ms.
+ */
+static void bench_InitSamples(void) {
+
+	uint32_t random = 12345;
+
+	for(uint32_t i = 0; i < BENCH_NUMBER_OF_SAMPLES; i++) {
+
+		AppTelemetryPayload_Sample_T * samplePtr = &bench_Samples[i];
+		memset(samplePtr, 0, sizeof(*samplePtr));
+
+		random = random * 1103515245 + 12345;
+		int32_t noise = (int32_t) ((random >> 16) % 41) - 20;
+
+		samplePtr->tickCount = (TickType_t) (2000 + i * 10);
+		samplePtr->humidity = 48;
+		samplePtr->light = 100800;
+		samplePtr->temperature = 20211 + noise;
+		samplePtr->accel[0] = -4 + noise;
+		samplePtr->accel[1] = 1 - noise;
+		samplePtr->accel[2] = 986 + noise;
+		samplePtr->gyro[0] = 854 + 10 * noise;
+		samplePtr->gyro[1] = -610 - 10 * noise;
+		samplePtr->gyro[2] = -5612 + 10 * noise;
+		samplePtr->mag[0] = 6299;
+		samplePtr->mag[1] = -42 + noise / 4;
+		samplePtr->mag[2] = -29 - noise / 4;
+		samplePtr->mag[3] = -40 + noise / 4;
+		samplePtr->presentSensors = APP_TELEMETRY_PAYLOAD_SENSOR_ALL;
+	}
+}
+
+/**
+ * @brief Configure the payload module with all sensors selected and a format.
+ */
+static void bench_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat) {
+
+	AppRuntimeConfig_TelemetryConfig_T config;
+	memset(&config, 0, sizeof(config));
+
+	config.received.payloadFormat = payloadFormat;
+	config.received.payloadTimestampFormat = AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601;
+	config.received.sensors.isHumidity = true;
+	config.received.sensors.isLight = true;
+	config.received.sensors.isTemperature = true;
+	config.received.sensors.isAccelerator = true;
+	config.received.sensors.isGyro = true;
+	config.received.sensors.isMagneto = true;
+
+	APP_TEST_CHECK(RETCODE_OK == AppTelemetryPayload_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, &config));
+}
+
+/**
+ * @brief Measure both encoders in the configured format and print the results.
+ */
+static void bench_Encoders(const char * formatName) {
+
+	// identical output
+	uint32_t length = 0;
+	APP_TEST_CHECK(RETCODE_OK == AppTelemetryPayload_EncodeBatch(bench_Samples, BENCH_NUMBER_OF_SAMPLES, bench_Buffer, sizeof(bench_Buffer), &length));
+
+	size_t heapSize = bench_HeapSize;
+	bench_PeakHeapSize = heapSize;
+	char * payloadStr = AppTelemetryPayload_CreateBatchStr(bench_Samples, BENCH_NUMBER_OF_SAMPLES);
+	APP_TEST_CHECK(NULL != payloadStr);
+	if(NULL == payloadStr) return;
+	// the tree and the print buffer, the payload string included
+	size_t peakHeapSize = bench_PeakHeapSize - heapSize;
+	APP_TEST_CHECK_MSG(0 == strcmp(payloadStr, bench_Buffer), "\n%s\n%s", payloadStr, bench_Buffer);
+	cJSON_free(payloadStr);
+
+	// streaming encoder
+	uint64_t iterations = 0;
+	uint64_t startNanos = appTest_GetNanos();
+	uint64_t nanos = 0;
+	do {
+		for(uint32_t i = 0; i < 100; i++) (void) AppTelemetryPayload_EncodeBatch(bench_Samples, BENCH_NUMBER_OF_SAMPLES, bench_Buffer, sizeof(bench_Buffer), &length);
+		iterations += 100;
+		nanos = appTest_GetNanos() - startNanos;
+	} while(nanos < BENCH_MIN_NANOS);
+	double streamingBytesPerSecond = (double) length * (double) iterations * 1e9 / (double) nanos;
+
+	// cJSON
+	iterations = 0;
+	startNanos = appTest_GetNanos();
+	do {
+		for(uint32_t i = 0; i < 10; i++) cJSON_free(AppTelemetryPayload_CreateBatchStr(bench_Samples, BENCH_NUMBER_OF_SAMPLES));
+		iterations += 10;
+		nanos = appTest_GetNanos() - startNanos;
+	} while(nanos < BENCH_MIN_NANOS);
+	double cJsonBytesPerSecond = (double) length * (double) iterations * 1e9 / (double) nanos;
+
+	printf("  %s, %u samples, %u bytes:\n", formatName, BENCH_NUMBER_OF_SAMPLES, length);
+	printf("    streaming encoder: %.1f MB/s, heap 0 bytes, buffer %u bytes\n", streamingBytesPerSecond / 1e6, length + 1);
+	printf("    cJSON:             %.1f MB/s, peak heap %zu bytes, %.1fx slower\n", cJsonBytesPerSecond / 1e6, peakHeapSize, streamingBytesPerSecond / cJsonBytesPerSecond);
+}
+
+/**
+ * @brief 'V1 JSON Verbose'.
+ */
+static void bench_V1_Json_Verbose(void) {
+
+	bench_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose);
+	bench_Encoders("V1 JSON Verbose");
+}
+
+/**
+ * @brief 'V1 JSON Compact'.
+ */
+static void bench_V1_Json_Compact(void) {
+
+	bench_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact);
+	bench_Encoders("V1 JSON Compact");
+}
+
+int main(void) {
+
+	cJSON_Hooks hooks = { .malloc_fn = bench_Malloc, .free_fn = bench_Free };
+	cJSON_InitHooks(&hooks);
+
+	APP_TEST_CHECK(RETCODE_OK == AppTelemetryPayload_Init(BENCH_DEVICE_ID));
+	bench_InitSamples();
+
+	appTestStubs_SntpSeconds = BENCH_SNTP_SECONDS;
+	appTestStubs_TickCount = 1000;
+	APP_TEST_CHECK(RETCODE_OK == AppTimestamp_Enable());
+
+	APP_TEST_RUN(bench_V1_Json_Verbose);
+	APP_TEST_RUN(bench_V1_Json_Compact);
+
+	return APP_TEST_RESULT();
+}
@@ -0,0 +1,17 @@
+/*
+ * BCDS_CmdProcessor.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host stub of the XDK SDK header for the unit tests, declares only what the tested modules use.
+* @file
+*/
+
+#ifndef TEST_STUBS_BCDS_CMDPROCESSOR_H_
+#define TEST_STUBS_BCDS_CMDPROCESSOR_H_
+
+typedef struct { int unused; } CmdProcessor_T; /**< not used by the tested modules */
+
+#endif /* TEST_STUBS_BCDS_CMDPROCESSOR_H_ */
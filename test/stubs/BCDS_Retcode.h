@@ -0,0 +1,45 @@
+/*
+ * BCDS_Retcode.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host stub of the XDK SDK header for the unit tests, declares only what the tested modules use.
+* @file
+*/
+
+#ifndef TEST_STUBS_BCDS_RETCODE_H_
+#define TEST_STUBS_BCDS_RETCODE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <assert.h>
+
+typedef uint32_t Retcode_T; /**< severity in bits 28..31, code in bits 0..15 */
+
+#define RETCODE_OK							((Retcode_T) 0) /**< success */
+#define RETCODE_SEVERITY_FATAL				UINT32_C(1) /**< fatal */
+#define RETCODE_SEVERITY_ERROR				UINT32_C(2) /**< error */
+#define RETCODE_SEVERITY_WARNING			UINT32_C(3) /**< warning */
+#define RETCODE_SEVERITY_INFO				UINT32_C(4) /**< info */
+#define RETCODE_XDK_APP_FIRST_CUSTOM_CODE	200 /**< first custom code of the app */
+
+#define RETCODE(severity, code)		((Retcode_T) (((uint32_t) (severity) << 28) | ((uint32_t) (code) & 0xFFFF))) /**< compose a retcode */
+
+/**
+ * @brief Returns the code of a retcode.
+ */
+static inline uint32_t Retcode_GetCode(Retcode_T retcode) { return retcode & 0xFFFF; }
+/**
+ * @brief Returns the severity of a retcode.
+ */
+static inline uint32_t Retcode_GetSeverity(Retcode_T retcode) { return retcode >> 28; }
+/**
+ * @brief Raise an error, fails the test.
+ */
+static inline void Retcode_RaiseError(Retcode_T retcode) { (void) retcode; assert(0); }
+
+#endif /* TEST_STUBS_BCDS_RETCODE_H_ */
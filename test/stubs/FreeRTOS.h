@@ -0,0 +1,24 @@
+/*
+ * FreeRTOS.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host stub of the XDK SDK header for the unit tests, declares only what the tested modules use.
+* @file
+*/
+
+#ifndef TEST_STUBS_FREERTOS_H_
+#define TEST_STUBS_FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t; /**< 1 tick per millisecond as on the XDK */
+typedef TickType_t portTickType; /**< legacy name */
+
+#define portTICK_PERIOD_MS		((TickType_t) 1) /**< milliseconds per tick */
+#define portTICK_RATE_MS		portTICK_PERIOD_MS /**< legacy name */
+
+#endif /* TEST_STUBS_FREERTOS_H_ */
@@ -0,0 +1,27 @@
+/*
+ * XDK_SNTP.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host stub of the XDK SDK header for the unit tests, declares only what the tested modules use.
+* @file
+*/
+
+#ifndef TEST_STUBS_XDK_SNTP_H_
+#define TEST_STUBS_XDK_SNTP_H_
+
+#include "BCDS_Retcode.h"
+
+typedef struct { const char * ServerUrl; uint16_t ServerPort; } SNTP_Setup_T; /**< SNTP setup */
+
+extern uint64_t appTestStubs_SntpSeconds; /**< the time returned by SNTP_GetTimeFromServer(), set by the test */
+
+Retcode_T SNTP_Setup(SNTP_Setup_T * setupPtr);
+
+Retcode_T SNTP_Enable(void);
+
+Retcode_T SNTP_GetTimeFromServer(uint64_t * secondsPtr, uint32_t timeoutMillis);
+
+#endif /* TEST_STUBS_XDK_SNTP_H_ */
@@ -0,0 +1,30 @@
+/*
+ * XDK_Sensor.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host stub of the XDK SDK header for the unit tests, declares only what the tested modules use.
+* @file
+*/
+
+#ifndef TEST_STUBS_XDK_SENSOR_H_
+#define TEST_STUBS_XDK_SENSOR_H_
+
+#include <stdint.h>
+
+typedef struct { int32_t X; int32_t Y; int32_t Z; } Sensor_Axis_T; /**< x, y, z */
+
+typedef struct { int32_t R; int32_t X; int32_t Y; int32_t Z; } Sensor_Mag_T; /**< resistance and x, y, z */
+
+typedef struct {
+	uint32_t RH; /**< humidity */
+	uint32_t Light; /**< light */
+	float Temp; /**< temperature in milli degrees celsius, a float as in the SDK */
+	Sensor_Axis_T Accel; /**< accelerometer */
+	Sensor_Axis_T Gyro; /**< gyroscope */
+	Sensor_Mag_T Mag; /**< magnetometer */
+} Sensor_Value_T;
+
+#endif /* TEST_STUBS_XDK_SENSOR_H_ */
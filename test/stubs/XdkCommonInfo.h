@@ -0,0 +1,17 @@
+/*
+ * XdkCommonInfo.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host stub of the XDK SDK header for the unit tests, declares only what the tested modules use.
+* @file
+*/
+
+#ifndef TEST_STUBS_XDKCOMMONINFO_H_
+#define TEST_STUBS_XDKCOMMONINFO_H_
+
+#define XDK_COMMON_ID_OVERFLOW		62 /**< first module id of the app */
+
+#endif /* TEST_STUBS_XDKCOMMONINFO_H_ */
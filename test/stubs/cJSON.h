@@ -0,0 +1,26 @@
+/*
+ * cJSON.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host stub of the XDK SDK header for the unit tests, declares only what the tested modules use.
+* @file
+*/
+
+#ifndef TEST_STUBS_CJSON_H_
+#define TEST_STUBS_CJSON_H_
+
+typedef struct cJSON cJSON; /**< opaque, the tested encoders don't build cJSON trees */
+
+cJSON * cJSON_CreateObject(void);
+cJSON * cJSON_CreateArray(void);
+cJSON * cJSON_CreateString(const char * string);
+cJSON * cJSON_AddNumberToObject(cJSON * object, const char * name, const double number);
+void cJSON_AddItemToObject(cJSON * object, const char * name, cJSON * item);
+void cJSON_AddItemToArray(cJSON * array, cJSON * item);
+char * cJSON_PrintUnformatted(const cJSON * item);
+void cJSON_Delete(cJSON * item);
+
+#endif /* TEST_STUBS_CJSON_H_ */
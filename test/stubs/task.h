@@ -0,0 +1,23 @@
+/*
+ * task.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host stub of the XDK SDK header for the unit tests, declares only what the tested modules use.
+* @file
+*/
+
+#ifndef TEST_STUBS_TASK_H_
+#define TEST_STUBS_TASK_H_
+
+#include "FreeRTOS.h"
+
+extern TickType_t appTestStubs_TickCount; /**< the tick count returned by xTaskGetTickCount(), set by the test */
+
+TickType_t xTaskGetTickCount(void);
+
+void vTaskDelay(TickType_t ticks);
+
+#endif /* TEST_STUBS_TASK_H_ */
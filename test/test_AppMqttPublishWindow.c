@@ -0,0 +1,331 @@
+/*
+ * test_AppMqttPublishWindow.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host unit test of @ref AppMqttPublishWindow against a broker stand-in that acknowledges the messages in the order it received them, after a latency.
+* Checks the throughput against the window size, that a late acknowledgement of an abandoned message does not complete the next one,
+* a broker that stopped responding and the disconnect.
+* @file
+*/
+
+#include "AppTest.h"
+#include "AppMqttPublishWindow.h"
+
+#include <string.h>
+
+#define TEST_MAX_MESSAGES			UINT32_C(1000) /**< max number of messages of a run */
+#define TEST_LATENCY_TICKS			UINT32_C(50) /**< round trip to the broker */
+#define TEST_TIMEOUT_TICKS			UINT32_C(100) /**< timeout of the window */
+#define TEST_NEVER					UINT32_MAX /**< latency of a message the broker does not acknowledge */
+
+/**
+ * @brief The broker stand-in: the ticks at which it acknowledges the messages received, in the order received.
+ */
+typedef struct {
+	uint32_t ackTicks[TEST_MAX_MESSAGES]; /**< ticks of the acknowledgement per message received, #TEST_NEVER for none */
+	uint32_t numberReceived; /**< number of messages received */
+	uint32_t numberAcknowledged; /**< number of acknowledgements sent */
+} Test_Broker_T;
+
+/**
+ * @brief The outcomes passed to the completion callback, per packet id.
+ */
+typedef struct {
+	uint32_t numberOfAcks; /**< number of calls with isAcknowledged */
+	uint32_t numberOfFailures; /**< number of calls without isAcknowledged, not abandoned */
+	uint32_t numberOfAbandons; /**< number of calls with isAbandoned */
+} Test_Outcome_T;
+
+static Test_Outcome_T test_Outcomes[TEST_MAX_MESSAGES + 1]; /**< the outcomes, indexed by packet id */
+
+/**
+ * @brief The completion callback, records the outcome.
+ */
+static void test_Completed(uint16_t packetId, bool isAcknowledged, bool isAbandoned, void * contextPtr) {
+	(void) contextPtr;
+	if(packetId > TEST_MAX_MESSAGES) return;
+	APP_TEST_CHECK(!(isAbandoned && isAcknowledged));
+	if(isAbandoned) test_Outcomes[packetId].numberOfAbandons++;
+	else if(isAcknowledged) test_Outcomes[packetId].numberOfAcks++;
+	else test_Outcomes[packetId].numberOfFailures++;
+}
+
+/**
+ * @brief The broker receives a message. It acknowledges in order, so not before the message received before.
+ */
+static void test_BrokerReceive(Test_Broker_T * brokerPtr, uint32_t nowTicks, uint32_t latencyTicks) {
+	uint32_t ackTicks = (TEST_NEVER == latencyTicks) ? TEST_NEVER : nowTicks + latencyTicks;
+	if(brokerPtr->numberReceived > 0) {
+		uint32_t previousAckTicks = brokerPtr->ackTicks[brokerPtr->numberReceived - 1];
+		if(previousAckTicks > ackTicks) ackTicks = previousAckTicks;
+	}
+	brokerPtr->ackTicks[brokerPtr->numberReceived++] = ackTicks;
+}
+
+/**
+ * @brief Apply the acknowledgements due and abandon the messages timed out, as AppXDK_MQTT does. Returns the number of messages abandoned.
+ */
+static uint32_t test_Service(AppMqttPublishWindow_T * windowPtr, Test_Broker_T * brokerPtr, uint32_t nowTicks) {
+
+	AppMqttPublishWindow_Completion_T completion;
+
+	while(brokerPtr->numberAcknowledged < brokerPtr->numberReceived && brokerPtr->ackTicks[brokerPtr->numberAcknowledged] <= nowTicks) {
+		brokerPtr->numberAcknowledged++;
+		APP_TEST_CHECK(AppMqttPublishWindow_Complete(windowPtr, true, &completion));
+		AppMqttPublishWindow_NotifyCompletion(&completion);
+	}
+
+	uint32_t numberAbandoned = 0;
+	while(AppMqttPublishWindow_AbandonTimedOut(windowPtr, nowTicks, &completion)) {
+		numberAbandoned++;
+		AppMqttPublishWindow_NotifyCompletion(&completion);
+	}
+	return numberAbandoned;
+}
+
+/**
+ * @brief Add a message to the window and send it to the broker.
+ */
+static AppMqttPublishWindow_Message_T * test_Publish(AppMqttPublishWindow_T * windowPtr, Test_Broker_T * brokerPtr, uint32_t nowTicks, uint32_t latencyTicks) {
+	AppMqttPublishWindow_Message_T * messagePtr = AppMqttPublishWindow_Add(windowPtr, "topic", "payload", 7, test_Completed, NULL, nowTicks);
+	if(NULL != messagePtr) test_BrokerReceive(brokerPtr, nowTicks, latencyTicks);
+	return messagePtr;
+}
+
+/**
+ * @brief Take all messages out of the window as the connection closed.
+ */
+static void test_Disconnect(AppMqttPublishWindow_T * windowPtr) {
+	AppMqttPublishWindow_Completion_T completion;
+	while(AppMqttPublishWindow_Complete(windowPtr, false, &completion)) AppMqttPublishWindow_NotifyCompletion(&completion);
+}
+
+/**
+ * @brief Add, remove, full window, packet ids and their wraparound.
+ */
+static void test_Basic(void) {
+	AppMqttPublishWindow_T window;
+	AppMqttPublishWindow_Completion_T completion;
+	memset(test_Outcomes, 0, sizeof(test_Outcomes));
+
+	AppMqttPublishWindow_Init(&window, 3, TEST_TIMEOUT_TICKS);
+	APP_TEST_CHECK(!AppMqttPublishWindow_Complete(&window, true, &completion));
+	APP_TEST_CHECK(!AppMqttPublishWindow_RemoveNewest(&window, &completion));
+
+	for(uint16_t packetId = 1; packetId <= 3; packetId++) {
+		AppMqttPublishWindow_Message_T * messagePtr = AppMqttPublishWindow_Add(&window, "topic", "payload", 7, test_Completed, NULL, 0);
+		APP_TEST_CHECK(NULL != messagePtr && packetId == messagePtr->packetId);
+	}
+	APP_TEST_CHECK(AppMqttPublishWindow_IsFull(&window));
+	APP_TEST_CHECK(NULL == AppMqttPublishWindow_Add(&window, "topic", "payload", 7, test_Completed, NULL, 0));
+
+	// sending the newest failed: no callback, its packet id is not reused
+	APP_TEST_CHECK(AppMqttPublishWindow_RemoveNewest(&window, &completion));
+	APP_TEST_CHECK(3 == completion.packetId && !completion.isAcknowledged);
+	APP_TEST_CHECK(2 == AppMqttPublishWindow_GetNumberInFlight(&window));
+	AppMqttPublishWindow_Message_T * messagePtr = AppMqttPublishWindow_Add(&window, "topic", "payload", 7, test_Completed, NULL, 0);
+	APP_TEST_CHECK(NULL != messagePtr && 4 == messagePtr->packetId);
+	APP_TEST_CHECK(0 == strcmp("topic", messagePtr->topic) && 0 == memcmp("payload", messagePtr->payload, 7));
+
+	// the oldest is completed first
+	APP_TEST_CHECK(AppMqttPublishWindow_Complete(&window, true, &completion));
+	APP_TEST_CHECK(1 == completion.packetId && completion.isAcknowledged && !completion.isAbandoned && !completion.wasAbandoned);
+
+	// a smaller window takes effect once enough messages completed
+	AppMqttPublishWindow_SetMaxInFlight(&window, 1);
+	APP_TEST_CHECK(AppMqttPublishWindow_IsFull(&window));
+	test_Disconnect(&window);
+	APP_TEST_CHECK(0 == AppMqttPublishWindow_GetNumberInFlight(&window));
+	APP_TEST_CHECK(!AppMqttPublishWindow_IsFull(&window));
+
+	// packet id 0 is skipped
+	window.nextPacketId = UINT16_MAX;
+	messagePtr = AppMqttPublishWindow_Add(&window, "topic", "payload", 7, NULL, NULL, 0);
+	APP_TEST_CHECK(NULL != messagePtr && UINT16_MAX == messagePtr->packetId);
+	APP_TEST_CHECK(AppMqttPublishWindow_Complete(&window, true, &completion));
+	messagePtr = AppMqttPublishWindow_Add(&window, "topic", "payload", 7, NULL, NULL, 0);
+	APP_TEST_CHECK(NULL != messagePtr && 1 == messagePtr->packetId);
+	test_Disconnect(&window);
+}
+
+/**
+ * @brief Publish as fast as the window allows, returns the ticks until the broker acknowledged all messages.
+ */
+static uint32_t test_RunThroughput(uint32_t maxInFlight, uint32_t numberOfMessages) {
+	static Test_Broker_T broker;
+	AppMqttPublishWindow_T window;
+	memset(&broker, 0, sizeof(broker));
+	memset(test_Outcomes, 0, sizeof(test_Outcomes));
+
+	AppMqttPublishWindow_Init(&window, maxInFlight, TEST_TIMEOUT_TICKS);
+
+	uint32_t numberSent = 0;
+	uint32_t nowTicks = 0;
+	for(; nowTicks < numberOfMessages * TEST_LATENCY_TICKS * 2; nowTicks++) {
+		APP_TEST_CHECK(0 == test_Service(&window, &broker, nowTicks));
+		if(numberSent == numberOfMessages && 0 == AppMqttPublishWindow_GetNumberInFlight(&window)) break;
+		while(numberSent < numberOfMessages && !AppMqttPublishWindow_IsFull(&window)) {
+			if(NULL == test_Publish(&window, &broker, nowTicks, TEST_LATENCY_TICKS)) break;
+			numberSent++;
+		}
+	}
+
+	for(uint32_t packetId = 1; packetId <= numberOfMessages; packetId++) {
+		APP_TEST_CHECK_MSG(1 == test_Outcomes[packetId].numberOfAcks && 0 == test_Outcomes[packetId].numberOfFailures,
+				"window %u, packet id %u: %u acks, %u failures", (unsigned) maxInFlight, (unsigned) packetId,
+				(unsigned) test_Outcomes[packetId].numberOfAcks, (unsigned) test_Outcomes[packetId].numberOfFailures);
+	}
+	return nowTicks;
+}
+
+/**
+ * @brief The throughput scales with the window: with w messages in flight one round trip completes w messages.
+ */
+static void test_Throughput(void) {
+	const uint32_t numberOfMessages = 400;
+	uint32_t ticksOfWindow1 = 0;
+
+	for(uint32_t maxInFlight = 1; maxInFlight <= APP_MQTT_PUBLISH_WINDOW_MAX_SIZE; maxInFlight *= 2) {
+		uint32_t ticks = test_RunThroughput(maxInFlight, numberOfMessages);
+		uint32_t expectedTicks = (numberOfMessages / maxInFlight) * TEST_LATENCY_TICKS;
+		printf("  window %u: %u messages in %u ticks, latency %u ticks\n", (unsigned) maxInFlight, (unsigned) numberOfMessages, (unsigned) ticks, (unsigned) TEST_LATENCY_TICKS);
+		APP_TEST_CHECK_MSG(ticks <= expectedTicks + TEST_LATENCY_TICKS, "window %u: %u ticks, expected %u", (unsigned) maxInFlight, (unsigned) ticks, (unsigned) expectedTicks);
+		if(1 == maxInFlight) ticksOfWindow1 = ticks;
+		else APP_TEST_CHECK_MSG(ticks * (maxInFlight - 1) <= ticksOfWindow1, "window %u: %u ticks, window 1: %u ticks", (unsigned) maxInFlight, (unsigned) ticks, (unsigned) ticksOfWindow1);
+	}
+}
+
+/**
+ * @brief A message acknowledged after the timeout is abandoned once, its late acknowledgement is passed on as its outcome and does not complete the next message.
+ */
+static void test_LateAck(void) {
+	static Test_Broker_T broker;
+	AppMqttPublishWindow_T window;
+	memset(&broker, 0, sizeof(broker));
+	memset(test_Outcomes, 0, sizeof(test_Outcomes));
+
+	AppMqttPublishWindow_Init(&window, 4, TEST_TIMEOUT_TICKS);
+
+	// 1 is acknowledged at 150, after its timeout at 100. 2 is sent at 60 and acknowledged at 155, in time
+	APP_TEST_CHECK(NULL != test_Publish(&window, &broker, 0, 150));
+	for(uint32_t nowTicks = 1; nowTicks < 60; nowTicks++) APP_TEST_CHECK(0 == test_Service(&window, &broker, nowTicks));
+	APP_TEST_CHECK(NULL != test_Publish(&window, &broker, 60, 95));
+
+	for(uint32_t nowTicks = 60; nowTicks < 100; nowTicks++) APP_TEST_CHECK(0 == test_Service(&window, &broker, nowTicks));
+	APP_TEST_CHECK(1 == test_Service(&window, &broker, 100));
+	APP_TEST_CHECK(1 == test_Outcomes[1].numberOfAbandons && 0 == test_Outcomes[1].numberOfFailures && 0 == test_Outcomes[1].numberOfAcks);
+
+	// the abandoned message keeps its place
+	APP_TEST_CHECK(2 == AppMqttPublishWindow_GetNumberInFlight(&window));
+
+	// the late acknowledgement of 1 is matched to 1 and passed on as its outcome
+	for(uint32_t nowTicks = 101; nowTicks <= 150; nowTicks++) APP_TEST_CHECK(0 == test_Service(&window, &broker, nowTicks));
+	APP_TEST_CHECK(1 == AppMqttPublishWindow_GetNumberInFlight(&window));
+	APP_TEST_CHECK(1 == test_Outcomes[1].numberOfAbandons && 0 == test_Outcomes[1].numberOfFailures && 1 == test_Outcomes[1].numberOfAcks);
+	APP_TEST_CHECK(0 == test_Outcomes[2].numberOfFailures && 0 == test_Outcomes[2].numberOfAcks);
+
+	for(uint32_t nowTicks = 151; nowTicks <= 155; nowTicks++) APP_TEST_CHECK(0 == test_Service(&window, &broker, nowTicks));
+	APP_TEST_CHECK(0 == AppMqttPublishWindow_GetNumberInFlight(&window));
+	APP_TEST_CHECK(0 == test_Outcomes[2].numberOfFailures && 1 == test_Outcomes[2].numberOfAcks);
+}
+
+/**
+ * @brief Every message is acknowledged just after the timeout: each is abandoned once, then acknowledged, the late acknowledgements never complete another message.
+ */
+static void test_AllLate(void) {
+	static Test_Broker_T broker;
+	AppMqttPublishWindow_T window;
+	memset(&broker, 0, sizeof(broker));
+	memset(test_Outcomes, 0, sizeof(test_Outcomes));
+
+	const uint32_t numberOfMessages = 100;
+	AppMqttPublishWindow_Init(&window, APP_MQTT_PUBLISH_WINDOW_MAX_SIZE, TEST_TIMEOUT_TICKS);
+
+	uint32_t numberSent = 0;
+	for(uint32_t nowTicks = 0; nowTicks < numberOfMessages * TEST_TIMEOUT_TICKS * 2; nowTicks++) {
+		test_Service(&window, &broker, nowTicks);
+		if(numberSent == numberOfMessages && 0 == AppMqttPublishWindow_GetNumberInFlight(&window)) break;
+		while(numberSent < numberOfMessages && !AppMqttPublishWindow_IsFull(&window)) {
+			if(NULL == test_Publish(&window, &broker, nowTicks, TEST_TIMEOUT_TICKS + 1)) break;
+			numberSent++;
+		}
+	}
+	APP_TEST_CHECK(numberOfMessages == numberSent);
+	APP_TEST_CHECK(0 == AppMqttPublishWindow_GetNumberInFlight(&window));
+	for(uint32_t packetId = 1; packetId <= numberOfMessages; packetId++) {
+		APP_TEST_CHECK_MSG(1 == test_Outcomes[packetId].numberOfAbandons && 1 == test_Outcomes[packetId].numberOfAcks && 0 == test_Outcomes[packetId].numberOfFailures,
+				"packet id %u: %u abandons, %u acks, %u failures", (unsigned) packetId, (unsigned) test_Outcomes[packetId].numberOfAbandons,
+				(unsigned) test_Outcomes[packetId].numberOfAcks, (unsigned) test_Outcomes[packetId].numberOfFailures);
+	}
+}
+
+/**
+ * @brief A broker that stopped responding fills the window with abandoned messages, the disconnect frees it and fails them once.
+ */
+static void test_BrokerStopsResponding(void) {
+	static Test_Broker_T broker;
+	AppMqttPublishWindow_T window;
+	memset(&broker, 0, sizeof(broker));
+	memset(test_Outcomes, 0, sizeof(test_Outcomes));
+
+	AppMqttPublishWindow_Init(&window, 2, TEST_TIMEOUT_TICKS);
+
+	APP_TEST_CHECK(NULL != test_Publish(&window, &broker, 0, TEST_LATENCY_TICKS));
+	APP_TEST_CHECK(NULL != test_Publish(&window, &broker, 10, TEST_NEVER));
+	APP_TEST_CHECK(NULL == test_Publish(&window, &broker, 10, TEST_NEVER));
+
+	uint32_t numberAbandoned = 0;
+	for(uint32_t nowTicks = 11; nowTicks < 10 * TEST_TIMEOUT_TICKS; nowTicks++) {
+		numberAbandoned += test_Service(&window, &broker, nowTicks);
+		if(!AppMqttPublishWindow_IsFull(&window)) APP_TEST_CHECK(NULL != test_Publish(&window, &broker, nowTicks, TEST_NEVER));
+	}
+	APP_TEST_CHECK(1 == test_Outcomes[1].numberOfAcks);
+	APP_TEST_CHECK(2 == numberAbandoned);
+	APP_TEST_CHECK(1 == test_Outcomes[2].numberOfAbandons && 1 == test_Outcomes[3].numberOfAbandons);
+	APP_TEST_CHECK(0 == test_Outcomes[2].numberOfFailures && 0 == test_Outcomes[3].numberOfFailures);
+	APP_TEST_CHECK(AppMqttPublishWindow_IsFull(&window));
+
+	test_Disconnect(&window);
+	APP_TEST_CHECK(0 == AppMqttPublishWindow_GetNumberInFlight(&window));
+	APP_TEST_CHECK(1 == test_Outcomes[2].numberOfFailures && 1 == test_Outcomes[3].numberOfFailures);
+	APP_TEST_CHECK(0 == test_Outcomes[4].numberOfFailures + test_Outcomes[4].numberOfAcks);
+}
+
+/**
+ * @brief The disconnect fails the messages in flight once.
+ */
+static void test_DisconnectInFlight(void) {
+	static Test_Broker_T broker;
+	AppMqttPublishWindow_T window;
+	memset(&broker, 0, sizeof(broker));
+	memset(test_Outcomes, 0, sizeof(test_Outcomes));
+
+	AppMqttPublishWindow_Init(&window, APP_MQTT_PUBLISH_WINDOW_MAX_SIZE, TEST_TIMEOUT_TICKS);
+	for(uint32_t i = 0; i < APP_MQTT_PUBLISH_WINDOW_MAX_SIZE; i++) APP_TEST_CHECK(NULL != test_Publish(&window, &broker, i, TEST_LATENCY_TICKS));
+	APP_TEST_CHECK(AppMqttPublishWindow_IsFull(&window));
+
+	// the first two are acknowledged, then the connection closes
+	APP_TEST_CHECK(0 == test_Service(&window, &broker, 1 + TEST_LATENCY_TICKS));
+	test_Disconnect(&window);
+
+	for(uint32_t packetId = 1; packetId <= APP_MQTT_PUBLISH_WINDOW_MAX_SIZE; packetId++) {
+		bool isAcknowledged = (packetId <= 2);
+		APP_TEST_CHECK_MSG((isAcknowledged ? 1u : 0u) == test_Outcomes[packetId].numberOfAcks && (isAcknowledged ? 0u : 1u) == test_Outcomes[packetId].numberOfFailures,
+				"packet id %u: %u acks, %u failures", (unsigned) packetId, (unsigned) test_Outcomes[packetId].numberOfAcks, (unsigned) test_Outcomes[packetId].numberOfFailures);
+	}
+}
+
+int main(void) {
+
+	APP_TEST_RUN(test_Basic);
+	APP_TEST_RUN(test_Throughput);
+	APP_TEST_RUN(test_LateAck);
+	APP_TEST_RUN(test_AllLate);
+	APP_TEST_RUN(test_BrokerStopsResponding);
+	APP_TEST_RUN(test_DisconnectInFlight);
+
+	return APP_TEST_RESULT();
+}
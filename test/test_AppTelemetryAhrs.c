@@ -0,0 +1,404 @@
+/*
+ * test_AppTelemetryAhrs.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host unit test of @ref AppTelemetryAhrs: the fixed-point filter against a double-precision filter of the same equations on a synthetic trace,
+* the convergence to the true orientation, the gyroscope integration and the CORDIC Euler angles.
+* @file
+*/
+
+#include "AppTest.h"
+#include "AppTelemetryAhrs.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define TEST_PI						3.14159265358979323846 /**< M_PI is not declared in strict C99 */
+#define TEST_RAD_TO_DEG				(180.0 / TEST_PI) /**< radians to degrees */
+#define TEST_PERIOD_MILLIS			UINT32_C(10) /**< sampling period of the traces */
+#define TEST_TRACE_MILLIS			UINT32_C(60000) /**< length of the synthetic trace */
+#define TEST_SUB_STEPS				UINT32_C(10) /**< integration steps of the true orientation per sample */
+#define TEST_MAX_ROTATION_ERROR_DEG	0.02 /**< max rotation between the fixed-point and the double-precision filter, documented in @ref AppTelemetryAhrs */
+#define TEST_MAX_EULER_ERROR_DEG	0.05 /**< max difference of the Euler angles to the double-precision filter, away from the gimbal lock */
+#define TEST_MAX_EULER_PITCH_DEG	80.0 /**< max pitch at which the Euler angles are compared, roll and yaw are ill-conditioned towards +-90 */
+#define TEST_TRACE_SAMPLES			(TEST_TRACE_MILLIS / TEST_PERIOD_MILLIS) /**< number of samples of the synthetic trace */
+#define TEST_TIMING_PASSES			UINT32_C(20) /**< passes over the trace samples of a timing */
+
+static const double test_EarthField[3] = { 20.0, 0.0, -40.0 }; /**< earth magnetic field in micro tesla, north on x, z up */
+
+/**
+ * @brief Double-precision Mahony filter with the same gains and the same equations as AppTelemetryAhrs_Update().
+ */
+typedef struct {
+	double q[4]; /**< the quaternion */
+	double integralFeedback[3]; /**< the integral of the error */
+	uint32_t elapsedMillis; /**< time since the reset */
+} test_Reference_T;
+
+/**
+ * @brief A sample of the sensors in their units.
+ */
+typedef struct {
+	int32_t accel[3]; /**< milli g */
+	int32_t gyro[3]; /**< milli degrees per second */
+	int32_t mag[3]; /**< micro tesla */
+} test_Sample_T;
+
+static test_Sample_T test_TraceSamples[TEST_TRACE_SAMPLES]; /**< the samples of the synthetic trace, see test_Trace() */
+
+/**
+ * @brief Resets the reference filter to the identity orientation.
+ */
+static void test_ResetReference(test_Reference_T * refPtr) {
+	memset(refPtr, 0, sizeof(test_Reference_T));
+	refPtr->q[0] = 1.0;
+}
+
+/**
+ * @brief Updates the reference filter with a sample, same equations as AppTelemetryAhrs_Update().
+ */
+static void test_UpdateReference(test_Reference_T * refPtr, const test_Sample_T * samplePtr, uint32_t periodMillis) {
+
+	double * q = refPtr->q;
+	double dt = periodMillis / 1000.0;
+	double g[3];
+	for(uint32_t i = 0; i < 3; i++) g[i] = samplePtr->gyro[i] / 1000.0 / TEST_RAD_TO_DEG;
+
+	double a[3] = { samplePtr->accel[0], samplePtr->accel[1], samplePtr->accel[2] };
+	double aNorm = sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+	if(aNorm > 0) {
+		for(uint32_t i = 0; i < 3; i++) a[i] /= aNorm;
+		double halfV[3] = { q[1] * q[3] - q[0] * q[2], q[0] * q[1] + q[2] * q[3], q[0] * q[0] - 0.5 + q[3] * q[3] };
+		double halfE[3] = { a[1] * halfV[2] - a[2] * halfV[1], a[2] * halfV[0] - a[0] * halfV[2], a[0] * halfV[1] - a[1] * halfV[0] };
+
+		double m[3] = { samplePtr->mag[0], samplePtr->mag[1], samplePtr->mag[2] };
+		double mNorm = sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+		if(mNorm > 0) {
+			for(uint32_t i = 0; i < 3; i++) m[i] /= mNorm;
+			double hx = 2 * (m[0] * (0.5 - q[2] * q[2] - q[3] * q[3]) + m[1] * (q[1] * q[2] - q[0] * q[3]) + m[2] * (q[1] * q[3] + q[0] * q[2]));
+			double hy = 2 * (m[0] * (q[1] * q[2] + q[0] * q[3]) + m[1] * (0.5 - q[1] * q[1] - q[3] * q[3]) + m[2] * (q[2] * q[3] - q[0] * q[1]));
+			double bx = sqrt(hx * hx + hy * hy);
+			double bz = 2 * (m[0] * (q[1] * q[3] - q[0] * q[2]) + m[1] * (q[2] * q[3] + q[0] * q[1]) + m[2] * (0.5 - q[1] * q[1] - q[2] * q[2]));
+			double halfW[3] = {
+				bx * (0.5 - q[2] * q[2] - q[3] * q[3]) + bz * (q[1] * q[3] - q[0] * q[2]),
+				bx * (q[1] * q[2] - q[0] * q[3]) + bz * (q[0] * q[1] + q[2] * q[3]),
+				bx * (q[0] * q[2] + q[1] * q[3]) + bz * (0.5 - q[1] * q[1] - q[2] * q[2])
+			};
+			halfE[0] += m[1] * halfW[2] - m[2] * halfW[1];
+			halfE[1] += m[2] * halfW[0] - m[0] * halfW[2];
+			halfE[2] += m[0] * halfW[1] - m[1] * halfW[0];
+		}
+		double twoKp = APP_TELEMETRY_AHRS_TWO_KP_THOUSANDTHS / 1000.0;
+		if(refPtr->elapsedMillis < APP_TELEMETRY_AHRS_CONVERGE_MILLIS) twoKp *= 10.0;
+		for(uint32_t i = 0; i < 3; i++) {
+			if(APP_TELEMETRY_AHRS_TWO_KI_THOUSANDTHS > 0) {
+				refPtr->integralFeedback[i] += APP_TELEMETRY_AHRS_TWO_KI_THOUSANDTHS / 1000.0 * halfE[i] * dt;
+				g[i] += refPtr->integralFeedback[i];
+			}
+			g[i] += twoKp * halfE[i];
+		}
+	}
+	if(refPtr->elapsedMillis < APP_TELEMETRY_AHRS_CONVERGE_MILLIS) refPtr->elapsedMillis += periodMillis;
+
+	for(uint32_t i = 0; i < 3; i++) {
+		g[i] *= 0.5 * dt;
+		if(g[i] > 0.25) g[i] = 0.25;
+		else if(g[i] < -0.25) g[i] = -0.25;
+	}
+	double q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+	q[0] += -q1 * g[0] - q2 * g[1] - q3 * g[2];
+	q[1] += q0 * g[0] + q2 * g[2] - q3 * g[1];
+	q[2] += q0 * g[1] - q1 * g[2] + q3 * g[0];
+	q[3] += q0 * g[2] + q1 * g[1] - q2 * g[0];
+	double norm = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+	for(uint32_t i = 0; i < 4; i++) q[i] /= norm;
+}
+
+/**
+ * @brief Euler angles of a quaternion in degrees, aerospace sequence z-y-x.
+ */
+static void test_GetEulerAngles(const double q[4], double eulerDeg[3]) {
+	eulerDeg[0] = atan2(q[0] * q[1] + q[2] * q[3], 0.5 - q[1] * q[1] - q[2] * q[2]) * TEST_RAD_TO_DEG;
+	eulerDeg[1] = asin(fmax(-1.0, fmin(1.0, 2 * (q[0] * q[2] - q[1] * q[3])))) * TEST_RAD_TO_DEG;
+	eulerDeg[2] = atan2(q[0] * q[3] + q[1] * q[2], 0.5 - q[2] * q[2] - q[3] * q[3]) * TEST_RAD_TO_DEG;
+}
+
+/**
+ * @brief Quaternion of Euler angles in degrees, aerospace sequence z-y-x.
+ */
+static void test_SetEulerAngles(double q[4], double rollDeg, double pitchDeg, double yawDeg) {
+	double cr = cos(rollDeg / TEST_RAD_TO_DEG / 2), sr = sin(rollDeg / TEST_RAD_TO_DEG / 2);
+	double cp = cos(pitchDeg / TEST_RAD_TO_DEG / 2), sp = sin(pitchDeg / TEST_RAD_TO_DEG / 2);
+	double cy = cos(yawDeg / TEST_RAD_TO_DEG / 2), sy = sin(yawDeg / TEST_RAD_TO_DEG / 2);
+	q[0] = cr * cp * cy + sr * sp * sy;
+	q[1] = sr * cp * cy - cr * sp * sy;
+	q[2] = cr * sp * cy + sr * cp * sy;
+	q[3] = cr * cp * sy - sr * sp * cy;
+}
+
+/**
+ * @brief Returns the rotation in degrees between two unit quaternions.
+ */
+static double test_GetRotationDeg(const double a[4], const double b[4]) {
+	double dot = 0;
+	for(uint32_t i = 0; i < 4; i++) dot += a[i] * b[i];
+	return 2.0 * acos(fmin(1.0, fabs(dot))) * TEST_RAD_TO_DEG;
+}
+
+/**
+ * @brief Returns the difference of two angles in degrees, wrapped to [-180, 180].
+ */
+static double test_GetAngleDifference(double a, double b) {
+	return fmod(a - b + 540.0, 360.0) - 180.0;
+}
+
+/**
+ * @brief The Q30 quaternion of the fixed-point filter as doubles.
+ */
+static void test_GetQuaternion(const AppTelemetryAhrs_T * ahrsPtr, double q[4]) {
+	for(uint32_t i = 0; i < 4; i++) q[i] = ahrsPtr->quaternion[i] / (double) APP_TELEMETRY_AHRS_Q30_ONE;
+}
+
+/**
+ * @brief The sensor samples of a true orientation, sensor to earth frame, and body rates in rad/s: gravity and the earth field in the sensor frame.
+ */
+static void test_GetSample(const double q[4], const double ratesRad[3], test_Sample_T * samplePtr) {
+
+	// rows of the rotation from the sensor to the earth frame, the earth vectors in the sensor frame are its transpose applied
+	double r[3][3] = {
+		{ 1 - 2 * (q[2] * q[2] + q[3] * q[3]), 2 * (q[1] * q[2] - q[0] * q[3]), 2 * (q[1] * q[3] + q[0] * q[2]) },
+		{ 2 * (q[1] * q[2] + q[0] * q[3]), 1 - 2 * (q[1] * q[1] + q[3] * q[3]), 2 * (q[2] * q[3] - q[0] * q[1]) },
+		{ 2 * (q[1] * q[3] - q[0] * q[2]), 2 * (q[2] * q[3] + q[0] * q[1]), 1 - 2 * (q[1] * q[1] + q[2] * q[2]) }
+	};
+	for(uint32_t i = 0; i < 3; i++) {
+		samplePtr->accel[i] = (int32_t) lround(1000.0 * r[2][i]);
+		samplePtr->mag[i] = (int32_t) lround(r[0][i] * test_EarthField[0] + r[1][i] * test_EarthField[1] + r[2][i] * test_EarthField[2]);
+		samplePtr->gyro[i] = (int32_t) lround(ratesRad[i] * TEST_RAD_TO_DEG * 1000.0);
+	}
+}
+
+/**
+ * @brief Rotates a quaternion by body rates in rad/s over a time: q * exp(rates dt / 2).
+ */
+static void test_Rotate(double q[4], const double ratesRad[3], double dt) {
+
+	double angle = sqrt(ratesRad[0] * ratesRad[0] + ratesRad[1] * ratesRad[1] + ratesRad[2] * ratesRad[2]) * dt;
+	if(0 == angle) return;
+	double s = sin(angle / 2) / (angle / dt);
+	double r[4] = { cos(angle / 2), ratesRad[0] * s, ratesRad[1] * s, ratesRad[2] * s };
+	double p[4] = {
+		q[0] * r[0] - q[1] * r[1] - q[2] * r[2] - q[3] * r[3],
+		q[0] * r[1] + q[1] * r[0] + q[2] * r[3] - q[3] * r[2],
+		q[0] * r[2] - q[1] * r[3] + q[2] * r[0] + q[3] * r[1],
+		q[0] * r[3] + q[1] * r[2] - q[2] * r[1] + q[3] * r[0]
+	};
+	memcpy(q, p, sizeof(p));
+}
+
+/**
+ * @brief The identity after a reset, the CORDIC Euler angles of known orientations.
+ */
+static void test_EulerAngles(void) {
+
+	static const double angles[][3] = { { 0, 0, 0 }, { 30, -20, 45 }, { -170, 60, -100 }, { 179.9, -89.0, 179.9 }, { 5, 10, -179.9 } };
+
+	AppTelemetryAhrs_T ahrs;
+	int32_t eulerMilliDeg[3];
+
+	AppTelemetryAhrs_Reset(&ahrs);
+	AppTelemetryAhrs_GetEulerAngles(&ahrs, eulerMilliDeg);
+	for(uint32_t i = 0; i < 3; i++) APP_TEST_CHECK(0 == eulerMilliDeg[i]);
+
+	for(uint32_t n = 0; n < sizeof(angles) / sizeof(angles[0]); n++) {
+		double q[4];
+		test_SetEulerAngles(q, angles[n][0], angles[n][1], angles[n][2]);
+		for(uint32_t i = 0; i < 4; i++) ahrs.quaternion[i] = (int32_t) lround(q[i] * APP_TELEMETRY_AHRS_Q30_ONE);
+		AppTelemetryAhrs_GetEulerAngles(&ahrs, eulerMilliDeg);
+		for(uint32_t i = 0; i < 3; i++) {
+			double error = fabs(test_GetAngleDifference(eulerMilliDeg[i] / 1000.0, angles[n][i]));
+			APP_TEST_CHECK_MSG(error <= 0.002, "angles:%u, axis:%u, euler:%d, expected:%.3f", n, i, eulerMilliDeg[i], angles[n][i]);
+		}
+	}
+}
+
+/**
+ * @brief Without accelerometer samples the gyroscope rates are integrated: 90 deg/s about z for 1 s, then -45 deg/s about x for 2 s.
+ */
+static void test_GyroIntegration(void) {
+
+	static const int32_t zero[3] = { 0, 0, 0 };
+	static const int32_t yawRate[3] = { 0, 0, 90000 };
+	static const int32_t rollRate[3] = { -45000, 0, 0 };
+
+	AppTelemetryAhrs_T ahrs;
+	int32_t eulerMilliDeg[3];
+
+	AppTelemetryAhrs_Reset(&ahrs);
+	for(uint32_t n = 0; n < 1000 / TEST_PERIOD_MILLIS; n++) AppTelemetryAhrs_Update(&ahrs, zero, yawRate, NULL, TEST_PERIOD_MILLIS);
+	AppTelemetryAhrs_GetEulerAngles(&ahrs, eulerMilliDeg);
+	APP_TEST_CHECK_MSG(abs(eulerMilliDeg[2] - 90000) <= 100, "yaw:%d", eulerMilliDeg[2]);
+	APP_TEST_CHECK(abs(eulerMilliDeg[0]) <= 10 && abs(eulerMilliDeg[1]) <= 10);
+
+	for(uint32_t n = 0; n < 2000 / TEST_PERIOD_MILLIS; n++) AppTelemetryAhrs_Update(&ahrs, zero, rollRate, zero, TEST_PERIOD_MILLIS);
+	AppTelemetryAhrs_GetEulerAngles(&ahrs, eulerMilliDeg);
+	APP_TEST_CHECK_MSG(abs(eulerMilliDeg[0] + 90000) <= 100, "roll:%d", eulerMilliDeg[0]);
+	APP_TEST_CHECK_MSG(abs(eulerMilliDeg[2] - 90000) <= 100, "yaw:%d", eulerMilliDeg[2]);
+}
+
+/**
+ * @brief Returns the angle in degrees between the directions of gravity of two orientations, the error of roll and pitch.
+ */
+static double test_GetTiltDeg(const double a[4], const double b[4]) {
+	double va[3] = { 2 * (a[1] * a[3] - a[0] * a[2]), 2 * (a[0] * a[1] + a[2] * a[3]), 1 - 2 * (a[1] * a[1] + a[2] * a[2]) };
+	double vb[3] = { 2 * (b[1] * b[3] - b[0] * b[2]), 2 * (b[0] * b[1] + b[2] * b[3]), 1 - 2 * (b[1] * b[1] + b[2] * b[2]) };
+	return acos(fmin(1.0, va[0] * vb[0] + va[1] * vb[1] + va[2] * vb[2])) * TEST_RAD_TO_DEG;
+}
+
+/**
+ * @brief A static tilted and turned sensor: roll and pitch converge within the converge time from gravity, the yaw slowly from the earth field.
+ */
+static void test_Convergence(void) {
+
+	double q[4];
+	static const double rates[3] = { 0, 0, 0 };
+	test_SetEulerAngles(q, 25.0, -15.0, 60.0);
+	test_Sample_T sample;
+	test_GetSample(q, rates, &sample);
+
+	AppTelemetryAhrs_T ahrs;
+	double estimate[4];
+
+	// gravity only: roll and pitch converge, the yaw stays
+	AppTelemetryAhrs_Reset(&ahrs);
+	for(uint32_t n = 0; n < APP_TELEMETRY_AHRS_CONVERGE_MILLIS / TEST_PERIOD_MILLIS; n++) AppTelemetryAhrs_Update(&ahrs, sample.accel, sample.gyro, NULL, TEST_PERIOD_MILLIS);
+	test_GetQuaternion(&ahrs, estimate);
+	double tiltDeg = test_GetTiltDeg(estimate, q);
+	printf("  static, gravity only: tilt error after %u ms:%.3f deg\n", APP_TELEMETRY_AHRS_CONVERGE_MILLIS, tiltDeg);
+	APP_TEST_CHECK_MSG(tiltDeg <= 0.5, "tilt error:%.3f deg", tiltDeg);
+
+	// with the earth field
+	AppTelemetryAhrs_Reset(&ahrs);
+	for(uint32_t millis = 0; millis < TEST_TRACE_MILLIS; millis += TEST_PERIOD_MILLIS) AppTelemetryAhrs_Update(&ahrs, sample.accel, sample.gyro, sample.mag, TEST_PERIOD_MILLIS);
+	test_GetQuaternion(&ahrs, estimate);
+	double rotationDeg = test_GetRotationDeg(estimate, q);
+	printf("  static: rotation error after %u ms:%.3f deg\n", TEST_TRACE_MILLIS, rotationDeg);
+	APP_TEST_CHECK_MSG(rotationDeg <= 2.0, "rotation error:%.3f deg", rotationDeg);
+}
+
+/**
+ * @brief A synthetic 60 s trace of a sensor turning about all axes: the fixed-point filter against the double-precision filter of the same samples
+ * after the converge time, and the tilt against the true orientation.
+ */
+static void test_Trace(void) {
+
+	double q[4];
+	test_SetEulerAngles(q, 10.0, 5.0, 0.0);
+
+	AppTelemetryAhrs_T ahrs;
+	test_Reference_T reference;
+	AppTelemetryAhrs_Reset(&ahrs);
+	test_ResetReference(&reference);
+
+	double maxEulerError = 0;
+	double maxRotationError = 0;
+	double maxTiltError = 0;
+
+	for(uint32_t millis = 0; millis < TEST_TRACE_MILLIS; millis += TEST_PERIOD_MILLIS) {
+
+		double t = millis / 1000.0;
+		// slow sines on every axis, up to 60 deg/s
+		double rates[3] = { 0.3 * sin(2 * TEST_PI * 0.13 * t), 0.3 * sin(2 * TEST_PI * 0.07 * t + 1.0), 1.0 * sin(2 * TEST_PI * 0.05 * t + 2.0) };
+
+		test_Sample_T sample;
+		test_GetSample(q, rates, &sample);
+		test_TraceSamples[millis / TEST_PERIOD_MILLIS] = sample;
+		AppTelemetryAhrs_Update(&ahrs, sample.accel, sample.gyro, sample.mag, TEST_PERIOD_MILLIS);
+		test_UpdateReference(&reference, &sample, TEST_PERIOD_MILLIS);
+		for(uint32_t i = 0; i < TEST_SUB_STEPS; i++) test_Rotate(q, rates, TEST_PERIOD_MILLIS / 1000.0 / TEST_SUB_STEPS);
+
+		if(millis < APP_TELEMETRY_AHRS_CONVERGE_MILLIS) continue;
+
+		double estimate[4];
+		test_GetQuaternion(&ahrs, estimate);
+		double rotationDeg = test_GetRotationDeg(estimate, reference.q);
+		if(rotationDeg > maxRotationError) maxRotationError = rotationDeg;
+		double tiltDeg = test_GetTiltDeg(estimate, q);
+		if(tiltDeg > maxTiltError) maxTiltError = tiltDeg;
+
+		int32_t eulerMilliDeg[3];
+		double referenceEulerDeg[3];
+		AppTelemetryAhrs_GetEulerAngles(&ahrs, eulerMilliDeg);
+		test_GetEulerAngles(reference.q, referenceEulerDeg);
+		if(fabs(referenceEulerDeg[1]) > TEST_MAX_EULER_PITCH_DEG) continue;
+		for(uint32_t i = 0; i < 3; i++) {
+			double error = fabs(test_GetAngleDifference(eulerMilliDeg[i] / 1000.0, referenceEulerDeg[i]));
+			if(error > maxEulerError) maxEulerError = error;
+		}
+	}
+
+	printf("  trace: max rotation error:%.4f deg, max euler error:%.4f deg, max tilt error to the true orientation:%.3f deg\n",
+			maxRotationError, maxEulerError, maxTiltError);
+	APP_TEST_CHECK_MSG(maxRotationError <= TEST_MAX_ROTATION_ERROR_DEG, "max rotation error:%.4f deg", maxRotationError);
+	APP_TEST_CHECK_MSG(maxEulerError <= TEST_MAX_EULER_ERROR_DEG, "max euler error:%.4f deg", maxEulerError);
+	APP_TEST_CHECK_MSG(maxTiltError <= 1.0, "max tilt error:%.3f deg", maxTiltError);
+}
+
+/**
+ * @brief Host time per update of the fixed-point filter over the samples of the synthetic trace, with and without the magnetometer,
+ * against the double-precision reference. Prints the timings. Runs after test_Trace().
+ * @details The host has a double-precision FPU, the Cortex-M3 of the XDK has none, so only the fixed-point figures carry over, scaled by the clock.
+ */
+static void test_UpdateRate(void) {
+
+	AppTelemetryAhrs_T ahrs;
+	test_Reference_T reference;
+	const double numberOfUpdates = (double) TEST_TRACE_SAMPLES * TEST_TIMING_PASSES;
+
+	for(uint32_t withMag = 0; withMag <= 1; withMag++) {
+
+		AppTelemetryAhrs_Reset(&ahrs);
+		uint64_t startNanos = appTest_GetNanos();
+		uint64_t startCycles = appTest_GetCycles();
+		for(uint32_t pass = 0; pass < TEST_TIMING_PASSES; pass++) {
+			for(uint32_t n = 0; n < TEST_TRACE_SAMPLES; n++) {
+				const test_Sample_T * samplePtr = &test_TraceSamples[n];
+				AppTelemetryAhrs_Update(&ahrs, samplePtr->accel, samplePtr->gyro, withMag ? samplePtr->mag : NULL, TEST_PERIOD_MILLIS);
+			}
+		}
+		double cyclesPerUpdate = (double) (appTest_GetCycles() - startCycles) / numberOfUpdates;
+		double nanosPerUpdate = (double) (appTest_GetNanos() - startNanos) / numberOfUpdates;
+
+		printf("  fixed-point update, %s: %.1f ns, %.0f " APP_TEST_CYCLES_UNIT " per sample, %.0f k samples per second\n",
+				withMag ? "accel, gyro and mag" : "accel and gyro", nanosPerUpdate, cyclesPerUpdate, 1e6 / nanosPerUpdate);
+	}
+
+	test_ResetReference(&reference);
+	uint64_t startNanos = appTest_GetNanos();
+	uint64_t startCycles = appTest_GetCycles();
+	for(uint32_t pass = 0; pass < TEST_TIMING_PASSES; pass++) {
+		for(uint32_t n = 0; n < TEST_TRACE_SAMPLES; n++) test_UpdateReference(&reference, &test_TraceSamples[n], TEST_PERIOD_MILLIS);
+	}
+	double cyclesPerUpdate = (double) (appTest_GetCycles() - startCycles) / numberOfUpdates;
+	double nanosPerUpdate = (double) (appTest_GetNanos() - startNanos) / numberOfUpdates;
+
+	printf("  double-precision reference, accel, gyro and mag: %.1f ns, %.0f " APP_TEST_CYCLES_UNIT " per sample\n", nanosPerUpdate, cyclesPerUpdate);
+
+	// uses the result of the reference updates
+	double norm = sqrt(reference.q[0] * reference.q[0] + reference.q[1] * reference.q[1] + reference.q[2] * reference.q[2] + reference.q[3] * reference.q[3]);
+	APP_TEST_CHECK_MSG(fabs(norm - 1.0) < 1e-9, "norm:%f", norm);
+}
+
+int main(void) {
+
+	APP_TEST_RUN(test_EulerAngles);
+	APP_TEST_RUN(test_GyroIntegration);
+	APP_TEST_RUN(test_Convergence);
+	APP_TEST_RUN(test_Trace);
+	APP_TEST_RUN(test_UpdateRate);
+
+	return APP_TEST_RESULT();
+}
@@ -0,0 +1,823 @@
+/*
+ * test_AppTelemetryPayload.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host unit test of the streaming batch encoders of @ref AppTelemetryPayload: the 'V1 JSON' payloads are compared with the expected strings,
+* the binary payloads are decoded and compared with the samples they were encoded from, the encoded sizes with the batch size tracking of the sampling task.
+* @details The decoders implement the formats as documented, independent of the encoder.
+* @details Compiled with the SDK stubs in stubs/ and the real @ref AppTimestamp, enabled at #TEST_SNTP_SECONDS at tick #TEST_ENABLE_TICK_COUNT.
+* @file
+*/
+
+#include "AppTest.h"
+#include "AppTelemetryPayload.h"
+#include "task.h"
+
+#include <string.h>
+
+#define TEST_DEVICE_ID				"xdk \"1\"" /**< a device id that needs escaping in JSON */
+#define TEST_DEVICE_ID_JSON			"\"xdk \\\"1\\\"\"" /**< #TEST_DEVICE_ID as JSON string */
+#define TEST_SNTP_SECONDS			UINT64_C(1700000000) /**< the SNTP time at enable, 2023-11-14T22:13:20Z */
+#define TEST_ENABLE_TICK_COUNT		((TickType_t) 1000) /**< the tick count at enable */
+#define TEST_NUMBER_OF_SAMPLES		UINT32_C(3) /**< number of samples of the test batch */
+#define TEST_BUFFER_SIZE			UINT32_C(32768) /**< size of the payload buffer */
+#define TEST_MAX_SAMPLES			UINT32_C(300) /**< number of samples of the long batch, the array heads of 'V2 CBOR' take 3 bytes */
+#define TEST_NUMBER_OF_CHANNELS		UINT32_C(13) /**< humidity, light, temperature, accelerometer x, y, z, gyroscope x, y, z, magnetometer r, x, y, z */
+#define TEST_SELECTED_CHANNELS		UINT32_C(0x003D) /**< bit per channel of the test configuration: humidity, temperature and accelerometer */
+#define TEST_ALL_CHANNELS			UINT32_C(0x1FFF) /**< bit per channel of all sensors */
+#define TEST_TIMING_SAMPLES			UINT32_C(100) /**< number of samples of the long batch the encode time is measured with, fits into the buffer in every format */
+#define TEST_TIMING_MIN_NANOS		UINT64_C(50000000) /**< minimum duration of a timing */
+
+/**
+ * @brief The test batch: humidity, temperature and accelerometer selected, the humidity of the second sample not read,
+ * the extreme values of the accelerometer and an irregular sampling interval. The JSON formats send the temperature in degrees, the binary formats in milli degrees.
+ */
+static const AppTelemetryPayload_Sample_T test_Samples[TEST_NUMBER_OF_SAMPLES] = {
+	{ .tickCount = 1100, .humidity = 45, .light = 1000, .temperature = -12000, .accel = { 12, -980, INT32_MIN }, .gyro = { 1, 2, 3 }, .mag = { 4, 5, 6, 7 },
+			.suppressedChannels = 0, .presentSensors = APP_TELEMETRY_PAYLOAD_SENSOR_ALL },
+	{ .tickCount = 1350, .humidity = 45, .light = 1000, .temperature = -1500, .accel = { 0, 1, INT32_MAX }, .gyro = { 1, 2, 3 }, .mag = { 4, 5, 6, 7 },
+			.suppressedChannels = 0, .presentSensors = APP_TELEMETRY_PAYLOAD_SENSOR_ALL & ~APP_TELEMETRY_PAYLOAD_SENSOR_HUMIDITY },
+	{ .tickCount = 1400, .humidity = 46, .light = 1000, .temperature = 20000, .accel = { -1, 0, 1000 }, .gyro = { 1, 2, 3 }, .mag = { 4, 5, 6, 7 },
+			.suppressedChannels = 0, .presentSensors = APP_TELEMETRY_PAYLOAD_SENSOR_ALL },
+};
+
+static AppTelemetryPayload_Sample_T test_LongSamples[TEST_MAX_SAMPLES]; /**< the long batch, see test_InitLongSamples() */
+
+static AppTelemetryPayload_Sample_T test_StableSamples[TEST_TIMING_SAMPLES]; /**< a device at rest, see test_InitStableSamples() */
+
+static char test_Buffer[TEST_BUFFER_SIZE]; /**< the payload buffer */
+
+/**
+ * @brief A decoded batch of a 'V2' format.
+ */
+typedef struct {
+	char deviceId[32]; /**< the device id */
+	bool isTimestamp; /**< true if the batch has a timestamp */
+	uint64_t millisSinceEpoch; /**< the timestamp of the first sample */
+	uint32_t numberOfSamples; /**< number of samples */
+	int64_t offsetsMillis[TEST_MAX_SAMPLES]; /**< the offsets of the samples to the first one */
+	bool isChannel[TEST_NUMBER_OF_CHANNELS]; /**< true if the channel is in the batch */
+	bool isNull[TEST_NUMBER_OF_CHANNELS][TEST_MAX_SAMPLES]; /**< true if the value was sent as null */
+	int64_t values[TEST_NUMBER_OF_CHANNELS][TEST_MAX_SAMPLES]; /**< the values per channel */
+} test_Batch_T;
+
+static test_Batch_T test_DecodedBatch; /**< the decoded batch */
+
+/**
+ * @brief Fill the long batch with a random walk per channel, irregular intervals and sensors missing in some samples.
+ */
+static void test_InitLongSamples(void) {
+
+	uint32_t random = 12345;
+	int32_t values[TEST_NUMBER_OF_CHANNELS] = { 40, 500000, 21000, 0, 0, 1000, 0, 0, 0, 300, 10, -20, 40 };
+	TickType_t tickCount = 2000;
+
+	for(uint32_t i = 0; i < TEST_MAX_SAMPLES; i++) {
+
+		for(uint32_t c = 0; c < TEST_NUMBER_OF_CHANNELS; c++) {
+			random = random * 1103515245 + 12345;
+			// mostly small steps, a few large ones
+			int32_t step = (int32_t) ((random >> 16) % 201) - 100;
+			if(0 == (random >> 8) % 50) step *= 100000;
+			values[c] += step;
+		}
+		if(values[0] < 0) values[0] = -values[0];
+		if(values[1] < 0) values[1] = -values[1];
+
+		AppTelemetryPayload_Sample_T * samplePtr = &test_LongSamples[i];
+		samplePtr->tickCount = tickCount;
+		samplePtr->humidity = (uint32_t) values[0];
+		samplePtr->light = (uint32_t) values[1];
+		samplePtr->temperature = values[2];
+		for(uint32_t axis = 0; axis < 3; axis++) {
+			samplePtr->accel[axis] = values[3 + axis];
+			samplePtr->gyro[axis] = values[6 + axis];
+		}
+		for(uint32_t axis = 0; axis < 4; axis++) samplePtr->mag[axis] = values[9 + axis];
+		samplePtr->suppressedChannels = 0;
+		samplePtr->presentSensors = APP_TELEMETRY_PAYLOAD_SENSOR_ALL;
+		if(i % 7 == 3) samplePtr->presentSensors &= (uint8_t) ~APP_TELEMETRY_PAYLOAD_SENSOR_HUMIDITY;
+		if(i % 5 == 1) samplePtr->presentSensors &= (uint8_t) ~APP_TELEMETRY_PAYLOAD_SENSOR_MAG;
+
+		random = random * 1103515245 + 12345;
+		tickCount += 10 + ((random >> 16) % 3) * 5;
+	}
+}
+
+/**
+ * @brief Fill the stable batch: a device at rest sampled every 10 ms, the values of the example in the external interface docs
+ * with the sensor noise of a resting XDK, a few milli g, about 60 milli degrees per second of the gyroscope, 1 microtesla of the magnetometer.
+ */
+static void test_InitStableSamples(void) {
+
+	uint32_t random = 54321;
+
+	for(uint32_t i = 0; i < TEST_TIMING_SAMPLES; i++) {
+
+		int32_t noise[7];
+		for(uint32_t n = 0; n < 7; n++) {
+			random = random * 1103515245 + 12345;
+			noise[n] = (int32_t) ((random >> 16) % 7) - 3;
+		}
+
+		AppTelemetryPayload_Sample_T * samplePtr = &test_StableSamples[i];
+		memset(samplePtr, 0, sizeof(*samplePtr));
+		samplePtr->tickCount = (TickType_t) (2000 + i * 10);
+		samplePtr->humidity = 48;
+		samplePtr->light = 100800;
+		samplePtr->temperature = 20211 + ((i < TEST_TIMING_SAMPLES / 2) ? 0 : 10);
+		samplePtr->accel[0] = -4 + noise[0];
+		samplePtr->accel[1] = 1 + noise[1];
+		samplePtr->accel[2] = 986 + noise[2];
+		samplePtr->gyro[0] = 854 + 20 * noise[3];
+		samplePtr->gyro[1] = -610 + 20 * noise[4];
+		samplePtr->gyro[2] = -5612 + 20 * noise[5];
+		samplePtr->mag[0] = 6299;
+		samplePtr->mag[1] = -42 + noise[6] / 3;
+		samplePtr->mag[2] = -29;
+		samplePtr->mag[3] = -40;
+		samplePtr->presentSensors = APP_TELEMETRY_PAYLOAD_SENSOR_ALL;
+	}
+}
+
+/**
+ * @brief Returns the value of a channel of a sample as sent by the binary formats, the temperature in milli degrees.
+ */
+static int64_t test_GetChannelValue(const AppTelemetryPayload_Sample_T * samplePtr, uint32_t channel) {
+
+	switch(channel) {
+	case 0: return samplePtr->humidity;
+	case 1: return samplePtr->light;
+	case 2: return samplePtr->temperature;
+	case 3: case 4: case 5: return samplePtr->accel[channel - 3];
+	case 6: case 7: case 8: return samplePtr->gyro[channel - 6];
+	default: return samplePtr->mag[channel - 9];
+	}
+}
+
+/**
+ * @brief Returns true if the sensor of a channel was read for a sample.
+ */
+static bool test_IsChannelPresent(const AppTelemetryPayload_Sample_T * samplePtr, uint32_t channel) {
+
+	static const uint8_t sensors[TEST_NUMBER_OF_CHANNELS] = {
+		APP_TELEMETRY_PAYLOAD_SENSOR_HUMIDITY, APP_TELEMETRY_PAYLOAD_SENSOR_LIGHT, APP_TELEMETRY_PAYLOAD_SENSOR_TEMPERATURE,
+		APP_TELEMETRY_PAYLOAD_SENSOR_ACCEL, APP_TELEMETRY_PAYLOAD_SENSOR_ACCEL, APP_TELEMETRY_PAYLOAD_SENSOR_ACCEL,
+		APP_TELEMETRY_PAYLOAD_SENSOR_GYRO, APP_TELEMETRY_PAYLOAD_SENSOR_GYRO, APP_TELEMETRY_PAYLOAD_SENSOR_GYRO,
+		APP_TELEMETRY_PAYLOAD_SENSOR_MAG, APP_TELEMETRY_PAYLOAD_SENSOR_MAG, APP_TELEMETRY_PAYLOAD_SENSOR_MAG, APP_TELEMETRY_PAYLOAD_SENSOR_MAG
+	};
+	return (0 != (samplePtr->presentSensors & sensors[channel]));
+}
+
+/**
+ * @brief Compare the decoded batch with the samples it was encoded from.
+ * @param[in] samplesPtr: the samples
+ * @param[in] numberOfSamples: the number of samples
+ * @param[in] selectedChannels: bit per channel selected in the configuration
+ * @param[in] millisSinceEpoch: the expected timestamp of the first sample, 0 if the batch has none
+ * @param[in] isNullOmitted: true if the format sends an omitted value as null, else as its record value
+ */
+static void test_CheckDecodedBatch(const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples, uint32_t selectedChannels, uint64_t millisSinceEpoch, bool isNullOmitted) {
+
+	const test_Batch_T * batchPtr = &test_DecodedBatch;
+
+	APP_TEST_CHECK_MSG(0 == strcmp(TEST_DEVICE_ID, batchPtr->deviceId), "%s", batchPtr->deviceId);
+	APP_TEST_CHECK((0 != millisSinceEpoch) == batchPtr->isTimestamp);
+	APP_TEST_CHECK_MSG(!batchPtr->isTimestamp || millisSinceEpoch == batchPtr->millisSinceEpoch, "%lu", (unsigned long) batchPtr->millisSinceEpoch);
+	APP_TEST_CHECK_MSG(numberOfSamples == batchPtr->numberOfSamples, "%u", batchPtr->numberOfSamples);
+	if(numberOfSamples != batchPtr->numberOfSamples) return;
+
+	uint32_t numberOfMismatches = 0;
+	for(uint32_t i = 0; i < numberOfSamples; i++) {
+		if((int64_t) (samplesPtr[i].tickCount - samplesPtr[0].tickCount) != batchPtr->offsetsMillis[i]) numberOfMismatches++;
+	}
+	for(uint32_t c = 0; c < TEST_NUMBER_OF_CHANNELS; c++) {
+		bool isSelected = (0 != (selectedChannels & (UINT32_C(1) << c)));
+		APP_TEST_CHECK_MSG(isSelected == batchPtr->isChannel[c], "channel:%u", c);
+		if(!isSelected || !batchPtr->isChannel[c]) continue;
+
+		for(uint32_t i = 0; i < numberOfSamples; i++) {
+			bool isNull = isNullOmitted && !test_IsChannelPresent(&samplesPtr[i], c);
+			if(isNull != batchPtr->isNull[c][i]) numberOfMismatches++;
+			else if(!isNull && test_GetChannelValue(&samplesPtr[i], c) != batchPtr->values[c][i]) numberOfMismatches++;
+		}
+	}
+	APP_TEST_CHECK_MSG(0 == numberOfMismatches, "mismatches:%u", numberOfMismatches);
+}
+
+/**
+ * @brief Configure the payload module with all sensors selected and a format.
+ */
+static void test_ConfigureAllSensors(AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat) {
+
+	AppRuntimeConfig_TelemetryConfig_T config;
+	memset(&config, 0, sizeof(config));
+
+	config.received.payloadFormat = payloadFormat;
+	config.received.sensors.isHumidity = true;
+	config.received.sensors.isLight = true;
+	config.received.sensors.isTemperature = true;
+	config.received.sensors.isAccelerator = true;
+	config.received.sensors.isGyro = true;
+	config.received.sensors.isMagneto = true;
+
+	APP_TEST_CHECK(RETCODE_OK == AppTelemetryPayload_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, &config));
+}
+
+/**
+ * @brief Configure the payload module with the test sensors and a format.
+ */
+static void test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat, AppRuntimeConfig_Telemetry_TimestampFormat_T timestampFormat) {
+
+	AppRuntimeConfig_TelemetryConfig_T config;
+	memset(&config, 0, sizeof(config));
+
+	config.received.payloadFormat = payloadFormat;
+	config.received.payloadTimestampFormat = timestampFormat;
+	config.received.sensors.isHumidity = true;
+	config.received.sensors.isTemperature = true;
+	config.received.sensors.isAccelerator = true;
+
+	APP_TEST_CHECK(RETCODE_OK == AppTelemetryPayload_ApplyNewRuntimeConfig(AppRuntimeConfig_Element_targetTelemetryConfig, &config));
+}
+
+/**
+ * @brief Returns the size of the test batch from the batch size tracking of the sampling task.
+ */
+static uint32_t test_GetBatchSize(const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples) {
+
+	AppTelemetryPayload_BatchSize_T batchSize;
+	AppTelemetryPayload_ResetBatchSize(&batchSize);
+
+	for(uint32_t i = 0; i < numberOfSamples; i++) {
+		AppTelemetryPayload_AddSampleToBatchSize(&batchSize, &samplesPtr[i], AppTelemetryPayload_GetBatchSizeWithSample(&batchSize, &samplesPtr[i]));
+	}
+	return batchSize.size;
+}
+
+/**
+ * @brief Encode a batch, check the result and that the size tracking of the sampling task is an upper bound.
+ * @return uint32_t: the length of the payload, 0 on error
+ */
+static uint32_t test_EncodeSamples(const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples, uint64_t firstMillisSinceEpoch) {
+
+	uint32_t length = 0;
+	Retcode_T retcode = AppTelemetryPayload_EncodeBatchAt(samplesPtr, numberOfSamples, firstMillisSinceEpoch, test_Buffer, sizeof(test_Buffer), &length);
+
+	APP_TEST_CHECK_MSG(RETCODE_OK == retcode, "retcode:0x%08x", retcode);
+	if(RETCODE_OK != retcode) return 0;
+
+	uint32_t size = test_GetBatchSize(samplesPtr, numberOfSamples);
+	APP_TEST_CHECK_MSG(length <= size, "length:%u, tracked size:%u", length, size);
+
+	return length;
+}
+
+/**
+ * @brief Encode the test batch, see test_EncodeSamples().
+ */
+static uint32_t test_Encode(uint64_t firstMillisSinceEpoch) {
+	return test_EncodeSamples(test_Samples, TEST_NUMBER_OF_SAMPLES, firstMillisSinceEpoch);
+}
+
+/**
+ * @brief Encode the test batch into every buffer size below its length: the encoder reports the overflow and writes nothing beyond the buffer.
+ */
+static void test_CheckBufferTooSmall(uint32_t length) {
+
+	for(uint32_t bufferSize = 0; bufferSize <= length; bufferSize++) {
+
+		memset(test_Buffer, 'x', sizeof(test_Buffer));
+
+		uint32_t encodedLength = 1;
+		Retcode_T retcode = AppTelemetryPayload_EncodeBatch(test_Samples, TEST_NUMBER_OF_SAMPLES, test_Buffer, bufferSize, &encodedLength);
+
+		// the terminating 0 needs a byte, too
+		APP_TEST_CHECK_MSG(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SOLAPP_TELEMETRY_PAYLOAD_BUFFER_TOO_SMALL) == retcode, "bufferSize:%u", bufferSize);
+		APP_TEST_CHECK(0 == encodedLength);
+		APP_TEST_CHECK_MSG('x' == test_Buffer[bufferSize], "bufferSize:%u", bufferSize);
+	}
+}
+
+/**
+ * @brief The 'V1 JSON' formats without timestamps, sent until @ref AppTimestamp is enabled. Runs first.
+ */
+static void test_V1_Json_NoTimestamp(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact, AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601);
+
+	const char * expected = "["
+			"{\"id\":" TEST_DEVICE_ID_JSON ",\"h\":45,\"t\":-12,\"aX\":12,\"aY\":-980,\"aZ\":-2147483648},"
+			"{\"id\":" TEST_DEVICE_ID_JSON ",\"t\":-1.5,\"aX\":0,\"aY\":1,\"aZ\":2147483647},"
+			"{\"id\":" TEST_DEVICE_ID_JSON ",\"h\":46,\"t\":20,\"aX\":-1,\"aY\":0,\"aZ\":1000}"
+			"]";
+
+	uint32_t length = test_Encode(0);
+	APP_TEST_CHECK_MSG(0 == strcmp(expected, test_Buffer), "\n%s\n%s", expected, test_Buffer);
+	APP_TEST_CHECK(strlen(expected) == length);
+}
+
+/**
+ * @brief 'V1 JSON Verbose' with ISO 8601 timestamps.
+ */
+static void test_V1_Json_Verbose(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose, AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601);
+
+	const char * expected = "["
+			"{\"timestamp\":\"2023-11-14T22:13:20.100Z\",\"deviceId\":" TEST_DEVICE_ID_JSON ",\"humidity\":45,\"temperature\":-12,\"acceleratorX\":12,\"acceleratorY\":-980,\"acceleratorZ\":-2147483648},"
+			"{\"timestamp\":\"2023-11-14T22:13:20.350Z\",\"deviceId\":" TEST_DEVICE_ID_JSON ",\"temperature\":-1.5,\"acceleratorX\":0,\"acceleratorY\":1,\"acceleratorZ\":2147483647},"
+			"{\"timestamp\":\"2023-11-14T22:13:20.400Z\",\"deviceId\":" TEST_DEVICE_ID_JSON ",\"humidity\":46,\"temperature\":20,\"acceleratorX\":-1,\"acceleratorY\":0,\"acceleratorZ\":1000}"
+			"]";
+
+	uint32_t length = test_Encode(0);
+	APP_TEST_CHECK_MSG(0 == strcmp(expected, test_Buffer), "\n%s\n%s", expected, test_Buffer);
+	APP_TEST_CHECK(strlen(expected) == length);
+
+	test_CheckBufferTooSmall(length);
+}
+
+/**
+ * @brief 'V1 JSON Compact' with timestamps in milliseconds since the epoch.
+ */
+static void test_V1_Json_Compact(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact, AppRuntimeConfig_Telemetry_TimestampFormat_EpochMillis);
+
+	const char * expected = "["
+			"{\"ts\":1700000000100,\"id\":" TEST_DEVICE_ID_JSON ",\"h\":45,\"t\":-12,\"aX\":12,\"aY\":-980,\"aZ\":-2147483648},"
+			"{\"ts\":1700000000350,\"id\":" TEST_DEVICE_ID_JSON ",\"t\":-1.5,\"aX\":0,\"aY\":1,\"aZ\":2147483647},"
+			"{\"ts\":1700000000400,\"id\":" TEST_DEVICE_ID_JSON ",\"h\":46,\"t\":20,\"aX\":-1,\"aY\":0,\"aZ\":1000}"
+			"]";
+
+	uint32_t length = test_Encode(0);
+	APP_TEST_CHECK_MSG(0 == strcmp(expected, test_Buffer), "\n%s\n%s", expected, test_Buffer);
+	APP_TEST_CHECK(strlen(expected) == length);
+
+	test_CheckBufferTooSmall(length);
+}
+
+/**
+ * @brief A batch spilled in a previous run: the timestamps are the given time of the first sample plus the tick offsets.
+ */
+static void test_V1_Json_EncodeBatchAt(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose, AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601);
+
+	test_Encode(UINT64_C(1600000000000));
+	APP_TEST_CHECK(NULL != strstr(test_Buffer, "{\"timestamp\":\"2020-09-13T12:26:40.000Z\","));
+	APP_TEST_CHECK(NULL != strstr(test_Buffer, "{\"timestamp\":\"2020-09-13T12:26:40.250Z\","));
+	APP_TEST_CHECK(NULL != strstr(test_Buffer, "{\"timestamp\":\"2020-09-13T12:26:40.300Z\","));
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact, AppRuntimeConfig_Telemetry_TimestampFormat_EpochMillis);
+
+	test_Encode(UINT64_C(1600000000000));
+	APP_TEST_CHECK(0 == strncmp(test_Buffer, "[{\"ts\":1600000000000,", 21));
+	APP_TEST_CHECK(NULL != strstr(test_Buffer, "{\"ts\":1600000000250,"));
+	APP_TEST_CHECK(NULL != strstr(test_Buffer, "{\"ts\":1600000000300,"));
+}
+
+/**
+ * @brief A sample populated from the sensor readings encodes the readings.
+ */
+static void test_PopulateSample(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact, AppRuntimeConfig_Telemetry_TimestampFormat_EpochMillis);
+
+	Sensor_Value_T sensorValue;
+	memset(&sensorValue, 0, sizeof(sensorValue));
+	sensorValue.RH = 55;
+	sensorValue.Temp = 21499.6f;
+	sensorValue.Accel.X = -3;
+	sensorValue.Accel.Y = 4;
+	sensorValue.Accel.Z = 1001;
+
+	AppTelemetryPayload_Sample_T sample;
+	AppTelemetryPayload_PopulateSample(&sample, 2000, &sensorValue, APP_TELEMETRY_PAYLOAD_SENSOR_ALL);
+
+	uint32_t length = 0;
+	APP_TEST_CHECK(RETCODE_OK == AppTelemetryPayload_EncodeBatch(&sample, 1, test_Buffer, sizeof(test_Buffer), &length));
+	APP_TEST_CHECK_MSG(0 == strcmp("[{\"ts\":1700000001000,\"id\":" TEST_DEVICE_ID_JSON ",\"h\":55,\"t\":21.5,\"aX\":-3,\"aY\":4,\"aZ\":1001}]", test_Buffer), "%s", test_Buffer);
+}
+
+/**
+ * @brief Print a number as cJSON_PrintUnformatted() does: "%d" if it is integral, else "%1.15g", "%1.17g" if that does not read back the same number.
+ */
+static void test_PrintNumberAsCJson(double number, char * str, size_t size) {
+
+	if(number == (double) (int) number) {
+		snprintf(str, size, "%d", (int) number);
+		return;
+	}
+	double readBack = 0;
+	snprintf(str, size, "%1.15g", number);
+	if((1 != sscanf(str, "%lg", &readBack)) || (readBack != number)) snprintf(str, size, "%1.17g", number);
+}
+
+/**
+ * @brief The temperature in the 'V1 JSON' formats: the bytes cJSON prints for the milli degrees divided by 1000.0, the value of @ref AppTelemetryPayload_CreateNew().
+ * @details The baseline divided the float reading by 1000 in float, cJSON printed the float error of most quotients, e.g. 17.070999145507812 for 17.071.
+ */
+static void test_V1_Json_Temperature(void) {
+
+	static const int32_t temperatures[] = { 17071, -12345, 999, -999, 1, -1, 10, -10, 100, 1000, -1000, 1500, -1500, 20211, 0, 123456, INT32_MAX, INT32_MIN };
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact, AppRuntimeConfig_Telemetry_TimestampFormat_EpochMillis);
+
+	for(uint32_t i = 0; i < sizeof(temperatures) / sizeof(temperatures[0]); i++) {
+
+		AppTelemetryPayload_Sample_T sample = test_Samples[0];
+		sample.temperature = temperatures[i];
+
+		char number[32];
+		test_PrintNumberAsCJson(temperatures[i] / 1000.0, number, sizeof(number));
+		char expected[64];
+		snprintf(expected, sizeof(expected), ",\"t\":%s,", number);
+
+		uint32_t length = test_EncodeSamples(&sample, 1, 0);
+		APP_TEST_CHECK_MSG(NULL != strstr(test_Buffer, expected), "temperature:%d, expected:%s, %s", temperatures[i], expected, test_Buffer);
+		APP_TEST_CHECK(strlen(test_Buffer) == length);
+	}
+}
+
+/**
+ * @brief Read a CBOR head: major type and argument. Any of the argument lengths 0, 1, 2, 4 and 8 bytes.
+ * @return bool: false if the head is truncated or indefinite
+ */
+static bool test_ReadCborHead(const uint8_t ** posPtrPtr, const uint8_t * endPtr, uint8_t * majorTypePtr, uint64_t * argumentPtr) {
+
+	const uint8_t * posPtr = *posPtrPtr;
+	if(posPtr >= endPtr) return false;
+
+	*majorTypePtr = (uint8_t) (*posPtr >> 5);
+	uint8_t additional = *posPtr & 0x1F;
+	posPtr++;
+
+	uint32_t length = 0;
+	if(additional < 24) {
+		*argumentPtr = additional;
+	} else if(additional <= 27) {
+		length = UINT32_C(1) << (additional - 24);
+		if(posPtr + length > endPtr) return false;
+		*argumentPtr = 0;
+		for(uint32_t i = 0; i < length; i++) *argumentPtr = (*argumentPtr << 8) | posPtr[i];
+	} else return false;
+
+	*posPtrPtr = posPtr + length;
+	return true;
+}
+
+/**
+ * @brief Decode a 'V2 CBOR' batch into #test_DecodedBatch: a map of key 0 device id, 1 timestamp, 2 offsets and 3 .. 15 the channel arrays.
+ * @return bool: false if the payload is not a valid batch
+ */
+static bool test_DecodeBatch_V2_Cbor(const char * payloadPtr, uint32_t length) {
+
+	test_Batch_T * batchPtr = &test_DecodedBatch;
+	memset(batchPtr, 0, sizeof(*batchPtr));
+
+	const uint8_t * posPtr = (const uint8_t *) payloadPtr;
+	const uint8_t * endPtr = posPtr + length;
+	uint8_t majorType = 0;
+	uint64_t numberOfEntries = 0;
+	bool isOffsets = false;
+
+	if(!test_ReadCborHead(&posPtr, endPtr, &majorType, &numberOfEntries) || 5 != majorType) return false;
+
+	for(uint64_t entry = 0; entry < numberOfEntries; entry++) {
+
+		uint64_t key = 0;
+		uint64_t argument = 0;
+		if(!test_ReadCborHead(&posPtr, endPtr, &majorType, &key) || 0 != majorType) return false;
+
+		if(0 == key) {
+			if(!test_ReadCborHead(&posPtr, endPtr, &majorType, &argument) || 3 != majorType) return false;
+			if(argument >= sizeof(batchPtr->deviceId) || posPtr + argument > endPtr) return false;
+			memcpy(batchPtr->deviceId, posPtr, argument);
+			posPtr += argument;
+		} else if(1 == key) {
+			if(!test_ReadCborHead(&posPtr, endPtr, &majorType, &batchPtr->millisSinceEpoch) || 0 != majorType) return false;
+			batchPtr->isTimestamp = true;
+		} else if(key <= 2 + TEST_NUMBER_OF_CHANNELS) {
+			if(!test_ReadCborHead(&posPtr, endPtr, &majorType, &argument) || 4 != majorType || argument > TEST_MAX_SAMPLES) return false;
+
+			// all arrays have one item per sample
+			if((isOffsets || batchPtr->numberOfSamples > 0) && argument != batchPtr->numberOfSamples) return false;
+			batchPtr->numberOfSamples = (uint32_t) argument;
+
+			uint32_t channel = (uint32_t) key - 3;
+			if(2 == key) isOffsets = true;
+			else batchPtr->isChannel[channel] = true;
+
+			for(uint32_t i = 0; i < batchPtr->numberOfSamples; i++) {
+				if(!test_ReadCborHead(&posPtr, endPtr, &majorType, &argument)) return false;
+
+				int64_t value = 0;
+				if(0 == majorType) value = (int64_t) argument;
+				else if(1 == majorType) value = -1 - (int64_t) argument;
+				else if(2 != key && 7 == majorType && 22 == argument) batchPtr->isNull[channel][i] = true;
+				else return false;
+
+				if(2 == key) batchPtr->offsetsMillis[i] = value;
+				else batchPtr->values[channel][i] = value;
+			}
+		} else return false;
+	}
+	return isOffsets && posPtr == endPtr;
+}
+
+/**
+ * @brief 'V2 CBOR' without timestamp, sent until @ref AppTimestamp is enabled. Runs before it is.
+ */
+static void test_V2_Cbor_NoTimestamp(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor, AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601);
+
+	uint32_t length = test_Encode(0);
+	APP_TEST_CHECK(test_DecodeBatch_V2_Cbor(test_Buffer, length));
+	test_CheckDecodedBatch(test_Samples, TEST_NUMBER_OF_SAMPLES, TEST_SELECTED_CHANNELS, 0, true);
+}
+
+/**
+ * @brief 'V2 CBOR' round trip of the test batch and the long batch with all sensors. The size tracking is exact.
+ */
+static void test_V2_Cbor(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor, AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601);
+
+	uint32_t length = test_Encode(0);
+	APP_TEST_CHECK(test_GetBatchSize(test_Samples, TEST_NUMBER_OF_SAMPLES) == length);
+	APP_TEST_CHECK(test_DecodeBatch_V2_Cbor(test_Buffer, length));
+	test_CheckDecodedBatch(test_Samples, TEST_NUMBER_OF_SAMPLES, TEST_SELECTED_CHANNELS, UINT64_C(1700000000100), true);
+
+	test_CheckBufferTooSmall(length);
+
+	test_ConfigureAllSensors(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor);
+
+	for(uint32_t numberOfSamples = 1; numberOfSamples <= TEST_MAX_SAMPLES; numberOfSamples++) {
+		length = test_EncodeSamples(test_LongSamples, numberOfSamples, 0);
+		APP_TEST_CHECK_MSG(test_GetBatchSize(test_LongSamples, numberOfSamples) == length, "samples:%u", numberOfSamples);
+		APP_TEST_CHECK_MSG(test_DecodeBatch_V2_Cbor(test_Buffer, length), "samples:%u", numberOfSamples);
+		test_CheckDecodedBatch(test_LongSamples, numberOfSamples, TEST_ALL_CHANNELS, UINT64_C(1700000001000), true);
+	}
+}
+
+/**
+ * @brief 'V2 CBOR' of a batch spilled in a previous run carries the given timestamp.
+ */
+static void test_V2_Cbor_EncodeBatchAt(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor, AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601);
+
+	uint32_t length = test_Encode(UINT64_C(1600000000000));
+	APP_TEST_CHECK(test_DecodeBatch_V2_Cbor(test_Buffer, length));
+	test_CheckDecodedBatch(test_Samples, TEST_NUMBER_OF_SAMPLES, TEST_SELECTED_CHANNELS, UINT64_C(1600000000000), true);
+}
+
+/**
+ * @brief Read an unsigned LEB128 varint.
+ * @return bool: false if the varint is truncated or longer than 64 bits
+ */
+static bool test_ReadVarint(const uint8_t ** posPtrPtr, const uint8_t * endPtr, uint64_t * valuePtr) {
+
+	*valuePtr = 0;
+	for(uint32_t shift = 0; shift < 64; shift += 7) {
+		if(*posPtrPtr >= endPtr) return false;
+		uint8_t b = *(*posPtrPtr)++;
+		*valuePtr |= (uint64_t) (b & 0x7F) << shift;
+		if(0 == (b & 0x80)) return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Read a zig-zag encoded signed varint.
+ */
+static bool test_ReadSignedVarint(const uint8_t ** posPtrPtr, const uint8_t * endPtr, int64_t * valuePtr) {
+
+	uint64_t value = 0;
+	if(!test_ReadVarint(posPtrPtr, endPtr, &value)) return false;
+
+	*valuePtr = (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+	return true;
+}
+
+/**
+ * @brief Decode a 'V2 Delta' batch into #test_DecodedBatch, as test-scripts/payload-decoder/decodeDeltaPayload.py does.
+ * @return bool: false if the payload is not a valid batch
+ */
+static bool test_DecodeBatch_V2_Delta(const char * payloadPtr, uint32_t length) {
+
+	test_Batch_T * batchPtr = &test_DecodedBatch;
+	memset(batchPtr, 0, sizeof(*batchPtr));
+
+	const uint8_t * posPtr = (const uint8_t *) payloadPtr;
+	const uint8_t * endPtr = posPtr + length;
+	uint64_t flags = 0;
+	uint64_t value = 0;
+
+	if(posPtr >= endPtr || 1 != *posPtr++) return false;
+	if(!test_ReadVarint(&posPtr, endPtr, &flags) || flags >= (UINT64_C(1) << (TEST_NUMBER_OF_CHANNELS + 1))) return false;
+
+	if(!test_ReadVarint(&posPtr, endPtr, &value) || value >= sizeof(batchPtr->deviceId) || posPtr + value > endPtr) return false;
+	memcpy(batchPtr->deviceId, posPtr, value);
+	posPtr += value;
+
+	batchPtr->isTimestamp = (0 != (flags & 0x01));
+	if(batchPtr->isTimestamp && !test_ReadVarint(&posPtr, endPtr, &batchPtr->millisSinceEpoch)) return false;
+
+	if(!test_ReadVarint(&posPtr, endPtr, &value) || 0 == value || value > TEST_MAX_SAMPLES) return false;
+	batchPtr->numberOfSamples = (uint32_t) value;
+
+	// delta of deltas of the offsets
+	int64_t deltaMillis = 0;
+	for(uint32_t i = 1; i < batchPtr->numberOfSamples; i++) {
+		int64_t deltaOfDeltaMillis = 0;
+		if(!test_ReadSignedVarint(&posPtr, endPtr, &deltaOfDeltaMillis)) return false;
+		deltaMillis += deltaOfDeltaMillis;
+		batchPtr->offsetsMillis[i] = batchPtr->offsetsMillis[i - 1] + deltaMillis;
+	}
+
+	// first value and deltas per selected channel
+	for(uint32_t c = 0; c < TEST_NUMBER_OF_CHANNELS; c++) {
+		if(0 == (flags & (UINT64_C(1) << (c + 1)))) continue;
+		batchPtr->isChannel[c] = true;
+
+		int64_t channelValue = 0;
+		for(uint32_t i = 0; i < batchPtr->numberOfSamples; i++) {
+			int64_t delta = 0;
+			if(!test_ReadSignedVarint(&posPtr, endPtr, &delta)) return false;
+			channelValue += delta;
+			batchPtr->values[c][i] = channelValue;
+		}
+	}
+	return (posPtr == endPtr);
+}
+
+/**
+ * @brief 'V2 Delta' without timestamp, sent until @ref AppTimestamp is enabled. Runs before it is.
+ */
+static void test_V2_Delta_NoTimestamp(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta, AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601);
+
+	uint32_t length = test_Encode(0);
+	APP_TEST_CHECK(test_DecodeBatch_V2_Delta(test_Buffer, length));
+	test_CheckDecodedBatch(test_Samples, TEST_NUMBER_OF_SAMPLES, TEST_SELECTED_CHANNELS, 0, false);
+}
+
+/**
+ * @brief 'V2 Delta' round trip of the test batch and the long batch with all sensors. The size tracking is exact.
+ * A value of a sensor not read holds its last reading and is sent as such.
+ */
+static void test_V2_Delta(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta, AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601);
+
+	uint32_t length = test_Encode(0);
+	APP_TEST_CHECK(test_GetBatchSize(test_Samples, TEST_NUMBER_OF_SAMPLES) == length);
+	APP_TEST_CHECK(test_DecodeBatch_V2_Delta(test_Buffer, length));
+	test_CheckDecodedBatch(test_Samples, TEST_NUMBER_OF_SAMPLES, TEST_SELECTED_CHANNELS, UINT64_C(1700000000100), false);
+
+	test_CheckBufferTooSmall(length);
+
+	test_ConfigureAllSensors(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta);
+
+	for(uint32_t numberOfSamples = 1; numberOfSamples <= TEST_MAX_SAMPLES; numberOfSamples++) {
+		length = test_EncodeSamples(test_LongSamples, numberOfSamples, 0);
+		APP_TEST_CHECK_MSG(test_GetBatchSize(test_LongSamples, numberOfSamples) == length, "samples:%u", numberOfSamples);
+		APP_TEST_CHECK_MSG(test_DecodeBatch_V2_Delta(test_Buffer, length), "samples:%u", numberOfSamples);
+		test_CheckDecodedBatch(test_LongSamples, numberOfSamples, TEST_ALL_CHANNELS, UINT64_C(1700000001000), false);
+	}
+}
+
+/**
+ * @brief 'V2 Delta' of a batch spilled in a previous run carries the given timestamp.
+ */
+static void test_V2_Delta_EncodeBatchAt(void) {
+
+	test_Configure(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta, AppRuntimeConfig_Telemetry_TimestampFormat_Iso8601);
+
+	uint32_t length = test_Encode(UINT64_C(1600000000000));
+	APP_TEST_CHECK(test_DecodeBatch_V2_Delta(test_Buffer, length));
+	test_CheckDecodedBatch(test_Samples, TEST_NUMBER_OF_SAMPLES, TEST_SELECTED_CHANNELS, UINT64_C(1600000000000), false);
+}
+
+/**
+ * @brief Time the encoding of a batch in the configured format.
+ * @return double: the cycles per sample, see appTest_GetCycles()
+ */
+static double test_TimeEncode(const AppTelemetryPayload_Sample_T * samplesPtr, uint32_t numberOfSamples, double * nanosPerSamplePtr, uint32_t * lengthPtr) {
+
+	uint64_t iterations = 0;
+	uint64_t startNanos = appTest_GetNanos();
+	uint64_t startCycles = appTest_GetCycles();
+	uint64_t nanos = 0;
+	do {
+		for(uint32_t i = 0; i < 10; i++) APP_TEST_CHECK(RETCODE_OK == AppTelemetryPayload_EncodeBatch(samplesPtr, numberOfSamples, test_Buffer, sizeof(test_Buffer), lengthPtr));
+		iterations += 10;
+		nanos = appTest_GetNanos() - startNanos;
+	} while(nanos < TEST_TIMING_MIN_NANOS);
+	double numberEncoded = (double) iterations * (double) numberOfSamples;
+
+	*nanosPerSamplePtr = (double) nanos / numberEncoded;
+	return (double) (appTest_GetCycles() - startCycles) / numberEncoded;
+}
+
+/**
+ * @brief Encode time of the formats for a batch of the long batch with all sensors, compared with 'V1 JSON Verbose'. Prints host timings, checks nothing but the encoding.
+ */
+static void test_EncodeTime(void) {
+
+	static const struct {
+		AppRuntimeConfig_Telemetry_PayloadFormat_T payloadFormat;
+		const char * name;
+	} formats[] = {
+		{ AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Verbose, "V1 JSON Verbose" },
+		{ AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact, "V1 JSON Compact" },
+		{ AppRuntimeConfig_Telemetry_PayloadFormat_V2_Json_Columnar, "V2 JSON Columnar" },
+		{ AppRuntimeConfig_Telemetry_PayloadFormat_V2_Cbor, "V2 CBOR" },
+		{ AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta, "V2 Delta" },
+	};
+
+	double verboseCyclesPerSample = 0;
+	for(uint32_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+
+		test_ConfigureAllSensors(formats[i].payloadFormat);
+		uint32_t length = 0;
+		double nanosPerSample = 0;
+		double cyclesPerSample = test_TimeEncode(test_LongSamples, TEST_TIMING_SAMPLES, &nanosPerSample, &length);
+		if(0 == i) verboseCyclesPerSample = cyclesPerSample;
+
+		printf("  %-16s %5u bytes, %6.1f ns, %5.0f " APP_TEST_CYCLES_UNIT " per sample, %.2f of the time of V1 JSON Verbose\n",
+				formats[i].name, length, nanosPerSample, cyclesPerSample, cyclesPerSample / verboseCyclesPerSample);
+	}
+}
+
+/**
+ * @brief 'V2 Delta' against 'V1 JSON Compact' on the stable batch and, for contrast, on the random walk of the long batch, all sensors:
+ * prints the compression ratio and the encode cycles per sample. The stable batch of 100 samples is compressed by an order of magnitude.
+ */
+static void test_DeltaCompression(void) {
+
+	static const struct {
+		const AppTelemetryPayload_Sample_T * samplesPtr;
+		uint32_t numberOfSamples;
+		const char * name;
+	} traces[] = {
+		{ test_StableSamples, 10, "stable, 10 samples" },
+		{ test_StableSamples, TEST_TIMING_SAMPLES, "stable, 100 samples" },
+		{ test_LongSamples, TEST_TIMING_SAMPLES, "random walk, 100 samples" },
+	};
+
+	for(uint32_t i = 0; i < sizeof(traces) / sizeof(traces[0]); i++) {
+
+		uint32_t compactLength = 0;
+		uint32_t deltaLength = 0;
+		double nanosPerSample = 0;
+
+		test_ConfigureAllSensors(AppRuntimeConfig_Telemetry_PayloadFormat_V1_Json_Compact);
+		(void) test_TimeEncode(traces[i].samplesPtr, traces[i].numberOfSamples, &nanosPerSample, &compactLength);
+
+		test_ConfigureAllSensors(AppRuntimeConfig_Telemetry_PayloadFormat_V2_Delta);
+		double cyclesPerSample = test_TimeEncode(traces[i].samplesPtr, traces[i].numberOfSamples, &nanosPerSample, &deltaLength);
+
+		double ratio = (double) compactLength / (double) deltaLength;
+		printf("  %-24s V1 JSON Compact %5u bytes, V2 Delta %4u bytes, ratio %4.1f, %4.0f " APP_TEST_CYCLES_UNIT " per sample\n",
+				traces[i].name, compactLength, deltaLength, ratio, cyclesPerSample);
+
+		if(1 == i) APP_TEST_CHECK_MSG(ratio >= 10.0, "ratio:%.1f", ratio);
+	}
+}
+
+int main(void) {
+
+	APP_TEST_CHECK(RETCODE_OK == AppTelemetryPayload_Init(TEST_DEVICE_ID));
+	test_InitLongSamples();
+	test_InitStableSamples();
+
+	APP_TEST_RUN(test_V1_Json_NoTimestamp);
+	APP_TEST_RUN(test_V2_Cbor_NoTimestamp);
+	APP_TEST_RUN(test_V2_Delta_NoTimestamp);
+
+	appTestStubs_SntpSeconds = TEST_SNTP_SECONDS;
+	appTestStubs_TickCount = TEST_ENABLE_TICK_COUNT;
+	APP_TEST_CHECK(RETCODE_OK == AppTimestamp_Enable());
+
+	APP_TEST_RUN(test_V1_Json_Verbose);
+	APP_TEST_RUN(test_V1_Json_Compact);
+	APP_TEST_RUN(test_V1_Json_EncodeBatchAt);
+	APP_TEST_RUN(test_PopulateSample);
+	APP_TEST_RUN(test_V1_Json_Temperature);
+	APP_TEST_RUN(test_V2_Cbor);
+	APP_TEST_RUN(test_V2_Cbor_EncodeBatchAt);
+	APP_TEST_RUN(test_V2_Delta);
+	APP_TEST_RUN(test_V2_Delta_EncodeBatchAt);
+	APP_TEST_RUN(test_EncodeTime);
+	APP_TEST_RUN(test_DeltaCompression);
+
+	return APP_TEST_RESULT();
+}
@@ -0,0 +1,272 @@
+/*
+ * test_AppTelemetryRing.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host unit test of @ref AppTelemetryRing: empty and full ring, wraparound of the indices, marks, dropping the oldest elements
+* and a two-thread producer / consumer stress run with and without drops.
+* @file
+*/
+
+#include "AppTest.h"
+#include "AppTelemetryRing.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#define TEST_CAPACITY				UINT32_C(5) /**< small odd capacity so the indices wrap often */
+#define TEST_STRESS_ELEMENTS		UINT32_C(2000000) /**< number of elements the producer writes in a stress run */
+#define TEST_STRESS_CAPACITY		UINT32_C(64) /**< capacity of the stress ring */
+
+/**
+ * @brief The test element. check is the complement of sequence to detect a torn or overwritten slot.
+ */
+typedef struct {
+	uint32_t sequence; /**< running number written by the producer */
+	uint32_t check; /**< ~sequence */
+} Test_Element_T;
+
+/**
+ * @brief Write one element, returns false if the ring is full.
+ */
+static bool test_Write(AppTelemetryRing_T * ringPtr, uint32_t sequence) {
+	Test_Element_T * elementPtr = (Test_Element_T *) AppTelemetryRing_GetWriteSlot(ringPtr);
+	if(NULL == elementPtr) return false;
+	elementPtr->sequence = sequence;
+	elementPtr->check = ~sequence;
+	AppTelemetryRing_CommitWrite(ringPtr);
+	return true;
+}
+
+static void test_Empty(void) {
+	AppTelemetryRing_T ring;
+	APP_TEST_CHECK(AppTelemetryRing_Create(&ring, sizeof(Test_Element_T), TEST_CAPACITY));
+
+	APP_TEST_CHECK(0 == AppTelemetryRing_GetCount(&ring));
+	APP_TEST_CHECK(0 == AppTelemetryRing_GetMarkedCount(&ring));
+	APP_TEST_CHECK(0 == AppTelemetryRing_BeginRead(&ring));
+	APP_TEST_CHECK(0 == AppTelemetryRing_GetReadMarkedCount(&ring));
+	APP_TEST_CHECK(0 == AppTelemetryRing_BeginDrop(&ring));
+	APP_TEST_CHECK(AppTelemetryRing_Release(&ring, 0));
+	APP_TEST_CHECK(NULL != AppTelemetryRing_GetWriteSlot(&ring));
+
+	AppTelemetryRing_Delete(&ring);
+	APP_TEST_CHECK(NULL == ring.bufferPtr);
+}
+
+static void test_Full(void) {
+	AppTelemetryRing_T ring;
+	APP_TEST_CHECK(AppTelemetryRing_Create(&ring, sizeof(Test_Element_T), TEST_CAPACITY));
+
+	for(uint32_t i = 0; i < TEST_CAPACITY; i++) APP_TEST_CHECK(test_Write(&ring, i));
+	APP_TEST_CHECK(TEST_CAPACITY == AppTelemetryRing_GetCount(&ring));
+	// full, no slot is sacrificed
+	APP_TEST_CHECK(NULL == AppTelemetryRing_GetWriteSlot(&ring));
+	APP_TEST_CHECK(!test_Write(&ring, TEST_CAPACITY));
+
+	APP_TEST_CHECK(TEST_CAPACITY == AppTelemetryRing_BeginRead(&ring));
+	const Test_Element_T * elementPtr = (const Test_Element_T *) AppTelemetryRing_GetReadSlot(&ring, 0);
+	APP_TEST_CHECK(0 == elementPtr->sequence);
+	APP_TEST_CHECK(AppTelemetryRing_Release(&ring, 1));
+	APP_TEST_CHECK(TEST_CAPACITY - 1 == AppTelemetryRing_GetCount(&ring));
+
+	// one slot free again
+	APP_TEST_CHECK(test_Write(&ring, TEST_CAPACITY));
+	APP_TEST_CHECK(!test_Write(&ring, TEST_CAPACITY + 1));
+
+	AppTelemetryRing_Reset(&ring);
+	APP_TEST_CHECK(0 == AppTelemetryRing_GetCount(&ring));
+
+	AppTelemetryRing_Delete(&ring);
+}
+
+static void test_Wraparound(void) {
+	AppTelemetryRing_T ring;
+	APP_TEST_CHECK(AppTelemetryRing_Create(&ring, sizeof(Test_Element_T), TEST_CAPACITY));
+
+	uint32_t nextWrite = 0;
+	uint32_t nextRead = 0;
+	// vary the batch sizes so the indices cross 2*capacity at every position
+	for(uint32_t round = 0; round < 10 * TEST_CAPACITY; round++) {
+		uint32_t numToWrite = (round % TEST_CAPACITY) + 1;
+		for(uint32_t i = 0; i < numToWrite; i++) APP_TEST_CHECK(test_Write(&ring, nextWrite++));
+		APP_TEST_CHECK(numToWrite == AppTelemetryRing_GetCount(&ring));
+
+		uint32_t numToRead = AppTelemetryRing_BeginRead(&ring);
+		APP_TEST_CHECK(numToWrite == numToRead);
+		for(uint32_t i = 0; i < numToRead; i++) {
+			const Test_Element_T * elementPtr = (const Test_Element_T *) AppTelemetryRing_GetReadSlot(&ring, i);
+			APP_TEST_CHECK_MSG(nextRead == elementPtr->sequence, "expected %u, got %u", nextRead, elementPtr->sequence);
+			nextRead++;
+		}
+		APP_TEST_CHECK(AppTelemetryRing_Release(&ring, numToRead));
+		APP_TEST_CHECK(0 == AppTelemetryRing_GetCount(&ring));
+		APP_TEST_CHECK(ring.writeIndex < 2 * TEST_CAPACITY);
+		APP_TEST_CHECK(ring.readIndex < 2 * TEST_CAPACITY);
+	}
+	APP_TEST_CHECK(nextWrite == nextRead);
+
+	AppTelemetryRing_Delete(&ring);
+}
+
+static void test_Mark(void) {
+	AppTelemetryRing_T ring;
+	APP_TEST_CHECK(AppTelemetryRing_Create(&ring, sizeof(Test_Element_T), TEST_CAPACITY));
+
+	APP_TEST_CHECK(test_Write(&ring, 0));
+	APP_TEST_CHECK(test_Write(&ring, 1));
+	AppTelemetryRing_SetMark(&ring);
+	APP_TEST_CHECK(test_Write(&ring, 2));
+
+	// the element after the mark is committed but its batch is not complete
+	APP_TEST_CHECK(3 == AppTelemetryRing_GetCount(&ring));
+	APP_TEST_CHECK(2 == AppTelemetryRing_GetMarkedCount(&ring));
+	APP_TEST_CHECK(3 == AppTelemetryRing_BeginRead(&ring));
+	APP_TEST_CHECK(2 == AppTelemetryRing_GetReadMarkedCount(&ring));
+	APP_TEST_CHECK(AppTelemetryRing_Release(&ring, 2));
+	APP_TEST_CHECK(0 == AppTelemetryRing_GetMarkedCount(&ring));
+	APP_TEST_CHECK(1 == AppTelemetryRing_GetCount(&ring));
+
+	AppTelemetryRing_Delete(&ring);
+}
+
+static void test_DropOldest(void) {
+	AppTelemetryRing_T ring;
+	APP_TEST_CHECK(AppTelemetryRing_Create(&ring, sizeof(Test_Element_T), TEST_CAPACITY));
+
+	for(uint32_t i = 0; i < TEST_CAPACITY; i++) APP_TEST_CHECK(test_Write(&ring, i));
+	AppTelemetryRing_SetMark(&ring);
+
+	// the consumer is in the middle of reading when the producer drops
+	APP_TEST_CHECK(TEST_CAPACITY == AppTelemetryRing_BeginRead(&ring));
+
+	APP_TEST_CHECK(TEST_CAPACITY == AppTelemetryRing_BeginDrop(&ring));
+	const Test_Element_T * dropPtr = (const Test_Element_T *) AppTelemetryRing_GetDropSlot(&ring, 1);
+	APP_TEST_CHECK(1 == dropPtr->sequence);
+	APP_TEST_CHECK(AppTelemetryRing_DropOldest(&ring, 2));
+	APP_TEST_CHECK(TEST_CAPACITY - 2 == AppTelemetryRing_GetCount(&ring));
+	APP_TEST_CHECK(test_Write(&ring, TEST_CAPACITY));
+
+	// the consumer's snapshot is stale and must be discarded
+	APP_TEST_CHECK(!AppTelemetryRing_Release(&ring, TEST_CAPACITY));
+
+	// a new snapshot starts at the oldest element that was kept
+	APP_TEST_CHECK(TEST_CAPACITY - 1 == AppTelemetryRing_BeginRead(&ring));
+	const Test_Element_T * elementPtr = (const Test_Element_T *) AppTelemetryRing_GetReadSlot(&ring, 0);
+	APP_TEST_CHECK(2 == elementPtr->sequence);
+	APP_TEST_CHECK(AppTelemetryRing_Release(&ring, 1));
+
+	// the consumer released in the meantime: the producer's drop fails and it has to retry
+	APP_TEST_CHECK(AppTelemetryRing_BeginDrop(&ring) > 0);
+	APP_TEST_CHECK(AppTelemetryRing_BeginRead(&ring) > 0);
+	APP_TEST_CHECK(AppTelemetryRing_Release(&ring, 1));
+	APP_TEST_CHECK(!AppTelemetryRing_DropOldest(&ring, 1));
+
+	AppTelemetryRing_Delete(&ring);
+}
+
+/**
+ * @brief Shared state of a stress run.
+ */
+typedef struct {
+	AppTelemetryRing_T ring; /**< the ring under test */
+	bool isDropOldest; /**< producer drops the oldest elements instead of waiting if the ring is full */
+	uint32_t numberOfDropped; /**< elements dropped by the producer */
+	uint32_t numberOfReceived; /**< elements released by the consumer */
+	uint32_t numberOfErrors; /**< torn, overwritten or out of order elements seen by the consumer */
+} Test_Stress_T;
+
+static void * test_StressProducer(void * argPtr) {
+	Test_Stress_T * stressPtr = (Test_Stress_T *) argPtr;
+	for(uint32_t sequence = 0; sequence < TEST_STRESS_ELEMENTS; sequence++) {
+		while(!test_Write(&stressPtr->ring, sequence)) {
+			if(stressPtr->isDropOldest) {
+				uint32_t numToDrop = AppTelemetryRing_BeginDrop(&stressPtr->ring);
+				if(numToDrop > 0) {
+					numToDrop = (numToDrop + 1) / 2;
+					if(AppTelemetryRing_DropOldest(&stressPtr->ring, numToDrop)) stressPtr->numberOfDropped += numToDrop;
+				}
+			} else {
+				sched_yield();
+			}
+		}
+		AppTelemetryRing_SetMark(&stressPtr->ring);
+	}
+	return NULL;
+}
+
+static void * test_StressConsumer(void * argPtr) {
+	Test_Stress_T * stressPtr = (Test_Stress_T *) argPtr;
+	uint32_t nextSequence = 0;
+	Test_Element_T copy[TEST_STRESS_CAPACITY];
+	// the last element is never dropped, the consumer is done when it received it
+	while(nextSequence < TEST_STRESS_ELEMENTS) {
+		uint32_t numToRead = AppTelemetryRing_BeginRead(&stressPtr->ring);
+		if(numToRead == 0) {
+			sched_yield();
+			continue;
+		}
+		for(uint32_t i = 0; i < numToRead; i++) copy[i] = *(const Test_Element_T *) AppTelemetryRing_GetReadSlot(&stressPtr->ring, i);
+		if(!AppTelemetryRing_Release(&stressPtr->ring, numToRead)) {
+			// dropped by the producer while reading
+			continue;
+		}
+		for(uint32_t i = 0; i < numToRead; i++) {
+			if(copy[i].check != ~copy[i].sequence) stressPtr->numberOfErrors++;
+			else if(copy[i].sequence < nextSequence) stressPtr->numberOfErrors++;
+			else if(!stressPtr->isDropOldest && copy[i].sequence != nextSequence) stressPtr->numberOfErrors++;
+			nextSequence = copy[i].sequence + 1;
+		}
+		stressPtr->numberOfReceived += numToRead;
+	}
+	return NULL;
+}
+
+static void test_Stress(bool isDropOldest) {
+	static Test_Stress_T stress;
+	stress.isDropOldest = isDropOldest;
+	stress.numberOfDropped = 0;
+	stress.numberOfReceived = 0;
+	stress.numberOfErrors = 0;
+	APP_TEST_CHECK(AppTelemetryRing_Create(&stress.ring, sizeof(Test_Element_T), TEST_STRESS_CAPACITY));
+
+	pthread_t producer, consumer;
+	APP_TEST_CHECK(0 == pthread_create(&consumer, NULL, test_StressConsumer, &stress));
+	APP_TEST_CHECK(0 == pthread_create(&producer, NULL, test_StressProducer, &stress));
+	pthread_join(producer, NULL);
+	pthread_join(consumer, NULL);
+
+	printf("  received: %u, dropped: %u\n", stress.numberOfReceived, stress.numberOfDropped);
+	APP_TEST_CHECK(0 == stress.numberOfErrors);
+	if(isDropOldest) {
+		APP_TEST_CHECK(stress.numberOfReceived + stress.numberOfDropped <= TEST_STRESS_ELEMENTS);
+		APP_TEST_CHECK(stress.numberOfReceived > 0);
+	} else {
+		APP_TEST_CHECK(TEST_STRESS_ELEMENTS == stress.numberOfReceived);
+		APP_TEST_CHECK(0 == stress.numberOfDropped);
+	}
+	APP_TEST_CHECK(0 == AppTelemetryRing_GetCount(&stress.ring));
+
+	AppTelemetryRing_Delete(&stress.ring);
+}
+
+static void test_StressNoDrop(void) {
+	test_Stress(false);
+}
+
+static void test_StressDropOldest(void) {
+	test_Stress(true);
+}
+
+int main(void) {
+	APP_TEST_RUN(test_Empty);
+	APP_TEST_RUN(test_Full);
+	APP_TEST_RUN(test_Wraparound);
+	APP_TEST_RUN(test_Mark);
+	APP_TEST_RUN(test_DropOldest);
+	APP_TEST_RUN(test_StressNoDrop);
+	APP_TEST_RUN(test_StressDropOldest);
+	return APP_TEST_RESULT();
+}
@@ -0,0 +1,204 @@
+/*
+ * test_AppTelemetrySketch.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host unit test of @ref AppTelemetrySketch: the p50, p95 and p99 of the sketch against the exact quantiles of the values,
+* within the documented error bound of the level the sketch merged to, for distributions of sensor values and the full int32 range.
+* @file
+*/
+
+#include "AppTest.h"
+#include "AppTelemetrySketch.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define TEST_NUMBER_OF_VALUES		UINT32_C(100000) /**< number of values per distribution, more than a bin holds */
+#define TEST_SUB_BUCKETS			(INT64_C(1) << APP_TELEMETRY_SKETCH_SUB_BUCKET_BITS) /**< number of buckets per power of two */
+
+static const uint32_t test_Permilles[] = { 500, 950, 990 }; /**< the quantiles sent in the aggregation mode */
+static const uint32_t test_NumbersOfBins[] = { 128, 256, 512 }; /**< the range of bins of the configuration */
+static const uint32_t test_MaxLevels[] = { 3, 2, 1 }; /**< the max level of any values per number of bins, documented in @ref AppTelemetrySketch */
+
+static int32_t test_Values[TEST_NUMBER_OF_VALUES]; /**< the values of a distribution */
+static int32_t test_SortedValues[TEST_NUMBER_OF_VALUES]; /**< the values sorted */
+static uint64_t test_Random = 88172645463325252ULL; /**< state of the random generator */
+
+/**
+ * @brief xorshift64, uniform in [0, 2^64).
+ */
+static uint64_t test_NextRandom(void) {
+	test_Random ^= test_Random << 13;
+	test_Random ^= test_Random >> 7;
+	test_Random ^= test_Random << 17;
+	return test_Random;
+}
+
+/**
+ * @brief Uniform in (0, 1).
+ */
+static double test_NextUniform(void) {
+	return ((double) (test_NextRandom() >> 11) + 0.5) / 9007199254740992.0;
+}
+
+/**
+ * @brief Normal distributed, Box-Muller.
+ */
+static double test_NextNormal(double mean, double stddev) {
+	return mean + stddev * sqrt(-2.0 * log(test_NextUniform())) * cos(6.283185307179586 * test_NextUniform());
+}
+
+static int test_CompareValues(const void * aPtr, const void * bPtr) {
+	int32_t a = *(const int32_t *) aPtr;
+	int32_t b = *(const int32_t *) bPtr;
+	return (a > b) - (a < b);
+}
+
+/**
+ * @brief Returns the documented error bound of a quantile at a level: relative 2^level / 2^(bits + 1) for values of at least 2^bits,
+ * absolute 2^level below. Beyond level bits a bucket spans several powers of two and there is no useful bound.
+ */
+static bool test_IsWithinBound(int32_t exactValue, int32_t sketchValue, uint32_t level) {
+
+	int64_t error = llabs((int64_t) sketchValue - exactValue);
+	int64_t absExactValue = llabs((int64_t) exactValue);
+
+	if(level > APP_TELEMETRY_SKETCH_SUB_BUCKET_BITS) return true;
+	if(absExactValue < TEST_SUB_BUCKETS << level) return error <= (INT64_C(1) << level);
+	return error * 2 * TEST_SUB_BUCKETS <= absExactValue << level;
+}
+
+/**
+ * @brief Add the values to sketches of every number of bins and check the quantiles and the level. Prints the errors and the host time per insert.
+ * @param[in] name: the name of the distribution
+ * @param[in] maxLevel512: the max level expected with 512 bins, the bins of all sensor channels at level 0
+ */
+static void test_CheckDistribution(const char * name, uint32_t maxLevel512) {
+
+	memcpy(test_SortedValues, test_Values, sizeof(test_Values));
+	qsort(test_SortedValues, TEST_NUMBER_OF_VALUES, sizeof(int32_t), test_CompareValues);
+
+	for(uint32_t b = 0; b < sizeof(test_NumbersOfBins) / sizeof(test_NumbersOfBins[0]); b++) {
+
+		AppTelemetrySketch_T sketch;
+		APP_TEST_CHECK(AppTelemetrySketch_Create(&sketch, test_NumbersOfBins[b]));
+
+		uint64_t startNanos = appTest_GetNanos();
+		uint64_t startCycles = appTest_GetCycles();
+		for(uint32_t i = 0; i < TEST_NUMBER_OF_VALUES; i++) AppTelemetrySketch_Add(&sketch, test_Values[i]);
+		double cyclesPerInsert = (double) (appTest_GetCycles() - startCycles) / TEST_NUMBER_OF_VALUES;
+		double nanosPerInsert = (double) (appTest_GetNanos() - startNanos) / TEST_NUMBER_OF_VALUES;
+
+		printf("  %s, bins:%u, level:%u, insert:%.1f ns, %.0f " APP_TEST_CYCLES_UNIT, name, test_NumbersOfBins[b], sketch.level, nanosPerInsert, cyclesPerInsert);
+
+		for(uint32_t q = 0; q < sizeof(test_Permilles) / sizeof(test_Permilles[0]); q++) {
+
+			int32_t exactValue = test_SortedValues[(uint64_t) test_Permilles[q] * (TEST_NUMBER_OF_VALUES - 1) / 1000];
+			int32_t sketchValue = AppTelemetrySketch_GetQuantile(&sketch, test_Permilles[q]);
+			double errorPercent = (0 == exactValue) ? 0.0 : 100.0 * fabs((double) sketchValue - exactValue) / fabs((double) exactValue);
+
+			printf(", p%u:%.1f%%", test_Permilles[q] / 10, errorPercent);
+
+			APP_TEST_CHECK_MSG(test_IsWithinBound(exactValue, sketchValue, sketch.level), "%s, bins:%u, level:%u, p%u, exact:%d, sketch:%d",
+					name, test_NumbersOfBins[b], sketch.level, test_Permilles[q] / 10, exactValue, sketchValue);
+		}
+		printf("\n");
+
+		APP_TEST_CHECK_MSG(sketch.level <= test_MaxLevels[b], "%s, bins:%u, level:%u", name, test_NumbersOfBins[b], sketch.level);
+		if(512 == test_NumbersOfBins[b]) APP_TEST_CHECK_MSG(sketch.level <= maxLevel512, "%s, level:%u", name, sketch.level);
+
+		// the quantiles are clamped to the values added
+		APP_TEST_CHECK(test_SortedValues[0] <= AppTelemetrySketch_GetQuantile(&sketch, 0));
+		APP_TEST_CHECK(test_SortedValues[TEST_NUMBER_OF_VALUES - 1] >= AppTelemetrySketch_GetQuantile(&sketch, 1000));
+
+		AppTelemetrySketch_Delete(&sketch);
+	}
+}
+
+/**
+ * @brief Empty, single and constant values.
+ */
+static void test_Basic(void) {
+
+	AppTelemetrySketch_T sketch;
+	APP_TEST_CHECK(AppTelemetrySketch_Create(&sketch, 128));
+
+	APP_TEST_CHECK(0 == AppTelemetrySketch_GetQuantile(&sketch, 500));
+
+	AppTelemetrySketch_Add(&sketch, -12345);
+	APP_TEST_CHECK(-12345 == AppTelemetrySketch_GetQuantile(&sketch, 0));
+	APP_TEST_CHECK(-12345 == AppTelemetrySketch_GetQuantile(&sketch, 990));
+
+	// more values than a bin counts: the bins are halved, which keeps a steady distribution
+	AppTelemetrySketch_Reset(&sketch);
+	for(uint32_t i = 0; i < 4 * UINT32_C(65536); i++) AppTelemetrySketch_Add(&sketch, (i % 10 < 9) ? 7 : 8);
+	APP_TEST_CHECK(0 == sketch.level);
+	APP_TEST_CHECK(7 == AppTelemetrySketch_GetQuantile(&sketch, 500));
+	APP_TEST_CHECK(7 == AppTelemetrySketch_GetQuantile(&sketch, 850));
+	APP_TEST_CHECK(8 == AppTelemetrySketch_GetQuantile(&sketch, 950));
+
+	// small values are exact at level 0
+	AppTelemetrySketch_Reset(&sketch);
+	for(int32_t v = -15; v <= 15; v++) AppTelemetrySketch_Add(&sketch, v);
+	APP_TEST_CHECK(0 == sketch.level);
+	APP_TEST_CHECK(0 == AppTelemetrySketch_GetQuantile(&sketch, 500));
+	APP_TEST_CHECK(14 == AppTelemetrySketch_GetQuantile(&sketch, 990));
+
+	AppTelemetrySketch_Delete(&sketch);
+}
+
+/**
+ * @brief An accelerometer axis at rest, around 1 g in milli g.
+ */
+static void test_AccelAtRest(void) {
+	for(uint32_t i = 0; i < TEST_NUMBER_OF_VALUES; i++) test_Values[i] = (int32_t) lround(test_NextNormal(1000.0, 20.0));
+	test_CheckDistribution("accel at rest", 0);
+}
+
+/**
+ * @brief An accelerometer axis under vibration, +-2 g in milli g, around 0.
+ */
+static void test_AccelVibration(void) {
+	for(uint32_t i = 0; i < TEST_NUMBER_OF_VALUES; i++) test_Values[i] = (int32_t) lround(test_NextNormal(0.0, 500.0));
+	test_CheckDistribution("accel vibration", 0);
+}
+
+/**
+ * @brief A gyroscope axis in milli degrees per second, +-2000 deg/s.
+ */
+static void test_GyroFullScale(void) {
+	for(uint32_t i = 0; i < TEST_NUMBER_OF_VALUES; i++) test_Values[i] = (int32_t) lround(test_NextNormal(0.0, 500000.0));
+	test_CheckDistribution("gyro full scale", 1);
+}
+
+/**
+ * @brief Log-uniform positive values over 8 decades, a heavy tail.
+ */
+static void test_HeavyTail(void) {
+	for(uint32_t i = 0; i < TEST_NUMBER_OF_VALUES; i++) test_Values[i] = (int32_t) exp(test_NextUniform() * 8.0 * log(10.0));
+	test_CheckDistribution("heavy tail", 0);
+}
+
+/**
+ * @brief Uniform over the full int32 range, both signs.
+ */
+static void test_FullRange(void) {
+	for(uint32_t i = 0; i < TEST_NUMBER_OF_VALUES; i++) test_Values[i] = (int32_t) (uint32_t) test_NextRandom();
+	test_CheckDistribution("full int32", 1);
+}
+
+int main(void) {
+
+	APP_TEST_RUN(test_Basic);
+	APP_TEST_RUN(test_AccelAtRest);
+	APP_TEST_RUN(test_AccelVibration);
+	APP_TEST_RUN(test_GyroFullScale);
+	APP_TEST_RUN(test_HeavyTail);
+	APP_TEST_RUN(test_FullRange);
+
+	return APP_TEST_RESULT();
+}
@@ -0,0 +1,227 @@
+/*
+ * test_AppTelemetrySpectrum.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host unit test of @ref AppTelemetrySpectrum: the Q15 FFT against a double-precision DFT of the same input for every number of points,
+* and the RMS, crest factor and peaks of the features for sines at and between bin centers.
+* @file
+*/
+
+#include "AppTest.h"
+#include "AppTelemetrySpectrum.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define TEST_PI						3.14159265358979323846 /**< M_PI is not declared in strict C99 */
+#define TEST_PERIOD_MILLIS			UINT32_C(10) /**< sampling period of the test signals, 100 Hz */
+#define TEST_SAMPLING_RATE_HZ		(1000.0 / TEST_PERIOD_MILLIS) /**< sampling rate of the test signals */
+
+/**
+ * @brief The min SNR of the transform of a full scale input per log2 of the number of points, index 4 to 9. Each stage adds a rounding error of half an LSB
+ * while the scaling by 1/N halves the signal: about 3 dB less per doubling of the points.
+ */
+static const double test_MinSnrDb[APP_TELEMETRY_SPECTRUM_LOG2_MAX_POINTS + 1] = { 0, 0, 0, 0, 66.0, 63.0, 60.0, 57.0, 54.0, 51.0 };
+
+static int16_t test_Values[APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES * APP_TELEMETRY_SPECTRUM_MAX_POINTS]; /**< the values of a window: x, y, z */
+static int16_t test_Work[2 * APP_TELEMETRY_SPECTRUM_MAX_POINTS]; /**< the work buffer of a transform */
+static int16_t test_Input[2 * APP_TELEMETRY_SPECTRUM_MAX_POINTS]; /**< a copy of the input of a transform */
+
+/**
+ * @brief Fill an axis with a sine plus an offset.
+ */
+static void test_FillSine(uint32_t axis, uint32_t numberOfPoints, double offset, double amplitude, double frequencyHz) {
+	for(uint32_t i = 0; i < numberOfPoints; i++) {
+		double value = offset + amplitude * sin(2.0 * TEST_PI * frequencyHz * i / TEST_SAMPLING_RATE_HZ);
+		test_Values[axis * numberOfPoints + i] = (int16_t) lround(value);
+	}
+}
+
+/**
+ * @brief Check a peak: the frequency within a bin, the amplitude within a relative error.
+ */
+static void test_CheckPeak(const AppTelemetrySpectrum_Peak_T * peakPtr, double frequencyHz, double amplitude, double binHz, double maxRelativeError) {
+
+	double peakFrequencyHz = peakPtr->frequencyMilliHz / 1000.0;
+	double peakAmplitude = peakPtr->amplitudeThousandths / 1000.0;
+
+	APP_TEST_CHECK_MSG(fabs(peakFrequencyHz - frequencyHz) <= binHz / 2 + 0.001, "frequency:%.3f Hz, expected:%.3f Hz", peakFrequencyHz, frequencyHz);
+	APP_TEST_CHECK_MSG(fabs(peakAmplitude - amplitude) <= maxRelativeError * amplitude, "amplitude:%.3f, expected:%.3f", peakAmplitude, amplitude);
+}
+
+/**
+ * @brief Returns the SNR in dB of the transform of the input against a double-precision DFT, scaled by 1/N.
+ */
+static double test_GetFftSnrDb(uint32_t log2NumberOfPoints) {
+
+	const uint32_t numberOfPoints = UINT32_C(1) << log2NumberOfPoints;
+
+	memcpy(test_Work, test_Input, 2 * numberOfPoints * sizeof(int16_t));
+	AppTelemetrySpectrum_Fft(test_Work, &test_Work[numberOfPoints], log2NumberOfPoints);
+
+	double signalEnergy = 0;
+	double errorEnergy = 0;
+	for(uint32_t k = 0; k < numberOfPoints; k++) {
+		double re = 0;
+		double im = 0;
+		for(uint32_t i = 0; i < numberOfPoints; i++) {
+			double angle = -2.0 * TEST_PI * (double) ((uint64_t) k * i % numberOfPoints) / numberOfPoints;
+			re += test_Input[i] * cos(angle) - test_Input[numberOfPoints + i] * sin(angle);
+			im += test_Input[i] * sin(angle) + test_Input[numberOfPoints + i] * cos(angle);
+		}
+		re /= numberOfPoints;
+		im /= numberOfPoints;
+		signalEnergy += re * re + im * im;
+		errorEnergy += (test_Work[k] - re) * (test_Work[k] - re) + (test_Work[numberOfPoints + k] - im) * (test_Work[numberOfPoints + k] - im);
+	}
+	return 10.0 * log10(signalEnergy / errorEnergy);
+}
+
+/**
+ * @brief The transform of random full scale values, |re + j im| < 2^15 as required, for every number of points.
+ */
+static void test_Fft_Snr_Noise(void) {
+
+	srand(1);
+
+	for(uint32_t log2NumberOfPoints = 4; log2NumberOfPoints <= APP_TELEMETRY_SPECTRUM_LOG2_MAX_POINTS; log2NumberOfPoints++) {
+
+		const uint32_t numberOfPoints = UINT32_C(1) << log2NumberOfPoints;
+
+		for(uint32_t i = 0; i < 2 * numberOfPoints; i++) test_Input[i] = (int16_t) (rand() % 32767 - 16383);
+
+		double snrDb = test_GetFftSnrDb(log2NumberOfPoints);
+		printf("  points:%u, SNR:%.1f dB\n", numberOfPoints, snrDb);
+		APP_TEST_CHECK_MSG(snrDb >= test_MinSnrDb[log2NumberOfPoints], "points:%u, SNR:%.1f dB", numberOfPoints, snrDb);
+	}
+}
+
+/**
+ * @brief The transform of two full scale sines with the Hann window, the input of the features, for every number of points.
+ */
+static void test_Fft_Snr_WindowedSines(void) {
+
+	for(uint32_t log2NumberOfPoints = 4; log2NumberOfPoints <= APP_TELEMETRY_SPECTRUM_LOG2_MAX_POINTS; log2NumberOfPoints++) {
+
+		const uint32_t numberOfPoints = UINT32_C(1) << log2NumberOfPoints;
+
+		for(uint32_t i = 0; i < numberOfPoints; i++) {
+			double window = (1.0 - cos(2.0 * TEST_PI * i / numberOfPoints)) / 2.0;
+			test_Input[i] = (int16_t) lround(16383.0 * window * sin(2.0 * TEST_PI * 3.0 * i / numberOfPoints));
+			test_Input[numberOfPoints + i] = (int16_t) lround(16383.0 * window * sin(2.0 * TEST_PI * 5.3 * i / numberOfPoints));
+		}
+
+		double snrDb = test_GetFftSnrDb(log2NumberOfPoints);
+		printf("  points:%u, SNR:%.1f dB\n", numberOfPoints, snrDb);
+		APP_TEST_CHECK_MSG(snrDb >= test_MinSnrDb[log2NumberOfPoints], "points:%u, SNR:%.1f dB", numberOfPoints, snrDb);
+	}
+}
+
+/**
+ * @brief Sines at bin centers: the peak at the frequency of the sine with its amplitude, the RMS and crest factor of a sine, for every number of points.
+ */
+static void test_Features_BinCenter(void) {
+
+	for(uint32_t log2NumberOfPoints = 4; log2NumberOfPoints <= APP_TELEMETRY_SPECTRUM_LOG2_MAX_POINTS; log2NumberOfPoints++) {
+
+		const uint32_t numberOfPoints = UINT32_C(1) << log2NumberOfPoints;
+		const double binHz = TEST_SAMPLING_RATE_HZ / numberOfPoints;
+
+		// x and y of similar amplitudes share a transform, z with gravity
+		test_FillSine(0, numberOfPoints, -12.0, 400.0, 3 * binHz);
+		test_FillSine(1, numberOfPoints, 3.0, 250.0, 5 * binHz);
+		test_FillSine(2, numberOfPoints, 1000.0, 80.0, (numberOfPoints / 4) * binHz);
+
+		AppTelemetrySpectrum_Features_T features;
+		AppTelemetrySpectrum_ComputeFeatures(test_Values, log2NumberOfPoints, TEST_PERIOD_MILLIS, 3, test_Work, &features);
+
+		const double amplitudes[APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES] = { 400.0, 250.0, 80.0 };
+		const double frequenciesHz[APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES] = { 3 * binHz, 5 * binHz, (numberOfPoints / 4) * binHz };
+
+		for(uint32_t axis = 0; axis < APP_TELEMETRY_SPECTRUM_NUMBER_OF_AXES; axis++) {
+			const AppTelemetrySpectrum_AxisFeatures_T * axisPtr = &features.axes[axis];
+
+			APP_TEST_CHECK_MSG(axisPtr->numberOfPeaks >= 1, "points:%u, axis:%u", numberOfPoints, axis);
+			if(axisPtr->numberOfPeaks < 1) continue;
+			test_CheckPeak(&axisPtr->peaks[0], frequenciesHz[axis], amplitudes[axis], binHz, 0.02);
+
+			// the leakage of the Hann window and the rounding errors are far below the sine
+			for(uint32_t i = 1; i < axisPtr->numberOfPeaks; i++) APP_TEST_CHECK(axisPtr->peaks[i].amplitudeThousandths * 20 < axisPtr->peaks[0].amplitudeThousandths);
+
+			double rms = axisPtr->rmsThousandths / 1000.0;
+			APP_TEST_CHECK_MSG(fabs(rms - amplitudes[axis] / sqrt(2.0)) <= 0.01 * amplitudes[axis], "points:%u, axis:%u, rms:%.3f", numberOfPoints, axis, rms);
+			double crestFactor = axisPtr->crestFactorThousandths / 1000.0;
+			APP_TEST_CHECK_MSG(fabs(crestFactor - sqrt(2.0)) <= 0.03, "points:%u, axis:%u, crest:%.3f", numberOfPoints, axis, crestFactor);
+		}
+	}
+}
+
+/**
+ * @brief Sines between two bins read up to 15% low, two sines are found highest first.
+ */
+static void test_Features_BetweenBins(void) {
+
+	const uint32_t log2NumberOfPoints = 8;
+	const uint32_t numberOfPoints = UINT32_C(1) << log2NumberOfPoints;
+	const double binHz = TEST_SAMPLING_RATE_HZ / numberOfPoints;
+
+	test_FillSine(0, numberOfPoints, 0.0, 300.0, 20.5 * binHz);
+	test_FillSine(1, numberOfPoints, 0.0, 300.0, 40.25 * binHz);
+	// two sines on z
+	for(uint32_t i = 0; i < numberOfPoints; i++) {
+		double t = i / TEST_SAMPLING_RATE_HZ;
+		test_Values[2 * numberOfPoints + i] = (int16_t) lround(1000.0 + 200.0 * sin(2.0 * TEST_PI * 10 * binHz * t) + 50.0 * sin(2.0 * TEST_PI * 60 * binHz * t));
+	}
+
+	AppTelemetrySpectrum_Features_T features;
+	AppTelemetrySpectrum_ComputeFeatures(test_Values, log2NumberOfPoints, TEST_PERIOD_MILLIS, 2, test_Work, &features);
+
+	APP_TEST_CHECK(2 == features.axes[0].numberOfPeaks);
+	test_CheckPeak(&features.axes[0].peaks[0], 20.5 * binHz, 300.0 * (1.0 - 0.075), binHz, 0.09);
+	test_CheckPeak(&features.axes[1].peaks[0], 40.25 * binHz, 300.0 * (1.0 - 0.075), binHz, 0.09);
+
+	APP_TEST_CHECK(2 == features.axes[2].numberOfPeaks);
+	test_CheckPeak(&features.axes[2].peaks[0], 10 * binHz, 200.0, binHz, 0.02);
+	test_CheckPeak(&features.axes[2].peaks[1], 60 * binHz, 50.0, binHz, 0.02);
+}
+
+/**
+ * @brief x and y of very different amplitudes are transformed one by one, a constant axis has no peaks.
+ */
+static void test_Features_Scales(void) {
+
+	const uint32_t log2NumberOfPoints = 7;
+	const uint32_t numberOfPoints = UINT32_C(1) << log2NumberOfPoints;
+	const double binHz = TEST_SAMPLING_RATE_HZ / numberOfPoints;
+
+	test_FillSine(0, numberOfPoints, 0.0, 16000.0, 7 * binHz);
+	test_FillSine(1, numberOfPoints, 0.0, 20.0, 30 * binHz);
+	for(uint32_t i = 0; i < numberOfPoints; i++) test_Values[2 * numberOfPoints + i] = 1000;
+
+	AppTelemetrySpectrum_Features_T features;
+	AppTelemetrySpectrum_ComputeFeatures(test_Values, log2NumberOfPoints, TEST_PERIOD_MILLIS, 1, test_Work, &features);
+
+	APP_TEST_CHECK(1 == features.axes[0].numberOfPeaks);
+	test_CheckPeak(&features.axes[0].peaks[0], 7 * binHz, 16000.0, binHz, 0.02);
+	APP_TEST_CHECK(1 == features.axes[1].numberOfPeaks);
+	test_CheckPeak(&features.axes[1].peaks[0], 30 * binHz, 20.0, binHz, 0.05);
+
+	APP_TEST_CHECK(0 == features.axes[2].rmsThousandths);
+	APP_TEST_CHECK(0 == features.axes[2].crestFactorThousandths);
+	APP_TEST_CHECK(0 == features.axes[2].numberOfPeaks);
+}
+
+int main(void) {
+
+	APP_TEST_RUN(test_Fft_Snr_Noise);
+	APP_TEST_RUN(test_Fft_Snr_WindowedSines);
+	APP_TEST_RUN(test_Features_BinCenter);
+	APP_TEST_RUN(test_Features_BetweenBins);
+	APP_TEST_RUN(test_Features_Scales);
+
+	return APP_TEST_RESULT();
+}
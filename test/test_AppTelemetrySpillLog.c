@@ -0,0 +1,278 @@
+/*
+ * test_AppTelemetrySpillLog.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+/**
+* @brief Host unit test of @ref AppTelemetrySpillLog with file-backed storage: append and read back, consume,
+* rebuilding the index after a reopen, dropping the oldest segment of a full log, torn writes and corrupt records.
+* @file
+*/
+
+#include "AppTest.h"
+#include "AppTelemetrySpillLog.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TEST_SEGMENT_SIZE			UINT32_C(256) /**< small segments so records spread over several files */
+#define TEST_NUMBER_OF_SEGMENTS		UINT32_C(4) /**< number of segment files */
+#define TEST_ELEMENT_SIZE			UINT16_C(12) /**< size of a test element */
+#define TEST_TIMESTAMP_BASE			UINT64_C(1791000000000) /**< millis since the epoch of record 0 */
+
+static char test_Dir[64]; /**< the temporary folder of the segment files */
+
+/**
+ * @brief Map a segment file name to a path in the temporary folder.
+ */
+static void test_GetPath(const char * fileName, char * pathBuffer, size_t pathBufferSize) {
+	snprintf(pathBuffer, pathBufferSize, "%s%s", test_Dir, fileName);
+}
+
+static bool test_StorageWrite(const char * fileName, const uint8_t * bufferPtr, uint32_t length, uint32_t offset) {
+	char path[128];
+	test_GetPath(fileName, path, sizeof(path));
+	FILE * filePtr = fopen(path, "r+b");
+	if(NULL == filePtr) filePtr = fopen(path, "w+b");
+	if(NULL == filePtr) return false;
+	bool isOk = (0 == fseek(filePtr, (long) offset, SEEK_SET)) && (length == fwrite(bufferPtr, 1, length, filePtr));
+	fclose(filePtr);
+	return isOk;
+}
+
+static bool test_StorageRead(const char * fileName, uint8_t * bufferPtr, uint32_t length, uint32_t offset) {
+	char path[128];
+	test_GetPath(fileName, path, sizeof(path));
+	FILE * filePtr = fopen(path, "rb");
+	if(NULL == filePtr) return false;
+	bool isOk = (0 == fseek(filePtr, (long) offset, SEEK_SET)) && (length == fread(bufferPtr, 1, length, filePtr));
+	fclose(filePtr);
+	return isOk;
+}
+
+static bool test_StorageDelete(const char * fileName) {
+	char path[128];
+	test_GetPath(fileName, path, sizeof(path));
+	return (0 == remove(path));
+}
+
+static const AppTelemetrySpillLog_Storage_T test_Storage = {
+	.writeFunc = test_StorageWrite,
+	.readFunc = test_StorageRead,
+	.deleteFunc = test_StorageDelete
+};
+
+/**
+ * @brief Fill the elements of record number recordNumber with a pattern.
+ */
+static void test_FillRecord(uint8_t * bufferPtr, uint32_t recordNumber, uint16_t numberOfElements) {
+	for(uint32_t i = 0; i < (uint32_t) TEST_ELEMENT_SIZE * numberOfElements; i++) bufferPtr[i] = (uint8_t) (recordNumber * 31 + i);
+}
+
+static AppTelemetrySpillLog_Result_T test_Append(AppTelemetrySpillLog_T * logPtr, uint32_t recordNumber) {
+	uint8_t buffer[TEST_ELEMENT_SIZE * 4];
+	uint16_t numberOfElements = (uint16_t) ((recordNumber % 4) + 1);
+	test_FillRecord(buffer, recordNumber, numberOfElements);
+	return AppTelemetrySpillLog_Append(logPtr, buffer, TEST_ELEMENT_SIZE, numberOfElements, TEST_TIMESTAMP_BASE + recordNumber);
+}
+
+/**
+ * @brief Read the next record and check it is record number recordNumber.
+ */
+static void test_ReadAndCheck(AppTelemetrySpillLog_T * logPtr, uint32_t recordNumber, bool isConsume) {
+	uint8_t buffer[TEST_ELEMENT_SIZE * 4];
+	uint8_t expected[TEST_ELEMENT_SIZE * 4];
+	uint16_t elementSize = 0;
+	uint16_t numberOfElements = 0;
+	uint64_t timestamp = 0;
+	AppTelemetrySpillLog_Result_T result = AppTelemetrySpillLog_ReadNext(logPtr, buffer, sizeof(buffer), &elementSize, &numberOfElements, &timestamp);
+	APP_TEST_CHECK_MSG(AppTelemetrySpillLog_Result_Ok == result, "record %u: result %d", recordNumber, (int) result);
+	if(AppTelemetrySpillLog_Result_Ok != result) return;
+	APP_TEST_CHECK(TEST_ELEMENT_SIZE == elementSize);
+	APP_TEST_CHECK((recordNumber % 4) + 1 == numberOfElements);
+	APP_TEST_CHECK_MSG(TEST_TIMESTAMP_BASE + recordNumber == timestamp, "record %u: timestamp %llu", recordNumber, (unsigned long long) timestamp);
+	test_FillRecord(expected, recordNumber, numberOfElements);
+	APP_TEST_CHECK(0 == memcmp(buffer, expected, (size_t) TEST_ELEMENT_SIZE * numberOfElements));
+	if(isConsume) AppTelemetrySpillLog_Consume(logPtr);
+}
+
+static void test_Open(AppTelemetrySpillLog_T * logPtr) {
+	AppTelemetrySpillLog_Open(logPtr, &test_Storage, TEST_SEGMENT_SIZE, TEST_NUMBER_OF_SEGMENTS);
+}
+
+static void test_CleanDir(void) {
+	for(uint32_t i = 0; i < APP_TELEMETRY_SPILL_LOG_MAX_NUMBER_OF_SEGMENTS; i++) {
+		char fileName[APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH];
+		snprintf(fileName, sizeof(fileName), "/TLMSPL%02u.BIN", (unsigned int) i);
+		test_StorageDelete(fileName);
+	}
+}
+
+static void test_AppendRead(void) {
+	test_CleanDir();
+	AppTelemetrySpillLog_T log;
+	test_Open(&log);
+
+	uint8_t buffer[TEST_ELEMENT_SIZE * 4];
+	uint16_t elementSize, numberOfElements;
+	uint64_t timestamp;
+	APP_TEST_CHECK(AppTelemetrySpillLog_Result_Empty == AppTelemetrySpillLog_ReadNext(&log, buffer, sizeof(buffer), &elementSize, &numberOfElements, &timestamp));
+
+	// spread over 3 segments
+	for(uint32_t i = 0; i < 10; i++) APP_TEST_CHECK(AppTelemetrySpillLog_Result_Ok == test_Append(&log, i));
+	APP_TEST_CHECK(10 == AppTelemetrySpillLog_GetNumberOfRecords(&log));
+	APP_TEST_CHECK(log.writeSegmentSeq > log.readSegmentSeq);
+
+	// reading without consuming returns the same record
+	test_ReadAndCheck(&log, 0, false);
+	test_ReadAndCheck(&log, 0, true);
+	for(uint32_t i = 1; i < 10; i++) test_ReadAndCheck(&log, i, true);
+	APP_TEST_CHECK(0 == AppTelemetrySpillLog_GetNumberOfRecords(&log));
+	APP_TEST_CHECK(AppTelemetrySpillLog_Result_Empty == AppTelemetrySpillLog_ReadNext(&log, buffer, sizeof(buffer), &elementSize, &numberOfElements, &timestamp));
+
+	// a buffer too small for the record
+	APP_TEST_CHECK(AppTelemetrySpillLog_Result_Ok == test_Append(&log, 3));
+	APP_TEST_CHECK(AppTelemetrySpillLog_Result_BufferTooSmall == AppTelemetrySpillLog_ReadNext(&log, buffer, TEST_ELEMENT_SIZE, &elementSize, &numberOfElements, &timestamp));
+	APP_TEST_CHECK(4 == numberOfElements);
+	test_ReadAndCheck(&log, 3, true);
+
+	// too large for a segment
+	uint8_t large[TEST_SEGMENT_SIZE];
+	memset(large, 0, sizeof(large));
+	APP_TEST_CHECK(AppTelemetrySpillLog_Result_RecordTooLarge == AppTelemetrySpillLog_Append(&log, large, 1, (uint16_t) sizeof(large), 0));
+}
+
+static void test_Reopen(void) {
+	test_CleanDir();
+	AppTelemetrySpillLog_T log;
+	test_Open(&log);
+
+	for(uint32_t i = 0; i < 10; i++) APP_TEST_CHECK(AppTelemetrySpillLog_Result_Ok == test_Append(&log, i));
+	// consumed records of the read segment must not come back
+	for(uint32_t i = 0; i < 4; i++) test_ReadAndCheck(&log, i, true);
+
+	// reset: the index is lost, the files are not
+	memset(&log, 0xEE, sizeof(log));
+	test_Open(&log);
+	APP_TEST_CHECK_MSG(6 == AppTelemetrySpillLog_GetNumberOfRecords(&log), "%u", AppTelemetrySpillLog_GetNumberOfRecords(&log));
+	APP_TEST_CHECK(6 == log.numberOfRecoveredRecords);
+
+	// writing continues after the recovered records
+	for(uint32_t i = 10; i < 12; i++) APP_TEST_CHECK(AppTelemetrySpillLog_Result_Ok == test_Append(&log, i));
+	for(uint32_t i = 4; i < 12; i++) test_ReadAndCheck(&log, i, true);
+	APP_TEST_CHECK(0 == AppTelemetrySpillLog_GetNumberOfRecords(&log));
+
+	// all consumed: nothing to recover
+	test_Open(&log);
+	APP_TEST_CHECK(0 == AppTelemetrySpillLog_GetNumberOfRecords(&log));
+	APP_TEST_CHECK(0 == log.numberOfRecoveredRecords);
+	APP_TEST_CHECK(AppTelemetrySpillLog_Result_Ok == test_Append(&log, 20));
+	test_ReadAndCheck(&log, 20, true);
+}
+
+static void test_Full(void) {
+	test_CleanDir();
+	AppTelemetrySpillLog_T log;
+	test_Open(&log);
+
+	// more than the segments hold, the oldest segments are dropped
+	uint32_t numberOfRecords = 40;
+	for(uint32_t i = 0; i < numberOfRecords; i++) APP_TEST_CHECK(AppTelemetrySpillLog_Result_Ok == test_Append(&log, i));
+	uint32_t numberKept = AppTelemetrySpillLog_GetNumberOfRecords(&log);
+	APP_TEST_CHECK(numberKept < numberOfRecords);
+	APP_TEST_CHECK(numberKept + log.numberOfDroppedRecords == numberOfRecords);
+	APP_TEST_CHECK(log.writeSegmentSeq - log.readSegmentSeq < TEST_NUMBER_OF_SEGMENTS);
+
+	// the segment sequence numbers wrapped around the files, the reopen finds the newest run
+	test_Open(&log);
+	APP_TEST_CHECK_MSG(numberKept == AppTelemetrySpillLog_GetNumberOfRecords(&log), "%u != %u", numberKept, AppTelemetrySpillLog_GetNumberOfRecords(&log));
+	for(uint32_t i = numberOfRecords - numberKept; i < numberOfRecords; i++) test_ReadAndCheck(&log, i, true);
+	APP_TEST_CHECK(0 == AppTelemetrySpillLog_GetNumberOfRecords(&log));
+}
+
+static void test_TornWrite(void) {
+	test_CleanDir();
+	AppTelemetrySpillLog_T log;
+	test_Open(&log);
+
+	for(uint32_t i = 0; i < 3; i++) APP_TEST_CHECK(AppTelemetrySpillLog_Result_Ok == test_Append(&log, i));
+
+	// the power fails in the middle of the next record: the header is written, the data only partly
+	char fileName[APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH];
+	snprintf(fileName, sizeof(fileName), "/TLMSPL%02u.BIN", (unsigned int) (log.writeSegmentSeq % TEST_NUMBER_OF_SEGMENTS));
+	uint8_t header[APP_TELEMETRY_SPILL_LOG_RECORD_HEADER_SIZE] = { 0x5A, 0xA5, TEST_ELEMENT_SIZE, 0, 4, 0, 0, 0 };
+	uint8_t partial[5] = { 1, 2, 3, 4, 5 };
+	APP_TEST_CHECK(test_StorageWrite(fileName, header, sizeof(header), log.writeOffset));
+	APP_TEST_CHECK(test_StorageWrite(fileName, partial, sizeof(partial), log.writeOffset + sizeof(header)));
+
+	test_Open(&log);
+	APP_TEST_CHECK(3 == AppTelemetrySpillLog_GetNumberOfRecords(&log));
+
+	// the torn record is overwritten by the next one
+	APP_TEST_CHECK(AppTelemetrySpillLog_Result_Ok == test_Append(&log, 3));
+	for(uint32_t i = 0; i < 4; i++) test_ReadAndCheck(&log, i, true);
+}
+
+static void test_Corrupt(void) {
+	test_CleanDir();
+	AppTelemetrySpillLog_T log;
+	test_Open(&log);
+
+	for(uint32_t i = 0; i < 10; i++) APP_TEST_CHECK(AppTelemetrySpillLog_Result_Ok == test_Append(&log, i));
+	uint32_t recordsInFirstSegment = log.segmentRecords[log.readSegmentSeq % TEST_NUMBER_OF_SEGMENTS];
+
+	// flip a data byte of the first record
+	char fileName[APP_TELEMETRY_SPILL_LOG_FILE_NAME_LENGTH];
+	snprintf(fileName, sizeof(fileName), "/TLMSPL%02u.BIN", (unsigned int) (log.readSegmentSeq % TEST_NUMBER_OF_SEGMENTS));
+	uint8_t byte = 0x55;
+	APP_TEST_CHECK(test_StorageWrite(fileName, &byte, 1, APP_TELEMETRY_SPILL_LOG_SEGMENT_HEADER_SIZE + APP_TELEMETRY_SPILL_LOG_RECORD_HEADER_SIZE));
+
+	uint8_t buffer[TEST_ELEMENT_SIZE * 4];
+	uint16_t elementSize, numberOfElements;
+	uint64_t timestamp;
+	APP_TEST_CHECK(AppTelemetrySpillLog_Result_Corrupt == AppTelemetrySpillLog_ReadNext(&log, buffer, sizeof(buffer), &elementSize, &numberOfElements, &timestamp));
+	APP_TEST_CHECK(recordsInFirstSegment == log.numberOfDroppedRecords);
+
+	// the rest of the segment is dropped, reading goes on with the next segment
+	for(uint32_t i = recordsInFirstSegment; i < 10; i++) test_ReadAndCheck(&log, i, true);
+	APP_TEST_CHECK(0 == AppTelemetrySpillLog_GetNumberOfRecords(&log));
+}
+
+static void test_StaleFiles(void) {
+	test_CleanDir();
+	AppTelemetrySpillLog_T log;
+
+	// written with more segments: files in slots of the smaller log are stale
+	AppTelemetrySpillLog_Open(&log, &test_Storage, TEST_SEGMENT_SIZE, TEST_NUMBER_OF_SEGMENTS + 2);
+	for(uint32_t i = 0; i < 20; i++) APP_TEST_CHECK(AppTelemetrySpillLog_Result_Ok == test_Append(&log, i));
+
+	test_Open(&log);
+	// whatever is recovered must be a consecutive tail of the records, complete and in order
+	uint32_t numberOfRecords = AppTelemetrySpillLog_GetNumberOfRecords(&log);
+	APP_TEST_CHECK(numberOfRecords <= 20);
+	for(uint32_t i = 20 - numberOfRecords; i < 20; i++) test_ReadAndCheck(&log, i, true);
+	APP_TEST_CHECK(0 == AppTelemetrySpillLog_GetNumberOfRecords(&log));
+}
+
+int main(void) {
+
+	snprintf(test_Dir, sizeof(test_Dir), "/tmp/test_spilllog_XXXXXX");
+	if(NULL == mkdtemp(test_Dir)) {
+		printf("failed to create the temporary folder\n");
+		return 1;
+	}
+
+	APP_TEST_RUN(test_AppendRead);
+	APP_TEST_RUN(test_Reopen);
+	APP_TEST_RUN(test_Full);
+	APP_TEST_RUN(test_TornWrite);
+	APP_TEST_RUN(test_Corrupt);
+	APP_TEST_RUN(test_StaleFiles);
+
+	test_CleanDir();
+	rmdir(test_Dir);
+
+	return APP_TEST_RESULT();
+}